@@ -33,6 +33,7 @@
 #include <stdarg.h>
 #include <signal.h>
 
+#include <libsautil/compat.h>
 #include <libsautil/time.h>
 #include <libsautil/sastring.h>
 #include <libsautil/sa_path.h>
@@ -136,6 +137,12 @@ uint32_t cli_parse_format(const char *format)
         sa_strcasecmp(format, "txt") == 0) {
         return CLI_FORMAT_PRINT;
     }
+    if (sa_strcasecmp(format, "raw") == 0 || sa_strcasecmp(format, "dsd") == 0) {
+        return CLI_FORMAT_RAW_DSD;
+    }
+    if (sa_strcasecmp(format, "pcm") == 0) {
+        return CLI_FORMAT_RAW_PCM;
+    }
 
     return CLI_FORMAT_NONE;
 }
@@ -151,6 +158,8 @@ const char *cli_format_extension(uint32_t format)
     case CLI_FORMAT_XML:       return ".xml";
     case CLI_FORMAT_CUE:       return ".cue";
     case CLI_FORMAT_PRINT:     return ".txt";
+    case CLI_FORMAT_RAW_DSD:   return ".dsd";
+    case CLI_FORMAT_RAW_PCM:   return ".pcm";
     default:                   return "";
     }
 }
@@ -166,6 +175,8 @@ const char *cli_format_name(uint32_t format)
     case CLI_FORMAT_XML:       return "XML Metadata";
     case CLI_FORMAT_CUE:       return "CUE Sheet";
     case CLI_FORMAT_PRINT:     return "Text Metadata";
+    case CLI_FORMAT_RAW_DSD:   return "Raw DSD";
+    case CLI_FORMAT_RAW_PCM:   return "Raw PCM";
     default:                   return "Unknown";
     }
 }
@@ -242,6 +253,164 @@ const char *cli_track_format_name(dsdpipe_track_format_t format)
     }
 }
 
+/* ==========================================================================
+ * Time range
+ * ========================================================================== */
+
+/**
+ * Parse "[[h:]m:]s[.fff]" up to a terminator; advances *str past it.
+ */
+static int parse_time_ms(const char **str, uint64_t *ms)
+{
+    const char *p = *str;
+    uint64_t total = 0;
+    int fields = 0;
+
+    for (;;) {
+        if (*p < '0' || *p > '9') {
+            return -1;
+        }
+        uint64_t value = 0;
+        while (*p >= '0' && *p <= '9') {
+            value = value * 10 + (uint64_t)(*p - '0');
+            if (value > 359999) {
+                return -1;
+            }
+            p++;
+        }
+        if (fields > 0 && value >= 60) {
+            return -1;
+        }
+        total = total * 60 + value;
+        fields++;
+        if (*p != ':' || fields == 3) {
+            break;
+        }
+        p++;
+    }
+
+    total *= 1000;
+    if (*p == '.') {
+        uint64_t scale = 100;
+        p++;
+        if (*p < '0' || *p > '9') {
+            return -1;
+        }
+        while (*p >= '0' && *p <= '9') {
+            total += (uint64_t)(*p - '0') * scale;
+            scale /= 10;
+            p++;
+        }
+    }
+
+    *ms = total;
+    *str = p;
+    return 0;
+}
+
+int cli_parse_time_range(const char *str, uint32_t *start_ms, uint32_t *end_ms)
+{
+    uint64_t start = 0;
+    uint64_t end = 0;
+
+    if (!str || parse_time_ms(&str, &start) != 0 || *str != '-') {
+        return -1;
+    }
+    str++;
+
+    if (*str != '\0') {
+        if (parse_time_ms(&str, &end) != 0 || *str != '\0' || end <= start) {
+            return -1;
+        }
+    }
+
+    if (start > UINT32_MAX || end > UINT32_MAX) {
+        return -1;
+    }
+
+    *start_ms = (uint32_t)start;
+    *end_ms = (uint32_t)end;
+    return 0;
+}
+
+int cli_parse_raw_dsd_format(const char *str, dsdpipe_format_t *format)
+{
+    unsigned long rate;
+    unsigned long channels = 2;
+    char *end = NULL;
+
+    if (!str || !format) {
+        return -1;
+    }
+
+    rate = strtoul(str, &end, 10);
+    if (end == str) {
+        return -1;
+    }
+    if (*end == ':') {
+        const char *p = end + 1;
+        channels = strtoul(p, &end, 10);
+        if (end == p) {
+            return -1;
+        }
+    }
+    if (*end != '\0' || channels == 0 || channels > 6) {
+        return -1;
+    }
+
+    /* Small values are multiples of 64 x 44.1 kHz: DSD64, DSD128, ... */
+    if (rate == 64 || rate == 128 || rate == 256 || rate == 512) {
+        rate *= 44100;
+    } else if (rate < 64 * 44100 || rate > 512 * 44100) {
+        return -1;
+    }
+
+    memset(format, 0, sizeof(*format));
+    format->type = DSDPIPE_FORMAT_DSD_RAW;
+    format->sample_rate = (uint32_t)rate;
+    format->channel_count = (uint16_t)channels;
+    format->bits_per_sample = 1;
+    format->frame_rate = 75;
+    return 0;
+}
+
+/* ==========================================================================
+ * Standard streams
+ * ========================================================================== */
+
+int cli_redirect_stdout(void)
+{
+    int fd;
+
+    fflush(stdout);
+#ifdef _WIN32
+    fd = _dup(_fileno(stdout));
+    if (fd >= 0 && _dup2(_fileno(stderr), _fileno(stdout)) != 0) {
+        _close(fd);
+        return -1;
+    }
+#else
+    fd = dup(STDOUT_FILENO);
+    if (fd >= 0 && dup2(STDERR_FILENO, STDOUT_FILENO) < 0) {
+        close(fd);
+        return -1;
+    }
+#endif
+    return fd;
+}
+
+void cli_close_stream(int fd)
+{
+    if (fd < 0) {
+        return;
+    }
+#ifdef _WIN32
+    _close(fd);
+#else
+    close(fd);
+#endif
+}
+
 /* ==========================================================================
  * Input source detection
  * ========================================================================== */
@@ -252,6 +421,10 @@ cli_input_type_t cli_detect_input_type(const char *path)
         return CLI_INPUT_SACD;
     }
 
+    if (strcmp(path, "-") == 0) {
+        return CLI_INPUT_STREAM;
+    }
+
     /* Check for network address pattern: host:port
      * Look for a colon followed by digits (but not a Windows drive letter) */
     const char *colon = strchr(path, ':');
@@ -301,6 +474,7 @@ const char *cli_input_type_name(cli_input_type_t type)
     case CLI_INPUT_DSDIFF:     return "DSDIFF";
     case CLI_INPUT_PS3_DEVICE: return "PS3 Drive";
     case CLI_INPUT_NETWORK:    return "Network";
+    case CLI_INPUT_STREAM:     return "Standard input";
     default:                   return "Unknown";
     }
 }
@@ -75,17 +75,24 @@ typedef enum {
     CLI_FORMAT_FLAC       = (1 << 4),
     CLI_FORMAT_XML        = (1 << 5),
     CLI_FORMAT_CUE        = (1 << 6),
-    CLI_FORMAT_PRINT      = (1 << 7)
+    CLI_FORMAT_PRINT      = (1 << 7),
+    CLI_FORMAT_RAW_DSD    = (1 << 8),   /* Raw DSD, standard output only */
+    CLI_FORMAT_RAW_PCM    = (1 << 9)    /* Raw PCM, standard output only */
 } cli_format_flags_t;
 
-#define CLI_FORMAT_DSD_MASK   (CLI_FORMAT_DSF | CLI_FORMAT_DSDIFF | CLI_FORMAT_DSDIFF_EM)
-#define CLI_FORMAT_PCM_MASK   (CLI_FORMAT_WAV | CLI_FORMAT_FLAC)
+#define CLI_FORMAT_DSD_MASK   (CLI_FORMAT_DSF | CLI_FORMAT_DSDIFF | CLI_FORMAT_DSDIFF_EM | \
+                               CLI_FORMAT_RAW_DSD)
+#define CLI_FORMAT_PCM_MASK   (CLI_FORMAT_WAV | CLI_FORMAT_FLAC | CLI_FORMAT_RAW_PCM)
 #define CLI_FORMAT_META_MASK  (CLI_FORMAT_XML | CLI_FORMAT_CUE | CLI_FORMAT_PRINT)
 #define CLI_FORMAT_AUDIO_MASK (CLI_FORMAT_DSD_MASK | CLI_FORMAT_PCM_MASK)
+/* Formats that can be written to standard output */
+#define CLI_FORMAT_STREAM_MASK (CLI_FORMAT_WAV | CLI_FORMAT_FLAC | \
+                                CLI_FORMAT_RAW_DSD | CLI_FORMAT_RAW_PCM)
 
 /**
  * Parse format string to flags.
- * @param format  Format string (e.g., "dsf", "dsdiff", "em", "wav", "flac", "xml", "cue", "print")
+ * @param format  Format string (e.g., "dsf", "dsdiff", "em", "wav", "flac", "xml", "cue", "print",
+ *                "raw", "pcm")
  * @return Format flag or CLI_FORMAT_NONE if invalid
  */
 uint32_t cli_parse_format(const char *format);
@@ -139,6 +146,46 @@ int cli_parse_track_format(const char *str, dsdpipe_track_format_t *format);
  */
 const char *cli_track_format_name(dsdpipe_track_format_t format);
 
+/* ==========================================================================
+ * Time range
+ * ========================================================================== */
+
+/**
+ * Parse a time range "<start>-<end>" or "<start>-" (to end of track).
+ * Times are seconds with optional fraction, optionally preceded by
+ * minutes and hours: "90", "1:30", "1:30.250", "0:01:30".
+ * @return 0 on success, -1 if malformed
+ */
+int cli_parse_time_range(const char *str, uint32_t *start_ms, uint32_t *end_ms);
+
+/**
+ * Parse a raw DSD input format "<rate>[:<channels>]".
+ * The rate is a DSD multiple (64, 128, 256, 512) or a rate in Hz;
+ * channels default to 2.
+ * @param str     Format string, e.g. "64", "128:6", "5644800"
+ * @param format  Receives sample rate and channel count
+ * @return 0 on success, -1 if malformed
+ */
+int cli_parse_raw_dsd_format(const char *str, dsdpipe_format_t *format);
+
+/* ==========================================================================
+ * Standard streams
+ * ========================================================================== */
+
+/**
+ * Move standard output aside for a data stream.
+ * Returns a descriptor for the original standard output and points
+ * standard output at standard error, so that messages printed during
+ * the conversion do not end up in the stream.
+ * @return Descriptor for the data stream, or -1 on error
+ */
+int cli_redirect_stdout(void);
+
+/**
+ * Close a descriptor returned by cli_redirect_stdout().
+ */
+void cli_close_stream(int fd);
+
 /* ==========================================================================
  * Input source detection
  * ========================================================================== */
@@ -148,7 +195,8 @@ typedef enum {
     CLI_INPUT_DSF,            /* DSF file (.dsf) */
     CLI_INPUT_DSDIFF,         /* DSDIFF file (.dff, .dsdiff) */
     CLI_INPUT_PS3_DEVICE,     /* Physical PS3 drive (/dev/sr0, D:) */
-    CLI_INPUT_NETWORK         /* PS3 network address (host:port) */
+    CLI_INPUT_NETWORK,        /* PS3 network address (host:port) */
+    CLI_INPUT_STREAM          /* Standard input ("-"), DSF or raw DSD */
 } cli_input_type_t;
 
 /**
@@ -5,7 +5,9 @@
  * @brief Convert command implementation
  * Converts DSD audio formats (SACD ISO, DSF, DSDIFF) to various output
  * formats using the libdsdpipe pipeline. Supports multi-channel extraction,
- * DSD-to-PCM conversion, and multiple simultaneous output sinks.
+ * DSD-to-PCM conversion, and multiple simultaneous output sinks. "-" as
+ * input or output directory reads DSF/raw DSD from standard input or
+ * writes a single WAV, FLAC or raw stream to standard output.
  *
  * DSD-Nexus is free software; you can redistribute it and/or
  * modify it under the terms of the GNU Lesser General Public
@@ -56,6 +58,7 @@ typedef struct {
     int pcm_sample_rate;
     dsdpipe_pcm_quality_t pcm_quality;
     int flac_compression;
+    int flac_threads;
     int write_dst;
     int write_id3;
     int artist_flag;
@@ -63,6 +66,13 @@ typedef struct {
     int list_only;
     int verbose;
     int show_progress;
+    int resume;
+    int loudness;
+    int has_range;
+    uint32_t range_start_ms;
+    uint32_t range_end_ms;
+    int has_raw_format;
+    dsdpipe_format_t raw_format;
 } convert_opts_t;
 
 /* ==========================================================================
@@ -87,7 +97,12 @@ enum {
     OPT_PRINT,
     OPT_ARTIST,
     OPT_TRACK_FORMAT,
-    OPT_NO_PROGRESS
+    OPT_NO_PROGRESS,
+    OPT_RESUME,
+    OPT_LOUDNESS,
+    OPT_RANGE,
+    OPT_RAW_DSD,
+    OPT_FLAC_THREADS
 };
 
 static struct option long_options[] = {
@@ -104,6 +119,7 @@ static struct option long_options[] = {
     {"cue",         no_argument,       NULL, OPT_CUE},
     {"cuesheet",    no_argument,       NULL, OPT_CUESHEET},
     {"print",       no_argument,       NULL, OPT_PRINT},
+    {"loudness",    no_argument,       NULL, OPT_LOUDNESS},
     /* Format specification */
     {"format",      required_argument, NULL, 'f'},
     /* PCM options */
@@ -111,11 +127,14 @@ static struct option long_options[] = {
     {"rate",        required_argument, NULL, 'r'},
     {"quality",     required_argument, NULL, 'q'},
     {"compression", required_argument, NULL, 'c'},
+    {"flac-threads", required_argument, NULL, OPT_FLAC_THREADS},
     /* DST options */
     {"dst",         no_argument,       NULL, OPT_DST},
     {"decode-dst",  no_argument,       NULL, OPT_DECODE_DST},
     /* Track/area selection */
     {"tracks",      required_argument, NULL, 't'},
+    {"range",       required_argument, NULL, OPT_RANGE},
+    {"raw-dsd",     required_argument, NULL, OPT_RAW_DSD},
     {"area",        required_argument, NULL, 'a'},
     /* Metadata options */
     {"id3",         no_argument,       NULL, OPT_ID3},
@@ -125,6 +144,7 @@ static struct option long_options[] = {
     {"track-format", required_argument, NULL, OPT_TRACK_FORMAT},
     /* Behavior */
     {"no-progress", no_argument,       NULL, OPT_NO_PROGRESS},
+    {"resume",      no_argument,       NULL, OPT_RESUME},
     {"list",        no_argument,       NULL, 'l'},
     {"verbose",     no_argument,       NULL, 'v'},
     {"help",        no_argument,       NULL, 'h'},
@@ -141,11 +161,13 @@ static void print_convert_help(void)
     printf("Convert DSD audio formats with support for multiple simultaneous outputs.\n\n");
 
     printf("Supported Input Formats:\n");
-    printf("  SACD ISO images (.iso), DSF files (.dsf), DSDIFF files (.dff, .dsdiff)\n\n");
+    printf("  SACD ISO images (.iso), DSF files (.dsf), DSDIFF files (.dff, .dsdiff)\n");
+    printf("  \"-\" reads DSF, or raw DSD with --raw-dsd, from standard input\n\n");
 
     printf("Output Format Options (can specify multiple for simultaneous output):\n");
     printf("  -f, --format <fmt>      Add output format (can be repeated)\n");
-    printf("                          Formats: dsf, dsdiff, dff, em, wav, flac, xml, cue, print\n");
+    printf("                          Formats: dsf, dsdiff, dff, em, wav, flac, xml, cue, print,\n");
+    printf("                          raw (DSD), pcm (standard output only)\n");
     printf("  --dsf                   Output as DSF files\n");
     printf("  --dsdiff, --dff         Output as DSDIFF files\n");
     printf("  --edit-master, --em     Output as single DSDIFF Edit Master\n");
@@ -154,15 +176,20 @@ static void print_convert_help(void)
     printf("  --xml                   Export XML metadata\n");
     printf("  --cue, --cuesheet       Generate CUE sheet\n");
     printf("  --print                 Print metadata to stdout\n");
+    printf("  --loudness              Measure EBU R128 loudness and true peak;\n");
+    printf("                          tags FLAC (ReplayGain), WAV (BWF) and XML\n");
     printf("\n");
     printf("  NOTE: If no format specified, defaults to DSF.\n");
-    printf("        Example: --dsf --wav outputs both formats simultaneously.\n\n");
+    printf("        Example: --dsf --wav outputs both formats simultaneously.\n");
+    printf("        With output \"-\", one of wav, flac, raw or pcm is written to\n");
+    printf("        standard output as a single stream (default: raw).\n\n");
 
     printf("WAV/FLAC Options (PCM formats):\n");
     printf("  -b, --bits <depth>      PCM bit depth: 16, 24, 32 (default: 24)\n");
     printf("  -r, --rate <Hz>         PCM sample rate (default: auto from DSD rate)\n");
     printf("  -q, --quality <level>   DSD-to-PCM quality: fast, normal, high (default: normal)\n");
-    printf("  -c, --compression <0-8> FLAC compression level (default: 5)\n\n");
+    printf("  -c, --compression <0-8> FLAC compression level (default: 5)\n");
+    printf("  --flac-threads <n>      FLAC encoder threads, 0 = one per CPU (default: 0)\n\n");
 
     printf("DST Options:\n");
     printf("  --dst                   Keep DST compression (DSDIFF only)\n");
@@ -171,8 +198,14 @@ static void print_convert_help(void)
     printf("Track/Area Selection:\n");
     printf("  -t, --tracks <spec>     Track selection (default: all)\n");
     printf("                          Examples: \"all\", \"1\", \"1-5\", \"1,3,5\"\n");
+    printf("  --range <start>-[end]   Extract only part of a single track\n");
+    printf("                          Times: [[h:]m:]s[.ms], e.g. \"1:30-2:00\", \"45.5-\"\n");
     printf("  -a, --area <type>       Audio area: stereo, multichannel (default: stereo)\n\n");
 
+    printf("Standard Input:\n");
+    printf("  --raw-dsd <rate>[:ch]   Input \"-\" is raw byte-interleaved DSD (MSB first)\n");
+    printf("                          Rate: 64, 128, 256, 512 or Hz; ch default 2\n\n");
+
     printf("Metadata Options:\n");
     printf("  -i, --id3               Write ID3v2 metadata tags (default)\n");
     printf("  -n, --no-id3            Disable ID3v2 tags\n\n");
@@ -187,6 +220,10 @@ static void print_convert_help(void)
     printf("Other Options:\n");
     printf("  -l, --list              List tracks only, don't convert\n");
     printf("  --no-progress           Disable progress bar\n");
+    printf("  --resume                Reuse the album directory and skip tracks\n");
+    printf("                          finished by a previous (interrupted) run;\n");
+    printf("                          with --loudness no album gain is written\n");
+    printf("                          when tracks are skipped\n");
     printf("  -v, --verbose           Verbose output\n");
     printf("  -h, --help              Show this help\n\n");
 
@@ -198,6 +235,11 @@ static void print_convert_help(void)
     printf("  dsdctl convert --edit-master --cue --xml album.iso ./output\n");
     printf("  dsdctl convert -a multichannel --dsf album.iso ./output\n");
     printf("  dsdctl convert --dsdiff track.dsf ./output\n");
+    printf("  dsdctl convert --resume --flac album.iso ./output\n");
+    printf("  dsdctl convert --flac --xml --loudness album.iso ./output\n");
+    printf("  dsdctl convert --wav -t 3 --range 1:30-2:00 album.iso ./output\n");
+    printf("  dsdctl convert --flac -t 2 album.iso - | flac -d -c - | aplay\n");
+    printf("  cat track.dsf | dsdctl convert -f pcm -b 16 - - > track.pcm\n");
     printf("  dsdctl convert -l album.iso\n");
 }
 
@@ -282,11 +324,107 @@ static void print_track_list(dsdpipe_t *pipe)
  * Convert implementation
  * ========================================================================== */
 
+/* ==========================================================================
+ * Print loudness results
+ * ========================================================================== */
+
+static void print_loudness_line(const char *label,
+                                const dsdpipe_loudness_t *loudness)
+{
+    printf("  %-8s %6.1f LUFS  LRA %4.1f LU  TP %5.1f dBTP  RG %+6.2f dB\n",
+           label, loudness->integrated_lufs, loudness->loudness_range_lu,
+           loudness->true_peak_dbtp, loudness->replaygain_db);
+}
+
+static void print_loudness(dsdpipe_t *pipe, int verbose, int resume)
+{
+    dsdpipe_loudness_t loudness;
+    uint8_t selected[256];
+    size_t sel_count = 0;
+    size_t unmeasured = 0;
+
+    printf("Loudness:\n");
+
+    dsdpipe_get_selected_tracks(pipe, selected, 256, &sel_count);
+    for (size_t i = 0; i < sel_count; i++) {
+        if (dsdpipe_get_loudness(pipe, selected[i], &loudness) != DSDPIPE_OK) {
+            unmeasured++;
+        } else if (verbose) {
+            char label[16];
+            snprintf(label, sizeof(label), "Track %u", selected[i]);
+            print_loudness_line(label, &loudness);
+        }
+    }
+
+    if (dsdpipe_get_loudness(pipe, 0, &loudness) == DSDPIPE_OK) {
+        print_loudness_line("Album", &loudness);
+    } else if (resume && unmeasured > 0) {
+        printf("  Album gain not written: %zu track(s) skipped by --resume were not measured\n",
+               unmeasured);
+    } else {
+        printf("  (no audio above the gating threshold)\n");
+    }
+}
+
+/* ==========================================================================
+ * Time range selection
+ * ========================================================================== */
+
+/**
+ * Select the --range excerpt. Needs a single track, given with -t unless
+ * the input has only one.
+ */
+static int select_range(dsdpipe_t *pipe, const convert_opts_t *opts)
+{
+    uint8_t track_count = 0;
+    unsigned long track = 0;
+    char *end = NULL;
+
+    dsdpipe_get_track_count(pipe, &track_count);
+
+    if (sa_strcasecmp(opts->track_spec, "all") == 0) {
+        if (track_count != 1) {
+            cli_error("--range needs a single track; select one with -t");
+            return DSDPIPE_ERROR_INVALID_ARG;
+        }
+        track = 1;
+    } else {
+        track = strtoul(opts->track_spec, &end, 10);
+        if (!end || *end != '\0' || track == 0 || track > 255) {
+            cli_error("--range needs a single track, not \"%s\"", opts->track_spec);
+            return DSDPIPE_ERROR_INVALID_ARG;
+        }
+    }
+
+    int result = dsdpipe_select_range(pipe, (uint8_t)track,
+                                      opts->range_start_ms, opts->range_end_ms);
+    if (result != DSDPIPE_OK) {
+        cli_error("Invalid range for track %lu (%s)", track,
+                  dsdpipe_get_error_message(pipe));
+        return result;
+    }
+
+    if (opts->verbose) {
+        if (opts->range_end_ms) {
+            printf("Range:   %u.%03u s - %u.%03u s\n",
+                   opts->range_start_ms / 1000, opts->range_start_ms % 1000,
+                   opts->range_end_ms / 1000, opts->range_end_ms % 1000);
+        } else {
+            printf("Range:   %u.%03u s - end\n",
+                   opts->range_start_ms / 1000, opts->range_start_ms % 1000);
+        }
+    }
+
+    return DSDPIPE_OK;
+}
+
 static int do_convert(const convert_opts_t *opts)
 {
     dsdpipe_t *pipe = NULL;
     cli_input_type_t in_type;
     dsdpipe_channel_type_t channel_type;
+    int to_stdout = opts->output_dir && strcmp(opts->output_dir, "-") == 0;
+    int stream_fd = -1;
     int result;
 
     /* Parse area type */
@@ -320,6 +458,15 @@ static int do_convert(const convert_opts_t *opts)
         return 1;
     }
 
+    /* Keep messages out of the audio stream */
+    if (to_stdout && !opts->list_only) {
+        stream_fd = cli_redirect_stdout();
+        if (stream_fd < 0) {
+            cli_error("Failed to set up standard output");
+            return 1;
+        }
+    }
+
     /* Install signal handler */
     cli_install_signal_handler();
 
@@ -327,6 +474,7 @@ static int do_convert(const convert_opts_t *opts)
     pipe = dsdpipe_create();
     if (!pipe) {
         cli_error("Failed to create pipeline");
+        cli_close_stream(stream_fd);
         return 1;
     }
 
@@ -348,11 +496,17 @@ static int do_convert(const convert_opts_t *opts)
     case CLI_INPUT_DSDIFF:
         result = dsdpipe_set_source_dsdiff(pipe, opts->input_path);
         break;
+    case CLI_INPUT_STREAM:
+        /* Descriptor 0 is standard input on every platform */
+        result = dsdpipe_set_source_stream(pipe, 0,
+                                           opts->has_raw_format ? &opts->raw_format : NULL);
+        break;
     default:
         cli_error("Unsupported input type for convert: %s",
                   cli_input_type_name(in_type));
         dsdpipe_destroy(pipe);
         cli_set_pipe_for_cancel(NULL);
+        cli_close_stream(stream_fd);
         return 1;
     }
 
@@ -360,6 +514,7 @@ static int do_convert(const convert_opts_t *opts)
         cli_error("Failed to open source: %s", dsdpipe_get_error_message(pipe));
         dsdpipe_destroy(pipe);
         cli_set_pipe_for_cancel(NULL);
+        cli_close_stream(stream_fd);
         return 1;
     }
 
@@ -376,6 +531,7 @@ static int do_convert(const convert_opts_t *opts)
         print_track_list(pipe);
         dsdpipe_destroy(pipe);
         cli_set_pipe_for_cancel(NULL);
+        cli_close_stream(stream_fd);
         return 0;
     }
 
@@ -384,13 +540,23 @@ static int do_convert(const convert_opts_t *opts)
     }
 
     /* Select tracks */
-    result = dsdpipe_select_tracks_str(pipe, opts->track_spec);
-    if (result != DSDPIPE_OK) {
-        cli_error("Invalid track selection: %s (%s)",
-                  opts->track_spec, dsdpipe_get_error_message(pipe));
-        dsdpipe_destroy(pipe);
-        cli_set_pipe_for_cancel(NULL);
-        return 1;
+    if (opts->has_range) {
+        if (select_range(pipe, opts) != DSDPIPE_OK) {
+            dsdpipe_destroy(pipe);
+            cli_set_pipe_for_cancel(NULL);
+            cli_close_stream(stream_fd);
+            return 1;
+        }
+    } else {
+        result = dsdpipe_select_tracks_str(pipe, opts->track_spec);
+        if (result != DSDPIPE_OK) {
+            cli_error("Invalid track selection: %s (%s)",
+                      opts->track_spec, dsdpipe_get_error_message(pipe));
+            dsdpipe_destroy(pipe);
+            cli_set_pipe_for_cancel(NULL);
+            cli_close_stream(stream_fd);
+            return 1;
+        }
     }
 
     /* Print selected tracks */
@@ -412,7 +578,7 @@ static int do_convert(const convert_opts_t *opts)
 
     /* Generate album output directory from metadata */
     char *album_output_path = NULL;
-    {
+    if (!to_stdout) {
         dsdpipe_metadata_t album_meta = {0};
         if (dsdpipe_get_album_metadata(pipe, &album_meta) == DSDPIPE_OK) {
             dsdpipe_album_format_t dir_format = opts->artist_flag
@@ -421,7 +587,10 @@ static int do_convert(const convert_opts_t *opts)
 
             char *album_dir = dsdpipe_get_album_dir(&album_meta, dir_format);
             if (album_dir != NULL) {
-                album_output_path = sa_unique_path(opts->output_dir, album_dir, NULL);
+                /* Resume continues in the existing directory */
+                album_output_path = opts->resume
+                    ? sa_make_path(opts->output_dir, NULL, album_dir, NULL)
+                    : sa_unique_path(opts->output_dir, album_dir, NULL);
 
                 if (album_output_path &&
                     album_meta.disc_total > 1 && album_meta.disc_number > 0) {
@@ -460,7 +629,7 @@ static int do_convert(const convert_opts_t *opts)
     }
 
     /* Print output configuration */
-    printf("Output:  %s\n", final_output);
+    printf("Output:  %s\n", to_stdout ? "standard output" : final_output);
     if (album_output_path)
         printf("         (auto-generated from album metadata)\n");
 
@@ -474,12 +643,29 @@ static int do_convert(const convert_opts_t *opts)
         dsdpipe_set_pcm_quality(pipe, opts->pcm_quality);
     }
 
+    /* Set FLAC encoder threads */
+    dsdpipe_set_flac_threads(pipe, opts->flac_threads);
+
     /* Set track filename format */
     dsdpipe_set_track_filename_format(pipe, opts->track_format);
     if (opts->verbose) {
         printf("Track naming: %s\n", cli_track_format_name(opts->track_format));
     }
 
+    /* Track completion journal for --resume */
+    if (opts->resume) {
+        char *journal_path = sa_make_path(final_output, NULL,
+                                          DSDPIPE_JOURNAL_NAME,
+                                          DSDPIPE_JOURNAL_EXT);
+        if (journal_path) {
+            dsdpipe_set_journal(pipe, journal_path);
+            if (opts->verbose) {
+                printf("Journal: %s\n", journal_path);
+            }
+            sa_free(journal_path);
+        }
+    }
+
     /* Configure sinks based on format bitmask */
     result = DSDPIPE_OK;
     int sink_count = 0;
@@ -493,6 +679,37 @@ static int do_convert(const convert_opts_t *opts)
                       dsdpipe_get_error_message(pipe));
     }
 
+    /* Standard output: one stream sink instead of the per-track files */
+    if (to_stdout && result == DSDPIPE_OK) {
+        dsdpipe_stream_format_t stream_format;
+        int bit_depth = opts->pcm_bit_depth;
+
+        if (opts->out_formats & CLI_FORMAT_WAV) {
+            stream_format = DSDPIPE_STREAM_WAV;
+        } else if (opts->out_formats & CLI_FORMAT_FLAC) {
+            stream_format = DSDPIPE_STREAM_FLAC;
+            if (bit_depth == 32)
+                bit_depth = 24;
+        } else if (opts->out_formats & CLI_FORMAT_RAW_PCM) {
+            stream_format = DSDPIPE_STREAM_RAW_PCM;
+        } else {
+            stream_format = DSDPIPE_STREAM_RAW_DSD;
+        }
+
+        if (stream_format == DSDPIPE_STREAM_RAW_DSD) {
+            printf("\n[Sink %d] Raw DSD to standard output\n", ++sink_count);
+        } else {
+            printf("\n[Sink %d] %s to standard output (%d-bit, quality: %s)\n",
+                   ++sink_count, cli_format_name(opts->out_formats & CLI_FORMAT_STREAM_MASK),
+                   bit_depth, cli_pcm_quality_name(opts->pcm_quality));
+        }
+        result = dsdpipe_add_sink_stream(pipe, stream_fd, stream_format,
+                                         bit_depth, opts->flac_compression);
+        if (result != DSDPIPE_OK)
+            cli_error("Failed to configure standard output: %s",
+                      dsdpipe_get_error_message(pipe));
+    }
+
     /* DSF sink */
     if ((opts->out_formats & CLI_FORMAT_DSF) && result == DSDPIPE_OK) {
         printf("\n[Sink %d] DSF (ID3: %s)\n", ++sink_count,
@@ -528,7 +745,7 @@ static int do_convert(const convert_opts_t *opts)
     }
 
     /* WAV sink */
-    if ((opts->out_formats & CLI_FORMAT_WAV) && result == DSDPIPE_OK) {
+    if (!to_stdout && (opts->out_formats & CLI_FORMAT_WAV) && result == DSDPIPE_OK) {
         printf("\n[Sink %d] WAV (%d-bit, %s, quality: %s)\n", ++sink_count,
                opts->pcm_bit_depth,
                opts->pcm_sample_rate > 0 ? "custom rate" : "auto rate",
@@ -541,7 +758,7 @@ static int do_convert(const convert_opts_t *opts)
     }
 
     /* FLAC sink */
-    if ((opts->out_formats & CLI_FORMAT_FLAC) && result == DSDPIPE_OK) {
+    if (!to_stdout && (opts->out_formats & CLI_FORMAT_FLAC) && result == DSDPIPE_OK) {
         int flac_bit_depth = (opts->pcm_bit_depth == 32) ? 24 : opts->pcm_bit_depth;
         printf("\n[Sink %d] FLAC (%d-bit, compression: %d, quality: %s)\n",
                ++sink_count, flac_bit_depth, opts->flac_compression,
@@ -600,10 +817,20 @@ static int do_convert(const convert_opts_t *opts)
         }
     }
 
+    /* Loudness analysis sink */
+    if (opts->loudness && result == DSDPIPE_OK) {
+        printf("\n[Sink %d] Loudness Analysis (EBU R128)\n", ++sink_count);
+        result = dsdpipe_add_sink_loudness(pipe);
+        if (result != DSDPIPE_OK)
+            cli_error("Failed to configure loudness analysis: %s",
+                      dsdpipe_get_error_message(pipe));
+    }
+
     if (result != DSDPIPE_OK) {
         sa_free(album_output_path);
         dsdpipe_destroy(pipe);
         cli_set_pipe_for_cancel(NULL);
+        cli_close_stream(stream_fd);
         return 1;
     }
 
@@ -615,7 +842,7 @@ static int do_convert(const convert_opts_t *opts)
 
         int has_per_track = opts->out_formats &
             (CLI_FORMAT_DSF | CLI_FORMAT_DSDIFF | CLI_FORMAT_WAV | CLI_FORMAT_FLAC);
-        if (has_per_track && sel_count > 0) {
+        if (has_per_track && !to_stdout && sel_count > 0) {
             printf("\nFiles:\n");
             for (size_t i = 0; i < sel_count; i++) {
                 dsdpipe_metadata_t trk_meta = {0};
@@ -688,6 +915,7 @@ static int do_convert(const convert_opts_t *opts)
             {CLI_FORMAT_DSDIFF_EM, "Edit Master"}, {CLI_FORMAT_WAV, "WAV"},
             {CLI_FORMAT_FLAC, "FLAC"}, {CLI_FORMAT_XML, "XML"},
             {CLI_FORMAT_CUE, "CUE"}, {CLI_FORMAT_PRINT, "TEXT"},
+            {CLI_FORMAT_RAW_DSD, "raw DSD"}, {CLI_FORMAT_RAW_PCM, "raw PCM"},
         };
         for (int i = 0; i < (int)(sizeof(fmts) / sizeof(fmts[0])); i++) {
             if (opts->out_formats & fmts[i].flag) {
@@ -720,8 +948,11 @@ static int do_convert(const convert_opts_t *opts)
         sa_free(album_output_path);
         dsdpipe_destroy(pipe);
         cli_set_pipe_for_cancel(NULL);
+        cli_close_stream(stream_fd);
         return 1;
     } else {
+        if (opts->loudness)
+            print_loudness(pipe, opts->verbose, opts->resume);
         printf("Done!\n");
     }
 
@@ -729,6 +960,7 @@ static int do_convert(const convert_opts_t *opts)
     sa_free(album_output_path);
     dsdpipe_destroy(pipe);
     cli_set_pipe_for_cancel(NULL);
+    cli_close_stream(stream_fd);
 
     return (result == DSDPIPE_OK) ? 0 : 1;
 }
@@ -755,7 +987,9 @@ int cmd_convert(int argc, char *argv[])
         .track_format = DSDPIPE_TRACK_NUM_ARTIST_TITLE,
         .list_only = 0,
         .verbose = 0,
-        .show_progress = 1
+        .show_progress = 1,
+        .resume = 0,
+        .loudness = 0
     };
 
     uint32_t fmt;
@@ -801,7 +1035,7 @@ int cmd_convert(int argc, char *argv[])
             fmt = cli_parse_format(optarg);
             if (fmt == 0) {
                 cli_error("Unknown output format: %s", optarg);
-                fprintf(stderr, "  Use: dsf, dsdiff, dff, em, wav, flac, xml, cue, print\n");
+                fprintf(stderr, "  Use: dsf, dsdiff, dff, em, wav, flac, xml, cue, print, raw, pcm\n");
                 return 1;
             }
             opts.out_formats |= fmt;
@@ -837,6 +1071,13 @@ int cmd_convert(int argc, char *argv[])
                 return 1;
             }
             break;
+        case OPT_FLAC_THREADS:
+            opts.flac_threads = atoi(optarg);
+            if (opts.flac_threads < 0) {
+                cli_error("Invalid FLAC thread count: %s", optarg);
+                return 1;
+            }
+            break;
 
         /* DST options */
         case OPT_DST:
@@ -850,6 +1091,21 @@ int cmd_convert(int argc, char *argv[])
         case 't':
             opts.track_spec = optarg;
             break;
+        case OPT_RANGE:
+            if (cli_parse_time_range(optarg, &opts.range_start_ms,
+                                     &opts.range_end_ms) != 0) {
+                cli_error("Invalid time range: %s (use e.g. 1:30-2:00)", optarg);
+                return 1;
+            }
+            opts.has_range = 1;
+            break;
+        case OPT_RAW_DSD:
+            if (cli_parse_raw_dsd_format(optarg, &opts.raw_format) != 0) {
+                cli_error("Invalid raw DSD format: %s (use e.g. 64 or 128:6)", optarg);
+                return 1;
+            }
+            opts.has_raw_format = 1;
+            break;
         case 'a':
             opts.area = optarg;
             break;
@@ -880,6 +1136,12 @@ int cmd_convert(int argc, char *argv[])
         case OPT_NO_PROGRESS:
             opts.show_progress = 0;
             break;
+        case OPT_RESUME:
+            opts.resume = 1;
+            break;
+        case OPT_LOUDNESS:
+            opts.loudness = 1;
+            break;
         case 'l':
             opts.list_only = 1;
             break;
@@ -905,9 +1167,12 @@ int cmd_convert(int argc, char *argv[])
             opts.output_dir = argv[i];
     }
 
-    /* Default to DSF if no format specified */
-    if (opts.out_formats == 0) {
-        opts.out_formats = CLI_FORMAT_DSF;
+    int to_stdout = opts.output_dir && strcmp(opts.output_dir, "-") == 0;
+
+    /* Default to DSF (raw DSD on standard output) if no format specified */
+    if ((opts.out_formats & CLI_FORMAT_AUDIO_MASK) == 0 &&
+        (opts.out_formats == 0 || to_stdout)) {
+        opts.out_formats |= to_stdout ? CLI_FORMAT_RAW_DSD : CLI_FORMAT_DSF;
     }
 
     /* Validate required arguments */
@@ -923,5 +1188,26 @@ int cmd_convert(int argc, char *argv[])
         return 1;
     }
 
+    /* Standard output carries exactly one stream and nothing else */
+    if (to_stdout) {
+        uint32_t stream_formats = opts.out_formats & CLI_FORMAT_STREAM_MASK;
+        if (cli_count_formats(stream_formats) != 1 ||
+            (opts.out_formats & ~(CLI_FORMAT_STREAM_MASK | CLI_FORMAT_PRINT))) {
+            cli_error("Output \"-\" takes exactly one of wav, flac, raw or pcm");
+            return 1;
+        }
+        if (opts.resume) {
+            cli_error("--resume cannot be used with output \"-\"");
+            return 1;
+        }
+    } else if (opts.out_formats & (CLI_FORMAT_RAW_DSD | CLI_FORMAT_RAW_PCM)) {
+        cli_error("Raw output is only available on standard output (\"-\")");
+        return 1;
+    }
+
+    if (opts.has_raw_format && strcmp(opts.input_path, "-") != 0) {
+        cli_warning("--raw-dsd ignored for input %s", opts.input_path);
+    }
+
     return do_convert(&opts);
 }
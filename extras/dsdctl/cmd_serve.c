@@ -0,0 +1,286 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Serve command implementation
+ * Exports SACD ISO images or a PS3 drive with sacd_server, which speaks
+ * the PS3 network streaming protocol. The protocol has no notion of a path,
+ * so every source gets its own port.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "cmd_serve.h"
+#include "cli_common.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <libsacd/sacd.h>
+#include <libsautil/mem.h>
+#ifndef SACD_NO_PS3DRIVE
+#include <libsacd/sacd_server.h>
+#endif
+
+/* Poll interval, bounds how long Ctrl+C takes to be noticed */
+#define SERVE_POLL_MS 250
+
+/* ==========================================================================
+ * Serve options
+ * ========================================================================== */
+
+typedef struct {
+    const char *bind_address;
+    unsigned long port;
+    unsigned long window;
+    unsigned long max_clients;
+    bool use_sendfile;
+    const char **sources;
+    int source_count;
+} serve_opts_t;
+
+/* ==========================================================================
+ * Help
+ * ========================================================================== */
+
+static void print_serve_help(void)
+{
+    printf("Usage: dsdctl serve [options] <iso|device>...\n\n");
+    printf("Serve SACD ISO images or a PS3 drive over the PS3 network protocol.\n");
+    printf("Each source is served on its own port, counting up from --port.\n\n");
+
+    printf("Options:\n");
+    printf("  -b, --bind <addr>       IPv4 address to listen on (default: all)\n");
+    printf("  -p, --port <port>       First port (default: 2002)\n");
+    printf("  --window <n>            Requests queued per client (default: 16)\n");
+    printf("  --max-clients <n>       Connection limit (default: 64)\n");
+    printf("  --no-sendfile           Always use buffered writes\n");
+    printf("  -v, --verbose           Log connections\n");
+    printf("  -h, --help              Show this help message\n\n");
+
+    printf("Examples:\n");
+    printf("  dsdctl serve album.iso\n");
+    printf("  dsdctl serve -p 3000 first.iso second.iso\n");
+    printf("  dsdctl serve -b 192.168.1.10 /dev/sr0\n");
+    printf("  dsdctl extract -n 192.168.1.10:2002 -o copy.iso\n");
+}
+
+static int parse_number(const char *str, unsigned long min, unsigned long max,
+                        unsigned long *value)
+{
+    char *end = NULL;
+    unsigned long v;
+
+    if (!str || !*str) {
+        return -1;
+    }
+    v = strtoul(str, &end, 10);
+    if (*end != '\0' || v < min || v > max) {
+        return -1;
+    }
+    *value = v;
+    return 0;
+}
+
+/* ==========================================================================
+ * Serve implementation
+ * ========================================================================== */
+
+#ifndef SACD_NO_PS3DRIVE
+
+static void serve_log(void *opaque, const char *message)
+{
+    (void)opaque;
+    cli_info("%s", message);
+}
+
+static int do_serve(const serve_opts_t *opts)
+{
+    sacd_server_config_t config;
+    sacd_server_t *server = NULL;
+    int ret = 0;
+
+    memset(&config, 0, sizeof(config));
+    config.bind_address = opts->bind_address;
+    config.client_window = (uint32_t)opts->window;
+    config.max_clients = (uint32_t)opts->max_clients;
+    config.disable_sendfile = !opts->use_sendfile;
+    config.log = serve_log;
+
+    if (sacd_server_create(&config, &server) != SACD_OK) {
+        cli_error("Failed to create server%s%s",
+                  opts->bind_address ? " on " : "",
+                  opts->bind_address ? opts->bind_address : "");
+        return 1;
+    }
+
+    for (int i = 0; i < opts->source_count; i++) {
+        unsigned long port = opts->port + (unsigned long)i;
+
+        if (port > 65535) {
+            cli_error("Out of ports for: %s", opts->sources[i]);
+            sacd_server_destroy(server);
+            return 1;
+        }
+        if (sacd_server_add_export(server, opts->sources[i],
+                                   (uint16_t)port) != SACD_OK) {
+            cli_error("Failed to serve %s on port %lu", opts->sources[i], port);
+            sacd_server_destroy(server);
+            return 1;
+        }
+        printf("Serving: %s on %s:%lu\n", opts->sources[i],
+               opts->bind_address ? opts->bind_address : "0.0.0.0", port);
+    }
+    printf("Press Ctrl+C to stop.\n");
+    fflush(stdout);
+
+    cli_install_signal_handler();
+
+    while (!cli_is_interrupted()) {
+        if (sacd_server_poll(server, SERVE_POLL_MS) != SACD_OK) {
+            cli_error("Server error, shutting down");
+            ret = 1;
+            break;
+        }
+    }
+
+    if (ret == 0) {
+        printf("\nServer stopped.\n");
+    }
+    sacd_server_destroy(server);
+    return ret;
+}
+
+#else
+
+static int do_serve(const serve_opts_t *opts)
+{
+    (void)opts;
+    cli_error("dsdctl was built without network support (BUILD_PS3DRIVE=OFF)");
+    return 1;
+}
+
+#endif
+
+/* ==========================================================================
+ * Command entry point
+ * ========================================================================== */
+
+int cmd_serve(int argc, char *argv[])
+{
+    serve_opts_t opts = {
+        .bind_address = NULL,
+        .port = 2002,
+        .window = 16,
+        .max_clients = 64,
+        .use_sendfile = true,
+        .sources = NULL,
+        .source_count = 0
+    };
+    int ret;
+
+    opts.sources = (const char **)sa_calloc((size_t)argc, sizeof(const char *));
+    if (!opts.sources) {
+        cli_error("Out of memory");
+        return 1;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+
+        if (cli_match_option(arg, "-h", "--help")) {
+            print_serve_help();
+            sa_free(opts.sources);
+            return 0;
+        }
+
+        if (cli_match_option(arg, "-b", "--bind")) {
+            opts.bind_address = cli_get_option_value(argc, argv, &i);
+            if (!opts.bind_address) {
+                cli_error("Missing value for --bind");
+                sa_free(opts.sources);
+                return 1;
+            }
+            continue;
+        }
+
+        if (cli_match_option(arg, "-p", "--port")) {
+            if (parse_number(cli_get_option_value(argc, argv, &i), 1, 65535,
+                             &opts.port) != 0) {
+                cli_error("Invalid value for --port (1-65535)");
+                sa_free(opts.sources);
+                return 1;
+            }
+            continue;
+        }
+
+        if (strcmp(arg, "--window") == 0) {
+            if (parse_number(cli_get_option_value(argc, argv, &i), 1, 1024,
+                             &opts.window) != 0) {
+                cli_error("Invalid value for --window (1-1024)");
+                sa_free(opts.sources);
+                return 1;
+            }
+            continue;
+        }
+
+        if (strcmp(arg, "--max-clients") == 0) {
+            if (parse_number(cli_get_option_value(argc, argv, &i), 1, 100000,
+                             &opts.max_clients) != 0) {
+                cli_error("Invalid value for --max-clients (1-100000)");
+                sa_free(opts.sources);
+                return 1;
+            }
+            continue;
+        }
+
+        if (strcmp(arg, "--no-sendfile") == 0) {
+            opts.use_sendfile = false;
+            continue;
+        }
+
+        if (cli_match_option(arg, "-v", "--verbose")) {
+            cli_set_verbose(true);
+            continue;
+        }
+
+        /* Unknown option */
+        if (cli_is_option(arg)) {
+            cli_error("Unknown option: %s", arg);
+            sa_free(opts.sources);
+            return 1;
+        }
+
+        /* Positional argument: a source to serve */
+        if (cli_detect_input_type(arg) == CLI_INPUT_NETWORK) {
+            cli_error("Cannot serve a network source: %s", arg);
+            sa_free(opts.sources);
+            return 1;
+        }
+        opts.sources[opts.source_count++] = arg;
+    }
+
+    if (opts.source_count == 0) {
+        cli_error("At least one ISO image or device is required");
+        fprintf(stderr, "Run 'dsdctl serve --help' for usage.\n");
+        sa_free(opts.sources);
+        return 1;
+    }
+
+    ret = do_serve(&opts);
+    sa_free(opts.sources);
+    return ret;
+}
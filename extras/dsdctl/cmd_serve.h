@@ -0,0 +1,57 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Serve command for exporting SACD images over the network
+ * Serves local ISO images or a PS3 drive with the same protocol as the
+ * PS3 network streaming server, so extract, convert and info can read
+ * them remotely with a host:port input.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSDCTL_CMD_SERVE_H
+#define DSDCTL_CMD_SERVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Execute the serve command.
+ *
+ * Usage: dsdctl serve [options] <iso|device>...
+ *
+ * Each source is served on its own port, starting at --port.
+ *
+ * Options:
+ *   -b, --bind <addr>       IPv4 address to listen on (default: all)
+ *   -p, --port <port>       First port (default: 2002)
+ *   --window <n>            Requests queued per client (default: 16)
+ *   --max-clients <n>       Connection limit (default: 64)
+ *   --no-sendfile           Always use buffered writes
+ *   -v, --verbose           Log connections
+ *   -h, --help              Show help
+ *
+ * @param argc Argument count (including "serve")
+ * @param argv Argument vector
+ * @return Exit code (0 on success)
+ */
+int cmd_serve(int argc, char *argv[]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSDCTL_CMD_SERVE_H */
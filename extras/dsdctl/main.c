@@ -6,6 +6,7 @@
  * Subcommands:
  *   convert - Convert DSD formats (ISO, DSF, DSDIFF) to various outputs
  *   extract - Extract raw SACD ISO from PS3 drive or network
+ *   serve   - Serve SACD ISOs or a PS3 drive over the network
  *   info    - Display file/disc metadata information
  *
  * DSD-Nexus is free software; you can redistribute it and/or
@@ -30,6 +31,7 @@
 #include "cmd_convert.h"
 #include "cmd_extract.h"
 #include "cmd_info.h"
+#include "cmd_serve.h"
 #include "cli_common.h"
 
 #define DSDCTL_VERSION "1.0.0"
@@ -53,6 +55,7 @@ static void print_usage(const char *prog)
     printf("  convert    Convert between DSD audio formats (ISO, DSF, DSDIFF -> DSF, DSDIFF, WAV, FLAC, etc.)\n");
     printf("  extract    Extract raw SACD ISO image from PS3 drive or network\n");
     printf("  info       Display file or disc metadata information\n");
+    printf("  serve      Serve SACD ISO images or a PS3 drive over the network\n");
     printf("\n");
     printf("Options:\n");
     printf("  -h, --help     Show this help message\n");
@@ -65,6 +68,7 @@ static void print_usage(const char *prog)
     printf("  %s extract -n 192.168.1.100:2002 -o album.iso\n", prog);
     printf("  %s info album.iso\n", prog);
     printf("  %s info --json track.dsf\n", prog);
+    printf("  %s serve album.iso\n", prog);
     printf("\n");
     printf("Run '%s <command> --help' for more information on a command.\n", prog);
 }
@@ -109,6 +113,10 @@ int main(int argc, char *argv[])
         return cmd_info(argc - 1, argv + 1);
     }
 
+    if (strcmp(cmd, "serve") == 0) {
+        return cmd_serve(argc - 1, argv + 1);
+    }
+
     /* Unknown command */
     fprintf(stderr, "Error: Unknown command '%s'\n", cmd);
     fprintf(stderr, "Run '%s --help' for usage.\n", argv[0]);
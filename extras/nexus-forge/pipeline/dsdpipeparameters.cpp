@@ -24,6 +24,7 @@ DsdPipeParameters::DsdPipeParameters()
     , writeId3(true)
     , trackFormat(2)         // DSDPIPE_TRACK_NUM_ARTIST_TITLE
     , albumFormat(1)         // DSDPIPE_ALBUM_ARTIST_TITLE
+    , resume(false)
     , trackCount(0)
 {
 }
@@ -39,6 +40,7 @@ void DsdPipeParameters::copyConfigurationFrom(const DsdPipeParameters &other)
     writeId3 = other.writeId3;
     trackFormat = other.trackFormat;
     albumFormat = other.albumFormat;
+    resume = other.resume;
 }
 
 QString DsdPipeParameters::buildFormatSummary() const
@@ -64,6 +64,9 @@ struct DsdPipeParameters {
     int trackFormat;            ///< DSDPIPE_TRACK_NUM_ONLY/NUM_TITLE/NUM_ARTIST_TITLE
     int albumFormat;            ///< DSDPIPE_ALBUM_TITLE_ONLY/ARTIST_TITLE
 
+    // Resume
+    bool resume;                ///< Reuse album dir, skip tracks finished earlier
+
     // Display fields (populated from probe, used for list columns)
     QString albumTitle;
     QString albumArtist;
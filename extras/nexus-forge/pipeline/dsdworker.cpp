@@ -131,8 +131,10 @@ int DsdWorker::configurePipeline(const DsdPipeParameters &param)
             char *album_dir = dsdpipe_get_album_dir(&album_meta, dir_format);
             if (album_dir) {
                 QByteArray baseDir = param.outputDir.toUtf8();
-                char *album_path = sa_unique_path(baseDir.constData(),
-                                                  album_dir, nullptr);
+                /* Resume continues in the existing directory */
+                char *album_path = param.resume
+                    ? sa_make_path(baseDir.constData(), nullptr, album_dir, nullptr)
+                    : sa_unique_path(baseDir.constData(), album_dir, nullptr);
                 if (album_path) {
                     /* Handle multi-disc sets */
                     if (album_meta.disc_total > 1 && album_meta.disc_number > 0) {
@@ -221,6 +223,18 @@ int DsdWorker::configurePipeline(const DsdPipeParameters &param)
     rc = dsdpipe_set_track_filename_format(m_pipe, tfmt);
     if (rc != DSDPIPE_OK) return rc;
 
+    /* === Track completion journal (resume) === */
+    if (param.resume) {
+        char *journal_path = sa_make_path(outDir.constData(), nullptr,
+                                          DSDPIPE_JOURNAL_NAME,
+                                          DSDPIPE_JOURNAL_EXT);
+        if (journal_path) {
+            rc = dsdpipe_set_journal(m_pipe, journal_path);
+            sa_free(journal_path);
+            if (rc != DSDPIPE_OK) return rc;
+        }
+    }
+
     /* === Set progress callback === */
     rc = dsdpipe_set_progress_callback(m_pipe,
         &DsdWorker::progressCallback,
@@ -418,6 +418,7 @@ void ConvertList::editSelectedParameters()
                 task->param.trackFormat = edited.trackFormat;
                 task->param.albumFormat = edited.albumFormat;
                 task->param.outputDir = edited.outputDir;
+                task->param.resume = edited.resume;
                 task->param.formatSummary = task->param.buildFormatSummary();
 
                 // Update list columns
@@ -657,6 +658,7 @@ void ConvertList::slotDoubleClick(QModelIndex index)
                         task->param.trackFormat = edited.trackFormat;
                         task->param.albumFormat = edited.albumFormat;
                         task->param.outputDir = edited.outputDir;
+                        task->param.resume = edited.resume;
                         task->param.formatSummary = task->param.buildFormatSummary();
 
                         item->setText(COL_FORMATS, task->param.formatSummary);
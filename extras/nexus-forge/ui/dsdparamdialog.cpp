@@ -74,6 +74,7 @@ void DsdParamDialog::setParameters(const DsdPipeParameters &param)
 
     // Output directory
     m_editOutputDir->setText(param.outputDir);
+    m_chkResume->setChecked(param.resume);
 
     updatePcmOptionsEnabled();
 }
@@ -109,6 +110,7 @@ DsdPipeParameters DsdParamDialog::parameters() const
 
     // Output
     p.outputDir = m_editOutputDir->text();
+    p.resume = m_chkResume->isChecked();
 
     p.formatSummary = p.buildFormatSummary();
 
@@ -249,6 +251,10 @@ void DsdParamDialog::setupUi()
 
         connect(btnBrowse, &QPushButton::clicked,
                 this, &DsdParamDialog::slotBrowseOutput);
+
+        m_chkResume = new QCheckBox(
+            tr("Resume: reuse the album folder and skip finished tracks"), this);
+        mainLayout->addWidget(m_chkResume);
     }
 
     // Buttons
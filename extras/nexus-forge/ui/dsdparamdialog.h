@@ -65,6 +65,7 @@ private:
 
     QCheckBox *m_chkWriteId3;
     QCheckBox *m_chkWriteDst;
+    QCheckBox *m_chkResume;
 
     QComboBox *m_cboTrackFormat;
     QComboBox *m_cboAlbumFormat;
@@ -52,6 +52,9 @@ typedef struct {
     int threads;
     int cache_timeout;
     int max_isos;
+    int block_cache;    /* decoded block cache in MiB, 0 = disabled */
+    char *cache_dir;    /* transcode cache directory, NULL = disabled */
+    int cache_size;     /* transcode cache budget in MiB */
     int foreground;
     int debug;
     int verbose;        /* verbosity counter: -v increments */
@@ -59,6 +62,9 @@ typedef struct {
     int help;
     int stereo;         /* 1 = show stereo, 0 = hide (with fallback) */
     int multichannel;   /* 1 = show multichannel, 0 = hide (with fallback) */
+    int dff;            /* 1 = also list DST tracks as DSDIFF/DST .dff */
+    int wav;            /* sample rate of .wav renditions, 0 = off */
+    int wav_bits;       /* sample size of .wav renditions */
 } mount_options_t;
 
 static mount_options_t g_options = {
@@ -67,13 +73,19 @@ static mount_options_t g_options = {
     0,      /* threads - Auto */
     300,    /* cache_timeout - 5 minutes */
     0,      /* max_isos - Unlimited */
+    64,     /* block_cache - 64 MiB */
+    NULL,   /* cache_dir - Disabled */
+    4096,   /* cache_size - 4 GiB */
     0,      /* foreground */
     0,      /* debug */
     0,      /* verbose */
     -1,     /* log_level - Unset */
     0,      /* help */
     1,      /* stereo - Show by default */
-    1       /* multichannel - Show by default */
+    1,      /* multichannel - Show by default */
+    0,      /* dff - Off by default */
+    0,      /* wav - Off by default */
+    24      /* wav_bits */
 };
 
 /* Global context for signal handler */
@@ -161,8 +173,14 @@ static void print_usage(const char *prog)
         "  /threads:N          Number of DST decoder threads (default: auto)\n"
         "  /cache_timeout:N    ISO cache timeout in seconds (default: 300)\n"
         "  /max_isos:N         Maximum concurrent ISO mounts (default: unlimited)\n"
+        "  /block_cache:N      Decoded DST block cache in MiB, 0 = off (default: 64)\n"
+        "  /cache_dir:PATH     Keep decoded DST tracks in PATH across mounts\n"
+        "  /cache_size:N       Size limit of cache_dir in MiB (default: 4096)\n"
         "  /no_stereo          Hide stereo area (unless it's the only area)\n"
         "  /no_multichannel    Hide multichannel area (unless it's the only area)\n"
+        "  /dff                Also list DST tracks as undecoded DSDIFF/DST .dff files\n"
+        "  /wav:RATE           Also list tracks as WAV converted at RATE Hz (e.g. 88200)\n"
+        "  /wav_bits:N         Sample size of the WAV files, 16 or 24 (default: 24)\n"
         "  /v                  Increase verbosity (-v=verbose, -vv=debug, -vvv=trace)\n"
         "  /log_level:LEVEL    Set log level (quiet/error/warning/info/verbose/debug/trace)\n"
         "  /f                  Foreground mode (don't daemonize)\n"
@@ -172,8 +190,14 @@ static void print_usage(const char *prog)
         "  -o threads=N        Number of DST decoder threads (default: auto)\n"
         "  -o cache_timeout=N  ISO cache timeout in seconds (default: 300)\n"
         "  -o max_isos=N       Maximum concurrent ISO mounts (default: unlimited)\n"
+        "  -o block_cache=N    Decoded DST block cache in MiB, 0 = off (default: 64)\n"
+        "  -o cache_dir=PATH   Keep decoded DST tracks in PATH across mounts\n"
+        "  -o cache_size=N     Size limit of cache_dir in MiB (default: 4096)\n"
         "  -o no_stereo        Hide stereo area (unless it's the only area)\n"
         "  -o no_multichannel  Hide multichannel area (unless it's the only area)\n"
+        "  -o dff              Also list DST tracks as undecoded DSDIFF/DST .dff files\n"
+        "  -o wav=RATE         Also list tracks as WAV converted at RATE Hz (e.g. 88200)\n"
+        "  -o wav_bits=N       Sample size of the WAV files, 16 or 24 (default: 24)\n"
         "  -v                  Increase verbosity (-v=verbose, -vv=debug, -vvv=trace)\n"
         "  -o log_level=LEVEL  Set log level (quiet/error/warning/info/verbose/debug/trace)\n"
         "  -f                  Foreground mode (don't daemonize)\n"
@@ -185,15 +209,17 @@ static void print_usage(const char *prog)
 #ifdef _WIN32
         "  %s D:\\SACD S:\n"
         "  %s /threads:4 /no_multichannel D:\\SACD S:\n"
+        "  %s /cache_dir:C:\\SacdCache /cache_size:20000 D:\\SACD S:\n"
 #else
         "  %s /media/sacd /mnt/sacd-vfs\n"
         "  %s -f -o threads=4 -o no_multichannel /media/sacd /mnt/sacd-vfs\n"
+        "  %s -o cache_dir=/var/cache/sacd-vfs,cache_size=20000 /media/sacd /mnt/sacd-vfs\n"
 #endif
         "\n"
         "When mounted, SACD ISO files appear as directories containing DSF files.\n"
         "The original directory structure is preserved (shadow copied).\n"
         "\n",
-        prog, prog, prog);
+        prog, prog, prog, prog);
 }
 
 /* =============================================================================
@@ -216,6 +242,12 @@ static int parse_options(int argc, char *argv[])
                 g_options.cache_timeout = atoi(opt + 14);
             } else if (strncmp(opt, "max_isos:", 9) == 0) {
                 g_options.max_isos = atoi(opt + 9);
+            } else if (strncmp(opt, "block_cache:", 12) == 0) {
+                g_options.block_cache = atoi(opt + 12);
+            } else if (strncmp(opt, "cache_dir:", 10) == 0) {
+                g_options.cache_dir = opt + 10;
+            } else if (strncmp(opt, "cache_size:", 11) == 0) {
+                g_options.cache_size = atoi(opt + 11);
             } else if (strcmp(opt, "f") == 0) {
                 g_options.foreground = 1;
             } else if (strcmp(opt, "v") == 0) {
@@ -233,6 +265,12 @@ static int parse_options(int argc, char *argv[])
                 g_options.stereo = 0;
             } else if (strcmp(opt, "no_multichannel") == 0) {
                 g_options.multichannel = 0;
+            } else if (strcmp(opt, "dff") == 0) {
+                g_options.dff = 1;
+            } else if (strncmp(opt, "wav:", 4) == 0) {
+                g_options.wav = atoi(opt + 4);
+            } else if (strncmp(opt, "wav_bits:", 9) == 0) {
+                g_options.wav_bits = atoi(opt + 9);
             } else if (strcmp(opt, "h") == 0 || strcmp(opt, "help") == 0 ||
                        strcmp(opt, "?") == 0) {
                 g_options.help = 1;
@@ -261,6 +299,45 @@ static int parse_options(int argc, char *argv[])
 }
 
 #else
+/**
+ * Apply one option of a -o list. The value is kept by pointer, so @p opt
+ * must stay valid (it points into argv).
+ */
+static int _parse_mount_option(char *opt)
+{
+    if (strncmp(opt, "threads=", 8) == 0) {
+        g_options.threads = atoi(opt + 8);
+    } else if (strncmp(opt, "cache_timeout=", 14) == 0) {
+        g_options.cache_timeout = atoi(opt + 14);
+    } else if (strncmp(opt, "max_isos=", 9) == 0) {
+        g_options.max_isos = atoi(opt + 9);
+    } else if (strncmp(opt, "block_cache=", 12) == 0) {
+        g_options.block_cache = atoi(opt + 12);
+    } else if (strncmp(opt, "cache_dir=", 10) == 0) {
+        g_options.cache_dir = opt + 10;
+    } else if (strncmp(opt, "cache_size=", 11) == 0) {
+        g_options.cache_size = atoi(opt + 11);
+    } else if (strcmp(opt, "no_stereo") == 0) {
+        g_options.stereo = 0;
+    } else if (strcmp(opt, "no_multichannel") == 0) {
+        g_options.multichannel = 0;
+    } else if (strcmp(opt, "dff") == 0) {
+        g_options.dff = 1;
+    } else if (strncmp(opt, "wav=", 4) == 0) {
+        g_options.wav = atoi(opt + 4);
+    } else if (strncmp(opt, "wav_bits=", 9) == 0) {
+        g_options.wav_bits = atoi(opt + 9);
+    } else if (strncmp(opt, "log_level=", 10) == 0) {
+        g_options.log_level = _parse_log_level(opt + 10);
+        if (g_options.log_level < 0) {
+            fprintf(stderr, "Unknown log level: %s\n", opt + 10);
+            return -1;
+        }
+    }
+    /* Other -o options are passed to FUSE */
+    return 0;
+}
+
 static int parse_options(int argc, char *argv[])
 {
     static struct option long_options[] = {
@@ -282,25 +359,17 @@ static int parse_options(int argc, char *argv[])
             g_options.verbose++;
             break;
         case 'o':
-            /* Parse -o options */
-            if (strncmp(optarg, "threads=", 8) == 0) {
-                g_options.threads = atoi(optarg + 8);
-            } else if (strncmp(optarg, "cache_timeout=", 14) == 0) {
-                g_options.cache_timeout = atoi(optarg + 14);
-            } else if (strncmp(optarg, "max_isos=", 9) == 0) {
-                g_options.max_isos = atoi(optarg + 9);
-            } else if (strcmp(optarg, "no_stereo") == 0) {
-                g_options.stereo = 0;
-            } else if (strcmp(optarg, "no_multichannel") == 0) {
-                g_options.multichannel = 0;
-            } else if (strncmp(optarg, "log_level=", 10) == 0) {
-                g_options.log_level = _parse_log_level(optarg + 10);
-                if (g_options.log_level < 0) {
-                    fprintf(stderr, "Unknown log level: %s\n", optarg + 10);
+            /* Parse -o options, which may be comma separated */
+            for (char *o = optarg; o; ) {
+                char *comma = strchr(o, ',');
+                if (comma) {
+                    *comma = '\0';
+                }
+                if (_parse_mount_option(o) != 0) {
                     return -1;
                 }
+                o = comma ? comma + 1 : NULL;
             }
-            /* Other -o options are passed to FUSE */
             break;
         case 'h':
             g_options.help = 1;
@@ -391,8 +460,16 @@ int main(int argc, char *argv[])
     config.thread_pool_size = g_options.threads;
     config.cache_timeout_seconds = g_options.cache_timeout;
     config.max_open_isos = g_options.max_isos;
+    config.block_cache_size = g_options.block_cache > 0
+        ? (size_t)g_options.block_cache * 1024 * 1024 : 0;
+    config.disk_cache_dir = g_options.cache_dir;
+    config.disk_cache_size = g_options.cache_size > 0
+        ? (uint64_t)g_options.cache_size * 1024 * 1024 : 0;
     config.stereo_visible = g_options.stereo ? true : false;
     config.multichannel_visible = g_options.multichannel ? true : false;
+    config.dst_passthrough = g_options.dff ? true : false;
+    config.pcm_sample_rate = g_options.wav > 0 ? (uint32_t)g_options.wav : 0;
+    config.pcm_bits = (uint16_t)g_options.wav_bits;
 
     g_ctx = sacd_overlay_create(&config);
     if (!g_ctx) {
@@ -500,6 +577,29 @@ cleanup:
     fuse_opt_free_args(&args);
 
     if (g_ctx) {
+        sacd_vfs_block_cache_stats_t stats;
+        if (sacd_overlay_get_block_cache_stats(g_ctx, &stats) == SACD_OVERLAY_OK) {
+            sa_log(NULL, SA_LOG_INFO,
+                   "Block cache: %llu hits, %llu misses, %llu evictions, "
+                   "%llu of %llu bytes in use\n",
+                   (unsigned long long)stats.hits,
+                   (unsigned long long)stats.misses,
+                   (unsigned long long)stats.evictions,
+                   (unsigned long long)stats.bytes,
+                   (unsigned long long)stats.max_bytes);
+        }
+        sacd_vfs_disk_cache_stats_t disk_stats;
+        if (sacd_overlay_get_disk_cache_stats(g_ctx, &disk_stats) == SACD_OVERLAY_OK) {
+            sa_log(NULL, SA_LOG_INFO,
+                   "Disk cache: %llu hits, %llu misses, %llu blocks written, "
+                   "%u tracks, %llu of %llu bytes in use\n",
+                   (unsigned long long)disk_stats.hits,
+                   (unsigned long long)disk_stats.misses,
+                   (unsigned long long)disk_stats.writes,
+                   disk_stats.files,
+                   (unsigned long long)disk_stats.bytes,
+                   (unsigned long long)disk_stats.max_bytes);
+        }
         sacd_overlay_destroy(g_ctx);
         g_ctx = NULL;
     }
@@ -106,7 +106,8 @@ typedef enum dsdpipe_source_type_e {
     DSDPIPE_SOURCE_NONE = 0,       /**< No source configured */
     DSDPIPE_SOURCE_SACD,           /**< SACD ISO image via libsacd */
     DSDPIPE_SOURCE_DSDIFF,         /**< DSDIFF file via libdsdiff */
-    DSDPIPE_SOURCE_DSF             /**< DSF file via libdsf */
+    DSDPIPE_SOURCE_DSF,            /**< DSF file via libdsf */
+    DSDPIPE_SOURCE_STREAM          /**< Raw DSD or DSF read from a file descriptor */
 } dsdpipe_source_type_t;
 
 /**
@@ -121,9 +122,21 @@ typedef enum dsdpipe_sink_type_e {
     DSDPIPE_SINK_PRINT,            /**< Human-readable text output */
     DSDPIPE_SINK_XML,              /**< XML metadata export */
     DSDPIPE_SINK_CUE,              /**< CUE sheet generation */
-    DSDPIPE_SINK_ID3               /**< ID3v2.4 tag file */
+    DSDPIPE_SINK_ID3,              /**< ID3v2.4 tag file */
+    DSDPIPE_SINK_LOUDNESS,         /**< Loudness/peak analysis (no file output) */
+    DSDPIPE_SINK_STREAM            /**< Non-seekable output to a file descriptor */
 } dsdpipe_sink_type_t;
 
+/**
+ * @brief Output format of a stream sink
+ */
+typedef enum dsdpipe_stream_format_e {
+    DSDPIPE_STREAM_RAW_DSD = 0,    /**< Byte-interleaved DSD, MSB first (DSDIFF order) */
+    DSDPIPE_STREAM_RAW_PCM,        /**< Interleaved little-endian signed PCM */
+    DSDPIPE_STREAM_WAV,            /**< WAV with streaming (unknown) chunk sizes */
+    DSDPIPE_STREAM_FLAC            /**< FLAC without seek table or totals */
+} dsdpipe_stream_format_t;
+
 /**
  * @brief Channel type for SACD source selection
  */
@@ -213,6 +226,28 @@ typedef struct dsdpipe_metadata_s {
     metadata_tags_t *tags;          /**< Key-value tag storage (may be NULL) */
 } dsdpipe_metadata_t;
 
+/*============================================================================
+ * Loudness Measurement
+ *============================================================================*/
+
+/**
+ * @brief Loudness and peak measurement (EBU R128 / ITU-R BS.1770-4)
+ *
+ * Produced by the loudness analysis sink for every track and for the
+ * whole album (all processed tracks).
+ */
+typedef struct dsdpipe_loudness_s {
+    bool valid;                     /**< false if no block passed the gates */
+    double integrated_lufs;         /**< Integrated loudness (LUFS) */
+    double loudness_range_lu;       /**< Loudness range, LRA (LU) */
+    double max_momentary_lufs;      /**< Highest momentary (400 ms) loudness */
+    double max_short_term_lufs;     /**< Highest short-term (3 s) loudness */
+    double sample_peak;             /**< Sample peak (linear, 1.0 = 0 dBFS) */
+    double true_peak;               /**< True peak (linear, 1.0 = 0 dBTP) */
+    double true_peak_dbtp;          /**< True peak (dBTP) */
+    double replaygain_db;           /**< ReplayGain 2.0 gain to -18 LUFS (dB) */
+} dsdpipe_loudness_t;
+
 /*============================================================================
  * Progress Information
  *============================================================================*/
@@ -315,6 +350,24 @@ int DSDPIPE_API dsdpipe_set_source_dsdiff(dsdpipe_t *pipe, const char *path);
  */
 int DSDPIPE_API dsdpipe_set_source_dsf(dsdpipe_t *pipe, const char *path);
 
+/**
+ * @brief Set a file descriptor (e.g. stdin) as source
+ *
+ * Reads the stream strictly sequentially, so pipes and sockets work. A
+ * stream that starts with a DSF header is parsed as DSF; anything else is
+ * taken as byte-interleaved raw DSD (MSB first) in @p raw_format. The
+ * stream is presented as a single track; seeking within it is done by
+ * reading ahead. The descriptor is not closed by the pipeline.
+ *
+ * @param pipe Pipeline handle
+ * @param fd Open readable file descriptor
+ * @param raw_format Format of raw DSD input (sample_rate and channel_count
+ *                   are required), or NULL to accept DSF only
+ * @return DSDPIPE_OK on success, error code otherwise
+ */
+int DSDPIPE_API dsdpipe_set_source_stream(dsdpipe_t *pipe, int fd,
+                                          const dsdpipe_format_t *raw_format);
+
 /**
  * @brief Get the currently configured source type
  *
@@ -398,6 +451,29 @@ int DSDPIPE_API dsdpipe_get_selected_tracks(dsdpipe_t *pipe,
                                  size_t max_count,
                                  size_t *count);
 
+/**
+ * @brief Select a time range of a single track
+ *
+ * Replaces the track selection with @p track_number and extracts only
+ * [start_ms, end_ms) of it. The source is positioned at the nearest frame
+ * (SACD access list, DSDIFF DSTI index, DSF block seek), so only the frames
+ * covering the range plus the DSD-to-PCM filter pre-roll are read and
+ * decoded. PCM output is trimmed to the exact sample, DSD output to the
+ * byte (8 DSD samples), and DST passthrough output to the frame (1/75 s).
+ *
+ * Any other track selection call clears the range.
+ *
+ * @param pipe Pipeline handle
+ * @param track_number Track number (1-based)
+ * @param start_ms Range start in milliseconds from track start
+ * @param end_ms Range end in milliseconds from track start (0 = end of track)
+ * @return DSDPIPE_OK on success, error code otherwise
+ */
+int DSDPIPE_API dsdpipe_select_range(dsdpipe_t *pipe,
+                          uint8_t track_number,
+                          uint32_t start_ms,
+                          uint32_t end_ms);
+
 /*============================================================================
  * Sink Configuration Functions
  *============================================================================*/
@@ -460,6 +536,31 @@ int DSDPIPE_API dsdpipe_add_sink_flac(dsdpipe_t *pipe,
                            int bit_depth,
                            int compression);
 
+/**
+ * @brief Add a non-seekable output sink writing to a file descriptor
+ *
+ * All selected tracks are written as one continuous stream and the sink
+ * never seeks, so the output can be a pipe (e.g. stdout). WAV output
+ * carries the conventional 0xFFFFFFFF streaming sizes; FLAC output has no
+ * sample count or MD5 in STREAMINFO. The descriptor is not closed by the
+ * pipeline.
+ *
+ * FLAC output uses the encoder threads set with dsdpipe_set_flac_threads()
+ * before this call.
+ *
+ * @param pipe Pipeline handle
+ * @param fd Open writable file descriptor
+ * @param format Output format
+ * @param bit_depth PCM bit depth (16, 24, or 32; FLAC 16 or 24), ignored
+ *                  for raw DSD
+ * @param compression FLAC compression level (0-8, default 5), ignored for
+ *                    other formats
+ * @return DSDPIPE_OK on success, error code otherwise
+ */
+int DSDPIPE_API dsdpipe_add_sink_stream(dsdpipe_t *pipe, int fd,
+                                        dsdpipe_stream_format_t format,
+                                        int bit_depth, int compression);
+
 /**
  * @brief Add a human-readable text metadata sink
  *
@@ -514,6 +615,33 @@ int DSDPIPE_API dsdpipe_add_sink_id3(dsdpipe_t *pipe,
                           const char *output_path,
                           bool per_track);
 
+/**
+ * @brief Add loudness analysis sink
+ *
+ * Measures integrated loudness, loudness range and true peak of the PCM
+ * stream produced by the DSD-to-PCM converter, per track and per album,
+ * in the same pass as the conversion. Results are written as ReplayGain
+ * tags to FLAC output, as BWF loudness fields to WAV output and into the
+ * XML export, and can be queried with dsdpipe_get_loudness().
+ *
+ * @param pipe Pipeline handle
+ * @return DSDPIPE_OK on success, error code otherwise
+ */
+int DSDPIPE_API dsdpipe_add_sink_loudness(dsdpipe_t *pipe);
+
+/**
+ * @brief Get a loudness measurement from the last run
+ *
+ * @param pipe Pipeline handle
+ * @param track_number Track number (1-based), or 0 for the album
+ * @param loudness Receives the measurement
+ * @return DSDPIPE_OK on success, DSDPIPE_ERROR_NOT_CONFIGURED if no
+ *         loudness sink was added, DSDPIPE_ERROR_TRACK_NOT_FOUND if the
+ *         track was not measured
+ */
+int DSDPIPE_API dsdpipe_get_loudness(dsdpipe_t *pipe, uint8_t track_number,
+                                     dsdpipe_loudness_t *loudness);
+
 /**
  * @brief Render ID3v2.4 tag to buffer
  *
@@ -571,6 +699,19 @@ int DSDPIPE_API dsdpipe_set_pcm_quality(dsdpipe_t *pipe, dsdpipe_pcm_quality_t q
  */
 int DSDPIPE_API dsdpipe_set_pcm_use_fp64(dsdpipe_t *pipe, bool use_fp64);
 
+/**
+ * @brief Set the number of FLAC encoder threads
+ *
+ * FLAC frames are encoded in parallel and written in order when libFLAC
+ * supports it (version 1.5 or later); otherwise this setting has no
+ * effect. Applies to FLAC file and stream sinks added after the call.
+ *
+ * @param pipe Pipeline handle
+ * @param threads Encoder threads (0 = one per CPU, the default; 1 = off)
+ * @return DSDPIPE_OK on success, error code otherwise
+ */
+int DSDPIPE_API dsdpipe_set_flac_threads(dsdpipe_t *pipe, int threads);
+
 /**
  * @brief Set track filename format for output sinks
  *
@@ -592,6 +733,35 @@ int DSDPIPE_API dsdpipe_set_track_filename_format(dsdpipe_t *pipe,
  */
 dsdpipe_track_format_t DSDPIPE_API dsdpipe_get_track_filename_format(dsdpipe_t *pipe);
 
+/** File name (without extension) of the journal that front ends keep in
+ * the album output directory */
+#define DSDPIPE_JOURNAL_NAME "dsdctl-resume"
+
+/** Extension of the journal file */
+#define DSDPIPE_JOURNAL_EXT "journal"
+
+/**
+ * @brief Enable the per-track completion journal (resumable conversion)
+ *
+ * When set, dsdpipe_run() records every track whose per-track output files
+ * were written successfully, together with the source identity (path, size,
+ * modification time), the sink configuration, the dsdpipe_select_range()
+ * excerpt if any, and the output file size.
+ * A later run with the same journal, source and sink configuration skips
+ * tracks whose outputs are still intact and redoes only missing or partial
+ * ones. Metadata-only sinks (XML, CUE, print) still see every track.
+ *
+ * Skipping is only applied when every audio sink writes one file per
+ * track; with a DSDIFF Edit Master or stream sink all tracks are always
+ * processed. The loudness sink writes no files and does not prevent
+ * skipping, but it does not measure skipped tracks.
+ *
+ * @param pipe Pipeline handle
+ * @param journal_path Journal file path, or NULL to disable
+ * @return DSDPIPE_OK on success, error code otherwise
+ */
+int DSDPIPE_API dsdpipe_set_journal(dsdpipe_t *pipe, const char *journal_path);
+
 /*============================================================================
  * Progress and Execution
  *============================================================================*/
@@ -22,6 +22,7 @@
 #include "dsdpipe_internal.h"
 #include "frame_queue.h"
 #include "reader_thread.h"
+#include "journal.h"
 #include <libdsdpipe/version.h>
 
 #include <string.h>
@@ -265,6 +266,8 @@ void dsdpipe_destroy(dsdpipe_t *pipe)
     /* Free buffer pools */
     dsdpipe_free_pools(pipe);
 
+    sa_free(pipe->source_path);
+    sa_free(pipe->journal_path);
     sa_free(pipe);
 }
 
@@ -283,6 +286,7 @@ int dsdpipe_reset(dsdpipe_t *pipe)
 
     /* Clear track selection */
     dsdpipe_track_selection_clear(&pipe->tracks);
+    pipe->range_active = false;
 
     /* Clear transforms */
     if (pipe->dst_decoder) {
@@ -312,6 +316,15 @@ int dsdpipe_reset(dsdpipe_t *pipe)
  * Source Configuration
  *============================================================================*/
 
+/**
+ * @brief Remember the path the source was opened from (resume journal)
+ */
+static void dsdpipe_store_source_path(dsdpipe_t *pipe, const char *path)
+{
+    sa_free(pipe->source_path);
+    pipe->source_path = sa_strdup(path);
+}
+
 int dsdpipe_set_source_sacd(dsdpipe_t *pipe, const char *iso_path,
                              dsdpipe_channel_type_t channel_type)
 {
@@ -344,6 +357,7 @@ int dsdpipe_set_source_sacd(dsdpipe_t *pipe, const char *iso_path,
     }
 
     pipe->source.is_open = true;
+    dsdpipe_store_source_path(pipe, iso_path);
 
     /* Cache format */
     pipe->source.ops->get_format(pipe->source.ctx, &pipe->source.format);
@@ -383,6 +397,7 @@ int dsdpipe_set_source_dsdiff(dsdpipe_t *pipe, const char *path)
     }
 
     pipe->source.is_open = true;
+    dsdpipe_store_source_path(pipe, path);
 
     /* Cache format */
     pipe->source.ops->get_format(pipe->source.ctx, &pipe->source.format);
@@ -421,8 +436,53 @@ int dsdpipe_set_source_dsf(dsdpipe_t *pipe, const char *path)
         return DSDPIPE_ERROR_SOURCE_OPEN;
     }
 
+    pipe->source.is_open = true;
+    dsdpipe_store_source_path(pipe, path);
+
+    /* Cache format */
+    pipe->source.ops->get_format(pipe->source.ctx, &pipe->source.format);
+
+    pipe->state = DSDPIPE_STATE_CONFIGURED;
+    return DSDPIPE_OK;
+}
+
+int dsdpipe_set_source_stream(dsdpipe_t *pipe, int fd,
+                              const dsdpipe_format_t *raw_format)
+{
+    if (!pipe || fd < 0) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (pipe->state == DSDPIPE_STATE_RUNNING) {
+        dsdpipe_set_error(pipe, DSDPIPE_ERROR_ALREADY_RUNNING, NULL);
+        return DSDPIPE_ERROR_ALREADY_RUNNING;
+    }
+
+    /* Destroy existing source */
+    dsdpipe_source_destroy(&pipe->source);
+
+    /* Create new stream source */
+    int result = dsdpipe_source_stream_create(&pipe->source, fd, raw_format);
+    if (result != DSDPIPE_OK) {
+        dsdpipe_set_error(pipe, result, "Failed to create stream source");
+        return result;
+    }
+
+    /* Open the source (reads the DSF header, if any) */
+    result = pipe->source.ops->open(pipe->source.ctx, NULL);
+    if (result != DSDPIPE_OK) {
+        dsdpipe_set_error(pipe, DSDPIPE_ERROR_SOURCE_OPEN,
+                          raw_format ? "Failed to read input stream"
+                                     : "Failed to read DSF input stream");
+        dsdpipe_source_destroy(&pipe->source);
+        return DSDPIPE_ERROR_SOURCE_OPEN;
+    }
+
     pipe->source.is_open = true;
 
+    /* A stream has no identity to resume against */
+    sa_freep(&pipe->source_path);
+
     /* Cache format */
     pipe->source.ops->get_format(pipe->source.ctx, &pipe->source.format);
 
@@ -482,6 +542,7 @@ int dsdpipe_select_tracks(dsdpipe_t *pipe, const uint8_t *track_numbers,
     }
 
     dsdpipe_track_selection_clear(&pipe->tracks);
+    pipe->range_active = false;
 
     for (size_t i = 0; i < count; i++) {
         int result = dsdpipe_track_selection_add(&pipe->tracks, track_numbers[i]);
@@ -506,6 +567,7 @@ int dsdpipe_select_tracks_str(dsdpipe_t *pipe, const char *selection)
     }
 
     dsdpipe_track_selection_clear(&pipe->tracks);
+    pipe->range_active = false;
 
     result = dsdpipe_track_selection_parse(&pipe->tracks, selection, max_track);
     if (result != DSDPIPE_OK) {
@@ -528,6 +590,7 @@ int dsdpipe_select_all_tracks(dsdpipe_t *pipe)
     }
 
     dsdpipe_track_selection_clear(&pipe->tracks);
+    pipe->range_active = false;
 
     for (uint8_t i = 1; i <= count; i++) {
         result = dsdpipe_track_selection_add(&pipe->tracks, i);
@@ -557,6 +620,60 @@ int dsdpipe_get_selected_tracks(dsdpipe_t *pipe, uint8_t *tracks,
     return DSDPIPE_OK;
 }
 
+int dsdpipe_select_range(dsdpipe_t *pipe, uint8_t track_number,
+                         uint32_t start_ms, uint32_t end_ms)
+{
+    if (!pipe) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (end_ms != 0 && end_ms <= start_ms) {
+        dsdpipe_set_error(pipe, DSDPIPE_ERROR_INVALID_ARG,
+                          "Invalid time range: %u-%u ms", start_ms, end_ms);
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    uint8_t count = 0;
+    int result = dsdpipe_get_track_count(pipe, &count);
+    if (result != DSDPIPE_OK) {
+        return result;
+    }
+
+    if (track_number == 0 || track_number > count) {
+        dsdpipe_set_error(pipe, DSDPIPE_ERROR_TRACK_NOT_FOUND,
+                          "Track %u not found", track_number);
+        return DSDPIPE_ERROR_TRACK_NOT_FOUND;
+    }
+
+    /* Reject a start beyond the end of the track when its length is known */
+    uint64_t total_frames = 0;
+    if (pipe->source.ops->get_track_frames &&
+        pipe->source.ops->get_track_frames(pipe->source.ctx, track_number,
+                                           &total_frames) == DSDPIPE_OK &&
+        total_frames > 0) {
+        uint32_t frame_rate = pipe->source.format.frame_rate
+                              ? pipe->source.format.frame_rate : 75;
+        if ((uint64_t)start_ms * frame_rate / 1000 >= total_frames) {
+            dsdpipe_set_error(pipe, DSDPIPE_ERROR_INVALID_ARG,
+                              "Range start %u ms is beyond the end of track %u",
+                              start_ms, track_number);
+            return DSDPIPE_ERROR_INVALID_ARG;
+        }
+    }
+
+    dsdpipe_track_selection_clear(&pipe->tracks);
+    result = dsdpipe_track_selection_add(&pipe->tracks, track_number);
+    if (result != DSDPIPE_OK) {
+        return result;
+    }
+
+    pipe->range_active = true;
+    pipe->range_start_ms = start_ms;
+    pipe->range_end_ms = end_ms;
+
+    return DSDPIPE_OK;
+}
+
 /*============================================================================
  * Sink Configuration
  *============================================================================*/
@@ -593,8 +710,8 @@ int dsdpipe_add_sink_dsf(dsdpipe_t *pipe, const char *output_path, bool write_id
 
     dsdpipe_sink_t *sink = NULL;
     int result = dsdpipe_sink_dsf_create(&sink, &config);
+    sa_free(config.path); /* The sink keeps its own copy */
     if (result != DSDPIPE_OK) {
-        sa_free(config.path);
         dsdpipe_set_error(pipe, result, "Failed to create DSF sink");
         return result;
     }
@@ -623,8 +740,8 @@ int dsdpipe_add_sink_dsdiff(dsdpipe_t *pipe, const char *output_path,
 
     dsdpipe_sink_t *sink = NULL;
     int result = dsdpipe_sink_dsdiff_create(&sink, &config);
+    sa_free(config.path); /* The sink keeps its own copy */
     if (result != DSDPIPE_OK) {
-        sa_free(config.path);
         dsdpipe_set_error(pipe, result, "Failed to create DSDIFF sink");
         return result;
     }
@@ -659,8 +776,8 @@ int dsdpipe_add_sink_wav(dsdpipe_t *pipe, const char *output_path,
 
     dsdpipe_sink_t *sink = NULL;
     int result = dsdpipe_sink_wav_create(&sink, &config);
+    sa_free(config.path); /* The sink keeps its own copy */
     if (result != DSDPIPE_OK) {
-        sa_free(config.path);
         dsdpipe_set_error(pipe, result, "Failed to create WAV sink");
         return result;
     }
@@ -700,6 +817,7 @@ int dsdpipe_add_sink_flac(dsdpipe_t *pipe, const char *output_path,
     config.track_filename_format = pipe->track_filename_format;
     config.opts.flac.bit_depth = bit_depth;
     config.opts.flac.compression = compression;
+    config.opts.flac.threads = pipe->flac_threads;
 
     if (!config.path) {
         return DSDPIPE_ERROR_OUT_OF_MEMORY;
@@ -707,8 +825,8 @@ int dsdpipe_add_sink_flac(dsdpipe_t *pipe, const char *output_path,
 
     dsdpipe_sink_t *sink = NULL;
     int result = dsdpipe_sink_flac_create(&sink, &config);
+    sa_free(config.path); /* The sink keeps its own copy */
     if (result != DSDPIPE_OK) {
-        sa_free(config.path);
         dsdpipe_set_error(pipe, result, "Failed to create FLAC sink");
         return result;
     }
@@ -716,6 +834,74 @@ int dsdpipe_add_sink_flac(dsdpipe_t *pipe, const char *output_path,
     return dsdpipe_add_sink_internal(pipe, sink);
 }
 
+int dsdpipe_add_sink_stream(dsdpipe_t *pipe, int fd,
+                            dsdpipe_stream_format_t format, int bit_depth,
+                            int compression)
+{
+    char label[] = "-";
+
+    if (!pipe || fd < 0) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (format == DSDPIPE_STREAM_FLAC) {
+#ifndef HAVE_LIBFLAC
+        dsdpipe_set_error(pipe, DSDPIPE_ERROR_FLAC_UNAVAILABLE, NULL);
+        return DSDPIPE_ERROR_FLAC_UNAVAILABLE;
+#endif
+        if (bit_depth != 16 && bit_depth != 24) {
+            dsdpipe_set_error(pipe, DSDPIPE_ERROR_INVALID_ARG,
+                              "Invalid bit depth %d for FLAC (must be 16 or 24)",
+                              bit_depth);
+            return DSDPIPE_ERROR_INVALID_ARG;
+        }
+        if (compression < 0 || compression > 8) {
+            dsdpipe_set_error(pipe, DSDPIPE_ERROR_INVALID_ARG,
+                              "Invalid FLAC compression %d (must be 0-8)",
+                              compression);
+            return DSDPIPE_ERROR_INVALID_ARG;
+        }
+    } else if (format == DSDPIPE_STREAM_RAW_PCM || format == DSDPIPE_STREAM_WAV) {
+        if (bit_depth != 16 && bit_depth != 24 && bit_depth != 32) {
+            dsdpipe_set_error(pipe, DSDPIPE_ERROR_INVALID_ARG,
+                              "Invalid bit depth %d (must be 16, 24, or 32)",
+                              bit_depth);
+            return DSDPIPE_ERROR_INVALID_ARG;
+        }
+    } else if (format != DSDPIPE_STREAM_RAW_DSD) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    /* Only one sink can own a stream */
+    for (int i = 0; i < pipe->sink_count; i++) {
+        if (pipe->sinks[i]->type == DSDPIPE_SINK_STREAM &&
+            pipe->sinks[i]->config.opts.stream.fd == fd) {
+            dsdpipe_set_error(pipe, DSDPIPE_ERROR_INVALID_ARG,
+                              "File descriptor %d already has a sink", fd);
+            return DSDPIPE_ERROR_INVALID_ARG;
+        }
+    }
+
+    dsdpipe_sink_config_t config = {0};
+    config.type = DSDPIPE_SINK_STREAM;
+    config.path = label;
+    config.track_filename_format = pipe->track_filename_format;
+    config.opts.stream.fd = fd;
+    config.opts.stream.format = format;
+    config.opts.stream.bit_depth = bit_depth;
+    config.opts.stream.compression = compression;
+    config.opts.stream.threads = pipe->flac_threads;
+
+    dsdpipe_sink_t *sink = NULL;
+    int result = dsdpipe_sink_stream_create(&sink, &config);
+    if (result != DSDPIPE_OK) {
+        dsdpipe_set_error(pipe, result, "Failed to create stream sink");
+        return result;
+    }
+
+    return dsdpipe_add_sink_internal(pipe, sink);
+}
+
 int dsdpipe_add_sink_print(dsdpipe_t *pipe, const char *output_path)
 {
     if (!pipe) {
@@ -816,6 +1002,60 @@ int dsdpipe_add_sink_cue(dsdpipe_t *pipe, const char *output_path,
     return dsdpipe_add_sink_internal(pipe, sink);
 }
 
+int dsdpipe_add_sink_loudness(dsdpipe_t *pipe)
+{
+    if (!pipe) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    /* Allocate sink structure */
+    dsdpipe_sink_t *sink = (dsdpipe_sink_t *)sa_calloc(1, sizeof(dsdpipe_sink_t));
+    if (!sink) {
+        dsdpipe_set_error(pipe, DSDPIPE_ERROR_OUT_OF_MEMORY, "Failed to allocate loudness sink");
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    int result = dsdpipe_sink_loudness_create(sink);
+    if (result != DSDPIPE_OK) {
+        sa_free(sink);
+        dsdpipe_set_error(pipe, result, "Failed to create loudness sink");
+        return result;
+    }
+
+    /* Cache capabilities */
+    sink->caps = sink->ops->get_capabilities(sink->ctx);
+
+    return dsdpipe_add_sink_internal(pipe, sink);
+}
+
+/**
+ * @brief Find the loudness analysis sink, if one was added
+ */
+static dsdpipe_sink_t *dsdpipe_find_loudness_sink(dsdpipe_t *pipe)
+{
+    for (int i = 0; i < pipe->sink_count; i++) {
+        if (pipe->sinks[i]->type == DSDPIPE_SINK_LOUDNESS) {
+            return pipe->sinks[i];
+        }
+    }
+    return NULL;
+}
+
+int dsdpipe_get_loudness(dsdpipe_t *pipe, uint8_t track_number,
+                         dsdpipe_loudness_t *loudness)
+{
+    if (!pipe || !loudness) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    dsdpipe_sink_t *sink = dsdpipe_find_loudness_sink(pipe);
+    if (!sink) {
+        return DSDPIPE_ERROR_NOT_CONFIGURED;
+    }
+
+    return dsdpipe_sink_loudness_get_result(sink->ctx, track_number, loudness);
+}
+
 int dsdpipe_get_sink_count(dsdpipe_t *pipe)
 {
     return pipe ? pipe->sink_count : 0;
@@ -860,6 +1100,16 @@ int dsdpipe_set_pcm_use_fp64(dsdpipe_t *pipe, bool use_fp64)
     return DSDPIPE_OK;
 }
 
+int dsdpipe_set_flac_threads(dsdpipe_t *pipe, int threads)
+{
+    if (!pipe || threads < 0) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    pipe->flac_threads = threads;
+    return DSDPIPE_OK;
+}
+
 int dsdpipe_set_track_filename_format(dsdpipe_t *pipe,
                                        dsdpipe_track_format_t format)
 {
@@ -880,6 +1130,30 @@ dsdpipe_track_format_t dsdpipe_get_track_filename_format(dsdpipe_t *pipe)
     return pipe->track_filename_format;
 }
 
+int dsdpipe_set_journal(dsdpipe_t *pipe, const char *journal_path)
+{
+    if (!pipe) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (pipe->state == DSDPIPE_STATE_RUNNING) {
+        dsdpipe_set_error(pipe, DSDPIPE_ERROR_ALREADY_RUNNING, NULL);
+        return DSDPIPE_ERROR_ALREADY_RUNNING;
+    }
+
+    char *copy = NULL;
+    if (journal_path) {
+        copy = sa_strdup(journal_path);
+        if (!copy) {
+            return DSDPIPE_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+    sa_free(pipe->journal_path);
+    pipe->journal_path = copy;
+    return DSDPIPE_OK;
+}
+
 /*============================================================================
  * Progress
  *============================================================================*/
@@ -1121,6 +1395,413 @@ static int dsdpipe_write_to_sinks(dsdpipe_t *pipe, dsdpipe_buffer_t *buffer)
     return DSDPIPE_OK;
 }
 
+/*============================================================================
+ * Resume Journal Helpers
+ *============================================================================*/
+
+/**
+ * @brief Check whether a sink writes audio (and thus track output files)
+ */
+static bool dsdpipe_sink_writes_audio(const dsdpipe_sink_t *sink)
+{
+    return (sink->caps & (DSDPIPE_SINK_CAP_DSD | DSDPIPE_SINK_CAP_DST |
+                          DSDPIPE_SINK_CAP_PCM)) != 0;
+}
+
+/**
+ * @brief Check whether a sink writes per-track output files
+ *
+ * The loudness sink analyses audio but writes nothing, so it has no outputs
+ * to journal and does not keep a track from being skipped.
+ */
+static bool dsdpipe_sink_writes_files(const dsdpipe_sink_t *sink)
+{
+    return dsdpipe_sink_writes_audio(sink) &&
+           sink->type != DSDPIPE_SINK_LOUDNESS;
+}
+
+/**
+ * @brief Build the journal signature of a sink's output format options
+ */
+static char *dsdpipe_journal_format_sig(const dsdpipe_t *pipe,
+                                        const dsdpipe_sink_t *sink)
+{
+    const dsdpipe_sink_config_t *cfg = &sink->config;
+    unsigned int channels = pipe->source.format.channel_count;
+    unsigned int rate = pipe->source.format.sample_rate;
+
+    switch (sink->type) {
+    case DSDPIPE_SINK_DSF:
+        return sa_asprintf("dsf:ch%u:fs%u:id3=%d", channels, rate,
+                           cfg->opts.dsf.write_id3 ? 1 : 0);
+    case DSDPIPE_SINK_DSDIFF:
+        return sa_asprintf("dff:ch%u:fs%u:dst=%d:id3=%d", channels, rate,
+                           cfg->opts.dsdiff.write_dst ? 1 : 0,
+                           cfg->opts.dsdiff.write_id3 ? 1 : 0);
+    case DSDPIPE_SINK_WAV:
+        return sa_asprintf("wav:ch%u:fs%u:b%d:r%d:q%d:fp%d", channels, rate,
+                           cfg->opts.wav.bit_depth, cfg->opts.wav.sample_rate,
+                           (int)pipe->pcm_quality, pipe->pcm_use_fp64 ? 1 : 0);
+    case DSDPIPE_SINK_FLAC:
+        return sa_asprintf("flac:ch%u:fs%u:b%d:c%d:q%d:fp%d", channels, rate,
+                           cfg->opts.flac.bit_depth, cfg->opts.flac.compression,
+                           (int)pipe->pcm_quality, pipe->pcm_use_fp64 ? 1 : 0);
+    default:
+        return sa_asprintf("sink%d:ch%u:fs%u", (int)sink->type, channels, rate);
+    }
+}
+
+/**
+ * @brief Build the journal signature of a sink's output configuration
+ *
+ * Anything that changes the bytes written for a track must be part of the
+ * signature, so that changing an option invalidates earlier records. A
+ * dsdpipe_select_range() excerpt is written to the same file name as the
+ * whole track, so the range is part of it too.
+ */
+static char *dsdpipe_journal_sink_sig(const dsdpipe_t *pipe,
+                                      const dsdpipe_sink_t *sink)
+{
+    char *sig = dsdpipe_journal_format_sig(pipe, sink);
+    if (!sig || !pipe->range_active) {
+        return sig;
+    }
+
+    char *range_sig = sa_asprintf("%s:range%u-%u", sig, pipe->range_start_ms,
+                                  pipe->range_end_ms);
+    sa_free(sig);
+    return range_sig;
+}
+
+/**
+ * @brief Check whether every audio output of a track is recorded complete
+ */
+static bool dsdpipe_track_is_journaled(dsdpipe_t *pipe, uint8_t track_number,
+                                       const dsdpipe_metadata_t *track_meta)
+{
+    int audio_sinks = 0;
+
+    for (int i = 0; i < pipe->sink_count; i++) {
+        dsdpipe_sink_t *sink = pipe->sinks[i];
+        if (!dsdpipe_sink_writes_files(sink)) {
+            continue;
+        }
+        if (!sink->ops->get_track_path) {
+            return false;
+        }
+
+        char *path = sink->ops->get_track_path(sink->ctx, track_meta);
+        char *sig = dsdpipe_journal_sink_sig(pipe, sink);
+        bool complete = path && sig &&
+            dsdpipe_journal_is_complete(pipe->journal, track_number, sig, path);
+        sa_free(path);
+        sa_free(sig);
+
+        if (!complete) {
+            return false;
+        }
+        audio_sinks++;
+    }
+
+    return audio_sinks > 0;
+}
+
+/**
+ * @brief Record the audio outputs of a finished track in the journal
+ *
+ * Journal write failures are not fatal; the track is simply redone on the
+ * next resume.
+ */
+static void dsdpipe_journal_record_track(dsdpipe_t *pipe, uint8_t track_number,
+                                         const dsdpipe_metadata_t *track_meta)
+{
+    for (int i = 0; i < pipe->sink_count; i++) {
+        dsdpipe_sink_t *sink = pipe->sinks[i];
+        if (!dsdpipe_sink_writes_files(sink) || !sink->ops->get_track_path) {
+            continue;
+        }
+
+        char *path = sink->ops->get_track_path(sink->ctx, track_meta);
+        char *sig = dsdpipe_journal_sink_sig(pipe, sink);
+        if (path && sig) {
+            dsdpipe_journal_record(pipe->journal, track_number, sig, path);
+        }
+        sa_free(path);
+        sa_free(sig);
+    }
+}
+
+/**
+ * @brief Skip a track whose outputs are already complete
+ *
+ * Metadata-only sinks still receive track_start/track_end so that CUE,
+ * XML and print outputs describe the whole selection.
+ */
+static int dsdpipe_skip_track(dsdpipe_t *pipe, uint8_t track_number,
+                              const dsdpipe_metadata_t *track_meta)
+{
+    pipe->progress.track_number = track_number;
+    pipe->progress.track_title = track_meta->track_title;
+    pipe->progress.frames_done = 0;
+    pipe->progress.frames_total = 0;
+    pipe->progress.track_percent = 100.0f;
+
+    for (int i = 0; i < pipe->sink_count; i++) {
+        dsdpipe_sink_t *sink = pipe->sinks[i];
+        if (dsdpipe_sink_writes_audio(sink)) {
+            continue;
+        }
+        if (sink->ops->track_start) {
+            int result = sink->ops->track_start(sink->ctx, track_number,
+                                                track_meta);
+            if (result != DSDPIPE_OK) {
+                dsdpipe_set_error(pipe, result,
+                                  "Failed to start track %d on sink %s",
+                                  track_number, sink->config.path);
+                return result;
+            }
+        }
+        if (sink->ops->track_end) {
+            sink->ops->track_end(sink->ctx, track_number);
+        }
+    }
+
+    if (dsdpipe_report_progress(pipe) != 0) {
+        atomic_store(&pipe->cancelled, 1);
+        return DSDPIPE_ERROR_CANCELLED;
+    }
+
+    return DSDPIPE_OK;
+}
+
+/*============================================================================
+ * Loudness Distribution
+ *============================================================================*/
+
+/**
+ * @brief Hand a loudness measurement to the sinks that store it
+ *
+ * Called before track_end() for a track (track_number > 0) and before
+ * finalize() for the album (track_number == 0), so sinks can put the
+ * values into tags and exports of the same run.
+ */
+static void dsdpipe_distribute_loudness(dsdpipe_t *pipe, uint8_t track_number)
+{
+    dsdpipe_sink_t *meter = dsdpipe_find_loudness_sink(pipe);
+    if (!meter || !meter->is_open) {
+        return;
+    }
+
+    dsdpipe_loudness_t loudness;
+    if (dsdpipe_sink_loudness_measure(meter->ctx, track_number,
+                                      &loudness) != DSDPIPE_OK) {
+        return;
+    }
+
+    for (int i = 0; i < pipe->sink_count; i++) {
+        dsdpipe_sink_t *sink = pipe->sinks[i];
+        if (sink != meter && sink->is_open && sink->ops->set_loudness) {
+            sink->ops->set_loudness(sink->ctx, track_number, &loudness);
+        }
+    }
+}
+
+/*============================================================================
+ * Time Range Helpers
+ *============================================================================*/
+
+/**
+ * @brief Per-track state of a dsdpipe_select_range() extraction
+ *
+ * Frame and DSD positions are relative to the track start. DSD positions
+ * count bytes per channel (8 samples); PCM positions count output samples
+ * per channel on the source timeline, i.e. with the filter delay removed.
+ */
+typedef struct dsdpipe_range_state_s {
+    bool active;                /**< Range extraction for this track */
+    uint64_t read_start;        /**< First frame read from the source */
+    uint64_t read_count;        /**< Frames to read (0 = to end of track) */
+    uint64_t keep_start;        /**< First frame inside the range */
+    uint64_t keep_end;          /**< Frame after the range (UINT64_MAX = track end) */
+    uint64_t frames_seen;       /**< Frames processed so far */
+    uint64_t dsd_bytes_per_frame; /**< DSD bytes per channel per frame */
+    int64_t dsd_start;          /**< First DSD byte per channel to keep */
+    int64_t dsd_end;            /**< DSD byte per channel after the range */
+    int64_t pcm_start;          /**< First PCM sample to keep */
+    int64_t pcm_end;            /**< PCM sample after the range */
+    int64_t pcm_pos;            /**< Position of the next PCM output sample */
+} dsdpipe_range_state_t;
+
+/**
+ * @brief Work out which frames to read and where to cut for a track
+ *
+ * The DSD-to-PCM filter needs about twice its delay of input before the
+ * first kept sample to settle, and its output lags the input by the delay,
+ * so PCM extraction reads that many extra frames on either side.
+ */
+static void dsdpipe_range_setup(dsdpipe_t *pipe, uint64_t total_frames,
+                                dsdpipe_range_state_t *range)
+{
+    memset(range, 0, sizeof(*range));
+    if (!pipe->range_active) {
+        return;
+    }
+
+    uint64_t frame_rate = pipe->source.format.frame_rate
+                          ? pipe->source.format.frame_rate : 75;
+    uint64_t dsd_rate = pipe->source.format.sample_rate;
+    uint64_t samples_per_frame = dsd_rate / frame_rate;
+    if (samples_per_frame == 0) {
+        return;
+    }
+
+    uint64_t start_sample = (uint64_t)pipe->range_start_ms * dsd_rate / 1000;
+    uint64_t end_sample = (uint64_t)pipe->range_end_ms * dsd_rate / 1000;
+
+    range->active = true;
+    range->dsd_bytes_per_frame = samples_per_frame / 8;
+    range->keep_start = start_sample / samples_per_frame;
+    range->dsd_start = (int64_t)(start_sample / 8);
+    if (pipe->range_end_ms != 0) {
+        range->keep_end = (end_sample + samples_per_frame - 1) / samples_per_frame;
+        range->dsd_end = (int64_t)(end_sample / 8);
+    } else {
+        range->keep_end = UINT64_MAX;
+        range->dsd_end = INT64_MAX;
+    }
+    if (total_frames > 0 && range->keep_end > total_frames) {
+        range->keep_end = total_frames;
+    }
+
+    uint64_t read_start = range->keep_start;
+    uint64_t read_end = range->keep_end;
+
+    range->pcm_end = INT64_MAX;
+    if (pipe->dsd2pcm && dsdpipe_needs_pcm(pipe)) {
+        uint64_t pcm_rate = pipe->dsd2pcm->output_format.sample_rate;
+        uint64_t pcm_per_frame = pcm_rate / frame_rate;
+        double delay = 0.0;
+        dsdpipe_transform_dsd2pcm_get_delay(pipe->dsd2pcm, &delay);
+        uint64_t delay_samples = (uint64_t)(delay + 0.5);
+
+        if (pcm_per_frame > 0) {
+            uint64_t pre_roll = (2 * delay_samples + pcm_per_frame - 1) /
+                                pcm_per_frame + 1;
+            uint64_t post_roll = (delay_samples + pcm_per_frame - 1) /
+                                 pcm_per_frame + 1;
+
+            read_start = (read_start > pre_roll) ? read_start - pre_roll : 0;
+            if (read_end != UINT64_MAX) {
+                read_end += post_roll;
+                if (total_frames > 0 && read_end > total_frames) {
+                    read_end = total_frames;
+                }
+            }
+        }
+
+        range->pcm_start = (int64_t)((uint64_t)pipe->range_start_ms * pcm_rate / 1000);
+        if (pipe->range_end_ms != 0) {
+            range->pcm_end = (int64_t)((uint64_t)pipe->range_end_ms * pcm_rate / 1000);
+        }
+        range->pcm_pos = (int64_t)(read_start * pcm_rate / frame_rate) -
+                         (int64_t)delay_samples;
+    }
+
+    range->read_start = read_start;
+    range->read_count = (read_end != UINT64_MAX && read_end > read_start)
+                        ? read_end - read_start : 0;
+}
+
+/**
+ * @brief Narrow a buffer to the part inside [start, end)
+ *
+ * @param in Buffer covering positions [pos, pos + in->size / unit)
+ * @param out Receives a view of @p in (shares its data)
+ * @param unit Bytes per position (all channels)
+ * @return true if any part of the buffer lies inside the range
+ */
+static bool dsdpipe_range_clip(const dsdpipe_buffer_t *in, dsdpipe_buffer_t *out,
+                               int64_t pos, int64_t start, int64_t end,
+                               size_t unit)
+{
+    if (unit == 0) {
+        return false;
+    }
+
+    int64_t count = (int64_t)(in->size / unit);
+    int64_t lo = (pos > start) ? pos : start;
+    int64_t hi = (pos + count < end) ? pos + count : end;
+    if (hi <= lo) {
+        return false;
+    }
+
+    *out = *in;
+    out->data = in->data + (size_t)(lo - pos) * unit;
+    out->size = (size_t)(hi - lo) * unit;
+    return true;
+}
+
+/**
+ * @brief Write the part of a DSD or DST frame that lies inside the range
+ *
+ * DST frames cannot be cut and are passed whole; DSD is cut to the byte.
+ */
+static int dsdpipe_write_dsd_range(dsdpipe_t *pipe,
+                                   const dsdpipe_range_state_t *range,
+                                   dsdpipe_buffer_t *buffer,
+                                   uint64_t frame_index)
+{
+    if (!range->active) {
+        return dsdpipe_write_to_sinks(pipe, buffer);
+    }
+
+    if (frame_index < range->keep_start || frame_index >= range->keep_end) {
+        return DSDPIPE_OK;
+    }
+
+    if (buffer->format.type != DSDPIPE_FORMAT_DSD_RAW) {
+        return dsdpipe_write_to_sinks(pipe, buffer);
+    }
+
+    dsdpipe_buffer_t view;
+    int64_t pos = (int64_t)(frame_index * range->dsd_bytes_per_frame);
+    if (!dsdpipe_range_clip(buffer, &view, pos, range->dsd_start,
+                            range->dsd_end, buffer->format.channel_count)) {
+        return DSDPIPE_OK;
+    }
+
+    return dsdpipe_write_to_sinks(pipe, &view);
+}
+
+/**
+ * @brief Write the part of a PCM buffer that lies inside the range
+ */
+static int dsdpipe_write_pcm_range(dsdpipe_t *pipe, dsdpipe_range_state_t *range,
+                                   dsdpipe_buffer_t *buffer)
+{
+    if (!range->active) {
+        return dsdpipe_write_to_sinks(pipe, buffer);
+    }
+
+    size_t sample_bytes = (buffer->format.type == DSDPIPE_FORMAT_PCM_FLOAT64)
+                          ? sizeof(double) : sizeof(float);
+    size_t unit = sample_bytes * buffer->format.channel_count;
+    if (unit == 0) {
+        return DSDPIPE_OK;
+    }
+
+    int64_t pos = range->pcm_pos;
+    range->pcm_pos += (int64_t)(buffer->size / unit);
+
+    dsdpipe_buffer_t view;
+    if (!dsdpipe_range_clip(buffer, &view, pos, range->pcm_start,
+                            range->pcm_end, unit)) {
+        return DSDPIPE_OK;
+    }
+
+    return dsdpipe_write_to_sinks(pipe, &view);
+}
+
 /*============================================================================
  * Batch Processing Constants and Helpers
  *============================================================================*/
@@ -1166,6 +1847,17 @@ static int dsdpipe_process_track(dsdpipe_t *pipe, uint8_t track_number)
     if (pipe->source.ops->get_track_frames) {
         pipe->source.ops->get_track_frames(pipe->source.ctx, track_number, &total_frames);
     }
+
+    /* Only the frames covering the selected time range are read */
+    dsdpipe_range_state_t range;
+    dsdpipe_range_setup(pipe, total_frames, &range);
+    if (range.active) {
+        if (range.read_count > 0) {
+            total_frames = range.read_count;
+        } else if (total_frames > range.read_start) {
+            total_frames -= range.read_start;
+        }
+    }
     pipe->progress.frames_total = total_frames;
 
     /* Debug: log total frames */
@@ -1211,8 +1903,9 @@ static int dsdpipe_process_track(dsdpipe_t *pipe, uint8_t track_number)
         return DSDPIPE_ERROR_OUT_OF_MEMORY;
     }
 
-    /* Start reading the track */
-    if (dsdpipe_reader_thread_start_track(reader, track_number) != 0) {
+    /* Start reading the track (or the frames covering the range) */
+    if (dsdpipe_reader_thread_start_range(reader, track_number,
+                                          range.read_start, range.read_count) != 0) {
         dsdpipe_reader_thread_destroy(reader);
         dsdpipe_frame_queue_destroy(frame_queue);
         dsdpipe_metadata_free(&track_meta);
@@ -1343,7 +2036,8 @@ static int dsdpipe_process_track(dsdpipe_t *pipe, uint8_t track_number)
         if (dsdpipe_needs_dsd(pipe)) {
             for (size_t j = 0; j < batch_count; j++) {
                 dsdpipe_buffer_t *dsd_buffer = need_dst_decode ? batch_outputs[j] : batch_inputs[j];
-                result = dsdpipe_write_to_sinks(pipe, dsd_buffer);
+                result = dsdpipe_write_dsd_range(pipe, &range, dsd_buffer,
+                                                 range.read_start + range.frames_seen + j);
                 if (result != DSDPIPE_OK) {
                     for (size_t k = j; k < batch_count; k++) {
                         dsdpipe_buffer_unref(batch_inputs[k]);
@@ -1417,7 +2111,7 @@ static int dsdpipe_process_track(dsdpipe_t *pipe, uint8_t track_number)
                 pcm_buffers[j]->track_number = dsd_buffer->track_number;
                 pcm_buffers[j]->flags = dsd_buffer->flags;
 
-                result = dsdpipe_write_to_sinks(pipe, pcm_buffers[j]);
+                result = dsdpipe_write_pcm_range(pipe, &range, pcm_buffers[j]);
                 dsdpipe_buffer_unref(pcm_buffers[j]);
 
                 if (result != DSDPIPE_OK) {
@@ -1460,7 +2154,7 @@ static int dsdpipe_process_track(dsdpipe_t *pipe, uint8_t track_number)
                     goto cleanup;
                 }
 
-                result = dsdpipe_write_to_sinks(pipe, pcm_buffer);
+                result = dsdpipe_write_pcm_range(pipe, &range, pcm_buffer);
                 dsdpipe_buffer_unref(pcm_buffer);
 
                 if (result != DSDPIPE_OK) {
@@ -1483,6 +2177,7 @@ static int dsdpipe_process_track(dsdpipe_t *pipe, uint8_t track_number)
             dsdpipe_buffer_unref(batch_inputs[j]);
             if (batch_outputs[j]) dsdpipe_buffer_unref(batch_outputs[j]);
         }
+        range.frames_seen += batch_count;
 
         /* Update progress */
         if (total_frames > 0) {
@@ -1520,13 +2215,28 @@ cleanup:
         dsdpipe_frame_queue_destroy(frame_queue);
     }
 
+    /* Pass the track loudness on before the sinks close their files */
+    if (result == DSDPIPE_OK && !atomic_load(&pipe->cancelled)) {
+        dsdpipe_distribute_loudness(pipe, track_number);
+    }
+
     /* Notify sinks of track end */
+    bool track_end_ok = true;
     for (int i = 0; i < pipe->sink_count; i++) {
         if (pipe->sinks[i]->ops->track_end) {
-            pipe->sinks[i]->ops->track_end(pipe->sinks[i]->ctx, track_number);
+            if (pipe->sinks[i]->ops->track_end(pipe->sinks[i]->ctx,
+                                               track_number) != DSDPIPE_OK) {
+                track_end_ok = false;
+            }
         }
     }
 
+    /* Record finished outputs so a later run can skip this track */
+    if (pipe->journal && result == DSDPIPE_OK && track_end_ok &&
+        !atomic_load(&pipe->cancelled)) {
+        dsdpipe_journal_record_track(pipe, track_number, &track_meta);
+    }
+
     dsdpipe_metadata_free(&track_meta);
 
     if (atomic_load(&pipe->cancelled)) {
@@ -1599,6 +2309,19 @@ int dsdpipe_run(dsdpipe_t *pipe)
         return result;
     }
 
+    /* Open resume journal */
+    if (pipe->journal_path && pipe->source_path) {
+        result = dsdpipe_journal_open(&pipe->journal, pipe->journal_path,
+                                      pipe->source_path);
+        if (result != DSDPIPE_OK) {
+            dsdpipe_set_error(pipe, result, "Failed to open journal: %s",
+                              pipe->journal_path);
+            dsdpipe_close_sinks(pipe);
+            dsdpipe_metadata_free(&album_meta);
+            return result;
+        }
+    }
+
     /* Set running state */
     pipe->state = DSDPIPE_STATE_RUNNING;
     atomic_store(&pipe->cancelled, 0);
@@ -1609,13 +2332,31 @@ int dsdpipe_run(dsdpipe_t *pipe)
     pipe->progress.bytes_written = 0;
 
     /* Process each selected track */
+    size_t skipped = 0;
     for (size_t i = 0; i < pipe->tracks.count; i++) {
         uint8_t track_num = pipe->tracks.tracks[i];
 
         /* Store selection index for track renumbering in edit master mode */
         pipe->tracks.current_idx = i;
 
-        result = dsdpipe_process_track(pipe, track_num);
+        /* Skip tracks whose outputs the journal records as complete */
+        bool skip = false;
+        if (pipe->journal) {
+            dsdpipe_metadata_t track_meta;
+            dsdpipe_metadata_init(&track_meta);
+            pipe->source.ops->get_track_metadata(pipe->source.ctx, track_num,
+                                                 &track_meta);
+            if (dsdpipe_track_is_journaled(pipe, track_num, &track_meta)) {
+                skip = true;
+                skipped++;
+                result = dsdpipe_skip_track(pipe, track_num, &track_meta);
+            }
+            dsdpipe_metadata_free(&track_meta);
+        }
+
+        if (!skip) {
+            result = dsdpipe_process_track(pipe, track_num);
+        }
         if (result != DSDPIPE_OK) {
             break;
         }
@@ -1625,6 +2366,20 @@ int dsdpipe_run(dsdpipe_t *pipe)
             (float)(i + 1) / (float)pipe->tracks.count * 100.0f;
     }
 
+    /*
+     * Album loudness is only meaningful if every track was measured;
+     * tracks skipped by the journal were not, so no album gain is written
+     * and dsdpipe_get_loudness() reports none for the album.
+     */
+    if (skipped > 0) {
+        dsdpipe_sink_t *meter = dsdpipe_find_loudness_sink(pipe);
+        if (meter) {
+            dsdpipe_sink_loudness_set_album_incomplete(meter->ctx);
+        }
+    } else if (result == DSDPIPE_OK) {
+        dsdpipe_distribute_loudness(pipe, 0);
+    }
+
     /* Finalize sinks */
     for (int i = 0; i < pipe->sink_count; i++) {
         if (pipe->sinks[i]->is_open && pipe->sinks[i]->ops->finalize) {
@@ -1636,6 +2391,8 @@ int dsdpipe_run(dsdpipe_t *pipe)
     dsdpipe_close_sinks(pipe);
 
     /* Cleanup */
+    dsdpipe_journal_close(pipe->journal);
+    pipe->journal = NULL;
     dsdpipe_metadata_free(&album_meta);
 
     /* Update state */
@@ -132,6 +132,19 @@ typedef struct dsdpipe_source_ops_s {
      */
     int (*seek_track)(void *ctx, uint8_t track_number);
 
+    /**
+     * @brief Seek to a frame within the current track (optional)
+     *
+     * Called after seek_track(). The next read_frame() returns the given
+     * frame. Sources that cannot seek return DSDPIPE_ERROR_UNSUPPORTED
+     * (or leave this NULL) and are fast-forwarded by reading instead.
+     *
+     * @param ctx Source context
+     * @param frame Frame offset from track start
+     * @return DSDPIPE_OK on success
+     */
+    int (*seek_frame)(void *ctx, uint64_t frame);
+
     /**
      * @brief Read next frame
      * @param ctx Source context
@@ -267,6 +280,29 @@ typedef struct dsdpipe_sink_ops_s {
      * @param ctx Sink context
      */
     void (*destroy)(void *ctx);
+
+    /**
+     * @brief Get the output file written for a track
+     * @param ctx Sink context (opened)
+     * @param metadata Track metadata, as passed to track_start
+     * @return Allocated path (free with sa_free), or NULL if the sink
+     *         does not write one file per track
+     *
+     * @note Optional - may be NULL. Used by the resume journal.
+     */
+    char *(*get_track_path)(void *ctx, const dsdpipe_metadata_t *metadata);
+
+    /**
+     * @brief Receive a loudness measurement
+     * @param ctx Sink context (opened)
+     * @param track_number Track number (1-based), or 0 for the album
+     * @param loudness Measurement from the loudness sink
+     *
+     * @note Optional - may be NULL. Track results are delivered before
+     *       track_end() of that track, the album result before finalize().
+     */
+    void (*set_loudness)(void *ctx, uint8_t track_number,
+                         const dsdpipe_loudness_t *loudness);
 } dsdpipe_sink_ops_t;
 
 /**
@@ -293,7 +329,15 @@ typedef struct dsdpipe_sink_config_s {
         struct {
             int bit_depth;          /**< PCM bit depth */
             int compression;        /**< FLAC compression level */
+            int threads;            /**< Encoder threads (0 = auto) */
         } flac;
+        struct {
+            int fd;                 /**< Output file descriptor */
+            dsdpipe_stream_format_t format; /**< Output format */
+            int bit_depth;          /**< PCM bit depth */
+            int compression;        /**< FLAC compression level */
+            int threads;            /**< FLAC encoder threads (0 = auto) */
+        } stream;
     } opts;
 } dsdpipe_sink_config_t;
 
@@ -401,6 +445,9 @@ typedef enum dsdpipe_state_e {
     DSDPIPE_STATE_ERROR            /**< Finished with error */
 } dsdpipe_state_t;
 
+/* Resume journal (see journal.h) */
+struct dsdpipe_journal_s;
+
 /**
  * @brief Main pipeline structure
  */
@@ -415,10 +462,16 @@ struct dsdpipe_s {
 
     /* Source */
     dsdpipe_source_t source;       /**< Input source */
+    char *source_path;              /**< Path the source was opened from */
 
     /* Track selection */
     dsdpipe_track_selection_t tracks; /**< Selected tracks */
 
+    /* Time range within the selected track (dsdpipe_select_range) */
+    bool range_active;              /**< Extract a range instead of the whole track */
+    uint32_t range_start_ms;        /**< Range start from track start (ms) */
+    uint32_t range_end_ms;          /**< Range end from track start (ms, 0 = track end) */
+
     /* Sinks */
     dsdpipe_sink_t *sinks[DSDPIPE_MAX_SINKS]; /**< Output sinks */
     int sink_count;                 /**< Number of configured sinks */
@@ -431,6 +484,9 @@ struct dsdpipe_s {
     dsdpipe_pcm_quality_t pcm_quality;  /**< PCM conversion quality */
     bool pcm_use_fp64;              /**< Use double precision for PCM */
 
+    /* Encoder settings */
+    int flac_threads;               /**< FLAC encoder threads (0 = auto) */
+
     /* Filename generation settings */
     dsdpipe_track_format_t track_filename_format;  /**< Track filename format */
 
@@ -443,6 +499,10 @@ struct dsdpipe_s {
     dsdpipe_progress_cb progress_callback; /**< Progress callback */
     void *progress_userdata;        /**< Progress callback userdata */
     dsdpipe_progress_t progress;   /**< Current progress state */
+
+    /* Resume journal */
+    char *journal_path;             /**< Journal file path (NULL = disabled) */
+    struct dsdpipe_journal_s *journal; /**< Open journal during dsdpipe_run() */
 };
 
 /*============================================================================
@@ -535,6 +595,13 @@ int dsdpipe_source_dsdiff_create(dsdpipe_source_t *source);
  */
 int dsdpipe_source_dsf_create(dsdpipe_source_t *source);
 
+/**
+ * @brief Create file descriptor stream source
+ * @param raw_format Format of raw DSD input, or NULL to accept DSF only
+ */
+int dsdpipe_source_stream_create(dsdpipe_source_t *source, int fd,
+                                 const dsdpipe_format_t *raw_format);
+
 /**
  * @brief Destroy source (calls ops->destroy if set)
  */
@@ -575,6 +642,12 @@ int dsdpipe_sink_wav_create(dsdpipe_sink_t **sink,
 int dsdpipe_sink_flac_create(dsdpipe_sink_t **sink,
                               const dsdpipe_sink_config_t *config);
 
+/**
+ * @brief Create file descriptor stream sink
+ */
+int dsdpipe_sink_stream_create(dsdpipe_sink_t **sink,
+                                const dsdpipe_sink_config_t *config);
+
 /**
  * @brief Create Print (text metadata) sink
  */
@@ -595,6 +668,40 @@ int dsdpipe_sink_cue_create(dsdpipe_sink_t *sink, const char *audio_filename);
  */
 int dsdpipe_sink_id3_create(dsdpipe_sink_t *sink, bool per_track);
 
+/**
+ * @brief Create loudness analysis sink
+ */
+int dsdpipe_sink_loudness_create(dsdpipe_sink_t *sink);
+
+/**
+ * @brief Measure loudness of the track in progress or of the album so far
+ * @param ctx Loudness sink context
+ * @param track_number Current track number, or 0 for the album
+ * @param loudness Receives the measurement
+ * @return DSDPIPE_OK, or DSDPIPE_ERROR_TRACK_NOT_FOUND if nothing was measured
+ */
+int dsdpipe_sink_loudness_measure(void *ctx, uint8_t track_number,
+                                  dsdpipe_loudness_t *loudness);
+
+/**
+ * @brief Withhold the album result of the current run
+ *
+ * Used when tracks were skipped, so the album figures would cover only
+ * part of the selection.
+ * @param ctx Loudness sink context
+ */
+void dsdpipe_sink_loudness_set_album_incomplete(void *ctx);
+
+/**
+ * @brief Get a stored loudness result
+ * @param ctx Loudness sink context
+ * @param track_number Track number, or 0 for the album
+ * @param loudness Receives the measurement
+ * @return DSDPIPE_OK, or DSDPIPE_ERROR_TRACK_NOT_FOUND if not measured
+ */
+int dsdpipe_sink_loudness_get_result(void *ctx, uint8_t track_number,
+                                     dsdpipe_loudness_t *loudness);
+
 /**
  * @brief Destroy sink
  */
@@ -617,6 +724,15 @@ int dsdpipe_transform_dsd2pcm_create(dsdpipe_transform_t **transform,
                                       bool use_fp64,
                                       int pcm_sample_rate);
 
+/**
+ * @brief Get the filter delay of an initialized DSD-to-PCM transform
+ * @param transform Transform created by dsdpipe_transform_dsd2pcm_create()
+ * @param delay Receives the delay in output PCM samples
+ * @return DSDPIPE_OK on success
+ */
+int dsdpipe_transform_dsd2pcm_get_delay(dsdpipe_transform_t *transform,
+                                        double *delay);
+
 /**
  * @brief Destroy transform
  */
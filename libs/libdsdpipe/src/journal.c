@@ -0,0 +1,336 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Per-track completion journal for resumable conversions
+ * File format (UTF-8 text, one record per line, tab-separated):
+ *
+ *   # dsdpipe journal v1
+ *   T <track> <src_size> <src_mtime> <sink_sig> <out_size> <src_path> <out_path>
+ *
+ * Records are only ever appended. When the same (track, sink, output) is
+ * recorded more than once the last record wins.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "journal.h"
+
+#include <libsautil/mem.h>
+#include <libsautil/sastring.h>
+#include <libsautil/sa_path.h>
+#include <libsautil/compat.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+#define JOURNAL_HEADER          "# dsdpipe journal v1"
+#define JOURNAL_LINE_MAX        (SA_PATH_MAX * 2 + 256)
+#define JOURNAL_FIELD_COUNT     8
+
+/*============================================================================
+ * Journal Structure
+ *============================================================================*/
+
+typedef struct dsdpipe_journal_entry_s {
+    uint8_t track_number;           /**< Track number (1-based) */
+    char *sink_sig;                 /**< Sink configuration signature */
+    char *output_path;              /**< Output file path */
+    uint64_t output_size;           /**< Output file size when recorded */
+} dsdpipe_journal_entry_t;
+
+struct dsdpipe_journal_s {
+    char *path;                     /**< Journal file path */
+    char *source_path;              /**< Source identity: path */
+    uint64_t source_size;           /**< Source identity: size in bytes */
+    int64_t source_mtime;           /**< Source identity: modification time */
+
+    dsdpipe_journal_entry_t *entries; /**< Valid entries for this source */
+    size_t count;                   /**< Number of entries */
+    size_t capacity;                /**< Allocated entries */
+    bool partial_line;              /**< File ends in a record cut short */
+};
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static int journal_stat_file(const char *path, uint64_t *size, int64_t *mtime)
+{
+    struct stat st;
+
+    if (sa_stat(path, &st) != 0) {
+        return -1;
+    }
+
+    if (size) {
+        *size = (uint64_t)st.st_size;
+    }
+    if (mtime) {
+        *mtime = (int64_t)st.st_mtime;
+    }
+    return 0;
+}
+
+static dsdpipe_journal_entry_t *journal_find(const dsdpipe_journal_t *journal,
+                                             uint8_t track_number,
+                                             const char *sink_sig,
+                                             const char *output_path)
+{
+    for (size_t i = 0; i < journal->count; i++) {
+        dsdpipe_journal_entry_t *entry = &journal->entries[i];
+        if (entry->track_number == track_number &&
+            strcmp(entry->sink_sig, sink_sig) == 0 &&
+            strcmp(entry->output_path, output_path) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Insert or update an in-memory entry
+ */
+static int journal_put(dsdpipe_journal_t *journal, uint8_t track_number,
+                       const char *sink_sig, const char *output_path,
+                       uint64_t output_size)
+{
+    dsdpipe_journal_entry_t *entry = journal_find(journal, track_number,
+                                                  sink_sig, output_path);
+    if (entry) {
+        entry->output_size = output_size;
+        return DSDPIPE_OK;
+    }
+
+    if (journal->count == journal->capacity) {
+        size_t new_capacity = journal->capacity ? journal->capacity * 2 : 32;
+        dsdpipe_journal_entry_t *new_entries = (dsdpipe_journal_entry_t *)
+            sa_realloc(journal->entries, new_capacity * sizeof(*new_entries));
+        if (!new_entries) {
+            return DSDPIPE_ERROR_OUT_OF_MEMORY;
+        }
+        journal->entries = new_entries;
+        journal->capacity = new_capacity;
+    }
+
+    entry = &journal->entries[journal->count];
+    entry->track_number = track_number;
+    entry->output_size = output_size;
+    entry->sink_sig = sa_strdup(sink_sig);
+    entry->output_path = sa_strdup(output_path);
+    if (!entry->sink_sig || !entry->output_path) {
+        sa_freep(&entry->sink_sig);
+        sa_freep(&entry->output_path);
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    journal->count++;
+    return DSDPIPE_OK;
+}
+
+/**
+ * @brief Parse one journal record and add it if it matches the source
+ */
+static void journal_parse_line(dsdpipe_journal_t *journal, char *line)
+{
+    char *fields[JOURNAL_FIELD_COUNT];
+    char *saveptr = NULL;
+    int n = 0;
+
+    line[strcspn(line, "\r\n")] = '\0';
+    if (line[0] != 'T') {
+        return;  /* Header, comment or unknown record */
+    }
+
+    for (char *tok = sa_strtok(line, "\t", &saveptr);
+         tok && n < JOURNAL_FIELD_COUNT;
+         tok = sa_strtok(NULL, "\t", &saveptr)) {
+        fields[n++] = tok;
+    }
+    if (n != JOURNAL_FIELD_COUNT) {
+        return;
+    }
+
+    unsigned long track = strtoul(fields[1], NULL, 10);
+    uint64_t src_size = strtoull(fields[2], NULL, 10);
+    int64_t src_mtime = strtoll(fields[3], NULL, 10);
+    uint64_t out_size = strtoull(fields[5], NULL, 10);
+
+    if (track == 0 || track > DSDPIPE_MAX_TRACKS) {
+        return;
+    }
+
+    /* Drop records written for another source or an older copy of it */
+    if (src_size != journal->source_size ||
+        src_mtime != journal->source_mtime ||
+        strcmp(fields[6], journal->source_path) != 0) {
+        return;
+    }
+
+    journal_put(journal, (uint8_t)track, fields[4], fields[7], out_size);
+}
+
+static int journal_load(dsdpipe_journal_t *journal)
+{
+    FILE *fd = sa_fopen(journal->path, "r");
+    if (!fd) {
+        return DSDPIPE_OK;  /* No journal yet */
+    }
+
+    char *line = (char *)sa_malloc(JOURNAL_LINE_MAX);
+    if (!line) {
+        fclose(fd);
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    while (fgets(line, JOURNAL_LINE_MAX, fd)) {
+        /* An interrupted append leaves a line without its newline */
+        journal->partial_line = strchr(line, '\n') == NULL;
+        journal_parse_line(journal, line);
+    }
+
+    sa_free(line);
+    fclose(fd);
+    return DSDPIPE_OK;
+}
+
+/*============================================================================
+ * Public (internal) API
+ *============================================================================*/
+
+int dsdpipe_journal_open(dsdpipe_journal_t **journal, const char *path,
+                         const char *source_path)
+{
+    if (!journal || !path || !source_path) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    *journal = NULL;
+
+    dsdpipe_journal_t *j = (dsdpipe_journal_t *)sa_calloc(1, sizeof(*j));
+    if (!j) {
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    j->path = sa_strdup(path);
+    j->source_path = sa_strdup(source_path);
+    if (!j->path || !j->source_path) {
+        dsdpipe_journal_close(j);
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    /* Non-file sources (e.g. network) are identified by path alone */
+    if (journal_stat_file(source_path, &j->source_size, &j->source_mtime) != 0) {
+        j->source_size = 0;
+        j->source_mtime = 0;
+    }
+
+    int result = journal_load(j);
+    if (result != DSDPIPE_OK) {
+        dsdpipe_journal_close(j);
+        return result;
+    }
+
+    *journal = j;
+    return DSDPIPE_OK;
+}
+
+void dsdpipe_journal_close(dsdpipe_journal_t *journal)
+{
+    if (!journal) {
+        return;
+    }
+
+    for (size_t i = 0; i < journal->count; i++) {
+        sa_free(journal->entries[i].sink_sig);
+        sa_free(journal->entries[i].output_path);
+    }
+    sa_free(journal->entries);
+    sa_free(journal->path);
+    sa_free(journal->source_path);
+    sa_free(journal);
+}
+
+bool dsdpipe_journal_is_complete(const dsdpipe_journal_t *journal,
+                                 uint8_t track_number,
+                                 const char *sink_sig,
+                                 const char *output_path)
+{
+    if (!journal || !sink_sig || !output_path) {
+        return false;
+    }
+
+    const dsdpipe_journal_entry_t *entry = journal_find(journal, track_number,
+                                                        sink_sig, output_path);
+    if (!entry) {
+        return false;
+    }
+
+    /* A missing, truncated or rewritten output must be redone */
+    uint64_t size = 0;
+    if (journal_stat_file(output_path, &size, NULL) != 0) {
+        return false;
+    }
+
+    return size == entry->output_size;
+}
+
+int dsdpipe_journal_record(dsdpipe_journal_t *journal,
+                           uint8_t track_number,
+                           const char *sink_sig,
+                           const char *output_path)
+{
+    if (!journal || !sink_sig || !output_path) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    uint64_t size = 0;
+    if (journal_stat_file(output_path, &size, NULL) != 0) {
+        return DSDPIPE_ERROR_FILE_WRITE;
+    }
+
+    bool is_new = !sa_file_exists(journal->path);
+    FILE *fd = sa_fopen(journal->path, "a");
+    if (!fd) {
+        return DSDPIPE_ERROR_FILE_CREATE;
+    }
+
+    if (is_new) {
+        fprintf(fd, "%s\n", JOURNAL_HEADER);
+    } else if (journal->partial_line) {
+        /* Terminate the cut-short record so it does not swallow this one */
+        fputc('\n', fd);
+    }
+
+    int written = fprintf(fd, "T\t%u\t%" PRIu64 "\t%" PRId64 "\t%s\t%" PRIu64 "\t%s\t%s\n",
+                          track_number, journal->source_size,
+                          journal->source_mtime, sink_sig, size,
+                          journal->source_path, output_path);
+    int flushed = fflush(fd);
+    fclose(fd);
+
+    if (written < 0 || flushed != 0) {
+        return DSDPIPE_ERROR_FILE_WRITE;
+    }
+    journal->partial_line = false;
+
+    return journal_put(journal, track_number, sink_sig, output_path, size);
+}
@@ -0,0 +1,100 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Per-track completion journal for resumable conversions
+ * The journal is a small append-only text file that records, for every
+ * track a sink finished writing, the identity of the source (path, size,
+ * mtime), the sink configuration signature and the size of the output
+ * file. A later run over the same source and output directory consults the
+ * journal to skip tracks whose outputs are still intact.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBDSDPIPE_JOURNAL_H
+#define LIBDSDPIPE_JOURNAL_H
+
+#include "dsdpipe_internal.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opaque journal type
+ */
+typedef struct dsdpipe_journal_s dsdpipe_journal_t;
+
+/**
+ * @brief Open (or create) a journal for a source
+ *
+ * Existing entries are loaded; entries recorded for a different source
+ * identity (path, size or mtime changed) are ignored.
+ *
+ * @param journal Receives the journal handle
+ * @param path Journal file path
+ * @param source_path Path of the pipeline source
+ * @return DSDPIPE_OK on success, error code otherwise
+ */
+int dsdpipe_journal_open(dsdpipe_journal_t **journal, const char *path,
+                         const char *source_path);
+
+/**
+ * @brief Close a journal and free its resources
+ *
+ * @param journal Journal (may be NULL)
+ */
+void dsdpipe_journal_close(dsdpipe_journal_t *journal);
+
+/**
+ * @brief Check whether a track output is recorded as complete
+ *
+ * The output file must still exist with the recorded size.
+ *
+ * @param journal Journal
+ * @param track_number Track number (1-based)
+ * @param sink_sig Sink configuration signature (no whitespace)
+ * @param output_path Output file written by the sink for this track
+ * @return true if the output is complete and unchanged
+ */
+bool dsdpipe_journal_is_complete(const dsdpipe_journal_t *journal,
+                                 uint8_t track_number,
+                                 const char *sink_sig,
+                                 const char *output_path);
+
+/**
+ * @brief Record a completed track output
+ *
+ * The entry is appended and flushed to disk immediately so that it
+ * survives an interruption of the remaining conversion.
+ *
+ * @param journal Journal
+ * @param track_number Track number (1-based)
+ * @param sink_sig Sink configuration signature (no whitespace)
+ * @param output_path Output file written by the sink for this track
+ * @return DSDPIPE_OK on success, error code otherwise
+ */
+int dsdpipe_journal_record(dsdpipe_journal_t *journal,
+                           uint8_t track_number,
+                           const char *sink_sig,
+                           const char *output_path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBDSDPIPE_JOURNAL_H */
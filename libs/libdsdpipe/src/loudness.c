@@ -0,0 +1,731 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Loudness meter (ITU-R BS.1770-4 / EBU R128)
+ * Signal flow per channel:
+ *
+ *   x -> K-weighting (high shelf + high pass) -> square -> 100 ms sub-blocks
+ *     -> 400 ms momentary blocks (75% overlap) -> gating histogram
+ *     -> 3 s short-term blocks (10 Hz)         -> LRA histogram
+ *   x -> polyphase interpolator (>= 192 kHz)   -> true peak
+ *
+ * Channel state is kept in LOUDNESS_LANES-wide arrays indexed by channel so
+ * that every per-sample loop runs over a fixed lane count. The K-weighting
+ * and true-peak loops process two lanes per SSE2 register on x86 targets
+ * with SSE2 (Release builds disable auto-vectorisation); the scalar loops
+ * are the reference and the fallback.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "loudness.h"
+
+#include <libsautil/mem.h>
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LOUDNESS_SSE2               1
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+#define LOUDNESS_LANES              8       /**< Channel lanes (>= max channels) */
+#define LOUDNESS_MAX_CHANNELS       6
+
+#define LOUDNESS_HIST_BINS          1000    /**< -70 .. +30 LUFS */
+#define LOUDNESS_HIST_MIN           (-70.0)
+#define LOUDNESS_HIST_STEP          0.1
+
+#define LOUDNESS_ABS_GATE           (-70.0) /**< Absolute gate (LUFS) */
+#define LOUDNESS_REL_GATE           (-10.0) /**< Relative gate, integrated (LU) */
+#define LOUDNESS_LRA_REL_GATE       (-20.0) /**< Relative gate, LRA (LU) */
+#define LOUDNESS_LRA_LOW            0.10    /**< LRA lower percentile */
+#define LOUDNESS_LRA_HIGH           0.95    /**< LRA upper percentile */
+
+#define LOUDNESS_MOMENTARY_SUBS     4       /**< 400 ms in 100 ms sub-blocks */
+#define LOUDNESS_SHORT_TERM_SUBS    30      /**< 3 s in 100 ms sub-blocks */
+
+#define LOUDNESS_TP_TAPS            12      /**< Taps per polyphase branch */
+#define LOUDNESS_TP_MAX_FACTOR      4       /**< Maximum oversampling factor */
+#define LOUDNESS_TP_TARGET_RATE     192000  /**< Minimum oversampled rate */
+
+#define LOUDNESS_CHUNK_FRAMES       256     /**< Frames staged per conversion */
+
+/*============================================================================
+ * Meter Structure
+ *============================================================================*/
+
+/**
+ * @brief Histogram of block energies (count and exact energy sum per bin)
+ */
+typedef struct loudness_hist_s {
+    uint64_t count[LOUDNESS_HIST_BINS];
+    double energy[LOUDNESS_HIST_BINS];
+} loudness_hist_t;
+
+/**
+ * @brief Everything measured over one span (track or album)
+ */
+typedef struct loudness_accum_s {
+    loudness_hist_t momentary;      /**< 400 ms gating blocks */
+    loudness_hist_t short_term;     /**< 3 s blocks for LRA */
+    double max_momentary;           /**< Highest momentary block energy */
+    double max_short_term;          /**< Highest short-term block energy */
+    double sample_peak;             /**< Highest |sample| */
+    double true_peak;               /**< Highest |interpolated sample| */
+} loudness_accum_t;
+
+/**
+ * @brief Direct form II transposed biquad, one state per lane
+ */
+typedef struct loudness_biquad_s {
+    double b0, b1, b2, a1, a2;
+    double z1[LOUDNESS_LANES];
+    double z2[LOUDNESS_LANES];
+} loudness_biquad_t;
+
+struct dsdpipe_loudness_meter_s {
+    uint32_t sample_rate;
+    uint16_t channel_count;
+    double weight[LOUDNESS_LANES];  /**< BS.1770 channel weights (0 = unused) */
+
+    /* K-weighting */
+    loudness_biquad_t shelf;        /**< Stage 1: high shelf (head effects) */
+    loudness_biquad_t highpass;     /**< Stage 2: RLB high pass */
+
+    /* 100 ms sub-block integration */
+    size_t hop_frames;              /**< Frames per sub-block */
+    size_t hop_pos;                 /**< Frames in the current sub-block */
+    double hop_energy;              /**< Weighted energy of the sub-block */
+    double subs[LOUDNESS_SHORT_TERM_SUBS]; /**< Ring of sub-block energies */
+    size_t sub_idx;                 /**< Next ring slot */
+    uint64_t sub_count;             /**< Sub-blocks completed in this track */
+
+    /* True peak */
+    unsigned int tp_factor;         /**< Oversampling factor (1 = off) */
+    double tp_coef[LOUDNESS_TP_MAX_FACTOR][LOUDNESS_TP_TAPS]; /**< Reversed branches */
+    double tp_hist[LOUDNESS_TP_TAPS * 2][LOUDNESS_LANES]; /**< Mirrored history */
+    size_t tp_pos;                  /**< Newest history slot */
+
+    bool use_sse2;                  /**< SSE2 loops instead of the scalar ones */
+
+    /* Staging buffer (lane-major frames) */
+    double stage[LOUDNESS_CHUNK_FRAMES][LOUDNESS_LANES];
+
+    loudness_accum_t track;
+    loudness_accum_t album;
+};
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static double loudness_energy_to_lufs(double energy)
+{
+    return -0.691 + 10.0 * log10(energy);
+}
+
+static size_t loudness_hist_index(double lufs)
+{
+    if (lufs <= LOUDNESS_HIST_MIN) {
+        return 0;
+    }
+    size_t idx = (size_t)((lufs - LOUDNESS_HIST_MIN) / LOUDNESS_HIST_STEP);
+    return idx < LOUDNESS_HIST_BINS ? idx : LOUDNESS_HIST_BINS - 1;
+}
+
+static void loudness_hist_add(loudness_hist_t *hist, double energy)
+{
+    if (energy <= 0.0) {
+        return;
+    }
+    double lufs = loudness_energy_to_lufs(energy);
+    if (lufs < LOUDNESS_ABS_GATE) {
+        return;
+    }
+    size_t idx = loudness_hist_index(lufs);
+    hist->count[idx]++;
+    hist->energy[idx] += energy;
+}
+
+/**
+ * @brief Mean energy of all blocks at or above a gate
+ */
+static double loudness_hist_gated_mean(const loudness_hist_t *hist,
+                                       double gate_lufs, uint64_t *count)
+{
+    double sum = 0.0;
+    uint64_t n = 0;
+
+    for (size_t i = loudness_hist_index(gate_lufs); i < LOUDNESS_HIST_BINS; i++) {
+        sum += hist->energy[i];
+        n += hist->count[i];
+    }
+
+    if (count) {
+        *count = n;
+    }
+    return n > 0 ? sum / (double)n : 0.0;
+}
+
+/**
+ * @brief Loudness of the bin holding the n-th block at or above start
+ */
+static double loudness_hist_percentile(const loudness_hist_t *hist,
+                                       size_t start, uint64_t nth)
+{
+    uint64_t seen = 0;
+
+    for (size_t i = start; i < LOUDNESS_HIST_BINS; i++) {
+        seen += hist->count[i];
+        if (seen > nth) {
+            return LOUDNESS_HIST_MIN + ((double)i + 0.5) * LOUDNESS_HIST_STEP;
+        }
+    }
+    return LOUDNESS_HIST_MIN + (LOUDNESS_HIST_BINS - 0.5) * LOUDNESS_HIST_STEP;
+}
+
+static void loudness_accum_result(const loudness_accum_t *acc,
+                                  dsdpipe_loudness_t *out)
+{
+    memset(out, 0, sizeof(*out));
+
+    out->sample_peak = acc->sample_peak;
+    out->true_peak = acc->true_peak > acc->sample_peak ? acc->true_peak
+                                                       : acc->sample_peak;
+    out->true_peak_dbtp = out->true_peak > 0.0 ? 20.0 * log10(out->true_peak)
+                                               : -HUGE_VAL;
+    out->max_momentary_lufs = acc->max_momentary > 0.0
+        ? loudness_energy_to_lufs(acc->max_momentary) : -HUGE_VAL;
+    out->max_short_term_lufs = acc->max_short_term > 0.0
+        ? loudness_energy_to_lufs(acc->max_short_term) : -HUGE_VAL;
+    out->integrated_lufs = -HUGE_VAL;
+
+    /* Integrated loudness: absolute gate, then relative gate at -10 LU */
+    uint64_t n = 0;
+    double mean = loudness_hist_gated_mean(&acc->momentary, LOUDNESS_ABS_GATE, &n);
+    if (n == 0) {
+        return;
+    }
+    double gate = loudness_energy_to_lufs(mean) + LOUDNESS_REL_GATE;
+    mean = loudness_hist_gated_mean(&acc->momentary, gate, &n);
+    if (n == 0) {
+        return;
+    }
+
+    out->valid = true;
+    out->integrated_lufs = loudness_energy_to_lufs(mean);
+    out->replaygain_db = DSDPIPE_LOUDNESS_RG_REFERENCE - out->integrated_lufs;
+
+    /* Loudness range: short-term blocks, relative gate at -20 LU */
+    mean = loudness_hist_gated_mean(&acc->short_term, LOUDNESS_ABS_GATE, &n);
+    if (n == 0) {
+        return;
+    }
+    gate = loudness_energy_to_lufs(mean) + LOUDNESS_LRA_REL_GATE;
+    size_t start = loudness_hist_index(gate);
+    loudness_hist_gated_mean(&acc->short_term, gate, &n);
+    if (n == 0) {
+        return;
+    }
+
+    uint64_t lo = (uint64_t)((double)(n - 1) * LOUDNESS_LRA_LOW + 0.5);
+    uint64_t hi = (uint64_t)((double)(n - 1) * LOUDNESS_LRA_HIGH + 0.5);
+    out->loudness_range_lu = loudness_hist_percentile(&acc->short_term, start, hi) -
+                             loudness_hist_percentile(&acc->short_term, start, lo);
+}
+
+/*============================================================================
+ * Filter Design
+ *============================================================================*/
+
+/**
+ * @brief Design the two K-weighting stages for an arbitrary sample rate
+ *
+ * Analog prototypes from BS.1770 re-derived by bilinear transform, so the
+ * coefficients match the tabulated 48 kHz values and stay correct at the
+ * 88.2/176.4 kHz rates produced from DSD.
+ */
+static void loudness_design_k_weighting(dsdpipe_loudness_meter_t *meter)
+{
+    double fs = (double)meter->sample_rate;
+
+    /* Stage 1: high shelf */
+    double f0 = 1681.974450955533;
+    double gain_db = 3.999843853973347;
+    double q = 0.7071752369554196;
+    double k = tan(M_PI * f0 / fs);
+    double vh = pow(10.0, gain_db / 20.0);
+    double vb = pow(vh, 0.4996667741545416);
+    double a0 = 1.0 + k / q + k * k;
+
+    meter->shelf.b0 = (vh + vb * k / q + k * k) / a0;
+    meter->shelf.b1 = 2.0 * (k * k - vh) / a0;
+    meter->shelf.b2 = (vh - vb * k / q + k * k) / a0;
+    meter->shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+    meter->shelf.a2 = (1.0 - k / q + k * k) / a0;
+
+    /* Stage 2: high pass */
+    f0 = 38.13547087602444;
+    q = 0.5003270373238773;
+    k = tan(M_PI * f0 / fs);
+    a0 = 1.0 + k / q + k * k;
+
+    meter->highpass.b0 = 1.0;
+    meter->highpass.b1 = -2.0;
+    meter->highpass.b2 = 1.0;
+    meter->highpass.a1 = 2.0 * (k * k - 1.0) / a0;
+    meter->highpass.a2 = (1.0 - k / q + k * k) / a0;
+}
+
+/**
+ * @brief Design the true-peak interpolator (windowed sinc, polyphase)
+ */
+static void loudness_design_true_peak(dsdpipe_loudness_meter_t *meter)
+{
+    unsigned int factor = (LOUDNESS_TP_TARGET_RATE + meter->sample_rate - 1) /
+                          meter->sample_rate;
+    if (factor > LOUDNESS_TP_MAX_FACTOR) {
+        factor = LOUDNESS_TP_MAX_FACTOR;
+    }
+    meter->tp_factor = factor;
+    if (factor < 2) {
+        return;
+    }
+
+    size_t length = (size_t)factor * LOUDNESS_TP_TAPS;
+    double center = (double)(length - 1) / 2.0;
+
+    for (size_t m = 0; m < length; m++) {
+        double x = ((double)m - center) / (double)factor;
+        double sinc = (x == 0.0) ? 1.0 : sin(M_PI * x) / (M_PI * x);
+        double w = 0.42 - 0.5 * cos(2.0 * M_PI * (double)m / (double)(length - 1)) +
+                   0.08 * cos(4.0 * M_PI * (double)m / (double)(length - 1));
+
+        /* Branch p holds h[k * factor + p]; stored reversed for the history */
+        size_t phase = m % factor;
+        size_t tap = m / factor;
+        meter->tp_coef[phase][LOUDNESS_TP_TAPS - 1 - tap] = sinc * w;
+    }
+}
+
+/*============================================================================
+ * Processing
+ *============================================================================*/
+
+static void loudness_reset_state(dsdpipe_loudness_meter_t *meter)
+{
+    memset(meter->shelf.z1, 0, sizeof(meter->shelf.z1));
+    memset(meter->shelf.z2, 0, sizeof(meter->shelf.z2));
+    memset(meter->highpass.z1, 0, sizeof(meter->highpass.z1));
+    memset(meter->highpass.z2, 0, sizeof(meter->highpass.z2));
+    memset(meter->tp_hist, 0, sizeof(meter->tp_hist));
+    memset(meter->subs, 0, sizeof(meter->subs));
+    meter->tp_pos = 0;
+    meter->hop_pos = 0;
+    meter->hop_energy = 0.0;
+    meter->sub_idx = 0;
+    meter->sub_count = 0;
+}
+
+/**
+ * @brief Close a 100 ms sub-block and emit momentary/short-term blocks
+ */
+static void loudness_finish_sub_block(dsdpipe_loudness_meter_t *meter)
+{
+    meter->subs[meter->sub_idx] = meter->hop_energy / (double)meter->hop_frames;
+    meter->sub_idx = (meter->sub_idx + 1) % LOUDNESS_SHORT_TERM_SUBS;
+    meter->sub_count++;
+    meter->hop_pos = 0;
+    meter->hop_energy = 0.0;
+
+    if (meter->sub_count >= LOUDNESS_MOMENTARY_SUBS) {
+        double sum = 0.0;
+        for (size_t i = 1; i <= LOUDNESS_MOMENTARY_SUBS; i++) {
+            size_t idx = (meter->sub_idx + LOUDNESS_SHORT_TERM_SUBS - i) %
+                         LOUDNESS_SHORT_TERM_SUBS;
+            sum += meter->subs[idx];
+        }
+        double energy = sum / LOUDNESS_MOMENTARY_SUBS;
+
+        loudness_hist_add(&meter->track.momentary, energy);
+        loudness_hist_add(&meter->album.momentary, energy);
+        if (energy > meter->track.max_momentary) {
+            meter->track.max_momentary = energy;
+        }
+        if (energy > meter->album.max_momentary) {
+            meter->album.max_momentary = energy;
+        }
+    }
+
+    if (meter->sub_count >= LOUDNESS_SHORT_TERM_SUBS) {
+        double sum = 0.0;
+        for (size_t i = 0; i < LOUDNESS_SHORT_TERM_SUBS; i++) {
+            sum += meter->subs[i];
+        }
+        double energy = sum / LOUDNESS_SHORT_TERM_SUBS;
+
+        loudness_hist_add(&meter->track.short_term, energy);
+        loudness_hist_add(&meter->album.short_term, energy);
+        if (energy > meter->track.max_short_term) {
+            meter->track.max_short_term = energy;
+        }
+        if (energy > meter->album.max_short_term) {
+            meter->album.max_short_term = energy;
+        }
+    }
+}
+
+#ifdef LOUDNESS_SSE2
+/**
+ * @brief loudness_k_weight() with two lanes per SSE2 register
+ *
+ * The filter states stay in registers for the whole stage.
+ */
+static void loudness_k_weight_sse2(dsdpipe_loudness_meter_t *meter, size_t frames,
+                                   double *energy)
+{
+    loudness_biquad_t *s1 = &meter->shelf;
+    loudness_biquad_t *s2 = &meter->highpass;
+    const __m128d b0 = _mm_set1_pd(s1->b0), b1 = _mm_set1_pd(s1->b1);
+    const __m128d b2 = _mm_set1_pd(s1->b2), a1 = _mm_set1_pd(s1->a1);
+    const __m128d a2 = _mm_set1_pd(s1->a2);
+    const __m128d c0 = _mm_set1_pd(s2->b0), c1 = _mm_set1_pd(s2->b1);
+    const __m128d c2 = _mm_set1_pd(s2->b2), d1 = _mm_set1_pd(s2->a1);
+    const __m128d d2 = _mm_set1_pd(s2->a2);
+    __m128d z1[LOUDNESS_LANES / 2], z2[LOUDNESS_LANES / 2];
+    __m128d y1[LOUDNESS_LANES / 2], y2[LOUDNESS_LANES / 2];
+    __m128d w[LOUDNESS_LANES / 2];
+
+    for (int v = 0; v < LOUDNESS_LANES / 2; v++) {
+        z1[v] = _mm_loadu_pd(&s1->z1[2 * v]);
+        z2[v] = _mm_loadu_pd(&s1->z2[2 * v]);
+        y1[v] = _mm_loadu_pd(&s2->z1[2 * v]);
+        y2[v] = _mm_loadu_pd(&s2->z2[2 * v]);
+        w[v] = _mm_loadu_pd(&meter->weight[2 * v]);
+    }
+
+    for (size_t f = 0; f < frames; f++) {
+        const double *x = meter->stage[f];
+        __m128d e = _mm_setzero_pd();
+
+        for (int v = 0; v < LOUDNESS_LANES / 2; v++) {
+            __m128d in = _mm_loadu_pd(&x[2 * v]);
+            __m128d out = _mm_add_pd(_mm_mul_pd(b0, in), z1[v]);
+            z1[v] = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(b1, in), _mm_mul_pd(a1, out)), z2[v]);
+            z2[v] = _mm_sub_pd(_mm_mul_pd(b2, in), _mm_mul_pd(a2, out));
+
+            __m128d out2 = _mm_add_pd(_mm_mul_pd(c0, out), y1[v]);
+            y1[v] = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(c1, out), _mm_mul_pd(d1, out2)), y2[v]);
+            y2[v] = _mm_sub_pd(_mm_mul_pd(c2, out), _mm_mul_pd(d2, out2));
+
+            e = _mm_add_pd(e, _mm_mul_pd(w[v], _mm_mul_pd(out2, out2)));
+        }
+        energy[f] = _mm_cvtsd_f64(_mm_add_sd(e, _mm_unpackhi_pd(e, e)));
+    }
+
+    for (int v = 0; v < LOUDNESS_LANES / 2; v++) {
+        _mm_storeu_pd(&s1->z1[2 * v], z1[v]);
+        _mm_storeu_pd(&s1->z2[2 * v], z2[v]);
+        _mm_storeu_pd(&s2->z1[2 * v], y1[v]);
+        _mm_storeu_pd(&s2->z2[2 * v], y2[v]);
+    }
+}
+
+/**
+ * @brief One true-peak branch with two lanes per SSE2 register
+ */
+static void loudness_tp_branch_sse2(const double *h,
+                                    const double (*win)[LOUDNESS_LANES],
+                                    double *tpeak)
+{
+    const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(INT64_MAX));
+    __m128d acc[LOUDNESS_LANES / 2];
+
+    for (int v = 0; v < LOUDNESS_LANES / 2; v++) {
+        acc[v] = _mm_setzero_pd();
+    }
+    for (int t = 0; t < LOUDNESS_TP_TAPS; t++) {
+        __m128d ht = _mm_set1_pd(h[t]);
+        for (int v = 0; v < LOUDNESS_LANES / 2; v++) {
+            acc[v] = _mm_add_pd(acc[v], _mm_mul_pd(ht, _mm_loadu_pd(&win[t][2 * v])));
+        }
+    }
+    for (int v = 0; v < LOUDNESS_LANES / 2; v++) {
+        __m128d a = _mm_and_pd(acc[v], abs_mask);
+        _mm_storeu_pd(&tpeak[2 * v], _mm_max_pd(a, _mm_loadu_pd(&tpeak[2 * v])));
+    }
+}
+#endif
+
+/**
+ * @brief K-weight staged frames and compute the weighted energy of each
+ */
+static void loudness_k_weight(dsdpipe_loudness_meter_t *meter, size_t frames,
+                              double *energy)
+{
+    loudness_biquad_t *s1 = &meter->shelf;
+    loudness_biquad_t *s2 = &meter->highpass;
+
+#ifdef LOUDNESS_SSE2
+    if (meter->use_sse2) {
+        loudness_k_weight_sse2(meter, frames, energy);
+        return;
+    }
+#endif
+
+    for (size_t f = 0; f < frames; f++) {
+        const double *x = meter->stage[f];
+        double e = 0.0;
+
+        /* K-weighting, both stages, all lanes */
+        for (int l = 0; l < LOUDNESS_LANES; l++) {
+            double in = x[l];
+            double out = s1->b0 * in + s1->z1[l];
+            s1->z1[l] = s1->b1 * in - s1->a1 * out + s1->z2[l];
+            s1->z2[l] = s1->b2 * in - s1->a2 * out;
+
+            double out2 = s2->b0 * out + s2->z1[l];
+            s2->z1[l] = s2->b1 * out - s2->a1 * out2 + s2->z2[l];
+            s2->z2[l] = s2->b2 * out - s2->a2 * out2;
+            e += meter->weight[l] * out2 * out2;
+        }
+        energy[f] = e;
+    }
+}
+
+/**
+ * @brief Push one frame into the true-peak history and evaluate every branch
+ */
+static void loudness_true_peak(dsdpipe_loudness_meter_t *meter, const double *x,
+                               double *tpeak)
+{
+    size_t pos = meter->tp_pos;
+
+    for (int l = 0; l < LOUDNESS_LANES; l++) {
+        meter->tp_hist[pos][l] = x[l];
+        meter->tp_hist[pos + LOUDNESS_TP_TAPS][l] = x[l];
+    }
+
+    const double (*win)[LOUDNESS_LANES] = &meter->tp_hist[pos + 1];
+    for (unsigned int p = 0; p < meter->tp_factor; p++) {
+        const double *h = meter->tp_coef[p];
+#ifdef LOUDNESS_SSE2
+        if (meter->use_sse2) {
+            loudness_tp_branch_sse2(h, win, tpeak);
+            continue;
+        }
+#endif
+        double acc[LOUDNESS_LANES] = {0};
+        for (int t = 0; t < LOUDNESS_TP_TAPS; t++) {
+            for (int l = 0; l < LOUDNESS_LANES; l++) {
+                acc[l] += h[t] * win[t][l];
+            }
+        }
+        for (int l = 0; l < LOUDNESS_LANES; l++) {
+            double a = fabs(acc[l]);
+            tpeak[l] = a > tpeak[l] ? a : tpeak[l];
+        }
+    }
+    meter->tp_pos = (pos + 1) % LOUDNESS_TP_TAPS;
+}
+
+/**
+ * @brief Run staged lane-major frames through all measurement paths
+ */
+static void loudness_process_stage(dsdpipe_loudness_meter_t *meter, size_t frames)
+{
+    double energy[LOUDNESS_CHUNK_FRAMES];
+    double peak[LOUDNESS_LANES] = {0};
+    double tpeak[LOUDNESS_LANES] = {0};
+
+    loudness_k_weight(meter, frames, energy);
+
+    for (size_t f = 0; f < frames; f++) {
+        const double *x = meter->stage[f];
+
+        /* Sample peak */
+        for (int l = 0; l < LOUDNESS_LANES; l++) {
+            double a = fabs(x[l]);
+            peak[l] = a > peak[l] ? a : peak[l];
+        }
+
+        if (meter->tp_factor >= 2) {
+            loudness_true_peak(meter, x, tpeak);
+        }
+
+        meter->hop_energy += energy[f];
+        if (++meter->hop_pos == meter->hop_frames) {
+            loudness_finish_sub_block(meter);
+        }
+    }
+
+    for (int l = 0; l < LOUDNESS_LANES; l++) {
+        if (peak[l] > meter->track.sample_peak) meter->track.sample_peak = peak[l];
+        if (peak[l] > meter->album.sample_peak) meter->album.sample_peak = peak[l];
+        if (tpeak[l] > meter->track.true_peak) meter->track.true_peak = tpeak[l];
+        if (tpeak[l] > meter->album.true_peak) meter->album.true_peak = tpeak[l];
+    }
+}
+
+/*============================================================================
+ * Public (internal) API
+ *============================================================================*/
+
+int dsdpipe_loudness_meter_create(dsdpipe_loudness_meter_t **meter,
+                                  uint32_t sample_rate,
+                                  uint16_t channel_count)
+{
+    if (!meter || sample_rate < 8000 || channel_count == 0 ||
+        channel_count > LOUDNESS_MAX_CHANNELS) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    *meter = NULL;
+
+    dsdpipe_loudness_meter_t *m =
+        (dsdpipe_loudness_meter_t *)sa_calloc(1, sizeof(*m));
+    if (!m) {
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    m->sample_rate = sample_rate;
+    m->channel_count = channel_count;
+    m->hop_frames = (size_t)((sample_rate + 5) / 10);
+#ifdef LOUDNESS_SSE2
+    m->use_sse2 = true;
+#endif
+
+    /* BS.1770 weights: 1.0 front, 1.41 surround, 0 for LFE and unused lanes */
+    for (uint16_t c = 0; c < channel_count; c++) {
+        m->weight[c] = 1.0;
+    }
+    if (channel_count == 6) {
+        m->weight[3] = 0.0;
+        m->weight[4] = 1.41;
+        m->weight[5] = 1.41;
+    } else if (channel_count == 5) {
+        m->weight[3] = 1.41;
+        m->weight[4] = 1.41;
+    } else if (channel_count == 4) {
+        m->weight[2] = 1.41;
+        m->weight[3] = 1.41;
+    }
+
+    loudness_design_k_weighting(m);
+    loudness_design_true_peak(m);
+    loudness_reset_state(m);
+
+    *meter = m;
+    return DSDPIPE_OK;
+}
+
+void dsdpipe_loudness_meter_destroy(dsdpipe_loudness_meter_t *meter)
+{
+    sa_free(meter);
+}
+
+void dsdpipe_loudness_meter_start_track(dsdpipe_loudness_meter_t *meter)
+{
+    if (!meter) {
+        return;
+    }
+
+    memset(&meter->track, 0, sizeof(meter->track));
+    loudness_reset_state(meter);
+}
+
+void dsdpipe_loudness_meter_add_float(dsdpipe_loudness_meter_t *meter,
+                                      const float *samples, size_t frames)
+{
+    if (!meter || !samples) {
+        return;
+    }
+
+    uint16_t channels = meter->channel_count;
+
+    while (frames > 0) {
+        size_t n = frames < LOUDNESS_CHUNK_FRAMES ? frames : LOUDNESS_CHUNK_FRAMES;
+        for (size_t f = 0; f < n; f++) {
+            for (uint16_t c = 0; c < channels; c++) {
+                meter->stage[f][c] = (double)samples[c];
+            }
+            samples += channels;
+        }
+        loudness_process_stage(meter, n);
+        frames -= n;
+    }
+}
+
+void dsdpipe_loudness_meter_add_double(dsdpipe_loudness_meter_t *meter,
+                                       const double *samples, size_t frames)
+{
+    if (!meter || !samples) {
+        return;
+    }
+
+    uint16_t channels = meter->channel_count;
+
+    while (frames > 0) {
+        size_t n = frames < LOUDNESS_CHUNK_FRAMES ? frames : LOUDNESS_CHUNK_FRAMES;
+        for (size_t f = 0; f < n; f++) {
+            memcpy(meter->stage[f], samples, channels * sizeof(double));
+            samples += channels;
+        }
+        loudness_process_stage(meter, n);
+        frames -= n;
+    }
+}
+
+void dsdpipe_loudness_meter_get_track(const dsdpipe_loudness_meter_t *meter,
+                                      dsdpipe_loudness_t *loudness)
+{
+    if (!meter || !loudness) {
+        return;
+    }
+    loudness_accum_result(&meter->track, loudness);
+}
+
+void dsdpipe_loudness_meter_get_album(const dsdpipe_loudness_meter_t *meter,
+                                      dsdpipe_loudness_t *loudness)
+{
+    if (!meter || !loudness) {
+        return;
+    }
+    loudness_accum_result(&meter->album, loudness);
+}
+
+bool dsdpipe_loudness_meter_use_sse2(dsdpipe_loudness_meter_t *meter, bool enable)
+{
+    if (!meter) {
+        return false;
+    }
+#ifdef LOUDNESS_SSE2
+    meter->use_sse2 = enable;
+#else
+    (void)enable;
+#endif
+    return meter->use_sse2;
+}
@@ -0,0 +1,133 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Loudness meter (ITU-R BS.1770-4 / EBU R128)
+ * Measures gated integrated loudness, loudness range (EBU Tech 3342),
+ * momentary/short-term maxima, sample peak and true peak of interleaved
+ * floating-point PCM. Gating blocks are kept in fixed-size histograms, so
+ * memory use does not grow with track length and album values are
+ * obtained from the same blocks as the track values.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBDSDPIPE_LOUDNESS_H
+#define LIBDSDPIPE_LOUDNESS_H
+
+#include <libdsdpipe/dsdpipe.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** ReplayGain 2.0 reference loudness (LUFS) */
+#define DSDPIPE_LOUDNESS_RG_REFERENCE   (-18.0)
+
+/**
+ * @brief Opaque loudness meter
+ */
+typedef struct dsdpipe_loudness_meter_s dsdpipe_loudness_meter_t;
+
+/**
+ * @brief Create a loudness meter
+ *
+ * Channels are weighted for the SACD channel order: L, R, C, LFE, Ls, Rs
+ * for 6 channels, L, R, C, Ls, Rs for 5 and L, R, Ls, Rs for 4. LFE is
+ * excluded from the measurement.
+ *
+ * @param meter Receives the meter
+ * @param sample_rate PCM sample rate in Hz
+ * @param channel_count Number of interleaved channels (1-6)
+ * @return DSDPIPE_OK on success, error code otherwise
+ */
+int dsdpipe_loudness_meter_create(dsdpipe_loudness_meter_t **meter,
+                                  uint32_t sample_rate,
+                                  uint16_t channel_count);
+
+/**
+ * @brief Destroy a loudness meter
+ *
+ * @param meter Meter (may be NULL)
+ */
+void dsdpipe_loudness_meter_destroy(dsdpipe_loudness_meter_t *meter);
+
+/**
+ * @brief Begin a new track
+ *
+ * Clears the track measurement and the filter state. Album values keep
+ * accumulating.
+ *
+ * @param meter Meter
+ */
+void dsdpipe_loudness_meter_start_track(dsdpipe_loudness_meter_t *meter);
+
+/**
+ * @brief Feed interleaved 32-bit float samples
+ *
+ * @param meter Meter
+ * @param samples Interleaved samples (full scale = +/-1.0)
+ * @param frames Number of sample frames (samples per channel)
+ */
+void dsdpipe_loudness_meter_add_float(dsdpipe_loudness_meter_t *meter,
+                                      const float *samples, size_t frames);
+
+/**
+ * @brief Feed interleaved 64-bit float samples
+ *
+ * @param meter Meter
+ * @param samples Interleaved samples (full scale = +/-1.0)
+ * @param frames Number of sample frames (samples per channel)
+ */
+void dsdpipe_loudness_meter_add_double(dsdpipe_loudness_meter_t *meter,
+                                       const double *samples, size_t frames);
+
+/**
+ * @brief Get the measurement of the current track
+ *
+ * @param meter Meter
+ * @param loudness Receives the measurement
+ */
+void dsdpipe_loudness_meter_get_track(const dsdpipe_loudness_meter_t *meter,
+                                      dsdpipe_loudness_t *loudness);
+
+/**
+ * @brief Get the measurement over all tracks fed so far
+ *
+ * @param meter Meter
+ * @param loudness Receives the measurement
+ */
+void dsdpipe_loudness_meter_get_album(const dsdpipe_loudness_meter_t *meter,
+                                      dsdpipe_loudness_t *loudness);
+
+/**
+ * @brief Choose between the SSE2 and the scalar filter loops
+ *
+ * New meters use SSE2 when the build targets it. The scalar loops are the
+ * reference the SSE2 ones are tested against.
+ *
+ * @param meter Meter
+ * @param enable true for SSE2, false for the scalar loops
+ * @return true if the meter now uses SSE2
+ */
+bool dsdpipe_loudness_meter_use_sse2(dsdpipe_loudness_meter_t *meter, bool enable);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBDSDPIPE_LOUDNESS_H */
@@ -49,6 +49,8 @@ struct dsdpipe_reader_thread_s {
 
     /* Track state */
     uint8_t current_track;
+    uint64_t start_frame;     /**< First frame to read (track-relative) */
+    uint64_t frame_count;     /**< Frames to read (0 = whole track) */
     bool track_started;
 
     /* Synchronization for track start/finish */
@@ -71,6 +73,42 @@ struct dsdpipe_reader_thread_s {
  * Reader Thread Function
  *============================================================================*/
 
+/**
+ * @brief Position the source at a frame of the current track
+ *
+ * Uses the source's seek_frame() when it has one; otherwise reads and
+ * drops frames up to the target.
+ */
+static int reader_seek_frame(dsdpipe_reader_thread_t *reader, uint64_t frame)
+{
+    dsdpipe_t *pipe = reader->pipe;
+
+    if (pipe->source.ops->seek_frame) {
+        int result = pipe->source.ops->seek_frame(pipe->source.ctx, frame);
+        if (result != DSDPIPE_ERROR_UNSUPPORTED) {
+            return result;
+        }
+    }
+
+    dsdpipe_buffer_t *scratch = dsdpipe_buffer_alloc_dsd(pipe);
+    if (!scratch) {
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    int result = DSDPIPE_OK;
+    for (uint64_t i = 0; i < frame && !reader->cancelled; i++) {
+        result = pipe->source.ops->read_frame(pipe->source.ctx, scratch);
+        if (result != DSDPIPE_OK) {
+            /* Range starts beyond the track: nothing left to read */
+            result = (result == 1) ? DSDPIPE_OK : result;
+            break;
+        }
+    }
+
+    dsdpipe_buffer_unref(scratch);
+    return result;
+}
+
 /**
  * @brief Main reader thread function
  */
@@ -81,6 +119,9 @@ static int reader_thread_func(void *arg)
 
     while (!reader->shutdown) {
         uint8_t track_number;
+        uint64_t start_frame;
+        uint64_t frame_count;
+        uint64_t frames_read = 0;
         int result;
 
         /* Wait for a track to be assigned */
@@ -95,6 +136,8 @@ static int reader_thread_func(void *arg)
         }
 
         track_number = reader->current_track;
+        start_frame = reader->start_frame;
+        frame_count = reader->frame_count;
         reader->track_pending = false;
         reader->track_finished = false;
         reader->has_error = false;
@@ -104,8 +147,11 @@ static int reader_thread_func(void *arg)
         /* Reset queue for new track */
         dsdpipe_frame_queue_reset(reader->output_queue);
 
-        /* Seek to track start */
+        /* Seek to track start, then to the first frame of the range */
         result = pipe->source.ops->seek_track(pipe->source.ctx, track_number);
+        if (result == DSDPIPE_OK && start_frame > 0) {
+            result = reader_seek_frame(reader, start_frame);
+        }
         if (result != DSDPIPE_OK) {
             mtx_lock(&reader->state_mutex);
             reader->has_error = true;
@@ -153,6 +199,17 @@ static int reader_thread_func(void *arg)
                 break;
             }
 
+            /* A range starts and ends wherever the caller asked */
+            if (result == DSDPIPE_OK) {
+                if (frames_read == 0) {
+                    buffer->flags |= DSDPIPE_BUF_FLAG_TRACK_START;
+                }
+                frames_read++;
+                if (frame_count > 0 && frames_read >= frame_count) {
+                    buffer->flags |= DSDPIPE_BUF_FLAG_TRACK_END;
+                }
+            }
+
             /* Check for end-of-track */
             is_last_frame = (result == 1) ||
                             (buffer->flags & DSDPIPE_BUF_FLAG_TRACK_END);
@@ -257,6 +314,14 @@ dsdpipe_reader_thread_t *dsdpipe_reader_thread_create(
 
 int dsdpipe_reader_thread_start_track(dsdpipe_reader_thread_t *reader,
                                         uint8_t track_number)
+{
+    return dsdpipe_reader_thread_start_range(reader, track_number, 0, 0);
+}
+
+int dsdpipe_reader_thread_start_range(dsdpipe_reader_thread_t *reader,
+                                      uint8_t track_number,
+                                      uint64_t start_frame,
+                                      uint64_t frame_count)
 {
     if (!reader) {
         return -1;
@@ -277,6 +342,8 @@ int dsdpipe_reader_thread_start_track(dsdpipe_reader_thread_t *reader,
     /* Reset state */
     reader->cancelled = false;
     reader->current_track = track_number;
+    reader->start_frame = start_frame;
+    reader->frame_count = frame_count;
     reader->track_pending = true;
     reader->track_started = true;
     reader->track_finished = false;
@@ -64,6 +64,25 @@ dsdpipe_reader_thread_t *dsdpipe_reader_thread_create(
 int dsdpipe_reader_thread_start_track(dsdpipe_reader_thread_t *reader,
                                         uint8_t track_number);
 
+/**
+ * @brief Start reading a frame range of a track
+ *
+ * Like dsdpipe_reader_thread_start_track(), but positions the source at
+ * start_frame and stops after frame_count frames. The first frame pushed
+ * carries DSDPIPE_BUF_FLAG_TRACK_START and the last one
+ * DSDPIPE_BUF_FLAG_TRACK_END.
+ *
+ * @param reader Reader thread
+ * @param track_number Track number to read (1-based)
+ * @param start_frame First frame, relative to the track start
+ * @param frame_count Number of frames to read (0 = to end of track)
+ * @return 0 on success, -1 on error
+ */
+int dsdpipe_reader_thread_start_range(dsdpipe_reader_thread_t *reader,
+                                      uint8_t track_number,
+                                      uint64_t start_frame,
+                                      uint64_t frame_count);
+
 /**
  * @brief Wait for the reader to finish the current track
  *
@@ -765,6 +765,24 @@ static void dsdiff_sink_destroy(void *ctx)
     sa_free(dsdiff_ctx);
 }
 
+static char *dsdiff_sink_get_track_path(void *ctx,
+                                        const dsdpipe_metadata_t *metadata)
+{
+    dsdpipe_sink_dsdiff_ctx_t *dsdiff_ctx = (dsdpipe_sink_dsdiff_ctx_t *)ctx;
+
+    if (!dsdiff_ctx) {
+        return NULL;
+    }
+
+    /* Edit master writes all tracks into a single file */
+    if (dsdiff_ctx->edit_master) {
+        return NULL;
+    }
+
+    return generate_track_filename(dsdiff_ctx->base_path, metadata,
+                                   dsdiff_ctx->track_filename_format);
+}
+
 /*============================================================================
  * Operations Table
  *============================================================================*/
@@ -777,7 +795,8 @@ static const dsdpipe_sink_ops_t s_dsdiff_sink_ops = {
     .write_frame = dsdiff_sink_write_frame,
     .finalize = dsdiff_sink_finalize,
     .get_capabilities = dsdiff_sink_get_capabilities,
-    .destroy = dsdiff_sink_destroy
+    .destroy = dsdiff_sink_destroy,
+    .get_track_path = dsdiff_sink_get_track_path
 };
 
 /*============================================================================
@@ -604,6 +604,19 @@ static void dsf_sink_destroy(void *ctx)
     sa_free(dsf_ctx);
 }
 
+static char *dsf_sink_get_track_path(void *ctx,
+                                     const dsdpipe_metadata_t *metadata)
+{
+    dsdpipe_sink_dsf_ctx_t *dsf_ctx = (dsdpipe_sink_dsf_ctx_t *)ctx;
+
+    if (!dsf_ctx) {
+        return NULL;
+    }
+
+    return generate_track_filename(dsf_ctx->base_path, metadata,
+                                   dsf_ctx->track_filename_format);
+}
+
 /*============================================================================
  * Operations Table
  *============================================================================*/
@@ -616,7 +629,8 @@ static const dsdpipe_sink_ops_t s_dsf_sink_ops = {
     .write_frame = dsf_sink_write_frame,
     .finalize = dsf_sink_finalize,
     .get_capabilities = dsf_sink_get_capabilities,
-    .destroy = dsf_sink_destroy
+    .destroy = dsf_sink_destroy,
+    .get_track_path = dsf_sink_get_track_path
 };
 
 /*============================================================================
@@ -14,6 +14,12 @@
  * Output formats:
  *   - 16-bit FLAC (bits_per_sample=16)
  *   - 24-bit FLAC (bits_per_sample=24)
+ * A PADDING block is reserved after the Vorbis comment so that ReplayGain
+ * tags from the loudness sink can be added in place once a track (or the
+ * album) has been measured.
+ * With libFLAC 1.5 or later the encoder runs multithreaded: fixed-size
+ * frames are encoded on worker threads and written out in order. Older
+ * libFLAC versions encode on the calling thread.
  * NOTE: This sink requires PCM data. The pipeline should have a DSD-to-PCM
  *       transform inserted when the source provides DSD/DST data.
  *
@@ -38,6 +44,7 @@
 #include <stdio.h>
 #include <stdint.h>
 
+#include <libsautil/cpu.h>
 #include <libsautil/mem.h>
 #include <libsautil/sa_path.h>
 #include <libsautil/sastring.h>
@@ -53,6 +60,14 @@
 
 #define FLAC_SINK_MAX_CHANNELS       8
 #define FLAC_SINK_SAMPLE_BUFFER_SIZE 8192
+#define FLAC_SINK_PADDING_SIZE       1024  /**< Room for tags added later */
+#define FLAC_SINK_MAX_THREADS        64    /**< libFLAC encoder thread limit */
+
+/** libFLAC 1.5 (API 14) added the multithreaded encoder */
+#if defined(HAVE_LIBFLAC) && defined(FLAC_API_VERSION_CURRENT) && \
+    FLAC_API_VERSION_CURRENT >= 14
+#define FLAC_SINK_HAVE_THREADS       1
+#endif
 
 /*============================================================================
  * FLAC Sink Context
@@ -63,6 +78,7 @@ typedef struct dsdpipe_sink_flac_ctx_s {
     char *base_path;            /**< Base output path (without extension) */
     int bit_depth;              /**< Requested output bit depth (16, 24) */
     int compression;            /**< FLAC compression level (0-8) */
+    int threads;                /**< Encoder threads (0 = one per CPU) */
     int sample_rate;            /**< Output sample rate (derived from format) */
     dsdpipe_track_format_t track_filename_format; /**< Track filename format */
 
@@ -79,8 +95,16 @@ typedef struct dsdpipe_sink_flac_ctx_s {
 
     /* Metadata for current track */
     FLAC__StreamMetadata *vorbis_comment;
+    FLAC__StreamMetadata *padding;
 #endif
 
+    /* ReplayGain */
+    char *track_path;           /**< Output file of the current track */
+    char *written_paths[DSDPIPE_MAX_TRACKS]; /**< Files finished this run */
+    int written_count;          /**< Number of entries in written_paths */
+    dsdpipe_loudness_t track_loudness;  /**< Pending track measurement */
+    dsdpipe_loudness_t album_loudness;  /**< Pending album measurement */
+
     /* Conversion buffer (for converting input PCM to FLAC__int32) */
     int32_t *conv_buffer;       /**< Conversion buffer */
     size_t conv_buffer_size;    /**< Conversion buffer size (samples) */
@@ -359,6 +383,96 @@ static FLAC__StreamMetadata *build_vorbis_comments(
     return vc;
 }
 
+/*============================================================================
+ * Helper: Write ReplayGain tags into a finished file
+ *============================================================================*/
+
+static int replace_vorbis_comment(FLAC__StreamMetadata *vc, const char *name,
+                                  const char *value)
+{
+    FLAC__StreamMetadata_VorbisComment_Entry entry;
+    if (!FLAC__metadata_object_vorbiscomment_entry_from_name_value_pair(
+            &entry, name, value)) {
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (!FLAC__metadata_object_vorbiscomment_replace_comment(vc, entry,
+                                                             true, false)) {
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    return DSDPIPE_OK;
+}
+
+/**
+ * @brief Set REPLAYGAIN_TRACK_* or REPLAYGAIN_ALBUM_* tags of a FLAC file
+ *
+ * The Vorbis comment grows into the reserved padding, so the audio data is
+ * normally not rewritten.
+ */
+static int write_replaygain_tags(const char *path,
+                                 const dsdpipe_loudness_t *loudness,
+                                 bool album)
+{
+    char gain[32];
+    char peak[32];
+    snprintf(gain, sizeof(gain), "%+.2f dB", loudness->replaygain_db);
+    snprintf(peak, sizeof(peak), "%.6f", loudness->true_peak);
+
+    FLAC__Metadata_Chain *chain = FLAC__metadata_chain_new();
+    if (!chain) {
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (!FLAC__metadata_chain_read(chain, path)) {
+        FLAC__metadata_chain_delete(chain);
+        return DSDPIPE_ERROR_FILE_WRITE;
+    }
+
+    FLAC__Metadata_Iterator *it = FLAC__metadata_iterator_new();
+    if (!it) {
+        FLAC__metadata_chain_delete(chain);
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    int result = DSDPIPE_ERROR_FILE_WRITE;
+    FLAC__metadata_iterator_init(it, chain);
+    do {
+        if (FLAC__metadata_iterator_get_block_type(it) !=
+            FLAC__METADATA_TYPE_VORBIS_COMMENT) {
+            continue;
+        }
+
+        FLAC__StreamMetadata *vc = FLAC__metadata_iterator_get_block(it);
+        if (album) {
+            result = replace_vorbis_comment(vc, "REPLAYGAIN_ALBUM_GAIN", gain);
+            if (result == DSDPIPE_OK) {
+                result = replace_vorbis_comment(vc, "REPLAYGAIN_ALBUM_PEAK", peak);
+            }
+        } else {
+            result = replace_vorbis_comment(vc, "REPLAYGAIN_TRACK_GAIN", gain);
+            if (result == DSDPIPE_OK) {
+                result = replace_vorbis_comment(vc, "REPLAYGAIN_TRACK_PEAK", peak);
+            }
+            if (result == DSDPIPE_OK) {
+                result = replace_vorbis_comment(vc, "REPLAYGAIN_REFERENCE_LOUDNESS",
+                                                "-18.00 LUFS");
+            }
+        }
+        break;
+    } while (FLAC__metadata_iterator_next(it));
+
+    FLAC__metadata_iterator_delete(it);
+
+    if (result == DSDPIPE_OK &&
+        !FLAC__metadata_chain_write(chain, true, false)) {
+        result = DSDPIPE_ERROR_FILE_WRITE;
+    }
+
+    FLAC__metadata_chain_delete(chain);
+    return result;
+}
+
 /*============================================================================
  * Helper: Close encoder if active
  *============================================================================*/
@@ -378,6 +492,11 @@ static void close_encoder(dsdpipe_sink_flac_ctx_t *ctx)
         FLAC__metadata_object_delete(ctx->vorbis_comment);
         ctx->vorbis_comment = NULL;
     }
+
+    if (ctx->padding) {
+        FLAC__metadata_object_delete(ctx->padding);
+        ctx->padding = NULL;
+    }
 }
 
 /*============================================================================
@@ -413,6 +532,9 @@ static int flac_sink_open(void *ctx, const char *path,
     flac_ctx->encoder_active = false;
     flac_ctx->encoder = NULL;
     flac_ctx->vorbis_comment = NULL;
+    flac_ctx->padding = NULL;
+    flac_ctx->written_count = 0;
+    memset(&flac_ctx->album_loudness, 0, sizeof(flac_ctx->album_loudness));
 
     /* Determine output sample rate */
     if (format->sample_rate > 100000) {
@@ -457,6 +579,11 @@ static void flac_sink_close(void *ctx)
 
     /* Free resources */
     sa_freep(&flac_ctx->base_path);
+    sa_freep(&flac_ctx->track_path);
+    for (int i = 0; i < flac_ctx->written_count; i++) {
+        sa_freep(&flac_ctx->written_paths[i]);
+    }
+    flac_ctx->written_count = 0;
 
     if (flac_ctx->conv_buffer) {
         sa_freep(&flac_ctx->conv_buffer);
@@ -478,11 +605,13 @@ static int flac_sink_track_start(void *ctx, uint8_t track_number,
 
     flac_ctx->current_track = track_number;
     flac_ctx->track_samples = 0;
+    memset(&flac_ctx->track_loudness, 0, sizeof(flac_ctx->track_loudness));
 
     /* Generate unique output filename for this track */
-    char *output_path = generate_track_filename(flac_ctx->base_path, metadata,
-                                                flac_ctx->track_filename_format);
-    if (!output_path) {
+    sa_freep(&flac_ctx->track_path);
+    flac_ctx->track_path = generate_track_filename(flac_ctx->base_path, metadata,
+                                                   flac_ctx->track_filename_format);
+    if (!flac_ctx->track_path) {
         return DSDPIPE_ERROR_OUT_OF_MEMORY;
     }
 
@@ -508,20 +637,46 @@ static int flac_sink_track_start(void *ctx, uint8_t track_number,
     /* Set total samples if known (enables seeking) */
     FLAC__stream_encoder_set_total_samples_estimate(flac_ctx->encoder, 0);
 
-    /* Build and set Vorbis comment metadata */
+#ifdef FLAC_SINK_HAVE_THREADS
+    /* Encode frames in parallel; a refusal just leaves one thread */
+    if (flac_ctx->threads != 1) {
+        int threads = flac_ctx->threads > 0 ? flac_ctx->threads : sa_cpu_count();
+        if (threads > FLAC_SINK_MAX_THREADS) {
+            threads = FLAC_SINK_MAX_THREADS;
+        }
+        if (threads > 1) {
+            FLAC__stream_encoder_set_num_threads(flac_ctx->encoder,
+                                                 (uint32_t)threads);
+        }
+    }
+#endif
+
+    /* Build and set Vorbis comment metadata, followed by padding */
+    FLAC__StreamMetadata *metadata_array[2];
+    unsigned metadata_count = 0;
+
     flac_ctx->vorbis_comment = build_vorbis_comments(metadata, track_number);
     if (flac_ctx->vorbis_comment) {
-        FLAC__StreamMetadata *metadata_array[1] = { flac_ctx->vorbis_comment };
-        FLAC__stream_encoder_set_metadata(flac_ctx->encoder, metadata_array, 1);
+        metadata_array[metadata_count++] = flac_ctx->vorbis_comment;
+    }
+
+    flac_ctx->padding = FLAC__metadata_object_new(FLAC__METADATA_TYPE_PADDING);
+    if (flac_ctx->padding) {
+        flac_ctx->padding->length = FLAC_SINK_PADDING_SIZE;
+        metadata_array[metadata_count++] = flac_ctx->padding;
+    }
+
+    if (metadata_count > 0) {
+        FLAC__stream_encoder_set_metadata(flac_ctx->encoder, metadata_array,
+                                          metadata_count);
     }
 
     /* Initialize encoder with file output */
     FLAC__StreamEncoderInitStatus init_status;
     init_status = FLAC__stream_encoder_init_file(flac_ctx->encoder,
-                                                  output_path,
+                                                  flac_ctx->track_path,
                                                   NULL,  /* progress callback */
                                                   NULL); /* client data */
-    sa_free(output_path);
 
     if (init_status != FLAC__STREAM_ENCODER_INIT_STATUS_OK) {
         close_encoder(flac_ctx);
@@ -544,6 +699,7 @@ static int flac_sink_track_end(void *ctx, uint8_t track_number)
     (void)track_number;
 
     /* Finalize and close the encoder for this track */
+    bool finished = false;
     if (flac_ctx->encoder && flac_ctx->encoder_active) {
         FLAC__bool ok = FLAC__stream_encoder_finish(flac_ctx->encoder);
         flac_ctx->encoder_active = false;
@@ -555,12 +711,29 @@ static int flac_sink_track_end(void *ctx, uint8_t track_number)
         }
 
         flac_ctx->tracks_written++;
+        finished = true;
     }
 
     /* Clean up encoder resources */
     close_encoder(flac_ctx);
 
-    return DSDPIPE_OK;
+    if (!finished || !flac_ctx->track_path) {
+        return DSDPIPE_OK;
+    }
+
+    int result = DSDPIPE_OK;
+    if (flac_ctx->track_loudness.valid) {
+        result = write_replaygain_tags(flac_ctx->track_path,
+                                       &flac_ctx->track_loudness, false);
+    }
+
+    /* Remember the file for the album tags written at finalize */
+    if (flac_ctx->written_count < DSDPIPE_MAX_TRACKS) {
+        flac_ctx->written_paths[flac_ctx->written_count++] = flac_ctx->track_path;
+        flac_ctx->track_path = NULL;
+    }
+
+    return result;
 }
 
 static int flac_sink_write_frame(void *ctx, const dsdpipe_buffer_t *buffer)
@@ -703,7 +876,18 @@ static int flac_sink_finalize(void *ctx)
     /* Close any remaining active encoder */
     close_encoder(flac_ctx);
 
-    return DSDPIPE_OK;
+    int result = DSDPIPE_OK;
+    if (flac_ctx->album_loudness.valid) {
+        for (int i = 0; i < flac_ctx->written_count; i++) {
+            int ret = write_replaygain_tags(flac_ctx->written_paths[i],
+                                            &flac_ctx->album_loudness, true);
+            if (ret != DSDPIPE_OK) {
+                result = ret;
+            }
+        }
+    }
+
+    return result;
 }
 
 static uint32_t flac_sink_get_capabilities(void *ctx)
@@ -725,6 +909,35 @@ static void flac_sink_destroy(void *ctx)
     sa_free(flac_ctx);
 }
 
+static char *flac_sink_get_track_path(void *ctx,
+                                      const dsdpipe_metadata_t *metadata)
+{
+    dsdpipe_sink_flac_ctx_t *flac_ctx = (dsdpipe_sink_flac_ctx_t *)ctx;
+
+    if (!flac_ctx) {
+        return NULL;
+    }
+
+    return generate_track_filename(flac_ctx->base_path, metadata,
+                                   flac_ctx->track_filename_format);
+}
+
+static void flac_sink_set_loudness(void *ctx, uint8_t track_number,
+                                   const dsdpipe_loudness_t *loudness)
+{
+    dsdpipe_sink_flac_ctx_t *flac_ctx = (dsdpipe_sink_flac_ctx_t *)ctx;
+
+    if (!flac_ctx || !loudness) {
+        return;
+    }
+
+    if (track_number == 0) {
+        flac_ctx->album_loudness = *loudness;
+    } else if (track_number == flac_ctx->current_track) {
+        flac_ctx->track_loudness = *loudness;
+    }
+}
+
 /*============================================================================
  * Operations Table
  *============================================================================*/
@@ -737,7 +950,9 @@ static const dsdpipe_sink_ops_t s_flac_sink_ops = {
     .write_frame = flac_sink_write_frame,
     .finalize = flac_sink_finalize,
     .get_capabilities = flac_sink_get_capabilities,
-    .destroy = flac_sink_destroy
+    .destroy = flac_sink_destroy,
+    .get_track_path = flac_sink_get_track_path,
+    .set_loudness = flac_sink_set_loudness
 };
 
 #endif /* HAVE_LIBFLAC */
@@ -772,6 +987,7 @@ int dsdpipe_sink_flac_create(dsdpipe_sink_t **sink,
 
     ctx->bit_depth = config->opts.flac.bit_depth;
     ctx->compression = config->opts.flac.compression;
+    ctx->threads = config->opts.flac.threads;
     ctx->track_filename_format = config->track_filename_format;
 
     /* Set defaults if not specified */
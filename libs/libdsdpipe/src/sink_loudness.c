@@ -0,0 +1,285 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Loudness analysis sink
+ * Measures EBU R128 loudness, loudness range and true peak of the PCM
+ * stream produced by the DSD-to-PCM transform. Writes no file; the
+ * pipeline hands the per-track and album results to the other sinks
+ * (tags, XML export) in the same run.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "dsdpipe_internal.h"
+#include "loudness.h"
+
+#include <libsautil/mem.h>
+
+#include <string.h>
+
+/*============================================================================
+ * Loudness Sink Context
+ *============================================================================*/
+
+typedef struct dsdpipe_sink_loudness_ctx_s {
+    dsdpipe_loudness_meter_t *meter;    /**< Meter (created at open) */
+    dsdpipe_format_t format;            /**< PCM input format */
+
+    uint8_t current_track;              /**< Track being measured (0 = none) */
+    dsdpipe_loudness_t tracks[DSDPIPE_MAX_TRACKS + 1]; /**< Results by track number */
+    bool album_incomplete;              /**< Some selected tracks were not measured */
+
+    bool is_open;
+} dsdpipe_sink_loudness_ctx_t;
+
+/*============================================================================
+ * Sink Operations
+ *============================================================================*/
+
+static int loudness_sink_open(void *ctx, const char *path,
+                               const dsdpipe_format_t *format,
+                               const dsdpipe_metadata_t *metadata)
+{
+    dsdpipe_sink_loudness_ctx_t *loud_ctx = (dsdpipe_sink_loudness_ctx_t *)ctx;
+
+    (void)path;
+    (void)metadata;
+
+    if (!loud_ctx || !format) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (format->type != DSDPIPE_FORMAT_PCM_FLOAT32 &&
+        format->type != DSDPIPE_FORMAT_PCM_FLOAT64) {
+        return DSDPIPE_ERROR_UNSUPPORTED;
+    }
+
+    dsdpipe_loudness_meter_destroy(loud_ctx->meter);
+    loud_ctx->meter = NULL;
+
+    int result = dsdpipe_loudness_meter_create(&loud_ctx->meter,
+                                               format->sample_rate,
+                                               format->channel_count);
+    if (result != DSDPIPE_OK) {
+        return result;
+    }
+
+    loud_ctx->format = *format;
+    loud_ctx->current_track = 0;
+    memset(loud_ctx->tracks, 0, sizeof(loud_ctx->tracks));
+    loud_ctx->album_incomplete = false;
+    loud_ctx->is_open = true;
+
+    return DSDPIPE_OK;
+}
+
+static void loudness_sink_close(void *ctx)
+{
+    dsdpipe_sink_loudness_ctx_t *loud_ctx = (dsdpipe_sink_loudness_ctx_t *)ctx;
+
+    if (!loud_ctx) {
+        return;
+    }
+
+    /* Results stay available for dsdpipe_get_loudness() until destroy */
+    loud_ctx->is_open = false;
+}
+
+static int loudness_sink_track_start(void *ctx, uint8_t track_number,
+                                      const dsdpipe_metadata_t *metadata)
+{
+    dsdpipe_sink_loudness_ctx_t *loud_ctx = (dsdpipe_sink_loudness_ctx_t *)ctx;
+
+    (void)metadata;
+
+    if (!loud_ctx || !loud_ctx->is_open) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    dsdpipe_loudness_meter_start_track(loud_ctx->meter);
+    loud_ctx->current_track = track_number;
+    memset(&loud_ctx->tracks[track_number], 0, sizeof(dsdpipe_loudness_t));
+
+    return DSDPIPE_OK;
+}
+
+static int loudness_sink_track_end(void *ctx, uint8_t track_number)
+{
+    dsdpipe_sink_loudness_ctx_t *loud_ctx = (dsdpipe_sink_loudness_ctx_t *)ctx;
+
+    if (!loud_ctx || !loud_ctx->is_open) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    dsdpipe_loudness_meter_get_track(loud_ctx->meter,
+                                     &loud_ctx->tracks[track_number]);
+    loud_ctx->current_track = 0;
+
+    return DSDPIPE_OK;
+}
+
+static int loudness_sink_write_frame(void *ctx, const dsdpipe_buffer_t *buffer)
+{
+    dsdpipe_sink_loudness_ctx_t *loud_ctx = (dsdpipe_sink_loudness_ctx_t *)ctx;
+
+    if (!loud_ctx || !loud_ctx->is_open || !buffer) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    uint16_t channels = buffer->format.channel_count;
+    if (channels == 0) {
+        return DSDPIPE_OK;
+    }
+
+    if (buffer->format.type == DSDPIPE_FORMAT_PCM_FLOAT32) {
+        size_t frames = buffer->size / (sizeof(float) * channels);
+        dsdpipe_loudness_meter_add_float(loud_ctx->meter,
+                                         (const float *)buffer->data, frames);
+    } else if (buffer->format.type == DSDPIPE_FORMAT_PCM_FLOAT64) {
+        size_t frames = buffer->size / (sizeof(double) * channels);
+        dsdpipe_loudness_meter_add_double(loud_ctx->meter,
+                                          (const double *)buffer->data, frames);
+    }
+
+    return DSDPIPE_OK;
+}
+
+static int loudness_sink_finalize(void *ctx)
+{
+    dsdpipe_sink_loudness_ctx_t *loud_ctx = (dsdpipe_sink_loudness_ctx_t *)ctx;
+
+    if (!loud_ctx) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (loud_ctx->meter && !loud_ctx->album_incomplete) {
+        dsdpipe_loudness_meter_get_album(loud_ctx->meter, &loud_ctx->tracks[0]);
+    }
+
+    return DSDPIPE_OK;
+}
+
+static uint32_t loudness_sink_get_capabilities(void *ctx)
+{
+    (void)ctx;
+    return DSDPIPE_SINK_CAP_PCM;
+}
+
+static void loudness_sink_destroy(void *ctx)
+{
+    dsdpipe_sink_loudness_ctx_t *loud_ctx = (dsdpipe_sink_loudness_ctx_t *)ctx;
+
+    if (!loud_ctx) {
+        return;
+    }
+
+    loudness_sink_close(ctx);
+    dsdpipe_loudness_meter_destroy(loud_ctx->meter);
+    sa_free(loud_ctx);
+}
+
+/*============================================================================
+ * Operations Table
+ *============================================================================*/
+
+static const dsdpipe_sink_ops_t s_loudness_sink_ops = {
+    .open = loudness_sink_open,
+    .close = loudness_sink_close,
+    .track_start = loudness_sink_track_start,
+    .track_end = loudness_sink_track_end,
+    .write_frame = loudness_sink_write_frame,
+    .finalize = loudness_sink_finalize,
+    .get_capabilities = loudness_sink_get_capabilities,
+    .destroy = loudness_sink_destroy
+};
+
+/*============================================================================
+ * Result Access
+ *============================================================================*/
+
+int dsdpipe_sink_loudness_measure(void *ctx, uint8_t track_number,
+                                  dsdpipe_loudness_t *loudness)
+{
+    dsdpipe_sink_loudness_ctx_t *loud_ctx = (dsdpipe_sink_loudness_ctx_t *)ctx;
+
+    if (!loud_ctx || !loudness || !loud_ctx->meter) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (track_number == 0) {
+        if (loud_ctx->album_incomplete) {
+            return DSDPIPE_ERROR_TRACK_NOT_FOUND;
+        }
+        dsdpipe_loudness_meter_get_album(loud_ctx->meter, loudness);
+    } else if (track_number == loud_ctx->current_track) {
+        dsdpipe_loudness_meter_get_track(loud_ctx->meter, loudness);
+    } else {
+        return DSDPIPE_ERROR_TRACK_NOT_FOUND;
+    }
+
+    return loudness->valid ? DSDPIPE_OK : DSDPIPE_ERROR_TRACK_NOT_FOUND;
+}
+
+void dsdpipe_sink_loudness_set_album_incomplete(void *ctx)
+{
+    dsdpipe_sink_loudness_ctx_t *loud_ctx = (dsdpipe_sink_loudness_ctx_t *)ctx;
+
+    if (loud_ctx) {
+        loud_ctx->album_incomplete = true;
+    }
+}
+
+int dsdpipe_sink_loudness_get_result(void *ctx, uint8_t track_number,
+                                     dsdpipe_loudness_t *loudness)
+{
+    dsdpipe_sink_loudness_ctx_t *loud_ctx = (dsdpipe_sink_loudness_ctx_t *)ctx;
+
+    if (!loud_ctx || !loudness) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (!loud_ctx->tracks[track_number].valid) {
+        return DSDPIPE_ERROR_TRACK_NOT_FOUND;
+    }
+
+    *loudness = loud_ctx->tracks[track_number];
+    return DSDPIPE_OK;
+}
+
+/*============================================================================
+ * Factory Function
+ *============================================================================*/
+
+int dsdpipe_sink_loudness_create(dsdpipe_sink_t *sink)
+{
+    dsdpipe_sink_loudness_ctx_t *ctx;
+
+    if (!sink) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    ctx = (dsdpipe_sink_loudness_ctx_t *)sa_calloc(1, sizeof(*ctx));
+    if (!ctx) {
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    sink->type = DSDPIPE_SINK_LOUDNESS;
+    sink->ops = &s_loudness_sink_ops;
+    sink->ctx = ctx;
+    sink->is_open = false;
+
+    return DSDPIPE_OK;
+}
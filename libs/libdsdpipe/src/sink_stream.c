@@ -0,0 +1,630 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Stream sink implementation for libdsdpipe
+ * Writes audio to a file descriptor such as stdout or a pipe. Unlike the
+ * file sinks, this sink never seeks: all tracks form one continuous stream
+ * and any header is written up front.
+ * Output formats:
+ *   - Raw DSD: byte-interleaved, MSB first (DSDIFF order)
+ *   - Raw PCM: interleaved little-endian signed 16/24/32-bit
+ *   - WAV: RIFF and data sizes set to 0xFFFFFFFF, the value streaming
+ *     readers take as "until end of stream"
+ *   - FLAC: libFLAC stream encoder without seek callback, so STREAMINFO
+ *     carries no sample count or MD5
+ * PCM input is the float output of the DSD-to-PCM transform; conversion to
+ * integers clips like the WAV and FLAC sinks.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "dsdpipe_internal.h"
+
+#include <libsautil/compat.h>
+#include <libsautil/cpu.h>
+#include <libsautil/mem.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef HAVE_LIBFLAC
+#include <FLAC/stream_encoder.h>
+#endif
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+/** stdio buffer size for the output stream */
+#define STREAM_SINK_BUFFER_SIZE     (256 * 1024)
+
+/** WAV chunk size meaning "unknown, read to end of stream" */
+#define WAV_STREAM_SIZE_UNKNOWN     0xFFFFFFFFu
+
+#define WAV_FORMAT_PCM              0x0001
+#define WAV_FORMAT_EXTENSIBLE       0xFFFE
+
+#define STREAM_FLAC_MAX_THREADS     64    /**< libFLAC encoder thread limit */
+
+/** libFLAC 1.5 (API 14) added the multithreaded encoder */
+#if defined(HAVE_LIBFLAC) && defined(FLAC_API_VERSION_CURRENT) && \
+    FLAC_API_VERSION_CURRENT >= 14
+#define STREAM_FLAC_HAVE_THREADS    1
+#endif
+
+/*============================================================================
+ * Stream Sink Context
+ *============================================================================*/
+
+typedef struct dsdpipe_sink_stream_ctx_s {
+    /* Configuration */
+    int fd;                         /**< File descriptor (not owned) */
+    dsdpipe_stream_format_t output; /**< Output format */
+    int bit_depth;                  /**< PCM bit depth */
+    int compression;                /**< FLAC compression level (0-8) */
+    int threads;                    /**< FLAC encoder threads (0 = one per CPU) */
+
+    /* Output */
+    FILE *fp;                       /**< Buffered stream on a duplicate of fd */
+    dsdpipe_format_t format;        /**< Input format */
+
+#ifdef HAVE_LIBFLAC
+    FLAC__StreamEncoder *encoder;   /**< FLAC encoder (FLAC output only) */
+    bool write_failed;              /**< Write callback hit an error */
+#endif
+
+    /* Conversion buffer */
+    uint8_t *conv_buffer;           /**< Integer samples for output */
+    size_t conv_buffer_size;        /**< Conversion buffer size (bytes) */
+
+    bool is_open;                   /**< Whether sink is open */
+} dsdpipe_sink_stream_ctx_t;
+
+/*============================================================================
+ * Helper Functions
+ *============================================================================*/
+
+static void stream_put_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void stream_put_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)((v >> 8) & 0xFF);
+    p[2] = (uint8_t)((v >> 16) & 0xFF);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief Scale a float sample to a signed integer of @p bit_depth bits
+ */
+static int32_t stream_float_to_int(double value, int bit_depth)
+{
+    double max = (double)((1u << (bit_depth - 1)) - 1);
+    double val = value * max;
+
+    if (val > max) val = max;
+    if (val < -max - 1.0) val = -max - 1.0;
+    return (int32_t)val;
+}
+
+static int ensure_conv_buffer(dsdpipe_sink_stream_ctx_t *ctx, size_t bytes)
+{
+    if (ctx->conv_buffer_size >= bytes) {
+        return DSDPIPE_OK;
+    }
+
+    uint8_t *new_buffer = (uint8_t *)sa_realloc(ctx->conv_buffer, bytes);
+    if (!new_buffer) {
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    ctx->conv_buffer = new_buffer;
+    ctx->conv_buffer_size = bytes;
+    return DSDPIPE_OK;
+}
+
+/**
+ * @brief Write a WAV header with streaming sizes
+ *
+ * WAVE_FORMAT_EXTENSIBLE is used for more than two channels or more than
+ * 16 bits, as required for those layouts.
+ */
+static int write_wav_header(dsdpipe_sink_stream_ctx_t *ctx)
+{
+    static const uint32_t channel_masks[DSDPIPE_MAX_CHANNELS + 1] = {
+        0, 0x4, 0x3, 0x7, 0x33, 0x37, 0x3F
+    };
+    static const uint8_t pcm_guid[16] = {
+        0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+        0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71
+    };
+    uint8_t header[68];
+    uint16_t channels = ctx->format.channel_count;
+    uint16_t block_align = (uint16_t)(channels * (ctx->bit_depth / 8));
+    bool extensible = (channels > 2 || ctx->bit_depth > 16);
+    uint32_t fmt_size = extensible ? 40 : 16;
+    size_t pos = 0;
+
+    memcpy(header + pos, "RIFF", 4);
+    stream_put_le32(header + pos + 4, WAV_STREAM_SIZE_UNKNOWN);
+    memcpy(header + pos + 8, "WAVE", 4);
+    pos += 12;
+
+    memcpy(header + pos, "fmt ", 4);
+    stream_put_le32(header + pos + 4, fmt_size);
+    stream_put_le16(header + pos + 8, extensible ? WAV_FORMAT_EXTENSIBLE : WAV_FORMAT_PCM);
+    stream_put_le16(header + pos + 10, channels);
+    stream_put_le32(header + pos + 12, ctx->format.sample_rate);
+    stream_put_le32(header + pos + 16, ctx->format.sample_rate * block_align);
+    stream_put_le16(header + pos + 20, block_align);
+    stream_put_le16(header + pos + 22, (uint16_t)ctx->bit_depth);
+    pos += 24;
+
+    if (extensible) {
+        stream_put_le16(header + pos, 22);
+        stream_put_le16(header + pos + 2, (uint16_t)ctx->bit_depth);
+        stream_put_le32(header + pos + 4,
+                        channels <= DSDPIPE_MAX_CHANNELS ? channel_masks[channels] : 0);
+        memcpy(header + pos + 8, pcm_guid, sizeof(pcm_guid));
+        pos += 24;
+    }
+
+    memcpy(header + pos, "data", 4);
+    stream_put_le32(header + pos + 4, WAV_STREAM_SIZE_UNKNOWN);
+    pos += 8;
+
+    if (fwrite(header, 1, pos, ctx->fp) != pos) {
+        return DSDPIPE_ERROR_FILE_WRITE;
+    }
+
+    return DSDPIPE_OK;
+}
+
+#ifdef HAVE_LIBFLAC
+
+static FLAC__StreamEncoderWriteStatus stream_flac_write(
+    const FLAC__StreamEncoder *encoder, const FLAC__byte buffer[],
+    size_t bytes, uint32_t samples, uint32_t current_frame, void *client_data)
+{
+    dsdpipe_sink_stream_ctx_t *ctx = (dsdpipe_sink_stream_ctx_t *)client_data;
+
+    (void)encoder;
+    (void)samples;
+    (void)current_frame;
+
+    if (fwrite(buffer, 1, bytes, ctx->fp) != bytes) {
+        ctx->write_failed = true;
+        return FLAC__STREAM_ENCODER_WRITE_STATUS_FATAL_ERROR;
+    }
+
+    return FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+}
+
+static int open_flac_encoder(dsdpipe_sink_stream_ctx_t *ctx)
+{
+    ctx->encoder = FLAC__stream_encoder_new();
+    if (!ctx->encoder) {
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    FLAC__stream_encoder_set_channels(ctx->encoder, ctx->format.channel_count);
+    FLAC__stream_encoder_set_bits_per_sample(ctx->encoder, (unsigned)ctx->bit_depth);
+    FLAC__stream_encoder_set_sample_rate(ctx->encoder, ctx->format.sample_rate);
+    FLAC__stream_encoder_set_compression_level(ctx->encoder,
+                                               (unsigned)ctx->compression);
+    FLAC__stream_encoder_set_verify(ctx->encoder, false);
+
+#ifdef STREAM_FLAC_HAVE_THREADS
+    /* Same threading as the FLAC file sink; a refusal leaves one thread */
+    if (ctx->threads != 1) {
+        int threads = ctx->threads > 0 ? ctx->threads : sa_cpu_count();
+        if (threads > STREAM_FLAC_MAX_THREADS) {
+            threads = STREAM_FLAC_MAX_THREADS;
+        }
+        if (threads > 1) {
+            FLAC__stream_encoder_set_num_threads(ctx->encoder, (uint32_t)threads);
+        }
+    }
+#endif
+
+    /* No seek or tell callback: libFLAC leaves STREAMINFO as first written */
+    FLAC__StreamEncoderInitStatus init_status =
+        FLAC__stream_encoder_init_stream(ctx->encoder, stream_flac_write,
+                                         NULL, NULL, NULL, ctx);
+    if (init_status != FLAC__STREAM_ENCODER_INIT_STATUS_OK) {
+        FLAC__stream_encoder_delete(ctx->encoder);
+        ctx->encoder = NULL;
+        return DSDPIPE_ERROR_FILE_CREATE;
+    }
+
+    return DSDPIPE_OK;
+}
+
+static int write_flac(dsdpipe_sink_stream_ctx_t *ctx, const dsdpipe_buffer_t *buffer,
+                      size_t samples)
+{
+    int result = ensure_conv_buffer(ctx, samples * sizeof(int32_t));
+    if (result != DSDPIPE_OK) {
+        return result;
+    }
+
+    int32_t *dst = (int32_t *)ctx->conv_buffer;
+    if (buffer->format.type == DSDPIPE_FORMAT_PCM_FLOAT64) {
+        const double *src = (const double *)buffer->data;
+        for (size_t i = 0; i < samples; i++) {
+            dst[i] = stream_float_to_int(src[i], ctx->bit_depth);
+        }
+    } else {
+        const float *src = (const float *)buffer->data;
+        for (size_t i = 0; i < samples; i++) {
+            dst[i] = stream_float_to_int(src[i], ctx->bit_depth);
+        }
+    }
+
+    unsigned frames = (unsigned)(samples / ctx->format.channel_count);
+    if (!FLAC__stream_encoder_process_interleaved(ctx->encoder, dst, frames)) {
+        return DSDPIPE_ERROR_FILE_WRITE;
+    }
+
+    return DSDPIPE_OK;
+}
+
+#endif /* HAVE_LIBFLAC */
+
+/**
+ * @brief Convert float samples to packed little-endian integers and write
+ */
+static int write_pcm(dsdpipe_sink_stream_ctx_t *ctx, const dsdpipe_buffer_t *buffer,
+                     size_t samples)
+{
+    size_t out_bytes = (size_t)(ctx->bit_depth / 8);
+    int result = ensure_conv_buffer(ctx, samples * out_bytes);
+    if (result != DSDPIPE_OK) {
+        return result;
+    }
+
+    const float *src32 = (const float *)buffer->data;
+    const double *src64 = (const double *)buffer->data;
+    bool is_double = (buffer->format.type == DSDPIPE_FORMAT_PCM_FLOAT64);
+    uint8_t *dst = ctx->conv_buffer;
+
+    for (size_t i = 0; i < samples; i++) {
+        double value = is_double ? src64[i] : (double)src32[i];
+        uint32_t v = (uint32_t)stream_float_to_int(value, ctx->bit_depth);
+        for (size_t b = 0; b < out_bytes; b++) {
+            *dst++ = (uint8_t)(v >> (8 * b));
+        }
+    }
+
+    size_t total = samples * out_bytes;
+    if (fwrite(ctx->conv_buffer, 1, total, ctx->fp) != total) {
+        return DSDPIPE_ERROR_FILE_WRITE;
+    }
+
+    return DSDPIPE_OK;
+}
+
+/*============================================================================
+ * Sink Operations
+ *============================================================================*/
+
+static void stream_sink_close(void *ctx);
+
+static int stream_sink_open(void *ctx, const char *path,
+                            const dsdpipe_format_t *format,
+                            const dsdpipe_metadata_t *metadata)
+{
+    dsdpipe_sink_stream_ctx_t *stream_ctx = (dsdpipe_sink_stream_ctx_t *)ctx;
+    int fd;
+    int result = DSDPIPE_OK;
+
+    (void)path;
+    (void)metadata;
+
+    if (!stream_ctx || !format) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (stream_ctx->output == DSDPIPE_STREAM_RAW_DSD) {
+        if (format->type != DSDPIPE_FORMAT_DSD_RAW) {
+            return DSDPIPE_ERROR_UNSUPPORTED;
+        }
+    } else if (format->type != DSDPIPE_FORMAT_PCM_FLOAT32 &&
+               format->type != DSDPIPE_FORMAT_PCM_FLOAT64) {
+        return DSDPIPE_ERROR_UNSUPPORTED;
+    }
+
+    if (format->channel_count == 0 || format->channel_count > DSDPIPE_MAX_CHANNELS) {
+        return DSDPIPE_ERROR_UNSUPPORTED;
+    }
+
+    /* Wrap a duplicate so fclose() leaves the caller's descriptor open */
+#ifdef _WIN32
+    _setmode(stream_ctx->fd, _O_BINARY);
+    fd = _dup(stream_ctx->fd);
+    stream_ctx->fp = (fd >= 0) ? _fdopen(fd, "wb") : NULL;
+#else
+    fd = dup(stream_ctx->fd);
+    stream_ctx->fp = (fd >= 0) ? fdopen(fd, "wb") : NULL;
+#endif
+    if (!stream_ctx->fp) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return DSDPIPE_ERROR_FILE_CREATE;
+    }
+    setvbuf(stream_ctx->fp, NULL, _IOFBF, STREAM_SINK_BUFFER_SIZE);
+
+    stream_ctx->format = *format;
+
+    switch (stream_ctx->output) {
+        case DSDPIPE_STREAM_WAV:
+            result = write_wav_header(stream_ctx);
+            break;
+        case DSDPIPE_STREAM_FLAC:
+#ifdef HAVE_LIBFLAC
+            stream_ctx->write_failed = false;
+            result = open_flac_encoder(stream_ctx);
+#else
+            result = DSDPIPE_ERROR_FLAC_UNAVAILABLE;
+#endif
+            break;
+        default:
+            break;
+    }
+
+    if (result != DSDPIPE_OK) {
+        stream_sink_close(ctx);
+        return result;
+    }
+
+    stream_ctx->is_open = true;
+    return DSDPIPE_OK;
+}
+
+static void stream_sink_close(void *ctx)
+{
+    dsdpipe_sink_stream_ctx_t *stream_ctx = (dsdpipe_sink_stream_ctx_t *)ctx;
+
+    if (!stream_ctx) {
+        return;
+    }
+
+#ifdef HAVE_LIBFLAC
+    if (stream_ctx->encoder) {
+        FLAC__stream_encoder_finish(stream_ctx->encoder);
+        FLAC__stream_encoder_delete(stream_ctx->encoder);
+        stream_ctx->encoder = NULL;
+    }
+#endif
+
+    if (stream_ctx->fp) {
+        fclose(stream_ctx->fp);
+        stream_ctx->fp = NULL;
+    }
+
+    stream_ctx->is_open = false;
+}
+
+static int stream_sink_track_start(void *ctx, uint8_t track_number,
+                                   const dsdpipe_metadata_t *metadata)
+{
+    dsdpipe_sink_stream_ctx_t *stream_ctx = (dsdpipe_sink_stream_ctx_t *)ctx;
+
+    (void)track_number;
+    (void)metadata;
+
+    if (!stream_ctx || !stream_ctx->is_open) {
+        return DSDPIPE_ERROR_INVALID_STATE;
+    }
+
+    /* Tracks follow each other in the one stream */
+    return DSDPIPE_OK;
+}
+
+static int stream_sink_track_end(void *ctx, uint8_t track_number)
+{
+    dsdpipe_sink_stream_ctx_t *stream_ctx = (dsdpipe_sink_stream_ctx_t *)ctx;
+
+    (void)track_number;
+
+    if (!stream_ctx || !stream_ctx->is_open) {
+        return DSDPIPE_ERROR_INVALID_STATE;
+    }
+
+    /* Hand complete tracks to the reader without waiting for more data */
+    if (fflush(stream_ctx->fp) != 0) {
+        return DSDPIPE_ERROR_FILE_WRITE;
+    }
+
+    return DSDPIPE_OK;
+}
+
+static int stream_sink_write_frame(void *ctx, const dsdpipe_buffer_t *buffer)
+{
+    dsdpipe_sink_stream_ctx_t *stream_ctx = (dsdpipe_sink_stream_ctx_t *)ctx;
+
+    if (!stream_ctx || !buffer) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (!stream_ctx->is_open) {
+        return DSDPIPE_ERROR_INVALID_STATE;
+    }
+
+    if (buffer->size == 0) {
+        return DSDPIPE_OK;
+    }
+
+    if (stream_ctx->output == DSDPIPE_STREAM_RAW_DSD) {
+        if (buffer->format.type != DSDPIPE_FORMAT_DSD_RAW) {
+            return DSDPIPE_ERROR_INVALID_ARG;
+        }
+        if (fwrite(buffer->data, 1, buffer->size, stream_ctx->fp) != buffer->size) {
+            return DSDPIPE_ERROR_FILE_WRITE;
+        }
+        return DSDPIPE_OK;
+    }
+
+    size_t sample_bytes;
+    if (buffer->format.type == DSDPIPE_FORMAT_PCM_FLOAT32) {
+        sample_bytes = sizeof(float);
+    } else if (buffer->format.type == DSDPIPE_FORMAT_PCM_FLOAT64) {
+        sample_bytes = sizeof(double);
+    } else {
+        /* Non-PCM data received - pipeline should have inserted DSD2PCM transform */
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    /* Whole sample frames only */
+    size_t samples = buffer->size / sample_bytes;
+    samples -= samples % stream_ctx->format.channel_count;
+    if (samples == 0) {
+        return DSDPIPE_OK;
+    }
+
+#ifdef HAVE_LIBFLAC
+    if (stream_ctx->output == DSDPIPE_STREAM_FLAC) {
+        return write_flac(stream_ctx, buffer, samples);
+    }
+#endif
+
+    return write_pcm(stream_ctx, buffer, samples);
+}
+
+static int stream_sink_finalize(void *ctx)
+{
+    dsdpipe_sink_stream_ctx_t *stream_ctx = (dsdpipe_sink_stream_ctx_t *)ctx;
+    int result = DSDPIPE_OK;
+
+    if (!stream_ctx) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (!stream_ctx->is_open) {
+        return DSDPIPE_OK;
+    }
+
+#ifdef HAVE_LIBFLAC
+    if (stream_ctx->encoder) {
+        if (!FLAC__stream_encoder_finish(stream_ctx->encoder) ||
+            stream_ctx->write_failed) {
+            result = DSDPIPE_ERROR_FILE_WRITE;
+        }
+        FLAC__stream_encoder_delete(stream_ctx->encoder);
+        stream_ctx->encoder = NULL;
+    }
+#endif
+
+    if (fflush(stream_ctx->fp) != 0 || ferror(stream_ctx->fp)) {
+        result = DSDPIPE_ERROR_FILE_WRITE;
+    }
+
+    return result;
+}
+
+static uint32_t stream_sink_get_capabilities(void *ctx)
+{
+    dsdpipe_sink_stream_ctx_t *stream_ctx = (dsdpipe_sink_stream_ctx_t *)ctx;
+
+    if (stream_ctx && stream_ctx->output == DSDPIPE_STREAM_RAW_DSD) {
+        return DSDPIPE_SINK_CAP_DSD;
+    }
+
+    return DSDPIPE_SINK_CAP_PCM;
+}
+
+static void stream_sink_destroy(void *ctx)
+{
+    dsdpipe_sink_stream_ctx_t *stream_ctx = (dsdpipe_sink_stream_ctx_t *)ctx;
+
+    if (!stream_ctx) {
+        return;
+    }
+
+    stream_sink_close(ctx);
+    sa_free(stream_ctx->conv_buffer);
+    sa_free(stream_ctx);
+}
+
+/*============================================================================
+ * Operations Table
+ *============================================================================*/
+
+static const dsdpipe_sink_ops_t s_stream_sink_ops = {
+    .open = stream_sink_open,
+    .close = stream_sink_close,
+    .track_start = stream_sink_track_start,
+    .track_end = stream_sink_track_end,
+    .write_frame = stream_sink_write_frame,
+    .finalize = stream_sink_finalize,
+    .get_capabilities = stream_sink_get_capabilities,
+    .destroy = stream_sink_destroy
+};
+
+/*============================================================================
+ * Factory Function
+ *============================================================================*/
+
+int dsdpipe_sink_stream_create(dsdpipe_sink_t **sink,
+                                const dsdpipe_sink_config_t *config)
+{
+    if (!sink || !config || config->opts.stream.fd < 0) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+#ifndef HAVE_LIBFLAC
+    if (config->opts.stream.format == DSDPIPE_STREAM_FLAC) {
+        return DSDPIPE_ERROR_FLAC_UNAVAILABLE;
+    }
+#endif
+
+    dsdpipe_sink_t *new_sink = (dsdpipe_sink_t *)sa_calloc(1, sizeof(*new_sink));
+    if (!new_sink) {
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    dsdpipe_sink_stream_ctx_t *ctx =
+        (dsdpipe_sink_stream_ctx_t *)sa_calloc(1, sizeof(*ctx));
+    if (!ctx) {
+        sa_free(new_sink);
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    ctx->fd = config->opts.stream.fd;
+    ctx->output = config->opts.stream.format;
+    ctx->bit_depth = config->opts.stream.bit_depth;
+    ctx->compression = config->opts.stream.compression;
+    ctx->threads = config->opts.stream.threads;
+    if (ctx->compression < 0 || ctx->compression > 8) {
+        ctx->compression = 5;
+    }
+
+    new_sink->type = DSDPIPE_SINK_STREAM;
+    new_sink->ops = &s_stream_sink_ops;
+    new_sink->ctx = ctx;
+    new_sink->config = *config;
+    new_sink->config.path = dsdpipe_strdup(config->path);
+    new_sink->caps = stream_sink_get_capabilities(ctx);
+    new_sink->is_open = false;
+
+    *sink = new_sink;
+    return DSDPIPE_OK;
+}
@@ -15,6 +15,8 @@
  *   - 16-bit: WAV with 16-bit integer PCM samples
  *   - 24-bit: WAV with 24-bit integer PCM samples
  *   - 32-bit: WAV with 32-bit IEEE float samples
+ * When a loudness measurement is available, a BWF "bext" version 2 chunk
+ * carrying the EBU R128 loudness fields is appended after the audio data.
  * NOTE: This sink requires PCM data. The pipeline should have a DSD-to-PCM
  *       transform inserted when the source provides DSD/DST data.
  *
@@ -56,6 +58,12 @@
 #define WAV_SINK_SAMPLE_BUFFER_SIZE 8192
 #define WAV_SINK_MAX_METADATA       8
 
+/* BWF "bext" chunk (EBU Tech 3285 v2) */
+#define WAV_BEXT_SIZE               602
+#define WAV_BEXT_VERSION_OFFSET     346
+#define WAV_BEXT_LOUDNESS_OFFSET    412
+#define WAV_BEXT_UNKNOWN_LOUDNESS   0x7FFF
+
 /*============================================================================
  * WAV Sink Context
  *============================================================================*/
@@ -73,6 +81,7 @@ typedef struct dsdpipe_sink_wav_ctx_s {
     /* Track state */
     uint8_t current_track;      /**< Current track number */
     bool track_file_open;       /**< Whether a track file is currently open */
+    dsdpipe_loudness_t track_loudness; /**< Pending loudness for the bext chunk */
 
     /* dr_wav instance */
     drwav wav;                  /**< dr_wav writer state */
@@ -373,24 +382,126 @@ static drwav_uint32 build_metadata(dsdpipe_sink_wav_ctx_t *ctx,
     return count;
 }
 
+/*============================================================================
+ * Helper: Append BWF loudness chunk
+ *============================================================================*/
+
+static void wav_put_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void wav_put_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)((v >> 8) & 0xFF);
+    p[2] = (uint8_t)((v >> 16) & 0xFF);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief Encode a loudness value as bext int16 (value x 100)
+ */
+static uint16_t wav_bext_loudness(double value, bool known)
+{
+    if (!known || value < -327.67 || value > 327.67) {
+        return WAV_BEXT_UNKNOWN_LOUDNESS;
+    }
+    double scaled = value * 100.0;
+    return (uint16_t)(int16_t)(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+}
+
+/**
+ * @brief Append a "bext" chunk and patch the RIFF size
+ *
+ * Called after drwav_uninit(), so the header already describes the audio
+ * data; the chunk is added after it and the RIFF size grown to cover it.
+ */
+static int append_bext_chunk(FILE *f, const dsdpipe_loudness_t *loudness)
+{
+    uint8_t chunk[8 + WAV_BEXT_SIZE];
+    uint8_t *bext = chunk + 8;
+
+    memset(chunk, 0, sizeof(chunk));
+    memcpy(chunk, "bext", 4);
+    wav_put_le32(chunk + 4, WAV_BEXT_SIZE);
+
+    memcpy(bext + 256, "DSD-Nexus", 9);     /* Originator */
+    wav_put_le16(bext + WAV_BEXT_VERSION_OFFSET, 2);
+
+    uint8_t *lp = bext + WAV_BEXT_LOUDNESS_OFFSET;
+    wav_put_le16(lp + 0, wav_bext_loudness(loudness->integrated_lufs, true));
+    wav_put_le16(lp + 2, wav_bext_loudness(loudness->loudness_range_lu, true));
+    wav_put_le16(lp + 4, wav_bext_loudness(loudness->true_peak_dbtp,
+                                           loudness->true_peak > 0.0));
+    wav_put_le16(lp + 6, wav_bext_loudness(loudness->max_momentary_lufs,
+                                           loudness->max_momentary_lufs > -70.0));
+    wav_put_le16(lp + 8, wav_bext_loudness(loudness->max_short_term_lufs,
+                                           loudness->max_short_term_lufs > -70.0));
+
+    if (sa_fseek64(f, 0, SEEK_END) != 0) {
+        return DSDPIPE_ERROR_FILE_WRITE;
+    }
+
+    int64_t end = sa_ftell64(f);
+    if (end < 12) {
+        return DSDPIPE_ERROR_FILE_WRITE;
+    }
+
+    /* RIFF chunks start on even offsets */
+    if (end & 1) {
+        if (fputc(0, f) == EOF) {
+            return DSDPIPE_ERROR_FILE_WRITE;
+        }
+        end++;
+    }
+
+    if (end + (int64_t)sizeof(chunk) - 8 > (int64_t)UINT32_MAX) {
+        return DSDPIPE_ERROR_UNSUPPORTED;
+    }
+
+    if (fwrite(chunk, 1, sizeof(chunk), f) != sizeof(chunk)) {
+        return DSDPIPE_ERROR_FILE_WRITE;
+    }
+
+    uint8_t riff_size[4];
+    wav_put_le32(riff_size, (uint32_t)(end + (int64_t)sizeof(chunk) - 8));
+    if (sa_fseek64(f, 4, SEEK_SET) != 0 ||
+        fwrite(riff_size, 1, sizeof(riff_size), f) != sizeof(riff_size)) {
+        return DSDPIPE_ERROR_FILE_WRITE;
+    }
+
+    return DSDPIPE_OK;
+}
+
 /*============================================================================
  * Helper: Close current track safely
  *============================================================================*/
 
-static void close_current_track(dsdpipe_sink_wav_ctx_t *ctx)
+static int close_current_track(dsdpipe_sink_wav_ctx_t *ctx)
 {
+    int result = DSDPIPE_OK;
+
     if (!ctx->track_file_open) {
-        return;
+        return DSDPIPE_OK;
     }
 
     drwav_uninit(&ctx->wav);
 
+    if (ctx->wav_file && ctx->track_loudness.valid) {
+        result = append_bext_chunk(ctx->wav_file, &ctx->track_loudness);
+    }
+
     if (ctx->wav_file) {
-        fclose(ctx->wav_file);
+        if (fclose(ctx->wav_file) != 0) {
+            result = DSDPIPE_ERROR_FILE_WRITE;
+        }
         ctx->wav_file = NULL;
     }
 
     ctx->track_file_open = false;
+    return result;
 }
 
 /*============================================================================
@@ -510,6 +621,7 @@ static int wav_sink_track_start(void *ctx, uint8_t track_number,
 
     wav_ctx->current_track = track_number;
     wav_ctx->track_samples = 0;
+    memset(&wav_ctx->track_loudness, 0, sizeof(wav_ctx->track_loudness));
 
     /* Generate unique output filename for this track */
     char *output_path = generate_track_filename(wav_ctx->base_path, metadata,
@@ -583,12 +695,13 @@ static int wav_sink_track_end(void *ctx, uint8_t track_number)
 
     (void)track_number;
 
+    int result = DSDPIPE_OK;
     if (wav_ctx->track_file_open) {
-        close_current_track(wav_ctx);
+        result = close_current_track(wav_ctx);
         wav_ctx->tracks_written++;
     }
 
-    return DSDPIPE_OK;
+    return result;
 }
 
 static int wav_sink_write_frame(void *ctx, const dsdpipe_buffer_t *buffer)
@@ -776,6 +889,33 @@ static void wav_sink_destroy(void *ctx)
     sa_free(wav_ctx);
 }
 
+static char *wav_sink_get_track_path(void *ctx,
+                                     const dsdpipe_metadata_t *metadata)
+{
+    dsdpipe_sink_wav_ctx_t *wav_ctx = (dsdpipe_sink_wav_ctx_t *)ctx;
+
+    if (!wav_ctx) {
+        return NULL;
+    }
+
+    return generate_track_filename(wav_ctx->base_path, metadata,
+                                   wav_ctx->track_filename_format);
+}
+
+static void wav_sink_set_loudness(void *ctx, uint8_t track_number,
+                                  const dsdpipe_loudness_t *loudness)
+{
+    dsdpipe_sink_wav_ctx_t *wav_ctx = (dsdpipe_sink_wav_ctx_t *)ctx;
+
+    /* bext carries per-file values only; album results are not stored */
+    if (!wav_ctx || !loudness || track_number == 0 ||
+        track_number != wav_ctx->current_track) {
+        return;
+    }
+
+    wav_ctx->track_loudness = *loudness;
+}
+
 /*============================================================================
  * Operations Table
  *============================================================================*/
@@ -788,7 +928,9 @@ static const dsdpipe_sink_ops_t s_wav_sink_ops = {
     .write_frame = wav_sink_write_frame,
     .finalize = wav_sink_finalize,
     .get_capabilities = wav_sink_get_capabilities,
-    .destroy = wav_sink_destroy
+    .destroy = wav_sink_destroy,
+    .get_track_path = wav_sink_get_track_path,
+    .set_loudness = wav_sink_set_loudness
 };
 
 /*============================================================================
@@ -62,6 +62,7 @@ typedef struct xml_track_info_s {
     uint32_t start_frame;           /**< Start position in SACD frames (75fps) */
     uint32_t duration_frames;       /**< Duration in SACD frames (75fps) */
     double duration_seconds;        /**< Duration in seconds */
+    dsdpipe_loudness_t loudness;    /**< Loudness measurement (if any) */
 } xml_track_info_t;
 
 /*============================================================================
@@ -89,6 +90,7 @@ typedef struct dsdpipe_sink_xml_ctx_s {
     uint16_t disc_number;
     uint16_t disc_total;
     uint16_t track_total;
+    dsdpipe_loudness_t album_loudness; /**< Album loudness (if measured) */
 
     /* Track collection */
     xml_track_info_t tracks[XML_MAX_TRACKS];
@@ -127,6 +129,47 @@ static XMLNode *xml_add_text_element(XMLNode *parent, const char *tag, const cha
     return node;
 }
 
+/**
+ * @brief Add a loudness element with the measurement as attributes
+ */
+static XMLNode *xml_add_loudness_element(XMLNode *parent,
+                                         const dsdpipe_loudness_t *loudness)
+{
+    XMLNode *node;
+    char buf[32];
+
+    if (!parent || !loudness || !loudness->valid) {
+        return NULL;
+    }
+
+    node = XMLNode_new(TAG_SELF, "loudness", NULL);
+    if (!node) {
+        return NULL;
+    }
+
+    snprintf(buf, sizeof(buf), "%.2f", loudness->integrated_lufs);
+    XMLNode_set_attribute(node, "integrated_lufs", buf);
+    snprintf(buf, sizeof(buf), "%.2f", loudness->loudness_range_lu);
+    XMLNode_set_attribute(node, "loudness_range_lu", buf);
+    snprintf(buf, sizeof(buf), "%.2f", loudness->true_peak_dbtp);
+    XMLNode_set_attribute(node, "true_peak_dbtp", buf);
+    snprintf(buf, sizeof(buf), "%.6f", loudness->sample_peak);
+    XMLNode_set_attribute(node, "sample_peak", buf);
+    snprintf(buf, sizeof(buf), "%.2f", loudness->max_momentary_lufs);
+    XMLNode_set_attribute(node, "max_momentary_lufs", buf);
+    snprintf(buf, sizeof(buf), "%.2f", loudness->max_short_term_lufs);
+    XMLNode_set_attribute(node, "max_short_term_lufs", buf);
+    snprintf(buf, sizeof(buf), "%.2f", loudness->replaygain_db);
+    XMLNode_set_attribute(node, "replaygain_db", buf);
+
+    if (!XMLNode_add_child(parent, node)) {
+        XMLNode_free(node);
+        return NULL;
+    }
+
+    return node;
+}
+
 /**
  * @brief Add an integer element to an XML node
  */
@@ -245,6 +288,7 @@ static int xml_sink_open(void *ctx, const char *path,
     xml_ctx->track_count = 0;
     xml_ctx->current_track_idx = 0;
     memset(xml_ctx->tracks, 0, sizeof(xml_ctx->tracks));
+    memset(&xml_ctx->album_loudness, 0, sizeof(xml_ctx->album_loudness));
 
     xml_ctx->is_open = true;
     return DSDPIPE_OK;
@@ -488,6 +532,7 @@ static int xml_sink_finalize(void *ctx)
     if (xml_ctx->track_total > 0) {
         xml_add_int_element(album_node, "track_total", xml_ctx->track_total);
     }
+    xml_add_loudness_element(album_node, &xml_ctx->album_loudness);
 
     /* Create tracks section */
     tracks_node = XMLNode_new(TAG_FATHER, "tracks", NULL);
@@ -606,6 +651,8 @@ static int xml_sink_finalize(void *ctx)
 
             XMLNode_add_child(track_node, timing_node);
         }
+
+        xml_add_loudness_element(track_node, &track->loudness);
     }
 
     /* Create audio_format section */
@@ -688,6 +735,28 @@ static void xml_sink_destroy(void *ctx)
     sa_free(xml_ctx);
 }
 
+static void xml_sink_set_loudness(void *ctx, uint8_t track_number,
+                                  const dsdpipe_loudness_t *loudness)
+{
+    dsdpipe_sink_xml_ctx_t *xml_ctx = (dsdpipe_sink_xml_ctx_t *)ctx;
+
+    if (!xml_ctx || !loudness) {
+        return;
+    }
+
+    if (track_number == 0) {
+        xml_ctx->album_loudness = *loudness;
+        return;
+    }
+
+    for (int i = 0; i < xml_ctx->track_count; i++) {
+        if (xml_ctx->tracks[i].track_number == track_number) {
+            xml_ctx->tracks[i].loudness = *loudness;
+            return;
+        }
+    }
+}
+
 /*============================================================================
  * Operations Table
  *============================================================================*/
@@ -700,7 +769,8 @@ static const dsdpipe_sink_ops_t s_xml_sink_ops = {
     .write_frame = xml_sink_write_frame,
     .finalize = xml_sink_finalize,
     .get_capabilities = xml_sink_get_capabilities,
-    .destroy = xml_sink_destroy
+    .destroy = xml_sink_destroy,
+    .set_loudness = xml_sink_set_loudness
 };
 
 /*============================================================================
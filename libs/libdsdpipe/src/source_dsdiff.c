@@ -531,6 +531,58 @@ static int dsdiff_source_seek_track(void *ctx, uint8_t track_number)
     return DSDPIPE_OK;
 }
 
+static int dsdiff_source_seek_frame(void *ctx, uint64_t frame)
+{
+    dsdpipe_source_dsdiff_ctx_t *dsdiff_ctx = (dsdpipe_source_dsdiff_ctx_t *)ctx;
+    int result;
+
+    if (!dsdiff_ctx) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (!dsdiff_ctx->is_open) {
+        return DSDPIPE_ERROR_NOT_CONFIGURED;
+    }
+
+    if (dsdiff_ctx->current_track == 0) {
+        return DSDPIPE_ERROR_TRACK_NOT_FOUND;
+    }
+
+    uint64_t samples_per_frame = dsdiff_ctx->sample_rate / DSDIFF_SOURCE_FRAME_RATE;
+    uint64_t target_sample = dsdiff_ctx->track_start_sample + frame * samples_per_frame;
+    if (target_sample > dsdiff_ctx->track_end_sample) {
+        target_sample = dsdiff_ctx->track_end_sample;
+    }
+
+    if (dsdiff_ctx->audio_type == DSDIFF_AUDIO_DST) {
+        /* DST frames vary in size; only the DSTI index can locate them */
+        int has_index = 0;
+        dsdiff_has_dst_index(dsdiff_ctx->dsdiff, &has_index);
+        if (!has_index) {
+            return DSDPIPE_ERROR_UNSUPPORTED;
+        }
+
+        uint32_t frame_index = (uint32_t)(target_sample / samples_per_frame);
+        result = dsdiff_seek_dst_frame(dsdiff_ctx->dsdiff, frame_index);
+        if (result != DSDIFF_SUCCESS) {
+            return DSDPIPE_ERROR_READ;
+        }
+        dsdiff_ctx->dst_frame_index = frame_index;
+    } else {
+        result = dsdiff_seek_dsd_data(dsdiff_ctx->dsdiff,
+                                      (int64_t)(target_sample / 8),
+                                      DSDIFF_SEEK_SET);
+        if (result != DSDIFF_SUCCESS) {
+            return DSDPIPE_ERROR_READ;
+        }
+    }
+
+    dsdiff_ctx->current_frame = frame;
+    dsdiff_ctx->current_sample = target_sample;
+
+    return DSDPIPE_OK;
+}
+
 static int dsdiff_source_read_frame(void *ctx, dsdpipe_buffer_t *buffer)
 {
     dsdpipe_source_dsdiff_ctx_t *dsdiff_ctx = (dsdpipe_source_dsdiff_ctx_t *)ctx;
@@ -816,6 +868,7 @@ static const dsdpipe_source_ops_t s_dsdiff_source_ops = {
     .get_track_count = dsdiff_source_get_track_count,
     .get_format = dsdiff_source_get_format,
     .seek_track = dsdiff_source_seek_track,
+    .seek_frame = dsdiff_source_seek_frame,
     .read_frame = dsdiff_source_read_frame,
     .get_album_metadata = dsdiff_source_get_album_metadata,
     .get_track_metadata = dsdiff_source_get_track_metadata,
@@ -37,6 +37,9 @@
 /** Frame rate for SACD-compatible output (frames per second) */
 #define DSF_SOURCE_FRAME_RATE       75
 
+/** Scratch size for skipping into a DSF block group */
+#define DSF_SOURCE_SEEK_CHUNK       4096
+
 /*============================================================================
  * DSF Source Context
  *============================================================================*/
@@ -263,6 +266,60 @@ static int dsf_source_seek_track(void *ctx, uint8_t track_number)
     return DSDPIPE_OK;
 }
 
+static int dsf_source_seek_frame(void *ctx, uint64_t frame)
+{
+    dsdpipe_source_dsf_ctx_t *dsf_ctx = (dsdpipe_source_dsf_ctx_t *)ctx;
+    uint8_t discard[DSF_SOURCE_SEEK_CHUNK];
+    int result;
+
+    if (!dsf_ctx) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (!dsf_ctx->is_open) {
+        return DSDPIPE_ERROR_NOT_CONFIGURED;
+    }
+
+    if (dsf_ctx->current_track == 0) {
+        return DSDPIPE_ERROR_TRACK_NOT_FOUND;
+    }
+
+    uint64_t target = frame * dsf_ctx->bytes_per_frame;
+    if (target > dsf_ctx->audio_data_size) {
+        target = dsf_ctx->audio_data_size;
+    }
+
+    /*
+     * DSF stores audio in per-channel blocks, so the file can only be
+     * entered at a block group boundary. Seek there, then read off the
+     * remainder of the partial group.
+     */
+    uint64_t group_size = (uint64_t)DSF_BLOCK_SIZE_PER_CHANNEL *
+                          dsf_ctx->format.channel_count;
+    uint64_t group_start = (target / group_size) * group_size;
+
+    result = dsf_seek_audio_data(dsf_ctx->dsf, (int64_t)group_start, DSF_SEEK_SET);
+    if (result != DSF_SUCCESS) {
+        return DSDPIPE_ERROR_READ;
+    }
+
+    uint64_t skip = target - group_start;
+    while (skip > 0) {
+        size_t chunk = (skip < sizeof(discard)) ? (size_t)skip : sizeof(discard);
+        size_t bytes_read = 0;
+        result = dsf_read_audio_data(dsf_ctx->dsf, discard, chunk, &bytes_read);
+        if (result != DSF_SUCCESS || bytes_read == 0) {
+            return DSDPIPE_ERROR_READ;
+        }
+        skip -= bytes_read;
+    }
+
+    dsf_ctx->current_frame = frame;
+    dsf_ctx->audio_position = target;
+
+    return DSDPIPE_OK;
+}
+
 static int dsf_source_read_frame(void *ctx, dsdpipe_buffer_t *buffer)
 {
     dsdpipe_source_dsf_ctx_t *dsf_ctx = (dsdpipe_source_dsf_ctx_t *)ctx;
@@ -476,6 +533,7 @@ static const dsdpipe_source_ops_t s_dsf_source_ops = {
     .get_track_count = dsf_source_get_track_count,
     .get_format = dsf_source_get_format,
     .seek_track = dsf_source_seek_track,
+    .seek_frame = dsf_source_seek_frame,
     .read_frame = dsf_source_read_frame,
     .get_album_metadata = dsf_source_get_album_metadata,
     .get_track_metadata = dsf_source_get_track_metadata,
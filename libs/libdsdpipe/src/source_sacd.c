@@ -32,8 +32,8 @@
  * Constants
  *============================================================================*/
 
-/** Maximum DST frame buffer size */
-#define SACD_SOURCE_FRAME_BUFFER_SIZE   (SACD_MAX_DST_SIZE)
+/** Frames fetched per libsacd call; one sector run covers about this many */
+#define SACD_SOURCE_BATCH_FRAMES        32
 
 /** Text channel to use for metadata (1 = primary language) */
 #define SACD_TEXT_CHANNEL               1
@@ -61,8 +61,10 @@ typedef struct dsdpipe_source_sacd_ctx_s {
     uint32_t track_index_start;             /**< Start frame of current track */
     uint32_t track_frame_length;            /**< Length of current track in frames */
 
-    /* Frame buffer for reading */
-    uint8_t *frame_buffer;                  /**< Buffer for reading frames */
+    /* Frames read ahead, handed out one per read_frame() */
+    sacd_frame_ref_t batch[SACD_SOURCE_BATCH_FRAMES];
+    uint32_t batch_count;                   /**< Valid entries in batch */
+    uint32_t batch_pos;                     /**< Next entry to hand out */
 
     /* State flags */
     bool is_open;                           /**< Whether source is open */
@@ -80,6 +82,17 @@ static channel_t map_channel_type(dsdpipe_channel_type_t type)
     return (type == DSDPIPE_CHANNEL_MULTICHANNEL) ? MULTI_CHANNEL : TWO_CHANNEL;
 }
 
+/**
+ * @brief Drops the frames read ahead but not handed out yet
+ */
+static void drop_batch(dsdpipe_source_sacd_ctx_t *sacd_ctx)
+{
+    sacd_release_sound_frames(sacd_ctx->batch + sacd_ctx->batch_pos,
+                              sacd_ctx->batch_count - sacd_ctx->batch_pos);
+    sacd_ctx->batch_count = 0;
+    sacd_ctx->batch_pos = 0;
+}
+
 /**
  * @brief Gets genre string from genre table and index
  */
@@ -163,8 +176,9 @@ static int sacd_source_open(void *ctx, const char *path)
         return DSDPIPE_ERROR_OUT_OF_MEMORY;
     }
 
-    /* Initialize reader - open the ISO file */
-    result = sacd_init(sacd_ctx->sacd, path, 1, 1);
+    /* Initialize reader - open the ISO file. Text and the access list are
+     * decoded when first asked for, so opening only for info stays cheap. */
+    result = sacd_init_ex(sacd_ctx->sacd, path, 1, 1, SACD_INIT_LAZY_TOC);
     if (result != SACD_OK) {
         sacd_destroy(sacd_ctx->sacd);
         sacd_ctx->sacd = NULL;
@@ -237,17 +251,8 @@ static int sacd_source_open(void *ctx, const char *path)
     sacd_ctx->format.bits_per_sample = 1;  /* DSD is 1-bit */
     sacd_ctx->format.frame_rate = SACD_FRAMES_PER_SEC;
 
-    /* Allocate frame buffer */
-    sacd_ctx->frame_buffer = sa_malloc(SACD_SOURCE_FRAME_BUFFER_SIZE);
-    if (!sacd_ctx->frame_buffer) {
-        sacd_close(sacd_ctx->sacd);
-        sacd_destroy(sacd_ctx->sacd);
-        sacd_ctx->sacd = NULL;
-        sa_free(sacd_ctx->path);
-        sacd_ctx->path = NULL;
-        return DSDPIPE_ERROR_OUT_OF_MEMORY;
-    }
-
+    sacd_ctx->batch_count = 0;
+    sacd_ctx->batch_pos = 0;
     sacd_ctx->is_open = true;
     sacd_ctx->current_track = 0;
     sacd_ctx->current_frame = 0;
@@ -263,10 +268,7 @@ static void sacd_source_close(void *ctx)
         return;
     }
 
-    if (sacd_ctx->frame_buffer) {
-        sa_free(sacd_ctx->frame_buffer);
-        sacd_ctx->frame_buffer = NULL;
-    }
+    drop_batch(sacd_ctx);
 
     if (sacd_ctx->sacd) {
         sacd_close(sacd_ctx->sacd);
@@ -344,18 +346,46 @@ static int sacd_source_seek_track(void *ctx, uint8_t track_number)
         return DSDPIPE_ERROR_READ;
     }
 
+    drop_batch(sacd_ctx);
     sacd_ctx->current_track = track_number;
     sacd_ctx->current_frame = 0;
 
     return DSDPIPE_OK;
 }
 
+static int sacd_source_seek_frame(void *ctx, uint64_t frame)
+{
+    dsdpipe_source_sacd_ctx_t *sacd_ctx = (dsdpipe_source_sacd_ctx_t *)ctx;
+
+    if (!sacd_ctx) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (!sacd_ctx->is_open) {
+        return DSDPIPE_ERROR_NOT_CONFIGURED;
+    }
+
+    if (sacd_ctx->current_track == 0) {
+        return DSDPIPE_ERROR_TRACK_NOT_FOUND;
+    }
+
+    /* Frames are addressed absolutely; libsacd maps them to sectors
+     * through the access list, so repositioning is free */
+    if (frame > sacd_ctx->track_frame_length) {
+        frame = sacd_ctx->track_frame_length;
+    }
+    if (frame != sacd_ctx->current_frame) {
+        drop_batch(sacd_ctx);
+    }
+    sacd_ctx->current_frame = (uint32_t)frame;
+
+    return DSDPIPE_OK;
+}
+
 static int sacd_source_read_frame(void *ctx, dsdpipe_buffer_t *buffer)
 {
     dsdpipe_source_sacd_ctx_t *sacd_ctx = (dsdpipe_source_sacd_ctx_t *)ctx;
-    int result;
-    uint32_t frames_to_read = 1;
-    uint16_t frame_size = 0;
+    sacd_frame_ref_t *frame;
     uint32_t absolute_frame;
 
     if (!sacd_ctx || !buffer) {
@@ -380,30 +410,37 @@ static int sacd_source_read_frame(void *ctx, dsdpipe_buffer_t *buffer)
     /* Calculate absolute frame number */
     absolute_frame = sacd_ctx->track_index_start + sacd_ctx->current_frame;
 
-    /* Read one frame of audio data */
-    result = sacd_get_sound_data(sacd_ctx->sacd,
-                                        sacd_ctx->frame_buffer,
-                                        absolute_frame,
-                                        &frames_to_read,
-                                        &frame_size);
+    /* Read the next run of frames once the previous one is used up */
+    if (sacd_ctx->batch_pos == sacd_ctx->batch_count) {
+        uint32_t count = sacd_ctx->track_frame_length - sacd_ctx->current_frame;
 
-    if (result != SACD_OK || frames_to_read == 0) {
-        return DSDPIPE_ERROR_READ;
+        if (count > SACD_SOURCE_BATCH_FRAMES) {
+            count = SACD_SOURCE_BATCH_FRAMES;
+        }
+        drop_batch(sacd_ctx);
+        if (sacd_get_sound_frames(sacd_ctx->sacd, absolute_frame, &count,
+                                  sacd_ctx->batch) != SACD_OK || count == 0) {
+            return DSDPIPE_ERROR_READ;
+        }
+        sacd_ctx->batch_count = count;
     }
 
-    /* Ensure frame fits in output buffer */
-    if (frame_size > buffer->capacity) {
+    frame = &sacd_ctx->batch[sacd_ctx->batch_pos];
+    if (frame->frame_nr != absolute_frame) {
+        drop_batch(sacd_ctx);
         return DSDPIPE_ERROR_INTERNAL;
     }
+    sacd_ctx->batch_pos++;
 
-    /* Copy frame data to output buffer */
-#ifdef _MSC_VER
-    memcpy_s(buffer->data, buffer->capacity, sacd_ctx->frame_buffer, frame_size);
-#else
-    memcpy(buffer->data, sacd_ctx->frame_buffer, frame_size);
-#endif
+    /* Hand the frame over without copying: the buffer now references the
+     * sectors libsacd read. Consumers treat source data as read-only. */
+    sa_buffer_unref(&buffer->ref);
+    buffer->ref = frame->buf;
+    buffer->data = (uint8_t *)frame->data;
+    buffer->capacity = frame->size;
+    frame->buf = NULL;
 
-    buffer->size = frame_size;
+    buffer->size = frame->size;
     buffer->format = sacd_ctx->format;
     buffer->track_number = sacd_ctx->current_track;
     buffer->frame_number = sacd_ctx->current_frame;
@@ -680,6 +717,7 @@ static const dsdpipe_source_ops_t s_sacd_source_ops = {
     .get_track_count = sacd_source_get_track_count,
     .get_format = sacd_source_get_format,
     .seek_track = sacd_source_seek_track,
+    .seek_frame = sacd_source_seek_frame,
     .read_frame = sacd_source_read_frame,
     .get_album_metadata = sacd_source_get_album_metadata,
     .get_track_metadata = sacd_source_get_track_metadata,
@@ -0,0 +1,716 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Stream source implementation for libdsdpipe
+ * Reads DSD audio from a file descriptor such as stdin or a pipe. The
+ * stream is read strictly front to back: a DSF stream is parsed chunk by
+ * chunk and its block-interleaved, LSB-first data is converted to the
+ * pipeline's byte-interleaved, MSB-first layout one block group at a time;
+ * anything else is passed through as raw byte-interleaved DSD. The whole
+ * stream is a single track.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "dsdpipe_internal.h"
+
+#include <libsautil/compat.h>
+#include <libsautil/mem.h>
+#include <libsautil/reverse.h>
+
+#include <stdio.h>
+#include <string.h>
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+/** Frame rate for SACD-compatible output (frames per second) */
+#define STREAM_SOURCE_FRAME_RATE    75
+
+/** stdio buffer size for the input stream */
+#define STREAM_SOURCE_BUFFER_SIZE   (256 * 1024)
+
+/** Largest DSF block size per channel accepted from a stream header */
+#define STREAM_SOURCE_MAX_BLOCK     (64 * 1024)
+
+/** Size of the DSF "DSD " chunk */
+#define DSF_DSD_CHUNK_SIZE          28
+
+/** Size of the DSF "fmt " chunk */
+#define DSF_FMT_CHUNK_SIZE          52
+
+/** Size of a DSF chunk header (ID + 64-bit size) */
+#define DSF_CHUNK_HEADER_SIZE       12
+
+/*============================================================================
+ * Stream Source Context
+ *============================================================================*/
+
+typedef struct dsdpipe_source_stream_ctx_s {
+    /* Input */
+    int fd;                         /**< File descriptor (not owned) */
+    FILE *fp;                       /**< Buffered stream on a duplicate of fd */
+    uint8_t magic[4];               /**< First bytes, read to detect DSF */
+    size_t magic_len;               /**< Valid bytes in magic */
+    size_t magic_pos;               /**< Bytes of magic already consumed */
+
+    /* Format */
+    bool has_raw_format;            /**< Raw DSD input is allowed */
+    dsdpipe_format_t format;        /**< Audio format */
+    uint64_t bytes_per_frame;       /**< Bytes per DSD frame */
+    uint64_t total_frames;          /**< Total frames (0 = unknown) */
+
+    /* DSF parsing */
+    bool is_dsf;                    /**< Stream carries a DSF file */
+    bool lsb_first;                 /**< DSF samples are LSB first */
+    uint32_t block_size;            /**< DSF block size per channel */
+    uint64_t data_remaining;        /**< Unread bytes of the DSF data chunk */
+    uint64_t output_remaining;      /**< Audio bytes still to deliver */
+    uint8_t *block_in;              /**< One block group as stored */
+    uint8_t *block_out;             /**< Same group, byte-interleaved */
+    size_t block_len;               /**< Valid bytes in block_out */
+    size_t block_pos;               /**< Delivered bytes of block_out */
+
+    /* Playback state */
+    uint8_t current_track;          /**< Current track (always 1) */
+    uint64_t current_frame;         /**< Current frame number */
+    bool started;                   /**< Reading has begun (no rewind) */
+    bool at_eof;                    /**< Input exhausted */
+
+    bool is_open;                   /**< Whether source is open */
+} dsdpipe_source_stream_ctx_t;
+
+/*============================================================================
+ * Helper Functions
+ *============================================================================*/
+
+static uint64_t calc_bytes_per_frame(uint32_t sample_rate, uint32_t channel_count)
+{
+    uint64_t samples_per_frame = sample_rate / STREAM_SOURCE_FRAME_RATE;
+    uint64_t bytes_per_channel = samples_per_frame / 8;
+    return bytes_per_channel * channel_count;
+}
+
+static uint32_t read_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t read_le64(const uint8_t *p)
+{
+    return (uint64_t)read_le32(p) | ((uint64_t)read_le32(p + 4) << 32);
+}
+
+/**
+ * @brief Read up to @p size bytes, serving the detection bytes first
+ * @return Number of bytes read (less than size only at end of stream)
+ */
+static size_t stream_read(dsdpipe_source_stream_ctx_t *ctx, uint8_t *data,
+                          size_t size)
+{
+    size_t done = 0;
+
+    while (done < size && ctx->magic_pos < ctx->magic_len) {
+        data[done++] = ctx->magic[ctx->magic_pos++];
+    }
+
+    while (done < size) {
+        size_t n = fread(data + done, 1, size - done, ctx->fp);
+        if (n == 0) {
+            break;
+        }
+        done += n;
+    }
+
+    return done;
+}
+
+/**
+ * @brief Consume @p size bytes without keeping them
+ */
+static int stream_skip(dsdpipe_source_stream_ctx_t *ctx, uint64_t size)
+{
+    uint8_t discard[4096];
+
+    while (size > 0) {
+        size_t chunk = (size < sizeof(discard)) ? (size_t)size : sizeof(discard);
+        if (stream_read(ctx, discard, chunk) != chunk) {
+            return DSDPIPE_ERROR_READ;
+        }
+        size -= chunk;
+    }
+
+    return DSDPIPE_OK;
+}
+
+/**
+ * @brief Parse DSF headers up to the start of the audio data
+ *
+ * The "DSD " magic has already been read. Chunks other than "fmt " and
+ * "data" are skipped; the metadata chunk at the end of the file is never
+ * reached.
+ */
+static int stream_parse_dsf(dsdpipe_source_stream_ctx_t *ctx)
+{
+    uint8_t hdr[DSF_FMT_CHUNK_SIZE];
+    bool have_fmt = false;
+
+    /* Rest of the "DSD " chunk: size, file size, metadata pointer */
+    if (stream_read(ctx, hdr, DSF_DSD_CHUNK_SIZE - 4) != DSF_DSD_CHUNK_SIZE - 4) {
+        return DSDPIPE_ERROR_SOURCE_OPEN;
+    }
+    uint64_t dsd_size = read_le64(hdr);
+    if (dsd_size < DSF_DSD_CHUNK_SIZE) {
+        return DSDPIPE_ERROR_SOURCE_OPEN;
+    }
+    if (stream_skip(ctx, dsd_size - DSF_DSD_CHUNK_SIZE) != DSDPIPE_OK) {
+        return DSDPIPE_ERROR_SOURCE_OPEN;
+    }
+
+    for (;;) {
+        if (stream_read(ctx, hdr, DSF_CHUNK_HEADER_SIZE) != DSF_CHUNK_HEADER_SIZE) {
+            return DSDPIPE_ERROR_SOURCE_OPEN;
+        }
+        uint64_t chunk_size = read_le64(hdr + 4);
+        if (chunk_size < DSF_CHUNK_HEADER_SIZE) {
+            return DSDPIPE_ERROR_SOURCE_OPEN;
+        }
+
+        if (memcmp(hdr, "data", 4) == 0) {
+            if (!have_fmt) {
+                return DSDPIPE_ERROR_SOURCE_OPEN;
+            }
+            ctx->data_remaining = chunk_size - DSF_CHUNK_HEADER_SIZE;
+            return DSDPIPE_OK;
+        }
+
+        if (memcmp(hdr, "fmt ", 4) != 0) {
+            if (stream_skip(ctx, chunk_size - DSF_CHUNK_HEADER_SIZE) != DSDPIPE_OK) {
+                return DSDPIPE_ERROR_SOURCE_OPEN;
+            }
+            continue;
+        }
+
+        if (chunk_size < DSF_FMT_CHUNK_SIZE) {
+            return DSDPIPE_ERROR_SOURCE_OPEN;
+        }
+        size_t body = DSF_FMT_CHUNK_SIZE - DSF_CHUNK_HEADER_SIZE;
+        if (stream_read(ctx, hdr, body) != body ||
+            stream_skip(ctx, chunk_size - DSF_FMT_CHUNK_SIZE) != DSDPIPE_OK) {
+            return DSDPIPE_ERROR_SOURCE_OPEN;
+        }
+
+        uint32_t format_id = read_le32(hdr + 4);
+        uint32_t channel_num = read_le32(hdr + 12);
+        uint32_t sampling_freq = read_le32(hdr + 16);
+        uint32_t bits_per_sample = read_le32(hdr + 20);
+        uint64_t sample_count = read_le64(hdr + 24);
+        uint32_t block_size = read_le32(hdr + 32);
+
+        /* Only DSD raw is defined */
+        if (format_id != 0) {
+            return DSDPIPE_ERROR_UNSUPPORTED;
+        }
+        if (channel_num == 0 || channel_num > DSDPIPE_MAX_CHANNELS ||
+            sampling_freq == 0 ||
+            (bits_per_sample != 1 && bits_per_sample != 8) ||
+            block_size == 0 || block_size > STREAM_SOURCE_MAX_BLOCK) {
+            return DSDPIPE_ERROR_UNSUPPORTED;
+        }
+
+        ctx->format.type = DSDPIPE_FORMAT_DSD_RAW;
+        ctx->format.sample_rate = sampling_freq;
+        ctx->format.channel_count = (uint16_t)channel_num;
+        ctx->format.bits_per_sample = 1;
+        ctx->format.frame_rate = STREAM_SOURCE_FRAME_RATE;
+        ctx->lsb_first = (bits_per_sample == 1);
+        ctx->block_size = block_size;
+        ctx->output_remaining = ((sample_count + 7) / 8) * channel_num;
+        have_fmt = true;
+    }
+}
+
+/**
+ * @brief Read the next DSF block group and convert it to byte-interleaved
+ * @return DSDPIPE_OK, 1 at end of data, or an error code
+ */
+static int stream_fill_block(dsdpipe_source_stream_ctx_t *ctx)
+{
+    uint32_t channels = ctx->format.channel_count;
+    size_t group_size = (size_t)ctx->block_size * channels;
+
+    ctx->block_pos = 0;
+    ctx->block_len = 0;
+
+    if (ctx->output_remaining == 0 || ctx->data_remaining < group_size) {
+        return 1;
+    }
+
+    if (stream_read(ctx, ctx->block_in, group_size) != group_size) {
+        /* Truncated stream: stop at the last complete group */
+        return 1;
+    }
+    ctx->data_remaining -= group_size;
+
+    const uint8_t *map = ctx->lsb_first ? ff_reverse : NULL;
+    for (uint32_t ch = 0; ch < channels; ch++) {
+        const uint8_t *in = ctx->block_in + (size_t)ch * ctx->block_size;
+        uint8_t *out = ctx->block_out + ch;
+        for (uint32_t i = 0; i < ctx->block_size; i++) {
+            out[(size_t)i * channels] = map ? map[in[i]] : in[i];
+        }
+    }
+
+    /* The last group is padded; drop the padding */
+    ctx->block_len = group_size;
+    if (ctx->block_len > ctx->output_remaining) {
+        ctx->block_len = (size_t)ctx->output_remaining;
+    }
+    ctx->output_remaining -= ctx->block_len;
+
+    return DSDPIPE_OK;
+}
+
+/**
+ * @brief Fill @p size bytes of DSF audio
+ * @return Number of bytes delivered
+ */
+static size_t stream_read_dsf(dsdpipe_source_stream_ctx_t *ctx, uint8_t *data,
+                              size_t size, int *result)
+{
+    size_t done = 0;
+
+    *result = DSDPIPE_OK;
+    while (done < size) {
+        if (ctx->block_pos == ctx->block_len) {
+            *result = stream_fill_block(ctx);
+            if (*result != DSDPIPE_OK) {
+                break;
+            }
+        }
+
+        size_t n = ctx->block_len - ctx->block_pos;
+        if (n > size - done) {
+            n = size - done;
+        }
+        memcpy(data + done, ctx->block_out + ctx->block_pos, n);
+        ctx->block_pos += n;
+        done += n;
+    }
+
+    return done;
+}
+
+/*============================================================================
+ * Source Operations
+ *============================================================================*/
+
+static void stream_source_close(void *ctx);
+
+static int stream_source_open(void *ctx, const char *path)
+{
+    dsdpipe_source_stream_ctx_t *stream_ctx = (dsdpipe_source_stream_ctx_t *)ctx;
+    int fd;
+    int result;
+
+    (void)path;
+
+    if (!stream_ctx || stream_ctx->fd < 0) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    /* Wrap a duplicate so fclose() leaves the caller's descriptor open */
+#ifdef _WIN32
+    _setmode(stream_ctx->fd, _O_BINARY);
+    fd = _dup(stream_ctx->fd);
+    stream_ctx->fp = (fd >= 0) ? _fdopen(fd, "rb") : NULL;
+#else
+    fd = dup(stream_ctx->fd);
+    stream_ctx->fp = (fd >= 0) ? fdopen(fd, "rb") : NULL;
+#endif
+    if (!stream_ctx->fp) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return DSDPIPE_ERROR_SOURCE_OPEN;
+    }
+    setvbuf(stream_ctx->fp, NULL, _IOFBF, STREAM_SOURCE_BUFFER_SIZE);
+
+    /* Detect DSF by its magic; the bytes are replayed for raw input */
+    stream_ctx->magic_len = fread(stream_ctx->magic, 1, sizeof(stream_ctx->magic),
+                                  stream_ctx->fp);
+    stream_ctx->magic_pos = 0;
+
+    if (stream_ctx->magic_len == sizeof(stream_ctx->magic) &&
+        memcmp(stream_ctx->magic, "DSD ", 4) == 0) {
+        stream_ctx->is_dsf = true;
+        stream_ctx->magic_pos = stream_ctx->magic_len;
+
+        result = stream_parse_dsf(stream_ctx);
+        if (result != DSDPIPE_OK) {
+            stream_source_close(ctx);
+            return result;
+        }
+
+        size_t group_size = (size_t)stream_ctx->block_size *
+                            stream_ctx->format.channel_count;
+        stream_ctx->block_in = (uint8_t *)sa_malloc(group_size);
+        stream_ctx->block_out = (uint8_t *)sa_malloc(group_size);
+        if (!stream_ctx->block_in || !stream_ctx->block_out) {
+            stream_source_close(ctx);
+            return DSDPIPE_ERROR_OUT_OF_MEMORY;
+        }
+    } else if (!stream_ctx->has_raw_format) {
+        stream_source_close(ctx);
+        return DSDPIPE_ERROR_UNSUPPORTED;
+    }
+
+    stream_ctx->bytes_per_frame = calc_bytes_per_frame(stream_ctx->format.sample_rate,
+                                                       stream_ctx->format.channel_count);
+    if (stream_ctx->bytes_per_frame == 0 ||
+        stream_ctx->bytes_per_frame > DSDPIPE_MAX_DSD_SIZE) {
+        stream_source_close(ctx);
+        return DSDPIPE_ERROR_UNSUPPORTED;
+    }
+
+    /* Only a DSF header tells the length in advance */
+    stream_ctx->total_frames = stream_ctx->is_dsf
+        ? stream_ctx->output_remaining / stream_ctx->bytes_per_frame : 0;
+
+    stream_ctx->current_track = 0;
+    stream_ctx->current_frame = 0;
+    stream_ctx->started = false;
+    stream_ctx->at_eof = false;
+    stream_ctx->is_open = true;
+
+    return DSDPIPE_OK;
+}
+
+static void stream_source_close(void *ctx)
+{
+    dsdpipe_source_stream_ctx_t *stream_ctx = (dsdpipe_source_stream_ctx_t *)ctx;
+
+    if (!stream_ctx) {
+        return;
+    }
+
+    if (stream_ctx->fp) {
+        fclose(stream_ctx->fp);
+        stream_ctx->fp = NULL;
+    }
+
+    sa_freep(&stream_ctx->block_in);
+    sa_freep(&stream_ctx->block_out);
+    stream_ctx->block_len = 0;
+    stream_ctx->block_pos = 0;
+
+    stream_ctx->is_open = false;
+}
+
+static int stream_source_get_track_count(void *ctx, uint8_t *count)
+{
+    dsdpipe_source_stream_ctx_t *stream_ctx = (dsdpipe_source_stream_ctx_t *)ctx;
+
+    if (!stream_ctx || !count) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (!stream_ctx->is_open) {
+        return DSDPIPE_ERROR_NOT_CONFIGURED;
+    }
+
+    *count = 1;
+    return DSDPIPE_OK;
+}
+
+static int stream_source_get_format(void *ctx, dsdpipe_format_t *format)
+{
+    dsdpipe_source_stream_ctx_t *stream_ctx = (dsdpipe_source_stream_ctx_t *)ctx;
+
+    if (!stream_ctx || !format) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (!stream_ctx->is_open) {
+        return DSDPIPE_ERROR_NOT_CONFIGURED;
+    }
+
+    *format = stream_ctx->format;
+    return DSDPIPE_OK;
+}
+
+static int stream_source_seek_track(void *ctx, uint8_t track_number)
+{
+    dsdpipe_source_stream_ctx_t *stream_ctx = (dsdpipe_source_stream_ctx_t *)ctx;
+
+    if (!stream_ctx) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (!stream_ctx->is_open) {
+        return DSDPIPE_ERROR_NOT_CONFIGURED;
+    }
+
+    if (track_number != 1) {
+        return DSDPIPE_ERROR_TRACK_NOT_FOUND;
+    }
+
+    /* A stream cannot be rewound once reading has begun */
+    if (stream_ctx->started) {
+        return DSDPIPE_ERROR_UNSUPPORTED;
+    }
+
+    stream_ctx->current_track = track_number;
+    stream_ctx->current_frame = 0;
+
+    return DSDPIPE_OK;
+}
+
+static int stream_source_seek_frame(void *ctx, uint64_t frame)
+{
+    (void)ctx;
+    (void)frame;
+
+    /* The reader skips forward by reading */
+    return DSDPIPE_ERROR_UNSUPPORTED;
+}
+
+static int stream_source_read_frame(void *ctx, dsdpipe_buffer_t *buffer)
+{
+    dsdpipe_source_stream_ctx_t *stream_ctx = (dsdpipe_source_stream_ctx_t *)ctx;
+    size_t bytes_to_read;
+    size_t bytes_read;
+    int result = DSDPIPE_OK;
+
+    if (!stream_ctx || !buffer) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (!stream_ctx->is_open) {
+        return DSDPIPE_ERROR_NOT_CONFIGURED;
+    }
+
+    if (stream_ctx->current_track == 0) {
+        return DSDPIPE_ERROR_TRACK_NOT_FOUND;
+    }
+
+    stream_ctx->started = true;
+
+    if (stream_ctx->at_eof) {
+        buffer->flags = DSDPIPE_BUF_FLAG_TRACK_END | DSDPIPE_BUF_FLAG_EOF;
+        buffer->size = 0;
+        return 1;  /* EOF indicator */
+    }
+
+    bytes_to_read = (size_t)stream_ctx->bytes_per_frame;
+    if (bytes_to_read > buffer->capacity) {
+        bytes_to_read = buffer->capacity;
+    }
+
+    if (stream_ctx->is_dsf) {
+        bytes_read = stream_read_dsf(stream_ctx, buffer->data, bytes_to_read,
+                                     &result);
+        if (result < 0) {
+            return result;
+        }
+    } else {
+        bytes_read = stream_read(stream_ctx, buffer->data, bytes_to_read);
+        if (bytes_read < bytes_to_read && ferror(stream_ctx->fp)) {
+            return DSDPIPE_ERROR_READ;
+        }
+        /* Drop a trailing partial sample group */
+        bytes_read -= bytes_read % stream_ctx->format.channel_count;
+    }
+
+    if (bytes_read < bytes_to_read) {
+        stream_ctx->at_eof = true;
+    }
+
+    if (bytes_read == 0) {
+        buffer->flags = DSDPIPE_BUF_FLAG_TRACK_END | DSDPIPE_BUF_FLAG_EOF;
+        buffer->size = 0;
+        return 1;  /* EOF indicator */
+    }
+
+    buffer->size = bytes_read;
+    buffer->format = stream_ctx->format;
+    buffer->track_number = stream_ctx->current_track;
+    buffer->frame_number = stream_ctx->current_frame;
+    buffer->sample_offset = stream_ctx->current_frame *
+                            (stream_ctx->format.sample_rate / STREAM_SOURCE_FRAME_RATE);
+    buffer->flags = 0;
+
+    if (stream_ctx->current_frame == 0) {
+        buffer->flags |= DSDPIPE_BUF_FLAG_TRACK_START;
+    }
+
+    stream_ctx->current_frame++;
+
+    /* A DSF stream knows where it ends; raw input ends on the next read */
+    if (stream_ctx->at_eof ||
+        (stream_ctx->is_dsf && stream_ctx->output_remaining == 0 &&
+         stream_ctx->block_pos == stream_ctx->block_len)) {
+        stream_ctx->at_eof = true;
+        buffer->flags |= DSDPIPE_BUF_FLAG_TRACK_END;
+    }
+
+    return DSDPIPE_OK;
+}
+
+static int stream_source_get_album_metadata(void *ctx, dsdpipe_metadata_t *metadata)
+{
+    dsdpipe_source_stream_ctx_t *stream_ctx = (dsdpipe_source_stream_ctx_t *)ctx;
+
+    if (!stream_ctx || !metadata) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (!stream_ctx->is_open) {
+        return DSDPIPE_ERROR_NOT_CONFIGURED;
+    }
+
+    /* DSF tags sit at the end of the file, past what a stream has read */
+    dsdpipe_metadata_init(metadata);
+    metadata->track_total = 1;
+    metadata->disc_number = 1;
+    metadata->disc_total = 1;
+
+    return DSDPIPE_OK;
+}
+
+static int stream_source_get_track_metadata(void *ctx, uint8_t track_number,
+                                            dsdpipe_metadata_t *metadata)
+{
+    dsdpipe_source_stream_ctx_t *stream_ctx = (dsdpipe_source_stream_ctx_t *)ctx;
+    int result;
+
+    if (!stream_ctx || !metadata) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (track_number != 1) {
+        return DSDPIPE_ERROR_TRACK_NOT_FOUND;
+    }
+
+    result = stream_source_get_album_metadata(ctx, metadata);
+    if (result != DSDPIPE_OK) {
+        return result;
+    }
+
+    metadata->track_number = 1;
+    if (stream_ctx->total_frames > 0) {
+        metadata->duration_frames = (uint32_t)stream_ctx->total_frames;
+        metadata->duration_seconds = (double)stream_ctx->total_frames /
+                                     STREAM_SOURCE_FRAME_RATE;
+    }
+
+    return DSDPIPE_OK;
+}
+
+static int stream_source_get_track_frames(void *ctx, uint8_t track_number,
+                                          uint64_t *frames)
+{
+    dsdpipe_source_stream_ctx_t *stream_ctx = (dsdpipe_source_stream_ctx_t *)ctx;
+
+    if (!stream_ctx || !frames) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (!stream_ctx->is_open) {
+        return DSDPIPE_ERROR_NOT_CONFIGURED;
+    }
+
+    if (track_number != 1) {
+        return DSDPIPE_ERROR_TRACK_NOT_FOUND;
+    }
+
+    *frames = stream_ctx->total_frames;
+    return DSDPIPE_OK;
+}
+
+static void stream_source_destroy(void *ctx)
+{
+    dsdpipe_source_stream_ctx_t *stream_ctx = (dsdpipe_source_stream_ctx_t *)ctx;
+
+    if (!stream_ctx) {
+        return;
+    }
+
+    stream_source_close(ctx);
+    sa_free(stream_ctx);
+}
+
+/*============================================================================
+ * Operations Table
+ *============================================================================*/
+
+static const dsdpipe_source_ops_t s_stream_source_ops = {
+    .open = stream_source_open,
+    .close = stream_source_close,
+    .get_track_count = stream_source_get_track_count,
+    .get_format = stream_source_get_format,
+    .seek_track = stream_source_seek_track,
+    .seek_frame = stream_source_seek_frame,
+    .read_frame = stream_source_read_frame,
+    .get_album_metadata = stream_source_get_album_metadata,
+    .get_track_metadata = stream_source_get_track_metadata,
+    .get_track_frames = stream_source_get_track_frames,
+    .destroy = stream_source_destroy
+};
+
+/*============================================================================
+ * Factory Function
+ *============================================================================*/
+
+int dsdpipe_source_stream_create(dsdpipe_source_t *source, int fd,
+                                 const dsdpipe_format_t *raw_format)
+{
+    dsdpipe_source_stream_ctx_t *ctx;
+
+    if (!source || fd < 0) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    if (raw_format && (raw_format->sample_rate == 0 ||
+                       raw_format->channel_count == 0 ||
+                       raw_format->channel_count > DSDPIPE_MAX_CHANNELS)) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    ctx = (dsdpipe_source_stream_ctx_t *)sa_calloc(1, sizeof(*ctx));
+    if (!ctx) {
+        return DSDPIPE_ERROR_OUT_OF_MEMORY;
+    }
+
+    ctx->fd = fd;
+    if (raw_format) {
+        ctx->has_raw_format = true;
+        ctx->format.type = DSDPIPE_FORMAT_DSD_RAW;
+        ctx->format.sample_rate = raw_format->sample_rate;
+        ctx->format.channel_count = raw_format->channel_count;
+        ctx->format.bits_per_sample = 1;
+        ctx->format.frame_rate = STREAM_SOURCE_FRAME_RATE;
+    }
+
+    source->type = DSDPIPE_SOURCE_STREAM;
+    source->ops = &s_stream_source_ops;
+    source->ctx = ctx;
+    source->is_open = false;
+
+    return DSDPIPE_OK;
+}
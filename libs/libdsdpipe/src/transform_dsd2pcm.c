@@ -561,3 +561,30 @@ int dsdpipe_transform_dsd2pcm_create(dsdpipe_transform_t **transform,
     *transform = new_transform;
     return DSDPIPE_OK;
 }
+
+/*============================================================================
+ * Queries
+ *============================================================================*/
+
+int dsdpipe_transform_dsd2pcm_get_delay(dsdpipe_transform_t *transform,
+                                        double *delay)
+{
+    if (!transform || !transform->ctx || !delay) {
+        return DSDPIPE_ERROR_INVALID_ARG;
+    }
+
+    dsdpipe_transform_dsd2pcm_ctx_t *dsd2pcm_ctx =
+        (dsdpipe_transform_dsd2pcm_ctx_t *)transform->ctx;
+
+    *delay = 0.0;
+    if (!dsd2pcm_ctx->decoder || !dsd2pcm_ctx->is_initialized) {
+        return DSDPIPE_ERROR_NOT_CONFIGURED;
+    }
+
+    if (dsdpcm_get_delay(dsd2pcm_ctx->decoder, delay) != DSDPCM_OK) {
+        *delay = 0.0;
+        return DSDPIPE_ERROR_INTERNAL;
+    }
+
+    return DSDPIPE_OK;
+}
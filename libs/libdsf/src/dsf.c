@@ -21,7 +21,7 @@
 #include "dsf_chunks.h"
 #include "dsf_io.h"
 
-#include <libsautil/reverse.h>
+#include <libsautil/dsdinterleave.h>
 #include <libsautil/mem.h>
 
 #include <stdlib.h>
@@ -683,16 +683,13 @@ static void dsf_convert_block_to_byte_interleaved(const uint8_t *dsf_data,
      *
      * Also bit-reverse each byte (DSF=LSB-first, DSDIFF=MSB-first)
      */
-    for (size_t byte_in_block = 0; byte_in_block < DSF_BLOCK_SIZE_PER_CHANNEL; byte_in_block++) {
-        for (uint32_t ch = 0; ch < channel_count; ch++) {
-            /* Source: block-interleaved position */
-            size_t src_offset = ch * DSF_BLOCK_SIZE_PER_CHANNEL + byte_in_block;
-            /* Destination: byte-interleaved position */
-            size_t dst_offset = byte_in_block * channel_count + ch;
+    const uint8_t *planes[DSF_MAX_CHANNELS];
 
-            dsdiff_data[dst_offset] = ff_reverse[dsf_data[src_offset]];
-        }
+    for (uint32_t ch = 0; ch < channel_count; ch++) {
+        planes[ch] = dsf_data + ch * DSF_BLOCK_SIZE_PER_CHANNEL;
     }
+    sa_dsd_interleave_bitrev(dsdiff_data, planes, DSF_BLOCK_SIZE_PER_CHANNEL,
+                             (int)channel_count);
 }
 
 /**
@@ -785,6 +782,22 @@ int dsf_read_audio_data(dsf_t *handle,
     return DSF_SUCCESS;
 }
 
+/**
+ * @brief Write the first total_bytes of the scratch buffer as audio data
+ */
+static int dsf_write_scratch_buffer(dsf_t *handle, size_t total_bytes) {
+    size_t written;
+    int ret;
+
+    ret = dsf_chunk_write_audio_data(handle->io, handle->scratch_buffer,
+                                      total_bytes, &written);
+    if (ret == DSF_SUCCESS) {
+        handle->bytes_written += written;
+    }
+
+    return ret;
+}
+
 /**
  * @brief Write one complete block group to file
  *
@@ -798,10 +811,8 @@ int dsf_read_audio_data(dsf_t *handle,
  */
 static int dsf_write_block_group(dsf_t *handle, size_t bytes_to_write, int pad_to_block) {
     uint32_t ch;
-    size_t written;
     size_t block_bytes = pad_to_block ? DSF_BLOCK_SIZE_PER_CHANNEL : bytes_to_write;
     size_t total_bytes = block_bytes * handle->info.channel_count;
-    int ret;
 
     /* Assemble block group: [Ch0][Ch1]...[ChN], each block_bytes */
     for (ch = 0; ch < handle->info.channel_count; ch++) {
@@ -814,13 +825,7 @@ static int dsf_write_block_group(dsf_t *handle, size_t bytes_to_write, int pad_t
         }
     }
 
-    ret = dsf_chunk_write_audio_data(handle->io, handle->scratch_buffer,
-                                      total_bytes, &written);
-    if (ret == DSF_SUCCESS) {
-        handle->bytes_written += written;
-    }
-
-    return ret;
+    return dsf_write_scratch_buffer(handle, total_bytes);
 }
 
 int dsf_write_audio_data(dsf_t *handle,
@@ -828,6 +833,8 @@ int dsf_write_audio_data(dsf_t *handle,
                          size_t num_bytes,
                          size_t *bytes_written) {
     uint32_t ch;
+    uint32_t channel_count;
+    uint8_t *planes[DSF_MAX_CHANNELS];
     size_t input_pos = 0;
     size_t bytes_per_channel;
     size_t total_written = 0;
@@ -849,7 +856,8 @@ int dsf_write_audio_data(dsf_t *handle,
         return DSF_ERROR_INVALID_PARAMETER;
     }
 
-    bytes_per_channel = num_bytes / handle->info.channel_count;
+    channel_count = handle->info.channel_count;
+    bytes_per_channel = num_bytes / channel_count;
 
     /* Process input data: de-interleave into channel buffers, bit-reverse,
      * and write complete blocks as they fill up.
@@ -858,22 +866,38 @@ int dsf_write_audio_data(dsf_t *handle,
      * We accumulate into per-channel buffers with bit reversal.
      * When buffers reach 4096 bytes, write a complete block group.
      */
-    for (size_t i = 0; i < bytes_per_channel; i++) {
-        /* De-interleave and bit-reverse each sample into channel buffers */
-        for (ch = 0; ch < handle->info.channel_count; ch++) {
-            handle->channel_buffers[ch][handle->bytes_buffered] =
-                ff_reverse[buffer[input_pos++]];
+    while (input_pos < num_bytes) {
+        size_t remaining = (num_bytes - input_pos) / channel_count;
+        size_t chunk = DSF_BLOCK_SIZE_PER_CHANNEL - handle->bytes_buffered;
+        int direct;
+
+        if (chunk > remaining) {
+            chunk = remaining;
         }
-        handle->bytes_buffered++;
+
+        /* Whole block groups go straight into the scratch buffer */
+        direct = (handle->bytes_buffered == 0 && chunk == DSF_BLOCK_SIZE_PER_CHANNEL);
+        for (ch = 0; ch < channel_count; ch++) {
+            planes[ch] = direct
+                ? &handle->scratch_buffer[ch * DSF_BLOCK_SIZE_PER_CHANNEL]
+                : &handle->channel_buffers[ch][handle->bytes_buffered];
+        }
+        sa_dsd_deinterleave_bitrev(planes, buffer + input_pos, chunk, (int)channel_count);
+        input_pos += chunk * channel_count;
+        handle->bytes_buffered += chunk;
 
         /* When we have a complete block (4096 bytes per channel), write it */
         if (handle->bytes_buffered == DSF_BLOCK_SIZE_PER_CHANNEL) {
-            ret = dsf_write_block_group(handle, DSF_BLOCK_SIZE_PER_CHANNEL, 0);
+            if (direct) {
+                ret = dsf_write_scratch_buffer(handle, DSF_BLOCK_SIZE_PER_CHANNEL * channel_count);
+            } else {
+                ret = dsf_write_block_group(handle, DSF_BLOCK_SIZE_PER_CHANNEL, 0);
+            }
             if (ret != DSF_SUCCESS) {
                 *bytes_written = total_written;
                 return ret;
             }
-            total_written += DSF_BLOCK_SIZE_PER_CHANNEL * handle->info.channel_count;
+            total_written += DSF_BLOCK_SIZE_PER_CHANNEL * channel_count;
             handle->bytes_buffered = 0;
         }
     }
@@ -1050,6 +1074,84 @@ int dsf_get_audio_position(dsf_t *handle, uint64_t *position) {
     return DSF_SUCCESS;
 }
 
+/* =============================================================================
+ * Format Conversion
+ * ===========================================================================*/
+
+int dsf_convert_dsd_to_block_interleaved(const uint8_t *dsdiff_data,
+                                         uint8_t *dsf_data,
+                                         size_t dsdiff_size,
+                                         uint32_t channel_count,
+                                         size_t *dsf_size) {
+    uint8_t *planes[DSF_MAX_CHANNELS];
+    size_t bytes_per_channel;
+    size_t group_size;
+    size_t out_pos = 0;
+
+    if (!dsdiff_data || !dsf_data || !dsf_size) {
+        return DSF_ERROR_INVALID_PARAMETER;
+    }
+    if (channel_count < 1 || channel_count > DSF_MAX_CHANNELS) {
+        return DSF_ERROR_INVALID_CHANNELS;
+    }
+    if (dsdiff_size % channel_count != 0) {
+        return DSF_ERROR_INVALID_PARAMETER;
+    }
+
+    bytes_per_channel = dsdiff_size / channel_count;
+    group_size = (size_t)DSF_BLOCK_SIZE_PER_CHANNEL * channel_count;
+
+    /* One block group per 4096 bytes per channel; the last one is
+     * zero-padded like dsf_flush_audio_data() does */
+    for (size_t done = 0; done < bytes_per_channel; done += DSF_BLOCK_SIZE_PER_CHANNEL) {
+        size_t chunk = bytes_per_channel - done;
+
+        if (chunk > DSF_BLOCK_SIZE_PER_CHANNEL) {
+            chunk = DSF_BLOCK_SIZE_PER_CHANNEL;
+        }
+        for (uint32_t ch = 0; ch < channel_count; ch++) {
+            planes[ch] = dsf_data + out_pos + ch * DSF_BLOCK_SIZE_PER_CHANNEL;
+            if (chunk < DSF_BLOCK_SIZE_PER_CHANNEL) {
+                memset(planes[ch] + chunk, 0, DSF_BLOCK_SIZE_PER_CHANNEL - chunk);
+            }
+        }
+        sa_dsd_deinterleave_bitrev(planes, dsdiff_data + done * channel_count,
+                                   chunk, (int)channel_count);
+        out_pos += group_size;
+    }
+
+    *dsf_size = out_pos;
+    return DSF_SUCCESS;
+}
+
+int dsf_convert_dsd_to_byte_interleaved(const uint8_t *dsf_data,
+                                        uint8_t *dsdiff_data,
+                                        size_t dsf_size,
+                                        uint32_t channel_count,
+                                        size_t *dsdiff_size) {
+    size_t group_size;
+
+    if (!dsf_data || !dsdiff_data || !dsdiff_size) {
+        return DSF_ERROR_INVALID_PARAMETER;
+    }
+    if (channel_count < 1 || channel_count > DSF_MAX_CHANNELS) {
+        return DSF_ERROR_INVALID_CHANNELS;
+    }
+
+    group_size = (size_t)DSF_BLOCK_SIZE_PER_CHANNEL * channel_count;
+    if (dsf_size % group_size != 0) {
+        return DSF_ERROR_INVALID_BLOCK_SIZE;
+    }
+
+    for (size_t pos = 0; pos < dsf_size; pos += group_size) {
+        dsf_convert_block_to_byte_interleaved(dsf_data + pos, dsdiff_data + pos,
+                                              channel_count);
+    }
+
+    *dsdiff_size = dsf_size;
+    return DSF_SUCCESS;
+}
+
 /* =============================================================================
  * Metadata Operations
  * ===========================================================================*/
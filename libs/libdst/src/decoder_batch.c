@@ -306,7 +306,7 @@ dst_batch_decoder_t *dst_batch_decoder_create_with_pool(int channel_count,
 
     /* Create persistent process queue */
     dec->queue_size = DST_QUEUE_SIZE;
-    dec->queue = sa_tpool_process_init(pool, dec->queue_size, 0);
+    dec->queue = sa_tpool_process_init(pool, dec->queue_size, 0, NULL);
     if (!dec->queue) {
         for (i = 0; i < pool_threads; i++) {
             dst_decoder_close(dec->decoders[i]);
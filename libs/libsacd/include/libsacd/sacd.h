@@ -40,6 +40,7 @@
 #define LIBSACD_SACD_H
 
 #include <libsautil/export.h>
+#include <libsautil/buffer.h>
 
 #include <stdint.h>
 #include <stdbool.h>
@@ -339,6 +340,38 @@ SACD_API void sacd_destroy(sacd_t* ctx);
 SACD_API int sacd_init(sacd_t* ctx, const char* filename,
                             unsigned int master_toc_nr, unsigned int area_toc_nr);
 
+/**
+ * @brief Initialization flag: defer decoding of Area TOC details.
+ *
+ * Only the Area TOC header, track list and index points are decoded by
+ * sacd_init_ex(). Area text, track text, ISRC and genre tables and the DST
+ * access list are decoded the first time any of them is queried, once per
+ * disc, shared by all clones. Suited to catalog scans that open many discs
+ * and look at few of these fields. The Master TOC is always read in full.
+ */
+#define SACD_INIT_LAZY_TOC 0x01
+
+/**
+ * @brief Initializes the SACD reader, with initialization flags.
+ *
+ * Behaves like sacd_init(); @p flags is a combination of SACD_INIT_* values.
+ * sacd_init() is sacd_init_ex() with no flags.
+ *
+ * @param[in,out] ctx            Pointer to the sacd_t context (must be created first)
+ * @param[in]     filename       Path to the SACD disc image file
+ * @param[in]     master_toc_nr  Which Master TOC copy to use (1 or 2, typically use 1)
+ * @param[in]     area_toc_nr    Which Area TOC copy to use (1 or 2, typically use 1)
+ * @param[in]     flags          SACD_INIT_* flags, 0 for a full parse
+ *
+ * @return Same as sacd_init()
+ *
+ * @see sacd_init
+ * @see SACD_INIT_LAZY_TOC
+ */
+SACD_API int sacd_init_ex(sacd_t* ctx, const char* filename,
+                               unsigned int master_toc_nr, unsigned int area_toc_nr,
+                               unsigned int flags);
+
 /**
  * @brief Closes the SACD reader and releases all TOC resources.
  *
@@ -355,6 +388,32 @@ SACD_API int sacd_init(sacd_t* ctx, const char* filename,
  */
 SACD_API int sacd_close(sacd_t* ctx);
 
+/**
+ * @brief Creates a new reader on the same disc without re-reading its TOCs.
+ *
+ * The clone shares the parsed Master TOC and Area TOCs of @p ctx, which are
+ * immutable after sacd_init() and reference counted, so it can outlive
+ * @p ctx. It gets its own input handle, area selection, playback position
+ * and audio data readers, and starts in the same state as a freshly
+ * initialized reader. Release it with sacd_destroy().
+ *
+ * A reader that is not being closed may be cloned from several threads at
+ * once, also while it is used for reading.
+ *
+ * @param[in]  ctx Pointer to an initialized sacd_t context
+ * @param[out] out Receives the new context
+ *
+ * @return SACD_OK on success, or error code:
+ *         - SACD_INVALID_ARGUMENT: Invalid pointer
+ *         - SACD_UNINITIALIZED: @p ctx is not initialized
+ *         - SACD_NOT_AVAILABLE: The input cannot be shared (use sacd_init())
+ *         - SACD_IO_ERROR: Failed to duplicate the input handle
+ *         - SACD_MEMORY_ALLOCATION_ERROR: Memory allocation failed
+ *
+ * @see sacd_init
+ */
+SACD_API int sacd_clone(sacd_t* ctx, sacd_t** out);
+
 /* ========================================================================
  * Channel Selection
  * ======================================================================== */
@@ -1141,6 +1200,61 @@ SACD_API int sacd_get_sound_data(sacd_t* ctx, uint8_t* data,
                                  uint32_t frame_nr_start, uint32_t* frame_count,
                                  uint16_t* frame_size);
 
+/**
+ * @brief One audio frame returned by sacd_get_sound_frames().
+ *
+ * @p data points into a reference-counted buffer that @p buf keeps alive.
+ * Several frames usually share one buffer (the sectors they were read from),
+ * so the payload must be treated as read-only. The buffer also outlives the
+ * sacd_t context; release it with sacd_release_sound_frames() or hand @p buf
+ * over to another owner.
+ */
+typedef struct sacd_frame_ref_s {
+    const uint8_t *data;      /**< Frame payload (DST coded or plain DSD) */
+    uint32_t size;            /**< Payload size in bytes */
+    uint32_t frame_nr;        /**< Frame number within the area */
+    sa_buffer_ref_t *buf;     /**< Reference holding @p data */
+} sacd_frame_ref_t;
+
+/**
+ * @brief Retrieves main audio data for a run of frames without copying it.
+ *
+ * Reads the sectors holding the frames once and returns a descriptor per
+ * frame. A frame whose packets are contiguous within one sector is returned
+ * in place; only frames that cross a sector boundary are reassembled, into a
+ * buffer shared by the whole run. Fewer frames than requested may be
+ * returned, call again from the next frame to continue.
+ *
+ * @param[in]     ctx            Pointer to the sacd_t context
+ * @param[in]     frame_nr_start First frame number (FRAME_START_USE_CURRENT
+ *                               is not supported)
+ * @param[in,out] frame_count    Input: maximum number of frames, the size of
+ *                               @p frames. Output: number of frames returned
+ * @param[out]    frames         Receives one descriptor per frame
+ *
+ * @return SACD_OK on success, or error code:
+ *         - SACD_UNINITIALIZED: Reader not initialized
+ *         - SACD_INVALID_ARGUMENT: Invalid parameters or frame range
+ *         - (Other error codes from audio data reading)
+ *
+ * @note On error no references are held and *frame_count is 0.
+ */
+SACD_API int sacd_get_sound_frames(sacd_t *ctx, uint32_t frame_nr_start,
+                                   uint32_t *frame_count,
+                                   sacd_frame_ref_t *frames);
+
+/**
+ * @brief Releases frames returned by sacd_get_sound_frames().
+ *
+ * Drops the buffer reference of each descriptor and clears it. Descriptors
+ * whose reference was already taken over (set to NULL) are skipped.
+ *
+ * @param[in,out] frames Frame descriptors
+ * @param[in]     count  Number of descriptors
+ */
+SACD_API void sacd_release_sound_frames(sacd_frame_ref_t *frames,
+                                        uint32_t count);
+
 /**
  * @brief Retrieves supplementary audio data for one or more frames.
  *
@@ -1183,6 +1297,52 @@ SACD_API int sacd_get_supplementary_data(sacd_t* ctx, uint8_t* data,
 SACD_API int sacd_get_frame_sector_range(sacd_t* ctx, uint32_t frame_nr,
                                      uint32_t* start_sector_nr, int* num_sectors);
 
+/**
+ * @brief Indexes the start sector of every frame in the selected area.
+ *
+ * DST frames vary in size, so locating a frame normally means scanning
+ * sectors. The reader remembers every frame it has already parsed; this
+ * function completes that index with one sequential pass over the area so
+ * that every later seek costs a single read. Fixed DSD areas need no index.
+ *
+ * @param[in] ctx  Pointer to the sacd_t context
+ *
+ * @return SACD_OK on success, or error code:
+ *         - SACD_UNINITIALIZED: Reader not initialized
+ *         - SACD_NOT_AVAILABLE: No area selected
+ *         - SACD_IO_ERROR: Read failed or frames could not be located
+ */
+SACD_API int sacd_build_frame_index(sacd_t* ctx);
+
+/**
+ * @brief Loads the frame index of the selected DST area from a sidecar file.
+ *
+ * @param[in] ctx   Pointer to the sacd_t context
+ * @param[in] path  Sidecar file written by sacd_save_frame_index()
+ *
+ * @return SACD_OK on success, or error code:
+ *         - SACD_UNINITIALIZED: Reader not initialized
+ *         - SACD_NOT_AVAILABLE: No area selected, or the area is not DST coded
+ *         - SACD_INVALID_ARGUMENT: File belongs to a different area or disc
+ *         - SACD_IO_ERROR: File could not be read
+ */
+SACD_API int sacd_load_frame_index(sacd_t* ctx, const char* path);
+
+/**
+ * @brief Saves the frame index of the selected DST area to a sidecar file.
+ *
+ * The index is completed with sacd_build_frame_index() first if needed.
+ *
+ * @param[in] ctx   Pointer to the sacd_t context
+ * @param[in] path  Sidecar file to write
+ *
+ * @return SACD_OK on success, or error code:
+ *         - SACD_UNINITIALIZED: Reader not initialized
+ *         - SACD_NOT_AVAILABLE: No area selected, or the area is not DST coded
+ *         - SACD_IO_ERROR: Index could not be built or written
+ */
+SACD_API int sacd_save_frame_index(sacd_t* ctx, const char* path);
+
 /**
  * @brief Gets the total number of sectors on the disc.
  *
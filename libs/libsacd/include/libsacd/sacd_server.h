@@ -0,0 +1,142 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief SACD network server.
+ * Exports local SACD images (or a PS3 drive) over the ServerRequest /
+ * ServerResponse protocol spoken by sacd_input_network, so any reader that
+ * accepts a "host:port" path can read them remotely.
+ * The server is single threaded: one event loop multiplexes the listening
+ * sockets and all client connections. Each client may pipeline up to
+ * @c client_window requests; DISC_READ payloads of plain 2048-byte images
+ * are sent with sendfile() where the platform supports it, everything else
+ * goes out as one large buffered write per response.
+ * The protocol carries no path, so every export listens on its own port.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBSACD_SACD_SERVER_H
+#define LIBSACD_SACD_SERVER_H
+
+#include <libsautil/export.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Default TCP port, the one used by the PS3 ripping server */
+#define SACD_SERVER_DEFAULT_PORT          2002
+/** Default number of requests a client may have outstanding */
+#define SACD_SERVER_DEFAULT_CLIENT_WINDOW 16
+/** Default limit on simultaneously connected clients */
+#define SACD_SERVER_DEFAULT_MAX_CLIENTS   64
+
+/**
+ * @brief Opaque server handle.
+ */
+typedef struct sacd_server sacd_server_t;
+
+/**
+ * @brief Callback receiving one line of server log output.
+ */
+typedef void (*sacd_server_log_fn)(void *opaque, const char *message);
+
+/**
+ * @brief Server settings.
+ *
+ * Zero-initialised fields select the defaults.
+ */
+typedef struct sacd_server_config {
+    const char         *bind_address;     /**< IPv4 address to bind, NULL for all */
+    uint32_t            client_window;    /**< Requests queued per client (0 = default) */
+    uint32_t            max_clients;      /**< Connection limit (0 = default) */
+    bool                disable_sendfile; /**< Always use buffered writes */
+    sacd_server_log_fn  log;              /**< Optional log sink */
+    void               *log_opaque;       /**< Passed to @c log */
+} sacd_server_config_t;
+
+/**
+ * @brief Create a server with no exports.
+ *
+ * @param[in]  config  Server settings, or NULL for the defaults
+ * @param[out] out     Receives the server
+ *
+ * @return SACD_OK on success, or:
+ *         - SACD_INVALID_ARGUMENT: NULL @p out or unparsable bind address
+ *         - SACD_MEMORY_ALLOCATION_ERROR: Allocation failed
+ *         - SACD_IO_ERROR: The socket layer could not be initialised
+ */
+SACD_API int sacd_server_create(const sacd_server_config_t *config,
+                                sacd_server_t **out);
+
+/**
+ * @brief Open a source and listen for clients of it on @p port.
+ *
+ * @p source is anything sacd_input_open() accepts except a network
+ * address: an ISO image or a PS3 drive. Drives are authenticated and their
+ * DST areas decrypted before the sectors are sent.
+ *
+ * @param[in] server  Server handle
+ * @param[in] source  Image path or device
+ * @param[in] port    TCP port to listen on
+ *
+ * @return SACD_OK on success, or:
+ *         - SACD_INVALID_ARGUMENT: NULL argument or port 0
+ *         - SACD_IO_ERROR: The source could not be opened or the port bound
+ *         - SACD_MEMORY_ALLOCATION_ERROR: Allocation failed
+ */
+SACD_API int sacd_server_add_export(sacd_server_t *server,
+                                    const char *source, uint16_t port);
+
+/**
+ * @brief Run one iteration of the event loop.
+ *
+ * Waits up to @p timeout_ms (indefinitely if negative) for socket activity
+ * and services every ready connection. Callers that drive their own loop
+ * call this repeatedly.
+ *
+ * @return SACD_OK on success (including a timeout), SACD_IO_ERROR if
+ *         polling failed
+ */
+SACD_API int sacd_server_poll(sacd_server_t *server, int timeout_ms);
+
+/**
+ * @brief Serve until sacd_server_stop() is called.
+ *
+ * @return SACD_OK after a stop request, SACD_IO_ERROR if polling failed
+ */
+SACD_API int sacd_server_run(sacd_server_t *server);
+
+/**
+ * @brief Ask sacd_server_run() to return.
+ *
+ * Safe to call from another thread or a signal handler; the loop notices
+ * within its poll interval.
+ */
+SACD_API void sacd_server_stop(sacd_server_t *server);
+
+/**
+ * @brief Close all connections and exports and free the server.
+ */
+SACD_API void sacd_server_destroy(sacd_server_t *server);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSACD_SACD_SERVER_H */
@@ -7,16 +7,10 @@
 #endif
 
 
-/* The following messages exceed 64kB in size: ServerResponse */
-
-/* The PB_FIELD_32BIT compilation option must be defined to support messages that exceed 64 kB in size. */
-#ifndef PB_FIELD_32BIT
-#error Enable PB_FIELD_32BIT to support messages exceeding 64kB in size: ServerResponse
-#endif
 PB_BIND(ServerRequest, ServerRequest, AUTO)
 
 
-PB_BIND(ServerResponse, ServerResponse, 4)
+PB_BIND(ServerResponse, ServerResponse, AUTO)
 
 
 
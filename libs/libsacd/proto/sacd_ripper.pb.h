@@ -31,12 +31,10 @@ typedef struct _ServerRequest {
     uint32_t sector_count;
 } ServerRequest;
 
-typedef PB_BYTES_ARRAY_T(1024000) ServerResponse_data_t;
 typedef struct _ServerResponse {
     ServerResponse_Type type;
     int64_t result;
-    bool has_data;
-    ServerResponse_data_t data;
+    pb_callback_t data;
 } ServerResponse;
 
 
@@ -60,9 +58,9 @@ extern "C" {
 
 /* Initializer values for message structs */
 #define ServerRequest_init_default               {_ServerRequest_Type_MIN, 0u, 0u}
-#define ServerResponse_init_default              {_ServerResponse_Type_MIN, 0, false, {0, {0}}}
+#define ServerResponse_init_default              {_ServerResponse_Type_MIN, 0, {{NULL}, NULL}}
 #define ServerRequest_init_zero                  {_ServerRequest_Type_MIN, 0, 0}
-#define ServerResponse_init_zero                 {_ServerResponse_Type_MIN, 0, false, {0, {0}}}
+#define ServerResponse_init_zero                 {_ServerResponse_Type_MIN, 0, {{NULL}, NULL}}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define ServerRequest_type_tag                   1
@@ -83,8 +81,8 @@ X(a, STATIC,   REQUIRED, UINT32,   sector_count,      3)
 #define ServerResponse_FIELDLIST(X, a) \
 X(a, STATIC,   REQUIRED, UENUM,    type,              1) \
 X(a, STATIC,   REQUIRED, INT64,    result,            2) \
-X(a, STATIC,   OPTIONAL, BYTES,    data,              3)
-#define ServerResponse_CALLBACK NULL
+X(a, CALLBACK, OPTIONAL, BYTES,    data,              3)
+#define ServerResponse_CALLBACK pb_default_field_callback
 #define ServerResponse_DEFAULT (const pb_byte_t*)"\x08\x01\x00"
 
 extern const pb_msgdesc_t ServerRequest_msg;
@@ -95,9 +93,9 @@ extern const pb_msgdesc_t ServerResponse_msg;
 #define ServerResponse_fields &ServerResponse_msg
 
 /* Maximum encoded size of messages (where known) */
-#define SACD_RIPPER_PB_H_MAX_SIZE                ServerResponse_size
+/* ServerResponse_size depends on runtime parameters */
+#define SACD_RIPPER_PB_H_MAX_SIZE                ServerRequest_size
 #define ServerRequest_size                       14
-#define ServerResponse_size                      1024017
 
 #ifdef __cplusplus
 } /* extern "C" */
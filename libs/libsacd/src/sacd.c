@@ -35,10 +35,25 @@
 
 #include <libsautil/mem.h>
 
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/**
+ * @brief Parsed disc data shared by a reader and its clones.
+ *
+ * Owns the Master TOC and the Area TOCs parsed by sacd_init(). The data is
+ * not modified after parsing; each sacd_t reads it through its own Area TOC
+ * clones, which hold the per-reader playback state and audio data readers.
+ */
+typedef struct sacd_disc_s {
+    atomic_int refcount;        /**< Readers referencing this disc */
+    master_toc_t *master_toc;   /**< Parsed Master TOC */
+    area_toc_t *st_area_toc;    /**< Parsed 2-channel Area TOC, or NULL */
+    area_toc_t *mc_area_toc;    /**< Parsed multi-channel Area TOC, or NULL */
+} sacd_disc_t;
+
 /**
  * @struct sacd_t
  * @brief Main SACD reader context structure.
@@ -99,6 +114,12 @@ struct sacd_s {
      * SACD discs store two copies of each Area TOC for redundancy.
      */
     int area_toc_num;
+
+    /**
+     * @brief Shared parsed disc data, set once sacd_init() succeeds.
+     * master_toc then points into it and the Area TOCs above are clones.
+     */
+    sacd_disc_t *disc;
 };
 
 /**
@@ -123,6 +144,128 @@ area_toc_t *sacd_get_selected_area_toc(sacd_t *ctx)
     }
 }
 
+/**
+ * @brief Internal helper: Drops a reference to the shared disc data.
+ *
+ * The last reference frees the Master TOC and the parsed Area TOCs.
+ */
+static void sacd_disc_release(sacd_disc_t *disc)
+{
+    if (atomic_fetch_sub(&disc->refcount, 1) != 1)
+    {
+        return;
+    }
+
+    if (disc->master_toc)
+    {
+        sacd_master_toc_destroy(disc->master_toc);
+        sa_free(disc->master_toc);
+    }
+    if (disc->st_area_toc)
+    {
+        sacd_area_toc_destroy(disc->st_area_toc);
+        sa_free(disc->st_area_toc);
+    }
+    if (disc->mc_area_toc)
+    {
+        sacd_area_toc_destroy(disc->mc_area_toc);
+        sa_free(disc->mc_area_toc);
+    }
+    sa_free(disc);
+}
+
+/**
+ * @brief Internal helper: Creates a clone of a parsed Area TOC for ctx's input.
+ */
+static int sacd_clone_area_toc(sacd_t *ctx, const area_toc_t *src, area_toc_t **out)
+{
+    *out = NULL;
+    if (!src)
+    {
+        return SACD_OK;
+    }
+
+    area_toc_t *area = (area_toc_t *)sa_malloc(sizeof(area_toc_t));
+    if (!area)
+    {
+        return SACD_MEMORY_ALLOCATION_ERROR;
+    }
+
+    int res = sacd_area_toc_clone(area, src, ctx->input);
+    if (res != SACD_AREA_TOC_OK)
+    {
+        sa_free(area);
+        return (res == SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR)
+               ? SACD_MEMORY_ALLOCATION_ERROR : SACD_UNINITIALIZED;
+    }
+
+    *out = area;
+    return SACD_OK;
+}
+
+/**
+ * @brief Internal helper: Binds ctx to shared disc data.
+ *
+ * Takes a reference on the disc and creates ctx's Area TOC clones on its
+ * input. The area selection is reset to what sacd_init() leaves behind.
+ */
+static int sacd_attach_disc(sacd_t *ctx, sacd_disc_t *disc)
+{
+    int res;
+
+    atomic_fetch_add(&disc->refcount, 1);
+    ctx->disc = disc;
+    ctx->master_toc = disc->master_toc;
+
+    res = sacd_clone_area_toc(ctx, disc->st_area_toc, &ctx->st_area_toc);
+    if (res == SACD_OK)
+    {
+        res = sacd_clone_area_toc(ctx, disc->mc_area_toc, &ctx->mc_area_toc);
+    }
+    if (res != SACD_OK)
+    {
+        return res;
+    }
+
+    ctx->current_channel_type = disc->mc_area_toc ? MULTI_CHANNEL : TWO_CHANNEL;
+    ctx->initialized = true;
+    return SACD_OK;
+}
+
+/**
+ * @brief Internal helper: Moves the TOCs parsed by sacd_init() into a shared disc.
+ *
+ * The parsed Area TOCs give up their audio data readers and ctx continues
+ * on clones of them, exactly like a reader created with sacd_clone().
+ */
+static int sacd_share_disc(sacd_t *ctx)
+{
+    sacd_disc_t *disc = (sacd_disc_t *)sa_calloc(1, sizeof(sacd_disc_t));
+    if (!disc)
+    {
+        return SACD_MEMORY_ALLOCATION_ERROR;
+    }
+
+    atomic_init(&disc->refcount, 0);
+    disc->master_toc = ctx->master_toc;
+    disc->st_area_toc = ctx->st_area_toc;
+    disc->mc_area_toc = ctx->mc_area_toc;
+    ctx->master_toc = NULL;
+    ctx->st_area_toc = NULL;
+    ctx->mc_area_toc = NULL;
+
+    if (disc->st_area_toc)
+    {
+        sacd_area_toc_drop_frame_reader(disc->st_area_toc);
+    }
+    if (disc->mc_area_toc)
+    {
+        sacd_area_toc_drop_frame_reader(disc->mc_area_toc);
+    }
+
+    return sacd_attach_disc(ctx, disc);
+}
+
 /**
  * @brief Creates and initializes a new SACD reader context.
  *
@@ -149,6 +292,7 @@ sacd_t *sacd_create(void)
     ctx->sector_format = -1;
     ctx->current_channel_type = TWO_CHANNEL;  /* Default to 2-channel */
     ctx->area_toc_num = 1;                     /* Use primary TOC copy */
+    ctx->disc = NULL;
 
     return ctx;
 }
@@ -196,8 +340,28 @@ void sacd_destroy(sacd_t *ctx)
  */
 int sacd_init(sacd_t *ctx, const char *filename, unsigned int master_toc_nr,
                           unsigned int area_toc_nr)
+{
+    return sacd_init_ex(ctx, filename, master_toc_nr, area_toc_nr, 0);
+}
+
+/**
+ * @brief Initializes the SACD reader, with initialization flags.
+ *
+ * With SACD_INIT_LAZY_TOC the Area TOCs are read lazily, see
+ * sacd_area_toc_read().
+ *
+ * @param[in,out] ctx           Pointer to the sacd_t context
+ * @param[in]     filename      Path to the SACD disc image file
+ * @param[in]     master_toc_nr Which Master TOC copy to use (1 or 2)
+ * @param[in]     area_toc_nr   Which Area TOC copy to use (1 or 2)
+ * @param[in]     flags         SACD_INIT_* flags
+ * @return SACD_OK on success, error code otherwise
+ */
+int sacd_init_ex(sacd_t *ctx, const char *filename, unsigned int master_toc_nr,
+                 unsigned int area_toc_nr, unsigned int flags)
 {
     int res;
+    bool lazy = (flags & SACD_INIT_LAZY_TOC) != 0;
     uint32_t area1_start;   /* Start sector of primary Area TOC copy */
     uint32_t area2_start;   /* Start sector of backup Area TOC copy */
     uint16_t area_length;   /* Length of Area TOC in sectors */
@@ -208,6 +372,12 @@ int sacd_init(sacd_t *ctx, const char *filename, unsigned int master_toc_nr,
         return SACD_INVALID_ARGUMENT;
     }
 
+    /* Release the shared data of a previous initialization */
+    if (ctx->disc)
+    {
+        sacd_close(ctx);
+    }
+
     /* Store pointer to input for sector-level access */
     res = sacd_input_open(filename, &ctx->input);
     if (res != SACD_INPUT_OK) {
@@ -254,7 +424,7 @@ int sacd_init(sacd_t *ctx, const char *filename, unsigned int master_toc_nr,
         return SACD_MEMORY_ALLOCATION_ERROR;
     }
     sacd_area_toc_init(ctx->st_area_toc);
-    res = sacd_area_toc_read(ctx->st_area_toc, 1, 0, 0, 0, TWO_CHANNEL, ctx->input);
+    res = sacd_area_toc_read(ctx->st_area_toc, 1, 0, 0, 0, TWO_CHANNEL, ctx->input, false);
     if (res != SACD_OK)
     {
         /* Temporary Area TOC initialization failed - clean up and return error */
@@ -331,7 +501,7 @@ int sacd_init(sacd_t *ctx, const char *filename, unsigned int master_toc_nr,
         /* Read and parse the 2-channel Area TOC */
         res = sacd_area_toc_read(ctx->st_area_toc, area_toc_nr, area1_start,
                                   area2_start, area_length, TWO_CHANNEL,
-                                  ctx->input);
+                                  ctx->input, lazy);
         if (res != SACD_OK)
         {
             /* 2-channel Area TOC read failed - clean up and return error */
@@ -373,7 +543,7 @@ int sacd_init(sacd_t *ctx, const char *filename, unsigned int master_toc_nr,
         /* Read and parse the multi-channel Area TOC */
         res = sacd_area_toc_read(ctx->mc_area_toc, area_toc_nr, area1_start,
                                   area2_start, area_length, MULTI_CHANNEL,
-                                  ctx->input);
+                                  ctx->input, lazy);
         if (res != SACD_OK)
         {
             /* Multi-channel Area TOC read failed - clean up and return error */
@@ -392,12 +562,77 @@ int sacd_init(sacd_t *ctx, const char *filename, unsigned int master_toc_nr,
         }
     }
 
-    /* Mark reader as fully initialized and ready for use */
-    ctx->initialized = true;
+    /* Step 7: Hand the parsed TOCs to a shared disc so sacd_clone() can
+     * create further readers without parsing them again. */
+    res = sacd_share_disc(ctx);
+    if (res != SACD_OK)
+    {
+        sacd_close(ctx);
+        return res;
+    }
 
     return SACD_OK;
 }
 
+/**
+ * @brief Creates a new reader on the same disc without re-reading its TOCs.
+ *
+ * Only immutable state of @p ctx is read (its input handle and the shared
+ * disc), so concurrent clones of a reader that is in use are safe.
+ *
+ * @param[in]  ctx Pointer to an initialized sacd_t context
+ * @param[out] out Receives the new context
+ * @return SACD_OK on success, error code otherwise
+ */
+int sacd_clone(sacd_t *ctx, sacd_t **out)
+{
+    sacd_input_t *input = NULL;
+    sacd_t *clone;
+    int res;
+
+    if (!ctx || !out)
+    {
+        return SACD_INVALID_ARGUMENT;
+    }
+    *out = NULL;
+
+    if (!ctx->initialized || !ctx->disc)
+    {
+        return SACD_UNINITIALIZED;
+    }
+
+    res = sacd_input_dup(ctx->input, &input);
+    if (res == SACD_INPUT_ERR_NOT_SUPPORTED)
+    {
+        return SACD_NOT_AVAILABLE;
+    }
+    if (res != SACD_INPUT_OK)
+    {
+        return SACD_IO_ERROR;
+    }
+
+    clone = sacd_create();
+    if (!clone)
+    {
+        sacd_input_close(input);
+        return SACD_MEMORY_ALLOCATION_ERROR;
+    }
+
+    clone->input = input;
+    clone->sector_format = ctx->sector_format;
+    clone->area_toc_num = ctx->area_toc_num;
+
+    res = sacd_attach_disc(clone, ctx->disc);
+    if (res != SACD_OK)
+    {
+        sacd_destroy(clone);
+        return res;
+    }
+
+    *out = clone;
+    return SACD_OK;
+}
+
 /**
  * @brief Closes the SACD reader and releases all TOC resources.
  *
@@ -423,8 +658,8 @@ int sacd_close(sacd_t *ctx)
         ctx->input = NULL;
     }
 
-    /* Free Master TOC and its internal structures */
-    if (ctx->master_toc)
+    /* Free Master TOC and its internal structures, unless shared */
+    if (ctx->master_toc && !ctx->disc)
     {
         sacd_master_toc_destroy(ctx->master_toc);
         sa_free(ctx->master_toc);
@@ -444,6 +679,13 @@ int sacd_close(sacd_t *ctx)
         sa_free(ctx->mc_area_toc);
     }
 
+    /* Drop this reader's reference to the shared disc data */
+    if (ctx->disc)
+    {
+        sacd_disc_release(ctx->disc);
+        ctx->disc = NULL;
+    }
+
     /* Reset all pointers to NULL and mark as uninitialized */
     ctx->master_toc = NULL;
     ctx->st_area_toc = NULL;
@@ -1550,6 +1792,79 @@ int sacd_get_frame_sector_range(sacd_t *ctx, uint32_t frame_nr,
     return sacd_area_toc_get_frame_sector_range(area_toc, frame_nr, start_sector_nr, num_sectors);
 }
 
+/* Map Area TOC frame index status codes */
+static int sacd_from_frame_index_status(int status)
+{
+    switch (status) {
+        case SACD_AREA_TOC_OK:
+            return SACD_OK;
+        case SACD_AREA_TOC_UNINITIALIZED:
+            return SACD_UNINITIALIZED;
+        case SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR:
+            return SACD_MEMORY_ALLOCATION_ERROR;
+        case SACD_AREA_TOC_INVALID_ARGUMENT:
+            return SACD_INVALID_ARGUMENT;
+        case SACD_AREA_TOC_FRAME_FORMAT:
+            return SACD_NOT_AVAILABLE;
+        default:
+            return SACD_IO_ERROR;
+    }
+}
+
+/* Index the frames of the selected area */
+int sacd_build_frame_index(sacd_t *ctx)
+{
+    area_toc_t *area_toc;
+
+    if (!ctx)
+        return (SACD_INVALID_ARGUMENT);
+
+    if (!ctx->initialized)
+        return (SACD_UNINITIALIZED);
+
+    area_toc = sacd_get_selected_area_toc(ctx);
+    if (!area_toc)
+        return (SACD_NOT_AVAILABLE);
+
+    return sacd_from_frame_index_status(sacd_area_toc_build_frame_index(area_toc));
+}
+
+/* Load the frame index of the selected area from a sidecar */
+int sacd_load_frame_index(sacd_t *ctx, const char *path)
+{
+    area_toc_t *area_toc;
+
+    if (!ctx || !path)
+        return (SACD_INVALID_ARGUMENT);
+
+    if (!ctx->initialized)
+        return (SACD_UNINITIALIZED);
+
+    area_toc = sacd_get_selected_area_toc(ctx);
+    if (!area_toc)
+        return (SACD_NOT_AVAILABLE);
+
+    return sacd_from_frame_index_status(sacd_area_toc_load_frame_index(area_toc, path));
+}
+
+/* Save the frame index of the selected area to a sidecar */
+int sacd_save_frame_index(sacd_t *ctx, const char *path)
+{
+    area_toc_t *area_toc;
+
+    if (!ctx || !path)
+        return (SACD_INVALID_ARGUMENT);
+
+    if (!ctx->initialized)
+        return (SACD_UNINITIALIZED);
+
+    area_toc = sacd_get_selected_area_toc(ctx);
+    if (!area_toc)
+        return (SACD_NOT_AVAILABLE);
+
+    return sacd_from_frame_index_status(sacd_area_toc_save_frame_index(area_toc, path));
+}
+
 /* Get total sectors on disc */
 int sacd_get_total_sectors(sacd_t *ctx, uint32_t *total_sectors)
 {
@@ -1654,6 +1969,56 @@ int sacd_get_sound_data(sacd_t *ctx, uint8_t *data,
     return (res);
 }
 
+/* Get sound frames without copying */
+int sacd_get_sound_frames(sacd_t *ctx, uint32_t frame_nr_start,
+                          uint32_t *frame_count, sacd_frame_ref_t *frames)
+{
+    area_toc_t *area_toc;
+    uint32_t total;
+    int res;
+
+    if (!ctx || !frame_count || !frames)
+        return (SACD_INVALID_ARGUMENT);
+
+    if (!ctx->initialized)
+        return (SACD_UNINITIALIZED);
+
+    area_toc = sacd_get_selected_area_toc(ctx);
+    if (!area_toc)
+        return (SACD_NOT_AVAILABLE);
+
+    total = sacd_area_toc_get_total_play_time(area_toc);
+    if (*frame_count == 0 || frame_nr_start >= total)
+    {
+        *frame_count = 0;
+        return (SACD_INVALID_ARGUMENT);
+    }
+    if (*frame_count > total - frame_nr_start)
+    {
+        *frame_count = total - frame_nr_start;
+    }
+
+    res = sacd_area_toc_get_audio_frames(area_toc, frame_nr_start, frame_count, frames);
+    if (res != SACD_OK)
+    {
+        *frame_count = 0;
+    }
+    return (res);
+}
+
+void sacd_release_sound_frames(sacd_frame_ref_t *frames, uint32_t count)
+{
+    if (!frames)
+        return;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        sa_buffer_unref(&frames[i].buf);
+        frames[i].data = NULL;
+        frames[i].size = 0;
+    }
+}
+
 /* Get supplementary data */
 int sacd_get_supplementary_data(sacd_t *ctx, uint8_t *data,
                                           uint32_t frame_nr_start, uint32_t *frame_count,
@@ -40,13 +40,52 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdatomic.h>
 #include <libsautil/mem.h>
+#include <libsautil/c11threads.h>
 
 #include "sacd_area_toc.h"
 #include "sacd_dst_reader.h"
 #include "sacd_dsd_reader.h"
 #include "sacd_charset.h"
 
+/**
+ * @brief Deferred data of a lazily read Area TOC.
+ *
+ * Decoded at most once under @c lock, by the first reader that queries it.
+ * @c loaded is only set after @c area_info, @c frame_info and the
+ * owner's per-track ISRC, genre and text fields have been written, so a
+ * reader that sees it set may use all of them without locking.
+ */
+struct area_toc_details_s {
+    mtx_t lock;                        /**< Serializes decoding */
+    atomic_bool loaded;                /**< Set once decoding has been attempted */
+    area_toc_t *owner;                 /**< Area TOC that was read, owns track_info */
+    uint32_t toc_start_lsn;            /**< First sector of the TOC copy that was read */
+    uint16_t toc_area_length;          /**< Length of the TOC in sectors */
+    area_toc_info_t area_info;         /**< Decoded area text */
+    area_toc_frame_info_t frame_info;  /**< Decoded access list */
+};
+
+/**
+ * @brief Free the deferred data holder and everything decoded into it
+ *
+ * The per-track ISRC, genre and text fields live in the owner's track_info
+ * and are freed with it.
+ */
+static void area_toc_free_details(area_toc_details_t *details)
+{
+    for (int channel_idx = 0; channel_idx < MAX_TEXT_CHANNEL_COUNT; channel_idx++) {
+        for (int text_type_idx = 0; text_type_idx < MAX_AREA_TEXT_TYPE_COUNT; text_type_idx++) {
+            sa_free(details->area_info.text[channel_idx][text_type_idx]);
+        }
+    }
+    sa_free(details->frame_info.frame_start);
+    sa_free(details->frame_info.access_margin);
+    mtx_destroy(&details->lock);
+    sa_free(details);
+}
+
 void sacd_area_toc_init(area_toc_t *ctx)
 {
     int channel_idx, text_type_idx;
@@ -90,8 +129,12 @@ void sacd_area_toc_init(area_toc_t *ctx)
     ctx->frame_info.num_entries = 1;
     ctx->frame_info.frame_start = NULL;
     ctx->frame_info.access_margin = NULL;
+    ctx->details = NULL;
+    ctx->details_loaded = false;
+    ctx->dst_index = NULL;
 
     ctx->initialized = false;
+    ctx->shares_data = false;
 }
 
 void sacd_area_toc_destroy(area_toc_t *ctx)
@@ -115,6 +158,41 @@ void sacd_area_toc_close(area_toc_t *ctx)
     /* Mark as uninitialized */
     ctx->initialized = false;
 
+    /* A clone only owns its audio data reader */
+    if (ctx->shares_data)
+    {
+        sacd_area_toc_drop_frame_reader(ctx);
+        for (int channel_idx = 0; channel_idx < MAX_TEXT_CHANNEL_COUNT; channel_idx++)
+        {
+            for (int text_type_idx = 0; text_type_idx < MAX_AREA_TEXT_TYPE_COUNT; text_type_idx++)
+            {
+                ctx->area_info.text[channel_idx][text_type_idx] = NULL;
+            }
+        }
+        ctx->track_info = NULL;
+        ctx->frame_info.frame_start = NULL;
+        ctx->frame_info.access_margin = NULL;
+        ctx->details = NULL;
+        ctx->details_loaded = false;
+        ctx->dst_index = NULL;
+        ctx->shares_data = false;
+        return;
+    }
+
+    /* Deferred data is freed with its holder; a loaded copy only aliases it */
+    if (ctx->details)
+    {
+        if (ctx->details_loaded)
+        {
+            memset(&ctx->area_info, 0, sizeof(ctx->area_info));
+            ctx->frame_info.frame_start = NULL;
+            ctx->frame_info.access_margin = NULL;
+        }
+        area_toc_free_details(ctx->details);
+        ctx->details = NULL;
+        ctx->details_loaded = false;
+    }
+
     /* Free area text strings */
     for (int channel_idx = 0; channel_idx < MAX_TEXT_CHANNEL_COUNT; channel_idx++)
     {
@@ -161,12 +239,394 @@ void sacd_area_toc_close(area_toc_t *ctx)
     sa_free(ctx->frame_info.access_margin);
     ctx->frame_info.access_margin = NULL;
 
-    /* Free audio data reader */
+    /* Free audio data reader, then the frame index it filled in */
+    sacd_area_toc_drop_frame_reader(ctx);
+    sacd_dst_index_destroy(ctx->dst_index);
+    ctx->dst_index = NULL;
+}
+
+void sacd_area_toc_drop_frame_reader(area_toc_t *ctx)
+{
     if (ctx->frame_reader)
     {
       ctx->frame_reader->ops->destroy(ctx->frame_reader);
       ctx->frame_reader = NULL;
     }
+    ctx->input = NULL;
+}
+
+/**
+ * @brief Create and bind the audio data reader for the area's frame format
+ */
+static int area_toc_create_frame_reader(area_toc_t *ctx, sacd_input_t *input,
+                                        uint32_t sector_size, int16_t header_size,
+                                        int16_t trailer_size)
+{
+    sacd_frame_reader_t *p;
+
+    switch (ctx->frame_format) {
+        case FRAME_FORMAT_DSD_3_IN_14:
+            if (sacd_frame_reader_fixed14_create(&p) != SACD_FRAME_READER_OK) {
+                return SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
+            }
+            break;
+        case FRAME_FORMAT_DSD_3_IN_16:
+            if (sacd_frame_reader_fixed16_create(&p) != SACD_FRAME_READER_OK) {
+                return SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
+            }
+            break;
+        case FRAME_FORMAT_DST:
+            /* Clones reuse the index of the Area TOC they were made from;
+             * without one, frames are located by scanning */
+            if (!ctx->shares_data && !ctx->dst_index) {
+                ctx->dst_index = sacd_dst_index_create(ctx->total_area_play_time);
+            }
+            if (sacd_frame_reader_dst_create(&p, ctx) != SACD_FRAME_READER_OK) {
+                return SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
+            }
+            break;
+        default:
+            return SACD_AREA_TOC_FRAME_FORMAT;
+    }
+
+    ctx->frame_reader = p;
+    sacd_frame_reader_init(ctx->frame_reader, input, ctx->track_area_start,
+                           ctx->track_area_end, sector_size, header_size,
+                           trailer_size);
+    return SACD_AREA_TOC_OK;
+}
+
+/**
+ * @brief Initialize an Area TOC as a reader over another Area TOC's data
+ *
+ * Copies the parsed fields by value so the clone's pointers alias the
+ * source's track, text and access list allocations, then resets the
+ * playback state the way sacd_area_toc_read() does.
+ */
+int sacd_area_toc_clone(area_toc_t *ctx, const area_toc_t *src, sacd_input_t *input)
+{
+    uint32_t sector_size = 0;
+    int16_t header_size = 0, trailer_size = 0;
+
+    if (!src->initialized)
+    {
+        return SACD_AREA_TOC_UNINITIALIZED;
+    }
+
+    memcpy(ctx, src, sizeof(*ctx));
+    ctx->shares_data = true;
+    ctx->initialized = false;
+    ctx->frame_reader = NULL;
+    ctx->input = NULL;
+
+    ctx->cur_frame_num_data = 0;
+    ctx->cur_track_num = 1;
+    ctx->cur_index_num = 1;
+    ctx->cur_frame_num_text = 0;
+    ctx->frame_start = 1;
+    ctx->frame_stop = 1;
+
+    sacd_input_get_sector_size(input, &sector_size);
+    sacd_input_get_header_size(input, &header_size);
+    sacd_input_get_trailer_size(input, &trailer_size);
+
+    int result = area_toc_create_frame_reader(ctx, input, sector_size,
+                                              header_size, trailer_size);
+    if (result != SACD_AREA_TOC_OK)
+    {
+        sacd_area_toc_close(ctx);
+        return result;
+    }
+
+    ctx->input = input;
+    ctx->initialized = true;
+    return SACD_AREA_TOC_OK;
+}
+
+/**
+ * @brief Copy up to @p sector_count TOC sectors into @p scratch as
+ *        contiguous 2048-byte payloads
+ *
+ * @return Number of bytes gathered
+ */
+static uint32_t area_toc_gather_sectors(uint8_t *scratch, const uint8_t *first,
+                                        uint32_t sector_size, int sector_count)
+{
+    // Ensure we don't overflow the 65536 byte scratch buffer
+    if (sector_count * SACD_LSN_SIZE > 65536) {
+        sector_count = 65536 / SACD_LSN_SIZE;
+    }
+    for (int s = 0; s < sector_count; s++) {
+        memcpy(&scratch[s * SACD_LSN_SIZE], first + s * sector_size, SACD_LSN_SIZE);
+    }
+    return (uint32_t)(sector_count * SACD_LSN_SIZE);
+}
+
+/**
+ * @brief Decode the parts of an Area TOC that a lazy read defers
+ *
+ * Fills @p area_info with the area text, the track_info entries of @p ctx
+ * with ISRC, genre and track text, and @p frame_info with the access list.
+ * The header, track lists and text channel info of @p ctx must already be
+ * parsed from the same TOC.
+ */
+static int area_toc_parse_details(area_toc_t *ctx, const uint8_t *sector_buffer,
+                                  uint32_t sector_size, int16_t header_size,
+                                  uint16_t toc_area_length, area_toc_info_t *area_info,
+                                  area_toc_frame_info_t *frame_info, uint8_t *scratch_buffer)
+{
+    const area_data_t *toc_header = (const area_data_t *)(header_size + sector_buffer);
+    const isrc_genre_list_1_t *isrc_genre_list1 =
+        (const isrc_genre_list_1_t *)(3 * sector_size + header_size + sector_buffer);
+    const isrc_genre_list_2_t *isrc_genre_list2 =
+        (const isrc_genre_list_2_t *)(4 * sector_size + header_size + sector_buffer);
+    uint16_t access_list_offset = ntoh16(toc_header->access_list_ptr);
+    uint16_t track_text_offset  = ntoh16(toc_header->track_text_ptr);
+    uint32_t track_text_scratch_size = 0;
+
+    // A lazy decode works on a second read of the TOC, so check it again
+    if ((access_list_offset != 0 && access_list_offset >= toc_area_length) ||
+        (track_text_offset != 0 && track_text_offset >= toc_area_length)) {
+        return SACD_AREA_TOC_INVALID_SIGNATURE;
+    }
+
+    const access_list_t *access_list =
+        (const access_list_t *)((const uint8_t *)toc_header + (access_list_offset * sector_size));
+    const track_text_header_t *track_text_header =
+        (const track_text_header_t *)((const uint8_t *)toc_header + (track_text_offset * sector_size));
+
+    if (isrc_genre_list1->signature != ISRC_GENRE_SIGN ||
+        (access_list_offset != 0 && access_list->signature != ACCESS_LIST_SIGN) ||
+        (track_text_offset != 0 && track_text_header->signature != TRACK_TEXT_SIGN)) {
+        return SACD_AREA_TOC_INVALID_SIGNATURE;
+    }
+
+    // 1. Area Text
+    // Only process text channels that are actually used (channel_idx < text_channel_count)
+    // Unused channels contain garbage data on disc
+    for (uint32_t channel_idx = 0; channel_idx < ctx->text_channel_count && channel_idx < MAX_TEXT_CHANNEL_COUNT; channel_idx++) {
+        /* Skip text channels with invalid codes */
+        if (ctx->channel_info[channel_idx].character_set_code == 0 || ctx->channel_info[channel_idx].language_code == 0) {
+            continue;
+        }
+
+        for (uint32_t text_type_idx = 0; text_type_idx < MAX_AREA_TEXT_TYPE_COUNT; text_type_idx++) {
+            uint16_t text_offset = 0;
+            switch (text_type_idx) {
+                case AREA_TEXT_TYPE_NAME: text_offset = toc_header->area_text[channel_idx].area_description_ptr; break;
+                case AREA_TEXT_TYPE_COPYRIGHT: text_offset = toc_header->area_text[channel_idx].area_copyright_ptr; break;
+                case AREA_TEXT_TYPE_NAME_PHONETIC: text_offset = toc_header->area_text[channel_idx].area_description_phonetic_ptr; break;
+                case AREA_TEXT_TYPE_COPYRIGHT_PHONETIC: text_offset = toc_header->area_text[channel_idx].area_copyright_phonetic_ptr; break;
+            }
+            text_offset = ntoh16(text_offset);
+
+            /* Bounds check: offset must be non-zero and within sector 0 (area_data_t) */
+            if (text_offset != 0 && text_offset < SACD_LSN_SIZE) {
+                area_info->text[channel_idx][text_type_idx] = sacd_special_string_to_utf8((const char *)toc_header + text_offset, ctx->channel_info[channel_idx].character_set_code);
+            }
+        }
+    }
+
+    // 2. Reassemble text sectors into scratch buffer
+    if (track_text_offset != 0) {
+        int sector_limit = (toc_area_length - track_text_offset < 32) ? (toc_area_length - track_text_offset) : 32;
+        track_text_scratch_size = area_toc_gather_sectors(scratch_buffer, (const uint8_t *)track_text_header,
+                                                          sector_size, sector_limit);
+    }
+
+    // 3. Per-track ISRC, Genre and Text
+    for (uint8_t track_num = 0; track_num < ctx->track_count; track_num++) {
+        area_toc_track_info_t *current_track = &ctx->track_info[track_num];
+
+        if (track_num < ISRC_FIRST_SECTOR_COUNT) {
+            memcpy(&current_track->isrc,
+                    &isrc_genre_list1->isrc_1[track_num], sizeof(area_isrc_t));
+        } else {
+            memcpy(&current_track->isrc,
+                    &isrc_genre_list2->isrc_2[track_num - ISRC_FIRST_SECTOR_COUNT], sizeof(area_isrc_t));
+        }
+
+        current_track->genre.genre_table = isrc_genre_list2->genre[track_num].genre_table;
+        current_track->genre.index       = ntoh16(isrc_genre_list2->genre[track_num].genre_index);
+
+        if (track_text_offset == 0) {
+            continue;
+        }
+
+        track_text_header_t *local_track_text = (track_text_header_t *)scratch_buffer;
+
+        // Only process text channels that are actually used (i < text_channel_count)
+        for (uint32_t i = 0; i < ctx->text_channel_count && i < MAX_TEXT_CHANNEL_COUNT; i++) {
+            /* Skip text channels with invalid codes */
+            if (ctx->channel_info[i].character_set_code == 0 || ctx->channel_info[i].language_code == 0) {
+                continue;
+            }
+
+            uint16_t offset = ntoh16(local_track_text->track_text_item_ptr[(i * ctx->track_count) + track_num]);
+
+            /* Bounds check: offset must be non-zero and within scratch buffer */
+            if (offset != 0 && offset < track_text_scratch_size) {
+                text_item_t *p_text_item = (text_item_t *)((uint8_t *)local_track_text + offset);
+                uint8_t item_count = p_text_item->num_items;
+
+                current_track->track_text_item_count = item_count;
+                current_track->track_text[i] = (area_toc_text_track_t *)sa_calloc(item_count, sizeof(area_toc_text_track_t));
+
+                if (current_track->track_text[i] == NULL) {
+                    return SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
+                }
+
+                offset = 0;
+                for (uint8_t item_num = 0; item_num < item_count; item_num++) {
+                    toc_text_t *text_entry = (toc_text_t *)((uint8_t *)&p_text_item->text + offset);
+
+                    current_track->track_text[i][item_num].text_type = text_entry->type;
+                    current_track->track_text[i][item_num].text = sacd_special_string_to_utf8(text_entry->text, ctx->channel_info[i].character_set_code);
+
+                    uint16_t text_length = sacd_special_string_len(text_entry->text, ctx->channel_info[i].character_set_code);
+                    // Align to next 4-byte boundary
+                    offset = (uint16_t)(offset + ((text_length + 3) & ~0x03));
+                }
+            }
+        }
+    }
+
+    // 4. Parse Access List
+    frame_info->frame_start = NULL;
+    frame_info->access_margin = NULL;
+    if (access_list_offset != 0) {
+        int sector_limit = (toc_area_length - access_list_offset < 32) ? (toc_area_length - access_list_offset) : 32;
+        area_toc_gather_sectors(scratch_buffer, (const uint8_t *)access_list, sector_size, sector_limit);
+        access_list_t *scratch_access_list = (access_list_t *)scratch_buffer;
+
+        frame_info->step_size = scratch_access_list->main_step_size;
+        frame_info->num_entries = ntoh16(scratch_access_list->entry_count);
+
+        frame_info->frame_start = (uint32_t *)sa_malloc(frame_info->num_entries * sizeof(uint32_t));
+        if (frame_info->frame_start == NULL) {
+            return SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
+        }
+
+        frame_info->access_margin = (uint16_t *)sa_malloc(frame_info->num_entries * sizeof(uint16_t));
+        if (frame_info->access_margin == NULL) {
+            return SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
+        }
+
+        for (uint16_t entry_idx = 0; entry_idx < frame_info->num_entries; entry_idx++) {
+            /* Parse 3-byte big-endian entry as: entry[0] << 16 | entry[1] << 8 | entry[2] */
+            uint8_t *entry = scratch_access_list->main_acc_list[entry_idx].entry;
+            frame_info->frame_start[entry_idx] = ((uint32_t)entry[0] << 16)
+                                               | ((uint32_t)entry[1] << 8)
+                                               | ((uint32_t)entry[2]);
+
+            /* Parse access_flags and extract margin (bits 0-14, bit 15 is detailed_access flag) */
+            uint16_t flags = ntoh16(scratch_access_list->main_acc_list[entry_idx].access_flags);
+            frame_info->access_margin[entry_idx] = flags & 0x7FFF;
+        }
+    }
+
+    return SACD_AREA_TOC_OK;
+}
+
+/**
+ * @brief Attach the deferred data holder to a lazily read Area TOC
+ */
+static int area_toc_create_details(area_toc_t *ctx, uint32_t toc_start_lsn,
+                                   uint16_t toc_area_length)
+{
+    area_toc_details_t *details = (area_toc_details_t *)sa_calloc(1, sizeof(area_toc_details_t));
+    if (details == NULL) {
+        return SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
+    }
+    if (mtx_init(&details->lock, mtx_plain) != thrd_success) {
+        sa_free(details);
+        return SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    atomic_init(&details->loaded, false);
+    details->owner = ctx;
+    details->toc_start_lsn = toc_start_lsn;
+    details->toc_area_length = toc_area_length;
+    details->frame_info = ctx->frame_info;
+
+    ctx->details = details;
+    ctx->details_loaded = false;
+    return SACD_AREA_TOC_OK;
+}
+
+/**
+ * @brief Read the TOC again and decode its deferred data
+ */
+static int area_toc_load_details(area_toc_details_t *details, sacd_input_t *input)
+{
+    int result;
+    uint8_t *sector_buffer;
+    uint8_t *scratch_buffer;
+    uint32_t sector_size = 0;
+    int16_t header_size = 0;
+    uint32_t sectors_read = 0;
+
+    if (input == NULL) {
+        return SACD_AREA_TOC_IO_ERROR;
+    }
+
+    sacd_input_get_sector_size(input, &sector_size);
+    sacd_input_get_header_size(input, &header_size);
+
+    sector_buffer = (uint8_t *)sa_malloc((size_t)sector_size * details->toc_area_length);
+    scratch_buffer = (uint8_t *)sa_malloc(65536);
+    if (sector_buffer == NULL || scratch_buffer == NULL) {
+        sa_free(sector_buffer);
+        sa_free(scratch_buffer);
+        return SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    if (sacd_input_read_sectors(input, details->toc_start_lsn, details->toc_area_length,
+                                sector_buffer, &sectors_read) != 0) {
+        result = SACD_AREA_TOC_IO_ERROR;
+    } else if (sectors_read != details->toc_area_length) {
+        result = SACD_AREA_TOC_NO_DATA;
+    } else {
+        result = area_toc_parse_details(details->owner, sector_buffer, sector_size,
+                                        header_size, details->toc_area_length,
+                                        &details->area_info, &details->frame_info,
+                                        scratch_buffer);
+    }
+
+    sa_free(sector_buffer);
+    sa_free(scratch_buffer);
+    return result;
+}
+
+/**
+ * @brief Make the deferred data of a lazily read Area TOC available
+ *
+ * The first caller among the Area TOC and its clones decodes it, reading
+ * through its own input. Every caller then copies the area text and access
+ * list into its own context, so this is a plain flag test afterwards.
+ * A failed decode is not retried; the affected queries report whatever
+ * could be decoded.
+ */
+static void area_toc_ensure_details(area_toc_t *ctx)
+{
+    area_toc_details_t *details = ctx->details;
+
+    if (details == NULL || ctx->details_loaded) {
+        return;
+    }
+
+    if (!atomic_load_explicit(&details->loaded, memory_order_acquire)) {
+        mtx_lock(&details->lock);
+        if (!atomic_load_explicit(&details->loaded, memory_order_relaxed)) {
+            area_toc_load_details(details, ctx->input);
+            atomic_store_explicit(&details->loaded, true, memory_order_release);
+        }
+        mtx_unlock(&details->lock);
+    }
+
+    ctx->area_info = details->area_info;
+    ctx->frame_info = details->frame_info;
+    ctx->details_loaded = true;
 }
 
 /**
@@ -187,10 +647,15 @@ void sacd_area_toc_close(area_toc_t *ctx)
  * - Access_List (optional, 32 sectors): Frame address table for DST seeking
  * - Track_Text (optional, variable): Multi-language track metadata
  * - Index_List (optional, variable): Sub-track index points
+ *
+ * A lazy read stops after the track lists and index points. The area text,
+ * ISRC/genre list, track text and access list are decoded by
+ * area_toc_ensure_details() when first queried, which spares catalog scans
+ * the charset conversions and allocations for data they never look at.
  */
 int sacd_area_toc_read(area_toc_t *ctx, uint32_t toc_copy_index, uint32_t toc_area1_start,
                       uint32_t toc_area2_start, uint16_t toc_area_length,
-                      channel_t area_type, sacd_input_t *input)
+                      channel_t area_type, sacd_input_t *input, bool lazy)
 {
     int result = SACD_AREA_TOC_OK;
     uint32_t toc_start_lsn;
@@ -205,7 +670,6 @@ int sacd_area_toc_read(area_toc_t *ctx, uint32_t toc_copy_index, uint32_t toc_ar
     track_list_1_t *track_list1;
     track_list_2_t *track_list2;
     isrc_genre_list_1_t *isrc_genre_list1;
-    isrc_genre_list_2_t *isrc_genre_list2;
     access_list_t *access_list;
     track_text_header_t *track_text_header;
     index_list_t *index_list;
@@ -260,7 +724,6 @@ int sacd_area_toc_read(area_toc_t *ctx, uint32_t toc_copy_index, uint32_t toc_ar
     track_list1      = (track_list_1_t *)(1 * sector_size + header_size + sector_buffer);
     track_list2      = (track_list_2_t *)(2 * sector_size + header_size + sector_buffer);
     isrc_genre_list1 = (isrc_genre_list_1_t *)(3 * sector_size + header_size + sector_buffer);
-    isrc_genre_list2 = (isrc_genre_list_2_t *)(4 * sector_size + header_size + sector_buffer);
 
     uint16_t access_list_offset = ntoh16(toc_header->access_list_ptr);
     uint16_t track_text_offset  = ntoh16(toc_header->track_text_ptr);
@@ -328,7 +791,7 @@ int sacd_area_toc_read(area_toc_t *ctx, uint32_t toc_copy_index, uint32_t toc_ar
     }
     ctx->channel_count = toc_header->channel_count;
 
-    // 7. Process Text Channels (Album Info)
+    // 7. Process Text Channels
     // First, initialize ALL channel info and text pointers to safe defaults
     for (int channel_idx = 0; channel_idx < MAX_TEXT_CHANNEL_COUNT; channel_idx++) {
         ctx->channel_info[channel_idx].character_set_code = 0;
@@ -343,27 +806,6 @@ int sacd_area_toc_read(area_toc_t *ctx, uint32_t toc_copy_index, uint32_t toc_ar
     for (uint32_t channel_idx = 0; channel_idx < ctx->text_channel_count && channel_idx < MAX_TEXT_CHANNEL_COUNT; channel_idx++) {
         ctx->channel_info[channel_idx].character_set_code = toc_header->text_channels.info[channel_idx].character_set_code;
         ctx->channel_info[channel_idx].language_code = toc_header->text_channels.info[channel_idx].language_code;
-
-        /* Skip text channels with invalid codes */
-        if (ctx->channel_info[channel_idx].character_set_code == 0 || ctx->channel_info[channel_idx].language_code == 0) {
-            continue;
-        }
-
-        for (uint32_t text_type_idx = 0; text_type_idx < MAX_AREA_TEXT_TYPE_COUNT; text_type_idx++) {
-            uint16_t text_offset = 0;
-            switch (text_type_idx) {
-                case AREA_TEXT_TYPE_NAME: text_offset = toc_header->area_text[channel_idx].area_description_ptr; break;
-                case AREA_TEXT_TYPE_COPYRIGHT: text_offset = toc_header->area_text[channel_idx].area_copyright_ptr; break;
-                case AREA_TEXT_TYPE_NAME_PHONETIC: text_offset = toc_header->area_text[channel_idx].area_description_phonetic_ptr; break;
-                case AREA_TEXT_TYPE_COPYRIGHT_PHONETIC: text_offset = toc_header->area_text[channel_idx].area_copyright_phonetic_ptr; break;
-            }
-            text_offset = ntoh16(text_offset);
-
-            /* Bounds check: offset must be non-zero and within sector 0 (area_data_t) */
-            if (text_offset != 0 && text_offset < SACD_LSN_SIZE) {
-                ctx->area_info.text[channel_idx][text_type_idx] = sacd_special_string_to_utf8((const char *)toc_header + text_offset, ctx->channel_info[channel_idx].character_set_code);
-            }
-        }
     }
 
     // 8. Allocate Track Info Array
@@ -373,33 +815,34 @@ int sacd_area_toc_read(area_toc_t *ctx, uint32_t toc_copy_index, uint32_t toc_ar
         goto cleanup;
     }
 
+    // Reassemble index sectors into scratch buffer
+    index_list_t *scratch_index_list = NULL;
+    uint32_t index_scratch_size = 0;
+
+    if (index_list_offset != 0) {
+        int sector_limit = (toc_area_length - index_list_offset < 10) ? (toc_area_length - index_list_offset) : 10;
+        index_scratch_size = area_toc_gather_sectors(scratch_buffer, (uint8_t *)index_list,
+                                                     sector_size, sector_limit);
+        scratch_index_list = (index_list_t *)scratch_buffer;
+    }
+
     // 9. Process Tracks
     uint32_t running_track_start_frame = 0;
 
     for (uint8_t track_num = 0; track_num < ctx->track_count; track_num++) {
         area_toc_track_info_t *current_track = &ctx->track_info[track_num];
 
-        // --- ISRC & Basic Info ---
-        if (track_num < ISRC_FIRST_SECTOR_COUNT) {
-            memcpy(&current_track->isrc,
-                    &isrc_genre_list1->isrc_1[track_num], sizeof(area_isrc_t));
-        } else {
-            memcpy(&current_track->isrc,
-                    &isrc_genre_list2->isrc_2[track_num - ISRC_FIRST_SECTOR_COUNT], sizeof(area_isrc_t));
-        }
-
-        current_track->genre.genre_table = isrc_genre_list2->genre[track_num].genre_table;
-        current_track->genre.index       = ntoh16(isrc_genre_list2->genre[track_num].genre_index);
+        // --- Basic Info ---
         current_track->track_length      = time_to_frame(track_list2->info_2[track_num].track_time_length);
         current_track->track_mode        = track_list2->info_1[track_num].track_mode;
-        
+
         // Flags
         current_track->track_flag_tmf1   = track_list2->info_2[track_num].track_flag_tmf1 == 1;
         current_track->track_flag_tmf2   = track_list2->info_2[track_num].track_flag_tmf2 == 1;
         current_track->track_flag_tmf3   = track_list2->info_2[track_num].track_flag_tmf3 == 1;
         current_track->track_flag_tmf4   = track_list2->info_2[track_num].track_flag_tmf4 == 1;
         current_track->track_flag_ilp    = track_list2->info_2[track_num].track_flag_ilp == 1;
-        
+
         /* Track start LSN: per the SACD spec (§3.2.2.2), Track_Start_Address[tno]
          * is the LSN of the first sector of Track[tno], which follows Pause[tno].
          * Track_Area_Start_Address points to the start of Pause[1], not Track[1].
@@ -422,26 +865,8 @@ int sacd_area_toc_read(area_toc_t *ctx, uint32_t toc_copy_index, uint32_t toc_ar
         // --- Index Points ---
         uint8_t index_count = 0;
         uint16_t index_offset = 0;
-        index_list_t *scratch_index_list = NULL;
-        uint32_t index_scratch_size = 0;
-
-        if (index_list_offset != 0) {
-            // Reassemble index sectors into scratch buffer
-            int sector_limit = (toc_area_length - index_list_offset < 10) ? (toc_area_length - index_list_offset) : 10;
-            // Ensure we don't overflow the 65536 byte scratch buffer
-            if (sector_limit * SACD_LSN_SIZE > 65536) {
-                sector_limit = 65536 / SACD_LSN_SIZE;
-            }
-            index_scratch_size = (uint32_t)(sector_limit * SACD_LSN_SIZE);
-            for (int s = 0; s < sector_limit; s++) {
-                size_t dest_offset = s * SACD_LSN_SIZE;
-                if (dest_offset + SACD_LSN_SIZE <= 65536) {
-                    memcpy(&scratch_buffer[dest_offset],
-                           (uint8_t *)index_list + s * sector_size, SACD_LSN_SIZE);
-                }
-            }
-            scratch_index_list = (index_list_t *)scratch_buffer;
 
+        if (scratch_index_list) {
             index_offset = ntoh16(index_list->index_ptr[track_num]);
             /* Bounds check: index_offset must be non-zero and within scratch buffer */
             if (index_offset != 0 && index_offset < index_scratch_size) {
@@ -464,7 +889,7 @@ int sacd_area_toc_read(area_toc_t *ctx, uint32_t toc_copy_index, uint32_t toc_ar
         current_track->index_start[0] = running_track_start_frame;
         running_track_start_frame = time_to_frame(track_list2->info_1[track_num].track_start_time_code);
         current_track->index_start[1] = running_track_start_frame;
-        
+
         // Update running start for next track
         running_track_start_frame += time_to_frame(track_list2->info_2[track_num].track_time_length);
 
@@ -475,149 +900,34 @@ int sacd_area_toc_read(area_toc_t *ctx, uint32_t toc_copy_index, uint32_t toc_ar
              }
         }
 
-        // --- Track Text ---
+        // --- Track Text (filled in with the details) ---
         current_track->track_text_item_count = 0;
-        for (int i = 0; i < MAX_TEXT_CHANNEL_COUNT; i++) { 
+        for (int i = 0; i < MAX_TEXT_CHANNEL_COUNT; i++) {
             current_track->track_text[i] = NULL;
         }
-
-        if (track_text_offset != 0) {
-            // Reassemble text sectors into scratch buffer
-            int sector_limit = (toc_area_length - track_text_offset < 32) ? (toc_area_length - track_text_offset) : 32;
-            // Ensure we don't overflow the 65536 byte scratch buffer
-            if (sector_limit * SACD_LSN_SIZE > 65536) {
-                sector_limit = 65536 / SACD_LSN_SIZE;
-            }
-            uint32_t track_text_scratch_size = (uint32_t)(sector_limit * SACD_LSN_SIZE);
-            for (int s = 0; s < sector_limit; s++) {
-                size_t dest_offset = s * SACD_LSN_SIZE;
-                if (dest_offset + SACD_LSN_SIZE <= 65536) {
-                    memcpy(&scratch_buffer[dest_offset],
-                           (uint8_t *)track_text_header + s * sector_size, SACD_LSN_SIZE);
-                }
-            }
-            // Use local var to shadow outer scope for clarity
-            track_text_header_t *local_track_text = (track_text_header_t *)scratch_buffer;
-
-            // Only process text channels that are actually used (i < text_channel_count)
-            for (uint32_t i = 0; i < ctx->text_channel_count && i < MAX_TEXT_CHANNEL_COUNT; i++) {
-                /* Skip text channels with invalid codes */
-                if (ctx->channel_info[i].character_set_code == 0 || ctx->channel_info[i].language_code == 0) {
-                    continue;
-                }
-
-                uint16_t offset = ntoh16(local_track_text->track_text_item_ptr[(i * ctx->track_count) + track_num]);
-
-                /* Bounds check: offset must be non-zero and within scratch buffer */
-                if (offset != 0 && offset < track_text_scratch_size) {
-                    text_item_t *p_text_item = (text_item_t *)((uint8_t *)local_track_text + offset);
-                    uint8_t item_count = p_text_item->num_items;
-
-                    current_track->track_text_item_count = item_count;
-                    current_track->track_text[i] = (area_toc_text_track_t *)sa_calloc(item_count, sizeof(area_toc_text_track_t));
-
-                    if (current_track->track_text[i] == NULL) {
-                        result = SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
-                        goto cleanup;
-                    }
-
-                    offset = 0;
-                    for (uint8_t item_num = 0; item_num < item_count; item_num++) {
-                        toc_text_t *text_entry = (toc_text_t *)((uint8_t *)&p_text_item->text + offset);
-
-                        current_track->track_text[i][item_num].text_type = text_entry->type;
-                        current_track->track_text[i][item_num].text = sacd_special_string_to_utf8(text_entry->text, ctx->channel_info[i].character_set_code);
-
-                        uint16_t text_length = sacd_special_string_len(text_entry->text, ctx->channel_info[i].character_set_code);
-                        // Align to next 4-byte boundary
-                        offset = (uint16_t)(offset + ((text_length + 3) & ~0x03));
-                    }
-                }
-            }
-        }
     }
 
-    // 10. Parse Access List
+    // 10. Area Text, ISRC/Genre, Track Text and Access List
     ctx->frame_info.frame_start = NULL;
     ctx->frame_info.access_margin = NULL;
-    if (access_list_offset != 0) {
-        // Ensure we don't overflow the 65536 byte scratch buffer
-        int access_limit = (32 * SACD_LSN_SIZE > 65536) ? (65536 / SACD_LSN_SIZE) : 32;
-        for (int s = 0; s < access_limit; s++) {
-            size_t dest_offset = s * SACD_LSN_SIZE;
-            if (dest_offset + SACD_LSN_SIZE <= 65536) {
-                memcpy(&scratch_buffer[dest_offset],
-                       (uint8_t *)access_list + (s * sector_size), SACD_LSN_SIZE);
-            }
-        }
-        access_list_t *scratch_access_list = (access_list_t *)scratch_buffer;
-
-        ctx->frame_info.step_size = scratch_access_list->main_step_size;
-        ctx->frame_info.num_entries = ntoh16(scratch_access_list->entry_count);
-
-        ctx->frame_info.frame_start = (uint32_t *)sa_malloc(ctx->frame_info.num_entries * sizeof(uint32_t));
-        if (ctx->frame_info.frame_start == NULL) {
-            result = SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
-            goto cleanup;
-        }
-
-        ctx->frame_info.access_margin = (uint16_t *)sa_malloc(ctx->frame_info.num_entries * sizeof(uint16_t));
-        if (ctx->frame_info.access_margin == NULL) {
-            result = SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
-            goto cleanup;
-        }
-
-        for (uint16_t entry_idx = 0; entry_idx < ctx->frame_info.num_entries; entry_idx++) {
-            /* Parse 3-byte big-endian entry as: entry[0] << 16 | entry[1] << 8 | entry[2] */
-            uint8_t *entry = scratch_access_list->main_acc_list[entry_idx].entry;
-            ctx->frame_info.frame_start[entry_idx] = ((uint32_t)entry[0] << 16)
-                                                   | ((uint32_t)entry[1] << 8)
-                                                   | ((uint32_t)entry[2]);
-
-            /* Parse access_flags and extract margin (bits 0-14, bit 15 is detailed_access flag) */
-            uint16_t flags = ntoh16(scratch_access_list->main_acc_list[entry_idx].access_flags);
-            ctx->frame_info.access_margin[entry_idx] = flags & 0x7FFF;
-        }
+    if (lazy) {
+        result = area_toc_create_details(ctx, toc_start_lsn, toc_area_length);
+    } else {
+        result = area_toc_parse_details(ctx, sector_buffer, sector_size, header_size,
+                                        toc_area_length, &ctx->area_info,
+                                        &ctx->frame_info, scratch_buffer);
+    }
+    if (result != SACD_AREA_TOC_OK) {
+        goto cleanup;
     }
 
     // 11. Create Audio Structure
-    switch (ctx->frame_format) {
-        case FRAME_FORMAT_DSD_3_IN_14: {
-            sacd_frame_reader_t *p;
-            if (sacd_frame_reader_fixed14_create(&p) != SACD_FRAME_READER_OK) {
-                result = SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
-                goto cleanup;
-            }
-            ctx->frame_reader = p;
-            break;
-        }
-        case FRAME_FORMAT_DSD_3_IN_16: {
-        sacd_frame_reader_t *p;
-        if (sacd_frame_reader_fixed16_create(&p) != SACD_FRAME_READER_OK) {
-            result = SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
-            goto cleanup;
-        }
-        ctx->frame_reader = p;
-        break;
-        }
-        case FRAME_FORMAT_DST: {
-        sacd_frame_reader_t *p;
-        if (sacd_frame_reader_dst_create(&p, ctx) != SACD_FRAME_READER_OK) {
-            result = SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
-            goto cleanup;
-        }
-        ctx->frame_reader = p;
-        break;
-        }
-        default:
-            result = SACD_AREA_TOC_FRAME_FORMAT;
-            goto cleanup;
+    result = area_toc_create_frame_reader(ctx, input, sector_size, header_size,
+                                          trailer_size);
+    if (result != SACD_AREA_TOC_OK) {
+        goto cleanup;
     }
 
-    sacd_frame_reader_init(ctx->frame_reader, input, ctx->track_area_start,
-                           ctx->track_area_end, sector_size, header_size,
-                           trailer_size);
-
     // Success - mark as initialized
     ctx->initialized = true;
 
@@ -759,6 +1069,8 @@ uint32_t sacd_area_toc_get_frame_lsn(area_toc_t *ctx, uint32_t frame_num)
         return 0;
     }
 
+    area_toc_ensure_details(ctx);
+
     /* Return 0 if access list is not available (used for plain DSD audio) */
     if (!ctx->frame_info.frame_start || ctx->frame_info.num_entries == 0)
     {
@@ -885,6 +1197,108 @@ int sacd_area_toc_get_frame_sector_range(area_toc_t *ctx, uint32_t frame,
     return SACD_AREA_TOC_OK;
 }
 
+/**
+ * @brief Map a DST reader status to an Area TOC status.
+ */
+static int area_toc_from_dst_status(int status)
+{
+    switch (status) {
+        case SACD_DST_READER_OK:
+            return SACD_AREA_TOC_OK;
+        case SACD_DST_READER_MEMORY_ALLOCATION_ERROR:
+            return SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
+        case SACD_DST_READER_INVALID_ARG:
+            return SACD_AREA_TOC_INVALID_ARGUMENT;
+        case SACD_DST_READER_FRAME_NOT_FOUND:
+            return SACD_AREA_TOC_NO_DATA;
+        default:
+            return SACD_AREA_TOC_IO_ERROR;
+    }
+}
+
+int sacd_area_toc_get_audio_frames(area_toc_t *ctx, uint32_t frame_num,
+                                   uint32_t *frame_count, sacd_frame_ref_t *frames)
+{
+    uint32_t frame_lsn;
+    uint32_t length;
+    int read_result;
+
+    if (!ctx->initialized) {
+      return SACD_AREA_TOC_UNINITIALIZED;
+    }
+
+    frame_lsn = sacd_area_toc_get_frame_lsn(ctx, frame_num);
+
+    if (sacd_frame_reader_has_read_frames(ctx->frame_reader)) {
+        read_result = sacd_frame_reader_read_frames(ctx->frame_reader, frame_num,
+                                                    frame_lsn, frame_count, frames);
+        if (ctx->frame_format == FRAME_FORMAT_DST) {
+            return area_toc_from_dst_status(read_result);
+        }
+        if (read_result == SACD_DSD_READER_MEMORY_ALLOCATION_ERROR) {
+            return SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
+        }
+        return (read_result == SACD_DSD_READER_OK) ? SACD_AREA_TOC_OK : SACD_AREA_TOC_IO_ERROR;
+    }
+
+    /* Reader without a batch path: one frame, copied into its own buffer */
+    *frame_count = 0;
+    length = (4704 + 1) * ctx->channel_count;
+    frames[0].buf = sa_buffer_alloc(length);
+    if (!frames[0].buf) {
+        return SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR;
+    }
+    read_result = sacd_frame_reader_read_frame(ctx->frame_reader, frames[0].buf->data, &length,
+                                               frame_num, frame_lsn, DATA_TYPE_AUDIO);
+    if (read_result != SACD_AREA_TOC_OK) {
+        sa_buffer_unref(&frames[0].buf);
+        return SACD_AREA_TOC_IO_ERROR;
+    }
+    frames[0].data = frames[0].buf->data;
+    frames[0].size = length;
+    frames[0].frame_nr = frame_num;
+    *frame_count = 1;
+    return SACD_AREA_TOC_OK;
+}
+
+int sacd_area_toc_build_frame_index(area_toc_t *ctx)
+{
+    if (!ctx->initialized) {
+      return SACD_AREA_TOC_UNINITIALIZED;
+    }
+
+    /* Fixed DSD frames are located arithmetically */
+    if (ctx->frame_format != FRAME_FORMAT_DST) {
+        return SACD_AREA_TOC_OK;
+    }
+
+    return area_toc_from_dst_status(sacd_dst_reader_build_index(ctx->frame_reader));
+}
+
+int sacd_area_toc_load_frame_index(area_toc_t *ctx, const char *path)
+{
+    if (!ctx->initialized) {
+      return SACD_AREA_TOC_UNINITIALIZED;
+    }
+    if (ctx->frame_format != FRAME_FORMAT_DST) {
+        return SACD_AREA_TOC_FRAME_FORMAT;
+    }
+
+    return area_toc_from_dst_status(sacd_dst_reader_load_index(ctx->frame_reader, path));
+}
+
+int sacd_area_toc_save_frame_index(area_toc_t *ctx, const char *path)
+{
+    if (!ctx->initialized) {
+      return SACD_AREA_TOC_UNINITIALIZED;
+    }
+    if (ctx->frame_format != FRAME_FORMAT_DST) {
+        return SACD_AREA_TOC_FRAME_FORMAT;
+    }
+
+    return area_toc_from_dst_status(sacd_dst_reader_save_index(ctx->frame_reader, path));
+}
+
 /* ========================================================================
  * Area Properties
  * ======================================================================== */
@@ -1006,6 +1420,7 @@ area_isrc_t sacd_area_toc_get_track_isrc_num(area_toc_t *ctx, uint8_t track_num)
     if (!ctx->initialized || track_num < 1 || track_num > ctx->track_count || !ctx->track_info) {
         return empty_isrc;
     }
+    area_toc_ensure_details(ctx);
     return ctx->track_info[track_num - 1].isrc;
 }
 
@@ -1084,6 +1499,7 @@ void sacd_area_toc_get_track_genre(area_toc_t *ctx, uint8_t track_num, uint8_t *
     if (track_num < 1 || track_num > ctx->track_count || !ctx->track_info) {
         return;
     }
+    area_toc_ensure_details(ctx);
     *out_genre_table = ctx->track_info[track_num - 1].genre.genre_table;
     *out_genre_index = ctx->track_info[track_num - 1].genre.index;
 }
@@ -1216,6 +1632,7 @@ char *sacd_area_toc_get_area_text(area_toc_t *ctx, uint8_t channel_number,
     if (text_type >= MAX_AREA_TEXT_TYPE_COUNT) {
         return NULL;
     }
+    area_toc_ensure_details(ctx);
     return ctx->area_info.text[channel_number - 1][text_type];
 }
 
@@ -1264,6 +1681,8 @@ char *sacd_area_toc_get_track_text(area_toc_t *ctx, uint8_t track_num, uint8_t c
     int track_idx = track_num - 1;
     int channel_idx = channel_number - 1;
 
+    area_toc_ensure_details(ctx);
+
     /* Check if this track has any text for the specified channel */
     if (!ctx->track_info[track_idx].track_text[channel_idx])
     {
@@ -1313,6 +1732,7 @@ int sacd_area_toc_get_access_list_range(area_toc_t *ctx,
         return SACD_AREA_TOC_INVALID_ARGUMENT;
     }
 
+    area_toc_ensure_details(ctx);
     access_info = &ctx->frame_info;
 
     /* Check if access list is available */
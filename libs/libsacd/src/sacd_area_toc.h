@@ -171,6 +171,15 @@ typedef struct {
     char* text[MAX_TEXT_CHANNEL_COUNT][MAX_AREA_TEXT_TYPE_COUNT];  /**< Area text strings [channel][type] */
 } area_toc_info_t;
 
+/**
+ * @brief Deferred Area TOC data of a lazily read Area TOC
+ *
+ * Holds what sacd_area_toc_read() skipped (area text, ISRC/genre tables,
+ * track text and the access list) once it has been decoded. Owned by the
+ * Area TOC that was read and shared by all of its clones.
+ */
+typedef struct area_toc_details_s area_toc_details_t;
+
 /**
  * @brief Main Area TOC context structure
  *
@@ -216,6 +225,8 @@ struct area_toc_s {
     /* === Metadata === */
     area_toc_info_t area_info;          /**< Area-level text information */
     area_toc_frame_info_t frame_info;   /**< Frame access list (for DST seeking) */
+    area_toc_details_t* details;        /**< Deferred data, NULL if the TOC was read eagerly */
+    bool details_loaded;                /**< True once area_info/frame_info hold the deferred data */
 
     /* === Current Playback State === */
     uint32_t cur_frame_num_data;        /**< Current frame number for audio data */
@@ -227,12 +238,14 @@ struct area_toc_s {
 
     /* === Audio Data Reader === */
     sacd_frame_reader_t *frame_reader;  /**< Audio data reader (DST or DSD implementation) */
+    struct sacd_dst_index_s *dst_index; /**< DST frame index, shared with clones (NULL for DSD or if allocation failed) */
 
     /* === Disc Access === */
     sacd_input_t* input;  /**< Input device for disc sector access */
 
     /* === Initialization State === */
     bool initialized;     /**< True if context has been successfully initialized and TOC has been read */
+    bool shares_data;     /**< True if the parsed TOC data belongs to another Area TOC (see sacd_area_toc_clone()) */
 };
 
 /* ========================================================================
@@ -275,6 +288,10 @@ void sacd_area_toc_destroy(area_toc_t* ctx);
  * @param toc_area_length    Length of Area TOC in sectors
  * @param area_type          Type of area (TWO_CHANNEL or MULTI_CHANNEL)
  * @param input              Input device for disc sector access
+ * @param lazy               Only decode the header, track list and index
+ *                           points now; area text, ISRC/genre tables, track
+ *                           text and the access list are decoded the first
+ *                           time one of them is queried
  *
  * @return SACD_AREA_TOC_OK on success, or error code:
  *         - SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR: Memory allocation failed
@@ -286,7 +303,7 @@ void sacd_area_toc_destroy(area_toc_t* ctx);
  */
 int sacd_area_toc_read(area_toc_t* ctx, uint32_t toc_copy_index, uint32_t toc_area1_start,
                         uint32_t toc_area2_start, uint16_t toc_area_length,
-                        channel_t area_type, sacd_input_t* input);
+                        channel_t area_type, sacd_input_t* input, bool lazy);
 
 /**
  * @brief Close and cleanup Area TOC resources
@@ -298,6 +315,37 @@ int sacd_area_toc_read(area_toc_t* ctx, uint32_t toc_copy_index, uint32_t toc_ar
  */
 void sacd_area_toc_close(area_toc_t* ctx);
 
+/**
+ * @brief Initialize an Area TOC as a reader over another Area TOC's data
+ *
+ * The clone shares the parsed track, text and access list data of @p src
+ * and gets its own playback state and audio data reader bound to @p input.
+ * @p src must stay alive, and must not be re-read, until the clone is
+ * closed. Closing a clone only releases its audio data reader.
+ * If @p src was read lazily, its deferred data is decoded once, by whichever
+ * clone queries it first.
+ *
+ * @param ctx   Pointer to the Area TOC context to initialize
+ * @param src   Initialized Area TOC whose data is shared
+ * @param input Input device for the clone's sector access
+ *
+ * @return SACD_AREA_TOC_OK on success, or error code:
+ *         - SACD_AREA_TOC_UNINITIALIZED: @p src has not been read
+ *         - SACD_AREA_TOC_MEMORY_ALLOCATION_ERROR: Memory allocation failed
+ *         - SACD_AREA_TOC_FRAME_FORMAT: Unsupported frame format
+ */
+int sacd_area_toc_clone(area_toc_t* ctx, const area_toc_t* src, sacd_input_t* input);
+
+/**
+ * @brief Release the audio data reader, keeping the parsed TOC data
+ *
+ * Used once the Area TOC only serves as the data source of clones, so it
+ * no longer holds on to an input device.
+ *
+ * @param ctx Pointer to the Area TOC context
+ */
+void sacd_area_toc_drop_frame_reader(area_toc_t* ctx);
+
 /* ========================================================================
  * Specification and Text Channel Queries
  * ======================================================================== */
@@ -424,6 +472,22 @@ frame_format_t sacd_area_toc_get_frame_format_enum(area_toc_t* ctx);
 int sacd_area_toc_get_audio_data(area_toc_t* ctx, uint8_t* out_data, uint32_t* length,
                              uint32_t frame_num, audio_packet_data_type_t data_type);
 
+/**
+ * @brief Read main audio data for a run of frames without copying it
+ *
+ * Returns descriptors pointing into reference-counted sector buffers; see
+ * sacd_get_sound_frames(). Does not move the current frame position.
+ *
+ * @param ctx          Pointer to Area TOC context
+ * @param frame_num    First frame number to read
+ * @param frame_count  Input: maximum frames; Output: frames returned
+ * @param frames       Receives one descriptor per frame
+ *
+ * @return SACD_AREA_TOC_OK on success, or error code
+ */
+int sacd_area_toc_get_audio_frames(area_toc_t* ctx, uint32_t frame_num,
+                                   uint32_t* frame_count, sacd_frame_ref_t* frames);
+
 /**
  * @brief Get sector information for a specific frame
  *
@@ -439,6 +503,40 @@ int sacd_area_toc_get_audio_data(area_toc_t* ctx, uint8_t* out_data, uint32_t* l
 int sacd_area_toc_get_frame_sector_range(area_toc_t* ctx, uint32_t frame,
                                  uint32_t* out_start_sector, int* out_sector_count);
 
+/**
+ * @brief Index the start sector of every frame in the area
+ *
+ * Only DST areas need an index; for fixed DSD areas this is a no-op.
+ *
+ * @param ctx Pointer to Area TOC context
+ *
+ * @return SACD_AREA_TOC_OK on success, or error code
+ */
+int sacd_area_toc_build_frame_index(area_toc_t* ctx);
+
+/**
+ * @brief Load the DST frame index from a sidecar file
+ *
+ * @param ctx  Pointer to Area TOC context
+ * @param path Sidecar file path
+ *
+ * @return SACD_AREA_TOC_OK on success, SACD_AREA_TOC_FRAME_FORMAT if the area
+ *         is not DST coded, SACD_AREA_TOC_INVALID_ARGUMENT if the file does
+ *         not match this area, or error code
+ */
+int sacd_area_toc_load_frame_index(area_toc_t* ctx, const char* path);
+
+/**
+ * @brief Save the DST frame index to a sidecar file
+ *
+ * @param ctx  Pointer to Area TOC context
+ * @param path Sidecar file path
+ *
+ * @return SACD_AREA_TOC_OK on success, SACD_AREA_TOC_FRAME_FORMAT if the area
+ *         is not DST coded, or error code
+ */
+int sacd_area_toc_save_frame_index(area_toc_t* ctx, const char* path);
+
 /* ========================================================================
  * Area Properties
  * ======================================================================== */
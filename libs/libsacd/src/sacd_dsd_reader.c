@@ -36,10 +36,16 @@
 #include <stdlib.h>
 #include <string.h>
 #include <libsautil/mem.h>
+#include <libsautil/buffer.h>
 
 #include "sacd_dsd_reader.h"
 #include "sacd_specification.h"
 
+/**
+ * @brief Most frames returned by one read_frames call (four 3-frame blocks).
+ */
+#define DSD_READ_FRAMES_MAX 12
+
 /**
  * @struct fixed_read_def_t
  * @brief Defines a byte range to read from a single sector.
@@ -240,6 +246,121 @@ static inline int dsd_audio_fixed_get_sector(
     return SACD_DSD_READER_OK;
 }
 
+/**
+ * @brief Generic fixed-format multi-frame reader.
+ *
+ * Reads the sectors spanned by a run of frames with one input call and
+ * assembles the frames into a single reference-counted buffer. Every fixed
+ * DSD frame crosses sector boundaries, so frames are always reassembled;
+ * the saving is one read for the run instead of one per sector.
+ *
+ * @param[in]     state        Pointer to the layout pattern table
+ * @param[in]     self         Pointer to audio_frame_reader_t base
+ * @param[in]     frame_num    First frame to read (0-based)
+ * @param[in,out] frame_count  Input: maximum frames; Output: frames returned
+ *                             (at most DSD_READ_FRAMES_MAX)
+ * @param[out]    frames       Receives one descriptor per frame
+ *
+ * @return SACD_DSD_READER_OK (0) on success, or error code:
+ *         - SACD_DSD_READER_MEMORY_ALLOCATION_ERROR: Failed to allocate buffers
+ *         - SACD_DSD_READER_IO_ERROR: Reached end of Track Area
+ */
+static inline int dsd_audio_fixed_read_frames(const fixed_read_state_t *state,
+                                              sacd_frame_reader_t *self,
+                                              uint32_t frame_num,
+                                              uint32_t *frame_count,
+                                              sacd_frame_ref_t *frames)
+{
+    const fixed_read_state_t *last;
+    sa_buffer_ref_t *out;
+    uint8_t *sectors;
+    uint32_t count, first_sector, last_sector, num_sectors, num_sectors_read = 0;
+    uint32_t frame_length = 0;
+    uint32_t i;
+    int j;
+
+    if (!frame_count || !frames || *frame_count == 0)
+        return SACD_DSD_READER_IO_ERROR;
+
+    count = *frame_count < DSD_READ_FRAMES_MAX ? *frame_count : DSD_READ_FRAMES_MAX;
+    *frame_count = 0;
+
+    for (j = 0; j < state[0].sector_count; j++)
+        frame_length += (uint32_t)state[0].state[j].length;
+
+    /* Sector run from the first sector of the first frame to the last
+     * sector of the last one; trim frames that run past the Track Area */
+    first_sector = self->start_sector + (frame_num / 3) * state[frame_num % 3].sector_mul +
+                   state[frame_num % 3].sector_addition;
+    for (;;)
+    {
+        uint32_t last_frame = frame_num + count - 1;
+
+        last = &state[last_frame % 3];
+        last_sector = self->start_sector + (last_frame / 3) * last->sector_mul +
+                      last->sector_addition + last->sector_count - 1;
+        if (last_sector <= self->end_sector)
+            break;
+        if (--count == 0)
+            return SACD_DSD_READER_IO_ERROR;
+    }
+    num_sectors = last_sector - first_sector + 1;
+
+    sectors = (uint8_t *)sa_malloc((size_t)num_sectors * self->sector_size);
+    out = sa_buffer_alloc((size_t)count * frame_length);
+    if (!sectors || !out)
+    {
+        sa_free(sectors);
+        sa_buffer_unref(&out);
+        return SACD_DSD_READER_MEMORY_ALLOCATION_ERROR;
+    }
+
+    sacd_input_read_sectors(self->input, first_sector, num_sectors, sectors, &num_sectors_read);
+    if (num_sectors_read != num_sectors)
+    {
+        sa_free(sectors);
+        sa_buffer_unref(&out);
+        return SACD_DSD_READER_IO_ERROR;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        uint32_t frame = frame_num + i;
+        const fixed_read_state_t *pos = &state[frame % 3];
+        uint32_t sector = (frame / 3) * pos->sector_mul + pos->sector_addition +
+                          self->start_sector - first_sector;
+        uint8_t *dst = out->data + (size_t)i * frame_length;
+        uint32_t length = 0;
+
+        for (j = 0; j < pos->sector_count; j++)
+        {
+            memcpy(dst + length,
+                   sectors + (size_t)(sector + (uint32_t)j) * self->sector_size +
+                       self->header_size + pos->state[j].offset,
+                   pos->state[j].length);
+            length += (uint32_t)pos->state[j].length;
+        }
+
+        frames[i].data = dst;
+        frames[i].size = length;
+        frames[i].frame_nr = frame;
+        frames[i].buf = sa_buffer_ref(out);
+        if (!frames[i].buf)
+        {
+            sacd_release_sound_frames(frames, i);
+            sa_free(sectors);
+            sa_buffer_unref(&out);
+            return SACD_DSD_READER_MEMORY_ALLOCATION_ERROR;
+        }
+    }
+
+    sa_free(sectors);
+    sa_buffer_unref(&out);
+
+    *frame_count = count;
+    return SACD_DSD_READER_OK;
+}
+
 /**
  * @brief Sector layout pattern table for 3-in-14 fixed DSD format.
  *
@@ -314,6 +435,16 @@ static int dsd_audio_fixed14_read_frame(sacd_frame_reader_t *self,
     return dsd_audio_fixed_read_frame(rdstate_3_in_14, self, p_data, length, frame_num, frame_lsn, data_type);
 }
 
+static int dsd_audio_fixed14_read_frames(sacd_frame_reader_t *self,
+                                         uint32_t frame_num,
+                                         uint32_t frame_lsn,
+                                         uint32_t *frame_count,
+                                         sacd_frame_ref_t *frames)
+{
+    (void)frame_lsn;
+    return dsd_audio_fixed_read_frames(rdstate_3_in_14, self, frame_num, frame_count, frames);
+}
+
 static int dsd_audio_fixed14_get_sector(
     sacd_frame_reader_t *self, uint32_t frame, uint32_t frame_lsn, uint32_t *start_sector_nr,
     int *sector_count)
@@ -325,7 +456,8 @@ static const sacd_frame_reader_ops_t dsd_reader_fixed14_ops = {
     .init              = dsd_reader_fixed14_init,
     .destroy           = dsd_reader_fixed14_destroy,
     .get_sector        = dsd_audio_fixed14_get_sector,
-    .read_frame        = dsd_audio_fixed14_read_frame
+    .read_frame        = dsd_audio_fixed14_read_frame,
+    .read_frames       = dsd_audio_fixed14_read_frames
 };
 
 int sacd_frame_reader_fixed14_create(sacd_frame_reader_t **out)
@@ -441,6 +573,16 @@ static int dsd_audio_fixed16_read_frame(sacd_frame_reader_t *self,
     return dsd_audio_fixed_read_frame(rdstate_3_in_16, self, p_data, length, frame_num, frame_lsn, data_type);
 }
 
+static int dsd_audio_fixed16_read_frames(sacd_frame_reader_t *self,
+                                         uint32_t frame_num,
+                                         uint32_t frame_lsn,
+                                         uint32_t *frame_count,
+                                         sacd_frame_ref_t *frames)
+{
+    (void)frame_lsn;
+    return dsd_audio_fixed_read_frames(rdstate_3_in_16, self, frame_num, frame_count, frames);
+}
+
 static int dsd_audio_fixed16_get_sector(
     sacd_frame_reader_t *self, uint32_t frame, uint32_t frame_lsn, uint32_t *start_sector_nr,
     int *sector_count)
@@ -452,7 +594,8 @@ static const sacd_frame_reader_ops_t dsd_reader_fixed16_ops = {
     .init              = dsd_reader_fixed16_init,
     .destroy           = dsd_reader_fixed16_destroy,
     .get_sector        = dsd_audio_fixed16_get_sector,
-    .read_frame        = dsd_audio_fixed16_read_frame
+    .read_frame        = dsd_audio_fixed16_read_frame,
+    .read_frames       = dsd_audio_fixed16_read_frames
 };
 
 int sacd_frame_reader_fixed16_create(sacd_frame_reader_t **out)
@@ -8,10 +8,15 @@
  * Scarlet Book specification for SACD audio frame and sector structures.
  * Key implementation details:
  * - Virtual method pattern for polymorphic audio data access
- * - Sector-based reading with dynamic memory allocation
+ * - Sector-based reading through an aligned read-ahead chunk, so frame
+ *   searches and sequential reads issue one input request per chunk
  * - Frame location using time codes and packet headers
  * - Support for variable sector sizes (2048-2064 bytes)
  * - Multi-sector frame handling (1-16 sectors per frame)
+ * - Frame index (frame -> LSN, sector count), shared by the readers of all
+ *   clones of the Area TOC and filled in as frames are parsed,
+ *   built by a full scan on request and persisted as a sidecar file, so that
+ *   seeks to an indexed frame cost a single read
  * @note Decryption handling:
  * Sector decryption is performed ONLY in the DST reader, not in DSD 14/16 readers.
  * This is because DST-coded audio requires sector-level decryption before the
@@ -39,8 +44,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdatomic.h>
 #include <libsautil/mem.h>
 #include <libsautil/bswap.h>
+#include <libsautil/buffer.h>
 
 #include <libsautil/sastring.h>
 #include <libsautil/compat.h>
@@ -88,6 +95,63 @@
  */
 #define AUDIO_FRAME_INFO_SIZE_DSD 3
 
+/**
+ * @brief Sectors per read-ahead chunk.
+ *
+ * Chunks start on a multiple of this value (unless a frame would straddle
+ * the chunk end) and are decrypted once when loaded.
+ */
+#define DST_CHUNK_SECTORS 64
+
+/**
+ * @brief Slack after the data of a run buffer.
+ *
+ * Frames returned by dst_reader_read_frames() go straight to the DST
+ * decoder, whose bitstream reader may read up to this many bytes past the
+ * end of its input (SA_INPUT_BUFFER_PADDING_SIZE).
+ */
+#define DST_RUN_PADDING 64
+
+/**
+ * @brief Frame index sidecar file layout
+ *
+ * Header (little-endian): magic "SDIX", version, first and last sector of
+ * the Track Area, frame count, then the disc's sector count and an FNV-1a
+ * hash of its first Master TOC sector, which tie the file to one disc.
+ * Followed by two bytes per frame: the LSN delta to the previous frame
+ * start (the first frame is relative to the Track Area start) and the
+ * sector count of the frame.
+ */
+#define DST_INDEX_MAGIC       "SDIX"
+#define DST_INDEX_VERSION     2
+#define DST_INDEX_HEADER_SIZE 28
+
+/**
+ * @brief Frame index entry layout
+ *
+ * Each entry packs the LSN where the frame starts (low 24 bits; Track Area
+ * LSNs stay far below 2^24) with the number of sectors it spans (high 8
+ * bits). The offset of the frame within its first sector is not kept: it is
+ * found again by parsing the packet headers of that sector, which the read
+ * has to do anyway. Zero marks a frame that has not been seen yet.
+ */
+#define DST_INDEX_LSN_MASK     0x00FFFFFFu
+#define DST_INDEX_SECTOR_SHIFT 24
+
+/**
+ * @brief Frame index of a Track Area
+ *
+ * Owned by the Area TOC and shared with the readers of all its clones, so a
+ * frame located by any of them is a direct seek for the others. Entries
+ * only ever go from unknown to known, which lets readers on different
+ * threads fill in the index without a lock.
+ */
+struct sacd_dst_index_s {
+    atomic_uint *entries;                  /**< One packed entry per frame */
+    uint32_t frame_count;                  /**< Number of entries (frames in the area) */
+    atomic_uint known;                     /**< Entries filled in so far */
+};
+
 /**
  * @struct sacd_frame_reader_dst_t
  * @brief Extended structure for DST frame reading.
@@ -97,9 +161,17 @@
  */
 typedef struct sacd_frame_reader_dst {
     sacd_frame_reader_t base;              /**< Base structure (must be first!) */
-    uint8_t *sector_buffer;                /**< Buffer for reading sectors */
+    uint8_t *sector_buffer;                /**< Buffer for reads outside the Track Area */
     uint32_t buffer_sector_count;          /**< Number of sectors in buffer */
 
+    /* Read-ahead chunk (decrypted sectors of the Track Area) */
+    uint8_t *chunk_buffer;                 /**< DST_CHUNK_SECTORS sectors */
+    uint32_t chunk_start;                  /**< LSN of the first sector in the chunk */
+    uint32_t chunk_count;                  /**< Valid sectors in the chunk (0 = empty) */
+
+    /* Buffers handed out by read_frames (DST_CHUNK_SECTORS sectors each) */
+    sa_buffer_pool_t *run_pool;
+
     area_toc_t *area;
 
     /* Position tracking for sequential reads */
@@ -199,6 +271,227 @@ static inline int parse_audio_sector_header(const uint8_t *sector_data,
     return 0;
 }
 
+/**
+ * @brief Get decrypted sectors, served from the read-ahead chunk.
+ *
+ * Unencrypted inputs that can expose their data in memory (mapped files)
+ * are used in place. Otherwise sectors inside the Track Area are loaded
+ * DST_CHUNK_SECTORS at a time into the chunk buffer and decrypted once. When the requested range is not in
+ * the chunk, a new chunk is loaded: aligned if the range fits in the aligned
+ * chunk, otherwise starting at @p lsn. If the chunk buffer could not be
+ * allocated, up to MAX_DST_SECTORS are read and decrypted in the sector
+ * buffer instead. Sectors outside the Track Area are read directly and not
+ * decrypted.
+ *
+ * @param[in,out] dst          DST reader context
+ * @param[in]     lsn          First sector wanted
+ * @param[in]     count        Sectors wanted (at most MAX_DST_SECTORS outside
+ *                             the Track Area, DST_CHUNK_SECTORS inside)
+ * @param[out]    out          Receives a pointer to the first sector
+ * @param[out]    sectors_read Receives the number of sectors available at
+ *                             @p out (fewer than @p count at the area end)
+ *
+ * @return SACD_DST_READER_OK on success, or error code
+ */
+static dst_reader_state_t dst_fetch_sectors(sacd_frame_reader_dst_t *dst,
+                                            uint32_t lsn, uint32_t count,
+                                            const uint8_t **out,
+                                            uint32_t *sectors_read)
+{
+    sacd_frame_reader_t *self = &dst->base;
+    size_t sector_size = (size_t)self->sector_size;
+    uint32_t start, n, got = 0;
+
+    if (count == 0) {
+        count = 1;
+    }
+
+    /* Outside the Track Area: plain read, no decryption */
+    if (lsn < self->start_sector || lsn > self->end_sector) {
+        if (count > MAX_DST_SECTORS) {
+            count = MAX_DST_SECTORS;
+        }
+        if (sacd_input_read_sectors(self->input, lsn, count, dst->sector_buffer, &got) != 0 ||
+            got == 0) {
+            return SACD_DST_READER_IO_ERROR;
+        }
+        *out = dst->sector_buffer;
+        *sectors_read = got;
+        return SACD_DST_READER_OK;
+    }
+
+    if (count > DST_CHUNK_SECTORS) {
+        count = DST_CHUNK_SECTORS;
+    }
+
+    /* Memory-resident, unencrypted input: point straight into it */
+    if (!(self->input->ops && self->input->ops->decrypt)) {
+        uint32_t limit = self->end_sector - lsn + 1;
+        if (sacd_input_get_sector_ptr(self->input, lsn, count < limit ? count : limit,
+                                      out, &got) == SACD_INPUT_OK) {
+            *sectors_read = got;
+            return SACD_DST_READER_OK;
+        }
+    }
+
+    /* No chunk buffer: read just these sectors, still decrypted */
+    if (!dst->chunk_buffer) {
+        n = self->end_sector - lsn + 1;
+        if (n > MAX_DST_SECTORS) {
+            n = MAX_DST_SECTORS;
+        }
+        if (n > count) {
+            n = count;
+        }
+        if (sacd_input_read_sectors(self->input, lsn, n, dst->sector_buffer, &got) != 0 ||
+            got == 0) {
+            return SACD_DST_READER_IO_ERROR;
+        }
+        if (self->input->ops && self->input->ops->decrypt &&
+            self->input->ops->decrypt(self->input, dst->sector_buffer, got) != SACD_INPUT_OK) {
+            return SACD_DST_READER_IO_ERROR;
+        }
+        *out = dst->sector_buffer;
+        *sectors_read = got;
+        return SACD_DST_READER_OK;
+    }
+
+    if (dst->chunk_count == 0 || lsn < dst->chunk_start ||
+        lsn + count > dst->chunk_start + dst->chunk_count) {
+        /* Does the wanted range end within the chunk already loaded? Then
+         * the chunk is simply short (area end), no reload needed. */
+        bool at_area_end = dst->chunk_count > 0 && lsn >= dst->chunk_start &&
+                           lsn < dst->chunk_start + dst->chunk_count &&
+                           dst->chunk_start + dst->chunk_count > self->end_sector;
+
+        if (!at_area_end) {
+            start = lsn - (lsn % DST_CHUNK_SECTORS);
+            if (start < self->start_sector || lsn + count > start + DST_CHUNK_SECTORS) {
+                start = lsn;
+            }
+            n = self->end_sector - start + 1;
+            if (n > DST_CHUNK_SECTORS) {
+                n = DST_CHUNK_SECTORS;
+            }
+
+            dst->chunk_count = 0;
+            if (sacd_input_read_sectors(self->input, start, n, dst->chunk_buffer, &got) != 0 ||
+                got == 0) {
+                return SACD_DST_READER_IO_ERROR;
+            }
+
+            /*
+             * Decryption is only performed in the DST reader (not DSD 14/16)
+             * because DST data must be decrypted at the sector level before
+             * parsing packet headers.
+             */
+            if (self->input->ops && self->input->ops->decrypt &&
+                self->input->ops->decrypt(self->input, dst->chunk_buffer, got) != SACD_INPUT_OK) {
+                return SACD_DST_READER_IO_ERROR;
+            }
+
+            dst->chunk_start = start;
+            dst->chunk_count = got;
+            DST_DEBUG("dst_fetch_sectors: loaded chunk [%u, %u)", start, start + got);
+
+            if (lsn >= start + got) {
+                return SACD_DST_READER_IO_ERROR;
+            }
+        }
+    }
+
+    n = dst->chunk_start + dst->chunk_count - lsn;
+    *out = dst->chunk_buffer + (size_t)(lsn - dst->chunk_start) * sector_size;
+    *sectors_read = (n < count) ? n : count;
+    return SACD_DST_READER_OK;
+}
+
+/**
+ * @brief Record the start of a frame in the frame index.
+ *
+ * @param[in,out] dst      DST reader context
+ * @param[in]     frame    Frame number (from the frame time code)
+ * @param[in]     lsn      Sector holding the frame's first audio packet
+ * @param[in]     sectors  Sectors the frame spans (from frame_info)
+ */
+static void dst_index_record(sacd_frame_reader_dst_t *dst, uint32_t frame,
+                             uint32_t lsn, int sectors)
+{
+    sacd_dst_index_t *index = dst->area ? dst->area->dst_index : NULL;
+    uint32_t entry;
+
+    if (!index || frame >= index->frame_count || lsn == 0 || lsn > DST_INDEX_LSN_MASK) {
+        return;
+    }
+
+    entry = lsn | ((uint32_t)(sectors > 0 ? sectors : 1) << DST_INDEX_SECTOR_SHIFT);
+    if (atomic_exchange_explicit(&index->entries[frame], entry, memory_order_relaxed) == 0) {
+        atomic_fetch_add_explicit(&index->known, 1, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Look up a frame in the frame index.
+ *
+ * @return true if the frame has been indexed
+ */
+static bool dst_index_lookup(const sacd_frame_reader_dst_t *dst, uint32_t frame,
+                             uint32_t *lsn, int *sectors)
+{
+    const sacd_dst_index_t *index = dst->area ? dst->area->dst_index : NULL;
+    uint32_t entry;
+
+    if (!index || frame >= index->frame_count) {
+        return false;
+    }
+
+    entry = (uint32_t)atomic_load_explicit(&index->entries[frame], memory_order_relaxed);
+    if (entry == 0) {
+        return false;
+    }
+
+    *lsn = entry & DST_INDEX_LSN_MASK;
+    *sectors = (int)(entry >> DST_INDEX_SECTOR_SHIFT);
+    return true;
+}
+
+/**
+ * @brief Drop a frame from the frame index.
+ */
+static void dst_index_forget(sacd_frame_reader_dst_t *dst, uint32_t frame)
+{
+    sacd_dst_index_t *index = dst->area ? dst->area->dst_index : NULL;
+
+    if (!index || frame >= index->frame_count) {
+        return;
+    }
+    if (atomic_exchange_explicit(&index->entries[frame], 0, memory_order_relaxed) != 0) {
+        atomic_fetch_sub_explicit(&index->known, 1, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Record every frame that starts in an already parsed sector.
+ */
+static void dst_index_record_sector(sacd_frame_reader_dst_t *dst,
+                                    const parsed_audio_sector_t *parsed,
+                                    uint32_t lsn)
+{
+    int frame_info_idx = 0;
+
+    for (int i = 0; i < parsed->sector.packet_count; i++) {
+        if (parsed->sector.packet_info[i].data_type == DATA_TYPE_AUDIO &&
+            parsed->sector.packet_info[i].frame_start) {
+            if (frame_info_idx >= parsed->sector.frame_start_count) {
+                break;
+            }
+            dst_index_record(dst, time_to_frame(parsed->frames[frame_info_idx].time_code),
+                             lsn, parsed->frames[frame_info_idx].sector_count);
+            frame_info_idx++;
+        }
+    }
+}
+
 /**
  * @brief Find the LSN of a specific DST frame by scanning sectors.
  *
@@ -246,26 +539,15 @@ static dst_reader_state_t find_dst_frame(sacd_frame_reader_t *self,
     }
 
     for (lsn = from_lsn; lsn <= to_lsn; lsn++) {
-        /* Read one sector using sector_size from base */
-        if (sacd_input_read_sectors(self->input, lsn, 1, dst->sector_buffer, &sectors_read) != 0
-            || sectors_read != 1) {
-            return SACD_DST_READER_IO_ERROR;
-        }
+        const uint8_t *sector_raw;
 
-        /*
-         * Decrypt sector if within encrypted range and decrypt function is available.
-         * Note: Decryption is only performed in the DST reader (not DSD 14/16) because
-         * DST data must be decrypted at the sector level before parsing packet headers.
-         */
-        if (self->input->ops && self->input->ops->decrypt &&
-            lsn >= self->start_sector && lsn <= self->end_sector) {
-            if (self->input->ops->decrypt(self->input, dst->sector_buffer, 1) != SACD_INPUT_OK) {
-                return SACD_DST_READER_IO_ERROR;
-            }
+        /* One sector, served from the read-ahead chunk */
+        if (dst_fetch_sectors(dst, lsn, 1, &sector_raw, &sectors_read) != SACD_DST_READER_OK) {
+            return SACD_DST_READER_IO_ERROR;
         }
 
         /* Skip header bytes to get to SACD audio data (2048 bytes) */
-        uint8_t *sector_data = dst->sector_buffer + self->header_size;
+        const uint8_t *sector_data = sector_raw + self->header_size;
 
         /* Check if we need to parse a new audio sector header */
         if (packet_idx >= current_packet_count) {
@@ -277,6 +559,9 @@ static dst_reader_state_t find_dst_frame(sacd_frame_reader_t *self,
             packet_idx = 0;
             frame_info_idx = 0;
             current_packet_count = parsed.sector.packet_count;
+
+            /* Remember every frame start passed on the way */
+            dst_index_record_sector(dst, &parsed, lsn);
         }
 
         /* Process packets in this sector */
@@ -319,6 +604,34 @@ static dst_reader_state_t find_dst_frame(sacd_frame_reader_t *self,
     return SACD_DST_READER_FRAME_NOT_FOUND;
 }
 
+/**
+ * @brief Check that a frame starts in a sector.
+ *
+ * Index entries can come from a sidecar file, so a hit is confirmed against
+ * the sector's frame headers before it is used.
+ */
+static bool dst_sector_starts_frame(sacd_frame_reader_dst_t *dst, uint32_t lsn,
+                                    uint32_t frame)
+{
+    parsed_audio_sector_t parsed;
+    const uint8_t *sector;
+    uint32_t sectors_read;
+    uint32_t data_offset;
+
+    if (lsn < dst->base.start_sector || lsn > dst->base.end_sector ||
+        dst_fetch_sectors(dst, lsn, 1, &sector, &sectors_read) != SACD_DST_READER_OK ||
+        parse_audio_sector_header(sector + dst->base.header_size, &parsed, &data_offset) != 0) {
+        return false;
+    }
+
+    for (int i = 0; i < parsed.sector.frame_start_count; i++) {
+        if (time_to_frame(parsed.frames[i].time_code) == frame) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * @brief Seek to a specific frame using the access list for fast positioning.
  *
@@ -342,6 +655,7 @@ static dst_reader_state_t dst_sector_seek(sacd_frame_reader_t *self,
                                           int *sector_count)
 {
     uint32_t from_lsn, to_lsn;
+    int indexed_sectors;
     dst_reader_state_t result;
     sacd_frame_reader_dst_t *dst = (sacd_frame_reader_dst_t *)self;
 
@@ -349,6 +663,19 @@ static dst_reader_state_t dst_sector_seek(sacd_frame_reader_t *self,
         return SACD_DST_READER_INVALID_ARG;
     }
 
+    /* Indexed frame: no search needed once its sector confirms it */
+    if (dst_index_lookup(dst, frame, found_lsn, &indexed_sectors)) {
+        if (dst_sector_starts_frame(dst, *found_lsn, frame)) {
+            if (sector_count) {
+                *sector_count = indexed_sectors;
+            }
+            DST_DEBUG("dst_sector_seek: index hit frame=%u at lsn=%u", frame, *found_lsn);
+            return SACD_DST_READER_OK;
+        }
+        DST_DEBUG("dst_sector_seek: stale index entry frame=%u at lsn=%u", frame, *found_lsn);
+        dst_index_forget(dst, frame);
+    }
+
     /* Use access list to calculate search range */
     DST_DEBUG("dst_sector_seek: area=%p, area->frame_info.step_size=%u, area->frame_info.num_entries=%u",
               (void*)dst->area, dst->area->frame_info.step_size, dst->area->frame_info.num_entries);
@@ -380,6 +707,40 @@ static dst_reader_state_t dst_sector_seek(sacd_frame_reader_t *self,
     return result;
 }
 
+/**
+ * @brief Find the sector where a frame starts, preferring the cached position.
+ *
+ * For sequential reads (frame N+1 after reading frame N) the previous read
+ * already saw where the next frame starts, which skips the
+ * find_dst_frame() sector-by-sector scan.
+ *
+ * @param[in,out] dst           DST reader context
+ * @param[in]     frame_num     Frame to locate
+ * @param[out]    found_lsn     Receives the LSN where the frame starts
+ * @param[out]    sector_count  Receives the sectors the frame spans
+ *                              (MAX_DST_SECTORS when only parsing can tell)
+ *
+ * @return SACD_DST_READER_OK on success, or error code
+ */
+static dst_reader_state_t dst_locate_frame(sacd_frame_reader_dst_t *dst,
+                                           uint32_t frame_num,
+                                           uint32_t *found_lsn,
+                                           int *sector_count)
+{
+    if (dst->position_valid && dst->next_frame_known &&
+        frame_num == dst->cached_frame_num + 1) {
+        /* Sequential read - use cached position, skip the scan */
+        DST_DEBUG("dst_locate_frame: SEQUENTIAL read, using cached_lsn=%u", dst->cached_frame_lsn);
+        *found_lsn = dst->cached_frame_lsn;
+        *sector_count = MAX_DST_SECTORS;  /* Parsing determines actual boundary */
+        return SACD_DST_READER_OK;
+    }
+
+    /* Random access or first read - use access list for fast seeking */
+    DST_DEBUG("dst_locate_frame: RANDOM access, seeking via access list");
+    return dst_sector_seek(&dst->base, frame_num, found_lsn, sector_count);
+}
+
 /**
  * @brief Initializes a DST reader context.
  *
@@ -405,6 +766,15 @@ static void dst_reader_init(sacd_frame_reader_t *self)
 
     dst->buffer_sector_count = 0;
 
+    /* Read-ahead chunk; without it reads fall back to sector_buffer */
+    dst->chunk_buffer = (uint8_t *)sa_malloc((size_t)DST_CHUNK_SECTORS * (size_t)self->sector_size);
+    dst->chunk_start = 0;
+    dst->chunk_count = 0;
+
+    /* Runs for read_frames; without the pool only read_frame works */
+    dst->run_pool = sa_buffer_pool_init((size_t)DST_CHUNK_SECTORS * (size_t)self->sector_size +
+                                        DST_RUN_PADDING, NULL);
+
     /* Initialize position tracking */
     dst->cached_frame_num = 0;
     dst->cached_frame_lsn = 0;
@@ -423,6 +793,9 @@ static void dst_reader_destroy(sacd_frame_reader_t *self)
         sacd_frame_reader_dst_t *dst = (sacd_frame_reader_dst_t *)self;
         sa_free(dst->sector_buffer);
         dst->sector_buffer = NULL;
+        sa_free(dst->chunk_buffer);
+        /* Frames still held by callers keep their buffers until released */
+        sa_buffer_pool_uninit(&dst->run_pool);
         sa_free(self);
     }
 }
@@ -464,6 +837,7 @@ static int dst_reader_read_frame(sacd_frame_reader_t *self, uint8_t *data,
     uint32_t found_lsn = 0;
     dst_reader_state_t seek_result;
     uint32_t sectors_read;
+    const uint8_t *frame_sectors;
     int i;
     bool frame_started = false;
     bool frame_complete = false;
@@ -489,24 +863,7 @@ static int dst_reader_read_frame(sacd_frame_reader_t *self, uint8_t *data,
         return SACD_DST_READER_MEMORY_ALLOCATION_ERROR;
     }
 
-    /*
-     * Optimization: For sequential reads (frame N+1 after reading frame N),
-     * we already know where the next frame starts from parsing the previous frame.
-     * This skips the expensive find_dst_frame() sector-by-sector scan.
-     */
-    if (dst->position_valid && dst->next_frame_known &&
-        frame_num == dst->cached_frame_num + 1) {
-        /* Sequential read - use cached position, skip the scan */
-        DST_DEBUG("dst_reader_read_frame: SEQUENTIAL read, using cached_lsn=%u", dst->cached_frame_lsn);
-        found_lsn = dst->cached_frame_lsn;
-        frame_sector_count = MAX_DST_SECTORS;  /* Parsing determines actual boundary */
-        seek_result = SACD_DST_READER_OK;
-    } else {
-        /* Random access or first read - use access list for fast seeking */
-        DST_DEBUG("dst_reader_read_frame: RANDOM access, seeking via access list");
-        seek_result = dst_sector_seek(self, frame_num, &found_lsn, &frame_sector_count);
-    }
-
+    seek_result = dst_locate_frame(dst, frame_num, &found_lsn, &frame_sector_count);
     if (seek_result != SACD_DST_READER_OK) {
         DST_DEBUG("dst_reader_read_frame: seek FAILED with result=%d", seek_result);
         dst->position_valid = false;
@@ -520,27 +877,13 @@ static int dst_reader_read_frame(sacd_frame_reader_t *self, uint8_t *data,
         frame_sector_count = MAX_DST_SECTORS;
     }
 
-    /* Read the sectors containing the frame */
-    if (sacd_input_read_sectors(self->input, found_lsn, (uint32_t)frame_sector_count,
-                                 dst->sector_buffer, &sectors_read) != 0) {
+    /* Get the sectors containing the frame (usually already in the chunk) */
+    if (dst_fetch_sectors(dst, found_lsn, (uint32_t)frame_sector_count,
+                          &frame_sectors, &sectors_read) != SACD_DST_READER_OK) {
         dst->position_valid = false;
         return SACD_DST_READER_IO_ERROR;
     }
 
-    /*
-     * Decrypt sectors if within encrypted range and decrypt function is available.
-     * Note: Decryption is only performed in the DST reader (not DSD 14/16) because
-     * DST data must be decrypted at the sector level before parsing packet headers.
-     */
-    if (self->input->ops && self->input->ops->decrypt &&
-        found_lsn >= self->start_sector &&
-        found_lsn + sectors_read - 1 <= self->end_sector) {
-        if (self->input->ops->decrypt(self->input, dst->sector_buffer, sectors_read) != SACD_INPUT_OK) {
-            dst->position_valid = false;
-            return SACD_DST_READER_IO_ERROR;
-        }
-    }
-
     /*
      * Process each sector to extract frame data.
      * DST frames track completion via sector_count (from frame_info).
@@ -554,8 +897,8 @@ static int dst_reader_read_frame(sacd_frame_reader_t *self, uint8_t *data,
 
     for (uint32_t sector_idx = 0; sector_idx < sectors_read && !frame_complete; sector_idx++) {
         /* Calculate sector offset using sector_size, skip header_size to get to SACD data */
-        uint8_t *sector_data = dst->sector_buffer + (sector_idx * (uint32_t)self->sector_size) + self->header_size;
-        uint8_t *packet_data;
+        const uint8_t *sector_data = frame_sectors + (sector_idx * (uint32_t)self->sector_size) + self->header_size;
+        const uint8_t *packet_data;
 
         /* Parse the sector header (operates on SACD_LSN_SIZE bytes after header) */
         if (parse_audio_sector_header(sector_data, &parsed, &data_offset) != 0) {
@@ -572,6 +915,8 @@ static int dst_reader_read_frame(sacd_frame_reader_t *self, uint8_t *data,
         frame_info_idx = 0;
         sector_had_audio = false;
 
+        dst_index_record_sector(dst, &parsed, found_lsn + sector_idx);
+
         /* Process packets in this sector */
         for (i = 0; i < parsed.sector.packet_count && !frame_complete; i++) {
             uint16_t pkt_data_type = parsed.sector.packet_info[i].data_type;
@@ -663,10 +1008,278 @@ static int dst_reader_read_frame(sacd_frame_reader_t *self, uint8_t *data,
 
     DST_DEBUG("dst_reader_read_frame: DONE frame_started=%d, output_length=%u", frame_started, output_length);
 
+    if (!frame_started) {
+        /* The located sectors do not hold the frame */
+        dst->position_valid = false;
+        return SACD_DST_READER_FRAME_NOT_FOUND;
+    }
+
     *length = output_length;
     return SACD_DST_READER_OK;
 }
 
+/**
+ * @brief Frame assembly state for dst_reader_read_frames().
+ *
+ * A frame is tracked as a single span into the run while its packets are
+ * contiguous. The first discontiguous packet (a sector boundary, or another
+ * packet type in between) moves it to the reassembly buffer.
+ */
+typedef struct {
+    sacd_frame_reader_dst_t *dst;
+    sa_buffer_ref_t *run;          /**< Sectors read for this call */
+    sa_buffer_ref_t *assembly;     /**< Reassembled frames, allocated on demand */
+    size_t assembly_pos;           /**< Bytes used in @p assembly */
+    size_t frame_start;            /**< Offset of the current frame in @p assembly */
+    const uint8_t *span;           /**< Current frame while still in place */
+    uint32_t span_length;
+    bool reassembled;              /**< Current frame lives in @p assembly */
+    uint32_t frame_num;            /**< Current frame number */
+    uint32_t frame_lsn;            /**< Sector where the current frame starts */
+    uint32_t last_lsn;             /**< Sector where the last returned frame starts */
+    uint32_t found;                /**< Frames returned so far */
+} dst_run_t;
+
+static dst_reader_state_t dst_run_add_packet(dst_run_t *run, const uint8_t *packet,
+                                             uint32_t length)
+{
+    if (!run->reassembled) {
+        if (run->span_length == 0) {
+            run->span = packet;
+            run->span_length = length;
+            return SACD_DST_READER_OK;
+        }
+        if (run->span + run->span_length == packet) {
+            run->span_length += length;
+            return SACD_DST_READER_OK;
+        }
+
+        /* Frame crosses a sector: move what we have so far */
+        if (!run->assembly) {
+            run->assembly = sa_buffer_pool_get(run->dst->run_pool);
+            if (!run->assembly) {
+                return SACD_DST_READER_MEMORY_ALLOCATION_ERROR;
+            }
+        }
+        run->frame_start = run->assembly_pos;
+        memcpy(run->assembly->data + run->assembly_pos, run->span, run->span_length);
+        run->assembly_pos += run->span_length;
+        run->reassembled = true;
+    }
+
+    /* Cannot overflow: a run holds no more payload than sectors read */
+    memcpy(run->assembly->data + run->assembly_pos, packet, length);
+    run->assembly_pos += length;
+    return SACD_DST_READER_OK;
+}
+
+static dst_reader_state_t dst_run_emit(dst_run_t *run, sacd_frame_ref_t *frames)
+{
+    sacd_frame_ref_t *frame = &frames[run->found];
+    const sa_buffer_ref_t *owner = run->reassembled ? run->assembly : run->run;
+
+    frame->frame_nr = run->frame_num;
+    if (run->reassembled) {
+        frame->data = run->assembly->data + run->frame_start;
+        frame->size = (uint32_t)(run->assembly_pos - run->frame_start);
+    } else {
+        frame->data = run->span;
+        frame->size = run->span_length;
+    }
+    frame->buf = sa_buffer_ref(owner);
+
+    run->span = NULL;
+    run->span_length = 0;
+    run->reassembled = false;
+    if (!frame->buf) {
+        return SACD_DST_READER_MEMORY_ALLOCATION_ERROR;
+    }
+
+    run->last_lsn = run->frame_lsn;
+    run->frame_num++;
+    run->found++;
+    return SACD_DST_READER_OK;
+}
+
+/**
+ * @brief Reads consecutive DST frames without copying them (virtual method implementation).
+ *
+ * Reads up to DST_CHUNK_SECTORS sectors starting at the first frame into a
+ * pooled buffer, decrypts them once and walks the packets like
+ * dst_reader_read_frame(). Frames whose audio packets are contiguous point
+ * into that buffer; the others are gathered into a second pooled buffer.
+ * Only frames that end inside the run are returned; the sequential position
+ * cache is updated so the next call continues without a seek.
+ *
+ * @param[in]     self         Pointer to frame reader structure
+ * @param[in]     frame_num    First frame to read
+ * @param[in]     frame_lsn    Starting LSN for search (from Access List)
+ * @param[in,out] frame_count  Input: maximum frames; Output: frames returned
+ * @param[out]    frames       Receives one descriptor per frame
+ *
+ * @return SACD_DST_READER_OK or error code
+ */
+static int dst_reader_read_frames(sacd_frame_reader_t *self, uint32_t frame_num,
+                                  uint32_t frame_lsn, uint32_t *frame_count,
+                                  sacd_frame_ref_t *frames)
+{
+    sacd_frame_reader_dst_t *dst = (sacd_frame_reader_dst_t *)self;
+    dst_run_t run;
+    parsed_audio_sector_t parsed;
+    uint32_t data_offset;
+    uint32_t wanted;
+    uint32_t found_lsn = 0, next_frame_lsn = 0;
+    uint32_t sectors, sectors_read = 0;
+    int frame_sector_count = 0;
+    int remaining_sectors = 0;
+    bool in_frame = false;
+    bool done = false;
+    dst_reader_state_t result;
+
+    (void)frame_lsn;  /* Not used - access list provides seeking info */
+
+    if (!self || !frame_count || !frames || *frame_count == 0) {
+        return SACD_DST_READER_INVALID_ARG;
+    }
+    wanted = *frame_count;
+    *frame_count = 0;
+
+    if (!dst->run_pool) {
+        return SACD_DST_READER_MEMORY_ALLOCATION_ERROR;
+    }
+
+    result = dst_locate_frame(dst, frame_num, &found_lsn, &frame_sector_count);
+    if (result != SACD_DST_READER_OK) {
+        dst->position_valid = false;
+        return result;
+    }
+
+    /* Enough sectors for the frames wanted, capped at one run */
+    sectors = self->end_sector - found_lsn + 1;
+    if (sectors > DST_CHUNK_SECTORS) {
+        sectors = DST_CHUNK_SECTORS;
+    }
+    if (wanted < DST_CHUNK_SECTORS / MAX_DST_SECTORS &&
+        sectors > wanted * MAX_DST_SECTORS) {
+        sectors = wanted * MAX_DST_SECTORS;
+    }
+
+    memset(&run, 0, sizeof(run));
+    run.dst = dst;
+    run.frame_num = frame_num;
+    run.run = sa_buffer_pool_get(dst->run_pool);
+    if (!run.run) {
+        return SACD_DST_READER_MEMORY_ALLOCATION_ERROR;
+    }
+
+    if (sacd_input_read_sectors(self->input, found_lsn, sectors, run.run->data,
+                                &sectors_read) != 0 || sectors_read == 0 ||
+        (self->input->ops && self->input->ops->decrypt &&
+         self->input->ops->decrypt(self->input, run.run->data, sectors_read) != SACD_INPUT_OK)) {
+        sa_buffer_unref(&run.run);
+        dst->position_valid = false;
+        return SACD_DST_READER_IO_ERROR;
+    }
+
+    for (uint32_t sector_idx = 0; sector_idx < sectors_read && !done; sector_idx++) {
+        const uint8_t *sector_data = run.run->data + (size_t)sector_idx * (size_t)self->sector_size +
+                                     self->header_size;
+        const uint8_t *sector_end = sector_data + SACD_LSN_SIZE;
+        const uint8_t *packet_data;
+        int frame_info_idx = 0;
+        bool sector_had_audio = false;
+
+        if (parse_audio_sector_header(sector_data, &parsed, &data_offset) != 0) {
+            result = SACD_DST_READER_IO_ERROR;
+            break;
+        }
+        dst_index_record_sector(dst, &parsed, found_lsn + sector_idx);
+        packet_data = sector_data + data_offset;
+
+        for (int i = 0; i < parsed.sector.packet_count && !done; i++) {
+            uint16_t pkt_data_type = parsed.sector.packet_info[i].data_type;
+            uint16_t pkt_length = parsed.sector.packet_info[i].packet_length;
+
+            if (packet_data + pkt_length > sector_end) {
+                result = SACD_DST_READER_IO_ERROR;
+                done = true;
+                break;
+            }
+
+            if (pkt_data_type == DATA_TYPE_AUDIO && parsed.sector.packet_info[i].frame_start) {
+                const frame_info_t *info = &parsed.frames[frame_info_idx++];
+
+                if (in_frame) {
+                    /* Start of the next frame: the current one is complete */
+                    in_frame = false;
+                    result = dst_run_emit(&run, frames);
+                    next_frame_lsn = found_lsn + sector_idx;
+                    if (result != SACD_DST_READER_OK || run.found == wanted) {
+                        done = true;
+                        break;
+                    }
+                }
+
+                if (time_to_frame(info->time_code) == run.frame_num) {
+                    in_frame = true;
+                    run.frame_lsn = found_lsn + sector_idx;
+                    remaining_sectors = info->sector_count ? info->sector_count : 1;
+                } else if (run.found > 0) {
+                    /* Time codes out of sequence: stop at what we have */
+                    done = true;
+                    break;
+                }
+            }
+
+            if (in_frame && pkt_data_type == DATA_TYPE_AUDIO && pkt_length > 0) {
+                result = dst_run_add_packet(&run, packet_data, pkt_length);
+                if (result != SACD_DST_READER_OK) {
+                    done = true;
+                    break;
+                }
+                sector_had_audio = true;
+            }
+
+            packet_data += pkt_length;
+        }
+
+        /* For DST, the frame also ends once its sector count is used up */
+        if (!done && in_frame && parsed.sector.dst_coded && sector_had_audio &&
+            --remaining_sectors <= 0) {
+            in_frame = false;
+            result = dst_run_emit(&run, frames);
+            next_frame_lsn = found_lsn + sector_idx + 1;
+            done = (result != SACD_DST_READER_OK || run.found == wanted);
+        }
+    }
+
+    /* The last frame of the Track Area ends with the area */
+    if (result == SACD_DST_READER_OK && in_frame && !done &&
+        found_lsn + sectors_read > self->end_sector) {
+        result = dst_run_emit(&run, frames);
+        next_frame_lsn = 0;
+    }
+
+    sa_buffer_unref(&run.run);
+    sa_buffer_unref(&run.assembly);
+
+    /* Frames completed before a failure are still good; the next call
+     * starts at the failing frame and reports the error there */
+    if (run.found == 0) {
+        dst->position_valid = false;
+        return (result != SACD_DST_READER_OK) ? result : SACD_DST_READER_FRAME_NOT_FOUND;
+    }
+
+    /* Same rule as dst_reader_read_frame(): only cache a later sector */
+    dst->cached_frame_num = run.frame_num - 1;
+    dst->next_frame_known = (next_frame_lsn > 0 && next_frame_lsn > run.last_lsn);
+    dst->cached_frame_lsn = dst->next_frame_known ? next_frame_lsn : run.last_lsn;
+    dst->position_valid = true;
+
+    *frame_count = run.found;
+    return SACD_DST_READER_OK;
+}
+
 /**
  * @brief Determines the sector location and span of a specific frame.
  *
@@ -713,7 +1326,8 @@ static const sacd_frame_reader_ops_t dst_reader_ops = {
     .init              = dst_reader_init,
     .destroy           = dst_reader_destroy,
     .get_sector        = dst_reader_get_sector,
-    .read_frame        = dst_reader_read_frame
+    .read_frame        = dst_reader_read_frame,
+    .read_frames       = dst_reader_read_frames
 };
 
 int sacd_frame_reader_dst_create(sacd_frame_reader_t **out, struct area_toc_s *area)
@@ -739,3 +1353,301 @@ int sacd_frame_reader_dst_create(sacd_frame_reader_t **out, struct area_toc_s *a
     *out = (sacd_frame_reader_t *)self;
     return SACD_FRAME_READER_OK;
 }
+
+/* ========================================================================
+ * Frame Index
+ * ======================================================================== */
+
+sacd_dst_index_t *sacd_dst_index_create(uint32_t frame_count)
+{
+    sacd_dst_index_t *index;
+
+    if (frame_count == 0) {
+        return NULL;
+    }
+
+    index = (sacd_dst_index_t *)sa_malloc(sizeof(*index));
+    if (!index) {
+        return NULL;
+    }
+
+    index->entries = (atomic_uint *)sa_malloc((size_t)frame_count * sizeof(atomic_uint));
+    if (!index->entries) {
+        sa_free(index);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < frame_count; i++) {
+        atomic_init(&index->entries[i], 0);
+    }
+    index->frame_count = frame_count;
+    atomic_init(&index->known, 0);
+    return index;
+}
+
+void sacd_dst_index_destroy(sacd_dst_index_t *index)
+{
+    if (index) {
+        sa_free(index->entries);
+        sa_free(index);
+    }
+}
+
+/**
+ * @brief Number of frames located so far.
+ */
+static uint32_t dst_index_known(const sacd_dst_index_t *index)
+{
+    return (uint32_t)atomic_load_explicit(&index->known, memory_order_relaxed);
+}
+
+int sacd_dst_reader_build_index(sacd_frame_reader_t *self)
+{
+    sacd_frame_reader_dst_t *dst = (sacd_frame_reader_dst_t *)self;
+    sacd_dst_index_t *index;
+    parsed_audio_sector_t parsed;
+    uint32_t data_offset;
+    const uint8_t *chunk;
+    uint32_t lsn;
+    int result = SACD_DST_READER_OK;
+
+    if (!self || self->type != SACD_FRAME_READER_DST || !self->input) {
+        return SACD_DST_READER_INVALID_ARG;
+    }
+    index = dst->area ? dst->area->dst_index : NULL;
+    if (!index) {
+        return SACD_DST_READER_MEMORY_ALLOCATION_ERROR;
+    }
+    if (dst_index_known(index) == index->frame_count) {
+        return SACD_DST_READER_OK;
+    }
+
+    /* Every sector of the Track Area carries an audio sector header */
+    for (lsn = self->start_sector; lsn <= self->end_sector; ) {
+        uint32_t sectors_read = 0;
+
+        if (dst_fetch_sectors(dst, lsn, DST_CHUNK_SECTORS, &chunk, &sectors_read) != SACD_DST_READER_OK) {
+            result = SACD_DST_READER_IO_ERROR;
+            break;
+        }
+
+        for (uint32_t i = 0; i < sectors_read; i++) {
+            const uint8_t *sector_data = chunk + (size_t)i * (size_t)self->sector_size + self->header_size;
+            if (parse_audio_sector_header(sector_data, &parsed, &data_offset) == 0) {
+                dst_index_record_sector(dst, &parsed, lsn + i);
+            }
+        }
+
+        lsn += sectors_read;
+    }
+
+    DST_DEBUG("sacd_dst_reader_build_index: %u of %u frames indexed",
+              dst_index_known(index), index->frame_count);
+
+    if (result == SACD_DST_READER_OK && dst_index_known(index) != index->frame_count) {
+        return SACD_DST_READER_FRAME_NOT_FOUND;
+    }
+    return result;
+}
+
+static void dst_index_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t dst_index_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Identify the disc a sidecar belongs to.
+ *
+ * @param[in]  self     DST reader
+ * @param[out] sectors  Sectors on the disc
+ * @param[out] hash     FNV-1a hash of the first Master TOC sector
+ *
+ * @return SACD_DST_READER_OK, or an error if the Master TOC cannot be read
+ */
+static int dst_index_disc_id(sacd_frame_reader_t *self, uint32_t *sectors, uint32_t *hash)
+{
+    uint8_t *buffer = (uint8_t *)sa_malloc((size_t)self->sector_size);
+    uint32_t got = 0;
+    uint32_t h = 0x811C9DC5u;
+
+    if (!buffer) {
+        return SACD_DST_READER_MEMORY_ALLOCATION_ERROR;
+    }
+    if (sacd_input_read_sectors(self->input, MASTER_TOC1_START, 1, buffer, &got) != 0 ||
+        got != 1) {
+        sa_free(buffer);
+        return SACD_DST_READER_IO_ERROR;
+    }
+
+    for (uint32_t i = 0; i < SACD_LSN_SIZE; i++) {
+        h ^= buffer[self->header_size + i];
+        h *= 0x01000193u;
+    }
+    sa_free(buffer);
+
+    *sectors = sacd_input_total_sectors(self->input);
+    *hash = h;
+    return SACD_DST_READER_OK;
+}
+
+int sacd_dst_reader_save_index(sacd_frame_reader_t *self, const char *path)
+{
+    sacd_frame_reader_dst_t *dst = (sacd_frame_reader_dst_t *)self;
+    const sacd_dst_index_t *index;
+    uint8_t header[DST_INDEX_HEADER_SIZE];
+    uint8_t *entries;
+    uint32_t prev_lsn;
+    uint32_t disc_sectors;
+    uint32_t disc_hash;
+    FILE *fp;
+    int result;
+
+    if (!self || self->type != SACD_FRAME_READER_DST || !path) {
+        return SACD_DST_READER_INVALID_ARG;
+    }
+
+    /* Only a complete index is written; fill in the gaps first */
+    result = sacd_dst_reader_build_index(self);
+    if (result != SACD_DST_READER_OK) {
+        return result;
+    }
+
+    result = dst_index_disc_id(self, &disc_sectors, &disc_hash);
+    if (result != SACD_DST_READER_OK) {
+        return result;
+    }
+
+    index = dst->area->dst_index;
+    entries = (uint8_t *)sa_malloc((size_t)index->frame_count * 2);
+    if (!entries) {
+        return SACD_DST_READER_MEMORY_ALLOCATION_ERROR;
+    }
+
+    prev_lsn = self->start_sector;
+    for (uint32_t i = 0; i < index->frame_count; i++) {
+        uint32_t entry = (uint32_t)atomic_load_explicit(&index->entries[i], memory_order_relaxed);
+        uint32_t lsn = entry & DST_INDEX_LSN_MASK;
+        uint32_t delta = lsn - prev_lsn;
+        if (lsn < prev_lsn || delta > UINT8_MAX) {
+            /* Frame starts out of order: not representable, don't persist */
+            sa_free(entries);
+            return SACD_DST_READER_FRAME_SEARCH_OVERFLOW;
+        }
+        entries[2 * i] = (uint8_t)delta;
+        entries[2 * i + 1] = (uint8_t)(entry >> DST_INDEX_SECTOR_SHIFT);
+        prev_lsn = lsn;
+    }
+
+    memcpy(header, DST_INDEX_MAGIC, 4);
+    dst_index_put_u32(header + 4, DST_INDEX_VERSION);
+    dst_index_put_u32(header + 8, self->start_sector);
+    dst_index_put_u32(header + 12, self->end_sector);
+    dst_index_put_u32(header + 16, index->frame_count);
+    dst_index_put_u32(header + 20, disc_sectors);
+    dst_index_put_u32(header + 24, disc_hash);
+
+    fp = sa_fopen(path, "wb");
+    if (!fp) {
+        sa_free(entries);
+        return SACD_DST_READER_IO_ERROR;
+    }
+
+    result = SACD_DST_READER_OK;
+    if (fwrite(header, 1, sizeof(header), fp) != sizeof(header) ||
+        fwrite(entries, 2, index->frame_count, fp) != index->frame_count) {
+        result = SACD_DST_READER_IO_ERROR;
+    }
+    if (fclose(fp) != 0) {
+        result = SACD_DST_READER_IO_ERROR;
+    }
+
+    sa_free(entries);
+    if (result != SACD_DST_READER_OK) {
+        remove(path);
+    }
+    return result;
+}
+
+int sacd_dst_reader_load_index(sacd_frame_reader_t *self, const char *path)
+{
+    sacd_frame_reader_dst_t *dst = (sacd_frame_reader_dst_t *)self;
+    sacd_dst_index_t *index;
+    uint8_t header[DST_INDEX_HEADER_SIZE];
+    uint8_t *entries;
+    uint32_t lsn;
+    uint32_t disc_sectors;
+    uint32_t disc_hash;
+    FILE *fp;
+    int result;
+
+    if (!self || self->type != SACD_FRAME_READER_DST || !path) {
+        return SACD_DST_READER_INVALID_ARG;
+    }
+    index = dst->area ? dst->area->dst_index : NULL;
+    if (!index) {
+        return SACD_DST_READER_MEMORY_ALLOCATION_ERROR;
+    }
+
+    result = dst_index_disc_id(self, &disc_sectors, &disc_hash);
+    if (result != SACD_DST_READER_OK) {
+        return result;
+    }
+
+    fp = sa_fopen(path, "rb");
+    if (!fp) {
+        return SACD_DST_READER_IO_ERROR;
+    }
+
+    /* The sidecar must describe exactly this Track Area of this disc */
+    if (fread(header, 1, sizeof(header), fp) != sizeof(header) ||
+        memcmp(header, DST_INDEX_MAGIC, 4) != 0 ||
+        dst_index_get_u32(header + 4) != DST_INDEX_VERSION ||
+        dst_index_get_u32(header + 8) != self->start_sector ||
+        dst_index_get_u32(header + 12) != self->end_sector ||
+        dst_index_get_u32(header + 16) != index->frame_count ||
+        dst_index_get_u32(header + 20) != disc_sectors ||
+        dst_index_get_u32(header + 24) != disc_hash) {
+        fclose(fp);
+        return SACD_DST_READER_INVALID_ARG;
+    }
+
+    entries = (uint8_t *)sa_malloc((size_t)index->frame_count * 2);
+    if (!entries) {
+        fclose(fp);
+        return SACD_DST_READER_MEMORY_ALLOCATION_ERROR;
+    }
+
+    if (fread(entries, 2, index->frame_count, fp) != index->frame_count) {
+        result = SACD_DST_READER_IO_ERROR;
+    }
+    fclose(fp);
+
+    /* Validate everything before touching the live index */
+    lsn = self->start_sector;
+    for (uint32_t i = 0; result == SACD_DST_READER_OK && i < index->frame_count; i++) {
+        lsn += entries[2 * i];
+        if (lsn > self->end_sector || entries[2 * i + 1] == 0 ||
+            entries[2 * i + 1] > MAX_DST_SECTORS) {
+            result = SACD_DST_READER_INVALID_ARG;
+        }
+    }
+
+    if (result == SACD_DST_READER_OK) {
+        lsn = self->start_sector;
+        for (uint32_t i = 0; i < index->frame_count; i++) {
+            lsn += entries[2 * i];
+            dst_index_record(dst, i, lsn, entries[2 * i + 1]);
+        }
+    }
+
+    sa_free(entries);
+    return result;
+}
@@ -98,6 +98,69 @@ typedef enum {
 
 int sacd_frame_reader_dst_create(sacd_frame_reader_t **out, struct area_toc_s *area);
 
+/**
+ * @brief Frame index of a Track Area (frame -> start LSN and sector count).
+ *
+ * Owned by the Area TOC and shared by the DST readers of the Area TOC and
+ * all of its clones; see sacd_dst_reader_build_index().
+ */
+typedef struct sacd_dst_index_s sacd_dst_index_t;
+
+/**
+ * @brief Create an empty frame index.
+ *
+ * @param[in] frame_count  Frames in the Track Area
+ * @return New index, or NULL if @p frame_count is 0 or allocation failed
+ *         (readers then locate frames by scanning)
+ */
+sacd_dst_index_t *sacd_dst_index_create(uint32_t frame_count);
+
+/**
+ * @brief Destroy a frame index.
+ *
+ * @param[in] index  Index to destroy (may be NULL)
+ */
+void sacd_dst_index_destroy(sacd_dst_index_t *index);
+
+/**
+ * @brief Index every frame of the Track Area.
+ *
+ * Scans the whole Track Area in large sequential reads and records where
+ * each frame starts. Afterwards seeks to any frame cost a single read.
+ * Frames already seen during normal reading are indexed as well, so calling
+ * this is optional. The index is shared with every clone of the Area TOC,
+ * so it only needs to be built once per disc.
+ *
+ * @param[in,out] self  DST frame reader
+ * @return SACD_DST_READER_OK on success, SACD_DST_READER_FRAME_NOT_FOUND if
+ *         some frames could not be located, or another error code
+ */
+int sacd_dst_reader_build_index(sacd_frame_reader_t *self);
+
+/**
+ * @brief Write the frame index to a sidecar file.
+ *
+ * Completes the index with sacd_dst_reader_build_index() first if needed.
+ *
+ * @param[in,out] self  DST frame reader
+ * @param[in]     path  Sidecar file path (UTF-8)
+ * @return SACD_DST_READER_OK on success, or error code
+ */
+int sacd_dst_reader_save_index(sacd_frame_reader_t *self, const char *path);
+
+/**
+ * @brief Load the frame index from a sidecar file.
+ *
+ * The file is rejected unless it was written for the same Track Area
+ * (sector range and frame count); the current index is then left as is.
+ *
+ * @param[in,out] self  DST frame reader
+ * @param[in]     path  Sidecar file path (UTF-8)
+ * @return SACD_DST_READER_OK on success, SACD_DST_READER_INVALID_ARG for a
+ *         mismatched or corrupt file, or another error code
+ */
+int sacd_dst_reader_load_index(sacd_frame_reader_t *self, const char *path);
+
 #ifdef __cplusplus
 }
 #endif
@@ -130,6 +130,26 @@ typedef struct sacd_frame_reader_ops {
                       uint32_t frame_lsn,
                       audio_packet_data_type_t data_type);
 
+    /**
+     * @brief Read a run of consecutive audio frames without copying them (optional).
+     *
+     * Reads the sectors holding the frames in one go and fills a descriptor
+     * per frame pointing into reference-counted buffers. Frames that cross a
+     * sector boundary are reassembled; the others are returned in place.
+     *
+     * @param[in]     ctx          Pointer to the frame reader context
+     * @param[in]     frame_num    First frame index (0-based within the Track Area)
+     * @param[in]     frame_lsn    Logical sector number where the first frame starts
+     * @param[in,out] frame_count  Input: maximum frames; Output: frames returned
+     * @param[out]    frames       Receives one descriptor per frame
+     * @return 0 on success, reader-specific error code on failure
+     */
+    int (*read_frames)(sacd_frame_reader_t *ctx,
+                       uint32_t frame_num,
+                       uint32_t frame_lsn,
+                       uint32_t *frame_count,
+                       sacd_frame_ref_t *frames);
+
 } sacd_frame_reader_ops_t;
 
 /**
@@ -303,6 +323,41 @@ static inline int sacd_frame_reader_read_frame(sacd_frame_reader_t *ctx,
     return ctx->ops->read_frame(ctx, data, length, frame_num, frame_lsn, data_type);
 }
 
+/**
+ * @brief Check whether a frame reader can return frames without copying.
+ *
+ * @param[in] ctx  Pointer to the frame reader context
+ * @return true if sacd_frame_reader_read_frames() is implemented
+ */
+static inline bool sacd_frame_reader_has_read_frames(const sacd_frame_reader_t *ctx)
+{
+    return ctx && ctx->ops && ctx->ops->read_frames;
+}
+
+/**
+ * @brief Read a run of consecutive main audio frames without copying them.
+ *
+ * @param[in]     ctx          Pointer to the frame reader context
+ * @param[in]     frame_num    First frame index (0-based within the Track Area)
+ * @param[in]     frame_lsn    Logical sector number where the first frame starts
+ * @param[in,out] frame_count  Input: maximum frames; Output: frames returned
+ * @param[out]    frames       Receives one descriptor per frame
+ * @return 0 on success, non-zero on failure or if read_frames is not implemented
+ *
+ * @see sacd_get_sound_frames()
+ */
+static inline int sacd_frame_reader_read_frames(sacd_frame_reader_t *ctx,
+                    uint32_t frame_num,
+                    uint32_t frame_lsn,
+                    uint32_t *frame_count,
+                    sacd_frame_ref_t *frames)
+{
+    if (!sacd_frame_reader_has_read_frames(ctx) || !frame_count || !frames) {
+        return SACD_FRAME_READER_ERR_INVALID_ARG;
+    }
+    return ctx->ops->read_frames(ctx, frame_num, frame_lsn, frame_count, frames);
+}
+
 #ifdef __cplusplus
 }
 #endif
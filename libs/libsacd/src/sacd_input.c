@@ -158,6 +158,25 @@ static bool _is_device_path(const char *path)
     return false;
 }
 
+#ifndef SACD_NO_PS3DRIVE
+/**
+ * @brief Put a sector cache in front of a freshly opened input.
+ *
+ * Used for network and drive inputs, where every uncached read costs a
+ * round trip. If the cache cannot be set up the input is used as is.
+ */
+static int _open_cached(int res, sacd_input_t **out)
+{
+    sacd_input_t *cached;
+
+    if (res == SACD_INPUT_OK &&
+        sacd_input_open_cache(*out, NULL, &cached) == SACD_INPUT_OK) {
+        *out = cached;
+    }
+    return res;
+}
+#endif
+
 int sacd_input_open(const char *path, sacd_input_t **out)
 {
     if (!path || !out) {
@@ -181,7 +200,7 @@ int sacd_input_open(const char *path, sacd_input_t **out)
         host[host_len] = '\0';
 
         port = (uint16_t)atoi(colon + 1);
-        return sacd_input_open_network(host, port, out);
+        return _open_cached(sacd_input_open_network(host, port, out), out);
 #endif
     }
 
@@ -190,7 +209,7 @@ int sacd_input_open(const char *path, sacd_input_t **out)
 #ifdef SACD_NO_PS3DRIVE
         return SACD_INPUT_ERR_NOT_SUPPORTED;
 #else
-        return sacd_input_open_device(path, out);
+        return _open_cached(sacd_input_open_device(path, out), out);
 #endif
     }
 
@@ -221,6 +221,41 @@ typedef struct sacd_input_ops {
      */
     int (*get_trailer_size)(sacd_input_t *self, int16_t *size);
 
+    /* ========================================================================
+     * Shared Access Methods
+     * ======================================================================== */
+
+    /**
+     * @brief Get a pointer to sectors without copying them.
+     * @param[in]  self              Pointer to the input device
+     * @param[in]  sector_pos        Starting sector number
+     * @param[in]  sector_count      Number of sectors wanted
+     * @param[out] ptr               Receives a pointer to the raw sectors
+     *                               (native format), valid until the last
+     *                               handle on the source is closed
+     * @param[out] sectors_available Receives the number of sectors at @p ptr
+     *                               (fewer than requested at the end)
+     * @return SACD_INPUT_OK on success, SACD_INPUT_ERR_NOT_SUPPORTED if the
+     *         data is not memory resident, or another negative error code
+     *
+     * @note Optional. Implemented by file inputs backed by a memory map;
+     *       they stop handing out pointers once the file changes on disk.
+     */
+    int (*get_sector_ptr)(sacd_input_t *self, uint32_t sector_pos,
+                          uint32_t sector_count, const uint8_t **ptr,
+                          uint32_t *sectors_available);
+
+    /**
+     * @brief Create another handle on the same source.
+     * @param[in]  self  Pointer to the input device
+     * @param[out] out   Receives the new handle (close it independently)
+     * @return SACD_INPUT_OK on success, negative error code on failure
+     *
+     * @note Optional. Handles share the open file (and its mapping) but keep
+     *       their own error state, so each thread can use its own handle.
+     */
+    int (*dup)(sacd_input_t *self, sacd_input_t **out);
+
 } sacd_input_ops_t;
 
 /**
@@ -281,6 +316,40 @@ SACD_API int sacd_input_open_network(const char *host, uint16_t port,
                                      sacd_input_t **out);
 #endif
 
+/** Default number of DISC_READ requests kept in flight by a network input */
+#define SACD_NETWORK_DEFAULT_WINDOW         4
+/** Upper bound for the network request window */
+#define SACD_NETWORK_MAX_WINDOW             16
+/** Default sectors per DISC_READ request (at most 500 fit one response) */
+#define SACD_NETWORK_DEFAULT_CHUNK_SECTORS  256
+
+#ifndef SACD_NO_PS3DRIVE
+/**
+ * @brief Configure the read pipeline of a network input.
+ *
+ * Reads are split into requests of @p chunk_sectors sectors, of which up to
+ * @p window are sent before the first response is received. Sequential reads
+ * additionally keep the window filled ahead of the reader. Outstanding
+ * responses are drained before the new settings take effect.
+ *
+ * @param[in] input          Input created with sacd_input_open_network()
+ * @param[in] window         Requests in flight (1..SACD_NETWORK_MAX_WINDOW),
+ *                           0 for SACD_NETWORK_DEFAULT_WINDOW
+ * @param[in] chunk_sectors  Sectors per request (1..500),
+ *                           0 for SACD_NETWORK_DEFAULT_CHUNK_SECTORS
+ *
+ * @return SACD_INPUT_OK on success, or:
+ *         - SACD_INPUT_ERR_NULL_PTR: NULL input
+ *         - SACD_INPUT_ERR_NOT_SUPPORTED: Not a network input
+ *         - SACD_INPUT_ERR_INVALID_ARG: Value out of range
+ *         - SACD_INPUT_ERR_OUT_OF_MEMORY: Allocation failed
+ *         - SACD_INPUT_ERR_NETWORK: Draining outstanding responses failed
+ */
+SACD_API int sacd_input_network_set_pipeline(sacd_input_t *input,
+                                             uint32_t window,
+                                             uint32_t chunk_sectors);
+#endif
+
 #ifndef SACD_NO_PS3DRIVE
 /**
  * @brief Open a physical device (Bluray/DVD drive).
@@ -321,6 +390,83 @@ SACD_API int sacd_input_open_device(const char *device, sacd_input_t **out);
  */
 SACD_API int sacd_input_open(const char *path, sacd_input_t **out);
 
+/* ============================================================================
+ * Sector Cache
+ * ============================================================================ */
+
+/** @brief Default sectors per cache block (64 KiB of 2048-byte sectors). */
+#define SACD_INPUT_CACHE_BLOCK_SECTORS    32
+/** @brief Default number of cached blocks. */
+#define SACD_INPUT_CACHE_MAX_BLOCKS       128
+/** @brief Default number of blocks read ahead of a sequential stream. */
+#define SACD_INPUT_CACHE_READAHEAD_BLOCKS 8
+/** @brief Default number of independently locked cache shards. */
+#define SACD_INPUT_CACHE_SHARDS           8
+
+/**
+ * @struct sacd_input_cache_config_t
+ * @brief Settings for sacd_input_open_cache().
+ *
+ * Zero sizes select the SACD_INPUT_CACHE_* defaults.
+ */
+typedef struct sacd_input_cache_config {
+    uint32_t block_sectors;     /**< Sectors per cache block */
+    uint32_t max_blocks;        /**< Blocks kept in the cache */
+    uint32_t readahead_blocks;  /**< Blocks read ahead of a sequential stream (0 = off) */
+    uint32_t shard_count;       /**< Independently locked shards */
+} sacd_input_cache_config_t;
+
+/**
+ * @struct sacd_input_cache_stats_t
+ * @brief Counters of a sector cache, summed over all its handles.
+ */
+typedef struct sacd_input_cache_stats {
+    uint64_t hits;              /**< Block lookups served from the cache */
+    uint64_t misses;            /**< Blocks read from the input on demand */
+    uint64_t readahead;         /**< Blocks read by the readahead worker */
+    uint64_t readahead_hits;    /**< Read-ahead blocks that were later requested */
+    uint64_t evictions;         /**< Blocks dropped to make room */
+    uint32_t cached_blocks;     /**< Blocks currently held */
+    uint32_t block_sectors;     /**< Sectors per block */
+} sacd_input_cache_stats_t;
+
+/**
+ * @brief Wrap an input in a sector cache with sequential readahead.
+ *
+ * Reads are served from an LRU cache of aligned blocks of sectors; a miss
+ * reads the whole block. Once a handle reads sequentially, a worker thread
+ * keeps the following blocks cached. The worker reads through its own
+ * sacd_input_dup() of @p inner when the backend supports it; otherwise all
+ * reads on @p inner are serialized.
+ *
+ * The cache can be stacked on any backend. Duplicating the cached input
+ * shares the cache, and requires @p inner to support sacd_input_dup().
+ *
+ * @param[in]  inner   Input to wrap; owned by the cache on success
+ * @param[in]  config  Cache settings, or NULL for the defaults
+ * @param[out] out     Receives the caching input
+ *
+ * @return SACD_INPUT_OK on success, or:
+ *         - SACD_INPUT_ERR_INVALID_ARG: NULL inner or out pointer
+ *         - SACD_INPUT_ERR_OUT_OF_MEMORY: Allocation failed (@p inner is
+ *           left open and still owned by the caller)
+ */
+SACD_API int sacd_input_open_cache(sacd_input_t *inner,
+                                   const sacd_input_cache_config_t *config,
+                                   sacd_input_t **out);
+
+/**
+ * @brief Get the counters of a cache created with sacd_input_open_cache().
+ *
+ * @param[in]  input  Caching input
+ * @param[out] stats  Receives the counters
+ *
+ * @return SACD_INPUT_OK on success, SACD_INPUT_ERR_NOT_SUPPORTED if
+ *         @p input is not a caching input
+ */
+SACD_API int sacd_input_cache_get_stats(sacd_input_t *input,
+                                        sacd_input_cache_stats_t *stats);
+
 /* ============================================================================
  * Inline Wrapper Functions - Call Through vtable
  * ============================================================================ */
@@ -545,6 +691,50 @@ static inline int sacd_input_read_sectors(sacd_input_t *input,
                                      buffer, sectors_read);
 }
 
+/**
+ * @brief Get a pointer to sectors without copying them (zero-copy).
+ * @param[in]  input             Device to read from
+ * @param[in]  sector_pos        Starting sector number
+ * @param[in]  sector_count      Number of sectors wanted
+ * @param[out] ptr               Receives a pointer to the raw sectors
+ * @param[out] sectors_available Receives the number of sectors at @p ptr
+ * @return SACD_INPUT_OK on success, SACD_INPUT_ERR_NOT_SUPPORTED if the
+ *         backend cannot expose its data (use sacd_input_read_sectors())
+ */
+static inline int sacd_input_get_sector_ptr(sacd_input_t *input,
+                                            uint32_t sector_pos,
+                                            uint32_t sector_count,
+                                            const uint8_t **ptr,
+                                            uint32_t *sectors_available)
+{
+    if (!input || !input->ops || !ptr || !sectors_available) {
+        return SACD_INPUT_ERR_NULL_PTR;
+    }
+    if (!input->ops->get_sector_ptr) {
+        return SACD_INPUT_ERR_NOT_SUPPORTED;
+    }
+    return input->ops->get_sector_ptr(input, sector_pos, sector_count,
+                                      ptr, sectors_available);
+}
+
+/**
+ * @brief Create another handle on the same source.
+ * @param[in]  input  Device to share
+ * @param[out] out    Receives the new handle
+ * @return SACD_INPUT_OK on success, SACD_INPUT_ERR_NOT_SUPPORTED if the
+ *         backend cannot share its connection
+ */
+static inline int sacd_input_dup(sacd_input_t *input, sacd_input_t **out)
+{
+    if (!input || !input->ops || !out) {
+        return SACD_INPUT_ERR_NULL_PTR;
+    }
+    if (!input->ops->dup) {
+        return SACD_INPUT_ERR_NOT_SUPPORTED;
+    }
+    return input->ops->dup(input, out);
+}
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
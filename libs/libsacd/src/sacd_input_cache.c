@@ -0,0 +1,912 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Sector cache decorator for SACD input devices.
+ * Wraps any sacd_input_t and keeps recently read sectors in an LRU cache of
+ * aligned, fixed-size blocks. The cache is split into shards, each with its
+ * own lock, so readers on different handles rarely contend. When a handle
+ * reads sequentially, a worker thread reads the next blocks ahead of it.
+ * Handles created with sacd_input_dup() share the cache.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sacd_input.h"
+
+#include <libsautil/mem.h>
+#include <libsautil/c11threads.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdatomic.h>
+
+/** Marks "no block" in block number fields */
+#define CACHE_NO_BLOCK UINT32_MAX
+
+/**
+ * @struct cache_block_t
+ * @brief One aligned run of sectors held by the cache.
+ */
+typedef struct cache_block {
+    uint32_t block_no;              /**< Block number (first sector / block size) */
+    uint32_t sectors;               /**< Valid sectors (short at end of disc) */
+    bool prefetched;                /**< Read ahead and not yet requested */
+    struct cache_block *hash_next;  /**< Next block in the hash bucket */
+    struct cache_block *lru_prev;   /**< More recently used neighbour */
+    struct cache_block *lru_next;   /**< Less recently used neighbour */
+    uint8_t data[];                 /**< Raw sectors (native format) */
+} cache_block_t;
+
+/**
+ * @struct cache_shard_t
+ * @brief Independently locked part of the cache.
+ *
+ * Block n lives in shard n % shard_count, so consecutive blocks of a
+ * stream are spread over all shards. The counters are only touched with
+ * the shard lock held.
+ */
+typedef struct cache_shard {
+    mtx_t lock;                     /**< Protects everything below */
+    cache_block_t **buckets;        /**< Hash table of cached blocks */
+    uint32_t bucket_mask;           /**< Bucket count - 1 (power of two) */
+    cache_block_t lru;              /**< List head; lru.lru_next is most recent */
+    uint32_t count;                 /**< Blocks held */
+    uint32_t capacity;              /**< Blocks allowed */
+    uint64_t hits;                  /**< Blocks served from the cache */
+    uint64_t misses;                /**< Blocks read from the input on demand */
+    uint64_t readahead;             /**< Blocks inserted by the readahead worker */
+    uint64_t readahead_hits;        /**< Read-ahead blocks later requested */
+    uint64_t evictions;             /**< Blocks dropped to make room */
+} cache_shard_t;
+
+/**
+ * @struct sacd_cache_core_t
+ * @brief Cache and readahead worker shared by all handles of one input.
+ */
+typedef struct sacd_cache_core {
+    atomic_int refcount;            /**< Handles using this core */
+    uint32_t block_sectors;         /**< Sectors per block */
+    uint32_t sector_size;           /**< Raw sector size of the input */
+    size_t block_bytes;             /**< block_sectors * sector_size */
+    uint32_t total_sectors;         /**< Input size in sectors (0 = unknown) */
+    uint32_t shard_count;           /**< Number of shards */
+    cache_shard_t *shards;          /**< Shard array */
+
+    /* Input access for the worker */
+    sacd_input_t *ra_input;         /**< Handle the worker reads through */
+    bool ra_owned;                  /**< ra_input is a private dup of the input */
+    bool io_shared;                 /**< Worker shares the input: lock io_lock */
+    mtx_t io_lock;                  /**< Serializes input reads when io_shared */
+
+    /* Readahead worker */
+    uint32_t readahead_blocks;      /**< Blocks to keep ahead of a stream (0 = off) */
+    mtx_t ra_lock;                  /**< Protects the fields below */
+    cnd_t ra_cond;                  /**< Signals a new request or shutdown */
+    cnd_t ra_done;                  /**< Signals that ra_inflight finished */
+    thrd_t ra_thread;               /**< Worker thread */
+    bool ra_running;                /**< Worker thread was started */
+    bool ra_failed;                 /**< Worker thread could not be started */
+    bool ra_stop;                   /**< Worker should exit */
+    uint32_t ra_next;               /**< Next block to read ahead */
+    uint32_t ra_end;                /**< Block after the last one requested */
+    uint32_t ra_inflight;           /**< Block being read by the worker */
+} sacd_cache_core_t;
+
+/**
+ * @struct sacd_input_cache_t
+ * @brief Extended structure for a caching input handle.
+ *
+ * The base struct MUST be the first member for safe casting.
+ */
+typedef struct sacd_input_cache {
+    sacd_input_t base;              /**< Base structure (must be first!) */
+    sacd_input_t *inner;            /**< Wrapped input (owned) */
+    sacd_cache_core_t *core;        /**< Shared cache */
+    uint32_t next_sector;           /**< Sector after the previous read */
+    uint32_t sequential_reads;      /**< Consecutive reads continuing the last one */
+    uint32_t ra_until;              /**< Block after the last one queued for readahead */
+} sacd_input_cache_t;
+
+/* Forward declarations of vtable functions */
+static int          _cache_close(sacd_input_t *self);
+static int          _cache_read_sectors(sacd_input_t *self, uint32_t sector_pos,
+                                        uint32_t sector_count, void *buffer,
+                                        uint32_t *sectors_read);
+static uint32_t     _cache_total_sectors(sacd_input_t *self);
+static int          _cache_authenticate(sacd_input_t *self);
+static int          _cache_decrypt(sacd_input_t *self, uint8_t *buffer,
+                                   uint32_t block_count);
+static const char  *_cache_get_error(sacd_input_t *self);
+static int          _cache_get_sector_format(sacd_input_t *self,
+                                             sacd_sector_format_t *format);
+static int          _cache_get_sector_size(sacd_input_t *self, uint32_t *size);
+static int          _cache_get_header_size(sacd_input_t *self, int16_t *size);
+static int          _cache_get_trailer_size(sacd_input_t *self, int16_t *size);
+static int          _cache_get_sector_ptr(sacd_input_t *self, uint32_t sector_pos,
+                                          uint32_t sector_count, const uint8_t **ptr,
+                                          uint32_t *sectors_available);
+static int          _cache_dup(sacd_input_t *self, sacd_input_t **out);
+
+/**
+ * @brief Cache input vtable, for inputs that decrypt.
+ */
+static const sacd_input_ops_t _cache_input_ops = {
+    .close             = _cache_close,
+    .read_sectors      = _cache_read_sectors,
+    .total_sectors     = _cache_total_sectors,
+    .authenticate      = _cache_authenticate,
+    .decrypt           = _cache_decrypt,
+    .get_error         = _cache_get_error,
+    /* Sector format methods */
+    .get_sector_format = _cache_get_sector_format,
+    .get_sector_size   = _cache_get_sector_size,
+    .get_header_size   = _cache_get_header_size,
+    .get_trailer_size  = _cache_get_trailer_size,
+    /* Shared access */
+    .get_sector_ptr    = _cache_get_sector_ptr,
+    .dup               = _cache_dup,
+};
+
+/**
+ * @brief Cache input vtable, for inputs without decryption.
+ *
+ * Readers check for a decrypt method to tell whether sectors need it, so
+ * the cache must not advertise one its input lacks.
+ */
+static const sacd_input_ops_t _cache_input_ops_plain = {
+    .close             = _cache_close,
+    .read_sectors      = _cache_read_sectors,
+    .total_sectors     = _cache_total_sectors,
+    .authenticate      = _cache_authenticate,
+    .get_error         = _cache_get_error,
+    /* Sector format methods */
+    .get_sector_format = _cache_get_sector_format,
+    .get_sector_size   = _cache_get_sector_size,
+    .get_header_size   = _cache_get_header_size,
+    .get_trailer_size  = _cache_get_trailer_size,
+    /* Shared access */
+    .get_sector_ptr    = _cache_get_sector_ptr,
+    .dup               = _cache_dup,
+};
+
+/* ============================================================================
+ * Cache Blocks
+ * ============================================================================ */
+
+static cache_shard_t *_cache_shard(sacd_cache_core_t *core, uint32_t block_no)
+{
+    return &core->shards[block_no % core->shard_count];
+}
+
+static cache_block_t **_cache_bucket(sacd_cache_core_t *core, cache_shard_t *shard,
+                                     uint32_t block_no)
+{
+    return &shard->buckets[(block_no / core->shard_count) & shard->bucket_mask];
+}
+
+static void _cache_lru_unlink(cache_block_t *block)
+{
+    block->lru_prev->lru_next = block->lru_next;
+    block->lru_next->lru_prev = block->lru_prev;
+}
+
+static void _cache_lru_push_front(cache_shard_t *shard, cache_block_t *block)
+{
+    block->lru_prev = &shard->lru;
+    block->lru_next = shard->lru.lru_next;
+    shard->lru.lru_next->lru_prev = block;
+    shard->lru.lru_next = block;
+}
+
+/**
+ * @brief Find a block in its shard (shard lock held).
+ */
+static cache_block_t *_cache_find(sacd_cache_core_t *core, cache_shard_t *shard,
+                                  uint32_t block_no)
+{
+    cache_block_t *block = *_cache_bucket(core, shard, block_no);
+    while (block && block->block_no != block_no) {
+        block = block->hash_next;
+    }
+    return block;
+}
+
+/**
+ * @brief Drop the least recently used block of a shard (shard lock held).
+ */
+static void _cache_evict_one(sacd_cache_core_t *core, cache_shard_t *shard)
+{
+    cache_block_t *victim = shard->lru.lru_prev;
+    cache_block_t **link;
+
+    if (victim == &shard->lru) {
+        return;
+    }
+
+    link = _cache_bucket(core, shard, victim->block_no);
+    while (*link != victim) {
+        link = &(*link)->hash_next;
+    }
+    *link = victim->hash_next;
+
+    _cache_lru_unlink(victim);
+    shard->count--;
+    shard->evictions++;
+    sa_free(victim);
+}
+
+/**
+ * @brief Copy sectors out of a cached block, optionally inserting it first.
+ *
+ * Looks the block up under the shard lock and, if @p insert is given and
+ * the block is not cached yet, adds @p insert (ownership passes to the
+ * cache; it is freed if the block turned up in the meantime). Copying
+ * happens under the lock, so the block cannot be evicted halfway.
+ *
+ * @return Sectors copied (0 if @p offset is past the end of a short block),
+ *         or -1 if the block is not cached
+ */
+static int _cache_copy(sacd_cache_core_t *core, uint32_t block_no,
+                       uint32_t offset, uint32_t count, uint8_t *dst,
+                       cache_block_t *insert)
+{
+    cache_shard_t *shard = _cache_shard(core, block_no);
+    cache_block_t *block;
+    int copied = -1;
+
+    mtx_lock(&shard->lock);
+
+    block = _cache_find(core, shard, block_no);
+    if (block) {
+        _cache_lru_unlink(block);
+        if (insert) {
+            sa_free(insert);
+        } else {
+            shard->hits++;
+            if (block->prefetched) {
+                shard->readahead_hits++;
+            }
+        }
+        block->prefetched = false;
+    } else if (insert) {
+        block = insert;
+        while (shard->count >= shard->capacity) {
+            _cache_evict_one(core, shard);
+        }
+        cache_block_t **bucket = _cache_bucket(core, shard, block_no);
+        block->hash_next = *bucket;
+        *bucket = block;
+        shard->count++;
+        if (block->prefetched) {
+            shard->readahead++;
+        } else {
+            shard->misses++;
+        }
+    }
+
+    if (block) {
+        _cache_lru_push_front(shard, block);
+        if (dst) {
+            uint32_t avail = (offset < block->sectors) ? block->sectors - offset : 0;
+            if (count > avail) {
+                count = avail;
+            }
+            memcpy(dst, block->data + (size_t)offset * core->sector_size,
+                   (size_t)count * core->sector_size);
+            copied = (int)count;
+        } else {
+            copied = 0;
+        }
+    }
+
+    mtx_unlock(&shard->lock);
+    return copied;
+}
+
+/**
+ * @brief Check whether a block is cached, without touching its LRU position.
+ */
+static bool _cache_contains(sacd_cache_core_t *core, uint32_t block_no)
+{
+    cache_shard_t *shard = _cache_shard(core, block_no);
+    bool found;
+
+    mtx_lock(&shard->lock);
+    found = _cache_find(core, shard, block_no) != NULL;
+    mtx_unlock(&shard->lock);
+    return found;
+}
+
+/**
+ * @brief Read a whole block from an input into a new, unlinked block.
+ *
+ * Blocks are only returned if the input read them without error; a short
+ * block is kept only when the input reports the end of the disc.
+ *
+ * @return The block, or NULL with the input's error code in @p err
+ */
+static cache_block_t *_cache_load(sacd_cache_core_t *core, sacd_input_t *input,
+                                  uint32_t block_no, int *err)
+{
+    uint32_t first = block_no * core->block_sectors;
+    uint32_t count = core->block_sectors;
+    uint32_t got = 0;
+    int res;
+
+    if (core->total_sectors && first + count > core->total_sectors) {
+        count = core->total_sectors - first;
+    }
+
+    cache_block_t *block = (cache_block_t *)sa_malloc(sizeof(cache_block_t) +
+                                                      core->block_bytes);
+    if (!block) {
+        *err = SACD_INPUT_ERR_OUT_OF_MEMORY;
+        return NULL;
+    }
+
+    if (core->io_shared) {
+        mtx_lock(&core->io_lock);
+    }
+    res = sacd_input_read_sectors(input, first, count, block->data, &got);
+    if (core->io_shared) {
+        mtx_unlock(&core->io_lock);
+    }
+
+    if ((res != SACD_INPUT_OK && res != SACD_INPUT_ERR_EOF) || got == 0) {
+        sa_free(block);
+        *err = (res != SACD_INPUT_OK) ? res : SACD_INPUT_ERR_EOF;
+        return NULL;
+    }
+
+    block->block_no = block_no;
+    block->sectors = got;
+    block->prefetched = false;
+    block->hash_next = NULL;
+    *err = SACD_INPUT_OK;
+    return block;
+}
+
+/* ============================================================================
+ * Readahead Worker
+ * ============================================================================ */
+
+/**
+ * @brief Worker thread: reads requested blocks into the cache.
+ *
+ * Only one request is pending at a time; a newer request replaces the
+ * rest of an older one, so the most recent stream is served first.
+ */
+static int _cache_readahead_thread(void *arg)
+{
+    sacd_cache_core_t *core = (sacd_cache_core_t *)arg;
+
+    mtx_lock(&core->ra_lock);
+    while (!core->ra_stop) {
+        if (core->ra_next >= core->ra_end) {
+            cnd_wait(&core->ra_cond, &core->ra_lock);
+            continue;
+        }
+
+        uint32_t block_no = core->ra_next++;
+        if (_cache_contains(core, block_no)) {
+            continue;
+        }
+
+        core->ra_inflight = block_no;
+        mtx_unlock(&core->ra_lock);
+
+        int err;
+        cache_block_t *block = _cache_load(core, core->ra_input, block_no, &err);
+        if (block) {
+            block->prefetched = true;
+            _cache_copy(core, block_no, 0, 0, NULL, block);
+        }
+
+        mtx_lock(&core->ra_lock);
+        core->ra_inflight = CACHE_NO_BLOCK;
+        cnd_broadcast(&core->ra_done);
+        if (!block) {
+            /* End of disc or read error: leave the rest to demand reads */
+            core->ra_next = core->ra_end;
+        }
+    }
+    mtx_unlock(&core->ra_lock);
+
+    return 0;
+}
+
+/**
+ * @brief Ask the worker to read blocks [first, end).
+ */
+static void _cache_request_readahead(sacd_cache_core_t *core, uint32_t first,
+                                     uint32_t end)
+{
+    mtx_lock(&core->ra_lock);
+    if (!core->ra_running && !core->ra_failed) {
+        /* Without a worker, demand reads still go through the cache */
+        core->ra_running = thrd_create(&core->ra_thread, _cache_readahead_thread,
+                                       core) == thrd_success;
+        core->ra_failed = !core->ra_running;
+    }
+    if (core->ra_running) {
+        core->ra_next = first;
+        core->ra_end = end;
+        cnd_signal(&core->ra_cond);
+    }
+    mtx_unlock(&core->ra_lock);
+}
+
+/**
+ * @brief Wait until the worker is no longer reading a block.
+ */
+static void _cache_wait_inflight(sacd_cache_core_t *core, uint32_t block_no)
+{
+    mtx_lock(&core->ra_lock);
+    while (core->ra_inflight == block_no) {
+        cnd_wait(&core->ra_done, &core->ra_lock);
+    }
+    mtx_unlock(&core->ra_lock);
+}
+
+/**
+ * @brief Track the access pattern of a handle and queue readahead.
+ *
+ * A read that starts where the previous one ended continues a stream.
+ * Once a stream is established the worker is asked to keep the next
+ * readahead_blocks blocks cached; a new request is only sent when less than
+ * half of that window is left, so the worker sees few, large requests.
+ */
+static void _cache_track_stream(sacd_input_cache_t *cself, uint32_t sector_pos,
+                                uint32_t sectors_read)
+{
+    sacd_cache_core_t *core = cself->core;
+
+    if (sector_pos == cself->next_sector) {
+        cself->sequential_reads++;
+    } else {
+        cself->sequential_reads = 0;
+        cself->ra_until = 0;
+    }
+    cself->next_sector = sector_pos + sectors_read;
+
+    if (core->readahead_blocks == 0 || cself->sequential_reads == 0) {
+        return;
+    }
+
+    uint32_t first = cself->next_sector / core->block_sectors;
+    uint32_t end = first + core->readahead_blocks;
+    if (core->total_sectors) {
+        uint32_t last = (core->total_sectors + core->block_sectors - 1) /
+                        core->block_sectors;
+        if (end > last) {
+            end = last;
+        }
+    }
+
+    if (cself->ra_until > first + core->readahead_blocks / 2 || first >= end) {
+        return;
+    }
+
+    if (cself->ra_until > first) {
+        first = cself->ra_until;
+    }
+    cself->ra_until = end;
+    _cache_request_readahead(core, first, end);
+}
+
+/* ============================================================================
+ * Core Lifecycle
+ * ============================================================================ */
+
+/**
+ * @brief Stop the worker and free a core.
+ */
+static void _cache_core_free(sacd_cache_core_t *core)
+{
+    if (core->ra_running) {
+        mtx_lock(&core->ra_lock);
+        core->ra_stop = true;
+        cnd_signal(&core->ra_cond);
+        mtx_unlock(&core->ra_lock);
+        thrd_join(core->ra_thread, NULL);
+    }
+
+    if (core->ra_owned) {
+        sacd_input_close(core->ra_input);
+    }
+
+    if (core->shards) {
+        for (uint32_t i = 0; i < core->shard_count; i++) {
+            cache_shard_t *shard = &core->shards[i];
+            while (shard->count > 0) {
+                _cache_evict_one(core, shard);
+            }
+            sa_free(shard->buckets);
+            mtx_destroy(&shard->lock);
+        }
+        sa_free(core->shards);
+    }
+
+    cnd_destroy(&core->ra_done);
+    cnd_destroy(&core->ra_cond);
+    mtx_destroy(&core->ra_lock);
+    mtx_destroy(&core->io_lock);
+    sa_free(core);
+}
+
+static void _cache_core_release(sacd_cache_core_t *core)
+{
+    if (core && atomic_fetch_sub(&core->refcount, 1) == 1) {
+        _cache_core_free(core);
+    }
+}
+
+/**
+ * @brief Create the shared cache for an input.
+ */
+static sacd_cache_core_t *_cache_core_new(sacd_input_t *inner,
+                                          const sacd_input_cache_config_t *config)
+{
+    uint32_t per_shard;
+    uint32_t buckets;
+
+    sacd_cache_core_t *core = (sacd_cache_core_t *)sa_calloc(1, sizeof(*core));
+    if (!core) {
+        return NULL;
+    }
+
+    atomic_init(&core->refcount, 1);
+    core->block_sectors = config->block_sectors;
+    core->shard_count = config->shard_count;
+    core->readahead_blocks = config->readahead_blocks;
+    core->ra_inflight = CACHE_NO_BLOCK;
+    core->total_sectors = sacd_input_total_sectors(inner);
+    sacd_input_get_sector_size(inner, &core->sector_size);
+    core->block_bytes = (size_t)core->block_sectors * core->sector_size;
+
+    mtx_init(&core->io_lock, mtx_plain);
+    mtx_init(&core->ra_lock, mtx_plain);
+    cnd_init(&core->ra_cond);
+    cnd_init(&core->ra_done);
+
+    /* Prefer a private handle for the worker; otherwise share the input and
+     * serialize every read on it */
+    core->ra_input = inner;
+    if (core->readahead_blocks > 0) {
+        if (sacd_input_dup(inner, &core->ra_input) == SACD_INPUT_OK) {
+            core->ra_owned = true;
+        } else {
+            core->ra_input = inner;
+            core->io_shared = true;
+        }
+    }
+
+    core->shards = (cache_shard_t *)sa_calloc(core->shard_count, sizeof(cache_shard_t));
+    if (!core->shards) {
+        core->shard_count = 0;
+        _cache_core_free(core);
+        return NULL;
+    }
+
+    per_shard = (config->max_blocks + core->shard_count - 1) / core->shard_count;
+    for (buckets = 1; buckets < per_shard; buckets <<= 1) {
+    }
+
+    for (uint32_t i = 0; i < core->shard_count; i++) {
+        cache_shard_t *shard = &core->shards[i];
+        mtx_init(&shard->lock, mtx_plain);
+        shard->lru.lru_next = &shard->lru;
+        shard->lru.lru_prev = &shard->lru;
+        shard->capacity = per_shard;
+        shard->bucket_mask = buckets - 1;
+        shard->buckets = (cache_block_t **)sa_calloc(buckets, sizeof(cache_block_t *));
+        if (!shard->buckets) {
+            core->shard_count = i + 1;
+            _cache_core_free(core);
+            return NULL;
+        }
+    }
+
+    return core;
+}
+
+/**
+ * @brief Create a handle on a core (takes over one core reference).
+ */
+static sacd_input_cache_t *_cache_handle_new(sacd_cache_core_t *core,
+                                             sacd_input_t *inner)
+{
+    sacd_input_cache_t *self = (sacd_input_cache_t *)sa_calloc(1, sizeof(*self));
+    if (!self) {
+        return NULL;
+    }
+
+    self->base.ops  = inner->ops->decrypt ? &_cache_input_ops : &_cache_input_ops_plain;
+    self->base.type = inner->type;
+    self->base.last_error = SACD_INPUT_OK;
+    self->inner = inner;
+    self->core = core;
+    self->next_sector = CACHE_NO_BLOCK;
+    return self;
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================ */
+
+int sacd_input_open_cache(sacd_input_t *inner,
+                          const sacd_input_cache_config_t *config,
+                          sacd_input_t **out)
+{
+    sacd_input_cache_config_t cfg = {
+        .block_sectors    = SACD_INPUT_CACHE_BLOCK_SECTORS,
+        .max_blocks       = SACD_INPUT_CACHE_MAX_BLOCKS,
+        .readahead_blocks = SACD_INPUT_CACHE_READAHEAD_BLOCKS,
+        .shard_count      = SACD_INPUT_CACHE_SHARDS,
+    };
+    sacd_cache_core_t *core;
+    sacd_input_cache_t *self;
+
+    if (!inner || !inner->ops || !out) {
+        return SACD_INPUT_ERR_INVALID_ARG;
+    }
+    *out = NULL;
+
+    if (config) {
+        if (config->block_sectors) {
+            cfg.block_sectors = config->block_sectors;
+        }
+        if (config->max_blocks) {
+            cfg.max_blocks = config->max_blocks;
+        }
+        if (config->shard_count) {
+            cfg.shard_count = config->shard_count;
+        }
+        cfg.readahead_blocks = config->readahead_blocks;
+    }
+    if (cfg.shard_count > cfg.max_blocks) {
+        cfg.shard_count = cfg.max_blocks;
+    }
+
+    core = _cache_core_new(inner, &cfg);
+    if (!core) {
+        return SACD_INPUT_ERR_OUT_OF_MEMORY;
+    }
+
+    self = _cache_handle_new(core, inner);
+    if (!self) {
+        _cache_core_release(core);
+        return SACD_INPUT_ERR_OUT_OF_MEMORY;
+    }
+
+    *out = (sacd_input_t *)self;
+    return SACD_INPUT_OK;
+}
+
+int sacd_input_cache_get_stats(sacd_input_t *input, sacd_input_cache_stats_t *stats)
+{
+    sacd_input_cache_t *cself = (sacd_input_cache_t *)input;
+
+    if (!input || !stats) {
+        return SACD_INPUT_ERR_NULL_PTR;
+    }
+    if (input->ops != &_cache_input_ops && input->ops != &_cache_input_ops_plain) {
+        return SACD_INPUT_ERR_NOT_SUPPORTED;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    for (uint32_t i = 0; i < cself->core->shard_count; i++) {
+        cache_shard_t *shard = &cself->core->shards[i];
+        mtx_lock(&shard->lock);
+        stats->hits += shard->hits;
+        stats->misses += shard->misses;
+        stats->readahead += shard->readahead;
+        stats->readahead_hits += shard->readahead_hits;
+        stats->evictions += shard->evictions;
+        stats->cached_blocks += shard->count;
+        mtx_unlock(&shard->lock);
+    }
+    stats->block_sectors = cself->core->block_sectors;
+
+    return SACD_INPUT_OK;
+}
+
+/* ============================================================================
+ * Vtable Functions
+ * ============================================================================ */
+
+/**
+ * @brief Read sectors, block by block, through the cache.
+ *
+ * Misses read the whole surrounding block from the input. If the input
+ * fails on a block, the requested sectors are read from it directly so
+ * the caller sees the same result as without the cache.
+ */
+static int _cache_read_sectors(sacd_input_t *self, uint32_t sector_pos,
+                               uint32_t sector_count, void *buffer,
+                               uint32_t *sectors_read)
+{
+    sacd_input_cache_t *cself = (sacd_input_cache_t *)self;
+    sacd_cache_core_t *core = cself->core;
+    uint8_t *dst = (uint8_t *)buffer;
+    uint32_t done = 0;
+
+    *sectors_read = 0;
+
+    while (done < sector_count) {
+        uint32_t sector = sector_pos + done;
+        uint32_t block_no = sector / core->block_sectors;
+        uint32_t offset = sector % core->block_sectors;
+        uint32_t want = core->block_sectors - offset;
+        uint8_t *out = dst + (size_t)done * core->sector_size;
+        int copied;
+
+        if (want > sector_count - done) {
+            want = sector_count - done;
+        }
+
+        copied = _cache_copy(core, block_no, offset, want, out, NULL);
+        if (copied < 0 && core->readahead_blocks > 0) {
+            _cache_wait_inflight(core, block_no);
+            copied = _cache_copy(core, block_no, offset, want, out, NULL);
+        }
+
+        if (copied < 0) {
+            int err;
+            cache_block_t *block = _cache_load(core, cself->inner, block_no, &err);
+            if (!block) {
+                break;
+            }
+            copied = _cache_copy(core, block_no, offset, want, out, block);
+        }
+
+        done += (uint32_t)copied;
+        if ((uint32_t)copied < want) {
+            break;
+        }
+    }
+
+    if (done < sector_count && done == 0) {
+        /* Let the input report its own error (or end of disc) */
+        int res;
+        if (core->io_shared) {
+            mtx_lock(&core->io_lock);
+        }
+        res = sacd_input_read_sectors(cself->inner, sector_pos, sector_count,
+                                      buffer, sectors_read);
+        if (core->io_shared) {
+            mtx_unlock(&core->io_lock);
+        }
+        self->last_error = (sacd_input_error_t)res;
+        return res;
+    }
+
+    *sectors_read = done;
+    _cache_track_stream(cself, sector_pos, done);
+    self->last_error = SACD_INPUT_OK;
+    return SACD_INPUT_OK;
+}
+
+/**
+ * @brief Create another handle sharing the cache.
+ *
+ * Requires the wrapped input to support sacd_input_dup() itself.
+ */
+static int _cache_dup(sacd_input_t *self, sacd_input_t **out)
+{
+    sacd_input_cache_t *cself = (sacd_input_cache_t *)self;
+    sacd_input_cache_t *copy;
+    sacd_input_t *inner;
+    int res;
+
+    res = sacd_input_dup(cself->inner, &inner);
+    if (res != SACD_INPUT_OK) {
+        return res;
+    }
+
+    atomic_fetch_add(&cself->core->refcount, 1);
+    copy = _cache_handle_new(cself->core, inner);
+    if (!copy) {
+        _cache_core_release(cself->core);
+        sacd_input_close(inner);
+        *out = NULL;
+        return SACD_INPUT_ERR_OUT_OF_MEMORY;
+    }
+
+    *out = (sacd_input_t *)copy;
+    return SACD_INPUT_OK;
+}
+
+/**
+ * @brief Close the handle and its wrapped input; the cache goes with the
+ *        last handle.
+ */
+static int _cache_close(sacd_input_t *self)
+{
+    sacd_input_cache_t *cself = (sacd_input_cache_t *)self;
+
+    if (!cself) {
+        return SACD_INPUT_ERR_NULL_PTR;
+    }
+
+    /* The worker may be reading through this handle's input */
+    _cache_core_release(cself->core);
+    sacd_input_close(cself->inner);
+
+    sa_free(cself);
+    return SACD_INPUT_OK;
+}
+
+static uint32_t _cache_total_sectors(sacd_input_t *self)
+{
+    return sacd_input_total_sectors(((sacd_input_cache_t *)self)->inner);
+}
+
+static int _cache_authenticate(sacd_input_t *self)
+{
+    return sacd_input_authenticate(((sacd_input_cache_t *)self)->inner);
+}
+
+/**
+ * @brief Decrypt through the wrapped input.
+ *
+ * The cache holds sectors as the input returned them, so decryption
+ * stays with the caller's copy.
+ */
+static int _cache_decrypt(sacd_input_t *self, uint8_t *buffer, uint32_t block_count)
+{
+    return sacd_input_decrypt(((sacd_input_cache_t *)self)->inner, buffer,
+                              block_count);
+}
+
+static const char *_cache_get_error(sacd_input_t *self)
+{
+    return sacd_input_get_error(((sacd_input_cache_t *)self)->inner);
+}
+
+static int _cache_get_sector_format(sacd_input_t *self, sacd_sector_format_t *format)
+{
+    return sacd_input_get_sector_format(((sacd_input_cache_t *)self)->inner, format);
+}
+
+static int _cache_get_sector_size(sacd_input_t *self, uint32_t *size)
+{
+    return sacd_input_get_sector_size(((sacd_input_cache_t *)self)->inner, size);
+}
+
+static int _cache_get_header_size(sacd_input_t *self, int16_t *size)
+{
+    return sacd_input_get_header_size(((sacd_input_cache_t *)self)->inner, size);
+}
+
+static int _cache_get_trailer_size(sacd_input_t *self, int16_t *size)
+{
+    return sacd_input_get_trailer_size(((sacd_input_cache_t *)self)->inner, size);
+}
+
+/**
+ * @brief Expose the wrapped input's memory, if it has any.
+ *
+ * Cached blocks can be evicted at any time, so they are never handed out.
+ */
+static int _cache_get_sector_ptr(sacd_input_t *self, uint32_t sector_pos,
+                                 uint32_t sector_count, const uint8_t **ptr,
+                                 uint32_t *sectors_available)
+{
+    return sacd_input_get_sector_ptr(((sacd_input_cache_t *)self)->inner,
+                                     sector_pos, sector_count, ptr,
+                                     sectors_available);
+}
@@ -5,6 +5,11 @@
  * @brief File-based input implementation for SACD reading.
  * This implementation reads sector data from disc image files (ISO format).
  * Supports 64-bit file sizes on both Windows and POSIX platforms.
+ * Sectors are read with positional reads. On 64-bit builds a read-only
+ * mapping of the image also backs the zero-copy sector pointers, as long
+ * as the file keeps the size and modification time it was opened with.
+ * Handles created with sacd_input_dup() share the open file, and reads are
+ * safe to issue from several threads at once.
  *
  * DSD-Nexus is free software; you can redistribute it and/or
  * modify it under the terms of the GNU Lesser General Public
@@ -30,20 +35,59 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <errno.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * @brief Map files into memory only where the address space is large enough.
+ */
+#if SIZE_MAX > UINT32_MAX
+#define SACD_FILE_USE_MMAP 1
+#endif
+
+/**
+ * @struct sacd_file_source_t
+ * @brief Open disc image shared by all handles created with sacd_input_dup().
+ *
+ * Immutable after open (the sector format is detected up front), except
+ * for the map_stale flag, so any number of threads may read through it
+ * concurrently: positional reads do not touch a shared file offset.
+ */
+typedef struct sacd_file_source {
+    atomic_int   refcount;          /**< Handles using this source */
+#ifdef _WIN32
+    HANDLE       handle;            /**< File handle */
+    HANDLE       mapping;           /**< File mapping object, or NULL */
+#else
+    int          fd;                /**< File descriptor */
+#endif
+    const uint8_t *map;             /**< Read-only view of the whole file, or NULL */
+    atomic_bool  map_stale;         /**< File changed, map no longer handed out */
+    uint64_t     file_size;         /**< File size in bytes */
+    uint64_t     file_mtime;        /**< Modification time at open */
+    sacd_sector_format_t sector_format; /**< Detected sector format */
+    bool         format_detected;   /**< True if an SACD signature was found */
+} sacd_file_source_t;
+
 /**
  * @struct sacd_input_file_t
  * @brief Extended structure for file-based input.
  *
- * The base struct MUST be the first member for safe casting.
+ * The base struct MUST be the first member for safe casting. Each handle
+ * has its own error state; the file itself lives in the shared source.
  */
 typedef struct sacd_input_file {
     sacd_input_t base;              /**< Base structure (must be first!) */
-    FILE        *fp;                /**< File pointer */
-    uint64_t     file_size;         /**< File size in bytes */
-    sacd_sector_format_t sector_format; /**< Detected sector format */
-    bool         format_detected;   /**< True if format has been detected */
+    sacd_file_source_t *src;        /**< Shared file source */
 } sacd_input_file_t;
 
 /* Forward declarations of vtable functions */
@@ -60,6 +104,12 @@ static int          _file_get_trailer_size(sacd_input_t *self, int16_t *size);
 static int          _file_read_sectors(sacd_input_t *self, uint32_t sector_pos,
                                        uint32_t sector_count, void *buffer,
                                        uint32_t *sectors_read);
+static int          _file_get_sector_ptr(sacd_input_t *self, uint32_t sector_pos,
+                                         uint32_t sector_count, const uint8_t **ptr,
+                                         uint32_t *sectors_available);
+static int          _file_dup(sacd_input_t *self, sacd_input_t **out);
+
+static void         _file_detect_sector_format(sacd_file_source_t *src);
 
 /**
  * @brief Static vtable for file input instances.
@@ -76,6 +126,9 @@ static const sacd_input_ops_t _file_input_ops = {
     .get_sector_size   = _file_get_sector_size,
     .get_header_size   = _file_get_header_size,
     .get_trailer_size  = _file_get_trailer_size,
+    /* Shared access */
+    .get_sector_ptr    = _file_get_sector_ptr,
+    .dup               = _file_dup,
 };
 
 /**
@@ -92,13 +145,114 @@ static void _file_set_error(sacd_input_file_t *self, sacd_input_error_t code,
     va_end(args);
 }
 
+/**
+ * @brief Query the current size and modification time of the source file.
+ *
+ * @return true on success
+ */
+static bool _file_source_stat(sacd_file_source_t *src, uint64_t *size,
+                              uint64_t *mtime)
+{
+#ifdef _WIN32
+    BY_HANDLE_FILE_INFORMATION info;
+
+    if (!GetFileInformationByHandle(src->handle, &info)) {
+        return false;
+    }
+    *size = ((uint64_t)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+    *mtime = ((uint64_t)info.ftLastWriteTime.dwHighDateTime << 32) |
+             info.ftLastWriteTime.dwLowDateTime;
+#else
+    struct stat st;
+
+    if (fstat(src->fd, &st) != 0 || st.st_size < 0) {
+        return false;
+    }
+    *size = (uint64_t)st.st_size;
+    *mtime = (uint64_t)st.st_mtime;
+#endif
+    return true;
+}
+
+#if defined(_WIN32) && defined(SACD_FILE_USE_MMAP)
+/**
+ * @brief Check whether a file lives on a network share.
+ */
+static bool _file_is_remote(HANDLE handle)
+{
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0601
+    FILE_REMOTE_PROTOCOL_INFO info;
+
+    /* Only succeeds for files opened through a network redirector */
+    return GetFileInformationByHandleEx(handle, FileRemoteProtocolInfo,
+                                        &info, sizeof(info)) != 0;
+#else
+    (void)handle;
+    return true;
+#endif
+}
+#endif
+
+/**
+ * @brief Release the OS resources of a source and free it.
+ */
+static void _file_source_free(sacd_file_source_t *src)
+{
+#ifdef _WIN32
+    if (src->map) {
+        UnmapViewOfFile((LPCVOID)src->map);
+    }
+    if (src->mapping) {
+        CloseHandle(src->mapping);
+    }
+    if (src->handle != INVALID_HANDLE_VALUE) {
+        CloseHandle(src->handle);
+    }
+#else
+    if (src->map) {
+        munmap((void *)src->map, (size_t)src->file_size);
+    }
+    if (src->fd >= 0) {
+        close(src->fd);
+    }
+#endif
+    sa_free(src);
+}
+
+/**
+ * @brief Drop one reference to a source.
+ */
+static void _file_source_release(sacd_file_source_t *src)
+{
+    if (src && atomic_fetch_sub(&src->refcount, 1) == 1) {
+        _file_source_free(src);
+    }
+}
+
+/**
+ * @brief Create a handle on a source (takes over one reference).
+ */
+static sacd_input_file_t *_file_handle_new(sacd_file_source_t *src)
+{
+    sacd_input_file_t *self = (sacd_input_file_t *)sa_calloc(1, sizeof(*self));
+    if (!self) {
+        return NULL;
+    }
+
+    self->base.ops  = &_file_input_ops;
+    self->base.type = SACD_INPUT_TYPE_FILE;
+    self->base.last_error = SACD_INPUT_OK;
+    self->src = src;
+    return self;
+}
+
 /**
  * @brief Open a file-based input.
  */
 int sacd_input_open_file(const char *path, sacd_input_t **out)
 {
     sacd_input_file_t *self;
-    int64_t size;
+    sacd_file_source_t *src;
 
     if (!path || !out) {
         return SACD_INPUT_ERR_INVALID_ARG;
@@ -107,54 +261,110 @@ int sacd_input_open_file(const char *path, sacd_input_t **out)
     *out = NULL;
 
     /* Allocate structure */
-    self = (sacd_input_file_t *)sa_calloc(1, sizeof(*self));
-    if (!self) {
+    src = (sacd_file_source_t *)sa_calloc(1, sizeof(*src));
+    if (!src) {
         return SACD_INPUT_ERR_OUT_OF_MEMORY;
     }
+    atomic_init(&src->refcount, 1);
+    atomic_init(&src->map_stale, false);
 
-    /* Initialize base */
-    self->base.ops  = &_file_input_ops;
-    self->base.type = SACD_INPUT_TYPE_FILE;
-    self->base.last_error = SACD_INPUT_OK;
-    self->fp = NULL;
+#ifdef _WIN32
+    {
+        /* CreateFile_utf8 handles UTF-8 paths */
+        src->handle = CreateFile_utf8(path, GENERIC_READ,
+                                      FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                      NULL, OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL, NULL);
+        if (src->handle == INVALID_HANDLE_VALUE) {
+            sa_free(src);
+            return SACD_INPUT_ERR_OPEN_FAILED;
+        }
+        if (!_file_source_stat(src, &src->file_size, &src->file_mtime)) {
+            _file_source_free(src);
+            return SACD_INPUT_ERR_OPEN_FAILED;
+        }
 
-    /* Open file (sa_fopen handles UTF-8 paths on Windows) */
-    self->fp = sa_fopen(path, "rb");
-    if (!self->fp) {
-        _file_set_error(self, SACD_INPUT_ERR_OPEN_FAILED,
-                        "failed to open file: %s (%s)", path, strerror(errno));
-        sa_free(self);
-        return SACD_INPUT_ERR_OPEN_FAILED;
+#ifdef SACD_FILE_USE_MMAP
+        /* Local files only: a lost network share faults on mapped pages */
+        if (src->file_size > 0 && !_file_is_remote(src->handle)) {
+            src->mapping = CreateFileMappingW(src->handle, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (src->mapping) {
+                src->map = (const uint8_t *)MapViewOfFile(src->mapping, FILE_MAP_READ, 0, 0, 0);
+            }
+        }
+#endif
+    }
+#else
+    {
+        struct stat st;
+        int flags = O_RDONLY;
+#ifdef O_CLOEXEC
+        flags |= O_CLOEXEC;
+#endif
+
+        src->fd = open(path, flags);
+        if (src->fd < 0) {
+            sa_free(src);
+            return SACD_INPUT_ERR_OPEN_FAILED;
+        }
+        if (fstat(src->fd, &st) != 0 || st.st_size < 0) {
+            _file_source_free(src);
+            return SACD_INPUT_ERR_OPEN_FAILED;
+        }
+        src->file_size = (uint64_t)st.st_size;
+        src->file_mtime = (uint64_t)st.st_mtime;
+
+#ifdef SACD_FILE_USE_MMAP
+        /* Regular files only; devices and pipes use positional reads */
+        if (S_ISREG(st.st_mode) && src->file_size > 0) {
+            void *map = mmap(NULL, (size_t)src->file_size, PROT_READ, MAP_SHARED, src->fd, 0);
+            if (map != MAP_FAILED) {
+                src->map = (const uint8_t *)map;
+            }
+        }
+#endif
     }
+#endif
+
+    /* Detect the format now so the source stays read-only afterwards */
+    _file_detect_sector_format(src);
 
-    /* Get file size via seek */
-    if (sa_fseek64(self->fp, 0, SEEK_END) != 0) {
-        _file_set_error(self, SACD_INPUT_ERR_OPEN_FAILED,
-                        "failed to seek file: %s (%s)", path, strerror(errno));
-        fclose(self->fp);
-        sa_free(self);
-        return SACD_INPUT_ERR_OPEN_FAILED;
+    self = _file_handle_new(src);
+    if (!self) {
+        _file_source_release(src);
+        return SACD_INPUT_ERR_OUT_OF_MEMORY;
     }
 
-    size = sa_ftell64(self->fp);
-    if (size < 0) {
-        _file_set_error(self, SACD_INPUT_ERR_OPEN_FAILED,
-                        "failed to get file size: %s (%s)", path, strerror(errno));
-        fclose(self->fp);
-        sa_free(self);
-        return SACD_INPUT_ERR_OPEN_FAILED;
+    *out = (sacd_input_t *)self;
+    return SACD_INPUT_OK;
+}
+
+/**
+ * @brief Create another handle sharing the same open file.
+ */
+static int _file_dup(sacd_input_t *self, sacd_input_t **out)
+{
+    sacd_input_file_t *fself = (sacd_input_file_t *)self;
+    sacd_input_file_t *copy;
+
+    if (!fself || !out) {
+        return SACD_INPUT_ERR_NULL_PTR;
     }
-    self->file_size = (uint64_t)size;
 
-    /* Seek back to beginning */
-    sa_fseek64(self->fp, 0, SEEK_SET);
+    atomic_fetch_add(&fself->src->refcount, 1);
+    copy = _file_handle_new(fself->src);
+    if (!copy) {
+        _file_source_release(fself->src);
+        *out = NULL;
+        return SACD_INPUT_ERR_OUT_OF_MEMORY;
+    }
 
-    *out = (sacd_input_t *)self;
+    *out = (sacd_input_t *)copy;
     return SACD_INPUT_OK;
 }
 
 /**
- * @brief Close file and free resources.
+ * @brief Close the handle; the file is closed with its last handle.
  */
 static int _file_close(sacd_input_t *self)
 {
@@ -164,10 +374,8 @@ static int _file_close(sacd_input_t *self)
         return SACD_INPUT_ERR_NULL_PTR;
     }
 
-    if (fself->fp) {
-        fclose(fself->fp);
-        fself->fp = NULL;
-    }
+    _file_source_release(fself->src);
+    fself->src = NULL;
 
     sa_free(fself);
     return SACD_INPUT_OK;
@@ -184,7 +392,7 @@ static uint32_t _file_total_sectors(sacd_input_t *self)
         return 0;
     }
 
-    return (uint32_t)(fself->file_size / SACD_LSN_SIZE);
+    return (uint32_t)(fself->src->file_size / SACD_LSN_SIZE);
 }
 
 /**
@@ -203,6 +411,57 @@ static const char *_file_get_error(sacd_input_t *self)
     return sacd_input_error_string(self->last_error);
 }
 
+/**
+ * @brief Read bytes at a specific offset of a source.
+ *
+ * Uses positional reads, which do not touch shared state, so this is safe
+ * to call concurrently. The mapping is not used here: a file truncated or
+ * rewritten under it would fault instead of failing the read.
+ *
+ * @return Number of bytes read; less than @p size at end of file or on error
+ *         (errno / GetLastError() tells which)
+ */
+static size_t _file_source_read(sacd_file_source_t *src, uint64_t offset,
+                                size_t size, void *buffer)
+{
+    size_t done = 0;
+
+    if (offset >= src->file_size) {
+        return 0;
+    }
+    if (offset + size > src->file_size) {
+        size = (size_t)(src->file_size - offset);
+    }
+
+    while (done < size) {
+#ifdef _WIN32
+        OVERLAPPED ov;
+        DWORD chunk = (size - done > 0x40000000) ? 0x40000000 : (DWORD)(size - done);
+        DWORD got = 0;
+        uint64_t pos = offset + done;
+
+        memset(&ov, 0, sizeof(ov));
+        ov.Offset = (DWORD)pos;
+        ov.OffsetHigh = (DWORD)(pos >> 32);
+        if (!ReadFile(src->handle, (uint8_t *)buffer + done, chunk, &got, &ov) || got == 0) {
+            break;
+        }
+#else
+        ssize_t got = pread(src->fd, (uint8_t *)buffer + done, size - done,
+                            (off_t)(offset + done));
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            break;
+        }
+#endif
+        done += (size_t)got;
+    }
+
+    return done;
+}
+
 /**
  * @brief Read bytes at a specific offset.
  *
@@ -212,40 +471,25 @@ static size_t _file_read_bytes(sacd_input_t *self, uint64_t offset,
                                size_t size, void *buffer)
 {
     sacd_input_file_t *fself = (sacd_input_file_t *)self;
+    size_t bytes_read;
 
     if (!fself || !buffer || size == 0) {
         return 0;
     }
 
     /* Check bounds */
-    if (offset >= fself->file_size) {
+    if (offset >= fself->src->file_size) {
         fself->base.last_error = SACD_INPUT_ERR_EOF;
         return 0;
     }
 
-    /* Clamp to available bytes */
-    if (offset + size > fself->file_size) {
-        size = (size_t)(fself->file_size - offset);
-    }
-
-    if (sa_fseek64(fself->fp, (int64_t)offset, SEEK_SET) != 0) {
-        fself->base.last_error = SACD_INPUT_ERR_SEEK_FAILED;
-        snprintf(fself->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE,
-                 "seek failed at offset %llu", (unsigned long long)offset);
-        return 0;
+    bytes_read = _file_source_read(fself->src, offset, size, buffer);
+    if (bytes_read == 0) {
+        _file_set_error(fself, SACD_INPUT_ERR_READ_FAILED,
+                        "read failed at offset %llu", (unsigned long long)offset);
     }
 
-    {
-        size_t bytes_read = fread(buffer, 1, size, fself->fp);
-        if (bytes_read == 0 && ferror(fself->fp)) {
-            fself->base.last_error = SACD_INPUT_ERR_READ_FAILED;
-            snprintf(fself->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE,
-                     "read failed at offset %llu", (unsigned long long)offset);
-            return 0;
-        }
-
-        return bytes_read;
-    }
+    return bytes_read;
 }
 
 
@@ -277,11 +521,11 @@ static const sector_format_info_t _sector_format_table[] = {
  *
  * Reads from sector 510 (Master TOC location) and checks for the signature.
  *
- * @param[in]  fself   File input structure
+ * @param[in]  src     File source
  * @param[in]  format  Sector format to test
  * @return true if SACD signature found, false otherwise
  */
-static bool _file_check_sacd_signature(sacd_input_file_t *fself,
+static bool _file_check_sacd_signature(sacd_file_source_t *src,
                                         sacd_sector_format_t format)
 {
     uint8_t buffer[20];
@@ -291,6 +535,7 @@ static bool _file_check_sacd_signature(sacd_input_file_t *fself,
     size_t bytes_read;
     uint32_t sector_size;
     int16_t header_size;
+    uint64_t signature;
 
     if (format > SACD_SECTOR_2064) {
         return false;
@@ -311,30 +556,25 @@ static bool _file_check_sacd_signature(sacd_input_file_t *fself,
         signature_offset = 0;
     }
 
-    /* Read using the existing read_bytes function */
-    bytes_read = _file_read_bytes((sacd_input_t *)fself, offset,
-                                   bytes_to_read, buffer);
+    bytes_read = _file_source_read(src, offset, bytes_to_read, buffer);
     if (bytes_read != bytes_to_read) {
         return false;
     }
 
     /* Check for SACD Master TOC signature */
-    if (*(uint64_t *)(buffer + signature_offset) == MASTER_TOC_SIGN) {
-        return true;
-    }
-
-    return false;
+    memcpy(&signature, buffer + signature_offset, sizeof(signature));
+    return signature == MASTER_TOC_SIGN;
 }
 
 /**
  * @brief Detect the SACD sector format of the file.
  *
  * Tries each format in order (2064, 2054, 2048) until signature is found.
+ * Called once at open; the result is shared by all handles.
  *
- * @param[in]  fself  File input structure
- * @return true if a valid format was detected, false otherwise
+ * @param[in,out] src  File source
  */
-static bool _file_detect_sector_format(sacd_input_file_t *fself)
+static void _file_detect_sector_format(sacd_file_source_t *src)
 {
     /* Try formats in order: 2064, 2054, 2048 */
     static const sacd_sector_format_t formats[] = {
@@ -344,17 +584,16 @@ static bool _file_detect_sector_format(sacd_input_file_t *fself)
     };
 
     for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
-        if (_file_check_sacd_signature(fself, formats[i])) {
-            fself->sector_format = formats[i];
-            fself->format_detected = true;
-            return true;
+        if (_file_check_sacd_signature(src, formats[i])) {
+            src->sector_format = formats[i];
+            src->format_detected = true;
+            return;
         }
     }
 
     /* Default to 2048 if no signature found (might not be SACD) */
-    fself->sector_format = SACD_SECTOR_2048;
-    fself->format_detected = false;
-    return false;
+    src->sector_format = SACD_SECTOR_2048;
+    src->format_detected = false;
 }
 
 /**
@@ -369,12 +608,7 @@ static int _file_get_sector_format(sacd_input_t *self,
         return SACD_INPUT_ERR_NULL_PTR;
     }
 
-    /* Detect format on first call if not already done */
-    if (!fself->format_detected) {
-        _file_detect_sector_format(fself);
-    }
-
-    *format = fself->sector_format;
+    *format = fself->src->sector_format;
     return SACD_INPUT_OK;
 }
 
@@ -389,12 +623,7 @@ static int _file_get_sector_size(sacd_input_t *self, uint32_t *size)
         return SACD_INPUT_ERR_NULL_PTR;
     }
 
-    /* Detect format on first call if not already done */
-    if (!fself->format_detected) {
-        _file_detect_sector_format(fself);
-    }
-
-    *size = _sector_format_table[fself->sector_format].sector_size;
+    *size = _sector_format_table[fself->src->sector_format].sector_size;
     return SACD_INPUT_OK;
 }
 
@@ -409,12 +638,7 @@ static int _file_get_header_size(sacd_input_t *self, int16_t *size)
         return SACD_INPUT_ERR_NULL_PTR;
     }
 
-    /* Detect format on first call if not already done */
-    if (!fself->format_detected) {
-        _file_detect_sector_format(fself);
-    }
-
-    *size = _sector_format_table[fself->sector_format].header_size;
+    *size = _sector_format_table[fself->src->sector_format].header_size;
     return SACD_INPUT_OK;
 }
 
@@ -429,12 +653,7 @@ static int _file_get_trailer_size(sacd_input_t *self, int16_t *size)
         return SACD_INPUT_ERR_NULL_PTR;
     }
 
-    /* Detect format on first call if not already done */
-    if (!fself->format_detected) {
-        _file_detect_sector_format(fself);
-    }
-
-    *size = _sector_format_table[fself->sector_format].trailer_size;
+    *size = _sector_format_table[fself->src->sector_format].trailer_size;
     return SACD_INPUT_OK;
 }
 
@@ -461,25 +680,20 @@ static int _file_read_sectors(sacd_input_t *self, uint32_t sector_pos,
         return SACD_INPUT_OK;
     }
 
-    /* Detect format on first call if not already done */
-    if (!fself->format_detected) {
-        _file_detect_sector_format(fself);
-    }
-
-    sector_size = _sector_format_table[fself->sector_format].sector_size;
+    sector_size = _sector_format_table[fself->src->sector_format].sector_size;
     offset = (uint64_t)sector_pos * sector_size;
     bytes_to_read = (size_t)sector_count * sector_size;
 
     /* Check bounds */
-    if (offset >= fself->file_size) {
+    if (offset >= fself->src->file_size) {
         *sectors_read = 0;
         fself->base.last_error = SACD_INPUT_ERR_EOF;
         return SACD_INPUT_ERR_EOF;
     }
 
     /* Clamp to available bytes */
-    if (offset + bytes_to_read > fself->file_size) {
-        bytes_to_read = (size_t)(fself->file_size - offset);
+    if (offset + bytes_to_read > fself->src->file_size) {
+        bytes_to_read = (size_t)(fself->src->file_size - offset);
     }
 
     /* Read using the existing read_bytes function */
@@ -492,3 +706,67 @@ static int _file_read_sectors(sacd_input_t *self, uint32_t sector_pos,
 
     return SACD_INPUT_OK;
 }
+
+/**
+ * @brief Check that the file still matches the mapping made at open.
+ *
+ * Touching mapped pages past a truncation raises SIGBUS (or an in-page
+ * exception on Windows), so once the size or modification time changes the
+ * mapping is retired and callers fall back to sacd_input_read_sectors(),
+ * which reports the change as a read error instead.
+ */
+static bool _file_map_valid(sacd_file_source_t *src)
+{
+    uint64_t size;
+    uint64_t mtime;
+
+    if (atomic_load(&src->map_stale)) {
+        return false;
+    }
+    if (_file_source_stat(src, &size, &mtime) &&
+        size == src->file_size && mtime == src->file_mtime) {
+        return true;
+    }
+
+    atomic_store(&src->map_stale, true);
+    return false;
+}
+
+/**
+ * @brief Point directly at sectors in the file mapping (zero-copy).
+ */
+static int _file_get_sector_ptr(sacd_input_t *self, uint32_t sector_pos,
+                                uint32_t sector_count, const uint8_t **ptr,
+                                uint32_t *sectors_available)
+{
+    sacd_input_file_t *fself = (sacd_input_file_t *)self;
+    uint32_t sector_size;
+    uint64_t offset;
+    uint64_t available;
+
+    if (!fself || !ptr || !sectors_available) {
+        return SACD_INPUT_ERR_NULL_PTR;
+    }
+
+    *ptr = NULL;
+    *sectors_available = 0;
+
+    if (!fself->src->map || !_file_map_valid(fself->src)) {
+        return SACD_INPUT_ERR_NOT_SUPPORTED;
+    }
+
+    sector_size = _sector_format_table[fself->src->sector_format].sector_size;
+    offset = (uint64_t)sector_pos * sector_size;
+    if (offset >= fself->src->file_size) {
+        return SACD_INPUT_ERR_EOF;
+    }
+
+    available = (fself->src->file_size - offset) / sector_size;
+    if (available == 0) {
+        return SACD_INPUT_ERR_EOF;
+    }
+
+    *ptr = fself->src->map + offset;
+    *sectors_available = (available < sector_count) ? (uint32_t)available : sector_count;
+    return SACD_INPUT_OK;
+}
@@ -40,8 +40,32 @@
 #include <pb_decode.h>
 #include "sacd_ripper.pb.h"
 
-/* Maximum sectors to read in a single request */
-#define MAX_PROCESSING_BLOCK_SIZE 256
+/* Largest DISC_READ request the server answers in one response */
+#define NETWORK_MAX_CHUNK_SECTORS 500
+
+/**
+ * @brief Destination of the ServerResponse.data bytes callback.
+ */
+typedef struct network_sink {
+    uint8_t        *dest;           /**< Where the payload is written */
+    size_t          capacity;       /**< Bytes available at dest */
+    size_t          size;           /**< Bytes received */
+} network_sink_t;
+
+/**
+ * @brief One DISC_READ request that has been sent to the server.
+ *
+ * Responses arrive in the order the requests were sent, so the requests
+ * form a FIFO ring; the payload of a received response is kept in @c data
+ * until the reader has consumed it.
+ */
+typedef struct network_request {
+    uint32_t        sector_pos;     /**< First sector requested */
+    uint32_t        sector_count;   /**< Number of sectors requested */
+    uint32_t        sectors;        /**< Sectors delivered by the server */
+    bool            received;       /**< Response has been decoded */
+    uint8_t        *data;           /**< Payload (sector_count * 2048 bytes) */
+} network_request_t;
 
 /**
  * @struct sacd_input_network_t
@@ -53,7 +77,15 @@ typedef struct sacd_input_network {
     sacd_input_t    base;           /**< Base structure (must be first!) */
     TcsSocket       sock;           /**< tinycsocket socket descriptor */
     uint32_t        total_sectors;  /**< Cached total sector count */
-    uint8_t        *input_buffer;   /**< Buffer for protobuf responses */
+    network_request_t requests[SACD_NETWORK_MAX_WINDOW]; /**< In-flight ring */
+    uint8_t        *request_data;   /**< Payload storage for the ring */
+    uint32_t        req_head;       /**< Oldest in-flight request */
+    uint32_t        req_count;      /**< Number of in-flight requests */
+    uint32_t        window;         /**< Maximum in-flight requests */
+    uint32_t        chunk_sectors;  /**< Sectors per request */
+    uint32_t        issue_pos;      /**< Sector after the newest request */
+    uint32_t        next_sector;    /**< Sector after the previous read */
+    uint32_t        sequential_reads; /**< Consecutive sequential reads */
     char            host[256];      /**< Server hostname (for error messages) */
     uint16_t        port;           /**< Server port */
     bool            connected;      /**< Connection status */
@@ -135,6 +167,207 @@ static bool _send_all(TcsSocket sock, const void *buf, size_t len)
     return true;
 }
 
+/**
+ * @brief nanopb callback for ServerResponse.data.
+ *
+ * Reads the payload straight from the socket into the sink, so sector data
+ * is never staged in an intermediate response buffer.
+ */
+static bool _network_decode_data(pb_istream_t *stream, const pb_field_t *field,
+                                 void **arg)
+{
+    network_sink_t *sink = (network_sink_t *)*arg;
+    size_t len = stream->bytes_left;
+
+    (void)field;
+
+    if (!sink || len > sink->capacity)
+    {
+        PB_RETURN_ERROR(stream, "data exceeds request");
+    }
+
+    if (!pb_read(stream, sink->dest, len))
+    {
+        return false;
+    }
+
+    sink->size = len;
+    return true;
+}
+
+/**
+ * @brief Decode one zero-terminated ServerResponse from the socket.
+ *
+ * Any data payload is discarded unless response->data has a decode callback.
+ */
+static bool _network_decode_response(TcsSocket sock, ServerResponse *response)
+{
+    pb_istream_t input = pb_istream_from_tcs_socket(sock);
+
+    return pb_decode_ex(&input, ServerResponse_fields, response,
+                        PB_DECODE_NULLTERMINATED);
+}
+
+/**
+ * @brief (Re)allocate the payload storage of the request ring.
+ *
+ * Must only be called while no request is in flight.
+ */
+static int _network_alloc_requests(sacd_input_network_t *nself,
+                                   uint32_t window, uint32_t chunk_sectors)
+{
+    size_t slot_size = (size_t)chunk_sectors * SACD_LSN_SIZE;
+    uint8_t *data = (uint8_t *)sa_malloc(slot_size * window);
+    uint32_t i;
+
+    if (!data)
+    {
+        return SACD_INPUT_ERR_OUT_OF_MEMORY;
+    }
+
+    sa_free(nself->request_data);
+    nself->request_data = data;
+    nself->window = window;
+    nself->chunk_sectors = chunk_sectors;
+    nself->req_head = 0;
+    nself->req_count = 0;
+
+    for (i = 0; i < SACD_NETWORK_MAX_WINDOW; i++)
+    {
+        nself->requests[i].data = (i < window) ? data + slot_size * i : NULL;
+    }
+    return SACD_INPUT_OK;
+}
+
+/**
+ * @brief Mark the connection unusable after a protocol or socket failure.
+ *
+ * Once a response has been lost the request/response stream can no longer
+ * be matched up, so all further reads fail.
+ */
+static int _network_fail(sacd_input_network_t *nself, const char *what)
+{
+    nself->connected = false;
+    nself->req_count = 0;
+    nself->base.last_error = SACD_INPUT_ERR_NETWORK;
+    snprintf(nself->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE, "%s", what);
+    return SACD_INPUT_ERR_NETWORK;
+}
+
+/**
+ * @brief Send a DISC_READ request and append it to the request ring.
+ */
+static int _network_issue_read(sacd_input_network_t *nself,
+                               uint32_t sector_pos, uint32_t sector_count)
+{
+    uint8_t output_buf[32];
+    ServerRequest request;
+    pb_ostream_t output;
+    network_request_t *req;
+
+    output = pb_ostream_from_buffer(output_buf, sizeof(output_buf) - 1);
+
+    request.type = ServerRequest_Type_DISC_READ;
+    request.sector_offset = sector_pos;
+    request.sector_count = sector_count;
+
+    if (!pb_encode(&output, ServerRequest_fields, &request))
+    {
+        return _network_fail(nself, "failed to encode READ request");
+    }
+
+    /* Add terminating zero byte */
+    output_buf[output.bytes_written] = 0;
+
+    if (!_send_all(nself->sock, output_buf, output.bytes_written + 1))
+    {
+        return _network_fail(nself, "failed to send READ request");
+    }
+
+    req = &nself->requests[(nself->req_head + nself->req_count) % nself->window];
+    req->sector_pos = sector_pos;
+    req->sector_count = sector_count;
+    req->sectors = 0;
+    req->received = false;
+    nself->req_count++;
+    nself->issue_pos = sector_pos + sector_count;
+    return SACD_INPUT_OK;
+}
+
+/**
+ * @brief Receive the response to the oldest in-flight request.
+ *
+ * The payload is decoded directly into @p dest, which must hold
+ * sector_count sectors: either the request's own buffer or, when the
+ * request lies entirely inside the caller's read, the caller's buffer.
+ */
+static int _network_receive_head(sacd_input_network_t *nself, uint8_t *dest)
+{
+    network_request_t *req = &nself->requests[nself->req_head];
+    ServerResponse response = ServerResponse_init_zero;
+    network_sink_t sink;
+    uint32_t sectors = 0;
+
+    sink.dest = dest;
+    sink.capacity = (size_t)req->sector_count * SACD_LSN_SIZE;
+    sink.size = 0;
+    response.data.funcs.decode = _network_decode_data;
+    response.data.arg = &sink;
+
+    if (!_network_decode_response(nself->sock, &response))
+    {
+        return _network_fail(nself, "failed to decode READ response");
+    }
+
+    if (response.type != ServerResponse_Type_DISC_READ)
+    {
+        return _network_fail(nself, "unexpected response type for READ");
+    }
+
+    if (response.result > 0)
+    {
+        sectors = (uint32_t)(sink.size / SACD_LSN_SIZE);
+        if ((int64_t)sectors > response.result)
+        {
+            sectors = (uint32_t)response.result;
+        }
+    }
+
+    req->sectors = sectors;
+    req->received = true;
+    return SACD_INPUT_OK;
+}
+
+/**
+ * @brief Drop the oldest request from the ring.
+ */
+static void _network_pop_head(sacd_input_network_t *nself)
+{
+    nself->req_head = (nself->req_head + 1) % nself->window;
+    nself->req_count--;
+}
+
+/**
+ * @brief Receive and discard every outstanding response.
+ */
+static int _network_drain(sacd_input_network_t *nself)
+{
+    while (nself->req_count > 0)
+    {
+        if (!nself->requests[nself->req_head].received)
+        {
+            int rc = _network_receive_head(nself,
+                                           nself->requests[nself->req_head].data);
+            if (rc != SACD_INPUT_OK)
+            {
+                return rc;
+            }
+        }
+        _network_pop_head(nself);
+    }
+    return SACD_INPUT_OK;
+}
+
 /**
  * @brief Open a network socket input.
  */
@@ -143,7 +376,6 @@ int sacd_input_open_network(const char *host, uint16_t port, sacd_input_t **out)
     sacd_input_network_t *self;
     ServerRequest request;
     ServerResponse response = ServerResponse_init_zero;
-    pb_istream_t input;
     pb_ostream_t output;
     uint8_t zero = 0;
 
@@ -178,9 +410,8 @@ int sacd_input_open_network(const char *host, uint16_t port, sacd_input_t **out)
     self->total_sectors = 0;
     sa_strlcpy(self->host, host, sizeof(self->host));
 
-    /* Allocate input buffer for responses - must be large enough for ServerResponse struct */
-    self->input_buffer = (uint8_t *)sa_malloc(sizeof(ServerResponse));
-    if (!self->input_buffer)
+    if (_network_alloc_requests(self, SACD_NETWORK_DEFAULT_WINDOW,
+                                SACD_NETWORK_DEFAULT_CHUNK_SECTORS) != SACD_INPUT_OK)
     {
         sa_free(self);
         return SACD_INPUT_ERR_OUT_OF_MEMORY;
@@ -192,25 +423,25 @@ int sacd_input_open_network(const char *host, uint16_t port, sacd_input_t **out)
         snprintf(self->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE,
                  "failed to create socket");
         self->base.last_error = SACD_INPUT_ERR_NETWORK;
-        sa_free(self->input_buffer);
+        sa_free(self->request_data);
         sa_free(self);
         return SACD_INPUT_ERR_NETWORK;
     }
 
-    /* Connect to server */
-    if (tcs_connect_str(self->sock, host, port) != TCS_SUCCESS)
+    /* Connect to server (tinycsocket's parser may look past short strings,
+     * so hand it the zero-padded copy) */
+    if (tcs_connect_str(self->sock, self->host, port) != TCS_SUCCESS)
     {
         snprintf(self->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE,
                  "failed to connect to %s:%u", host, port);
         self->base.last_error = SACD_INPUT_ERR_NETWORK;
         tcs_close(&self->sock);
-        sa_free(self->input_buffer);
+        sa_free(self->request_data);
         sa_free(self);
         return SACD_INPUT_ERR_NETWORK;
     }
 
-    /* Create nanopb streams */
-    input = pb_istream_from_tcs_socket(self->sock);
+    /* Create nanopb stream */
     output = pb_ostream_from_tcs_socket(self->sock);
 
     /* Send DISC_OPEN request */
@@ -224,7 +455,7 @@ int sacd_input_open_network(const char *host, uint16_t port, sacd_input_t **out)
                  "failed to encode OPEN request");
         self->base.last_error = SACD_INPUT_ERR_NETWORK;
         tcs_close(&self->sock);
-        sa_free(self->input_buffer);
+        sa_free(self->request_data);
         sa_free(self);
         return SACD_INPUT_ERR_NETWORK;
     }
@@ -233,13 +464,13 @@ int sacd_input_open_network(const char *host, uint16_t port, sacd_input_t **out)
     pb_write(&output, &zero, 1);
 
     /* Read response */
-    if (!pb_decode(&input, ServerResponse_fields, &response))
+    if (!_network_decode_response(self->sock, &response))
     {
         snprintf(self->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE,
                  "failed to decode OPEN response");
         self->base.last_error = SACD_INPUT_ERR_NETWORK;
         tcs_close(&self->sock);
-        sa_free(self->input_buffer);
+        sa_free(self->request_data);
         sa_free(self);
         return SACD_INPUT_ERR_NETWORK;
     }
@@ -250,7 +481,7 @@ int sacd_input_open_network(const char *host, uint16_t port, sacd_input_t **out)
                  "server returned error on OPEN");
         self->base.last_error = SACD_INPUT_ERR_OPEN_FAILED;
         tcs_close(&self->sock);
-        sa_free(self->input_buffer);
+        sa_free(self->request_data);
         sa_free(self);
         return SACD_INPUT_ERR_OPEN_FAILED;
     }
@@ -260,7 +491,6 @@ int sacd_input_open_network(const char *host, uint16_t port, sacd_input_t **out)
         ServerRequest size_request;
         ServerResponse size_response = ServerResponse_init_zero;
 
-        input = pb_istream_from_tcs_socket(self->sock);
         output = pb_ostream_from_tcs_socket(self->sock);
 
         size_request.type = ServerRequest_Type_DISC_SIZE;
@@ -273,20 +503,20 @@ int sacd_input_open_network(const char *host, uint16_t port, sacd_input_t **out)
                      "failed to encode SIZE request");
             self->base.last_error = SACD_INPUT_ERR_NETWORK;
             tcs_close(&self->sock);
-            sa_free(self->input_buffer);
+            sa_free(self->request_data);
             sa_free(self);
             return SACD_INPUT_ERR_NETWORK;
         }
 
         pb_write(&output, &zero, 1);
 
-        if (!pb_decode(&input, ServerResponse_fields, &size_response))
+        if (!_network_decode_response(self->sock, &size_response))
         {
             snprintf(self->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE,
                      "failed to decode SIZE response");
             self->base.last_error = SACD_INPUT_ERR_NETWORK;
             tcs_close(&self->sock);
-            sa_free(self->input_buffer);
+            sa_free(self->request_data);
             sa_free(self);
             return SACD_INPUT_ERR_NETWORK;
         }
@@ -297,7 +527,7 @@ int sacd_input_open_network(const char *host, uint16_t port, sacd_input_t **out)
                      "unexpected response type for SIZE");
             self->base.last_error = SACD_INPUT_ERR_NETWORK;
             tcs_close(&self->sock);
-            sa_free(self->input_buffer);
+            sa_free(self->request_data);
             sa_free(self);
             return SACD_INPUT_ERR_NETWORK;
         }
@@ -346,11 +576,8 @@ static int _network_close(sacd_input_t *self)
         nself->sock = TCS_SOCKET_INVALID;
     }
 
-    if (nself->input_buffer)
-    {
-        sa_free(nself->input_buffer);
-        nself->input_buffer = NULL;
-    }
+    sa_free(nself->request_data);
+    nself->request_data = NULL;
 
     nself->connected = false;
     sa_free(nself);
@@ -454,20 +681,27 @@ static int _network_get_trailer_size(sacd_input_t *self, int16_t *size)
 /**
  * @brief Read sectors from network.
  *
- * Uses the pre-allocated input_buffer to hold the ServerResponse (which is 1MB+
- * due to the embedded data array). After decoding, copies data to user buffer.
+ * Reads are served from a ring of pipelined DISC_READ requests. Large reads
+ * are split into chunk_sectors requests of which up to @c window are kept in
+ * flight, so the server can stream the next chunk while the previous one is
+ * being received. Once two consecutive reads continue where the previous
+ * one ended, the ring is also filled beyond the requested range with full
+ * chunks: small sequential reads then coalesce into large requests, and the
+ * prefetched chunks are already on the wire when the reader gets to them.
+ * Requests that a seek made useless are drained before new ones are sent.
+ * Payloads of requests that lie inside the read are decoded straight into
+ * @p buffer; only prefetched or partially used chunks are copied.
  */
 static int _network_read_sectors(sacd_input_t *self, uint32_t sector_pos,
                                   uint32_t sector_count, void *buffer,
                                   uint32_t *sectors_read)
 {
     sacd_input_network_t *nself = (sacd_input_network_t *)self;
-    uint8_t output_buf[32];
-    ServerRequest request;
-    ServerResponse *response;
-    pb_ostream_t output;
-    pb_istream_t input;
-    size_t bytes_written;
+    uint8_t *dst = (uint8_t *)buffer;
+    uint32_t cur = sector_pos;
+    uint64_t end = (uint64_t)sector_pos + sector_count;
+    uint64_t limit;
+    int rc;
 
     if (!nself || !buffer || !sectors_read)
     {
@@ -475,88 +709,194 @@ static int _network_read_sectors(sacd_input_t *self, uint32_t sector_pos,
         return SACD_INPUT_ERR_NULL_PTR;
     }
 
+    *sectors_read = 0;
+
     if (sector_count == 0)
     {
-        *sectors_read = 0;
         return SACD_INPUT_OK;
     }
 
     if (!nself->connected || nself->sock == TCS_SOCKET_INVALID)
     {
-        *sectors_read = 0;
         nself->base.last_error = SACD_INPUT_ERR_CLOSED;
         snprintf(nself->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE,
                  "not connected");
         return SACD_INPUT_ERR_CLOSED;
     }
 
-    /* Use the pre-allocated buffer for the large ServerResponse struct */
-    response = (ServerResponse *)nself->input_buffer;
-    memset(response, 0, sizeof(ServerResponse));
-
-    /* Build and encode READ request to buffer first */
-    output = pb_ostream_from_buffer(output_buf, sizeof(output_buf));
-
-    request.type = ServerRequest_Type_DISC_READ;
-    request.sector_offset = sector_pos;
-    request.sector_count = sector_count;
+    if (sector_pos == nself->next_sector)
+    {
+        nself->sequential_reads++;
+    }
+    else
+    {
+        nself->sequential_reads = 0;
+    }
+    nself->next_sector = (uint32_t)end;
 
-    if (!pb_encode(&output, ServerRequest_fields, &request))
+    /* Demand reads stop at the end of the request, prefetch at end of disc */
+    limit = end;
+    if (nself->sequential_reads >= 2 && limit < nself->total_sectors)
     {
-        *sectors_read = 0;
-        nself->base.last_error = SACD_INPUT_ERR_NETWORK;
-        snprintf(nself->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE,
-                 "failed to encode READ request");
-        return SACD_INPUT_ERR_NETWORK;
+        limit = nself->total_sectors;
     }
 
-    /* Add terminating zero byte */
-    bytes_written = output.bytes_written;
-    if (bytes_written < sizeof(output_buf))
+    while (cur < end)
     {
-        output_buf[bytes_written] = 0;
-        bytes_written++;
+        network_request_t *req;
+        uint32_t offset;
+        uint32_t count;
+
+        /* Discard requests in front of the one holding cur */
+        while (nself->req_count > 0)
+        {
+            req = &nself->requests[nself->req_head];
+            if (cur >= req->sector_pos &&
+                cur < req->sector_pos + req->sector_count)
+            {
+                break;
+            }
+            if (!req->received)
+            {
+                rc = _network_receive_head(nself, req->data);
+                if (rc != SACD_INPUT_OK)
+                {
+                    return rc;
+                }
+            }
+            _network_pop_head(nself);
+        }
+
+        if (nself->req_count == 0)
+        {
+            nself->issue_pos = cur;
+        }
+
+        /* Keep the pipeline full */
+        while (nself->req_count < nself->window && nself->issue_pos < limit)
+        {
+            uint64_t remaining = limit - nself->issue_pos;
+            count = nself->chunk_sectors;
+            if (remaining < count)
+            {
+                count = (uint32_t)remaining;
+            }
+            rc = _network_issue_read(nself, nself->issue_pos, count);
+            if (rc != SACD_INPUT_OK)
+            {
+                return rc;
+            }
+        }
+
+        req = &nself->requests[nself->req_head];
+        if (!req->received)
+        {
+            /* A request wholly inside this read lands in the caller's buffer */
+            bool direct = req->sector_pos == cur &&
+                          (uint64_t)req->sector_pos + req->sector_count <= end;
+
+            rc = _network_receive_head(nself, direct ? dst : req->data);
+            if (rc != SACD_INPUT_OK)
+            {
+                return rc;
+            }
+
+            if (direct)
+            {
+                count = req->sectors;
+                dst += (size_t)count * SACD_LSN_SIZE;
+                cur += count;
+                *sectors_read += count;
+                _network_pop_head(nself);
+
+                if (count < req->sector_count)
+                {
+                    nself->base.last_error = SACD_INPUT_ERR_READ_FAILED;
+                    snprintf(nself->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE,
+                             "short read at sector %u", cur);
+                    return SACD_INPUT_ERR_READ_FAILED;
+                }
+                continue;
+            }
+        }
+
+        offset = cur - req->sector_pos;
+        if (offset >= req->sectors)
+        {
+            /* Server delivered fewer sectors than requested */
+            nself->base.last_error = SACD_INPUT_ERR_READ_FAILED;
+            snprintf(nself->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE,
+                     "short read at sector %u", cur);
+            return SACD_INPUT_ERR_READ_FAILED;
+        }
+
+        count = req->sectors - offset;
+        if (count > end - cur)
+        {
+            count = (uint32_t)(end - cur);
+        }
+
+        memcpy(dst, req->data + (size_t)offset * SACD_LSN_SIZE,
+               (size_t)count * SACD_LSN_SIZE);
+        dst += (size_t)count * SACD_LSN_SIZE;
+        cur += count;
+        *sectors_read += count;
+
+        if (cur >= req->sector_pos + req->sector_count)
+        {
+            _network_pop_head(nself);
+        }
     }
 
-    /* Send the encoded request */
-    if (!_send_all(nself->sock, output_buf, bytes_written))
+    return SACD_INPUT_OK;
+}
+
+/* ============================================================================
+ * Pipeline Configuration
+ * ============================================================================ */
+
+/**
+ * @brief Configure the read pipeline of a network input.
+ */
+int sacd_input_network_set_pipeline(sacd_input_t *input, uint32_t window,
+                                    uint32_t chunk_sectors)
+{
+    sacd_input_network_t *nself = (sacd_input_network_t *)input;
+    int rc;
+
+    if (!input)
     {
-        *sectors_read = 0;
-        nself->base.last_error = SACD_INPUT_ERR_NETWORK;
-        snprintf(nself->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE,
-                 "failed to send READ request");
-        return SACD_INPUT_ERR_NETWORK;
+        return SACD_INPUT_ERR_NULL_PTR;
     }
 
-    /* Read and decode response from socket */
-    input = pb_istream_from_tcs_socket(nself->sock);
+    if (input->ops != &_network_input_ops)
+    {
+        return SACD_INPUT_ERR_NOT_SUPPORTED;
+    }
 
-    if (!pb_decode(&input, ServerResponse_fields, response))
+    if (window == 0)
     {
-        *sectors_read = 0;
-        nself->base.last_error = SACD_INPUT_ERR_NETWORK;
-        snprintf(nself->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE,
-                 "failed to decode READ response");
-        return SACD_INPUT_ERR_NETWORK;
+        window = SACD_NETWORK_DEFAULT_WINDOW;
+    }
+    if (chunk_sectors == 0)
+    {
+        chunk_sectors = SACD_NETWORK_DEFAULT_CHUNK_SECTORS;
     }
 
-    if (response->type != ServerResponse_Type_DISC_READ)
+    if (window > SACD_NETWORK_MAX_WINDOW ||
+        chunk_sectors > NETWORK_MAX_CHUNK_SECTORS)
     {
-        *sectors_read = 0;
-        nself->base.last_error = SACD_INPUT_ERR_READ_FAILED;
-        snprintf(nself->base.error_msg, SACD_INPUT_ERROR_MSG_SIZE,
-                 "unexpected response type for READ");
-        return SACD_INPUT_ERR_READ_FAILED;
+        return SACD_INPUT_ERR_INVALID_ARG;
     }
 
-    if (response->has_data && response->data.size > 0)
+    if (nself->connected)
     {
-        /* Copy decoded data to user buffer */
-        memcpy(buffer, response->data.bytes, response->data.size);
-        *sectors_read = (uint32_t)response->result;
-        return (*sectors_read == sector_count) ? SACD_INPUT_OK : SACD_INPUT_ERR_READ_FAILED;
+        rc = _network_drain(nself);
+        if (rc != SACD_INPUT_OK)
+        {
+            return rc;
+        }
     }
 
-    *sectors_read = 0;
-    return SACD_INPUT_ERR_READ_FAILED;
+    return _network_alloc_requests(nself, window, chunk_sectors);
 }
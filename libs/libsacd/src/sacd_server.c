@@ -0,0 +1,1055 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief SACD network server built on nanopb + tinycsocket.
+ * A single-threaded event loop serves the ServerRequest/ServerResponse
+ * protocol of sacd_ripper.proto to any number of clients:
+ * - Listening sockets and clients share one tinycsocket poll pool
+ * - Client sockets are non-blocking; requests are decoded from a small
+ *   input buffer and queued up to the per-client window, after which the
+ *   socket stops being polled for input until the queue drains
+ * - A DISC_READ response is a protobuf header (type, result and the tag and
+ *   length of the data field) followed by the raw sectors and the zero
+ *   terminator. Plain 2048-byte images send the sectors with sendfile() on
+ *   Linux; otherwise they are read into a per-client buffer laid out so the
+ *   whole response goes out as one contiguous write
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <libsacd/sacd_server.h>
+#include <libsacd/sacd.h>
+#include "sacd_input.h"
+
+#include <libsautil/mem.h>
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include <tinycsocket.h>
+#include <pb_encode.h>
+#include <pb_decode.h>
+#include "sacd_ripper.pb.h"
+
+#if defined(__linux__)
+#define SERVER_HAVE_SENDFILE 1
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/sendfile.h>
+#endif
+
+/* Largest DISC_READ answered in one response (1024000 bytes of payload) */
+#define SERVER_MAX_SECTORS      500
+/* Room in front of a buffered payload for the response header */
+#define SERVER_HEADER_RESERVE   32
+/* Bytes of undecoded request data kept per client */
+#define SERVER_INPUT_BUFFER     256
+/* Poll interval of sacd_server_run(), bounds the latency of a stop */
+#define SERVER_RUN_POLL_MS      250
+/* Events fetched per poll */
+#define SERVER_MAX_EVENTS       64
+
+/**
+ * @brief Tag at the start of everything registered in the poll pool.
+ */
+typedef enum server_slot_kind {
+    SERVER_SLOT_EXPORT,
+    SERVER_SLOT_CLIENT
+} server_slot_kind_t;
+
+/**
+ * @brief One exported source and the socket listening for its clients.
+ *
+ * Drives (and anything else that is not a plain file) are read through a
+ * sacd_t so that authentication and decryption happen as for local use;
+ * image files are read straight from their sacd_input.
+ */
+typedef struct server_export {
+    server_slot_kind_t kind;            /**< SERVER_SLOT_EXPORT */
+    char           *source;             /**< Path, for log messages */
+    sacd_input_t   *input;              /**< Image input, or NULL */
+    sacd_t         *reader;             /**< Drive reader, or NULL */
+    uint32_t        total_sectors;      /**< Disc size in 2048-byte sectors */
+    uint32_t        sector_size;        /**< Raw sector size of @c input */
+    int16_t         header_size;        /**< Bytes before the user data */
+    int             fd;                 /**< Descriptor for sendfile(), or -1 */
+    TcsSocket       listen_sock;        /**< Listening socket */
+    uint16_t        port;               /**< Port of @c listen_sock */
+} server_export_t;
+
+/**
+ * @brief One client connection and the response it is being sent.
+ *
+ * A response is sent in up to three parts: @c out (header, or the whole
+ * response when it was buffered), @c file_left bytes of the image via
+ * sendfile(), and a trailing zero byte.
+ */
+typedef struct server_client {
+    server_slot_kind_t kind;            /**< SERVER_SLOT_CLIENT */
+    server_export_t *export;            /**< Export this client reads */
+    TcsSocket       sock;               /**< Non-blocking client socket */
+    bool            dead;               /**< Closed; freed at end of poll */
+    bool            closing;            /**< Close once the response is sent */
+    bool            poll_read;          /**< Registered for input */
+    bool            poll_write;         /**< Registered for output */
+
+    uint8_t         in_buf[SERVER_INPUT_BUFFER]; /**< Undecoded request bytes */
+    size_t          in_len;             /**< Bytes in @c in_buf */
+    ServerRequest  *queue;              /**< Decoded requests (ring) */
+    uint32_t        queue_head;         /**< Oldest queued request */
+    uint32_t        queue_count;        /**< Requests queued */
+
+    bool            active;             /**< A response is being sent */
+    uint8_t         head[SERVER_HEADER_RESERVE + 1]; /**< Small responses */
+    const uint8_t  *out;                /**< Bytes to send first */
+    size_t          out_len;            /**< Length of @c out */
+    size_t          out_sent;           /**< Bytes of @c out sent */
+    uint64_t        file_pos;           /**< Image offset for sendfile() */
+    size_t          file_left;          /**< Bytes left for sendfile() */
+    bool            tail_pending;       /**< Terminator not yet sent */
+    uint8_t        *buffer;             /**< Buffered payload, lazily allocated */
+} server_client_t;
+
+struct sacd_server {
+    sacd_server_config_t config;        /**< Settings with defaults applied */
+    struct TcsAddress bind_address;     /**< Address exports listen on */
+    struct TcsPool *pool;               /**< All sockets */
+    server_export_t **exports;          /**< Exports */
+    size_t          export_count;       /**< Number of exports */
+    server_client_t **clients;          /**< Connected clients */
+    size_t          client_count;       /**< Number of clients */
+    atomic_int      stop;               /**< Set by sacd_server_stop() */
+};
+
+static void _server_log(sacd_server_t *server, const char *fmt, ...)
+{
+    char message[512];
+    va_list args;
+
+    if (!server->config.log)
+    {
+        return;
+    }
+
+    va_start(args, fmt);
+    vsnprintf(message, sizeof(message), fmt, args);
+    va_end(args);
+
+    server->config.log(server->config.log_opaque, message);
+}
+
+/* ==========================================================================
+ * Exports
+ * ========================================================================== */
+
+static void _export_free(server_export_t *export)
+{
+    if (!export)
+    {
+        return;
+    }
+    if (export->listen_sock != TCS_SOCKET_INVALID)
+    {
+        tcs_close(&export->listen_sock);
+    }
+#ifdef SERVER_HAVE_SENDFILE
+    if (export->fd >= 0)
+    {
+        close(export->fd);
+    }
+#endif
+    if (export->input)
+    {
+        sacd_input_close(export->input);
+    }
+    if (export->reader)
+    {
+        sacd_close(export->reader);
+        sacd_destroy(export->reader);
+    }
+    sa_free(export->source);
+    sa_free(export);
+}
+
+/**
+ * @brief Open @p source, choosing between the image and the drive path.
+ */
+static int _export_open_source(sacd_server_t *server, server_export_t *export,
+                               const char *source)
+{
+    sacd_input_t *input = NULL;
+
+    if (sacd_input_open(source, &input) != SACD_INPUT_OK)
+    {
+        return SACD_IO_ERROR;
+    }
+
+    if (sacd_input_get_type(input) != SACD_INPUT_TYPE_FILE)
+    {
+        /* Let sacd_t authenticate and decrypt, as for a local rip */
+        sacd_input_close(input);
+
+        export->reader = sacd_create();
+        if (!export->reader)
+        {
+            return SACD_MEMORY_ALLOCATION_ERROR;
+        }
+        if (sacd_init(export->reader, source, 1, 1) != SACD_OK ||
+            sacd_get_total_sectors(export->reader,
+                                   &export->total_sectors) != SACD_OK)
+        {
+            return SACD_IO_ERROR;
+        }
+        export->sector_size = SACD_LSN_SIZE;
+        return SACD_OK;
+    }
+
+    export->input = input;
+    export->total_sectors = sacd_input_total_sectors(input);
+    if (sacd_input_get_sector_size(input, &export->sector_size) != SACD_INPUT_OK ||
+        sacd_input_get_header_size(input, &export->header_size) != SACD_INPUT_OK)
+    {
+        export->sector_size = SACD_LSN_SIZE;
+        export->header_size = 0;
+    }
+
+#ifdef SERVER_HAVE_SENDFILE
+    if (!server->config.disable_sendfile &&
+        export->sector_size == SACD_LSN_SIZE)
+    {
+        export->fd = open(source, O_RDONLY | O_CLOEXEC);
+    }
+#else
+    (void)server;
+#endif
+    return SACD_OK;
+}
+
+static int _export_listen(sacd_server_t *server, server_export_t *export,
+                          uint16_t port)
+{
+    struct TcsAddress address = server->bind_address;
+
+    address.data.ip4.port = port;
+
+    if (tcs_socket(&export->listen_sock, TCS_AF_IP4, TCS_SOCK_STREAM,
+                   TCS_PROTOCOL_IP_TCP) != TCS_SUCCESS)
+    {
+        return SACD_IO_ERROR;
+    }
+    tcs_opt_reuse_address_set(export->listen_sock, true);
+    if (tcs_bind(export->listen_sock, &address) != TCS_SUCCESS ||
+        tcs_listen(export->listen_sock, TCS_BACKLOG_MAX) != TCS_SUCCESS ||
+        tcs_pool_add(server->pool, export->listen_sock, export,
+                     true, false, false) != TCS_SUCCESS)
+    {
+        tcs_close(&export->listen_sock);
+        return SACD_IO_ERROR;
+    }
+    export->port = port;
+    return SACD_OK;
+}
+
+/**
+ * @brief Read up to @p count user-data sectors into @p buffer.
+ *
+ * @p buffer must hold @p count raw sectors of the export; sectors with a
+ * header or trailer are compacted to 2048 bytes in place.
+ */
+static int _export_read(server_export_t *export, uint32_t sector_pos,
+                        uint32_t count, uint8_t *buffer, uint32_t *sectors_read)
+{
+    uint32_t i;
+
+    *sectors_read = 0;
+
+    if (export->reader)
+    {
+        return sacd_read_raw_sectors(export->reader, sector_pos, count,
+                                     buffer, sectors_read);
+    }
+
+    if (sacd_input_read_sectors(export->input, sector_pos, count, buffer,
+                                sectors_read) != SACD_INPUT_OK)
+    {
+        return SACD_IO_ERROR;
+    }
+
+    if (export->sector_size != SACD_LSN_SIZE)
+    {
+        for (i = 0; i < *sectors_read; i++)
+        {
+            memmove(buffer + (size_t)i * SACD_LSN_SIZE,
+                    buffer + (size_t)i * export->sector_size + export->header_size,
+                    SACD_LSN_SIZE);
+        }
+    }
+    return SACD_OK;
+}
+
+/* ==========================================================================
+ * Clients
+ * ========================================================================== */
+
+static void _client_free(server_client_t *client)
+{
+    if (client->sock != TCS_SOCKET_INVALID)
+    {
+        tcs_close(&client->sock);
+    }
+    sa_free(client->queue);
+    sa_free(client->buffer);
+    sa_free(client);
+}
+
+/**
+ * @brief Disconnect a client. It is freed at the end of the current poll,
+ *        since later events of the same batch may still point at it.
+ */
+static void _client_drop(sacd_server_t *server, server_client_t *client)
+{
+    if (client->dead)
+    {
+        return;
+    }
+    client->dead = true;
+    tcs_pool_remove(server->pool, client->sock);
+    tcs_close(&client->sock);
+}
+
+static void _client_update_interest(sacd_server_t *server,
+                                    server_client_t *client)
+{
+    bool want_read = !client->closing &&
+                     client->queue_count < server->config.client_window &&
+                     client->in_len < sizeof(client->in_buf);
+    bool want_write = client->active;
+
+    if (want_read == client->poll_read && want_write == client->poll_write)
+    {
+        return;
+    }
+
+    /* The pool has no modify operation */
+    tcs_pool_remove(server->pool, client->sock);
+    if (tcs_pool_add(server->pool, client->sock, client,
+                     want_read, want_write, false) != TCS_SUCCESS)
+    {
+        _client_drop(server, client);
+        return;
+    }
+    client->poll_read = want_read;
+    client->poll_write = want_write;
+}
+
+/**
+ * @brief Find the end of the first request in @p data.
+ *
+ * A request ends at a zero tag, but a zero byte may also be a field value,
+ * and nanopb accepts a buffer that stops at a field boundary as a complete
+ * message; so walk the fields to tell a finished request from a partial one.
+ *
+ * @return 1 with @p frame_len set if a whole request (terminator included)
+ *         is buffered, 0 if more bytes are needed, -1 if malformed
+ */
+static int _client_frame_length(const uint8_t *data, size_t len,
+                                size_t *frame_len)
+{
+    pb_istream_t stream = pb_istream_from_buffer(data, len);
+
+    for (;;)
+    {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+
+        if (!pb_decode_tag(&stream, &wire_type, &tag, &eof))
+        {
+            return stream.bytes_left == 0 ? 0 : -1;
+        }
+        if (tag == 0)
+        {
+            *frame_len = len - stream.bytes_left;
+            return wire_type == PB_WT_VARINT ? 1 : -1;
+        }
+        if (!pb_skip_field(&stream, wire_type))
+        {
+            return stream.bytes_left == 0 ? 0 : -1;
+        }
+    }
+}
+
+/**
+ * @brief Decode buffered request bytes into the queue.
+ * @return 0 on success, -1 if the client sent something undecodable
+ */
+static int _client_parse(sacd_server_t *server, server_client_t *client)
+{
+    while (!client->closing && client->in_len > 0 &&
+           client->queue_count < server->config.client_window)
+    {
+        ServerRequest request = ServerRequest_init_zero;
+        pb_istream_t input;
+        size_t consumed = 0;
+        int framed = _client_frame_length(client->in_buf, client->in_len,
+                                          &consumed);
+
+        if (framed == 0)
+        {
+            /* A request and its terminator never exceed this */
+            return client->in_len > ServerRequest_size ? -1 : 0;
+        }
+
+        input = pb_istream_from_buffer(client->in_buf, consumed);
+        if (framed < 0 ||
+            !pb_decode_ex(&input, ServerRequest_fields, &request,
+                          PB_DECODE_NULLTERMINATED))
+        {
+            return -1;
+        }
+
+        memmove(client->in_buf, client->in_buf + consumed,
+                client->in_len - consumed);
+        client->in_len -= consumed;
+
+        client->queue[(client->queue_head + client->queue_count) %
+                      server->config.client_window] = request;
+        client->queue_count++;
+
+        if (request.type == ServerRequest_Type_DISC_CLOSE)
+        {
+            client->closing = true;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Encodes only the tag and length of ServerResponse.data; the bytes
+ *        themselves follow the header unencoded.
+ */
+static bool _client_encode_data_header(pb_ostream_t *stream,
+                                       const pb_field_t *field,
+                                       void * const *arg)
+{
+    const size_t *size = (const size_t *)*arg;
+
+    return pb_encode_tag_for_field(stream, field) &&
+           pb_encode_varint(stream, (uint64_t)*size);
+}
+
+static size_t _client_encode_header(uint8_t *dest, size_t capacity,
+                                    ServerResponse_Type type, int64_t result,
+                                    size_t *payload_size)
+{
+    ServerResponse response = ServerResponse_init_zero;
+    pb_ostream_t output = pb_ostream_from_buffer(dest, capacity);
+
+    response.type = type;
+    response.result = result;
+    if (payload_size)
+    {
+        response.data.funcs.encode = _client_encode_data_header;
+        response.data.arg = payload_size;
+    }
+
+    if (!pb_encode(&output, ServerResponse_fields, &response))
+    {
+        return 0;
+    }
+    return output.bytes_written;
+}
+
+/**
+ * @brief Start a response carrying no sector data.
+ */
+static void _client_respond(server_client_t *client, ServerResponse_Type type,
+                            int64_t result)
+{
+    size_t len = _client_encode_header(client->head, SERVER_HEADER_RESERVE,
+                                       type, result, NULL);
+
+    client->head[len] = 0;
+    client->out = client->head;
+    client->out_len = len + 1;
+}
+
+static void _client_respond_read(sacd_server_t *server,
+                                 server_client_t *client,
+                                 const ServerRequest *request)
+{
+    server_export_t *export = client->export;
+    uint32_t count = 0;
+    uint32_t sectors_read = 0;
+    size_t payload_size;
+    size_t header_len;
+    uint8_t *payload;
+
+    if (request->sector_offset < export->total_sectors)
+    {
+        count = export->total_sectors - request->sector_offset;
+        if (count > request->sector_count)
+        {
+            count = request->sector_count;
+        }
+        if (count > SERVER_MAX_SECTORS)
+        {
+            count = SERVER_MAX_SECTORS;
+        }
+    }
+    if (count == 0)
+    {
+        _client_respond(client, ServerResponse_Type_DISC_READ, 0);
+        return;
+    }
+
+    payload_size = (size_t)count * SACD_LSN_SIZE;
+
+#ifdef SERVER_HAVE_SENDFILE
+    if (export->fd >= 0)
+    {
+        header_len = _client_encode_header(client->head, SERVER_HEADER_RESERVE,
+                                           ServerResponse_Type_DISC_READ,
+                                           count, &payload_size);
+        client->out = client->head;
+        client->out_len = header_len;
+        client->file_pos = (uint64_t)request->sector_offset * SACD_LSN_SIZE;
+        client->file_left = payload_size;
+        client->tail_pending = true;
+        return;
+    }
+#endif
+
+    if (!client->buffer)
+    {
+        client->buffer = (uint8_t *)sa_malloc(SERVER_HEADER_RESERVE +
+            (size_t)SERVER_MAX_SECTORS * export->sector_size + 1);
+        if (!client->buffer)
+        {
+            _server_log(server, "%s: out of memory", export->source);
+            _client_respond(client, ServerResponse_Type_DISC_READ, -1);
+            return;
+        }
+    }
+
+    payload = client->buffer + SERVER_HEADER_RESERVE;
+    if (_export_read(export, request->sector_offset, count, payload,
+                     &sectors_read) != SACD_OK || sectors_read == 0)
+    {
+        _server_log(server, "%s: read of %u sectors at %u failed",
+                    export->source, count, request->sector_offset);
+        _client_respond(client, ServerResponse_Type_DISC_READ, -1);
+        return;
+    }
+
+    /* Header, payload and terminator end up contiguous */
+    payload_size = (size_t)sectors_read * SACD_LSN_SIZE;
+    header_len = _client_encode_header(client->head, SERVER_HEADER_RESERVE,
+                                       ServerResponse_Type_DISC_READ,
+                                       sectors_read, &payload_size);
+    memcpy(payload - header_len, client->head, header_len);
+    payload[payload_size] = 0;
+
+    client->out = payload - header_len;
+    client->out_len = header_len + payload_size + 1;
+}
+
+static void _client_start_response(sacd_server_t *server,
+                                   server_client_t *client,
+                                   const ServerRequest *request)
+{
+    client->active = true;
+    client->out_sent = 0;
+    client->file_left = 0;
+    client->tail_pending = false;
+
+    switch (request->type)
+    {
+    case ServerRequest_Type_DISC_OPEN:
+        _client_respond(client, ServerResponse_Type_DISC_OPENED, 0);
+        break;
+
+    case ServerRequest_Type_DISC_SIZE:
+        _client_respond(client, ServerResponse_Type_DISC_SIZE,
+                        client->export->total_sectors);
+        break;
+
+    case ServerRequest_Type_DISC_READ:
+        _client_respond_read(server, client, request);
+        break;
+
+    case ServerRequest_Type_DISC_CLOSE:
+    default:
+        _client_respond(client, ServerResponse_Type_DISC_CLOSED, 0);
+        break;
+    }
+}
+
+/**
+ * @brief Send as much of the current response as the socket takes.
+ * @return 1 when the response is complete, 0 if the socket is full,
+ *         -1 on error
+ */
+static int _client_flush(server_client_t *client)
+{
+    static const uint8_t zero = 0;
+
+    while (client->out_sent < client->out_len)
+    {
+        size_t sent = 0;
+        TcsResult result = tcs_send(client->sock,
+                                    client->out + client->out_sent,
+                                    client->out_len - client->out_sent,
+                                    0, &sent);
+
+        if (result == TCS_ERROR_WOULD_BLOCK)
+        {
+            return 0;
+        }
+        if (result != TCS_SUCCESS)
+        {
+            return -1;
+        }
+        client->out_sent += sent;
+    }
+
+#ifdef SERVER_HAVE_SENDFILE
+    while (client->file_left > 0)
+    {
+        off_t offset = (off_t)client->file_pos;
+        ssize_t sent = sendfile(client->sock, client->export->fd, &offset,
+                                client->file_left);
+
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return 0;
+        }
+        if (sent <= 0)
+        {
+            /* Error, or the image shrank under us */
+            return -1;
+        }
+        client->file_pos += (uint64_t)sent;
+        client->file_left -= (size_t)sent;
+    }
+#endif
+
+    if (client->tail_pending)
+    {
+        size_t sent = 0;
+        TcsResult result = tcs_send(client->sock, &zero, 1, 0, &sent);
+
+        if (result == TCS_ERROR_WOULD_BLOCK)
+        {
+            return 0;
+        }
+        if (result != TCS_SUCCESS || sent != 1)
+        {
+            return -1;
+        }
+        client->tail_pending = false;
+    }
+    return 1;
+}
+
+/**
+ * @brief Answer queued requests until the socket fills up or the queue is
+ *        empty, then adjust what the client is polled for.
+ */
+static void _client_process(sacd_server_t *server, server_client_t *client)
+{
+    for (;;)
+    {
+        ServerRequest request;
+
+        if (_client_parse(server, client) < 0)
+        {
+            _server_log(server, "%s: dropping client sending a malformed request",
+                        client->export->source);
+            _client_drop(server, client);
+            return;
+        }
+
+        if (client->active)
+        {
+            int done = _client_flush(client);
+
+            if (done < 0)
+            {
+                _client_drop(server, client);
+                return;
+            }
+            if (done == 0)
+            {
+                break;
+            }
+            client->active = false;
+        }
+
+        if (client->queue_count == 0)
+        {
+            if (client->closing)
+            {
+                _client_drop(server, client);
+                return;
+            }
+            break;
+        }
+
+        request = client->queue[client->queue_head];
+        client->queue_head = (client->queue_head + 1) %
+                             server->config.client_window;
+        client->queue_count--;
+        _client_start_response(server, client, &request);
+    }
+
+    _client_update_interest(server, client);
+}
+
+static void _client_receive(sacd_server_t *server, server_client_t *client)
+{
+    size_t received = 0;
+    TcsResult result;
+
+    if (client->in_len >= sizeof(client->in_buf))
+    {
+        return;
+    }
+
+    result = tcs_receive(client->sock, client->in_buf + client->in_len,
+                         sizeof(client->in_buf) - client->in_len, 0, &received);
+    if (result == TCS_ERROR_WOULD_BLOCK)
+    {
+        return;
+    }
+    if (result != TCS_SUCCESS)
+    {
+        /* Disconnected without DISC_CLOSE */
+        _client_drop(server, client);
+        return;
+    }
+    client->in_len += received;
+}
+
+static void _server_accept(sacd_server_t *server, server_export_t *export)
+{
+    TcsSocket sock = TCS_SOCKET_INVALID;
+    server_client_t *client;
+
+    if (tcs_accept(export->listen_sock, &sock, NULL) != TCS_SUCCESS)
+    {
+        return;
+    }
+
+    if (server->client_count >= server->config.max_clients)
+    {
+        _server_log(server, "%s: refusing client, %u connected",
+                    export->source, server->config.max_clients);
+        tcs_close(&sock);
+        return;
+    }
+
+    client = (server_client_t *)sa_calloc(1, sizeof(*client));
+    if (client)
+    {
+        client->queue = (ServerRequest *)sa_calloc(server->config.client_window,
+                                                   sizeof(ServerRequest));
+    }
+    if (!client || !client->queue ||
+        tcs_opt_nonblocking_set(sock, true) != TCS_SUCCESS ||
+        tcs_pool_add(server->pool, sock, client, true, false, false) != TCS_SUCCESS)
+    {
+        if (client)
+        {
+            sa_free(client->queue);
+            sa_free(client);
+        }
+        tcs_close(&sock);
+        return;
+    }
+
+    client->kind = SERVER_SLOT_CLIENT;
+    client->export = export;
+    client->sock = sock;
+    client->poll_read = true;
+    server->clients[server->client_count++] = client;
+
+    _server_log(server, "%s: client connected (%zu active)",
+                export->source, server->client_count);
+}
+
+/* Free clients dropped during this poll */
+static void _server_reap(sacd_server_t *server)
+{
+    size_t i = 0;
+
+    while (i < server->client_count)
+    {
+        if (server->clients[i]->dead)
+        {
+            _server_log(server, "%s: client disconnected",
+                        server->clients[i]->export->source);
+            _client_free(server->clients[i]);
+            server->clients[i] = server->clients[--server->client_count];
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+/* ==========================================================================
+ * Public API
+ * ========================================================================== */
+
+int sacd_server_create(const sacd_server_config_t *config, sacd_server_t **out)
+{
+    sacd_server_t *server;
+
+    if (!out)
+    {
+        return SACD_INVALID_ARGUMENT;
+    }
+    *out = NULL;
+
+    server = (sacd_server_t *)sa_calloc(1, sizeof(*server));
+    if (!server)
+    {
+        return SACD_MEMORY_ALLOCATION_ERROR;
+    }
+    if (config)
+    {
+        server->config = *config;
+    }
+    if (server->config.client_window == 0)
+    {
+        server->config.client_window = SACD_SERVER_DEFAULT_CLIENT_WINDOW;
+    }
+    if (server->config.max_clients == 0)
+    {
+        server->config.max_clients = SACD_SERVER_DEFAULT_MAX_CLIENTS;
+    }
+    atomic_init(&server->stop, 0);
+
+    server->bind_address.family = TCS_AF_IP4;
+    if (server->config.bind_address && server->config.bind_address[0])
+    {
+        /* tcs_address_parse() looks at a fixed number of characters */
+        char padded[64] = {0};
+        size_t len = strlen(server->config.bind_address);
+
+        if (len >= sizeof(padded) ||
+            (memcpy(padded, server->config.bind_address, len),
+             tcs_address_parse(padded, &server->bind_address) != TCS_SUCCESS) ||
+            server->bind_address.family != TCS_AF_IP4)
+        {
+            sa_free(server);
+            return SACD_INVALID_ARGUMENT;
+        }
+    }
+    server->config.bind_address = NULL;
+
+    server->clients = (server_client_t **)sa_calloc(server->config.max_clients,
+                                                    sizeof(server_client_t *));
+    if (!server->clients)
+    {
+        sa_free(server);
+        return SACD_MEMORY_ALLOCATION_ERROR;
+    }
+
+    if (tcs_lib_init() != TCS_SUCCESS)
+    {
+        sa_free(server->clients);
+        sa_free(server);
+        return SACD_IO_ERROR;
+    }
+    if (tcs_pool_create(&server->pool) != TCS_SUCCESS)
+    {
+        tcs_lib_free();
+        sa_free(server->clients);
+        sa_free(server);
+        return SACD_IO_ERROR;
+    }
+
+    *out = server;
+    return SACD_OK;
+}
+
+int sacd_server_add_export(sacd_server_t *server, const char *source,
+                           uint16_t port)
+{
+    server_export_t *export;
+    server_export_t **exports;
+    size_t source_len;
+    int ret;
+
+    if (!server || !source || port == 0)
+    {
+        return SACD_INVALID_ARGUMENT;
+    }
+
+    exports = (server_export_t **)sa_realloc(server->exports,
+        (server->export_count + 1) * sizeof(server_export_t *));
+    if (!exports)
+    {
+        return SACD_MEMORY_ALLOCATION_ERROR;
+    }
+    server->exports = exports;
+
+    export = (server_export_t *)sa_calloc(1, sizeof(*export));
+    if (!export)
+    {
+        return SACD_MEMORY_ALLOCATION_ERROR;
+    }
+    export->kind = SERVER_SLOT_EXPORT;
+    export->fd = -1;
+    export->listen_sock = TCS_SOCKET_INVALID;
+
+    source_len = strlen(source);
+    export->source = (char *)sa_malloc(source_len + 1);
+    if (!export->source)
+    {
+        _export_free(export);
+        return SACD_MEMORY_ALLOCATION_ERROR;
+    }
+    memcpy(export->source, source, source_len + 1);
+
+    ret = _export_open_source(server, export, source);
+    if (ret == SACD_OK)
+    {
+        ret = _export_listen(server, export, port);
+    }
+    if (ret != SACD_OK)
+    {
+        _export_free(export);
+        return ret;
+    }
+
+    server->exports[server->export_count++] = export;
+
+    _server_log(server, "%s: %u sectors on port %u (%s)", source,
+                export->total_sectors, (unsigned)port,
+                export->reader ? "drive" :
+                export->fd >= 0 ? "sendfile" : "buffered");
+    return SACD_OK;
+}
+
+int sacd_server_poll(sacd_server_t *server, int timeout_ms)
+{
+    struct TcsPollEvent events[SERVER_MAX_EVENTS];
+    size_t populated = 0;
+    TcsResult result;
+    size_t i;
+
+    if (!server)
+    {
+        return SACD_INVALID_ARGUMENT;
+    }
+
+    result = tcs_pool_poll(server->pool, events, SERVER_MAX_EVENTS,
+                           &populated, timeout_ms < 0 ? -1 : timeout_ms);
+    if (result != TCS_SUCCESS && result != TCS_ERROR_TIMED_OUT)
+    {
+        return SACD_IO_ERROR;
+    }
+
+    for (i = 0; i < populated; i++)
+    {
+        server_slot_kind_t kind = *(const server_slot_kind_t *)events[i].user_data;
+
+        if (kind == SERVER_SLOT_EXPORT)
+        {
+            _server_accept(server, (server_export_t *)events[i].user_data);
+        }
+        else
+        {
+            server_client_t *client = (server_client_t *)events[i].user_data;
+
+            if (client->dead)
+            {
+                continue;
+            }
+            if (events[i].can_read || events[i].error != TCS_SUCCESS)
+            {
+                _client_receive(server, client);
+            }
+            if (!client->dead)
+            {
+                _client_process(server, client);
+            }
+        }
+    }
+
+    _server_reap(server);
+    return SACD_OK;
+}
+
+int sacd_server_run(sacd_server_t *server)
+{
+    if (!server)
+    {
+        return SACD_INVALID_ARGUMENT;
+    }
+
+    while (!atomic_load(&server->stop))
+    {
+        int ret = sacd_server_poll(server, SERVER_RUN_POLL_MS);
+
+        if (ret != SACD_OK)
+        {
+            return ret;
+        }
+    }
+    atomic_store(&server->stop, 0);
+    return SACD_OK;
+}
+
+void sacd_server_stop(sacd_server_t *server)
+{
+    if (server)
+    {
+        atomic_store(&server->stop, 1);
+    }
+}
+
+void sacd_server_destroy(sacd_server_t *server)
+{
+    size_t i;
+
+    if (!server)
+    {
+        return;
+    }
+
+    for (i = 0; i < server->client_count; i++)
+    {
+        _client_free(server->clients[i]);
+    }
+    for (i = 0; i < server->export_count; i++)
+    {
+        _export_free(server->exports[i]);
+    }
+    tcs_pool_destroy(&server->pool);
+    tcs_lib_free();
+
+    sa_free(server->clients);
+    sa_free(server->exports);
+    sa_free(server);
+}
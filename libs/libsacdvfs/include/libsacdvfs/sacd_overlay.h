@@ -28,6 +28,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <libsacdvfs/sacdvfs_export.h>
+#include <libsacdvfs/sacd_vfs.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +49,8 @@ extern "C" {
 /** Default configuration values */
 #define SACD_OVERLAY_DEFAULT_CACHE_TIMEOUT  300     /**< 5 minutes */
 #define SACD_OVERLAY_DEFAULT_MAX_ISOS       0       /**< Unlimited */
+#define SACD_OVERLAY_DEFAULT_BLOCK_CACHE    (64u * 1024 * 1024) /**< 64 MiB */
+#define SACD_OVERLAY_DEFAULT_DISK_CACHE     (4ull * 1024 * 1024 * 1024) /**< 4 GiB */
 
 /* =============================================================================
  * Error Codes
@@ -112,6 +115,12 @@ typedef struct {
     int cache_timeout_seconds;      /**< ISO cache timeout (0 = no timeout) */
     bool stereo_visible;            /**< Show stereo area (default: true) */
     bool multichannel_visible;      /**< Show multichannel area (default: true) */
+    bool dst_passthrough;           /**< Also list DST tracks as DSDIFF/DST .dff (default: false) */
+    uint32_t pcm_sample_rate;       /**< Also list tracks as WAV at this rate (0 = off) */
+    uint16_t pcm_bits;              /**< WAV sample size, 16 or 24 (0 = 24) */
+    size_t block_cache_size;        /**< Decoded block cache in bytes (0 = off) */
+    const char *disk_cache_dir;     /**< Transcode cache directory (NULL = off) */
+    uint64_t disk_cache_size;       /**< Transcode cache budget in bytes */
 } sacd_overlay_config_t;
 
 /** Opaque overlay context handle */
@@ -330,6 +339,28 @@ int SACDVFS_API sacd_overlay_flush_all(sacd_overlay_ctx_t *ctx);
  */
 int SACDVFS_API sacd_overlay_cleanup_idle(sacd_overlay_ctx_t *ctx);
 
+/**
+ * Get statistics of the decoded block cache shared by all mounted ISOs.
+ *
+ * @param ctx   Overlay context
+ * @param stats Output statistics
+ * @return SACD_OVERLAY_OK on success, SACD_OVERLAY_ERROR_NOT_FOUND if the
+ *         cache is disabled
+ */
+int SACDVFS_API sacd_overlay_get_block_cache_stats(sacd_overlay_ctx_t *ctx,
+                                                   sacd_vfs_block_cache_stats_t *stats);
+
+/**
+ * Get statistics of the on-disk transcode cache.
+ *
+ * @param ctx   Overlay context
+ * @param stats Output statistics
+ * @return SACD_OVERLAY_OK on success, SACD_OVERLAY_ERROR_NOT_FOUND if no
+ *         cache directory is configured
+ */
+int SACDVFS_API sacd_overlay_get_disk_cache_stats(sacd_overlay_ctx_t *ctx,
+                                                  sacd_vfs_disk_cache_stats_t *stats);
+
 /* =============================================================================
  * Utility Functions
  * ===========================================================================*/
@@ -135,6 +135,34 @@ typedef struct sacd_vfs_file sacd_vfs_file_t;
 /** Forward declaration for thread pool (from libsautil/sa_tpool.h) */
 typedef struct sa_tpool sa_tpool;
 
+/** Opaque decoded block cache, shared by several VFS contexts */
+typedef struct sacd_vfs_block_cache sacd_vfs_block_cache_t;
+
+/** Decoded block cache statistics */
+typedef struct {
+    uint64_t hits;              /* Block groups served from the cache */
+    uint64_t misses;            /* Lookups that had to decode */
+    uint64_t insertions;        /* Block groups stored */
+    uint64_t evictions;         /* Block groups dropped to stay in budget */
+    uint64_t bytes;             /* Memory held */
+    uint64_t max_bytes;         /* Memory budget */
+    uint32_t entries;           /* Block groups held */
+} sacd_vfs_block_cache_stats_t;
+
+/** Opaque on-disk transcode cache, shared by several VFS contexts */
+typedef struct sacd_vfs_disk_cache sacd_vfs_disk_cache_t;
+
+/** On-disk transcode cache statistics */
+typedef struct {
+    uint64_t hits;              /* Block groups read from disk */
+    uint64_t misses;            /* Lookups that had to decode */
+    uint64_t writes;            /* Block groups written */
+    uint64_t evictions;         /* Track files deleted to stay in budget */
+    uint64_t bytes;             /* Block data on disk */
+    uint64_t max_bytes;         /* Disk budget */
+    uint32_t files;             /* Track files on disk */
+} sacd_vfs_disk_cache_stats_t;
+
 /** Directory listing callback */
 typedef int (*sacd_vfs_readdir_callback_t)(const sacd_vfs_entry_t *entry, void *userdata);
 
@@ -173,6 +201,111 @@ int SACDVFS_API sacd_vfs_close(sacd_vfs_ctx_t *ctx);
  */
 void SACDVFS_API sacd_vfs_destroy(sacd_vfs_ctx_t *ctx);
 
+/* =============================================================================
+ * Decoded Block Cache
+ * ===========================================================================*/
+
+/**
+ * Create a decoded block cache.
+ *
+ * The cache holds DSF block groups (4096 bytes per channel) of DST tracks
+ * after decoding and transformation, in least-recently-used order. All
+ * file handles of the contexts attached to it share the cached blocks, so
+ * a track read by several clients is decoded once.
+ *
+ * @param max_bytes  Memory budget (must be non-zero)
+ * @return New cache or NULL on failure
+ */
+SACDVFS_API sacd_vfs_block_cache_t *sacd_vfs_block_cache_create(size_t max_bytes);
+
+/**
+ * Destroy a decoded block cache.
+ *
+ * Every context attached to the cache must be destroyed first.
+ *
+ * @param cache  Cache (may be NULL)
+ */
+void SACDVFS_API sacd_vfs_block_cache_destroy(sacd_vfs_block_cache_t *cache);
+
+/**
+ * Get decoded block cache statistics.
+ *
+ * @param cache  Cache
+ * @param stats  Output statistics
+ * @return SACD_VFS_OK on success
+ */
+int SACDVFS_API sacd_vfs_block_cache_get_stats(sacd_vfs_block_cache_t *cache,
+                                               sacd_vfs_block_cache_stats_t *stats);
+
+/**
+ * Attach a VFS context to a decoded block cache.
+ *
+ * Files opened afterwards read and fill the cache. The context's blocks
+ * are dropped from the cache when it is closed. Call this while no files
+ * of the context are open.
+ *
+ * @param ctx    VFS context
+ * @param cache  Cache (borrowed, must outlive ctx), or NULL to detach
+ * @return SACD_VFS_OK on success
+ */
+int SACDVFS_API sacd_vfs_set_block_cache(sacd_vfs_ctx_t *ctx, sacd_vfs_block_cache_t *cache);
+
+/* =============================================================================
+ * On-Disk Transcode Cache
+ * ===========================================================================*/
+
+/**
+ * Open or create an on-disk transcode cache.
+ *
+ * Decoded DSF block groups of DST tracks are written to one sparse file
+ * per track below @p dir, next to a map of the blocks present, so a track
+ * is decoded once no matter how often the ISO is closed and reopened.
+ * Blocks of an ISO are only used while its path, size and modification
+ * time match those they were decoded from. Whole tracks are deleted in
+ * least-recently-used order to stay within @p max_bytes.
+ *
+ * Files already in @p dir are picked up, so the cache survives restarts.
+ *
+ * @param dir        Cache directory (created if missing)
+ * @param max_bytes  Disk budget (must be non-zero)
+ * @return New cache or NULL on failure
+ */
+SACDVFS_API sacd_vfs_disk_cache_t *sacd_vfs_disk_cache_create(const char *dir,
+                                                             uint64_t max_bytes);
+
+/**
+ * Close an on-disk transcode cache. The files stay on disk.
+ *
+ * Every context attached to the cache must be destroyed first.
+ *
+ * @param cache  Cache (may be NULL)
+ */
+void SACDVFS_API sacd_vfs_disk_cache_destroy(sacd_vfs_disk_cache_t *cache);
+
+/**
+ * Get on-disk transcode cache statistics.
+ *
+ * @param cache  Cache
+ * @param stats  Output statistics
+ * @return SACD_VFS_OK on success
+ */
+int SACDVFS_API sacd_vfs_disk_cache_get_stats(sacd_vfs_disk_cache_t *cache,
+                                              sacd_vfs_disk_cache_stats_t *stats);
+
+/**
+ * Attach a VFS context to an on-disk transcode cache.
+ *
+ * Files opened afterwards read decoded blocks from the cache and write the
+ * ones they decode. Blocks read from disk are also offered to the decoded
+ * block cache, if one is set. Call this while no files of the context are
+ * open.
+ *
+ * @param ctx    VFS context
+ * @param cache  Cache (borrowed, must outlive ctx), or NULL to detach
+ * @return SACD_VFS_OK on success
+ */
+int SACDVFS_API sacd_vfs_set_disk_cache(sacd_vfs_ctx_t *ctx, sacd_vfs_disk_cache_t *cache);
+
 /* =============================================================================
  * Directory Operations
  * ===========================================================================*/
@@ -232,6 +365,63 @@ bool SACDVFS_API sacd_vfs_get_area_visibility(sacd_vfs_ctx_t *ctx, sacd_vfs_area
  */
 bool SACDVFS_API sacd_vfs_should_show_area(sacd_vfs_ctx_t *ctx, sacd_vfs_area_t area);
 
+/**
+ * Enable DSDIFF/DST passthrough files.
+ *
+ * When enabled, every track of a DST coded area is also listed as
+ * "NN. Track Title.dff": a DSDIFF file carrying the disc's DST frames
+ * unchanged, with a DSTI index, for players that decode DST themselves.
+ * Reading it costs no decoding. Its size depends on the size of every
+ * frame, so the first stat or open of a track reads the track's frames
+ * once; the sizes are kept until the context is closed.
+ *
+ * @param ctx      VFS context
+ * @param enabled  true to list .dff files (default: false)
+ * @return SACD_VFS_OK on success
+ */
+int SACDVFS_API sacd_vfs_set_dst_passthrough(sacd_vfs_ctx_t *ctx, bool enabled);
+
+/**
+ * Get the DSDIFF/DST passthrough setting.
+ *
+ * @param ctx  VFS context
+ * @return true if .dff files are listed for DST areas
+ */
+bool SACDVFS_API sacd_vfs_get_dst_passthrough(sacd_vfs_ctx_t *ctx);
+
+/**
+ * Enable PCM renditions.
+ *
+ * When enabled, every track is also listed as "NN. Track Title.wav", for
+ * players that cannot play DSD. The PCM is converted from the disc with
+ * libdsdpcm while the file is read, so nothing is stored and only tracks
+ * that are played cost CPU. Its size is exact before any conversion: each
+ * SACD frame converts to 1/75 s of PCM. Reads may start anywhere; the
+ * converter restarts a few frames before the frame that holds the offset.
+ * Converted frames go to the block cache (sacd_vfs_set_block_cache()),
+ * keyed apart from the DSF blocks. Tracks too long for a 4 GiB RIFF file
+ * are not listed.
+ *
+ * @param ctx              VFS context
+ * @param sample_rate      PCM sample rate: 2822400 divided by 8 to 1024,
+ *                         e.g. 88200, or 0 to list no .wav files (default)
+ * @param bits_per_sample  16 or 24
+ * @return SACD_VFS_OK on success, SACD_VFS_ERROR_INVALID_PARAMETER for an
+ *         unsupported format
+ */
+int SACDVFS_API sacd_vfs_set_pcm_rendition(sacd_vfs_ctx_t *ctx, uint32_t sample_rate,
+                                           uint16_t bits_per_sample);
+
+/**
+ * Get the PCM rendition setting.
+ *
+ * @param ctx              VFS context
+ * @param bits_per_sample  Output for the sample size (may be NULL)
+ * @return PCM sample rate of the .wav files, 0 if none are listed
+ */
+uint32_t SACDVFS_API sacd_vfs_get_pcm_rendition(sacd_vfs_ctx_t *ctx,
+                                                uint16_t *bits_per_sample);
+
 /**
  * Get the number of tracks in an area.
  *
@@ -275,10 +465,12 @@ int SACDVFS_API sacd_vfs_stat(sacd_vfs_ctx_t *ctx, const char *path, sacd_vfs_en
  * ===========================================================================*/
 
 /**
- * Open a virtual DSF file for reading.
+ * Open a virtual DSF file, a DSDIFF/DST file (".dff", see
+ * sacd_vfs_set_dst_passthrough()) or a WAV file (".wav", see
+ * sacd_vfs_set_pcm_rendition()) for reading.
  *
  * @param ctx    VFS context
- * @param path   Virtual path to the DSF file
+ * @param path   Virtual path to the DSF, DSDIFF or WAV file
  * @param file   Output file handle
  * @return SACD_VFS_OK on success
  */
@@ -292,6 +484,10 @@ int SACDVFS_API sacd_vfs_file_open(sacd_vfs_ctx_t *ctx, const char *path, sacd_v
  * consumed in dispatch order by the main read path. DSD (uncompressed)
  * tracks bypass the MT pipeline entirely.
  *
+ * The pipeline starts with the first read that needs decoded audio, so
+ * opens that only read the header or ID3 tag cost no decoding. Read-ahead
+ * starts at a couple of frames and grows while reads stay sequential.
+ *
  * @param ctx    VFS context
  * @param path   Virtual path to the DSF file
  * @param pool   Thread pool (borrowed, not owned). May be NULL for ST fallback.
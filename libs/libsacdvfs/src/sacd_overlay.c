@@ -108,6 +108,8 @@ void sacd_overlay_config_init(sacd_overlay_config_t *config)
     config->cache_timeout_seconds = SACD_OVERLAY_DEFAULT_CACHE_TIMEOUT;
     config->stereo_visible = true;
     config->multichannel_visible = true;
+    config->block_cache_size = SACD_OVERLAY_DEFAULT_BLOCK_CACHE;
+    config->disk_cache_size = SACD_OVERLAY_DEFAULT_DISK_CACHE;
 }
 
 /* =============================================================================
@@ -147,9 +149,15 @@ sacd_overlay_ctx_t *sacd_overlay_create(const sacd_overlay_config_t *config)
     ctx->thread_pool_size = config->thread_pool_size;
     ctx->stereo_visible = config->stereo_visible;
     ctx->multichannel_visible = config->multichannel_visible;
+    ctx->dst_passthrough = config->dst_passthrough;
+    ctx->pcm_sample_rate = config->pcm_sample_rate;
+    ctx->pcm_bits = config->pcm_bits ? config->pcm_bits : 24;
     ctx->iso_count = 0;
     ctx->iso_capacity = 0;
     ctx->iso_mounts = NULL;
+    atomic_init(&ctx->path_index, 0);
+    atomic_init(&ctx->vpath_index, 0);
+    ctx->retired_mounts = NULL;
 
     if (mtx_init(&ctx->iso_table_lock, mtx_plain) != thrd_success) {
         sa_free(ctx);
@@ -170,6 +178,32 @@ sacd_overlay_ctx_t *sacd_overlay_create(const sacd_overlay_config_t *config)
         /* NULL is not fatal - falls back to single-threaded DST decoding */
     }
 
+    /* Decoded DST blocks shared by every file of every ISO, so several
+     * clients playing the same track decode it once.
+     * NULL is not fatal - each file then decodes on its own. */
+    ctx->block_cache = NULL;
+    if (config->block_cache_size > 0) {
+        ctx->block_cache = sacd_vfs_block_cache_create(config->block_cache_size);
+    }
+
+    /* Decoded tracks kept on disk across ISO unmounts and restarts.
+     * NULL is not fatal - tracks are then decoded on every mount. */
+    ctx->disk_cache = NULL;
+    if (config->disk_cache_dir && config->disk_cache_dir[0] != '\0' &&
+        config->disk_cache_size > 0) {
+        ctx->disk_cache = sacd_vfs_disk_cache_create(config->disk_cache_dir,
+                                                     config->disk_cache_size);
+        if (!ctx->disk_cache) {
+            sa_log(NULL, SA_LOG_WARNING, "Cannot use cache directory %s\n",
+                   config->disk_cache_dir);
+        }
+    }
+
+    /* Remembered SACD detection results, kept next to the transcode cache.
+     * NULL is not fatal - every listing then probes the ISOs again. */
+    ctx->detect = NULL;
+    _overlay_detect_init(ctx, ctx->disk_cache ? config->disk_cache_dir : NULL);
+
     return ctx;
 }
 
@@ -194,6 +228,7 @@ void sacd_overlay_destroy(sacd_overlay_ctx_t *ctx)
             }
             mtx_unlock(&mount->mount_lock);
             mtx_destroy(&mount->mount_lock);
+            _overlay_summary_free(mount->summary);
             sa_free(mount);
             ctx->iso_mounts[i] = NULL;
         }
@@ -203,6 +238,7 @@ void sacd_overlay_destroy(sacd_overlay_ctx_t *ctx)
     ctx->iso_mounts = NULL;
     ctx->iso_count = 0;
     ctx->iso_capacity = 0;
+    _overlay_free_iso_index(ctx);
 
     mtx_unlock(&ctx->iso_table_lock);
     mtx_destroy(&ctx->iso_table_lock);
@@ -214,6 +250,12 @@ void sacd_overlay_destroy(sacd_overlay_ctx_t *ctx)
         ctx->thread_pool = NULL;
     }
 
+    sacd_vfs_block_cache_destroy(ctx->block_cache);
+    ctx->block_cache = NULL;
+    sacd_vfs_disk_cache_destroy(ctx->disk_cache);
+    ctx->disk_cache = NULL;
+    _overlay_detect_free(ctx);
+
     sa_free(ctx);
 }
 
@@ -301,14 +343,21 @@ int sacd_overlay_stat(sacd_overlay_ctx_t *ctx, const char *path,
             return SACD_OVERLAY_OK;
         }
 
-        /* Delegate to libsacdvfs for inner paths */
-        sacd_vfs_ctx_t *vfs = _overlay_ensure_iso_mounted(ctx, mount);
-        if (!vfs) {
-            return SACD_OVERLAY_ERROR_IO;
-        }
-
+        /* Inner paths come from the ISO summary; without one, mount the
+         * ISO once to build it */
         sacd_vfs_entry_t vfs_entry;
-        result = sacd_vfs_stat(vfs, inner_path, &vfs_entry);
+        result = _overlay_summary_stat(ctx, mount, inner_path, &vfs_entry);
+        if (result == SACD_VFS_ERROR_NOT_OPEN) {
+            sacd_vfs_ctx_t *vfs = _overlay_ensure_iso_mounted(ctx, mount);
+            if (!vfs) {
+                return SACD_OVERLAY_ERROR_IO;
+            }
+            _overlay_summary_update(ctx, mount, vfs);
+            result = _overlay_summary_stat(ctx, mount, inner_path, &vfs_entry);
+            if (result == SACD_VFS_ERROR_NOT_OPEN) {
+                result = sacd_vfs_stat(vfs, inner_path, &vfs_entry);
+            }
+        }
         if (result != SACD_VFS_OK) {
             return SACD_OVERLAY_ERROR_NOT_FOUND;
         }
@@ -358,7 +407,7 @@ int sacd_overlay_stat(sacd_overlay_ctx_t *ctx, const char *path,
 
             struct stat st;
             if (stat(iso_path, &st) == 0 && S_ISREG(st.st_mode)) {
-                if (_overlay_check_sacd_magic(iso_path)) {
+                if (_overlay_detect_sacd(ctx, iso_path, &st)) {
                     sa_strlcpy(entry->name, filename, sizeof(entry->name));
                     entry->type = SACD_OVERLAY_ENTRY_ISO_FOLDER;
                     entry->source = SACD_OVERLAY_SOURCE_VIRTUAL;
@@ -476,13 +525,8 @@ static int _readdir_source_callback(const char *name, int is_dir, void *userdata
 
     /* Check if this is an ISO file - hide it and add as virtual folder */
     if (!is_dir && _overlay_is_iso_file(full_path, rctx->ctx->iso_extensions)) {
-        /* Skip expensive magic check if this ISO is already registered */
-        int is_sacd = (_overlay_find_iso_mount(rctx->ctx, full_path) != NULL);
-        if (!is_sacd) {
-            is_sacd = _overlay_check_sacd_magic(full_path);
-            sa_log(NULL, SA_LOG_DEBUG, "overlay: %s: %s\n",
-                   full_path, is_sacd ? "valid SACD" : "not SACD");
-        }
+        /* Only opens the ISO if it is new or changed since the last check */
+        int is_sacd = _overlay_detect_sacd(rctx->ctx, full_path, NULL);
 
         if (is_sacd) {
             /* Get base name (without .iso) */
@@ -611,14 +655,23 @@ int sacd_overlay_readdir(sacd_overlay_ctx_t *ctx, const char *path,
         const char *inner_path = strchr(rel_path, '/');
         if (!inner_path) inner_path = "/";
 
-        /* Delegate to libsacdvfs */
-        sacd_vfs_ctx_t *vfs = _overlay_ensure_iso_mounted(ctx, mount);
-        if (!vfs) {
-            return SACD_OVERLAY_ERROR_IO;
-        }
-
+        /* List from the ISO summary; without one, mount the ISO once to
+         * build it */
         vfs_readdir_cb_ctx_t vctx = { callback, userdata, 0 };
-        int result = sacd_vfs_readdir(vfs, inner_path, _vfs_readdir_cb, &vctx);
+        int result = _overlay_summary_readdir(ctx, mount, inner_path,
+                                              _vfs_readdir_cb, &vctx);
+        if (result == SACD_VFS_ERROR_NOT_OPEN) {
+            sacd_vfs_ctx_t *vfs = _overlay_ensure_iso_mounted(ctx, mount);
+            if (!vfs) {
+                return SACD_OVERLAY_ERROR_IO;
+            }
+            _overlay_summary_update(ctx, mount, vfs);
+            result = _overlay_summary_readdir(ctx, mount, inner_path,
+                                              _vfs_readdir_cb, &vctx);
+            if (result == SACD_VFS_ERROR_NOT_OPEN) {
+                result = sacd_vfs_readdir(vfs, inner_path, _vfs_readdir_cb, &vctx);
+            }
+        }
         if (result < 0) {
             return SACD_OVERLAY_ERROR_IO;
         }
@@ -977,6 +1030,8 @@ int sacd_overlay_flush(sacd_overlay_file_t *file)
             if (result == SACD_VFS_OK) {
                 /* Save to XML sidecar */
                 sacd_vfs_save_id3_overlay(vfs);
+                /* The track size changed with its tag */
+                _overlay_summary_invalidate(file->ctx, file->virt.mount);
             }
         }
 
@@ -1058,6 +1113,26 @@ int sacd_overlay_flush_all(sacd_overlay_ctx_t *ctx)
     return SACD_OVERLAY_OK;
 }
 
+int sacd_overlay_get_block_cache_stats(sacd_overlay_ctx_t *ctx,
+                                       sacd_vfs_block_cache_stats_t *stats)
+{
+    if (!ctx || !stats) return SACD_OVERLAY_ERROR_INVALID_PARAMETER;
+    if (!ctx->block_cache) return SACD_OVERLAY_ERROR_NOT_FOUND;
+
+    sacd_vfs_block_cache_get_stats(ctx->block_cache, stats);
+    return SACD_OVERLAY_OK;
+}
+
+int sacd_overlay_get_disk_cache_stats(sacd_overlay_ctx_t *ctx,
+                                      sacd_vfs_disk_cache_stats_t *stats)
+{
+    if (!ctx || !stats) return SACD_OVERLAY_ERROR_INVALID_PARAMETER;
+    if (!ctx->disk_cache) return SACD_OVERLAY_ERROR_NOT_FOUND;
+
+    sacd_vfs_disk_cache_get_stats(ctx->disk_cache, stats);
+    return SACD_OVERLAY_OK;
+}
+
 int sacd_overlay_cleanup_idle(sacd_overlay_ctx_t *ctx)
 {
     if (!ctx || ctx->cache_timeout_seconds <= 0) return 0;
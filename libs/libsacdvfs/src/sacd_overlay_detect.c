@@ -0,0 +1,485 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief SACD Overlay VFS - Detection Cache
+ * Remembers which ISO files are SACD images, so listing a directory does
+ * not open every ISO in it again. Results are keyed by path and validated
+ * against device, inode, size and modification time; negative results
+ * are kept too. SACD entries can also carry the encoded listing summary
+ * of the ISO (sacd_overlay_summary.c). With a cache directory configured
+ * the results are saved to detect.cache there and reused on the next mount.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "sacd_overlay_internal.h"
+
+#include <libsautil/mem.h>
+#include <libsautil/log.h>
+#include <libsautil/compat.h>
+#include <libsautil/intreadwrite.h>
+#include <libsautil/sastring.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define DETECT_FILE_NAME        "detect.cache"
+#define DETECT_FILE_MAGIC       "SODC"
+#define DETECT_FILE_VERSION     2
+#define DETECT_FILE_HEADER      12
+#define DETECT_RECORD_HEADER    39      /* Key, result, path and summary length */
+#define DETECT_MAX_SUMMARY      (1 << 20)
+#define DETECT_MIN_BUCKETS      256
+#define DETECT_MAX_ENTRIES      (1 << 20)
+
+/** Detection result of one ISO file */
+typedef struct detect_entry {
+    struct detect_entry *next;          /* Bucket chain */
+    uint32_t hash;                      /* Hash of path */
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    int64_t mtime;
+    uint8_t is_sacd;
+    uint8_t *summary;                   /* Encoded listing summary or NULL */
+    uint32_t summary_len;
+    char path[];
+} detect_entry_t;
+
+struct overlay_detect {
+    mtx_t lock;
+    detect_entry_t **buckets;
+    uint32_t mask;                      /* Bucket count - 1 */
+    uint32_t count;
+    bool dirty;                         /* Changed since loaded */
+    char *file_path;                    /* Persistent copy (NULL = none) */
+
+    uint64_t hits;
+    uint64_t probes;
+};
+
+/* =============================================================================
+ * Hash Table
+ * ===========================================================================*/
+
+/** FNV-1a hash of a path */
+static uint32_t _hash_path(const char *path)
+{
+    uint32_t h = 2166136261u;
+    for (; *path; path++) {
+        h ^= (unsigned char)*path;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static detect_entry_t *_find_entry(overlay_detect_t *detect, const char *path,
+                                   uint32_t hash)
+{
+    detect_entry_t *e;
+    for (e = detect->buckets[hash & detect->mask]; e; e = e->next) {
+        if (e->hash == hash && strcmp(e->path, path) == 0) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+static void _clear_entries(overlay_detect_t *detect)
+{
+    for (uint32_t i = 0; i <= detect->mask; i++) {
+        detect_entry_t *e = detect->buckets[i];
+        while (e) {
+            detect_entry_t *next = e->next;
+            sa_free(e->summary);
+            sa_free(e);
+            e = next;
+        }
+        detect->buckets[i] = NULL;
+    }
+    detect->count = 0;
+}
+
+/** Double the bucket array; on failure the table just gets longer chains */
+static void _grow_buckets(overlay_detect_t *detect)
+{
+    uint32_t new_mask = detect->mask * 2 + 1;
+    detect_entry_t **buckets = sa_calloc((size_t)new_mask + 1, sizeof(*buckets));
+    if (!buckets) {
+        return;
+    }
+
+    for (uint32_t i = 0; i <= detect->mask; i++) {
+        detect_entry_t *e = detect->buckets[i];
+        while (e) {
+            detect_entry_t *next = e->next;
+            e->next = buckets[e->hash & new_mask];
+            buckets[e->hash & new_mask] = e;
+            e = next;
+        }
+    }
+    sa_free(detect->buckets);
+    detect->buckets = buckets;
+    detect->mask = new_mask;
+}
+
+/** Store a result, replacing an older one (and its summary) for the same path */
+static detect_entry_t *_put_entry(overlay_detect_t *detect, const char *path,
+                                  uint64_t dev, uint64_t ino, uint64_t size,
+                                  int64_t mtime, int is_sacd)
+{
+    uint32_t hash = _hash_path(path);
+    detect_entry_t *e = _find_entry(detect, path, hash);
+
+    if (!e) {
+        /* Entries of deleted files are never dropped one by one, so start
+         * over if the table gets out of hand */
+        if (detect->count >= DETECT_MAX_ENTRIES) {
+            _clear_entries(detect);
+        }
+        if (detect->count >= detect->mask + 1) {
+            _grow_buckets(detect);
+        }
+
+        size_t path_len = strlen(path);
+        e = sa_malloc(sizeof(*e) + path_len + 1);
+        if (!e) {
+            return NULL;
+        }
+        memcpy(e->path, path, path_len + 1);
+        e->hash = hash;
+        e->summary = NULL;
+        e->summary_len = 0;
+        e->next = detect->buckets[hash & detect->mask];
+        detect->buckets[hash & detect->mask] = e;
+        detect->count++;
+    }
+
+    e->dev = dev;
+    e->ino = ino;
+    e->size = size;
+    e->mtime = mtime;
+    e->is_sacd = is_sacd ? 1 : 0;
+    sa_free(e->summary);
+    e->summary = NULL;
+    e->summary_len = 0;
+    detect->dirty = true;
+    return e;
+}
+
+static bool _entry_matches(const detect_entry_t *e, const struct stat *st)
+{
+    return e->dev == (uint64_t)st->st_dev && e->ino == (uint64_t)st->st_ino &&
+           e->size == (uint64_t)st->st_size && e->mtime == (int64_t)st->st_mtime;
+}
+
+/* =============================================================================
+ * Persistence
+ * ===========================================================================*/
+
+static void _load_file(overlay_detect_t *detect)
+{
+    FILE *f = sa_fopen(detect->file_path, "rb");
+    if (!f) {
+        return;
+    }
+
+    uint8_t header[DETECT_FILE_HEADER];
+    if (fread(header, 1, sizeof(header), f) != sizeof(header) ||
+        memcmp(header, DETECT_FILE_MAGIC, 4) != 0 ||
+        SA_RL32(header + 4) != DETECT_FILE_VERSION) {
+        fclose(f);
+        return;
+    }
+
+    uint32_t count = SA_RL32(header + 8);
+    char path[SACD_OVERLAY_MAX_PATH];
+
+    for (uint32_t i = 0; i < count && i < DETECT_MAX_ENTRIES; i++) {
+        uint8_t rec[DETECT_RECORD_HEADER];
+        if (fread(rec, 1, sizeof(rec), f) != sizeof(rec)) {
+            break;
+        }
+        uint16_t path_len = SA_RL16(rec + 33);
+        uint32_t summary_len = SA_RL32(rec + 35);
+        if (path_len == 0 || path_len >= sizeof(path) ||
+            summary_len > DETECT_MAX_SUMMARY ||
+            fread(path, 1, path_len, f) != path_len) {
+            break;
+        }
+        path[path_len] = '\0';
+
+        uint8_t *summary = NULL;
+        if (summary_len > 0) {
+            summary = sa_malloc(summary_len);
+            if (!summary || fread(summary, 1, summary_len, f) != summary_len) {
+                sa_free(summary);
+                break;
+            }
+        }
+
+        detect_entry_t *e = _put_entry(detect, path, SA_RL64(rec),
+                                       SA_RL64(rec + 8), SA_RL64(rec + 16),
+                                       (int64_t)SA_RL64(rec + 24), rec[32]);
+        if (e) {
+            e->summary = summary;
+            e->summary_len = summary_len;
+        } else {
+            sa_free(summary);
+        }
+    }
+    fclose(f);
+
+    detect->dirty = false;
+    sa_log(NULL, SA_LOG_DEBUG, "overlay: loaded %u detection results from %s\n",
+           detect->count, detect->file_path);
+}
+
+/** Write to a temporary file and rename it over the old one */
+static void _save_file(overlay_detect_t *detect)
+{
+    size_t len = strlen(detect->file_path);
+    char *tmp_path = sa_malloc(len + 5);
+    if (!tmp_path) {
+        return;
+    }
+    memcpy(tmp_path, detect->file_path, len);
+    memcpy(tmp_path + len, ".tmp", 5);
+
+    FILE *f = sa_fopen(tmp_path, "wb");
+    if (!f) {
+        sa_free(tmp_path);
+        return;
+    }
+
+    uint8_t header[DETECT_FILE_HEADER];
+    memcpy(header, DETECT_FILE_MAGIC, 4);
+    SA_WL32(header + 4, DETECT_FILE_VERSION);
+    SA_WL32(header + 8, detect->count);
+    int ok = fwrite(header, 1, sizeof(header), f) == sizeof(header);
+
+    for (uint32_t i = 0; ok && i <= detect->mask; i++) {
+        for (detect_entry_t *e = detect->buckets[i]; ok && e; e = e->next) {
+            uint8_t rec[DETECT_RECORD_HEADER];
+            size_t path_len = strlen(e->path);
+
+            SA_WL64(rec, e->dev);
+            SA_WL64(rec + 8, e->ino);
+            SA_WL64(rec + 16, e->size);
+            SA_WL64(rec + 24, (uint64_t)e->mtime);
+            rec[32] = e->is_sacd;
+            SA_WL16(rec + 33, path_len);
+            SA_WL32(rec + 35, e->summary_len);
+            ok = fwrite(rec, 1, sizeof(rec), f) == sizeof(rec) &&
+                 fwrite(e->path, 1, path_len, f) == path_len &&
+                 (e->summary_len == 0 ||
+                  fwrite(e->summary, 1, e->summary_len, f) == e->summary_len);
+        }
+    }
+
+    if (fclose(f) != 0) {
+        ok = 0;
+    }
+    if (ok) {
+#ifdef _WIN32
+        sa_unlink(detect->file_path);
+#endif
+        ok = sa_rename(tmp_path, detect->file_path) == 0;
+    }
+    if (!ok) {
+        sa_log(NULL, SA_LOG_WARNING, "overlay: cannot write %s\n",
+               detect->file_path);
+        sa_unlink(tmp_path);
+    }
+    sa_free(tmp_path);
+}
+
+/* =============================================================================
+ * Detection
+ * ===========================================================================*/
+
+int _overlay_detect_init(sacd_overlay_ctx_t *ctx, const char *cache_dir)
+{
+    overlay_detect_t *detect = sa_mallocz(sizeof(*detect));
+    if (!detect) {
+        return SACD_OVERLAY_ERROR_MEMORY;
+    }
+
+    detect->mask = DETECT_MIN_BUCKETS - 1;
+    detect->buckets = sa_calloc(DETECT_MIN_BUCKETS, sizeof(*detect->buckets));
+    if (!detect->buckets || mtx_init(&detect->lock, mtx_plain) != thrd_success) {
+        sa_free(detect->buckets);
+        sa_free(detect);
+        return SACD_OVERLAY_ERROR_MEMORY;
+    }
+
+    if (cache_dir && cache_dir[0] != '\0') {
+        size_t len = strlen(cache_dir) + 1 + sizeof(DETECT_FILE_NAME);
+        detect->file_path = sa_malloc(len);
+        if (detect->file_path) {
+            sa_snprintf(detect->file_path, len, "%s%c%s",
+                        cache_dir, PATH_SEPARATOR, DETECT_FILE_NAME);
+            _load_file(detect);
+        }
+    }
+
+    ctx->detect = detect;
+    return SACD_OVERLAY_OK;
+}
+
+void _overlay_detect_free(sacd_overlay_ctx_t *ctx)
+{
+    overlay_detect_t *detect = ctx->detect;
+    if (!detect) {
+        return;
+    }
+
+    uint64_t hits, probes;
+    _overlay_detect_get_stats(ctx, &hits, &probes);
+    sa_log(NULL, SA_LOG_DEBUG,
+           "overlay: SACD detection: %llu cached, %llu probed\n",
+           (unsigned long long)hits, (unsigned long long)probes);
+
+    if (detect->file_path && detect->dirty) {
+        _save_file(detect);
+    }
+
+    _clear_entries(detect);
+    sa_free(detect->buckets);
+    sa_free(detect->file_path);
+    mtx_destroy(&detect->lock);
+    sa_free(detect);
+    ctx->detect = NULL;
+}
+
+void _overlay_detect_get_stats(sacd_overlay_ctx_t *ctx, uint64_t *hits,
+                               uint64_t *probes)
+{
+    overlay_detect_t *detect = ctx->detect;
+
+    *hits = 0;
+    *probes = 0;
+    if (detect) {
+        mtx_lock(&detect->lock);
+        *hits = detect->hits;
+        *probes = detect->probes;
+        mtx_unlock(&detect->lock);
+    }
+}
+
+int _overlay_detect_sacd(sacd_overlay_ctx_t *ctx, const char *path,
+                         const struct stat *st)
+{
+    overlay_detect_t *detect = ctx->detect;
+    struct stat own_st;
+
+    if (!st) {
+        if (stat(path, &own_st) != 0) {
+            return 0;
+        }
+        st = &own_st;
+    }
+    if (!detect) {
+        return _overlay_check_sacd_magic(path);
+    }
+
+    mtx_lock(&detect->lock);
+    detect_entry_t *e = _find_entry(detect, path, _hash_path(path));
+    if (e && _entry_matches(e, st)) {
+        int is_sacd = e->is_sacd;
+        detect->hits++;
+        mtx_unlock(&detect->lock);
+        return is_sacd;
+    }
+    detect->probes++;
+    mtx_unlock(&detect->lock);
+
+    /* Probe without the lock held; a concurrent probe of the same file
+     * stores the same result */
+    int is_sacd = _overlay_check_sacd_magic(path);
+
+    mtx_lock(&detect->lock);
+    _put_entry(detect, path, (uint64_t)st->st_dev, (uint64_t)st->st_ino,
+               (uint64_t)st->st_size, (int64_t)st->st_mtime, is_sacd);
+    mtx_unlock(&detect->lock);
+
+    return is_sacd;
+}
+
+int _overlay_detect_get_summary(sacd_overlay_ctx_t *ctx, const char *path,
+                                const struct stat *st, uint8_t **data,
+                                size_t *len)
+{
+    overlay_detect_t *detect = ctx->detect;
+    int found = 0;
+
+    *data = NULL;
+    *len = 0;
+    if (!detect) {
+        return 0;
+    }
+
+    mtx_lock(&detect->lock);
+    detect_entry_t *e = _find_entry(detect, path, _hash_path(path));
+    if (e && e->summary && _entry_matches(e, st)) {
+        *data = sa_malloc(e->summary_len);
+        if (*data) {
+            memcpy(*data, e->summary, e->summary_len);
+            *len = e->summary_len;
+            found = 1;
+        }
+    }
+    mtx_unlock(&detect->lock);
+
+    return found;
+}
+
+void _overlay_detect_set_summary(sacd_overlay_ctx_t *ctx, const char *path,
+                                 const struct stat *st, const uint8_t *data,
+                                 size_t len)
+{
+    overlay_detect_t *detect = ctx->detect;
+    if (!detect || len > DETECT_MAX_SUMMARY) {
+        return;
+    }
+
+    uint8_t *copy = NULL;
+    if (len > 0) {
+        copy = sa_malloc(len);
+        if (!copy) {
+            return;
+        }
+        memcpy(copy, data, len);
+    }
+
+    mtx_lock(&detect->lock);
+    detect_entry_t *e = _find_entry(detect, path, _hash_path(path));
+    if (!e || !_entry_matches(e, st)) {
+        /* Only mounted ISOs get a summary, so this one is an SACD */
+        e = _put_entry(detect, path, (uint64_t)st->st_dev, (uint64_t)st->st_ino,
+                       (uint64_t)st->st_size, (int64_t)st->st_mtime, 1);
+    }
+    if (e) {
+        sa_free(e->summary);
+        e->summary = copy;
+        e->summary_len = (uint32_t)len;
+        detect->dirty = true;
+    } else {
+        sa_free(copy);
+    }
+    mtx_unlock(&detect->lock);
+}
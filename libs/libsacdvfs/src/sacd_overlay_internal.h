@@ -26,13 +26,14 @@
 #include <libsacdvfs/sacd_overlay.h>
 #include <libsacdvfs/sacd_vfs.h>
 
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <time.h>
+#include <sys/stat.h>
 
 #ifdef _WIN32
 #include <windows.h>
-#include <sys/stat.h>
 #define PATH_SEPARATOR '\\'
 #define PATH_SEPARATOR_STR "\\"
 /* POSIX macros not available on Windows */
@@ -67,6 +68,9 @@
  * Internal Types
  * ===========================================================================*/
 
+/** Listing of an ISO folder (sacd_overlay_summary.c) */
+typedef struct iso_summary iso_summary_t;
+
 /** Mounted ISO context */
 typedef struct iso_mount {
     char iso_path[SACD_OVERLAY_MAX_PATH];       /**< Full path to ISO file */
@@ -75,12 +79,33 @@ typedef struct iso_mount {
     char iso_vpath[SACD_OVERLAY_MAX_PATH];      /**< Pre-computed virtual path */
     size_t iso_vpath_len;                       /**< Length of iso_vpath */
     sacd_vfs_ctx_t *vfs;                        /**< libsacdvfs context (lazy) */
+    iso_summary_t *summary;                     /**< Listing without mounting (lazy) */
     int ref_count;                              /**< Reference count */
     time_t last_access;                         /**< Last access time */
     int collision_index;                        /**< 0=none, 1="(1)", etc. */
     mtx_t mount_lock;                        /**< Per-ISO lock */
+    uint32_t path_hash;                         /**< Hash of iso_path */
+    uint32_t vpath_hash;                        /**< Hash of iso_vpath */
+    struct iso_mount *retired_next;             /**< Removed, freed on destroy */
 } iso_mount_t;
 
+/**
+ * Open-addressed hash index of ISO mounts.
+ *
+ * Lookups read the published index without locking. Writers hold
+ * iso_table_lock, fill empty slots in place and publish a larger copy
+ * when the index gets half full. Replaced indices and removed mounts may
+ * still be in use by readers, so they are only freed with the context.
+ */
+typedef struct iso_index {
+    uint32_t mask;                              /**< Slot count - 1 */
+    struct iso_index *retired;                  /**< Index this one replaced */
+    atomic_intptr_t slots[];                    /**< iso_mount_t *, 0 = empty */
+} iso_index_t;
+
+/** Cached SACD detection results (sacd_overlay_detect.c) */
+typedef struct overlay_detect overlay_detect_t;
+
 /** Overlay context structure */
 struct sacd_overlay_ctx {
     char source_dir[SACD_OVERLAY_MAX_PATH];
@@ -92,14 +117,25 @@ struct sacd_overlay_ctx {
     /* Area visibility settings */
     bool stereo_visible;                        /**< Show stereo area */
     bool multichannel_visible;                  /**< Show multichannel area */
+    bool dst_passthrough;                       /**< List .dff files for DST areas */
+    uint32_t pcm_sample_rate;                   /**< Rate of the .wav files, 0 if none */
+    uint16_t pcm_bits;                          /**< Sample size of the .wav files */
 
-    /* ISO mount table (dynamically grown) */
+    /* ISO mount table (dynamically grown), for iteration */
     iso_mount_t **iso_mounts;
     int iso_count;
     int iso_capacity;
 
-    mtx_t iso_table_lock;                    /**< Protects iso_mounts array */
+    /* Lock-free lookup by ISO path and by virtual path (iso_index_t *) */
+    atomic_intptr_t path_index;
+    atomic_intptr_t vpath_index;
+    iso_mount_t *retired_mounts;                /**< Removed mounts */
+
+    mtx_t iso_table_lock;                    /**< Serializes mount table writers */
     sa_tpool *thread_pool;                      /**< Shared DST decode pool */
+    sacd_vfs_block_cache_t *block_cache;        /**< Shared decoded blocks (may be NULL) */
+    sacd_vfs_disk_cache_t *disk_cache;          /**< Transcode cache (may be NULL) */
+    overlay_detect_t *detect;                   /**< SACD detection cache (may be NULL) */
 };
 
 /** File handle structure */
@@ -151,6 +187,33 @@ iso_mount_t *_overlay_get_or_create_iso(sacd_overlay_ctx_t *ctx,
 sacd_vfs_ctx_t *_overlay_ensure_iso_mounted(sacd_overlay_ctx_t *ctx, iso_mount_t *mount);
 void _overlay_release_iso(iso_mount_t *mount);
 void _overlay_cleanup_iso(sacd_overlay_ctx_t *ctx, iso_mount_t *mount);
+void _overlay_free_iso_index(sacd_overlay_ctx_t *ctx);
+
+/* SACD detection cache (implemented in sacd_overlay_detect.c) */
+int _overlay_detect_init(sacd_overlay_ctx_t *ctx, const char *cache_dir);
+void _overlay_detect_free(sacd_overlay_ctx_t *ctx);
+int _overlay_detect_sacd(sacd_overlay_ctx_t *ctx, const char *path,
+                         const struct stat *st);
+void _overlay_detect_get_stats(sacd_overlay_ctx_t *ctx, uint64_t *hits,
+                               uint64_t *probes);
+int _overlay_detect_get_summary(sacd_overlay_ctx_t *ctx, const char *path,
+                                const struct stat *st, uint8_t **data,
+                                size_t *len);
+void _overlay_detect_set_summary(sacd_overlay_ctx_t *ctx, const char *path,
+                                 const struct stat *st, const uint8_t *data,
+                                 size_t len);
+
+/* ISO listing summary (implemented in sacd_overlay_summary.c) */
+int _overlay_summary_stat(sacd_overlay_ctx_t *ctx, iso_mount_t *mount,
+                          const char *inner_path, sacd_vfs_entry_t *entry);
+int _overlay_summary_readdir(sacd_overlay_ctx_t *ctx, iso_mount_t *mount,
+                             const char *inner_path,
+                             sacd_vfs_readdir_callback_t callback,
+                             void *userdata);
+void _overlay_summary_update(sacd_overlay_ctx_t *ctx, iso_mount_t *mount,
+                             sacd_vfs_ctx_t *vfs);
+void _overlay_summary_invalidate(sacd_overlay_ctx_t *ctx, iso_mount_t *mount);
+void _overlay_summary_free(iso_summary_t *summary);
 
 /* Directory scanning */
 typedef int (*dir_scan_callback_t)(const char *name, int is_dir, void *userdata);
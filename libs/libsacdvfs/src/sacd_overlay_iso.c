@@ -38,30 +38,145 @@
 #endif
 
 /* =============================================================================
- * ISO Mount Management
+ * Mount Index
  * ===========================================================================*/
 
+/** FNV-1a hash of the first len bytes of a string */
+static uint32_t _hash_path(const char *str, size_t len)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)str[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static iso_index_t *_load_index(atomic_intptr_t *index)
+{
+    return (iso_index_t *)atomic_load_explicit(index, memory_order_acquire);
+}
+
+static iso_mount_t *_load_slot(iso_index_t *index, uint32_t i)
+{
+    return (iso_mount_t *)atomic_load_explicit(&index->slots[i], memory_order_acquire);
+}
+
 /**
- * Find an existing ISO mount by its source path.
- * Thread-safe: acquires iso_table_lock internally.
+ * Put a mount into the first free slot of its probe sequence.
+ * Caller holds iso_table_lock.
  */
-iso_mount_t *_overlay_find_iso_mount(sacd_overlay_ctx_t *ctx, const char *iso_path)
+static void _index_put(iso_index_t *index, iso_mount_t *mount, uint32_t hash)
 {
-    if (!ctx || !iso_path) return NULL;
+    uint32_t i = hash & index->mask;
+    while (_load_slot(index, i)) {
+        i = (i + 1) & index->mask;
+    }
+    /* Release: readers that see the pointer see the filled-in mount */
+    atomic_store_explicit(&index->slots[i], (intptr_t)mount, memory_order_release);
+}
 
-    mtx_lock(&ctx->iso_table_lock);
+/**
+ * Publish new path and vpath indices holding every registered mount,
+ * sized for at least @p capacity mounts. The old ones are retired, not
+ * freed, as lookups may still be reading them.
+ * Caller holds iso_table_lock.
+ */
+static int _rebuild_indices(sacd_overlay_ctx_t *ctx, int capacity)
+{
+    uint32_t slots = ISO_MOUNTS_INITIAL_CAPACITY * 2;
+    while (slots < (uint32_t)capacity * 2) {
+        slots *= 2;
+    }
 
-    iso_mount_t *found = NULL;
+    size_t size = sizeof(iso_index_t) + (size_t)slots * sizeof(atomic_intptr_t);
+    iso_index_t *by_path = sa_mallocz(size);
+    iso_index_t *by_vpath = sa_mallocz(size);
+    if (!by_path || !by_vpath) {
+        sa_free(by_path);
+        sa_free(by_vpath);
+        return -1;
+    }
+    by_path->mask = slots - 1;
+    by_vpath->mask = slots - 1;
     for (int i = 0; i < ctx->iso_count; i++) {
-        iso_mount_t *mount = ctx->iso_mounts[i];
-        if (mount && strcmp(mount->iso_path, iso_path) == 0) {
-            found = mount;
-            break;
+        _index_put(by_path, ctx->iso_mounts[i], ctx->iso_mounts[i]->path_hash);
+        _index_put(by_vpath, ctx->iso_mounts[i], ctx->iso_mounts[i]->vpath_hash);
+    }
+
+    by_path->retired = _load_index(&ctx->path_index);
+    by_vpath->retired = _load_index(&ctx->vpath_index);
+    atomic_store_explicit(&ctx->path_index, (intptr_t)by_path, memory_order_release);
+    atomic_store_explicit(&ctx->vpath_index, (intptr_t)by_vpath, memory_order_release);
+    return 0;
+}
+
+static iso_mount_t *_lookup_path(sacd_overlay_ctx_t *ctx, const char *iso_path)
+{
+    iso_index_t *index = _load_index(&ctx->path_index);
+    if (!index) return NULL;
+
+    uint32_t hash = _hash_path(iso_path, strlen(iso_path));
+    iso_mount_t *mount;
+    for (uint32_t i = hash & index->mask; (mount = _load_slot(index, i)) != NULL;
+         i = (i + 1) & index->mask) {
+        if (mount->path_hash == hash && strcmp(mount->iso_path, iso_path) == 0) {
+            return mount;
         }
     }
+    return NULL;
+}
 
-    mtx_unlock(&ctx->iso_table_lock);
-    return found;
+static iso_mount_t *_lookup_vpath(iso_index_t *index, const char *vpath, size_t len)
+{
+    uint32_t hash = _hash_path(vpath, len);
+    iso_mount_t *mount;
+    for (uint32_t i = hash & index->mask; (mount = _load_slot(index, i)) != NULL;
+         i = (i + 1) & index->mask) {
+        if (mount->vpath_hash == hash && mount->iso_vpath_len == len &&
+            memcmp(mount->iso_vpath, vpath, len) == 0) {
+            return mount;
+        }
+    }
+    return NULL;
+}
+
+void _overlay_free_iso_index(sacd_overlay_ctx_t *ctx)
+{
+    atomic_intptr_t *indices[2] = { &ctx->path_index, &ctx->vpath_index };
+
+    for (int i = 0; i < 2; i++) {
+        iso_index_t *index = _load_index(indices[i]);
+        while (index) {
+            iso_index_t *retired = index->retired;
+            sa_free(index);
+            index = retired;
+        }
+        atomic_store_explicit(indices[i], 0, memory_order_relaxed);
+    }
+
+    while (ctx->retired_mounts) {
+        iso_mount_t *mount = ctx->retired_mounts;
+        ctx->retired_mounts = mount->retired_next;
+        mtx_destroy(&mount->mount_lock);
+        _overlay_summary_free(mount->summary);
+        sa_free(mount);
+    }
+}
+
+/* =============================================================================
+ * ISO Mount Management
+ * ===========================================================================*/
+
+/**
+ * Find an existing ISO mount by its source path.
+ * Lock-free: reads the published path index.
+ */
+iso_mount_t *_overlay_find_iso_mount(sacd_overlay_ctx_t *ctx, const char *iso_path)
+{
+    if (!ctx || !iso_path) return NULL;
+
+    return _lookup_path(ctx, iso_path);
 }
 
 /**
@@ -70,11 +185,17 @@ iso_mount_t *_overlay_find_iso_mount(sacd_overlay_ctx_t *ctx, const char *iso_pa
  * The virtual path might be:
  * - The ISO folder itself: /parent/Album
  * - Inside the ISO: /parent/Album/Stereo/01. Track.dsf
+ *
+ * Each prefix ending at a path component is looked up, longest first, so
+ * the most specific mount wins. Lock-free: reads the published vpath index.
  */
 iso_mount_t *_overlay_find_iso_by_vpath(sacd_overlay_ctx_t *ctx, const char *vpath)
 {
     if (!ctx || !vpath) return NULL;
 
+    iso_index_t *index = _load_index(&ctx->vpath_index);
+    if (!index) return NULL;
+
     /* Normalize the path */
     char norm_path[SACD_OVERLAY_MAX_PATH];
     sa_strlcpy(norm_path, vpath, sizeof(norm_path));
@@ -90,32 +211,21 @@ iso_mount_t *_overlay_find_iso_by_vpath(sacd_overlay_ctx_t *ctx, const char *vpa
         norm_path[--len] = '\0';
     }
 
-    mtx_lock(&ctx->iso_table_lock);
-
-    iso_mount_t *found = NULL;
-    size_t best_match_len = 0;
-
-    for (int i = 0; i < ctx->iso_count; i++) {
-        iso_mount_t *mount = ctx->iso_mounts[i];
-        if (!mount || mount->iso_vpath_len == 0) continue;
-
-        /* Use pre-computed virtual path for fast comparison */
-        if (strncmp(norm_path, mount->iso_vpath, mount->iso_vpath_len) == 0) {
-            /* Must be exact match or followed by / */
-            if (norm_path[mount->iso_vpath_len] == '\0' ||
-                norm_path[mount->iso_vpath_len] == '/') {
-                /* Prefer longer matches (more specific paths) */
-                if (mount->iso_vpath_len > best_match_len) {
-                    found = mount;
-                    best_match_len = mount->iso_vpath_len;
-                }
-            }
+    while (len > 1) {
+        iso_mount_t *found = _lookup_vpath(index, norm_path, len);
+        if (found) {
+            return found;
+        }
+        /* Drop the last component */
+        while (len > 0 && norm_path[len - 1] != '/') {
+            len--;
+        }
+        if (len > 0) {
+            len--;
         }
     }
 
-    mtx_unlock(&ctx->iso_table_lock);
-
-    return found;
+    return NULL;
 }
 
 /**
@@ -131,16 +241,16 @@ iso_mount_t *_overlay_get_or_create_iso(sacd_overlay_ctx_t *ctx,
         return NULL;
     }
 
+    /* Already registered: the common case on every readdir */
+    iso_mount_t *mount = _lookup_path(ctx, iso_path);
+    if (mount) {
+        return mount;
+    }
+
     mtx_lock(&ctx->iso_table_lock);
 
-    /* Check if already exists */
-    iso_mount_t *mount = NULL;
-    for (int i = 0; i < ctx->iso_count; i++) {
-        if (ctx->iso_mounts[i] && strcmp(ctx->iso_mounts[i]->iso_path, iso_path) == 0) {
-            mount = ctx->iso_mounts[i];
-            break;
-        }
-    }
+    /* Another thread may have registered it meanwhile */
+    mount = _lookup_path(ctx, iso_path);
 
     if (!mount) {
         /* Check user-configured soft limit */
@@ -152,7 +262,7 @@ iso_mount_t *_overlay_get_or_create_iso(sacd_overlay_ctx_t *ctx,
             return NULL;
         }
 
-        /* Grow array if needed */
+        /* Grow array and indices if needed */
         if (ctx->iso_count >= ctx->iso_capacity) {
             int new_cap = ctx->iso_capacity ? ctx->iso_capacity * 2
                                             : ISO_MOUNTS_INITIAL_CAPACITY;
@@ -170,6 +280,13 @@ iso_mount_t *_overlay_get_or_create_iso(sacd_overlay_ctx_t *ctx,
                    (size_t)(new_cap - ctx->iso_capacity) * sizeof(iso_mount_t *));
             ctx->iso_mounts = new_arr;
             ctx->iso_capacity = new_cap;
+
+            if (_rebuild_indices(ctx, new_cap) != 0) {
+                sa_log(NULL, SA_LOG_ERROR,
+                       "overlay: failed to grow mount index to %d\n", new_cap);
+                mtx_unlock(&ctx->iso_table_lock);
+                return NULL;
+            }
         }
 
         /* Create new mount entry */
@@ -193,7 +310,10 @@ iso_mount_t *_overlay_get_or_create_iso(sacd_overlay_ctx_t *ctx,
                         "%s/%s", parent_vpath, display_name);
         }
         mount->iso_vpath_len = strlen(mount->iso_vpath);
+        mount->path_hash = _hash_path(mount->iso_path, strlen(mount->iso_path));
+        mount->vpath_hash = _hash_path(mount->iso_vpath, mount->iso_vpath_len);
         mount->vfs = NULL;  /* Lazy loaded */
+        mount->summary = NULL;
         mount->ref_count = 0;
         mount->last_access = time(NULL);
 
@@ -204,6 +324,8 @@ iso_mount_t *_overlay_get_or_create_iso(sacd_overlay_ctx_t *ctx,
         }
 
         ctx->iso_mounts[ctx->iso_count++] = mount;
+        _index_put(_load_index(&ctx->path_index), mount, mount->path_hash);
+        _index_put(_load_index(&ctx->vpath_index), mount, mount->vpath_hash);
 
         sa_log(NULL, SA_LOG_VERBOSE,
                "overlay: registered ISO #%d: %s\n",
@@ -237,6 +359,15 @@ sacd_vfs_ctx_t *_overlay_ensure_iso_mounted(sacd_overlay_ctx_t *ctx, iso_mount_t
                                           ctx->stereo_visible);
             sacd_vfs_set_area_visibility(mount->vfs, SACD_VFS_AREA_MULTICHANNEL,
                                           ctx->multichannel_visible);
+            sacd_vfs_set_dst_passthrough(mount->vfs, ctx->dst_passthrough);
+            if (sacd_vfs_set_pcm_rendition(mount->vfs, ctx->pcm_sample_rate,
+                                           ctx->pcm_bits) != SACD_VFS_OK) {
+                sa_log(NULL, SA_LOG_WARNING,
+                       "overlay: unsupported WAV format %u Hz/%u bit, not listed\n",
+                       ctx->pcm_sample_rate, ctx->pcm_bits);
+            }
+            sacd_vfs_set_block_cache(mount->vfs, ctx->block_cache);
+            sacd_vfs_set_disk_cache(mount->vfs, ctx->disk_cache);
 
             int result = sacd_vfs_open(mount->vfs, mount->iso_path);
             if (result != SACD_VFS_OK) {
@@ -303,7 +434,6 @@ void _overlay_cleanup_iso(sacd_overlay_ctx_t *ctx, iso_mount_t *mount)
                 mount->vfs = NULL;
             }
             mtx_unlock(&mount->mount_lock);
-            mtx_destroy(&mount->mount_lock);
 
             /* Remove from array */
             for (int j = i; j < ctx->iso_count - 1; j++) {
@@ -311,7 +441,11 @@ void _overlay_cleanup_iso(sacd_overlay_ctx_t *ctx, iso_mount_t *mount)
             }
             ctx->iso_mounts[--ctx->iso_count] = NULL;
 
-            sa_free(mount);
+            /* Open addressing has no in-place delete; publish fresh indices.
+             * Lookups may still hold the mount, so it is freed with ctx. */
+            _rebuild_indices(ctx, ctx->iso_capacity);
+            mount->retired_next = ctx->retired_mounts;
+            ctx->retired_mounts = mount;
             break;
         }
     }
@@ -209,8 +209,9 @@ int _overlay_check_sacd_magic(const char *path)
 
     /* Try to initialize the reader with this file.
      * Use TOC copy 1 for both master and area (same as actual file open).
+     * Detection never looks at text or access lists, so skip decoding them.
      */
-    int result = sacd_init(reader, path, 1, 1);
+    int result = sacd_init_ex(reader, path, 1, 1, SACD_INIT_LAZY_TOC);
 
     int is_sacd = (result == SACD_OK);
 
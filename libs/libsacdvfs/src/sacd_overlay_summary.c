@@ -0,0 +1,624 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief SACD Overlay VFS - ISO Listing Summary
+ * Answers stat and readdir inside an ISO folder without mounting the ISO.
+ * The summary holds what those calls report: album name, visible areas,
+ * track file names and virtual file sizes. It is built once from a mounted
+ * ISO and stored with the SACD detection result, so it survives idle
+ * unmounts and, with a cache directory, restarts. Reading a track still
+ * mounts the ISO.
+ *
+ * The lookups mirror sacd_vfs_stat() and sacd_vfs_readdir(), so callers
+ * see the same entries whether or not the ISO is mounted.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "sacd_overlay_internal.h"
+
+#include <libsautil/mem.h>
+#include <libsautil/log.h>
+#include <libsautil/compat.h>
+#include <libsautil/intreadwrite.h>
+#include <libsautil/sastring.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/*
+ * Encoded layout (little endian):
+ *
+ *   u8   version
+ *   u8   settings it was built with (bit 0 stereo, bit 1 MC, bit 2 .dff)
+ *   u8   1 if the XML sidecar existed
+ *   u64  sidecar size
+ *   i64  sidecar mtime
+ *   u32  .wav sample rate (0 if none), u8 .wav bits per sample
+ *   u16  album name length, album name
+ *   u8   area count
+ *   per area:  u8 area, u8 track count
+ *     per track: u64 size, u64 .dff size, u64 .wav size (0 if not listed),
+ *                u16 name length, name
+ *
+ * The .dff and .wav names are the track name with its extension swapped.
+ */
+#define SUMMARY_VERSION         3
+#define SUMMARY_HEADER          24
+#define SUMMARY_TRACK           26
+
+/** One track file */
+typedef struct {
+    char *name;
+    uint64_t size;
+    uint64_t dff_size;      /* DSDIFF/DST twin, 0 if not listed */
+    uint64_t wav_size;      /* PCM rendition, 0 if not listed */
+} summary_track_t;
+
+/** One visible area directory */
+typedef struct {
+    sacd_vfs_area_t area;
+    uint8_t track_count;
+    summary_track_t *tracks;
+} summary_area_t;
+
+struct iso_summary {
+    char album_name[SACD_VFS_MAX_FILENAME];
+    int area_count;
+    summary_area_t areas[2];
+};
+
+/** Sidecar state and settings a summary is only valid for */
+typedef struct {
+    uint8_t visible;
+    uint8_t has_sidecar;
+    uint64_t sidecar_size;
+    int64_t sidecar_mtime;
+    uint32_t pcm_sample_rate;
+    uint8_t pcm_bits;
+} summary_key_t;
+
+static const char *_area_dir_name(sacd_vfs_area_t area)
+{
+    return area == SACD_VFS_AREA_MULTICHANNEL ? "Multi-channel" : "Stereo";
+}
+
+void _overlay_summary_free(iso_summary_t *summary)
+{
+    if (!summary) return;
+
+    for (int a = 0; a < summary->area_count; a++) {
+        for (int t = 0; t < summary->areas[a].track_count; t++) {
+            sa_free(summary->areas[a].tracks[t].name);
+        }
+        sa_free(summary->areas[a].tracks);
+    }
+    sa_free(summary);
+}
+
+static void _current_key(sacd_overlay_ctx_t *ctx, const iso_mount_t *mount,
+                         summary_key_t *key)
+{
+    char xml_path[SACD_OVERLAY_MAX_PATH];
+    struct stat st;
+
+    memset(key, 0, sizeof(*key));
+    key->visible = (ctx->stereo_visible ? 1 : 0) |
+                   (ctx->multichannel_visible ? 2 : 0) |
+                   (ctx->dst_passthrough ? 4 : 0);
+    if (ctx->pcm_sample_rate != 0) {
+        key->pcm_sample_rate = ctx->pcm_sample_rate;
+        key->pcm_bits = (uint8_t)ctx->pcm_bits;
+    }
+
+    /* ID3 edits live in {iso}.xml and change the virtual file sizes */
+    sa_snprintf(xml_path, sizeof(xml_path), "%s.xml", mount->iso_path);
+    if (stat(xml_path, &st) == 0) {
+        key->has_sidecar = 1;
+        key->sidecar_size = (uint64_t)st.st_size;
+        key->sidecar_mtime = (int64_t)st.st_mtime;
+    }
+}
+
+/* =============================================================================
+ * Building and Encoding
+ * ===========================================================================*/
+
+static iso_summary_t *_build_summary(sacd_vfs_ctx_t *vfs)
+{
+    iso_summary_t *summary = sa_mallocz(sizeof(*summary));
+    if (!summary) {
+        return NULL;
+    }
+
+    if (sacd_vfs_get_album_name(vfs, summary->album_name,
+                                sizeof(summary->album_name)) != SACD_VFS_OK) {
+        sa_free(summary);
+        return NULL;
+    }
+
+    for (int a = SACD_VFS_AREA_STEREO; a <= SACD_VFS_AREA_MULTICHANNEL; a++) {
+        sacd_vfs_area_t area = (sacd_vfs_area_t)a;
+        uint8_t track_count = 0;
+
+        if (!sacd_vfs_should_show_area(vfs, area) ||
+            sacd_vfs_get_track_count(vfs, area, &track_count) != SACD_VFS_OK) {
+            continue;
+        }
+
+        summary_area_t *sa = &summary->areas[summary->area_count++];
+        sa->area = area;
+        if (track_count == 0) {
+            continue;
+        }
+        sa->tracks = sa_calloc(track_count, sizeof(*sa->tracks));
+        if (!sa->tracks) {
+            _overlay_summary_free(summary);
+            return NULL;
+        }
+
+        for (uint8_t t = 1; t <= track_count; t++) {
+            summary_track_t *track = &sa->tracks[t - 1];
+            char name[SACD_VFS_MAX_FILENAME];
+            char path[32];
+            sacd_vfs_file_t *file = NULL;
+            sacd_vfs_file_info_t info;
+
+            sa->track_count = t;
+            sacd_vfs_get_track_filename(vfs, area, t, name, sizeof(name));
+            track->name = sa_strdup(name);
+            if (!track->name) {
+                _overlay_summary_free(summary);
+                return NULL;
+            }
+
+            /* The file layout gives the size; no audio is read.
+             * File lookup only needs the area and the "NN." prefix. */
+            sa_snprintf(path, sizeof(path), "/%s/%02u.", _area_dir_name(area), t);
+            if (sacd_vfs_file_open(vfs, path, &file) == SACD_VFS_OK) {
+                if (sacd_vfs_file_get_info(file, &info) == SACD_VFS_OK) {
+                    track->size = info.total_size;
+                }
+                sacd_vfs_file_close(file);
+            }
+
+            /* Fails unless the area lists DSDIFF/DST files */
+            sa_snprintf(path, sizeof(path), "/%s/%02u.dff", _area_dir_name(area), t);
+            if (sacd_vfs_file_open(vfs, path, &file) == SACD_VFS_OK) {
+                if (sacd_vfs_file_get_info(file, &info) == SACD_VFS_OK) {
+                    track->dff_size = info.total_size;
+                }
+                sacd_vfs_file_close(file);
+            }
+
+            /* Fails unless PCM renditions are listed */
+            sa_snprintf(path, sizeof(path), "/%s/%02u.wav", _area_dir_name(area), t);
+            if (sacd_vfs_file_open(vfs, path, &file) == SACD_VFS_OK) {
+                if (sacd_vfs_file_get_info(file, &info) == SACD_VFS_OK) {
+                    track->wav_size = info.total_size;
+                }
+                sacd_vfs_file_close(file);
+            }
+        }
+    }
+
+    return summary;
+}
+
+static size_t _encoded_size(const iso_summary_t *summary)
+{
+    size_t len = SUMMARY_HEADER + 2 + strlen(summary->album_name) + 1;
+    for (int a = 0; a < summary->area_count; a++) {
+        len += 2;
+        for (int t = 0; t < summary->areas[a].track_count; t++) {
+            len += SUMMARY_TRACK + strlen(summary->areas[a].tracks[t].name);
+        }
+    }
+    return len;
+}
+
+static uint8_t *_encode_summary(const iso_summary_t *summary,
+                                const summary_key_t *key, size_t *len)
+{
+    *len = _encoded_size(summary);
+    uint8_t *data = sa_malloc(*len);
+    if (!data) {
+        return NULL;
+    }
+
+    uint8_t *p = data;
+    size_t n;
+
+    p[0] = SUMMARY_VERSION;
+    p[1] = key->visible;
+    p[2] = key->has_sidecar;
+    SA_WL64(p + 3, key->sidecar_size);
+    SA_WL64(p + 11, (uint64_t)key->sidecar_mtime);
+    SA_WL32(p + 19, key->pcm_sample_rate);
+    p[23] = key->pcm_bits;
+    p += SUMMARY_HEADER;
+
+    n = strlen(summary->album_name);
+    SA_WL16(p, n);
+    memcpy(p + 2, summary->album_name, n);
+    p += 2 + n;
+
+    *p++ = (uint8_t)summary->area_count;
+    for (int a = 0; a < summary->area_count; a++) {
+        const summary_area_t *sa = &summary->areas[a];
+        *p++ = (uint8_t)sa->area;
+        *p++ = sa->track_count;
+        for (int t = 0; t < sa->track_count; t++) {
+            n = strlen(sa->tracks[t].name);
+            SA_WL64(p, sa->tracks[t].size);
+            SA_WL64(p + 8, sa->tracks[t].dff_size);
+            SA_WL64(p + 16, sa->tracks[t].wav_size);
+            SA_WL16(p + 24, n);
+            memcpy(p + SUMMARY_TRACK, sa->tracks[t].name, n);
+            p += SUMMARY_TRACK + n;
+        }
+    }
+
+    return data;
+}
+
+/** Decode a summary; NULL if malformed or built for another key */
+static iso_summary_t *_decode_summary(const uint8_t *data, size_t len,
+                                      const summary_key_t *key)
+{
+    const uint8_t *p = data;
+    const uint8_t *end = data + len;
+    size_t n;
+
+    if (len < SUMMARY_HEADER + 3 || p[0] != SUMMARY_VERSION ||
+        p[1] != key->visible || p[2] != key->has_sidecar ||
+        SA_RL64(p + 3) != key->sidecar_size ||
+        (int64_t)SA_RL64(p + 11) != key->sidecar_mtime ||
+        SA_RL32(p + 19) != key->pcm_sample_rate || p[23] != key->pcm_bits) {
+        return NULL;
+    }
+    p += SUMMARY_HEADER;
+
+    iso_summary_t *summary = sa_mallocz(sizeof(*summary));
+    if (!summary) {
+        return NULL;
+    }
+
+    n = SA_RL16(p);
+    p += 2;
+    if (n >= sizeof(summary->album_name) || (size_t)(end - p) < n + 1) {
+        goto fail;
+    }
+    memcpy(summary->album_name, p, n);
+    p += n;
+
+    uint8_t area_count = *p++;
+    if (area_count > 2) {
+        goto fail;
+    }
+    for (uint8_t a = 0; a < area_count; a++) {
+        summary_area_t *sa = &summary->areas[summary->area_count++];
+        if (end - p < 2 || p[0] > SACD_VFS_AREA_MULTICHANNEL) {
+            goto fail;
+        }
+        sa->area = (sacd_vfs_area_t)p[0];
+        uint8_t track_count = p[1];
+        p += 2;
+        if (track_count == 0) {
+            continue;
+        }
+
+        sa->tracks = sa_calloc(track_count, sizeof(*sa->tracks));
+        if (!sa->tracks) {
+            goto fail;
+        }
+        for (uint8_t t = 0; t < track_count; t++) {
+            if (end - p < SUMMARY_TRACK) {
+                goto fail;
+            }
+            n = SA_RL16(p + 24);
+            if (n < 4 || n >= SACD_VFS_MAX_FILENAME ||
+                (size_t)(end - p - SUMMARY_TRACK) < n) {
+                goto fail;
+            }
+            summary_track_t *track = &sa->tracks[t];
+            track->name = sa_malloc(n + 1);
+            if (!track->name) {
+                goto fail;
+            }
+            sa->track_count = t + 1;
+            track->size = SA_RL64(p);
+            track->dff_size = SA_RL64(p + 8);
+            track->wav_size = SA_RL64(p + 16);
+            memcpy(track->name, p + SUMMARY_TRACK, n);
+            track->name[n] = '\0';
+            p += SUMMARY_TRACK + n;
+        }
+    }
+
+    return summary;
+
+fail:
+    _overlay_summary_free(summary);
+    return NULL;
+}
+
+/* =============================================================================
+ * Lookups
+ * ===========================================================================*/
+
+/** Summary of a mount, loading a stored one if needed. Needs mount_lock. */
+static iso_summary_t *_get_summary(sacd_overlay_ctx_t *ctx, iso_mount_t *mount)
+{
+    if (mount->summary) {
+        return mount->summary;
+    }
+
+    struct stat st;
+    uint8_t *data;
+    size_t len;
+    if (stat(mount->iso_path, &st) != 0 ||
+        !_overlay_detect_get_summary(ctx, mount->iso_path, &st, &data, &len)) {
+        return NULL;
+    }
+
+    summary_key_t key;
+    _current_key(ctx, mount, &key);
+    mount->summary = _decode_summary(data, len, &key);
+    sa_free(data);
+
+    return mount->summary;
+}
+
+static const summary_area_t *_find_area(const iso_summary_t *summary,
+                                        sacd_vfs_area_t area)
+{
+    for (int a = 0; a < summary->area_count; a++) {
+        if (summary->areas[a].area == area) {
+            return &summary->areas[a];
+        }
+    }
+    return NULL;
+}
+
+static int _lookup_stat(const iso_summary_t *summary, const char *path,
+                        sacd_vfs_entry_t *entry)
+{
+    char dir_path[SACD_VFS_MAX_PATH];
+
+    memset(entry, 0, sizeof(*entry));
+
+    if (strcmp(path, "/") == 0) {
+        sa_strlcpy(entry->name, "/", sizeof(entry->name));
+        entry->type = SACD_VFS_ENTRY_DIRECTORY;
+        return SACD_VFS_OK;
+    }
+
+    sa_snprintf(dir_path, sizeof(dir_path), "/%s", summary->album_name);
+    if (strcmp(path, dir_path) == 0) {
+        sa_strlcpy(entry->name, summary->album_name, sizeof(entry->name));
+        entry->type = SACD_VFS_ENTRY_DIRECTORY;
+        return SACD_VFS_OK;
+    }
+
+    for (int a = 0; a < summary->area_count; a++) {
+        const char *dir_name = _area_dir_name(summary->areas[a].area);
+        sa_snprintf(dir_path, sizeof(dir_path), "/%s/%s",
+                    summary->album_name, dir_name);
+        if (strcmp(path, dir_path) == 0) {
+            sa_strlcpy(entry->name, dir_name, sizeof(entry->name));
+            entry->type = SACD_VFS_ENTRY_DIRECTORY;
+            return SACD_VFS_OK;
+        }
+    }
+
+    /* Track file: same matching as sacd_vfs_file_open() */
+    sacd_vfs_area_t area;
+    if (strstr(path, "Stereo") != NULL) {
+        area = SACD_VFS_AREA_STEREO;
+    } else if (strstr(path, "Multi-channel") != NULL) {
+        area = SACD_VFS_AREA_MULTICHANNEL;
+    } else {
+        return SACD_VFS_ERROR_NOT_FOUND;
+    }
+
+    const summary_area_t *sa = _find_area(summary, area);
+    if (!sa) {
+        return SACD_VFS_ERROR_NOT_FOUND;
+    }
+
+    const char *fname = strrchr(path, '/');
+    fname = fname ? fname + 1 : path;
+
+    uint8_t track_num = 0;
+    if (sscanf(fname, "%hhu.", &track_num) != 1 || track_num == 0 ||
+        track_num > sa->track_count) {
+        return SACD_VFS_ERROR_NOT_FOUND;
+    }
+
+    /* Same tests as sacd_vfs_file_open() for the DSDIFF/DST and WAV twins */
+    const summary_track_t *track = &sa->tracks[track_num - 1];
+    size_t len = strlen(fname);
+    uint64_t size = track->size;
+    if (len >= 4 && (strcmp(fname + len - 4, ".dff") == 0 ||
+                     strcmp(fname + len - 4, ".wav") == 0)) {
+        size = fname[len - 1] == 'f' ? track->dff_size : track->wav_size;
+        if (size == 0) {
+            return SACD_VFS_ERROR_NOT_FOUND;
+        }
+    }
+
+    sa_strlcpy(entry->name, fname, sizeof(entry->name));
+    entry->type = SACD_VFS_ENTRY_FILE;
+    entry->size = size;
+    entry->track_num = track_num;
+    entry->area = area;
+    return SACD_VFS_OK;
+}
+
+/** Entries of a directory, same matching as sacd_vfs_readdir() */
+static int _lookup_dir(const iso_summary_t *summary, const char *path,
+                       sacd_vfs_entry_t *entries)
+{
+    char album_path[SACD_VFS_MAX_PATH];
+    int count = 0;
+
+    if (strcmp(path, "/") == 0) {
+        memset(&entries[0], 0, sizeof(entries[0]));
+        sa_strlcpy(entries[0].name, summary->album_name, sizeof(entries[0].name));
+        entries[0].type = SACD_VFS_ENTRY_DIRECTORY;
+        return 1;
+    }
+
+    sa_snprintf(album_path, sizeof(album_path), "/%s", summary->album_name);
+    if (strcmp(path, album_path) == 0 || strcmp(path, album_path + 1) == 0) {
+        for (int a = 0; a < summary->area_count; a++) {
+            memset(&entries[count], 0, sizeof(entries[count]));
+            sa_strlcpy(entries[count].name, _area_dir_name(summary->areas[a].area),
+                       sizeof(entries[count].name));
+            entries[count].type = SACD_VFS_ENTRY_DIRECTORY;
+            count++;
+        }
+        return count;
+    }
+
+    const summary_area_t *sa = NULL;
+    if (strstr(path, "Stereo") != NULL) {
+        sa = _find_area(summary, SACD_VFS_AREA_STEREO);
+    }
+    if (!sa && strstr(path, "Multi-channel") != NULL) {
+        sa = _find_area(summary, SACD_VFS_AREA_MULTICHANNEL);
+    }
+    if (!sa) {
+        return SACD_VFS_ERROR_NOT_FOUND;
+    }
+
+    for (int t = 0; t < sa->track_count; t++) {
+        memset(&entries[count], 0, sizeof(entries[count]));
+        sa_strlcpy(entries[count].name, sa->tracks[t].name,
+                   sizeof(entries[count].name));
+        entries[count].type = SACD_VFS_ENTRY_FILE;
+        entries[count].size = sa->tracks[t].size;
+        entries[count].track_num = (uint8_t)(t + 1);
+        entries[count].area = sa->area;
+        count++;
+
+        size_t dsf = (size_t)(count - 1);
+        if (sa->tracks[t].dff_size != 0) {
+            entries[count] = entries[dsf];
+            memcpy(entries[count].name + strlen(entries[count].name) - 4, ".dff", 4);
+            entries[count].size = sa->tracks[t].dff_size;
+            count++;
+        }
+        if (sa->tracks[t].wav_size != 0) {
+            entries[count] = entries[dsf];
+            memcpy(entries[count].name + strlen(entries[count].name) - 4, ".wav", 4);
+            entries[count].size = sa->tracks[t].wav_size;
+            count++;
+        }
+    }
+    return count;
+}
+
+int _overlay_summary_stat(sacd_overlay_ctx_t *ctx, iso_mount_t *mount,
+                          const char *inner_path, sacd_vfs_entry_t *entry)
+{
+    mtx_lock(&mount->mount_lock);
+
+    iso_summary_t *summary = _get_summary(ctx, mount);
+    int result = summary ? _lookup_stat(summary, inner_path, entry)
+                         : SACD_VFS_ERROR_NOT_OPEN;
+
+    mtx_unlock(&mount->mount_lock);
+    return result;
+}
+
+int _overlay_summary_readdir(sacd_overlay_ctx_t *ctx, iso_mount_t *mount,
+                             const char *inner_path,
+                             sacd_vfs_readdir_callback_t callback,
+                             void *userdata)
+{
+    /* At most 255 tracks per area, each with possible .dff and .wav twins;
+     * copy them out so the callback runs without the mount lock */
+    sacd_vfs_entry_t *entries = sa_malloc(3 * 255 * sizeof(*entries));
+    if (!entries) {
+        return SACD_VFS_ERROR_MEMORY;
+    }
+
+    mtx_lock(&mount->mount_lock);
+
+    iso_summary_t *summary = _get_summary(ctx, mount);
+    int count = summary ? _lookup_dir(summary, inner_path, entries)
+                        : SACD_VFS_ERROR_NOT_OPEN;
+
+    mtx_unlock(&mount->mount_lock);
+
+    int listed = count;
+    for (int i = 0; i < count; i++) {
+        if (callback(&entries[i], userdata) != 0) {
+            listed = i;
+            break;
+        }
+    }
+
+    sa_free(entries);
+    return listed;
+}
+
+/* =============================================================================
+ * Maintenance
+ * ===========================================================================*/
+
+void _overlay_summary_update(sacd_overlay_ctx_t *ctx, iso_mount_t *mount,
+                             sacd_vfs_ctx_t *vfs)
+{
+    mtx_lock(&mount->mount_lock);
+
+    if (!mount->summary) {
+        summary_key_t key;
+        struct stat st;
+
+        _current_key(ctx, mount, &key);
+        mount->summary = _build_summary(vfs);
+
+        if (mount->summary && stat(mount->iso_path, &st) == 0) {
+            size_t len;
+            uint8_t *data = _encode_summary(mount->summary, &key, &len);
+            if (data) {
+                _overlay_detect_set_summary(ctx, mount->iso_path, &st, data, len);
+                sa_free(data);
+            }
+        }
+    }
+
+    mtx_unlock(&mount->mount_lock);
+}
+
+void _overlay_summary_invalidate(sacd_overlay_ctx_t *ctx, iso_mount_t *mount)
+{
+    struct stat st;
+
+    mtx_lock(&mount->mount_lock);
+
+    _overlay_summary_free(mount->summary);
+    mount->summary = NULL;
+    if (stat(mount->iso_path, &st) == 0) {
+        _overlay_detect_set_summary(ctx, mount->iso_path, &st, NULL, 0);
+    }
+
+    mtx_unlock(&mount->mount_lock);
+}
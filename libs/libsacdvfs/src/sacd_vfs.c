@@ -26,18 +26,24 @@
 /* SACD library headers */
 #include <libsacd/sacd.h>
 #include "sacd_id3.h"
+#include "sacd_vfs_cache.h"
+#include "sacd_vfs_dff.h"
+#include "sacd_vfs_internal.h"
+#include "sacd_vfs_pcm.h"
 
 /* DST decoder for compressed streams (single-threaded) */
 #include <libdst/decoder.h>
+#include <libdsdpcm/dsdpcm.h>
 
 /* Utility headers */
 #include <libsautil/buffer.h>
 #include <libsautil/mem.h>
-#include <libsautil/reverse.h>
+#include <libsautil/dsdinterleave.h>
 #include <libsautil/sastring.h>
 #include <libsautil/sa_tpool.h>
 #include <libsautil/base64.h>
 #include <libsautil/log.h>
+#include <libsautil/time.h>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -79,6 +85,13 @@ typedef struct {
     bool from_xml;   /* true if loaded from XML sidecar */
 } id3_cache_entry_t;
 
+/** Frame sizes of a track, scanned for its .dff file */
+typedef struct {
+    uint32_t *frame_size;          /* NULL until scanned */
+    uint32_t frames_found;         /* Frames on the disc; the rest are silence */
+    bool scanning;                 /* A file open is scanning the track */
+} dff_track_t;
+
 /** Area information cache */
 typedef struct {
     bool available;
@@ -87,6 +100,7 @@ typedef struct {
     uint32_t sample_rate;
     sacd_vfs_frame_format_t frame_format;
     id3_cache_entry_t *id3_cache;  /* Array of track_count entries */
+    dff_track_t *dff_tracks;       /* Array of track_count entries, or NULL */
 } area_info_t;
 
 /* =============================================================================
@@ -103,8 +117,8 @@ typedef enum {
 
 /** DST decode job (dispatched to thread pool workers) */
 typedef struct {
-    sa_buffer_ref_t *compressed_ref;    /* Pool ref for compressed DST frame */
-    uint8_t *compressed_data;           /* == compressed_ref->data */
+    sa_buffer_ref_t *compressed_ref;    /* Sector buffer holding the compressed DST frame */
+    uint8_t *compressed_data;           /* Points into compressed_ref (read-only) */
     int compressed_size;
     int channel_count;
     int sample_rate;
@@ -120,6 +134,30 @@ typedef struct {
 /** Minimum queue depth for MT process queue */
 #define VFS_MT_MIN_QUEUE_DEPTH 16
 
+/** Frames decoded ahead after a start or seek; doubles while reads stay
+ * sequential, up to the process queue depth */
+#define VFS_MT_INITIAL_WINDOW 2
+
+/** Frames over which a reader's speed is measured (one second of audio) */
+#define VFS_MT_RATE_WINDOW SACD_FRAMES_PER_SEC
+
+/** A reader consuming frames faster than this many times real time is a
+ * copy or rip, and its decode jobs yield to the readers that play */
+#define VFS_MT_BULK_SPEED 4
+
+/** Pool priority of playing readers; copies run at the default 0 */
+#define VFS_MT_PLAYBACK_PRIORITY 1
+
+/** Compressed frames the MT reader fetches per libsacd call */
+#define VFS_MT_READ_BATCH 32
+
+/** Block groups of decoder output skipped, rather than restarting the
+ * decoder, when the block cache served a reader ahead of its decoder */
+#define VFS_CACHE_MAX_SKIP_GROUPS 8
+
+/** Marks "no block" in block index fields */
+#define VFS_NO_BLOCK UINT32_MAX
+
 /** VFS context structure */
 struct sacd_vfs_ctx {
     sacd_t *reader;
@@ -132,6 +170,23 @@ struct sacd_vfs_ctx {
 
     /* Area visibility settings */
     bool area_visible[2];  /* [0]=stereo visible, [1]=multichannel visible */
+
+    /* DSDIFF/DST passthrough files next to the DSF files of DST areas */
+    bool dst_passthrough;
+    mtx_t dff_lock;        /* Protects the areas' dff_tracks */
+    cnd_t dff_scanned;     /* Signalled when a track's scan ends */
+
+    /* WAV renditions next to the DSF files, 0 if not listed */
+    uint32_t pcm_sample_rate;
+    uint16_t pcm_bits;
+
+    /* Shared decoded block cache (borrowed, may be NULL) */
+    sacd_vfs_block_cache_t *block_cache;
+    uint32_t block_cache_owner;     /* Owner id of this context's blocks */
+
+    /* On-disk transcode cache (borrowed, may be NULL) */
+    sacd_vfs_disk_cache_t *disk_cache;
+    uint32_t disk_cache_iso;        /* ISO id while open, 0 if not cached */
 };
 
 
@@ -178,6 +233,37 @@ struct sacd_vfs_file {
     /* Seek alignment - bytes to skip from output after seeking mid-audio */
     size_t seek_skip_bytes;
 
+    /* Decoder output position and shared block cache.
+     * next_block is the index of the next block group the transform emits;
+     * the first one after a restart mid-block lacks its start and is only
+     * skipped, never cached. */
+    uint32_t next_block;
+    int first_block_partial;
+    sacd_vfs_block_cache_t *block_cache;    /* NULL unless a DST track */
+    sacd_vfs_disk_cache_t *disk_cache;      /* NULL unless a DST track */
+    uint32_t cache_miss_block;              /* Last block the caches missed */
+
+    /* DSDIFF/DST passthrough (NULL for DSF files). Frames are served as
+     * read from the disc, a batch at a time. */
+    vfs_dff_layout_t *dff;
+    sacd_frame_ref_t dff_frames[VFS_MT_READ_BATCH];
+    uint32_t dff_first;                     /* Track frame of dff_frames[0] */
+    uint32_t dff_count;                     /* Frames held in dff_frames */
+    uint32_t dff_found;                     /* Frames on the disc, then silence */
+
+    /* PCM (WAV) rendition (NULL for DSF and DSDIFF files). Each SACD frame
+     * converts to one block of PCM. The converter starts with the first
+     * read of PCM data and runs in track order; a read elsewhere restarts
+     * it pcm_warmup frames early so that its filters are primed. */
+    vfs_pcm_layout_t *pcm;
+    dsdpcm_decoder_t *pcm_converter;
+    double *pcm_samples;                    /* Converter output for one frame */
+    uint8_t *pcm_block;                     /* Packed PCM of pcm_block_index */
+    uint32_t pcm_block_index;               /* VFS_NO_BLOCK if none */
+    uint32_t pcm_next_frame;                /* Track frame converted next */
+    uint32_t pcm_exact_frame;               /* First frame with primed filters */
+    uint32_t pcm_warmup;
+
 #if VFS_PROFILE_ENABLED
     /* Performance profiling accumulators (in QPC ticks) */
     int64_t prof_read_ticks;
@@ -196,9 +282,15 @@ struct sacd_vfs_file {
     cnd_t command_cnd;              /* Signals command changes */
     vfs_mt_cmd_t command;           /* Current command for reader thread */
     uint32_t mt_seek_frame;         /* Target frame for SEEK command */
+    uint32_t mt_window;             /* Frames the reader may decode ahead */
+    uint32_t mt_ahead;              /* Frames dispatched, not yet consumed */
+    uint32_t mt_max_window;         /* Process queue depth */
+    uint32_t mt_sequential;         /* Frames consumed at this window size */
+    int64_t mt_rate_start;          /* Start of the speed window, 0 if none */
+    uint32_t mt_rate_frames;        /* Frames consumed in the speed window */
+    int mt_bulk;                    /* Non-zero: scheduled as a copy */
     int mt_errcode;                 /* Error code from reader thread */
     int audio_early_eof;            /* Non-zero: audio ended before metadata_offset (mastering issue) */
-    sa_buffer_pool_t *compressed_pool;   /* Pool for compressed DST frame buffers */
     sa_buffer_pool_t *decompressed_pool; /* Pool for decompressed DSD frame buffers */
 };
 
@@ -212,6 +304,11 @@ static int _read_header_region(sacd_vfs_file_t *file, uint8_t *buffer, size_t si
 static int _read_audio_region(sacd_vfs_file_t *file, uint8_t *buffer, size_t size, size_t *bytes_read);
 static int _read_metadata_region(sacd_vfs_file_t *file, uint8_t *buffer, size_t size, size_t *bytes_read);
 static int _transform_dsd_frame(sacd_vfs_file_t *file, const uint8_t *src, size_t src_len);
+static void _reposition_pipeline(sacd_vfs_file_t *file);
+static int _open_dff_layout(sacd_vfs_file_t *file);
+static int _read_dff_region(sacd_vfs_file_t *file, uint8_t *buffer, size_t size, size_t *bytes_read);
+static int _open_pcm_layout(sacd_vfs_file_t *file);
+static int _read_pcm_region(sacd_vfs_file_t *file, uint8_t *buffer, size_t size, size_t *bytes_read);
 /* _sanitize_filename removed - using sa_sanitize_filename from libsautil */
 
 
@@ -225,6 +322,7 @@ static int _vfs_reader_thread(void *arg);
 static void *_vfs_dst_decode_func(void *arg);
 static void _vfs_job_cleanup(void *arg);
 static void _vfs_result_cleanup(void *data);
+static int _start_mt_pipeline(sacd_vfs_file_t *file);
 static int _read_audio_region_mt(sacd_vfs_file_t *file, uint8_t *buffer,
                                   size_t size, size_t *bytes_read);
 
@@ -269,6 +367,16 @@ sacd_vfs_ctx_t *sacd_vfs_create(void)
         return NULL;
     }
 
+    if (mtx_init(&ctx->dff_lock, mtx_plain) != thrd_success) {
+        sa_free(ctx);
+        return NULL;
+    }
+    if (cnd_init(&ctx->dff_scanned) != thrd_success) {
+        mtx_destroy(&ctx->dff_lock);
+        sa_free(ctx);
+        return NULL;
+    }
+
     /* Default: both areas visible */
     ctx->area_visible[SACD_VFS_AREA_STEREO] = true;
     ctx->area_visible[SACD_VFS_AREA_MULTICHANNEL] = true;
@@ -295,8 +403,9 @@ int sacd_vfs_open(sacd_vfs_ctx_t *ctx, const char *iso_path)
         return SACD_VFS_ERROR_MEMORY;
     }
 
-    /* Initialize reader */
-    int result = sacd_init(ctx->reader, iso_path, 1, 1);
+    /* Initialize reader. Listing and stat only need the track list; text
+     * and the access list are decoded when a file name or seek needs them. */
+    int result = sacd_init_ex(ctx->reader, iso_path, 1, 1, SACD_INIT_LAZY_TOC);
     if (result != SACD_OK) {
         sacd_destroy(ctx->reader);
         ctx->reader = NULL;
@@ -379,6 +488,10 @@ int sacd_vfs_open(sacd_vfs_ctx_t *ctx, const char *iso_path)
 
     ctx->is_open = true;
 
+    if (ctx->disk_cache) {
+        ctx->disk_cache_iso = _vfs_disk_cache_attach(ctx->disk_cache, ctx->iso_path);
+    }
+
     /* Load ID3 overlays from XML sidecar file if present */
     _load_id3_overlay_xml(ctx);
 
@@ -402,10 +515,26 @@ int sacd_vfs_close(sacd_vfs_ctx_t *ctx)
             sa_free(ctx->areas[i].id3_cache);
             ctx->areas[i].id3_cache = NULL;
         }
+        if (ctx->areas[i].dff_tracks) {
+            for (uint8_t t = 0; t < ctx->areas[i].track_count; t++) {
+                sa_free(ctx->areas[i].dff_tracks[t].frame_size);
+            }
+            sa_free(ctx->areas[i].dff_tracks);
+            ctx->areas[i].dff_tracks = NULL;
+        }
         ctx->areas[i].available = false;
         ctx->areas[i].track_count = 0;
     }
 
+    /* Blocks of this ISO are of no use to anyone else */
+    if (ctx->block_cache) {
+        _vfs_block_cache_purge(ctx->block_cache, ctx->block_cache_owner);
+    }
+    if (ctx->disk_cache_iso) {
+        _vfs_disk_cache_detach(ctx->disk_cache, ctx->disk_cache_iso);
+        ctx->disk_cache_iso = 0;
+    }
+
     if (ctx->reader) {
         sacd_close(ctx->reader);
         sacd_destroy(ctx->reader);
@@ -426,9 +555,42 @@ void sacd_vfs_destroy(sacd_vfs_ctx_t *ctx)
         sacd_vfs_close(ctx);
     }
 
+    cnd_destroy(&ctx->dff_scanned);
+    mtx_destroy(&ctx->dff_lock);
     sa_free(ctx);
 }
 
+int sacd_vfs_set_block_cache(sacd_vfs_ctx_t *ctx, sacd_vfs_block_cache_t *cache)
+{
+    if (!ctx) {
+        return SACD_VFS_ERROR_INVALID_PARAMETER;
+    }
+
+    if (ctx->block_cache) {
+        _vfs_block_cache_purge(ctx->block_cache, ctx->block_cache_owner);
+    }
+    ctx->block_cache = cache;
+    ctx->block_cache_owner = cache ? _vfs_block_cache_attach(cache) : 0;
+    return SACD_VFS_OK;
+}
+
+int sacd_vfs_set_disk_cache(sacd_vfs_ctx_t *ctx, sacd_vfs_disk_cache_t *cache)
+{
+    if (!ctx) {
+        return SACD_VFS_ERROR_INVALID_PARAMETER;
+    }
+
+    if (ctx->disk_cache_iso) {
+        _vfs_disk_cache_detach(ctx->disk_cache, ctx->disk_cache_iso);
+        ctx->disk_cache_iso = 0;
+    }
+    ctx->disk_cache = cache;
+    if (cache && ctx->is_open) {
+        ctx->disk_cache_iso = _vfs_disk_cache_attach(cache, ctx->iso_path);
+    }
+    return SACD_VFS_OK;
+}
+
 /* =============================================================================
  * Directory Operations
  * ===========================================================================*/
@@ -500,6 +662,69 @@ bool sacd_vfs_should_show_area(sacd_vfs_ctx_t *ctx, sacd_vfs_area_t area)
     return false;
 }
 
+int sacd_vfs_set_dst_passthrough(sacd_vfs_ctx_t *ctx, bool enabled)
+{
+    if (!ctx) {
+        return SACD_VFS_ERROR_INVALID_PARAMETER;
+    }
+    ctx->dst_passthrough = enabled;
+    return SACD_VFS_OK;
+}
+
+bool sacd_vfs_get_dst_passthrough(sacd_vfs_ctx_t *ctx)
+{
+    return ctx ? ctx->dst_passthrough : false;
+}
+
+int sacd_vfs_set_pcm_rendition(sacd_vfs_ctx_t *ctx, uint32_t sample_rate,
+                               uint16_t bits_per_sample)
+{
+    if (!ctx) {
+        return SACD_VFS_ERROR_INVALID_PARAMETER;
+    }
+    if (sample_rate != 0 && !_vfs_pcm_format_valid(sample_rate, bits_per_sample)) {
+        return SACD_VFS_ERROR_INVALID_PARAMETER;
+    }
+    ctx->pcm_sample_rate = sample_rate;
+    ctx->pcm_bits = sample_rate != 0 ? bits_per_sample : 0;
+    return SACD_VFS_OK;
+}
+
+uint32_t sacd_vfs_get_pcm_rendition(sacd_vfs_ctx_t *ctx, uint16_t *bits_per_sample)
+{
+    if (bits_per_sample) {
+        *bits_per_sample = ctx ? ctx->pcm_bits : 0;
+    }
+    return ctx ? ctx->pcm_sample_rate : 0;
+}
+
+/**
+ * @brief Whether an area lists .dff files next to its .dsf files.
+ */
+static bool _area_has_dff(sacd_vfs_ctx_t *ctx, sacd_vfs_area_t area)
+{
+    return ctx->dst_passthrough &&
+           ctx->areas[area].frame_format == SACD_VFS_FRAME_DST;
+}
+
+/**
+ * @brief Whether a file name asks for the DSDIFF/DST variant of a track.
+ */
+static bool _is_dff_name(const char *fname)
+{
+    size_t len = strlen(fname);
+    return len >= 4 && strcmp(fname + len - 4, ".dff") == 0;
+}
+
+/**
+ * @brief Whether a file name asks for the WAV rendition of a track.
+ */
+static bool _is_wav_name(const char *fname)
+{
+    size_t len = strlen(fname);
+    return len >= 4 && strcmp(fname + len - 4, ".wav") == 0;
+}
+
 int sacd_vfs_get_track_count(sacd_vfs_ctx_t *ctx, sacd_vfs_area_t area, uint8_t *track_count)
 {
     if (!ctx || !track_count) {
@@ -666,6 +891,33 @@ int sacd_vfs_readdir(sacd_vfs_ctx_t *ctx, const char *path,
                 return count;
             }
             count++;
+
+            /* Same name, other extensions. A .dff size needs the track's
+             * frame sizes, which the first open reads from the disc; a
+             * .wav is not listed if it would not fit a RIFF file. */
+            const char *twins[2] = {
+                _area_has_dff(ctx, area) ? ".dff" : NULL,
+                ctx->pcm_sample_rate != 0 ? ".wav" : NULL
+            };
+            size_t name_len = strlen(entry.name);
+            for (int i = 0; i < 2; i++) {
+                if (!twins[i] || name_len < 4) {
+                    continue;
+                }
+                memcpy(entry.name + name_len - 4, twins[i], 4);
+                entry.size = 0;
+                snprintf(track_path, sizeof(track_path), "%s/%s", path, entry.name);
+                if (sacd_vfs_file_open(ctx, track_path, &file) != SACD_VFS_OK) {
+                    continue;
+                }
+                entry.size = file->info.total_size;
+                sacd_vfs_file_close(file);
+
+                if (callback(&entry, userdata) != 0) {
+                    return count;
+                }
+                count++;
+            }
         }
 
         return count;
@@ -799,6 +1051,16 @@ int sacd_vfs_file_open(sacd_vfs_ctx_t *ctx, const char *path, sacd_vfs_file_t **
         return SACD_VFS_ERROR_NOT_FOUND;
     }
 
+    bool is_dff = _is_dff_name(fname);
+    if (is_dff && !_area_has_dff(ctx, area)) {
+        return SACD_VFS_ERROR_NOT_FOUND;
+    }
+
+    bool is_wav = _is_wav_name(fname);
+    if (is_wav && ctx->pcm_sample_rate == 0) {
+        return SACD_VFS_ERROR_NOT_FOUND;
+    }
+
     /* Allocate file handle */
     sacd_vfs_file_t *f = sa_mallocz(sizeof(sacd_vfs_file_t));
     if (!f) {
@@ -813,19 +1075,25 @@ int sacd_vfs_file_open(sacd_vfs_ctx_t *ctx, const char *path, sacd_vfs_file_t **
     /* Create per-file SACD reader instance for concurrent access.
      * Each open file gets its own reader to avoid race conditions when
      * multiple files are read simultaneously (e.g., by audio players).
+     * The reader is cloned from the context's reader so the TOCs parsed
+     * at sacd_vfs_open() are shared instead of read again; inputs that
+     * cannot be shared fall back to a full sacd_init().
      */
-    f->reader = sacd_create();
-    if (!f->reader) {
-        sa_free(f);
-        return SACD_VFS_ERROR_MEMORY;
+    int result = sacd_clone(ctx->reader, &f->reader);
+    if (result == SACD_NOT_AVAILABLE) {
+        f->reader = sacd_create();
+        if (!f->reader) {
+            sa_free(f);
+            return SACD_VFS_ERROR_MEMORY;
+        }
+        result = sacd_init_ex(f->reader, ctx->iso_path, 1, 1, SACD_INIT_LAZY_TOC);
     }
-
-    int result = sacd_init(f->reader, ctx->iso_path, 1, 1);
     if (result != SACD_OK) {
         sa_log(NULL, SA_LOG_DEBUG,"VFS DEBUG: Reader init failed: result=%d, iso=%s\n", result, ctx->iso_path);
         sacd_destroy(f->reader);
         sa_free(f);
-        return SACD_VFS_ERROR_FORMAT;
+        return (result == SACD_MEMORY_ALLOCATION_ERROR) ? SACD_VFS_ERROR_MEMORY
+                                                        : SACD_VFS_ERROR_FORMAT;
     }
 
     /* Debug: Show available areas */
@@ -887,6 +1155,35 @@ int sacd_vfs_file_open(sacd_vfs_ctx_t *ctx, const char *path, sacd_vfs_file_t **
     f->info.sample_count = (uint64_t)track_frame_length * SACD_FRAME_SIZE_64 * 8;
     f->info.duration_seconds = (double)track_frame_length / SACD_FRAMES_PER_SEC;
 
+    /* DSDIFF/DST passthrough: the frames are served as they are, so none
+     * of the DSF conversion state below is needed */
+    if (is_dff) {
+        result = _open_dff_layout(f);
+        if (result != SACD_VFS_OK) {
+            sacd_close(f->reader);
+            sacd_destroy(f->reader);
+            sa_free(f);
+            return result;
+        }
+        *file = f;
+        return SACD_VFS_OK;
+    }
+
+    /* WAV rendition: converted from the disc's frames by libdsdpcm on the
+     * first read of PCM data, without the DSF conversion state below */
+    if (is_wav) {
+        result = _open_pcm_layout(f);
+        if (result != SACD_VFS_OK) {
+            sa_free(f->pcm);
+            sacd_close(f->reader);
+            sacd_destroy(f->reader);
+            sa_free(f);
+            return result;
+        }
+        *file = f;
+        return SACD_VFS_OK;
+    }
+
     /* Calculate virtual file size */
     result = _calculate_virtual_file_size(f);
     if (result != SACD_VFS_OK) {
@@ -938,6 +1235,14 @@ int sacd_vfs_file_open(sacd_vfs_ctx_t *ctx, const char *path, sacd_vfs_file_t **
     f->transform_buffer_len = 0;
     f->seek_skip_bytes = 0;
 
+    /* Only DST blocks are worth caching; DSD is just rearranged */
+    f->next_block = 0;
+    f->cache_miss_block = VFS_NO_BLOCK;
+    if (f->info.frame_format == SACD_VFS_FRAME_DST) {
+        f->block_cache = ctx->block_cache;
+        f->disk_cache = ctx->disk_cache_iso ? ctx->disk_cache : NULL;
+    }
+
     /* Initialize DST decoder if needed (single-threaded) */
     if (f->info.frame_format == SACD_VFS_FRAME_DST) {
 
@@ -980,33 +1285,92 @@ int sacd_vfs_file_open_mt(sacd_vfs_ctx_t *ctx, const char *path,
 
     sacd_vfs_file_t *f = *file;
 
-    /* Only enable MT for DST-compressed tracks with a valid pool */
-    if (pool == NULL || f->info.frame_format != SACD_VFS_FRAME_DST) {
+    /* Only enable MT for DST-compressed tracks with a valid pool; DSDIFF
+     * passthrough files are never decoded, WAV renditions decode in their
+     * converter's order */
+    if (pool == NULL || f->info.frame_format != SACD_VFS_FRAME_DST ||
+        f->dff || f->pcm) {
         return SACD_VFS_OK;
     }
 
-    /* Free the ST decoder - MT path uses per-job decoders in the worker pool */
-    if (f->dst_decoder) {
-        dst_decoder_close(f->dst_decoder);
-        f->dst_decoder = NULL;
+    /* Tag readers and thumbnailers open a file only for the header or the
+     * ID3 tag, so the pipeline waits for the first read that needs decoded
+     * audio (see _read_audio_region_mt) */
+    f->pool = pool;
+
+    return SACD_VFS_OK;
+}
+
+/**
+ * @brief Scheduling options of a file's process queue.
+ *
+ * Playback also keeps a quarter of the queue in flight ahead of every
+ * priority, so a player's buffer is refilled before it runs dry.
+ */
+static void _mt_schedule_opts(int bulk, int qsize, sa_tpool_process_opts *opts)
+{
+    opts->priority = bulk ? 0 : VFS_MT_PLAYBACK_PRIORITY;
+    opts->weight = 1;
+    opts->low_water = bulk ? 0 : qsize / 4;
+}
+
+static void _schedule_mt_reader(sacd_vfs_file_t *file, int bulk)
+{
+    sa_tpool_process_opts opts;
+
+    if (bulk == file->mt_bulk) {
+        return;
     }
-    if (f->dst_decode_buffer) {
-        sa_free(f->dst_decode_buffer);
-        f->dst_decode_buffer = NULL;
-        f->dst_decode_buffer_size = 0;
+    _mt_schedule_opts(bulk, (int)file->mt_max_window, &opts);
+    sa_tpool_process_set_opts(file->process, &opts);
+    file->mt_bulk = bulk;
+}
+
+/**
+ * @brief Schedule a file's decode jobs by how fast it is read.
+ *
+ * Measured once per second of audio: a reader more than VFS_MT_BULK_SPEED
+ * times faster than real time is a copy, anything slower is playing.
+ */
+static void _classify_mt_reader(sacd_vfs_file_t *file)
+{
+    int64_t now = sa_gettime_relative();
+
+    if (file->mt_rate_start == 0) {
+        file->mt_rate_start = now;
+        file->mt_rate_frames = 0;
+        return;
+    }
+    if (++file->mt_rate_frames < VFS_MT_RATE_WINDOW) {
+        return;
     }
 
-    /* Initialize MT pipeline */
-    f->pool = pool;
-    int qsize = sa_tpool_size(pool) * 2;
+    int64_t real_time = (int64_t)VFS_MT_RATE_WINDOW * 1000000 / SACD_FRAMES_PER_SEC;
+    _schedule_mt_reader(file,
+                        (now - file->mt_rate_start) * VFS_MT_BULK_SPEED < real_time);
+    file->mt_rate_start = now;
+    file->mt_rate_frames = 0;
+}
+
+/**
+ * @brief Start the MT decode pipeline at file->current_frame.
+ *
+ * The single-threaded decoder is released only once the reader thread is
+ * running, so on failure the file can keep decoding on the caller's thread.
+ */
+static int _start_mt_pipeline(sacd_vfs_file_t *f)
+{
+    int qsize = sa_tpool_size(f->pool) * 2;
     if (qsize < VFS_MT_MIN_QUEUE_DEPTH) {
         qsize = VFS_MT_MIN_QUEUE_DEPTH;
     }
 
-    f->process = sa_tpool_process_init(pool, qsize, 0);
+    /* Every reader starts out as playback, so a player's first read and
+     * every seek are served ahead of copies */
+    sa_tpool_process_opts opts;
+    _mt_schedule_opts(0, qsize, &opts);
+    f->process = sa_tpool_process_init(f->pool, qsize, 0, &opts);
     if (!f->process) {
-        sacd_vfs_file_close(f);
-        *file = NULL;
         return SACD_VFS_ERROR_MEMORY;
     }
 
@@ -1014,8 +1378,6 @@ int sacd_vfs_file_open_mt(sacd_vfs_ctx_t *ctx, const char *path,
     if (mtx_init(&f->command_mtx, mtx_plain) != thrd_success) {
         sa_tpool_process_destroy(f->process);
         f->process = NULL;
-        sacd_vfs_file_close(f);
-        *file = NULL;
         return SACD_VFS_ERROR_MEMORY;
     }
 
@@ -1023,36 +1385,27 @@ int sacd_vfs_file_open_mt(sacd_vfs_ctx_t *ctx, const char *path,
         mtx_destroy(&f->command_mtx);
         sa_tpool_process_destroy(f->process);
         f->process = NULL;
-        sacd_vfs_file_close(f);
-        *file = NULL;
         return SACD_VFS_ERROR_MEMORY;
     }
 
     f->command = VFS_MT_CMD_NONE;
     f->mt_errcode = 0;
-
-    /* Create buffer pools for the MT pipeline */
-    f->compressed_pool = sa_buffer_pool_init(SACD_MAX_DSD_SIZE, NULL);
-    if (!f->compressed_pool) {
-        cnd_destroy(&f->command_cnd);
-        mtx_destroy(&f->command_mtx);
-        sa_tpool_process_destroy(f->process);
-        f->process = NULL;
-        sacd_vfs_file_close(f);
-        *file = NULL;
-        return SACD_VFS_ERROR_MEMORY;
-    }
-
+    f->mt_window = VFS_MT_INITIAL_WINDOW;
+    f->mt_ahead = 0;
+    f->mt_max_window = (uint32_t)qsize;
+    f->mt_sequential = 0;
+    f->mt_rate_start = 0;
+    f->mt_bulk = 0;
+
+    /* Decoded frames come from a pool; compressed frames are referenced
+     * in the sector buffers libsacd returns */
     size_t decomp_size = (size_t)SACD_FRAME_SIZE_64 * f->info.channel_count;
     f->decompressed_pool = sa_buffer_pool_init(decomp_size, NULL);
     if (!f->decompressed_pool) {
-        sa_buffer_pool_uninit(&f->compressed_pool);
         cnd_destroy(&f->command_cnd);
         mtx_destroy(&f->command_mtx);
         sa_tpool_process_destroy(f->process);
         f->process = NULL;
-        sacd_vfs_file_close(f);
-        *file = NULL;
         return SACD_VFS_ERROR_MEMORY;
     }
 
@@ -1060,21 +1413,29 @@ int sacd_vfs_file_open_mt(sacd_vfs_ctx_t *ctx, const char *path,
     int tret = thrd_create(&f->reader_thread, _vfs_reader_thread, f);
     if (tret != thrd_success) {
         sa_buffer_pool_uninit(&f->decompressed_pool);
-        sa_buffer_pool_uninit(&f->compressed_pool);
         cnd_destroy(&f->command_cnd);
         mtx_destroy(&f->command_mtx);
         sa_tpool_process_destroy(f->process);
         f->process = NULL;
-        sacd_vfs_file_close(f);
-        *file = NULL;
         return SACD_VFS_ERROR_MEMORY;
     }
 
     f->reader_thread_active = 1;
     f->mt_enabled = 1;
 
-    sa_log(NULL, SA_LOG_DEBUG,"VFS DEBUG: MT pipeline started for track %u (pool_size=%d, qsize=%d)\n",
-              f->track_num, sa_tpool_size(pool), qsize);
+    /* Free the ST decoder - MT path uses per-job decoders in the worker pool */
+    if (f->dst_decoder) {
+        dst_decoder_close(f->dst_decoder);
+        f->dst_decoder = NULL;
+    }
+    if (f->dst_decode_buffer) {
+        sa_free(f->dst_decode_buffer);
+        f->dst_decode_buffer = NULL;
+        f->dst_decode_buffer_size = 0;
+    }
+
+    sa_log(NULL, SA_LOG_DEBUG,"VFS DEBUG: MT pipeline started for track %u at frame %u (pool_size=%d, qsize=%d)\n",
+              f->track_num, f->current_frame, sa_tpool_size(f->pool), qsize);
 
     return SACD_VFS_OK;
 }
@@ -1140,9 +1501,6 @@ int sacd_vfs_file_close(sacd_vfs_file_t *file)
         mtx_destroy(&file->command_mtx);
 
         /* Destroy buffer pools */
-        if (file->compressed_pool) {
-            sa_buffer_pool_uninit(&file->compressed_pool);
-        }
         if (file->decompressed_pool) {
             sa_buffer_pool_uninit(&file->decompressed_pool);
         }
@@ -1174,6 +1532,21 @@ int sacd_vfs_file_close(sacd_vfs_file_t *file)
         }
     }
 
+    if (file->dff) {
+        sacd_release_sound_frames(file->dff_frames, file->dff_count);
+        _vfs_dff_layout_free(file->dff);
+        file->dff = NULL;
+    }
+
+    if (file->pcm_converter) {
+        dsdpcm_destroy(file->pcm_converter);
+        file->pcm_converter = NULL;
+    }
+    sa_free(file->pcm_samples);
+    sa_free(file->pcm_block);
+    sa_free(file->pcm);
+    file->pcm = NULL;
+
     /* Close and destroy per-file reader */
     if (file->reader) {
         sacd_close(file->reader);
@@ -1214,7 +1587,17 @@ int sacd_vfs_file_read(sacd_vfs_file_t *file, uint8_t *buffer, size_t size, size
         size_t chunk_read = 0;
         int result;
 
-        if (file->position < file->dsf_header_size) {
+        if (file->dff && (file->position < file->info.metadata_offset ||
+                          file->position >= file->info.metadata_offset +
+                                            file->info.metadata_size)) {
+            /* DSDIFF/DST passthrough, anything but the ID3 tag */
+            result = _read_dff_region(file, buffer + total_read, remaining, &chunk_read);
+        } else if (file->pcm && (file->position < file->info.metadata_offset ||
+                                 file->position >= file->info.metadata_offset +
+                                                   file->info.metadata_size)) {
+            /* WAV rendition, anything but the ID3 tag */
+            result = _read_pcm_region(file, buffer + total_read, remaining, &chunk_read);
+        } else if (file->position < file->dsf_header_size) {
             /* Reading from header region */
             result = _read_header_region(file, buffer + total_read, remaining, &chunk_read);
         } else if (file->position < file->info.metadata_offset) {
@@ -1286,104 +1669,14 @@ int sacd_vfs_file_seek(sacd_vfs_file_t *file, int64_t offset, int whence)
     file->position = (uint64_t)new_pos;
     file->audio_early_eof = 0;
 
-    /* Invalidate transform buffer on seek */
-    file->transform_buffer_pos = 0;
-    file->transform_buffer_len = 0;
-    file->seek_skip_bytes = 0;
-
-    /* For single-threaded DST decoder, no special flush needed */
-
-    /* Calculate new current frame based on position */
-    if (file->position < file->dsf_header_size) {
-        /* Seeking to header region - reset to start of track */
-        file->current_frame = file->start_frame;
-        file->bytes_buffered = 0;
-    } else if (file->position < file->info.metadata_offset) {
-        /* Seeking within audio region.
-         *
-         * KEY INSIGHT: SACD frames are 4704 bytes/channel, DSF blocks are 4096 bytes.
-         * GCD(4704, 4096) = 32, so LCM = 602112 bytes per channel.
-         * Frame and block boundaries only align every 128 frames (602112/4704).
-         *
-         * After processing F frames:
-         * - Total raw bytes per channel: F * 4704
-         * - Complete blocks output per channel: floor(F * 4704 / 4096)
-         * - Bytes buffered per channel: (F * 4704) % 4096
-         * - Total output bytes: floor(F * 4704 / 4096) * 4096 * channel_count
-         */
-        uint64_t audio_offset = file->position - file->dsf_header_size;
-        uint32_t channel_count = file->info.channel_count;
-        uint64_t bytes_per_block_group = (uint64_t)DSF_BLOCK_SIZE_PER_CHANNEL * channel_count;
-
-        /* Both DSD and DST frames are independently decodable.
-         * DST frames are self-contained (each frame has its own coding parameters).
-         * We can seek to aligned boundaries and skip a small amount of output.
-         *
-         * FRAME_BLOCK_ALIGNMENT: frames where bytes_buffered = 0 (block-aligned)
-         * This occurs when (F * 4704) % 4096 = 0, i.e., F is multiple of 128
-         */
-        {
-            #define FRAME_BLOCK_ALIGNMENT 128
-
-            /* Calculate output position per aligned frame group:
-             * After 128 frames: output = floor(128 * 4704 / 4096) * 4096 * channels
-             *                         = 147 * 4096 * channels = 147 blocks per channel
-             */
-            uint64_t output_per_alignment = (uint64_t)FRAME_BLOCK_ALIGNMENT * SACD_FRAME_SIZE_64 /
-                                            DSF_BLOCK_SIZE_PER_CHANNEL * bytes_per_block_group;
-
-            /* Find which alignment group contains our target */
-            uint32_t alignment_group = (uint32_t)(audio_offset / output_per_alignment);
-            uint32_t aligned_frame = alignment_group * FRAME_BLOCK_ALIGNMENT;
-            uint64_t aligned_output_pos = alignment_group * output_per_alignment;
-
-            /* Set frame position to this aligned boundary */
-            file->current_frame = file->start_frame + aligned_frame;
-            if (file->current_frame > file->end_frame) {
-                file->current_frame = file->end_frame;
-                aligned_output_pos = (uint64_t)(file->end_frame - file->start_frame) *
-                                     SACD_FRAME_SIZE_64 / DSF_BLOCK_SIZE_PER_CHANNEL *
-                                     bytes_per_block_group;
-            }
-
-            /* At an aligned frame boundary, bytes_buffered is 0 (clean state) */
-            file->bytes_buffered = 0;
-
-            /* Skip bytes from aligned position to target position */
-            file->seek_skip_bytes = (size_t)(audio_offset - aligned_output_pos);
-
-            #undef FRAME_BLOCK_ALIGNMENT
-        }
-    } else {
-        /* Metadata region - reset audio state */
-        file->current_frame = file->end_frame;
-        file->bytes_buffered = 0;
+    /* DSDIFF/DST passthrough reads any frame directly; a WAV rendition
+     * repositions its converter when the block is not cached */
+    if (file->dff || file->pcm) {
+        return SACD_VFS_OK;
     }
 
-    /* For MT pipeline: signal the reader thread to seek to the computed frame.
-     * The reader drains the process queue, resets, and resumes from the target.
-     */
-    if (file->mt_enabled) {
-        mtx_lock(&file->command_mtx);
-        file->mt_seek_frame = file->current_frame;
-        file->command = VFS_MT_CMD_SEEK;
-        cnd_signal(&file->command_cnd);
-        mtx_unlock(&file->command_mtx);
-
-        /* Wake reader if blocked on full queue */
-        sa_tpool_wake_dispatch(file->process);
-
-        /* Wait for the reader thread to finish draining and repositioning */
-        mtx_lock(&file->command_mtx);
-        while (file->command != VFS_MT_CMD_SEEK_DONE) {
-            cnd_wait(&file->command_cnd, &file->command_mtx);
-        }
-        file->command = VFS_MT_CMD_NONE;
-        mtx_unlock(&file->command_mtx);
-
-        /* Clear error state from previous read */
-        file->mt_errcode = 0;
-    }
+    _reposition_pipeline(file);
+    file->cache_miss_block = VFS_NO_BLOCK;
 
     return SACD_VFS_OK;
 }
@@ -1674,24 +1967,44 @@ static void *_vfs_dst_decode_func(void *arg)
 /**
  * @brief Dedicated reader thread for multi-threaded DST decompression.
  *
- * Reads compressed frames from the SACD ISO and dispatches decode jobs
- * to the thread pool. Handles SEEK and CLOSE commands from the main thread.
+ * Reads compressed frames from the SACD ISO in runs and dispatches decode
+ * jobs to the thread pool. Each job references its frame in the sector
+ * buffer libsacd read, so frames reach the workers without a copy.
+ * Handles SEEK and CLOSE commands from the main thread.
  */
 static int _vfs_reader_thread(void *arg)
 {
     sacd_vfs_file_t *file = (sacd_vfs_file_t *)arg;
+    sacd_frame_ref_t batch[VFS_MT_READ_BATCH];
+    uint32_t batch_count = 0;
+    uint32_t batch_pos = 0;
 
     sa_log(NULL, SA_LOG_DEBUG,"VFS DEBUG: MT reader thread started for track %u\n", file->track_num);
 
 restart:
+    /* Frames read ahead of a seek are stale */
+    sacd_release_sound_frames(batch + batch_pos, batch_count - batch_pos);
+    batch_count = 0;
+    batch_pos = 0;
+
     while (file->current_frame < file->end_frame) {
-        /* Check for commands before each frame read */
+        /* Check for commands before each frame read, and stay within the
+         * prefetch window the consumer has opened up */
         mtx_lock(&file->command_mtx);
+        while (file->command != VFS_MT_CMD_CLOSE &&
+               file->command != VFS_MT_CMD_SEEK &&
+               file->mt_ahead >= file->mt_window) {
+            cnd_wait(&file->command_cnd, &file->command_mtx);
+        }
         vfs_mt_cmd_t cmd = file->command;
+        if (cmd != VFS_MT_CMD_CLOSE && cmd != VFS_MT_CMD_SEEK) {
+            file->mt_ahead++;
+        }
         mtx_unlock(&file->command_mtx);
 
         if (cmd == VFS_MT_CMD_CLOSE) {
             sa_log(NULL, SA_LOG_DEBUG,"VFS DEBUG: MT reader thread got CLOSE command\n");
+            sacd_release_sound_frames(batch + batch_pos, batch_count - batch_pos);
             return 0;
         }
 
@@ -1707,6 +2020,7 @@ restart:
             /* Update frame position */
             mtx_lock(&file->command_mtx);
             file->current_frame = file->mt_seek_frame;
+            file->mt_ahead = 0;
             file->command = VFS_MT_CMD_SEEK_DONE;
             cnd_signal(&file->command_cnd);
             mtx_unlock(&file->command_mtx);
@@ -1715,40 +2029,39 @@ restart:
             goto restart;
         }
 
-        /* Read next compressed frame from SACD */
-        uint8_t frame_buffer[SACD_MAX_DSD_SIZE];
-        uint32_t frames_to_read = 1;
-        uint16_t frame_size = 0;
+        /* Read the next run of compressed frames from SACD */
+        if (batch_pos == batch_count) {
+            uint32_t frames_to_read = file->end_frame - file->current_frame;
+            if (frames_to_read > VFS_MT_READ_BATCH) {
+                frames_to_read = VFS_MT_READ_BATCH;
+            }
 
-        int result = sacd_get_sound_data(file->reader, frame_buffer,
-                                                  file->current_frame,
-                                                  &frames_to_read, &frame_size);
+            batch_count = 0;
+            batch_pos = 0;
+            int result = sacd_get_sound_frames(file->reader, file->current_frame,
+                                               &frames_to_read, batch);
 
-        if (result != SACD_OK || frames_to_read == 0) {
-            sa_log(NULL, SA_LOG_DEBUG,"VFS DEBUG: MT reader thread read error at frame %u\n",
-                      file->current_frame);
-            file->mt_errcode = SACD_VFS_ERROR_READ;
-            break;
+            if (result != SACD_OK || frames_to_read == 0) {
+                sa_log(NULL, SA_LOG_DEBUG,"VFS DEBUG: MT reader thread read error at frame %u\n",
+                          file->current_frame);
+                file->mt_errcode = SACD_VFS_ERROR_READ;
+                break;
+            }
+            batch_count = frames_to_read;
         }
 
-        /* Create decode job with pooled compressed data */
+        /* Create decode job referencing the compressed frame in place */
         vfs_dst_job_t *job = sa_mallocz(sizeof(vfs_dst_job_t));
         if (!job) {
             file->mt_errcode = SACD_VFS_ERROR_MEMORY;
             break;
         }
 
-        sa_buffer_ref_t *comp_ref = sa_buffer_pool_get(file->compressed_pool);
-        if (!comp_ref) {
-            sa_free(job);
-            file->mt_errcode = SACD_VFS_ERROR_MEMORY;
-            break;
-        }
-
-        memcpy(comp_ref->data, frame_buffer, frame_size);
-        job->compressed_ref = comp_ref;
-        job->compressed_data = comp_ref->data;
-        job->compressed_size = frame_size;
+        sacd_frame_ref_t *frame = &batch[batch_pos++];
+        job->compressed_ref = frame->buf;
+        job->compressed_data = (uint8_t *)frame->data;
+        job->compressed_size = (int)frame->size;
+        frame->buf = NULL;
         job->channel_count = (int)file->info.channel_count;
         job->sample_rate = (int)file->info.sample_rate;
         job->frame_number = file->current_frame;
@@ -1765,16 +2078,19 @@ restart:
             _vfs_job_cleanup(job);
 
             mtx_lock(&file->command_mtx);
+            file->mt_ahead--;
             cmd = file->command;
             mtx_unlock(&file->command_mtx);
 
             if (cmd == VFS_MT_CMD_CLOSE) {
+                sacd_release_sound_frames(batch + batch_pos, batch_count - batch_pos);
                 return 0;
             }
             if (cmd == VFS_MT_CMD_SEEK) {
                 sa_tpool_process_reset(file->process, 1);
                 mtx_lock(&file->command_mtx);
                 file->current_frame = file->mt_seek_frame;
+                file->mt_ahead = 0;
                 file->command = VFS_MT_CMD_SEEK_DONE;
                 cnd_signal(&file->command_cnd);
                 mtx_unlock(&file->command_mtx);
@@ -1788,6 +2104,10 @@ restart:
         file->current_frame++;
     }
 
+    sacd_release_sound_frames(batch + batch_pos, batch_count - batch_pos);
+    batch_count = 0;
+    batch_pos = 0;
+
     /* Dispatch EOF sentinel so the consumer knows reading is done */
     {
         vfs_dst_job_t *eof_job = sa_mallocz(sizeof(vfs_dst_job_t));
@@ -1812,6 +2132,7 @@ restart:
     if (file->command == VFS_MT_CMD_SEEK) {
         sa_tpool_process_reset(file->process, 1);
         file->current_frame = file->mt_seek_frame;
+        file->mt_ahead = 0;
         file->command = VFS_MT_CMD_SEEK_DONE;
         cnd_signal(&file->command_cnd);
         mtx_unlock(&file->command_mtx);
@@ -2337,6 +2658,7 @@ static int _transform_dsd_frame(sacd_vfs_file_t *file, const uint8_t *src, size_
     size_t input_pos = 0;
     size_t output_pos = 0;
     size_t block_group_size = DSF_BLOCK_SIZE_PER_CHANNEL * channel_count;
+    uint8_t *planes[MAX_CHANNEL_COUNT];
 
     /* Calculate maximum output: could produce multiple complete blocks
      * For 4704 bytes/channel input with 608 bytes already buffered:
@@ -2364,19 +2686,32 @@ static int _transform_dsd_frame(sacd_vfs_file_t *file, const uint8_t *src, size_
      * We accumulate into per-channel buffers with bit reversal.
      * When buffers reach 4096 bytes, output a complete block group.
      */
-    for (size_t i = 0; i < bytes_per_channel; i++) {
-        /* De-interleave and bit-reverse each sample into channel buffers */
+    for (size_t done = 0; done < bytes_per_channel; ) {
+        size_t chunk = DSF_BLOCK_SIZE_PER_CHANNEL - file->bytes_buffered;
+        if (chunk > bytes_per_channel - done) {
+            chunk = bytes_per_channel - done;
+        }
+
+        /* A whole block is written straight into the transform buffer */
+        int direct = (file->bytes_buffered == 0 && chunk == DSF_BLOCK_SIZE_PER_CHANNEL);
         for (uint32_t ch = 0; ch < channel_count; ch++) {
-            file->channel_buffers[ch][file->bytes_buffered] = ff_reverse[src[input_pos++]];
+            planes[ch] = direct
+                ? &file->transform_buffer[output_pos + ch * DSF_BLOCK_SIZE_PER_CHANNEL]
+                : &file->channel_buffers[ch][file->bytes_buffered];
         }
-        file->bytes_buffered++;
+        sa_dsd_deinterleave_bitrev(planes, src + input_pos, chunk, (int)channel_count);
+        input_pos += chunk * channel_count;
+        done += chunk;
+        file->bytes_buffered += chunk;
 
         /* When we have a complete block (4096 bytes per channel), output it */
         if (file->bytes_buffered == DSF_BLOCK_SIZE_PER_CHANNEL) {
-            /* Assemble block group directly into transform buffer */
-            for (uint32_t ch = 0; ch < channel_count; ch++) {
-                memcpy(&file->transform_buffer[output_pos + ch * DSF_BLOCK_SIZE_PER_CHANNEL],
-                       file->channel_buffers[ch], DSF_BLOCK_SIZE_PER_CHANNEL);
+            if (!direct) {
+                /* Assemble block group into the transform buffer */
+                for (uint32_t ch = 0; ch < channel_count; ch++) {
+                    memcpy(&file->transform_buffer[output_pos + ch * DSF_BLOCK_SIZE_PER_CHANNEL],
+                           file->channel_buffers[ch], DSF_BLOCK_SIZE_PER_CHANNEL);
+                }
             }
             output_pos += block_group_size;
             file->bytes_buffered = 0;
@@ -2389,13 +2724,260 @@ static int _transform_dsd_frame(sacd_vfs_file_t *file, const uint8_t *src, size_
     return SACD_VFS_OK;
 }
 
+/**
+ * @brief Restart decoding so that the output continues at file->position.
+ *
+ * SACD frames are 4704 bytes per channel and DSF blocks 4096, so block
+ * groups and frames rarely line up. Decoding restarts at the frame that
+ * holds the first byte of the block group containing the position. Frames
+ * are independently decodable, so only the block group before it is wrong:
+ * its start came from the previous frame. That group, and the rest of the
+ * output before the position, is skipped.
+ */
+static void _reposition_pipeline(sacd_vfs_file_t *file)
+{
+    uint32_t channel_count = file->info.channel_count;
+    uint64_t group_size = (uint64_t)DSF_BLOCK_SIZE_PER_CHANNEL * channel_count;
+
+    file->transform_buffer_pos = 0;
+    file->transform_buffer_len = 0;
+    file->seek_skip_bytes = 0;
+    file->first_block_partial = 0;
+
+    if (file->position < file->dsf_header_size) {
+        /* Header region - reset to start of track */
+        file->current_frame = file->start_frame;
+        file->bytes_buffered = 0;
+        file->next_block = 0;
+    } else if (file->position < file->info.metadata_offset) {
+        uint64_t audio_offset = file->position - file->dsf_header_size;
+        uint32_t block = (uint32_t)(audio_offset / group_size);
+        uint32_t frame = (uint32_t)((uint64_t)block * DSF_BLOCK_SIZE_PER_CHANNEL /
+                                    SACD_FRAME_SIZE_64);
+        uint64_t frame_pos = (uint64_t)frame * SACD_FRAME_SIZE_64;
+
+        file->current_frame = file->start_frame + frame;
+        if (file->current_frame > file->end_frame) {
+            file->current_frame = file->end_frame;
+        }
+
+        /* Bytes the previous frame would have left in the channel buffers */
+        file->bytes_buffered = (size_t)(frame_pos % DSF_BLOCK_SIZE_PER_CHANNEL);
+        file->next_block = (uint32_t)(frame_pos / DSF_BLOCK_SIZE_PER_CHANNEL);
+        file->seek_skip_bytes = (size_t)(audio_offset - file->next_block * group_size);
+        if (file->bytes_buffered > 0) {
+            file->first_block_partial = 1;
+            for (uint32_t ch = 0; ch < channel_count; ch++) {
+                memset(file->channel_buffers[ch], 0, file->bytes_buffered);
+            }
+        }
+    } else {
+        /* Metadata region - reset audio state */
+        file->current_frame = file->end_frame;
+        file->bytes_buffered = 0;
+        file->next_block = (uint32_t)(file->info.audio_data_size / group_size);
+    }
+
+    /* For MT pipeline: signal the reader thread to seek to the computed frame.
+     * The reader drains the process queue, resets, and resumes from the target.
+     */
+    if (file->mt_enabled) {
+        mtx_lock(&file->command_mtx);
+        file->mt_seek_frame = file->current_frame;
+        file->mt_window = VFS_MT_INITIAL_WINDOW;
+        file->mt_sequential = 0;
+        file->mt_rate_start = 0;
+        file->command = VFS_MT_CMD_SEEK;
+        cnd_signal(&file->command_cnd);
+        mtx_unlock(&file->command_mtx);
+
+        /* Wake reader if blocked on full queue */
+        sa_tpool_wake_dispatch(file->process);
+
+        /* Wait for the reader thread to finish draining and repositioning */
+        mtx_lock(&file->command_mtx);
+        while (file->command != VFS_MT_CMD_SEEK_DONE) {
+            cnd_wait(&file->command_cnd, &file->command_mtx);
+        }
+        file->command = VFS_MT_CMD_NONE;
+        mtx_unlock(&file->command_mtx);
+
+        /* Clear error state from previous read */
+        file->mt_errcode = 0;
+
+        /* Seeks are interactive; a copy is demoted again after a second */
+        _schedule_mt_reader(file, 0);
+    }
+}
+
+/**
+ * @brief Account for the block groups the transform just emitted.
+ *
+ * Offers them to the block cache and, after a seek, skips the output that
+ * lies before the position. Called after every transform and flush.
+ */
+static void _commit_block_groups(sacd_vfs_file_t *file)
+{
+    size_t group_size = (size_t)DSF_BLOCK_SIZE_PER_CHANNEL * file->info.channel_count;
+
+    for (size_t off = 0; off + group_size <= file->transform_buffer_len; off += group_size) {
+        if (!file->first_block_partial) {
+            vfs_block_key_t key = {
+                .owner = file->ctx->block_cache_owner,
+                .area = (uint8_t)file->area,
+                .track = file->track_num,
+                .block = file->next_block
+            };
+            if (file->block_cache) {
+                _vfs_block_cache_insert(file->block_cache, &key,
+                                        file->transform_buffer + off, group_size);
+            }
+            if (file->disk_cache) {
+                key.owner = file->ctx->disk_cache_iso;
+                _vfs_disk_cache_insert(file->disk_cache, &key,
+                                       file->transform_buffer + off, group_size);
+            }
+        }
+        file->first_block_partial = 0;
+        file->next_block++;
+    }
+
+    /* After a seek, skip bytes to align with target position */
+    if (file->seek_skip_bytes > 0 && file->transform_buffer_len > 0) {
+        size_t skip = file->seek_skip_bytes;
+        if (skip > file->transform_buffer_len) {
+            skip = file->transform_buffer_len;
+        }
+        file->transform_buffer_pos = skip;
+        file->seek_skip_bytes -= skip;
+    }
+}
+
+/**
+ * @brief Serve the block group at file->position from the block caches.
+ *
+ * Memory is tried first; blocks found on disk are promoted to memory.
+ *
+ * @return true if the transform buffer now holds it
+ */
+static bool _fetch_cached_block(sacd_vfs_file_t *file)
+{
+    if (!file->block_cache && !file->disk_cache) {
+        return false;
+    }
+
+    size_t group_size = (size_t)DSF_BLOCK_SIZE_PER_CHANNEL * file->info.channel_count;
+    uint64_t audio_offset = file->position - file->dsf_header_size;
+    vfs_block_key_t key = {
+        .owner = file->ctx->block_cache_owner,
+        .area = (uint8_t)file->area,
+        .track = file->track_num,
+        .block = (uint32_t)(audio_offset / group_size)
+    };
+
+    /* Decoding up to a block takes several passes when output is skipped */
+    if (key.block == file->cache_miss_block) {
+        return false;
+    }
+
+    if (!file->block_cache ||
+        !_vfs_block_cache_lookup(file->block_cache, &key, file->transform_buffer,
+                                 group_size)) {
+        vfs_block_key_t disk_key = key;
+        disk_key.owner = file->ctx->disk_cache_iso;
+        if (!file->disk_cache ||
+            !_vfs_disk_cache_lookup(file->disk_cache, &disk_key,
+                                    file->transform_buffer, group_size)) {
+            file->cache_miss_block = key.block;
+            return false;
+        }
+        if (file->block_cache) {
+            _vfs_block_cache_insert(file->block_cache, &key,
+                                    file->transform_buffer, group_size);
+        }
+    }
+
+    file->transform_buffer_len = group_size;
+    file->transform_buffer_pos = (size_t)(audio_offset % group_size);
+    return true;
+}
+
+/**
+ * @brief Make the decoder output continue at file->position again.
+ *
+ * Block groups served from the cache move the position without decoding.
+ * A decoder a few groups behind skips ahead through its output; otherwise
+ * it is restarted at the position.
+ */
+static void _sync_pipeline(sacd_vfs_file_t *file)
+{
+    if (!file->block_cache && !file->disk_cache) {
+        return;
+    }
+
+    uint64_t group_size = (uint64_t)DSF_BLOCK_SIZE_PER_CHANNEL * file->info.channel_count;
+    uint64_t audio_offset = file->position - file->dsf_header_size;
+    uint64_t decoder_pos = (uint64_t)file->next_block * group_size + file->seek_skip_bytes;
+
+    if (decoder_pos == audio_offset) {
+        return;
+    }
+    if (decoder_pos < audio_offset &&
+        audio_offset - decoder_pos <= VFS_CACHE_MAX_SKIP_GROUPS * group_size) {
+        file->seek_skip_bytes += (size_t)(audio_offset - decoder_pos);
+        return;
+    }
+    _reposition_pipeline(file);
+}
+
+/**
+ * @brief Hand a decoded frame slot back to the MT reader thread.
+ *
+ * The prefetch window doubles each time a full window has been consumed
+ * without a seek, so a player quickly reaches the full queue depth while a
+ * probe that reads a few blocks decodes little more than it asked for.
+ */
+static void _consume_mt_frame(sacd_vfs_file_t *file)
+{
+    mtx_lock(&file->command_mtx);
+    if (file->mt_ahead > 0) {
+        file->mt_ahead--;
+    }
+    if (++file->mt_sequential >= file->mt_window &&
+        file->mt_window < file->mt_max_window) {
+        file->mt_window *= 2;
+        if (file->mt_window > file->mt_max_window) {
+            file->mt_window = file->mt_max_window;
+        }
+        file->mt_sequential = 0;
+    }
+    cnd_signal(&file->command_cnd);
+    mtx_unlock(&file->command_mtx);
+
+    _classify_mt_reader(file);
+}
+
+uint32_t _vfs_file_mt_window(sacd_vfs_file_t *file)
+{
+    if (!file->mt_enabled) {
+        return 0;
+    }
+
+    mtx_lock(&file->command_mtx);
+    uint32_t window = file->mt_window;
+    mtx_unlock(&file->command_mtx);
+    return window;
+}
+
 static int _read_audio_region(sacd_vfs_file_t *file, uint8_t *buffer, size_t size, size_t *bytes_read)
 {
     /* Audio ended before metadata_offset (disc mastering discrepancy: TOC frame count
      * is larger than the actual compressed frame data).  Fill the gap with DSD silence.
      * DSF stores DSD data LSB-first, so the silence pattern is 0x96 (bit-reversal of the
-     * standard noise-shaped 0x69 pattern used in DSDIFF/MSB-first DSD streams). */
-    if (file->audio_early_eof && file->position < file->info.metadata_offset) {
+     * standard noise-shaped 0x69 pattern used in DSDIFF/MSB-first DSD streams).
+     * The block flushed at the end of the audio is served first. */
+    if (file->audio_early_eof && file->position < file->info.metadata_offset &&
+        file->transform_buffer_pos >= file->transform_buffer_len) {
         if (size == 0) {
             *bytes_read = 0;
             return SACD_VFS_OK;
@@ -2408,7 +2990,7 @@ static int _read_audio_region(sacd_vfs_file_t *file, uint8_t *buffer, size_t siz
         return SACD_VFS_OK;
     }
 
-    if (file->mt_enabled) {
+    if (file->mt_enabled || file->pool) {
         return _read_audio_region_mt(file, buffer, size, bytes_read);
     }
 
@@ -2433,6 +3015,12 @@ static int _read_audio_region(sacd_vfs_file_t *file, uint8_t *buffer, size_t siz
             continue;
         }
 
+        /* Another reader may have decoded this block group already */
+        if (_fetch_cached_block(file)) {
+            continue;
+        }
+        _sync_pipeline(file);
+
         /* Need to read more frames */
         if (file->current_frame >= file->end_frame) {
             /* No more frames - flush any remaining buffered data with proper padding */
@@ -2444,6 +3032,7 @@ static int _read_audio_region(sacd_vfs_file_t *file, uint8_t *buffer, size_t siz
                     }
                     return result;
                 }
+                _commit_block_groups(file);
                 /* Continue loop to consume the flushed data from transform buffer */
                 continue;
             }
@@ -2542,16 +3131,7 @@ static int _read_audio_region(sacd_vfs_file_t *file, uint8_t *buffer, size_t siz
             }
             return result;
         }
-
-        /* After a seek, skip bytes to align with target position */
-        if (file->seek_skip_bytes > 0 && file->transform_buffer_len > 0) {
-            size_t skip = file->seek_skip_bytes;
-            if (skip > file->transform_buffer_len) {
-                skip = file->transform_buffer_len;
-            }
-            file->transform_buffer_pos = skip;
-            file->seek_skip_bytes -= skip;
-        }
+        _commit_block_groups(file);
     }
 
     *bytes_read = total_read;
@@ -2593,6 +3173,25 @@ static int _read_audio_region_mt(sacd_vfs_file_t *file, uint8_t *buffer,
             break;
         }
 
+        /* Another reader may have decoded this block group already */
+        if (_fetch_cached_block(file)) {
+            continue;
+        }
+        _sync_pipeline(file);
+
+        /* First block this handle has to decode: start the pipeline */
+        if (!file->mt_enabled && _start_mt_pipeline(file) != SACD_VFS_OK) {
+            sa_log(NULL, SA_LOG_WARNING,
+                   "sacd_vfs: track %u MT pipeline unavailable, decoding single-threaded\n",
+                   file->track_num);
+            file->pool = NULL;
+
+            size_t st_read = 0;
+            int st_ret = _read_audio_region(file, buffer + total_read, size, &st_read);
+            *bytes_read = total_read + st_read;
+            return (total_read > 0) ? SACD_VFS_OK : st_ret;
+        }
+
         /* Pull next decoded result from the process queue (blocking) */
         sa_tpool_result *result = sa_tpool_next_result_wait(file->process);
         if (!result) {
@@ -2621,12 +3220,14 @@ static int _read_audio_region_mt(sacd_vfs_file_t *file, uint8_t *buffer,
                     if (total_read > 0) break;
                     return flush_ret;
                 }
+                _commit_block_groups(file);
                 /* Continue loop to consume the flushed data; audio_early_eof check
                  * above will exit before calling sa_tpool_next_result_wait again */
                 continue;
             }
             break;
         }
+        _consume_mt_frame(file);
 
         /* Check for decode error */
         if (job->error_code != 0 || !job->decompressed_data || job->decompressed_size <= 0) {
@@ -2656,16 +3257,7 @@ static int _read_audio_region_mt(sacd_vfs_file_t *file, uint8_t *buffer,
             if (total_read > 0) break;
             return transform_ret;
         }
-
-        /* After a seek, skip bytes to align with target position */
-        if (file->seek_skip_bytes > 0 && file->transform_buffer_len > 0) {
-            size_t skip = file->seek_skip_bytes;
-            if (skip > file->transform_buffer_len) {
-                skip = file->transform_buffer_len;
-            }
-            file->transform_buffer_pos = skip;
-            file->seek_skip_bytes -= skip;
-        }
+        _commit_block_groups(file);
     }
 
     *bytes_read = total_read;
@@ -2706,3 +3298,413 @@ static int _read_metadata_region(sacd_vfs_file_t *file, uint8_t *buffer, size_t
     sa_free(id3_data);
     return SACD_VFS_OK;
 }
+
+/* =============================================================================
+ * DSDIFF/DST Passthrough
+ * ===========================================================================*/
+
+/**
+ * @brief Lay out a track as DSDIFF/DST.
+ *
+ * The frame sizes of a track are read from the disc by the first open and
+ * kept by the context, since every stat and listing opens the file again.
+ * The scan reads the whole track, so it runs outside dff_lock; other opens
+ * of the same track wait for it, opens of other tracks do not.
+ */
+static int _open_dff_layout(sacd_vfs_file_t *file)
+{
+    sacd_vfs_ctx_t *ctx = file->ctx;
+    area_info_t *area = &ctx->areas[file->area];
+    uint32_t frame_count = file->end_frame - file->start_frame;
+    const uint32_t *frame_size = NULL;
+    int result = SACD_VFS_OK;
+
+    mtx_lock(&ctx->dff_lock);
+    if (!area->dff_tracks) {
+        area->dff_tracks = sa_calloc(area->track_count, sizeof(*area->dff_tracks));
+    }
+    if (!area->dff_tracks) {
+        result = SACD_VFS_ERROR_MEMORY;
+    } else {
+        dff_track_t *track = &area->dff_tracks[file->track_num - 1];
+        while (track->scanning) {
+            cnd_wait(&ctx->dff_scanned, &ctx->dff_lock);
+        }
+        if (!track->frame_size && frame_count > 0) {
+            uint32_t *sizes = NULL;
+            uint32_t found = 0;
+
+            track->scanning = true;
+            mtx_unlock(&ctx->dff_lock);
+            result = _vfs_dff_scan_frames(file->reader, file->start_frame,
+                                          frame_count, file->info.channel_count,
+                                          &sizes, &found);
+            if (result == SACD_VFS_OK && found < frame_count) {
+                sa_log(NULL, SA_LOG_WARNING,
+                       "sacd_vfs: track %u audio ended at frame %u (expected %u),"
+                       " filling gap with silence\n",
+                       file->track_num, file->start_frame + found, file->end_frame);
+            }
+            mtx_lock(&ctx->dff_lock);
+            track->scanning = false;
+            track->frame_size = sizes;
+            track->frames_found = found;
+            cnd_broadcast(&ctx->dff_scanned);
+        }
+        frame_size = track->frame_size;
+        file->dff_found = track->frames_found;
+    }
+    mtx_unlock(&ctx->dff_lock);
+
+    if (result != SACD_VFS_OK) {
+        return result;
+    }
+
+    /* Get ID3 tag size */
+    uint8_t *id3_data = NULL;
+    size_t id3_size = 0;
+    if (sacd_vfs_get_id3_tag(ctx, file->area, file->track_num, &id3_data,
+                             &id3_size) != SACD_VFS_OK || !id3_data) {
+        id3_size = 0;
+    }
+    sa_free(id3_data);
+
+    file->dff = _vfs_dff_layout_create(frame_size, frame_count,
+                                       file->info.channel_count,
+                                       file->info.sample_rate, id3_size);
+    if (!file->dff) {
+        return SACD_VFS_ERROR_MEMORY;
+    }
+
+    file->dsf_header_size = file->dff->header_size;
+    file->info.header_size = file->dff->header_size;
+    file->info.audio_data_size = file->dff->data_end - file->dff->header_size;
+    file->info.metadata_offset = file->dff->id3_offset;
+    file->info.metadata_size = file->dff->id3_size;
+    file->info.total_size = file->dff->total_size;
+
+    return SACD_VFS_OK;
+}
+
+static int _read_dff_region(sacd_vfs_file_t *file, uint8_t *buffer, size_t size, size_t *bytes_read)
+{
+    vfs_dff_layout_t *dff = file->dff;
+    uint32_t frame;
+    uint32_t within;
+
+    *bytes_read = 0;
+
+    if (!_vfs_dff_find_payload(dff, file->position, &frame, &within)) {
+        size_t n = _vfs_dff_read_structure(dff, file->position, buffer, size);
+        file->position += n;
+        *bytes_read = n;
+        return n > 0 ? SACD_VFS_OK : SACD_VFS_ERROR_EOF;
+    }
+
+    /* Past the end of the audio: a plain DST frame of silence */
+    if (frame >= file->dff_found) {
+        size_t n = dff->frame_size[frame] - within;
+        if (n > size) {
+            n = size;
+        }
+        memset(buffer, VFS_DFF_SILENCE, n);
+        if (within == 0) {
+            buffer[0] = 0;
+        }
+        file->position += n;
+        *bytes_read = n;
+        return SACD_VFS_OK;
+    }
+
+    if (frame < file->dff_first || frame - file->dff_first >= file->dff_count) {
+        uint32_t count = file->dff_found - frame;
+        if (count > VFS_MT_READ_BATCH) {
+            count = VFS_MT_READ_BATCH;
+        }
+
+        sacd_release_sound_frames(file->dff_frames, file->dff_count);
+        file->dff_count = 0;
+        if (sacd_get_sound_frames(file->reader, file->start_frame + frame, &count,
+                                  file->dff_frames) != SACD_OK || count == 0) {
+            return SACD_VFS_ERROR_READ;
+        }
+        file->dff_first = frame;
+        file->dff_count = count;
+    }
+
+    /* The layout promised this size to the player */
+    const sacd_frame_ref_t *ref = &file->dff_frames[frame - file->dff_first];
+    if (ref->size != dff->frame_size[frame]) {
+        return SACD_VFS_ERROR_FORMAT;
+    }
+
+    size_t n = ref->size - within;
+    if (n > size) {
+        n = size;
+    }
+    memcpy(buffer, ref->data + within, n);
+    file->position += n;
+    *bytes_read = n;
+
+    return SACD_VFS_OK;
+}
+
+/* =============================================================================
+ * PCM (WAV) Renditions
+ * ===========================================================================*/
+
+static int _open_pcm_layout(sacd_vfs_file_t *file)
+{
+    sacd_vfs_ctx_t *ctx = file->ctx;
+
+    if (file->info.sample_rate % ctx->pcm_sample_rate != 0) {
+        return SACD_VFS_ERROR_FORMAT;
+    }
+
+    /* Get ID3 tag size */
+    uint8_t *id3_data = NULL;
+    size_t id3_size = 0;
+    if (sacd_vfs_get_id3_tag(ctx, file->area, file->track_num, &id3_data,
+                             &id3_size) != SACD_VFS_OK || !id3_data) {
+        id3_size = 0;
+    }
+    sa_free(id3_data);
+
+    file->pcm = sa_mallocz(sizeof(*file->pcm));
+    if (!file->pcm) {
+        return SACD_VFS_ERROR_MEMORY;
+    }
+
+    int result = _vfs_pcm_layout_init(file->pcm, file->end_frame - file->start_frame,
+                                      file->info.channel_count, ctx->pcm_sample_rate,
+                                      ctx->pcm_bits, id3_size);
+    if (result != SACD_VFS_OK) {
+        /* Too long for a RIFF file: not offered at all */
+        return SACD_VFS_ERROR_NOT_FOUND;
+    }
+
+    file->dsf_header_size = file->pcm->header_size;
+    file->info.header_size = file->pcm->header_size;
+    file->info.audio_data_size = file->pcm->data_size;
+    file->info.metadata_offset = file->pcm->id3_offset;
+    file->info.metadata_size = file->pcm->id3_size;
+    file->info.total_size = file->pcm->total_size;
+
+    file->pcm_block_index = VFS_NO_BLOCK;
+    file->block_cache = ctx->block_cache;
+
+    return SACD_VFS_OK;
+}
+
+/**
+ * @brief Set up conversion on the first read of PCM data.
+ *
+ * Restarting the converter at a frame without the frames before it would
+ * change the first blocks it produces. The filters are primed by the
+ * frames that span twice their delay, plus one for the rounding.
+ */
+static int _start_pcm_converter(sacd_vfs_file_t *file)
+{
+    vfs_pcm_layout_t *pcm = file->pcm;
+    uint32_t channel_count = file->info.channel_count;
+
+    file->pcm_samples = sa_malloc_array(pcm->block_samples, sizeof(double));
+    file->pcm_converter = dsdpcm_create();
+    if (!file->pcm_samples || !file->pcm_converter) {
+        return SACD_VFS_ERROR_MEMORY;
+    }
+
+    if (dsdpcm_init(file->pcm_converter, channel_count, SACD_FRAMES_PER_SEC,
+                    file->info.sample_rate, pcm->sample_rate,
+                    DSDPCM_CONV_MULTISTAGE, DSDPCM_PRECISION_FP64,
+                    NULL) != DSDPCM_OK) {
+        return SACD_VFS_ERROR_FORMAT;
+    }
+
+    double delay = 0.0;
+    dsdpcm_get_delay(file->pcm_converter, &delay);
+    file->pcm_warmup = (uint32_t)(2.0 * delay * channel_count / pcm->block_samples) + 1;
+    file->pcm_next_frame = 0;
+    file->pcm_exact_frame = 0;
+
+    if (file->info.frame_format == SACD_VFS_FRAME_DST) {
+        dst_decoder_init(&file->dst_decoder, (int)channel_count,
+                         (int)file->info.sample_rate);
+        file->dst_decode_buffer_size = SACD_FRAME_SIZE_64 * channel_count;
+        file->dst_decode_buffer = sa_malloc(file->dst_decode_buffer_size);
+        if (!file->dst_decoder || !file->dst_decode_buffer) {
+            return SACD_VFS_ERROR_MEMORY;
+        }
+    }
+
+    return SACD_VFS_OK;
+}
+
+/**
+ * @brief Convert the next frame of the track into file->pcm_samples.
+ *
+ * A frame missing from the disc (see audio_early_eof) converts to silence.
+ */
+static int _convert_pcm_frame(sacd_vfs_file_t *file)
+{
+    vfs_pcm_layout_t *pcm = file->pcm;
+    uint32_t frame = file->start_frame + file->pcm_next_frame++;
+    uint8_t frame_buffer[SACD_MAX_DSD_SIZE];
+    uint32_t frames_to_read = 1;
+    uint16_t frame_size = 0;
+    size_t samples = 0;
+
+    int result = sacd_get_sound_data(file->reader, frame_buffer, frame,
+                                     &frames_to_read, &frame_size);
+    if (result == SACD_OK && frames_to_read > 0) {
+        const uint8_t *data = frame_buffer;
+        size_t data_len = frame_size;
+
+        if (file->info.frame_format == SACD_VFS_FRAME_DST) {
+            int decoded_len = 0;
+            if (dst_decoder_decode(file->dst_decoder, frame_buffer, frame_size,
+                                   file->dst_decode_buffer, &decoded_len) != 0 ||
+                decoded_len <= 0) {
+                return SACD_VFS_ERROR_DST_DECODE;
+            }
+            data = file->dst_decode_buffer;
+            data_len = (size_t)decoded_len;
+        }
+
+        if (dsdpcm_convert_fp64(file->pcm_converter, data, data_len,
+                                file->pcm_samples, &samples) != DSDPCM_OK) {
+            return SACD_VFS_ERROR_FORMAT;
+        }
+    } else if (!file->audio_early_eof) {
+        file->audio_early_eof = 1;
+        sa_log(NULL, SA_LOG_WARNING,
+               "sacd_vfs: track %u audio ended at frame %u (expected %u),"
+               " filling gap with silence\n",
+               file->track_num, frame, file->end_frame);
+    }
+
+    if (samples < pcm->block_samples) {
+        memset(file->pcm_samples + samples, 0,
+               (pcm->block_samples - samples) * sizeof(double));
+    }
+    return SACD_VFS_OK;
+}
+
+/**
+ * @brief Make file->pcm_block hold a block, from the cache or converted.
+ *
+ * The converter carries on if the block is at most pcm_warmup frames
+ * ahead; otherwise it restarts that many frames before the block. Blocks
+ * converted with primed filters are identical whichever way they were
+ * reached, so they are offered to the block cache.
+ */
+static int _load_pcm_block(sacd_vfs_file_t *file, uint32_t block)
+{
+    vfs_pcm_layout_t *pcm = file->pcm;
+    vfs_block_key_t key = {
+        .owner = file->ctx->block_cache_owner,
+        .area = (uint8_t)(file->area | VFS_BLOCK_AREA_PCM),
+        .track = file->track_num,
+        .block = block
+    };
+    int result;
+
+    if (!file->pcm_block) {
+        file->pcm_block = sa_malloc(pcm->block_size);
+        if (!file->pcm_block) {
+            return SACD_VFS_ERROR_MEMORY;
+        }
+    }
+
+    if (file->block_cache &&
+        _vfs_block_cache_lookup(file->block_cache, &key, file->pcm_block,
+                                pcm->block_size)) {
+        file->pcm_block_index = block;
+        return SACD_VFS_OK;
+    }
+
+    if (!file->pcm_converter) {
+        result = _start_pcm_converter(file);
+        if (result != SACD_VFS_OK) {
+            if (file->pcm_converter) {
+                dsdpcm_destroy(file->pcm_converter);
+                file->pcm_converter = NULL;
+            }
+            return result;
+        }
+    }
+
+    if (block < file->pcm_next_frame ||
+        block - file->pcm_next_frame > file->pcm_warmup) {
+        uint32_t start = block > file->pcm_warmup ? block - file->pcm_warmup : 0;
+        if (dsdpcm_init(file->pcm_converter, file->info.channel_count,
+                        SACD_FRAMES_PER_SEC, file->info.sample_rate,
+                        pcm->sample_rate, DSDPCM_CONV_MULTISTAGE,
+                        DSDPCM_PRECISION_FP64, NULL) != DSDPCM_OK) {
+            return SACD_VFS_ERROR_FORMAT;
+        }
+        file->pcm_next_frame = start;
+        file->pcm_exact_frame = start > 0 ? block : 0;
+    }
+
+    /* pcm_block is overwritten from here on */
+    file->pcm_block_index = VFS_NO_BLOCK;
+
+    while (file->pcm_next_frame <= block) {
+        uint32_t frame = file->pcm_next_frame;
+
+        result = _convert_pcm_frame(file);
+        if (result != SACD_VFS_OK) {
+            return result;
+        }
+        if (frame < file->pcm_exact_frame && frame != block) {
+            continue;
+        }
+
+        _vfs_pcm_pack(file->pcm_samples, pcm->block_samples,
+                      pcm->bits_per_sample, file->pcm_block);
+        if (file->block_cache && frame >= file->pcm_exact_frame) {
+            key.block = frame;
+            _vfs_block_cache_insert(file->block_cache, &key, file->pcm_block,
+                                    pcm->block_size);
+        }
+    }
+
+    file->pcm_block_index = block;
+    return SACD_VFS_OK;
+}
+
+static int _read_pcm_region(sacd_vfs_file_t *file, uint8_t *buffer, size_t size, size_t *bytes_read)
+{
+    vfs_pcm_layout_t *pcm = file->pcm;
+
+    *bytes_read = 0;
+
+    if (file->position < pcm->data_offset ||
+        file->position >= pcm->data_offset + pcm->data_size) {
+        size_t n = _vfs_pcm_read_structure(pcm, file->position, buffer, size);
+        file->position += n;
+        *bytes_read = n;
+        return n > 0 ? SACD_VFS_OK : SACD_VFS_ERROR_EOF;
+    }
+
+    uint64_t audio_offset = file->position - pcm->data_offset;
+    uint32_t block = (uint32_t)(audio_offset / pcm->block_size);
+    if (block != file->pcm_block_index) {
+        int result = _load_pcm_block(file, block);
+        if (result != SACD_VFS_OK) {
+            return result;
+        }
+    }
+
+    size_t within = (size_t)(audio_offset % pcm->block_size);
+    size_t n = pcm->block_size - within;
+    if (n > size) {
+        n = size;
+    }
+    memcpy(buffer, file->pcm_block + within, n);
+    file->position += n;
+    *bytes_read = n;
+
+    return SACD_VFS_OK;
+}
@@ -0,0 +1,295 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Decoded block cache for virtual DSF files.
+ * Keeps DSF block groups (4096 bytes per channel, already de-interleaved
+ * and bit-reversed) in an LRU list bounded by a byte budget. Every file
+ * handle of an attached VFS context looks blocks up here before decoding,
+ * so readers of the same track share one decode.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sacd_vfs_cache.h"
+
+#include <libsautil/mem.h>
+
+#include <string.h>
+#ifdef __APPLE__
+#include <libsautil/c11threads.h>
+#else
+#include <threads.h>
+#endif
+
+/** Block group size the hash table is sized for (stereo) */
+#define BLOCK_CACHE_TYPICAL_BLOCK   (2 * DSF_BLOCK_SIZE_PER_CHANNEL)
+
+/** Smallest hash table */
+#define BLOCK_CACHE_MIN_BUCKETS     64
+
+/** One cached block group */
+typedef struct cache_entry {
+    vfs_block_key_t key;
+    size_t size;                    /* Bytes in data */
+    struct cache_entry *hash_next;  /* Next entry in the hash bucket */
+    struct cache_entry *lru_prev;   /* More recently used neighbour */
+    struct cache_entry *lru_next;   /* Less recently used neighbour */
+    uint8_t data[];
+} cache_entry_t;
+
+/** Decoded block cache */
+struct sacd_vfs_block_cache {
+    mtx_t lock;                     /* Protects everything below */
+    cache_entry_t **buckets;        /* Hash table */
+    uint32_t bucket_mask;           /* Bucket count - 1 (power of two) */
+    cache_entry_t lru;              /* List head; lru.lru_next is most recent */
+    size_t bytes;                   /* Bytes held, entry headers included */
+    size_t max_bytes;               /* Budget */
+    uint32_t entries;               /* Block groups held */
+    uint32_t next_owner;            /* Last owner id handed out */
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t insertions;
+    uint64_t evictions;
+};
+
+/* =============================================================================
+ * Hash Table and LRU List
+ * ===========================================================================*/
+
+static cache_entry_t **_cache_bucket(sacd_vfs_block_cache_t *cache,
+                                     const vfs_block_key_t *key)
+{
+    uint32_t h = key->owner * 0x9E3779B1u;
+    h ^= ((uint32_t)key->area << 8 | key->track) * 0x85EBCA77u;
+    h ^= key->block * 0xC2B2AE3Du;
+    h ^= h >> 15;
+    return &cache->buckets[h & cache->bucket_mask];
+}
+
+static bool _cache_key_equal(const vfs_block_key_t *a, const vfs_block_key_t *b)
+{
+    return a->owner == b->owner && a->area == b->area &&
+           a->track == b->track && a->block == b->block;
+}
+
+static cache_entry_t *_cache_find(sacd_vfs_block_cache_t *cache,
+                                  const vfs_block_key_t *key)
+{
+    cache_entry_t *entry = *_cache_bucket(cache, key);
+    while (entry && !_cache_key_equal(&entry->key, key)) {
+        entry = entry->hash_next;
+    }
+    return entry;
+}
+
+static void _cache_lru_unlink(cache_entry_t *entry)
+{
+    entry->lru_prev->lru_next = entry->lru_next;
+    entry->lru_next->lru_prev = entry->lru_prev;
+}
+
+static void _cache_lru_push_front(sacd_vfs_block_cache_t *cache, cache_entry_t *entry)
+{
+    entry->lru_prev = &cache->lru;
+    entry->lru_next = cache->lru.lru_next;
+    cache->lru.lru_next->lru_prev = entry;
+    cache->lru.lru_next = entry;
+}
+
+/**
+ * @brief Unlink and free an entry (lock held).
+ */
+static void _cache_remove(sacd_vfs_block_cache_t *cache, cache_entry_t *entry)
+{
+    cache_entry_t **link = _cache_bucket(cache, &entry->key);
+    while (*link != entry) {
+        link = &(*link)->hash_next;
+    }
+    *link = entry->hash_next;
+
+    _cache_lru_unlink(entry);
+    cache->bytes -= sizeof(cache_entry_t) + entry->size;
+    cache->entries--;
+    sa_free(entry);
+}
+
+/* =============================================================================
+ * Public API
+ * ===========================================================================*/
+
+sacd_vfs_block_cache_t *sacd_vfs_block_cache_create(size_t max_bytes)
+{
+    sacd_vfs_block_cache_t *cache;
+    uint32_t buckets = BLOCK_CACHE_MIN_BUCKETS;
+
+    if (max_bytes == 0) {
+        return NULL;
+    }
+
+    cache = sa_mallocz(sizeof(*cache));
+    if (!cache) {
+        return NULL;
+    }
+
+    while (buckets < (1u << 20) &&
+           (size_t)buckets * BLOCK_CACHE_TYPICAL_BLOCK < max_bytes) {
+        buckets <<= 1;
+    }
+    cache->buckets = sa_calloc(buckets, sizeof(cache_entry_t *));
+    if (!cache->buckets) {
+        sa_free(cache);
+        return NULL;
+    }
+    if (mtx_init(&cache->lock, mtx_plain) != thrd_success) {
+        sa_free(cache->buckets);
+        sa_free(cache);
+        return NULL;
+    }
+
+    cache->bucket_mask = buckets - 1;
+    cache->lru.lru_next = &cache->lru;
+    cache->lru.lru_prev = &cache->lru;
+    cache->max_bytes = max_bytes;
+    return cache;
+}
+
+void sacd_vfs_block_cache_destroy(sacd_vfs_block_cache_t *cache)
+{
+    if (!cache) {
+        return;
+    }
+
+    while (cache->lru.lru_next != &cache->lru) {
+        _cache_remove(cache, cache->lru.lru_next);
+    }
+    mtx_destroy(&cache->lock);
+    sa_free(cache->buckets);
+    sa_free(cache);
+}
+
+int sacd_vfs_block_cache_get_stats(sacd_vfs_block_cache_t *cache,
+                                   sacd_vfs_block_cache_stats_t *stats)
+{
+    if (!cache || !stats) {
+        return SACD_VFS_ERROR_INVALID_PARAMETER;
+    }
+
+    mtx_lock(&cache->lock);
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->insertions = cache->insertions;
+    stats->evictions = cache->evictions;
+    stats->bytes = cache->bytes;
+    stats->max_bytes = cache->max_bytes;
+    stats->entries = cache->entries;
+    mtx_unlock(&cache->lock);
+    return SACD_VFS_OK;
+}
+
+/* =============================================================================
+ * Internal API
+ * ===========================================================================*/
+
+uint32_t _vfs_block_cache_attach(sacd_vfs_block_cache_t *cache)
+{
+    uint32_t owner;
+
+    mtx_lock(&cache->lock);
+    owner = ++cache->next_owner;
+    mtx_unlock(&cache->lock);
+    return owner;
+}
+
+void _vfs_block_cache_purge(sacd_vfs_block_cache_t *cache, uint32_t owner)
+{
+    cache_entry_t *entry;
+
+    mtx_lock(&cache->lock);
+    entry = cache->lru.lru_next;
+    while (entry != &cache->lru) {
+        cache_entry_t *next = entry->lru_next;
+        if (entry->key.owner == owner) {
+            _cache_remove(cache, entry);
+        }
+        entry = next;
+    }
+    mtx_unlock(&cache->lock);
+}
+
+bool _vfs_block_cache_lookup(sacd_vfs_block_cache_t *cache,
+                             const vfs_block_key_t *key, uint8_t *dst,
+                             size_t size)
+{
+    cache_entry_t *entry;
+    bool hit = false;
+
+    mtx_lock(&cache->lock);
+    entry = _cache_find(cache, key);
+    if (entry && entry->size == size) {
+        /* Copy under the lock so the entry cannot be evicted meanwhile */
+        memcpy(dst, entry->data, size);
+        _cache_lru_unlink(entry);
+        _cache_lru_push_front(cache, entry);
+        cache->hits++;
+        hit = true;
+    } else {
+        cache->misses++;
+    }
+    mtx_unlock(&cache->lock);
+    return hit;
+}
+
+void _vfs_block_cache_insert(sacd_vfs_block_cache_t *cache,
+                             const vfs_block_key_t *key, const uint8_t *src,
+                             size_t size)
+{
+    size_t cost = sizeof(cache_entry_t) + size;
+    cache_entry_t *entry;
+
+    if (cost > cache->max_bytes) {
+        return;
+    }
+
+    /* Copy outside the lock; another reader may store the same block first */
+    entry = sa_malloc(cost);
+    if (!entry) {
+        return;
+    }
+    entry->key = *key;
+    entry->size = size;
+    memcpy(entry->data, src, size);
+
+    mtx_lock(&cache->lock);
+    if (_cache_find(cache, key)) {
+        mtx_unlock(&cache->lock);
+        sa_free(entry);
+        return;
+    }
+
+    while (cache->bytes + cost > cache->max_bytes) {
+        _cache_remove(cache, cache->lru.lru_prev);
+        cache->evictions++;
+    }
+
+    cache_entry_t **bucket = _cache_bucket(cache, key);
+    entry->hash_next = *bucket;
+    *bucket = entry;
+    _cache_lru_push_front(cache, entry);
+    cache->bytes += cost;
+    cache->entries++;
+    cache->insertions++;
+    mtx_unlock(&cache->lock);
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Decoded block caches - Internal Header
+ * Block groups of virtual DSF files, shared by every file handle of the
+ * VFS contexts attached to one cache, in memory or on disk.
+ * This header is NOT part of the public API.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBSACDVFS_SACD_VFS_CACHE_H
+#define LIBSACDVFS_SACD_VFS_CACHE_H
+
+#include <libsacdvfs/sacd_vfs.h>
+
+/** Identifies one block group of one virtual file */
+typedef struct {
+    uint32_t owner;     /* VFS context or ISO, from the cache's attach */
+    uint8_t area;       /* sacd_vfs_area_t, VFS_BLOCK_AREA_PCM for WAV blocks */
+    uint8_t track;      /* Track number (1-based) */
+    uint32_t block;     /* Block group index within the audio data */
+} vfs_block_key_t;
+
+/** Or'ed into vfs_block_key_t.area for the blocks of PCM renditions, which
+ * are one SACD frame of PCM each; only the memory cache holds them */
+#define VFS_BLOCK_AREA_PCM  0x80
+
+/**
+ * @brief Register a VFS context with the cache.
+ *
+ * @return Owner id to put in the keys of the context's blocks
+ */
+uint32_t _vfs_block_cache_attach(sacd_vfs_block_cache_t *cache);
+
+/**
+ * @brief Drop every block of an owner (its ISO was closed).
+ */
+void _vfs_block_cache_purge(sacd_vfs_block_cache_t *cache, uint32_t owner);
+
+/**
+ * @brief Copy a cached block group into @p dst.
+ *
+ * @return true on a hit; @p size must match the size it was stored with
+ */
+bool _vfs_block_cache_lookup(sacd_vfs_block_cache_t *cache,
+                             const vfs_block_key_t *key, uint8_t *dst,
+                             size_t size);
+
+/**
+ * @brief Store a copy of a block group, evicting old ones to stay in budget.
+ *
+ * Does nothing if the block is already cached or is larger than the cache.
+ */
+void _vfs_block_cache_insert(sacd_vfs_block_cache_t *cache,
+                             const vfs_block_key_t *key, const uint8_t *src,
+                             size_t size);
+
+/* =============================================================================
+ * On-Disk Transcode Cache (sacd_vfs_disk_cache.c)
+ * ===========================================================================*/
+
+/**
+ * @brief Register an opened ISO with the disk cache.
+ *
+ * Drops the ISO's cached tracks if it changed since they were written.
+ *
+ * @return ISO id to put in the owner field of block keys, 0 on failure
+ */
+uint32_t _vfs_disk_cache_attach(sacd_vfs_disk_cache_t *cache, const char *iso_path);
+
+/**
+ * @brief Release an ISO id; its track files are closed but kept.
+ */
+void _vfs_disk_cache_detach(sacd_vfs_disk_cache_t *cache, uint32_t iso);
+
+/**
+ * @brief Read a block group written earlier into @p dst.
+ *
+ * @return true on a hit; @p size must match the size it was written with
+ */
+bool _vfs_disk_cache_lookup(sacd_vfs_disk_cache_t *cache,
+                            const vfs_block_key_t *key, uint8_t *dst,
+                            size_t size);
+
+/**
+ * @brief Write a block group, deleting old tracks to stay in budget.
+ */
+void _vfs_disk_cache_insert(sacd_vfs_disk_cache_t *cache,
+                            const vfs_block_key_t *key, const uint8_t *src,
+                            size_t size);
+
+#endif /* LIBSACDVFS_SACD_VFS_CACHE_H */
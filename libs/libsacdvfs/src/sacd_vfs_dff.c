@@ -0,0 +1,362 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Virtual DSDIFF/DST files.
+ * Lays out a track of a DST coded area as a DSDIFF file whose DSTF chunks
+ * hold the disc's frames as they are. The chunk headers, the DSTI index and
+ * the file header are generated from a table of frame sizes, read once per
+ * track, so serving the file needs no decoding at all.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sacd_vfs_dff.h"
+
+#include <libsautil/mem.h>
+#include <libsautil/intreadwrite.h>
+
+#include <string.h>
+
+/** Frames fetched per libsacd call while scanning */
+#define DFF_SCAN_BATCH          32
+
+/** DSDIFF version 1.5 */
+#define DFF_FORMAT_VERSION      0x01050000
+
+/** Size of one DSTI entry (u64 offset, u32 length) */
+#define DFF_INDEX_ENTRY_SIZE    12
+
+static const char *const _dff_compression_name = "DST Encoded";
+
+/* =============================================================================
+ * Frame Size Scan
+ * ===========================================================================*/
+
+int _vfs_dff_scan_frames(sacd_t *reader, uint32_t start_frame,
+                         uint32_t frame_count, uint32_t channel_count,
+                         uint32_t **frame_size, uint32_t *frames_found)
+{
+    sacd_frame_ref_t batch[DFF_SCAN_BATCH];
+    uint32_t *sizes;
+    uint32_t done = 0;
+
+    *frame_size = NULL;
+    *frames_found = 0;
+    if (frame_count == 0) {
+        return SACD_VFS_OK;
+    }
+
+    sizes = sa_malloc_array(frame_count, sizeof(*sizes));
+    if (!sizes) {
+        return SACD_VFS_ERROR_MEMORY;
+    }
+
+    while (done < frame_count) {
+        uint32_t count = frame_count - done;
+        if (count > DFF_SCAN_BATCH) {
+            count = DFF_SCAN_BATCH;
+        }
+
+        if (sacd_get_sound_frames(reader, start_frame + done, &count,
+                                  batch) != SACD_OK || count == 0) {
+            break;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            sizes[done + i] = batch[i].size;
+        }
+        sacd_release_sound_frames(batch, count);
+        done += count;
+    }
+
+    /* Audio ended early: the rest is served as silence */
+    *frames_found = done;
+    for (; done < frame_count; done++) {
+        sizes[done] = VFS_DFF_PLAIN_FRAME_SIZE(channel_count);
+    }
+
+    *frame_size = sizes;
+    return SACD_VFS_OK;
+}
+
+/* =============================================================================
+ * Layout
+ * ===========================================================================*/
+
+static uint8_t *_put_chunk(uint8_t *p, const char *id, uint64_t size)
+{
+    memcpy(p, id, 4);
+    SA_WB64(p + 4, size);
+    return p + VFS_DFF_CHUNK_HEADER_SIZE;
+}
+
+/** Channel IDs in SACD channel order, as libdsdiff writes them */
+static void _channel_id(uint32_t channel_count, uint32_t ch, uint8_t *id)
+{
+    static const char *const stereo[] = { "SLFT", "SRGT" };
+    static const char *const five[] = { "MLFT", "MRGT", "C   ", "LS  ", "RS  " };
+    static const char *const six[] = { "MLFT", "MRGT", "C   ", "LFE ", "LS  ", "RS  " };
+
+    if (channel_count == 2) {
+        memcpy(id, stereo[ch], 4);
+    } else if (channel_count == 5) {
+        memcpy(id, five[ch], 4);
+    } else if (channel_count == 6) {
+        memcpy(id, six[ch], 4);
+    } else {
+        id[0] = 'C';
+        id[1] = (uint8_t)('0' + ch / 100 % 10);
+        id[2] = (uint8_t)('0' + ch / 10 % 10);
+        id[3] = (uint8_t)('0' + ch % 10);
+    }
+}
+
+/** FRM8 through FRTE; the sizes need the finished layout */
+static void _generate_header(vfs_dff_layout_t *layout, uint32_t channel_count,
+                             uint32_t sample_rate)
+{
+    size_t name_len = strlen(_dff_compression_name);
+    uint64_t cmpr_size = 4 + 1 + name_len + ((name_len % 2) == 0 ? 1 : 0);
+    uint64_t chnl_size = 2 + 4 * (uint64_t)channel_count;
+    uint64_t prop_size = 4 + (VFS_DFF_CHUNK_HEADER_SIZE + 4) +
+                         (VFS_DFF_CHUNK_HEADER_SIZE + chnl_size) +
+                         (VFS_DFF_CHUNK_HEADER_SIZE + cmpr_size);
+    uint8_t *p = layout->header;
+
+    p = _put_chunk(p, "FRM8", layout->total_size - VFS_DFF_CHUNK_HEADER_SIZE);
+    memcpy(p, "DSD ", 4);
+    p += 4;
+
+    p = _put_chunk(p, "FVER", 4);
+    SA_WB32(p, DFF_FORMAT_VERSION);
+    p += 4;
+
+    p = _put_chunk(p, "PROP", prop_size);
+    memcpy(p, "SND ", 4);
+    p += 4;
+
+    p = _put_chunk(p, "FS  ", 4);
+    SA_WB32(p, sample_rate);
+    p += 4;
+
+    p = _put_chunk(p, "CHNL", chnl_size);
+    SA_WB16(p, channel_count);
+    p += 2;
+    for (uint32_t ch = 0; ch < channel_count; ch++) {
+        _channel_id(channel_count, ch, p);
+        p += 4;
+    }
+
+    p = _put_chunk(p, "CMPR", cmpr_size);
+    memcpy(p, "DST ", 4);
+    p[4] = (uint8_t)name_len;
+    memcpy(p + 5, _dff_compression_name, name_len);
+    p += 5 + name_len;
+    if ((name_len % 2) == 0) {
+        *p++ = 0;
+    }
+
+    /* The DST chunk runs from here to data_end */
+    p = _put_chunk(p, "DST ", layout->data_end -
+                   (uint64_t)(p - layout->header) - VFS_DFF_CHUNK_HEADER_SIZE);
+    p = _put_chunk(p, "FRTE", 6);
+    SA_WB32(p, layout->frame_count);
+    SA_WB16(p + 4, SACD_FRAMES_PER_SEC);
+    p += 6;
+
+    layout->header_size = (size_t)(p - layout->header);
+}
+
+/** Size of FRM8 through FRTE, before the sizes in it are known */
+static size_t _header_size(uint32_t channel_count)
+{
+    size_t name_len = strlen(_dff_compression_name);
+
+    return (VFS_DFF_CHUNK_HEADER_SIZE + 4) +            /* FRM8 */
+           (VFS_DFF_CHUNK_HEADER_SIZE + 4) +            /* FVER */
+           (VFS_DFF_CHUNK_HEADER_SIZE + 4) +            /* PROP */
+           (VFS_DFF_CHUNK_HEADER_SIZE + 4) +            /* FS */
+           (VFS_DFF_CHUNK_HEADER_SIZE + 2 + 4 * (size_t)channel_count) +
+           (VFS_DFF_CHUNK_HEADER_SIZE + 5 + name_len + ((name_len % 2) == 0 ? 1 : 0)) +
+           VFS_DFF_CHUNK_HEADER_SIZE +                  /* DST */
+           (VFS_DFF_CHUNK_HEADER_SIZE + 6);             /* FRTE */
+}
+
+vfs_dff_layout_t *_vfs_dff_layout_create(const uint32_t *frame_size,
+                                         uint32_t frame_count,
+                                         uint32_t channel_count,
+                                         uint32_t sample_rate,
+                                         size_t id3_size)
+{
+    if (channel_count == 0 || channel_count > MAX_CHANNEL_COUNT ||
+        (frame_count > 0 && !frame_size)) {
+        return NULL;
+    }
+
+    vfs_dff_layout_t *layout = sa_mallocz(sizeof(*layout));
+    if (!layout) {
+        return NULL;
+    }
+
+    if (frame_count > 0) {
+        layout->frame_pos = sa_malloc_array(frame_count, sizeof(*layout->frame_pos));
+        if (!layout->frame_pos) {
+            sa_free(layout);
+            return NULL;
+        }
+    }
+    layout->frame_count = frame_count;
+    layout->frame_size = frame_size;
+
+    /* DSTF chunks, each padded to an even size */
+    uint64_t pos = _header_size(channel_count);
+    for (uint32_t i = 0; i < frame_count; i++) {
+        layout->frame_pos[i] = pos + VFS_DFF_CHUNK_HEADER_SIZE;
+        pos = layout->frame_pos[i] + frame_size[i] + (frame_size[i] & 1);
+    }
+    layout->data_end = pos;
+
+    /* DSTI, then the tag */
+    pos += VFS_DFF_CHUNK_HEADER_SIZE + (uint64_t)frame_count * DFF_INDEX_ENTRY_SIZE;
+    layout->id3_size = id3_size;
+    if (id3_size > 0) {
+        layout->id3_offset = pos + VFS_DFF_CHUNK_HEADER_SIZE;
+        pos = layout->id3_offset + id3_size + (id3_size & 1);
+    } else {
+        layout->id3_offset = pos;
+    }
+    layout->total_size = pos;
+
+    _generate_header(layout, channel_count, sample_rate);
+    return layout;
+}
+
+void _vfs_dff_layout_free(vfs_dff_layout_t *layout)
+{
+    if (!layout) {
+        return;
+    }
+    sa_free(layout->frame_pos);
+    sa_free(layout);
+}
+
+/* =============================================================================
+ * Byte Ranges
+ * ===========================================================================*/
+
+/** Frame whose DSTF chunk holds @p offset (header_size <= offset < data_end) */
+static uint32_t _find_chunk(const vfs_dff_layout_t *layout, uint64_t offset)
+{
+    uint32_t lo = 0;
+    uint32_t hi = layout->frame_count - 1;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo + 1) / 2;
+        if (layout->frame_pos[mid] - VFS_DFF_CHUNK_HEADER_SIZE <= offset) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
+
+bool _vfs_dff_find_payload(const vfs_dff_layout_t *layout, uint64_t offset,
+                           uint32_t *frame, uint32_t *within)
+{
+    if (offset < layout->header_size || offset >= layout->data_end) {
+        return false;
+    }
+
+    uint32_t i = _find_chunk(layout, offset);
+    if (offset < layout->frame_pos[i] ||
+        offset >= layout->frame_pos[i] + layout->frame_size[i]) {
+        return false;
+    }
+
+    *frame = i;
+    *within = (uint32_t)(offset - layout->frame_pos[i]);
+    return true;
+}
+
+size_t _vfs_dff_read_structure(const vfs_dff_layout_t *layout, uint64_t offset,
+                               uint8_t *buffer, size_t size)
+{
+    uint64_t index_end = layout->data_end + VFS_DFF_CHUNK_HEADER_SIZE +
+                         (uint64_t)layout->frame_count * DFF_INDEX_ENTRY_SIZE;
+    size_t copied = 0;
+
+    while (copied < size && offset < layout->total_size) {
+        uint8_t piece[VFS_DFF_CHUNK_HEADER_SIZE];
+        const uint8_t *src = piece;
+        uint64_t start;
+        size_t len;
+
+        if (offset < layout->header_size) {
+            src = layout->header;
+            start = 0;
+            len = layout->header_size;
+        } else if (offset < layout->data_end) {
+            uint32_t i = _find_chunk(layout, offset);
+            uint64_t payload_end = layout->frame_pos[i] + layout->frame_size[i];
+
+            if (offset < layout->frame_pos[i]) {
+                start = layout->frame_pos[i] - VFS_DFF_CHUNK_HEADER_SIZE;
+                len = VFS_DFF_CHUNK_HEADER_SIZE;
+                _put_chunk(piece, "DSTF", layout->frame_size[i]);
+            } else if (offset < payload_end) {
+                break;
+            } else {
+                start = payload_end;
+                len = 1;
+                piece[0] = 0;
+            }
+        } else if (offset < index_end) {
+            if (offset < layout->data_end + VFS_DFF_CHUNK_HEADER_SIZE) {
+                start = layout->data_end;
+                len = VFS_DFF_CHUNK_HEADER_SIZE;
+                _put_chunk(piece, "DSTI",
+                           (uint64_t)layout->frame_count * DFF_INDEX_ENTRY_SIZE);
+            } else {
+                uint64_t entry = (offset - layout->data_end - VFS_DFF_CHUNK_HEADER_SIZE) /
+                                 DFF_INDEX_ENTRY_SIZE;
+                start = layout->data_end + VFS_DFF_CHUNK_HEADER_SIZE +
+                        entry * DFF_INDEX_ENTRY_SIZE;
+                len = DFF_INDEX_ENTRY_SIZE;
+                SA_WB64(piece, layout->frame_pos[entry]);
+                SA_WB32(piece + 8, layout->frame_size[entry]);
+            }
+        } else if (offset < layout->id3_offset) {
+            start = layout->id3_offset - VFS_DFF_CHUNK_HEADER_SIZE;
+            len = VFS_DFF_CHUNK_HEADER_SIZE;
+            _put_chunk(piece, "ID3 ", layout->id3_size);
+        } else if (offset < layout->id3_offset + layout->id3_size) {
+            break;
+        } else {
+            start = layout->id3_offset + layout->id3_size;
+            len = 1;
+            piece[0] = 0;
+        }
+
+        size_t n = (size_t)(start + len - offset);
+        if (n > size - copied) {
+            n = size - copied;
+        }
+        memcpy(buffer + copied, src + (offset - start), n);
+        copied += n;
+        offset += n;
+    }
+
+    return copied;
+}
@@ -0,0 +1,124 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Virtual DSDIFF/DST files - Internal Header
+ * Layout of a track served as a DSDIFF file that carries the disc's DST
+ * frames unchanged, for players that decode DST themselves.
+ * This header is NOT part of the public API.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBSACDVFS_SACD_VFS_DFF_H
+#define LIBSACDVFS_SACD_VFS_DFF_H
+
+#include <libsacdvfs/sacd_vfs.h>
+#include <libsacd/sacd.h>
+
+/** Size of an IFF chunk header (ID + 64-bit size) */
+#define VFS_DFF_CHUNK_HEADER_SIZE   12
+
+/** FRM8 up to and including the FRTE chunk, for up to 6 channels */
+#define VFS_DFF_HEADER_MAX          192
+
+/** A DST frame holding plain DSD (DST_X_Bit 0): a zero byte, then the data */
+#define VFS_DFF_PLAIN_FRAME_SIZE(channel_count) \
+    (1 + SACD_FRAME_SIZE_64 * (uint32_t)(channel_count))
+
+/** DSD silence in the MSB-first bit order of DSDIFF */
+#define VFS_DFF_SILENCE             0x69
+
+/**
+ * Layout of one virtual DSDIFF/DST file:
+ *
+ *   FRM8 'DSD '
+ *     FVER, PROP 'SND ' (FS, CHNL, CMPR 'DST ')
+ *     DST  (FRTE, one DSTF chunk per frame)
+ *     DSTI (offset and length of every frame)
+ *     'ID3 ' (only if the track has a tag)
+ *
+ * Everything but the frame payloads and the ID3 tag is synthesized from
+ * the frame size table.
+ */
+typedef struct {
+    uint32_t frame_count;
+    const uint32_t *frame_size;     /* Borrowed: DST frame sizes */
+    uint64_t *frame_pos;            /* File offset of each frame's payload */
+    uint64_t data_end;              /* End of the DST chunk */
+    uint64_t id3_offset;            /* File offset of the ID3 tag */
+    uint64_t id3_size;              /* 0 if the track has no tag */
+    uint64_t total_size;
+    size_t header_size;             /* FRM8 through FRTE */
+    uint8_t header[VFS_DFF_HEADER_MAX];
+} vfs_dff_layout_t;
+
+/**
+ * @brief Read the size of every DST frame of a track.
+ *
+ * The frames are read but not decoded. If the audio ends before the track
+ * does (see audio_early_eof in sacd_vfs.c), the missing frames are given
+ * the size of a plain frame of silence.
+ *
+ * @param reader         Reader with the track's area selected
+ * @param start_frame    First frame of the track
+ * @param frame_count    Frames in the track
+ * @param channel_count  Channels, for the size of a silent frame
+ * @param frame_size     Receives the table (sa_free it), NULL if frame_count is 0
+ * @param frames_found   Receives the number of frames read from the disc
+ * @return SACD_VFS_OK on success
+ */
+int _vfs_dff_scan_frames(sacd_t *reader, uint32_t start_frame,
+                         uint32_t frame_count, uint32_t channel_count,
+                         uint32_t **frame_size, uint32_t *frames_found);
+
+/**
+ * @brief Lay out a track.
+ *
+ * @param frame_size     Frame size table (borrowed, must outlive the layout)
+ * @param frame_count    Frames in the track
+ * @param channel_count  Channels (1 to 6)
+ * @param sample_rate    DSD sample rate in Hz
+ * @param id3_size       Size of the track's ID3 tag, 0 if none
+ * @return New layout or NULL on failure
+ */
+vfs_dff_layout_t *_vfs_dff_layout_create(const uint32_t *frame_size,
+                                         uint32_t frame_count,
+                                         uint32_t channel_count,
+                                         uint32_t sample_rate,
+                                         size_t id3_size);
+
+void _vfs_dff_layout_free(vfs_dff_layout_t *layout);
+
+/**
+ * @brief Find the frame payload holding a file offset.
+ *
+ * @param frame   Receives the frame index within the track
+ * @param within  Receives the offset into the frame payload
+ * @return true if @p offset is frame payload
+ */
+bool _vfs_dff_find_payload(const vfs_dff_layout_t *layout, uint64_t offset,
+                           uint32_t *frame, uint32_t *within);
+
+/**
+ * @brief Copy synthesized bytes from @p offset on.
+ *
+ * Stops at the next frame payload, at the ID3 tag or at the end of file.
+ *
+ * @return Bytes copied, 0 if @p offset is frame payload, tag or EOF
+ */
+size_t _vfs_dff_read_structure(const vfs_dff_layout_t *layout, uint64_t offset,
+                               uint8_t *buffer, size_t size);
+
+#endif /* LIBSACDVFS_SACD_VFS_DFF_H */
@@ -0,0 +1,790 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief On-disk transcode cache for virtual DSF files.
+ * Decoded DSF block groups of DST tracks are kept below a cache directory,
+ * one directory per ISO (named after a hash of its path) holding:
+ *
+ *   iso.info   Path, size and modification time of the ISO
+ *   s001.dat   Audio data of stereo track 1, block group N at offset
+ *              N * group size; blocks not decoded yet are holes
+ *   s001.map   16 byte header, then one byte per block group (1 = present)
+ *
+ * Whole tracks are deleted in least-recently-used order to stay within the
+ * byte budget. The files are picked up again on the next start.
+ *
+ * The cache lock guards the track list, block maps and byte counts. Block
+ * data is read and written under a per-track lock only, with the track
+ * pinned so it cannot be evicted meanwhile.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sacd_vfs_cache.h"
+
+#include <libsautil/mem.h>
+#include <libsautil/compat.h>
+#include <libsautil/intreadwrite.h>
+#include <libsautil/sastring.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <direct.h>
+#else
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+#ifdef __APPLE__
+#include <libsautil/c11threads.h>
+#else
+#include <threads.h>
+#endif
+
+#define DISK_CACHE_INFO_NAME    "iso.info"
+#define DISK_CACHE_MAP_MAGIC    "SVDC"
+#define DISK_CACHE_MAP_VERSION  1
+#define DISK_CACHE_MAP_HEADER   16
+#define DISK_CACHE_DIR_LEN      16      /* Hex digits of the path hash */
+
+/** Block map states; only DISK_BLOCK_PRESENT is ever written to disk */
+#define DISK_BLOCK_ABSENT   0
+#define DISK_BLOCK_PRESENT  1
+#define DISK_BLOCK_WRITING  2
+
+/** One cached track: a sparse data file and its block map */
+typedef struct disk_track {
+    char dir[DISK_CACHE_DIR_LEN + 1];   /* ISO directory */
+    uint8_t area;                       /* sacd_vfs_area_t */
+    uint8_t track;                      /* Track number (1-based) */
+    uint32_t iso;                       /* ISO id while attached, else 0 */
+    uint32_t group_size;                /* Block group size from the map */
+    uint64_t bytes;                     /* Block data held */
+    uint64_t last_use;                  /* time() of the last read or write */
+
+    /* Loaded on first use while the ISO is attached */
+    FILE *data;
+    FILE *map;
+    uint8_t *valid;                     /* One DISK_BLOCK_* per block group */
+    uint32_t valid_len;
+    uint32_t valid_size;                /* Allocated bytes in valid */
+    bool touched;                       /* Refresh map mtime on unload */
+
+    mtx_t io;                           /* Serializes access to data and map */
+    int pins;                           /* Reads and writes in progress */
+
+    struct disk_track *next;
+} disk_track_t;
+
+/** An attached ISO */
+typedef struct disk_iso {
+    uint32_t id;
+    int refs;                           /* Attached VFS contexts */
+    char dir[DISK_CACHE_DIR_LEN + 1];
+    struct disk_iso *next;
+} disk_iso_t;
+
+/** On-disk transcode cache */
+struct sacd_vfs_disk_cache {
+    mtx_t lock;                         /* Protects everything below */
+    char root[SACD_VFS_MAX_PATH];
+    disk_track_t *tracks;               /* Every track on disk */
+    disk_iso_t *isos;                   /* Attached ISOs */
+    uint32_t next_iso;                  /* Last ISO id handed out */
+    uint32_t files;                     /* Tracks on disk */
+    uint64_t bytes;
+    uint64_t max_bytes;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t writes;
+    uint64_t evictions;
+};
+
+/* =============================================================================
+ * File System Helpers
+ * ===========================================================================*/
+
+static int _disk_mkdir(const char *path)
+{
+#ifdef _WIN32
+    int ret = _mkdir(path);
+#else
+    int ret = mkdir(path, 0755);
+#endif
+    return (ret == 0 || errno == EEXIST) ? 0 : -1;
+}
+
+typedef void (*disk_list_callback_t)(const char *name, void *userdata);
+
+/**
+ * @brief Call @p callback for each entry of a directory except . and ..
+ */
+static int _disk_list_dir(const char *path, disk_list_callback_t callback,
+                          void *userdata)
+{
+#ifdef _WIN32
+    char search_path[SACD_VFS_MAX_PATH];
+    snprintf(search_path, sizeof(search_path), "%s\\*", path);
+
+    WIN32_FIND_DATAA find_data;
+    HANDLE hFind = FindFirstFileA(search_path, &find_data);
+    if (hFind == INVALID_HANDLE_VALUE) {
+        return -1;
+    }
+    do {
+        if (strcmp(find_data.cFileName, ".") != 0 &&
+            strcmp(find_data.cFileName, "..") != 0) {
+            callback(find_data.cFileName, userdata);
+        }
+    } while (FindNextFileA(hFind, &find_data));
+    FindClose(hFind);
+    return 0;
+#else
+    DIR *dir = opendir(path);
+    if (!dir) {
+        return -1;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
+            callback(entry->d_name, userdata);
+        }
+    }
+    closedir(dir);
+    return 0;
+#endif
+}
+
+static void _track_path(const sacd_vfs_disk_cache_t *cache, const disk_track_t *t,
+                        const char *ext, char *path, size_t size)
+{
+    snprintf(path, size, "%s/%s/%c%03u.%s", cache->root, t->dir,
+             t->area == SACD_VFS_AREA_MULTICHANNEL ? 'm' : 's',
+             (unsigned)t->track, ext);
+}
+
+/**
+ * @brief Directory name of an ISO: 64-bit FNV-1a hash of its path.
+ */
+static void _iso_dir_name(const char *iso_path, char *dir)
+{
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (const unsigned char *p = (const unsigned char *)iso_path; *p; p++) {
+        h ^= *p;
+        h *= 0x100000001B3ull;
+    }
+    snprintf(dir, DISK_CACHE_DIR_LEN + 1, "%016llx", (unsigned long long)h);
+}
+
+/* =============================================================================
+ * Track Management (lock held)
+ * ===========================================================================*/
+
+static disk_track_t *_find_track(sacd_vfs_disk_cache_t *cache,
+                                 const vfs_block_key_t *key)
+{
+    for (disk_track_t *t = cache->tracks; t; t = t->next) {
+        if (t->iso == key->owner && t->area == key->area && t->track == key->track) {
+            return t;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Close the files of a track and free its block map.
+ */
+static void _unload_track(disk_track_t *t)
+{
+    if (t->map && t->touched) {
+        /* Rewriting the magic moves the map's mtime, which orders the
+         * tracks for eviction after a restart */
+        if (sa_fseek64(t->map, 0, SEEK_SET) == 0) {
+            fwrite(DISK_CACHE_MAP_MAGIC, 1, 4, t->map);
+        }
+    }
+    if (t->data) {
+        fclose(t->data);
+        t->data = NULL;
+    }
+    if (t->map) {
+        fclose(t->map);
+        t->map = NULL;
+    }
+    sa_free(t->valid);
+    t->valid = NULL;
+    t->valid_len = 0;
+    t->valid_size = 0;
+    t->touched = false;
+}
+
+static disk_track_t *_new_track(void)
+{
+    disk_track_t *t = sa_mallocz(sizeof(*t));
+    if (t && mtx_init(&t->io, mtx_plain) != thrd_success) {
+        sa_free(t);
+        t = NULL;
+    }
+    return t;
+}
+
+static void _free_track(disk_track_t *t)
+{
+    _unload_track(t);
+    mtx_destroy(&t->io);
+    sa_free(t);
+}
+
+/**
+ * @brief Delete a track from disk and from the list.
+ */
+static void _drop_track(sacd_vfs_disk_cache_t *cache, disk_track_t *t)
+{
+    char path[SACD_VFS_MAX_PATH];
+    disk_track_t **link = &cache->tracks;
+
+    while (*link != t) {
+        link = &(*link)->next;
+    }
+    *link = t->next;
+
+    _unload_track(t);
+    _track_path(cache, t, "map", path, sizeof(path));
+    sa_unlink(path);
+    _track_path(cache, t, "dat", path, sizeof(path));
+    sa_unlink(path);
+
+    cache->bytes -= t->bytes;
+    cache->files--;
+    _free_track(t);
+}
+
+static bool _grow_valid(disk_track_t *t, uint32_t len)
+{
+    if (len > t->valid_size) {
+        uint32_t size = t->valid_size ? t->valid_size : 1024;
+        while (size < len) {
+            size *= 2;
+        }
+        uint8_t *valid = sa_realloc(t->valid, size);
+        if (!valid) {
+            return false;
+        }
+        memset(valid + t->valid_size, 0, size - t->valid_size);
+        t->valid = valid;
+        t->valid_size = size;
+    }
+    if (len > t->valid_len) {
+        t->valid_len = len;
+    }
+    return true;
+}
+
+/**
+ * @brief Read a map file: group size, block map and bytes held.
+ *
+ * @return 0 on success, -1 if the file is missing or not a map
+ */
+static int _read_map(FILE *f, disk_track_t *t, bool keep_map)
+{
+    uint8_t header[DISK_CACHE_MAP_HEADER];
+    uint8_t buf[4096];
+    uint32_t block = 0;
+    size_t n;
+
+    if (sa_fseek64(f, 0, SEEK_SET) != 0 ||
+        fread(header, 1, sizeof(header), f) != sizeof(header) ||
+        memcmp(header, DISK_CACHE_MAP_MAGIC, 4) != 0 ||
+        SA_RL32(header + 4) != DISK_CACHE_MAP_VERSION ||
+        SA_RL32(header + 8) == 0) {
+        return -1;
+    }
+    t->group_size = SA_RL32(header + 8);
+    t->bytes = 0;
+
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        if (keep_map) {
+            if (!_grow_valid(t, block + (uint32_t)n)) {
+                return -1;
+            }
+            memcpy(t->valid + block, buf, n);
+        }
+        for (size_t i = 0; i < n; i++) {
+            if (buf[i]) {
+                t->bytes += t->group_size;
+            }
+        }
+        block += (uint32_t)n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Open the files of a track of an attached ISO, creating them for
+ * a track not on disk yet (@p group_size non-zero).
+ */
+static int _load_track(sacd_vfs_disk_cache_t *cache, disk_track_t *t,
+                       uint32_t group_size)
+{
+    char path[SACD_VFS_MAX_PATH];
+
+    if (t->map) {
+        return 0;
+    }
+
+    if (group_size) {
+        uint8_t header[DISK_CACHE_MAP_HEADER] = { 0 };
+
+        _track_path(cache, t, "dat", path, sizeof(path));
+        t->data = sa_fopen(path, "wb+");
+        _track_path(cache, t, "map", path, sizeof(path));
+        t->map = sa_fopen(path, "wb+");
+        if (!t->data || !t->map) {
+            return -1;
+        }
+        memcpy(header, DISK_CACHE_MAP_MAGIC, 4);
+        SA_WL32(header + 4, DISK_CACHE_MAP_VERSION);
+        SA_WL32(header + 8, group_size);
+        if (fwrite(header, 1, sizeof(header), t->map) != sizeof(header)) {
+            return -1;
+        }
+        t->group_size = group_size;
+        return 0;
+    }
+
+    _track_path(cache, t, "dat", path, sizeof(path));
+    t->data = sa_fopen(path, "rb+");
+    _track_path(cache, t, "map", path, sizeof(path));
+    t->map = sa_fopen(path, "rb+");
+    if (!t->data || !t->map) {
+        return -1;
+    }
+
+    /* The map was counted at startup; only the byte count is re-read */
+    uint64_t bytes = t->bytes;
+    if (_read_map(t->map, t, true) != 0) {
+        t->bytes = bytes;
+        return -1;
+    }
+    cache->bytes = cache->bytes - bytes + t->bytes;
+    return 0;
+}
+
+/**
+ * @brief Delete least recently used tracks until @p needed more bytes fit.
+ *
+ * Tracks with reads or writes in progress are left alone.
+ */
+static bool _make_room(sacd_vfs_disk_cache_t *cache, uint64_t needed,
+                       const disk_track_t *keep)
+{
+    while (cache->bytes + needed > cache->max_bytes) {
+        disk_track_t *lru = NULL;
+        for (disk_track_t *t = cache->tracks; t; t = t->next) {
+            if (t != keep && t->pins == 0 && t->bytes > 0 &&
+                (!lru || t->last_use < lru->last_use)) {
+                lru = t;
+            }
+        }
+        if (!lru) {
+            return false;
+        }
+        _drop_track(cache, lru);
+        cache->evictions++;
+    }
+    return true;
+}
+
+/* =============================================================================
+ * Startup Scan
+ * ===========================================================================*/
+
+typedef struct {
+    sacd_vfs_disk_cache_t *cache;
+    const char *dir;
+} scan_ctx_t;
+
+static void _scan_track_file(const char *name, void *userdata)
+{
+    scan_ctx_t *scan = (scan_ctx_t *)userdata;
+    sacd_vfs_disk_cache_t *cache = scan->cache;
+    unsigned track;
+    char ext[4];
+    char kind;
+
+    /* [sm]NNN.map */
+    if (strlen(name) != 8 ||
+        sscanf(name, "%c%3u.%3s", &kind, &track, ext) != 3 ||
+        (kind != 's' && kind != 'm') || strcmp(ext, "map") != 0 ||
+        track == 0 || track > 255) {
+        return;
+    }
+
+    disk_track_t *t = _new_track();
+    if (!t) {
+        return;
+    }
+    sa_strlcpy(t->dir, scan->dir, sizeof(t->dir));
+    t->area = (uint8_t)(kind == 'm' ? SACD_VFS_AREA_MULTICHANNEL : SACD_VFS_AREA_STEREO);
+    t->track = (uint8_t)track;
+
+    char path[SACD_VFS_MAX_PATH];
+    struct stat st;
+    _track_path(cache, t, "map", path, sizeof(path));
+    FILE *f = sa_fopen(path, "rb");
+    if (!f || stat(path, &st) != 0 || _read_map(f, t, false) != 0) {
+        if (f) {
+            fclose(f);
+        }
+        _free_track(t);
+        return;
+    }
+    fclose(f);
+
+    t->last_use = (uint64_t)st.st_mtime;
+    t->next = cache->tracks;
+    cache->tracks = t;
+    cache->bytes += t->bytes;
+    cache->files++;
+}
+
+static void _scan_iso_dir(const char *name, void *userdata)
+{
+    sacd_vfs_disk_cache_t *cache = (sacd_vfs_disk_cache_t *)userdata;
+    char path[SACD_VFS_MAX_PATH];
+
+    if (strlen(name) != DISK_CACHE_DIR_LEN ||
+        strspn(name, "0123456789abcdef") != DISK_CACHE_DIR_LEN) {
+        return;
+    }
+
+    scan_ctx_t scan = { cache, name };
+    snprintf(path, sizeof(path), "%s/%s", cache->root, name);
+    _disk_list_dir(path, _scan_track_file, &scan);
+}
+
+/* =============================================================================
+ * Public API
+ * ===========================================================================*/
+
+sacd_vfs_disk_cache_t *sacd_vfs_disk_cache_create(const char *dir, uint64_t max_bytes)
+{
+    sacd_vfs_disk_cache_t *cache;
+
+    if (!dir || !*dir || max_bytes == 0 || strlen(dir) >= SACD_VFS_MAX_PATH - 32) {
+        return NULL;
+    }
+    if (_disk_mkdir(dir) != 0) {
+        return NULL;
+    }
+
+    cache = sa_mallocz(sizeof(*cache));
+    if (!cache) {
+        return NULL;
+    }
+    if (mtx_init(&cache->lock, mtx_plain) != thrd_success) {
+        sa_free(cache);
+        return NULL;
+    }
+
+    sa_strlcpy(cache->root, dir, sizeof(cache->root));
+    size_t len = strlen(cache->root);
+    while (len > 1 && (cache->root[len - 1] == '/' || cache->root[len - 1] == '\\')) {
+        cache->root[--len] = '\0';
+    }
+    cache->max_bytes = max_bytes;
+
+    if (_disk_list_dir(cache->root, _scan_iso_dir, cache) != 0) {
+        sacd_vfs_disk_cache_destroy(cache);
+        return NULL;
+    }
+
+    /* The budget may have shrunk since the files were written */
+    _make_room(cache, 0, NULL);
+    return cache;
+}
+
+void sacd_vfs_disk_cache_destroy(sacd_vfs_disk_cache_t *cache)
+{
+    if (!cache) {
+        return;
+    }
+
+    while (cache->tracks) {
+        disk_track_t *t = cache->tracks;
+        cache->tracks = t->next;
+        _free_track(t);
+    }
+    while (cache->isos) {
+        disk_iso_t *iso = cache->isos;
+        cache->isos = iso->next;
+        sa_free(iso);
+    }
+    mtx_destroy(&cache->lock);
+    sa_free(cache);
+}
+
+int sacd_vfs_disk_cache_get_stats(sacd_vfs_disk_cache_t *cache,
+                                  sacd_vfs_disk_cache_stats_t *stats)
+{
+    if (!cache || !stats) {
+        return SACD_VFS_ERROR_INVALID_PARAMETER;
+    }
+
+    mtx_lock(&cache->lock);
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->writes = cache->writes;
+    stats->evictions = cache->evictions;
+    stats->bytes = cache->bytes;
+    stats->max_bytes = cache->max_bytes;
+    stats->files = cache->files;
+    mtx_unlock(&cache->lock);
+    return SACD_VFS_OK;
+}
+
+/* =============================================================================
+ * Internal API
+ * ===========================================================================*/
+
+uint32_t _vfs_disk_cache_attach(sacd_vfs_disk_cache_t *cache, const char *iso_path)
+{
+    char dir[DISK_CACHE_DIR_LEN + 1];
+    char info[SACD_VFS_MAX_PATH + 64];
+    char path[SACD_VFS_MAX_PATH];
+    struct stat st;
+    uint32_t id = 0;
+
+    if (stat(iso_path, &st) != 0) {
+        return 0;
+    }
+    _iso_dir_name(iso_path, dir);
+    snprintf(info, sizeof(info), "%s\n%llu\n%lld\n", iso_path,
+             (unsigned long long)st.st_size, (long long)st.st_mtime);
+
+    mtx_lock(&cache->lock);
+
+    for (disk_iso_t *iso = cache->isos; iso; iso = iso->next) {
+        if (strcmp(iso->dir, dir) == 0) {
+            iso->refs++;
+            id = iso->id;
+            goto out;
+        }
+    }
+
+    /* Blocks decoded from another version of the ISO are useless */
+    char stored[sizeof(info)] = { 0 };
+    snprintf(path, sizeof(path), "%s/%s/" DISK_CACHE_INFO_NAME, cache->root, dir);
+    FILE *f = sa_fopen(path, "rb");
+    if (f) {
+        size_t n = fread(stored, 1, sizeof(stored) - 1, f);
+        stored[n] = '\0';
+        fclose(f);
+    }
+    if (strcmp(stored, info) != 0) {
+        disk_track_t *t = cache->tracks;
+        while (t) {
+            disk_track_t *next = t->next;
+            if (strcmp(t->dir, dir) == 0) {
+                _drop_track(cache, t);
+            }
+            t = next;
+        }
+
+        snprintf(path, sizeof(path), "%s/%s", cache->root, dir);
+        if (_disk_mkdir(path) != 0) {
+            goto out;
+        }
+        snprintf(path, sizeof(path), "%s/%s/" DISK_CACHE_INFO_NAME, cache->root, dir);
+        f = sa_fopen(path, "wb");
+        if (!f) {
+            goto out;
+        }
+        size_t len = strlen(info);
+        size_t written = fwrite(info, 1, len, f);
+        if (fclose(f) != 0 || written != len) {
+            sa_unlink(path);
+            goto out;
+        }
+    }
+
+    disk_iso_t *iso = sa_mallocz(sizeof(*iso));
+    if (!iso) {
+        goto out;
+    }
+    iso->id = ++cache->next_iso;
+    iso->refs = 1;
+    sa_strlcpy(iso->dir, dir, sizeof(iso->dir));
+    iso->next = cache->isos;
+    cache->isos = iso;
+    id = iso->id;
+
+    for (disk_track_t *t = cache->tracks; t; t = t->next) {
+        if (strcmp(t->dir, dir) == 0) {
+            t->iso = id;
+        }
+    }
+
+out:
+    mtx_unlock(&cache->lock);
+    return id;
+}
+
+void _vfs_disk_cache_detach(sacd_vfs_disk_cache_t *cache, uint32_t id)
+{
+    disk_iso_t **link;
+
+    mtx_lock(&cache->lock);
+    for (link = &cache->isos; *link; link = &(*link)->next) {
+        disk_iso_t *iso = *link;
+        if (iso->id != id) {
+            continue;
+        }
+        if (--iso->refs == 0) {
+            for (disk_track_t *t = cache->tracks; t; t = t->next) {
+                if (t->iso == id) {
+                    _unload_track(t);
+                    t->iso = 0;
+                }
+            }
+            *link = iso->next;
+            sa_free(iso);
+        }
+        break;
+    }
+    mtx_unlock(&cache->lock);
+}
+
+bool _vfs_disk_cache_lookup(sacd_vfs_disk_cache_t *cache,
+                            const vfs_block_key_t *key, uint8_t *dst,
+                            size_t size)
+{
+    bool hit = false;
+
+    mtx_lock(&cache->lock);
+    disk_track_t *t = _find_track(cache, key);
+    if (t && _load_track(cache, t, 0) != 0) {
+        /* Deleted or damaged behind our back */
+        _drop_track(cache, t);
+        t = NULL;
+    }
+    if (!t || t->group_size != size || key->block >= t->valid_len ||
+        t->valid[key->block] != DISK_BLOCK_PRESENT) {
+        cache->misses++;
+        mtx_unlock(&cache->lock);
+        return false;
+    }
+    t->pins++;
+    mtx_unlock(&cache->lock);
+
+    mtx_lock(&t->io);
+    hit = sa_fseek64(t->data, (int64_t)key->block * (int64_t)size, SEEK_SET) == 0 &&
+          fread(dst, 1, size, t->data) == size;
+    mtx_unlock(&t->io);
+
+    mtx_lock(&cache->lock);
+    t->pins--;
+    if (hit) {
+        t->last_use = (uint64_t)time(NULL);
+        t->touched = true;
+        cache->hits++;
+    } else {
+        t->valid[key->block] = DISK_BLOCK_ABSENT;
+        cache->misses++;
+    }
+    mtx_unlock(&cache->lock);
+    return hit;
+}
+
+void _vfs_disk_cache_insert(sacd_vfs_disk_cache_t *cache,
+                            const vfs_block_key_t *key, const uint8_t *src,
+                            size_t size)
+{
+    if (size == 0 || size > cache->max_bytes || size > UINT32_MAX) {
+        return;
+    }
+
+    mtx_lock(&cache->lock);
+
+    disk_track_t *t = _find_track(cache, key);
+    if (t && _load_track(cache, t, 0) != 0) {
+        _drop_track(cache, t);
+        t = NULL;
+    }
+    if (!t) {
+        disk_iso_t *iso = cache->isos;
+        while (iso && iso->id != key->owner) {
+            iso = iso->next;
+        }
+        t = iso ? _new_track() : NULL;
+        if (!t) {
+            goto out;
+        }
+        sa_strlcpy(t->dir, iso->dir, sizeof(t->dir));
+        t->area = key->area;
+        t->track = key->track;
+        t->iso = key->owner;
+        t->next = cache->tracks;
+        cache->tracks = t;
+        cache->files++;
+        if (_load_track(cache, t, (uint32_t)size) != 0) {
+            _drop_track(cache, t);
+            goto out;
+        }
+    }
+
+    if (t->group_size != size ||
+        (key->block < t->valid_len && t->valid[key->block] != DISK_BLOCK_ABSENT) ||
+        !_make_room(cache, size, t) || !_grow_valid(t, key->block + 1)) {
+        goto out;
+    }
+
+    /* Claim the block and its bytes, then write without the cache lock */
+    t->valid[key->block] = DISK_BLOCK_WRITING;
+    t->bytes += size;
+    cache->bytes += size;
+    t->pins++;
+    mtx_unlock(&cache->lock);
+
+    /* Data first, so a present block never maps to a hole */
+    mtx_lock(&t->io);
+    bool written =
+        sa_fseek64(t->data, (int64_t)key->block * (int64_t)size, SEEK_SET) == 0 &&
+        fwrite(src, 1, size, t->data) == size && fflush(t->data) == 0 &&
+        sa_fseek64(t->map, DISK_CACHE_MAP_HEADER + (int64_t)key->block, SEEK_SET) == 0 &&
+        fputc(DISK_BLOCK_PRESENT, t->map) != EOF && fflush(t->map) == 0;
+    mtx_unlock(&t->io);
+
+    mtx_lock(&cache->lock);
+    t->pins--;
+    if (written) {
+        t->valid[key->block] = DISK_BLOCK_PRESENT;
+        t->last_use = (uint64_t)time(NULL);
+        cache->writes++;
+    } else {
+        t->valid[key->block] = DISK_BLOCK_ABSENT;
+        t->bytes -= size;
+        cache->bytes -= size;
+    }
+
+out:
+    mtx_unlock(&cache->lock);
+}
@@ -0,0 +1,36 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief SACD Virtual Filesystem - Internal Header
+ * State of virtual file handles that tests need to observe.
+ * This header is NOT part of the public API.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBSACDVFS_SACD_VFS_INTERNAL_H
+#define LIBSACDVFS_SACD_VFS_INTERNAL_H
+
+#include <libsacdvfs/sacd_vfs.h>
+
+/**
+ * @brief Prefetch window of a file opened with sacd_vfs_file_open_mt().
+ *
+ * @return Frames the MT reader thread may decode ahead of the reads, or 0
+ *         while the pipeline has not been started
+ */
+uint32_t _vfs_file_mt_window(sacd_vfs_file_t *file);
+
+#endif /* LIBSACDVFS_SACD_VFS_INTERNAL_H */
@@ -0,0 +1,206 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Virtual PCM (WAV) renditions
+ * Computes the layout of a track served as a WAV file. The PCM itself is
+ * converted by sacd_vfs.c with libdsdpcm, one SACD frame at a time.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sacd_vfs_pcm.h"
+
+#include <libdsdpcm/dsdpcm.h>
+#include <libsautil/intreadwrite.h>
+
+#include <string.h>
+
+/** SACD sample rate and frame rate */
+#define PCM_DSD_SAMPLE_RATE     2822400
+#define PCM_FRAMES_PER_SEC      75
+
+#define WAV_FORMAT_PCM          0x0001
+#define WAV_FORMAT_EXTENSIBLE   0xFFFE
+
+/** Speaker positions of the SACD channel orders, by channel count */
+static const uint32_t _channel_masks[7] = {
+    0, 0x4, 0x3, 0x7, 0x33, 0x37, 0x3F
+};
+
+/** KSDATAFORMAT_SUBTYPE_PCM */
+static const uint8_t _pcm_guid[16] = {
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+    0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71
+};
+
+bool _vfs_pcm_format_valid(uint32_t sample_rate, uint16_t bits_per_sample)
+{
+    if (bits_per_sample != 16 && bits_per_sample != 24) {
+        return false;
+    }
+    if (sample_rate == 0 || PCM_DSD_SAMPLE_RATE % sample_rate != 0) {
+        return false;
+    }
+    return dsdpcm_decimation_is_valid(
+        (dsdpcm_decimation_t)(PCM_DSD_SAMPLE_RATE / sample_rate)) != 0;
+}
+
+/* =============================================================================
+ * Layout
+ * ===========================================================================*/
+
+static uint8_t *_put_chunk(uint8_t *p, const char *id, uint32_t size)
+{
+    memcpy(p, id, 4);
+    SA_WL32(p + 4, size);
+    return p + VFS_PCM_CHUNK_HEADER_SIZE;
+}
+
+int _vfs_pcm_layout_init(vfs_pcm_layout_t *layout, uint32_t frame_count,
+                         uint32_t channel_count, uint32_t sample_rate,
+                         uint16_t bits_per_sample, size_t id3_size)
+{
+    uint32_t bytes_per_sample = bits_per_sample / 8;
+    uint32_t block_align = channel_count * bytes_per_sample;
+    bool extensible = channel_count > 2 || bits_per_sample > 16;
+    uint32_t fmt_size = extensible ? 40 : 16;
+    uint8_t *p = layout->header;
+
+    memset(layout, 0, sizeof(*layout));
+    layout->frame_count = frame_count;
+    layout->sample_rate = sample_rate;
+    layout->block_samples = sample_rate / PCM_FRAMES_PER_SEC * channel_count;
+    layout->block_size = layout->block_samples * bytes_per_sample;
+    layout->bits_per_sample = bits_per_sample;
+
+    /* RIFF chunks start on even offsets; the pad bytes are not counted in
+     * the chunk sizes */
+    layout->header_size = 12 + VFS_PCM_CHUNK_HEADER_SIZE + fmt_size +
+                          VFS_PCM_CHUNK_HEADER_SIZE;
+    layout->data_offset = layout->header_size;
+    layout->data_size = (uint64_t)frame_count * layout->block_size;
+    layout->total_size = layout->data_offset + layout->data_size +
+                         (layout->data_size & 1);
+    if (id3_size > 0) {
+        layout->id3_offset = layout->total_size + VFS_PCM_CHUNK_HEADER_SIZE;
+        layout->id3_size = id3_size;
+        layout->total_size = layout->id3_offset + id3_size + (id3_size & 1);
+    } else {
+        layout->id3_offset = layout->total_size;
+    }
+
+    if (layout->total_size - 8 > UINT32_MAX) {
+        return SACD_VFS_ERROR_FORMAT;
+    }
+
+    p = _put_chunk(p, "RIFF", (uint32_t)(layout->total_size - 8));
+    memcpy(p, "WAVE", 4);
+    p += 4;
+
+    p = _put_chunk(p, "fmt ", fmt_size);
+    SA_WL16(p, extensible ? WAV_FORMAT_EXTENSIBLE : WAV_FORMAT_PCM);
+    SA_WL16(p + 2, channel_count);
+    SA_WL32(p + 4, sample_rate);
+    SA_WL32(p + 8, sample_rate * block_align);
+    SA_WL16(p + 12, block_align);
+    SA_WL16(p + 14, bits_per_sample);
+    p += 16;
+    if (extensible) {
+        SA_WL16(p, 22);
+        SA_WL16(p + 2, bits_per_sample);
+        SA_WL32(p + 4, channel_count < 7 ? _channel_masks[channel_count] : 0);
+        memcpy(p + 8, _pcm_guid, sizeof(_pcm_guid));
+        p += 24;
+    }
+
+    _put_chunk(p, "data", (uint32_t)layout->data_size);
+
+    return SACD_VFS_OK;
+}
+
+size_t _vfs_pcm_read_structure(const vfs_pcm_layout_t *layout, uint64_t offset,
+                               uint8_t *buffer, size_t size)
+{
+    uint64_t data_end = layout->data_offset + layout->data_size;
+    uint64_t avail;
+
+    if (offset < layout->header_size) {
+        avail = layout->header_size - offset;
+        if (avail > size) {
+            avail = size;
+        }
+        memcpy(buffer, layout->header + offset, (size_t)avail);
+        return (size_t)avail;
+    }
+
+    if (offset >= data_end && offset < layout->id3_offset) {
+        /* Pad byte after the data, then the ID3 chunk header if tagged */
+        uint8_t gap[1 + VFS_PCM_CHUNK_HEADER_SIZE] = { 0 };
+        size_t gap_len = (size_t)(layout->id3_offset - data_end);
+        if (layout->id3_size > 0) {
+            _put_chunk(gap + gap_len - VFS_PCM_CHUNK_HEADER_SIZE, "id3 ",
+                       (uint32_t)layout->id3_size);
+        }
+
+        avail = layout->id3_offset - offset;
+        if (avail > size) {
+            avail = size;
+        }
+        memcpy(buffer, gap + (offset - data_end), (size_t)avail);
+        return (size_t)avail;
+    }
+
+    if (offset >= layout->id3_offset + layout->id3_size &&
+        offset < layout->total_size) {
+        /* Pad byte after the tag */
+        avail = layout->total_size - offset;
+        if (avail > size) {
+            avail = size;
+        }
+        memset(buffer, 0, (size_t)avail);
+        return (size_t)avail;
+    }
+
+    return 0;
+}
+
+/* =============================================================================
+ * Sample Packing
+ * ===========================================================================*/
+
+void _vfs_pcm_pack(const double *src, size_t count, uint16_t bits_per_sample,
+                   uint8_t *dst)
+{
+    if (bits_per_sample == 16) {
+        for (size_t i = 0; i < count; i++) {
+            double val = src[i];
+            if (val > 1.0) val = 1.0;
+            if (val < -1.0) val = -1.0;
+            int32_t s = (int32_t)(val * 32767.0);
+            SA_WL16(dst, (uint16_t)(int16_t)s);
+            dst += 2;
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        double val = src[i];
+        if (val > 1.0) val = 1.0;
+        if (val < -1.0) val = -1.0;
+        int32_t s = (int32_t)(val * 8388607.0);
+        SA_WL24(dst, (uint32_t)s & 0xFFFFFF);
+        dst += 3;
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Virtual PCM (WAV) renditions - Internal Header
+ * Layout of a track served as a WAV file converted from DSD on demand,
+ * for players that cannot play DSD.
+ * This header is NOT part of the public API.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBSACDVFS_SACD_VFS_PCM_H
+#define LIBSACDVFS_SACD_VFS_PCM_H
+
+#include <libsacdvfs/sacd_vfs.h>
+
+/** RIFF, a WAVE_FORMAT_EXTENSIBLE fmt chunk and the data chunk header */
+#define VFS_PCM_HEADER_MAX          68
+
+/** Size of a RIFF chunk header (ID + 32-bit size) */
+#define VFS_PCM_CHUNK_HEADER_SIZE   8
+
+/**
+ * Layout of one virtual WAV file:
+ *
+ *   RIFF 'WAVE'
+ *     fmt   (WAVE_FORMAT_EXTENSIBLE above 2 channels or 16 bits)
+ *     data  (one block of PCM per SACD frame)
+ *     'id3 ' (only if the track has a tag)
+ *
+ * Every SACD frame converts to the same number of PCM samples, so the
+ * size is known without converting anything, and byte offsets map to
+ * frames by a division.
+ */
+typedef struct {
+    uint32_t frame_count;           /* SACD frames, one block each */
+    uint32_t sample_rate;           /* PCM sample rate in Hz */
+    uint32_t block_size;            /* PCM bytes of one frame, all channels */
+    uint32_t block_samples;         /* PCM samples of one frame, all channels */
+    uint16_t bits_per_sample;
+    uint64_t data_offset;           /* Start of the PCM data */
+    uint64_t data_size;
+    uint64_t id3_offset;            /* File offset of the ID3 tag */
+    uint64_t id3_size;              /* 0 if the track has no tag */
+    uint64_t total_size;
+    size_t header_size;             /* RIFF through the data chunk header */
+    uint8_t header[VFS_PCM_HEADER_MAX];
+} vfs_pcm_layout_t;
+
+/**
+ * @brief Whether a rendition setting can be served.
+ *
+ * @param sample_rate      PCM sample rate; must divide the DSD64 rate by
+ *                         a power of two the converter supports
+ * @param bits_per_sample  16 or 24
+ */
+bool _vfs_pcm_format_valid(uint32_t sample_rate, uint16_t bits_per_sample);
+
+/**
+ * @brief Lay out a track.
+ *
+ * @param layout           Layout to fill
+ * @param frame_count      SACD frames in the track
+ * @param channel_count    Channels (1 to 6)
+ * @param sample_rate      PCM sample rate in Hz
+ * @param bits_per_sample  16 or 24
+ * @param id3_size         Size of the track's ID3 tag, 0 if none
+ * @return SACD_VFS_OK, or SACD_VFS_ERROR_FORMAT if the track does not fit
+ *         the 4 GiB limit of a RIFF file
+ */
+int _vfs_pcm_layout_init(vfs_pcm_layout_t *layout, uint32_t frame_count,
+                         uint32_t channel_count, uint32_t sample_rate,
+                         uint16_t bits_per_sample, size_t id3_size);
+
+/**
+ * @brief Copy synthesized bytes from @p offset on.
+ *
+ * Serves the header, the ID3 chunk header and the pad bytes. Stops at the
+ * PCM data, at the ID3 tag or at the end of file.
+ *
+ * @return Bytes copied, 0 if @p offset is PCM data, tag or EOF
+ */
+size_t _vfs_pcm_read_structure(const vfs_pcm_layout_t *layout, uint64_t offset,
+                               uint8_t *buffer, size_t size);
+
+/**
+ * @brief Pack converter output as little-endian integer samples.
+ *
+ * Samples outside [-1.0, 1.0] are clipped.
+ *
+ * @param src              Samples, interleaved by channel
+ * @param count            Samples in @p src, all channels
+ * @param bits_per_sample  16 or 24
+ * @param dst              Receives count * bits_per_sample / 8 bytes
+ */
+void _vfs_pcm_pack(const double *src, size_t count, uint16_t bits_per_sample,
+                   uint8_t *dst);
+
+#endif /* LIBSACDVFS_SACD_VFS_PCM_H */
@@ -0,0 +1,183 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief NEON kernels for dsdinterleave.h
+ * vrbit reverses the bits of each byte; the structured loads and stores
+ * (vld2..vld4, vst2..vst4) do the transpose.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#if ARCH_AARCH64 && HAVE_NEON
+
+#include <stddef.h>
+#include <stdint.h>
+#include <arm_neon.h>
+
+#include "libsautil/cpu.h"
+#include "libsautil/dsdinterleave_internal.h"
+
+static size_t deinterleave1_neon(uint8_t *const *dst, const uint8_t *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16)
+        vst1q_u8(dst[0] + i, vrbitq_u8(vld1q_u8(src + i)));
+    return i;
+}
+
+static size_t interleave1_neon(uint8_t *dst, const uint8_t *const *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16)
+        vst1q_u8(dst + i, vrbitq_u8(vld1q_u8(src[0] + i)));
+    return i;
+}
+
+static size_t deinterleave2_neon(uint8_t *const *dst, const uint8_t *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        uint8x16x2_t v = vld2q_u8(src + 2 * i);
+        vst1q_u8(dst[0] + i, vrbitq_u8(v.val[0]));
+        vst1q_u8(dst[1] + i, vrbitq_u8(v.val[1]));
+    }
+    return i;
+}
+
+static size_t interleave2_neon(uint8_t *dst, const uint8_t *const *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        uint8x16x2_t v;
+        v.val[0] = vrbitq_u8(vld1q_u8(src[0] + i));
+        v.val[1] = vrbitq_u8(vld1q_u8(src[1] + i));
+        vst2q_u8(dst + 2 * i, v);
+    }
+    return i;
+}
+
+static size_t deinterleave3_neon(uint8_t *const *dst, const uint8_t *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        uint8x16x3_t v = vld3q_u8(src + 3 * i);
+        for (int ch = 0; ch < 3; ch++)
+            vst1q_u8(dst[ch] + i, vrbitq_u8(v.val[ch]));
+    }
+    return i;
+}
+
+static size_t interleave3_neon(uint8_t *dst, const uint8_t *const *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        uint8x16x3_t v;
+        for (int ch = 0; ch < 3; ch++)
+            v.val[ch] = vrbitq_u8(vld1q_u8(src[ch] + i));
+        vst3q_u8(dst + 3 * i, v);
+    }
+    return i;
+}
+
+static size_t deinterleave4_neon(uint8_t *const *dst, const uint8_t *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        uint8x16x4_t v = vld4q_u8(src + 4 * i);
+        for (int ch = 0; ch < 4; ch++)
+            vst1q_u8(dst[ch] + i, vrbitq_u8(v.val[ch]));
+    }
+    return i;
+}
+
+static size_t interleave4_neon(uint8_t *dst, const uint8_t *const *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        uint8x16x4_t v;
+        for (int ch = 0; ch < 4; ch++)
+            v.val[ch] = vrbitq_u8(vld1q_u8(src[ch] + i));
+        vst4q_u8(dst + 4 * i, v);
+    }
+    return i;
+}
+
+/* 6 channels: a 3-way 16-bit load splits the frames into channel pairs,
+ * and an unzip of two such loads separates the pair */
+static size_t deinterleave6_neon(uint8_t *const *dst, const uint8_t *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        uint16x8x3_t a = vld3q_u16((const uint16_t *)(src + 6 * i));
+        uint16x8x3_t b = vld3q_u16((const uint16_t *)(src + 6 * i + 48));
+
+        for (int k = 0; k < 3; k++) {
+            uint8x16_t lo = vreinterpretq_u8_u16(a.val[k]);
+            uint8x16_t hi = vreinterpretq_u8_u16(b.val[k]);
+            vst1q_u8(dst[2 * k] + i, vrbitq_u8(vuzp1q_u8(lo, hi)));
+            vst1q_u8(dst[2 * k + 1] + i, vrbitq_u8(vuzp2q_u8(lo, hi)));
+        }
+    }
+    return i;
+}
+
+static size_t interleave6_neon(uint8_t *dst, const uint8_t *const *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        uint16x8x3_t a, b;
+
+        for (int k = 0; k < 3; k++) {
+            uint8x16_t c0 = vrbitq_u8(vld1q_u8(src[2 * k] + i));
+            uint8x16_t c1 = vrbitq_u8(vld1q_u8(src[2 * k + 1] + i));
+            a.val[k] = vreinterpretq_u16_u8(vzip1q_u8(c0, c1));
+            b.val[k] = vreinterpretq_u16_u8(vzip2q_u8(c0, c1));
+        }
+        vst3q_u16((uint16_t *)(dst + 6 * i), a);
+        vst3q_u16((uint16_t *)(dst + 6 * i + 48), b);
+    }
+    return i;
+}
+
+void sa_dsdinterleave_init_aarch64(SADSDInterleaveDSP *dsp, int cpu_flags)
+{
+    if (!(cpu_flags & SA_CPU_FLAG_NEON))
+        return;
+
+    dsp->deinterleave[1] = deinterleave1_neon;
+    dsp->interleave[1]   = interleave1_neon;
+    dsp->deinterleave[2] = deinterleave2_neon;
+    dsp->interleave[2]   = interleave2_neon;
+    dsp->deinterleave[3] = deinterleave3_neon;
+    dsp->interleave[3]   = interleave3_neon;
+    dsp->deinterleave[4] = deinterleave4_neon;
+    dsp->interleave[4]   = interleave4_neon;
+    dsp->deinterleave[6] = deinterleave6_neon;
+    dsp->interleave[6]   = interleave6_neon;
+}
+
+#endif /* ARCH_AARCH64 && HAVE_NEON */
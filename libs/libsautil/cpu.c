@@ -47,6 +47,11 @@
 #if HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#if ARCH_X86 && defined(_MSC_VER)
+#include <intrin.h>
+#elif ARCH_X86 && defined(__GNUC__)
+#include <cpuid.h>
+#endif
 
 #if HAVE_GETAUXVAL || HAVE_ELF_AUX_INFO
 #include <sys/auxv.h>
@@ -107,3 +112,76 @@ int sa_cpu_count(void)
 
     return nb_cpus;
 }
+
+#if ARCH_X86
+static void cpuid(int leaf, int subleaf, unsigned regs[4])
+{
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, leaf, subleaf);
+    for (int i = 0; i < 4; i++)
+        regs[i] = (unsigned)r[i];
+#elif defined(__GNUC__)
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#else
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+#endif
+}
+
+static uint64_t xgetbv0(void)
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#elif defined(__GNUC__)
+    unsigned eax, edx;
+    __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+#else
+    return 0;
+#endif
+}
+
+static int get_cpu_flags_x86(void)
+{
+    unsigned regs[4];
+    int flags = 0;
+
+    cpuid(0, 0, regs);
+    if (regs[0] < 1)
+        return 0;
+    unsigned max_leaf = regs[0];
+
+    cpuid(1, 0, regs);
+    if (regs[2] & (1u << 9))
+        flags |= SA_CPU_FLAG_SSSE3;
+
+    /* AVX2 also needs the OS to save the YMM state (OSXSAVE + XCR0) */
+    if (max_leaf >= 7 && (regs[2] & (1u << 27)) && (xgetbv0() & 0x6) == 0x6) {
+        cpuid(7, 0, regs);
+        if (regs[1] & (1u << 5))
+            flags |= SA_CPU_FLAG_AVX2;
+    }
+
+    return flags;
+}
+#endif
+
+int sa_get_cpu_flags(void)
+{
+    static atomic_int cpu_flags = -1;
+
+    int flags = atomic_load_explicit(&cpu_flags, memory_order_relaxed);
+    if (flags >= 0)
+        return flags;
+
+#if ARCH_X86
+    flags = get_cpu_flags_x86();
+#elif ARCH_AARCH64 && HAVE_NEON
+    flags = SA_CPU_FLAG_NEON;
+#else
+    flags = 0;
+#endif
+
+    atomic_store_explicit(&cpu_flags, flags, memory_order_relaxed);
+    return flags;
+}
@@ -29,4 +29,13 @@
  */
 SACD_API int sa_cpu_count(void);
 
+#define SA_CPU_FLAG_SSSE3   0x0001 ///< Supplemental SSE3 (pshufb)
+#define SA_CPU_FLAG_AVX2    0x0002 ///< AVX2, usable by the OS
+#define SA_CPU_FLAG_NEON    0x0004 ///< ARM Advanced SIMD
+
+/**
+ * @return the SA_CPU_FLAG_* set the running CPU supports, detected once.
+ */
+SACD_API int sa_get_cpu_flags(void);
+
 #endif /* SAUTIL_CPU_H */
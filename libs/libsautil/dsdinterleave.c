@@ -0,0 +1,88 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Byte-interleaved <-> planar DSD conversion with bit reversal
+ * The C loops here handle every channel count and every kernel's tail;
+ * x86/ and aarch64/ fill in kernels for the common layouts.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#ifdef __APPLE__
+#include "c11threads.h"
+#else
+#include <threads.h>
+#endif
+
+#include "cpu.h"
+#include "dsdinterleave.h"
+#include "dsdinterleave_internal.h"
+#include "reverse.h"
+
+static SADSDInterleaveDSP dsp;
+static once_flag dsp_once = ONCE_FLAG_INIT;
+
+static void init_dsp(void)
+{
+    int cpu_flags = sa_get_cpu_flags();
+
+#if ARCH_X86 && HAVE_SSSE3
+    sa_dsdinterleave_init_x86(&dsp, cpu_flags);
+#elif ARCH_AARCH64 && HAVE_NEON
+    sa_dsdinterleave_init_aarch64(&dsp, cpu_flags);
+#else
+    (void)cpu_flags;
+#endif
+}
+
+void sa_dsd_deinterleave_bitrev(uint8_t *const *dst, const uint8_t *src,
+                                size_t n, int channels)
+{
+    size_t done = 0;
+
+    call_once(&dsp_once, init_dsp);
+    if (channels <= SA_DSD_KERNEL_MAX_CHANNELS && dsp.deinterleave[channels])
+        done = dsp.deinterleave[channels](dst, src, n);
+
+    for (int ch = 0; ch < channels; ch++) {
+        uint8_t *d = dst[ch];
+        const uint8_t *s = src + done * (size_t)channels + (size_t)ch;
+
+        for (size_t i = done; i < n; i++, s += channels)
+            d[i] = ff_reverse[*s];
+    }
+}
+
+void sa_dsd_interleave_bitrev(uint8_t *dst, const uint8_t *const *src,
+                              size_t n, int channels)
+{
+    size_t done = 0;
+
+    call_once(&dsp_once, init_dsp);
+    if (channels <= SA_DSD_KERNEL_MAX_CHANNELS && dsp.interleave[channels])
+        done = dsp.interleave[channels](dst, src, n);
+
+    for (int ch = 0; ch < channels; ch++) {
+        const uint8_t *s = src[ch];
+        uint8_t *d = dst + done * (size_t)channels + (size_t)ch;
+
+        for (size_t i = done; i < n; i++, d += channels)
+            *d = ff_reverse[s[i]];
+    }
+}
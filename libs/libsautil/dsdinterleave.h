@@ -0,0 +1,56 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Byte-interleaved <-> planar DSD conversion with bit reversal
+ * DSDIFF and SACD store DSD byte-interleaved and MSB-first, DSF stores it
+ * in per-channel blocks and LSB-first. Every byte of every DSF that is
+ * written or read crosses one of these two functions, so they dispatch to
+ * SIMD kernels picked for the running CPU.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SAUTIL_DSDINTERLEAVE_H
+#define SAUTIL_DSDINTERLEAVE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "export.h"
+
+/**
+ * Split byte-interleaved DSD into channel planes, bit-reversing each byte:
+ * dst[ch][i] = reverse(src[i * channels + ch]) for 0 <= i < n.
+ *
+ * @param dst      One output pointer per channel, n bytes each
+ * @param src      n * channels interleaved bytes
+ * @param n        Bytes per channel
+ * @param channels Channel count (>= 1)
+ */
+SACD_API void sa_dsd_deinterleave_bitrev(uint8_t *const *dst, const uint8_t *src,
+                                         size_t n, int channels);
+
+/**
+ * Merge channel planes into byte-interleaved DSD, bit-reversing each byte:
+ * dst[i * channels + ch] = reverse(src[ch][i]) for 0 <= i < n.
+ *
+ * @param dst      n * channels output bytes
+ * @param src      One input pointer per channel, n bytes each
+ * @param n        Bytes per channel
+ * @param channels Channel count (>= 1)
+ */
+SACD_API void sa_dsd_interleave_bitrev(uint8_t *dst, const uint8_t *const *src,
+                                       size_t n, int channels);
+
+#endif /* SAUTIL_DSDINTERLEAVE_H */
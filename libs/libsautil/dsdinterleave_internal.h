@@ -0,0 +1,48 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Kernel table behind dsdinterleave.h
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SAUTIL_DSDINTERLEAVE_INTERNAL_H
+#define SAUTIL_DSDINTERLEAVE_INTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Highest channel count with a specialised kernel slot */
+#define SA_DSD_KERNEL_MAX_CHANNELS 6
+
+/**
+ * Kernels convert a prefix of the input and return how many bytes per
+ * channel they handled; the C loop finishes the tail.
+ */
+typedef size_t (*sa_dsd_deinterleave_fn)(uint8_t *const *dst, const uint8_t *src,
+                                         size_t n);
+typedef size_t (*sa_dsd_interleave_fn)(uint8_t *dst, const uint8_t *const *src,
+                                       size_t n);
+
+typedef struct SADSDInterleaveDSP {
+    /** Indexed by channel count; NULL slots use the C loop only */
+    sa_dsd_deinterleave_fn deinterleave[SA_DSD_KERNEL_MAX_CHANNELS + 1];
+    sa_dsd_interleave_fn interleave[SA_DSD_KERNEL_MAX_CHANNELS + 1];
+} SADSDInterleaveDSP;
+
+void sa_dsdinterleave_init_x86(SADSDInterleaveDSP *dsp, int cpu_flags);
+void sa_dsdinterleave_init_aarch64(SADSDInterleaveDSP *dsp, int cpu_flags);
+
+#endif /* SAUTIL_DSDINTERLEAVE_INTERNAL_H */
@@ -38,6 +38,9 @@ static void sa_tpool_process_detach_locked(sa_tpool *p, sa_tpool_process *q);
 static void sa_tpool_process_shutdown_locked(sa_tpool_process *q);
 static void wake_next_worker(sa_tpool_process *q, int locked);
 
+/* Virtual time a job costs a queue of weight 1 */
+#define SA_TPOOL_VTIME_UNIT 720720
+
 /* ============================================================================
  * Platform-specific helpers
  * ========================================================================== */
@@ -272,10 +275,30 @@ void *sa_tpool_result_data(sa_tpool_result *r)
     return r->data;
 }
 
+/* Sets the scheduling options -- must be called with pool_m held */
+static void sa_tpool_process_set_opts_locked(sa_tpool_process *q,
+                                             const sa_tpool_process_opts *opts)
+{
+    q->priority  = opts ? opts->priority : 0;
+    q->weight    = opts && opts->weight > 0 ? opts->weight : 1;
+    q->low_water = opts && opts->low_water > 0 ? opts->low_water : 0;
+}
+
+void sa_tpool_process_set_opts(sa_tpool_process *q,
+                               const sa_tpool_process_opts *opts)
+{
+    mtx_lock(&q->p->pool_m);
+    sa_tpool_process_set_opts_locked(q, opts);
+    if (q->input_head && !q->shutdown && q->prev && q->next)
+        wake_next_worker(q, 1);
+    mtx_unlock(&q->p->pool_m);
+}
+
 /*
  * Initializes a thread process-queue.
  */
-sa_tpool_process *sa_tpool_process_init(sa_tpool *p, int qsize, int in_only)
+sa_tpool_process *sa_tpool_process_init(sa_tpool *p, int qsize, int in_only,
+                                        const sa_tpool_process_opts *opts)
 {
     sa_tpool_process *q = sa_malloc(sizeof(*q));
     if (!q)
@@ -302,6 +325,8 @@ sa_tpool_process *sa_tpool_process_init(sa_tpool *p, int qsize, int in_only)
     q->shutdown    = 0;
     q->wake_dispatch = 0;
     q->ref_count   = 1;
+    q->vtime       = 0;
+    sa_tpool_process_set_opts_locked(q, opts);
 
     q->next        = NULL;
     q->prev        = NULL;
@@ -396,12 +421,44 @@ void sa_tpool_process_detach(sa_tpool *p, sa_tpool_process *q)
  * The thread pool
  * ========================================================================== */
 
+/* True if q has input and room to store its result */
+static int sa_tpool_process_runnable(const sa_tpool_process *q)
+{
+    return q->input_head && q->qsize - q->n_output > q->n_processing
+        && !q->shutdown;
+}
+
+/* True if q is below its low-water mark, i.e. its consumer may soon wait */
+static int sa_tpool_process_running_dry(const sa_tpool_process *q)
+{
+    return q->low_water > 0 && q->n_output + q->n_processing < q->low_water;
+}
+
+/*
+ * Returns true if a should be served before b: queues running dry first,
+ * then higher priorities, then the lower virtual time.
+ */
+static int sa_tpool_process_before(const sa_tpool_process *a,
+                                   const sa_tpool_process *b)
+{
+    int a_dry = sa_tpool_process_running_dry(a);
+    int b_dry = sa_tpool_process_running_dry(b);
+
+    if (a_dry != b_dry)
+        return a_dry;
+    if (a->priority != b->priority)
+        return a->priority > b->priority;
+    return a->vtime < b->vtime;
+}
+
 /*
  * A worker thread.
  *
- * Each thread checks each process-queue in the pool in turn, looking for
- * input jobs that also have room for output. If found, we execute and repeat.
- * If nothing found, we wait on our per-worker condition variable.
+ * Each thread checks every process-queue in the pool for input jobs that
+ * also have room for output, and runs one job of the queue that should be
+ * served first (see sa_tpool_process_before). It then chooses again, as the
+ * job may have changed which queue comes first. If nothing is found, we
+ * wait on our per-worker condition variable.
  */
 static int tpool_worker(void *arg)
 {
@@ -413,21 +470,20 @@ static int tpool_worker(void *arg)
     while (!p->shutdown) {
         assert(p->q_head == NULL || (p->q_head->prev && p->q_head->next));
 
-        int work_to_do = 0;
-        sa_tpool_process *first = p->q_head, *q = first;
-        do {
-            /* Iterate over queues, finding one with jobs and room for output */
-            if (q && q->input_head
-                && q->qsize - q->n_output > q->n_processing
-                && !q->shutdown) {
-                work_to_do = 1;
-                break;
-            }
-
-            if (q) q = q->next;
-        } while (q && q != first);
+        /* Iterate over queues, finding the best one with jobs and room for
+         * output. Ties go to the first found, starting from q_head. */
+        sa_tpool_process *first = p->q_head, *q = first, *best = NULL;
+        if (q) {
+            do {
+                if (sa_tpool_process_runnable(q)
+                    && (!best || sa_tpool_process_before(q, best)))
+                    best = q;
+                q = q->next;
+            } while (q != first);
+        }
+        q = best;
 
-        if (!work_to_do) {
+        if (!q) {
             /* No work available -- wait */
             p->nwaiting++;
 
@@ -452,48 +508,46 @@ static int tpool_worker(void *arg)
             continue;
         }
 
-        /* Process as many items in this queue as possible */
+        /* Process one item of this queue */
         q->ref_count++;
-        while (q->input_head && q->qsize - q->n_output > q->n_processing) {
-            if (p->shutdown)
-                goto shutdown;
+        j = q->input_head;
+        assert(j->p == p);
 
-            if (q->shutdown)
-                break;
+        if (!(q->input_head = j->next))
+            q->input_tail = NULL;
 
-            j = q->input_head;
-            assert(j->p == p);
+        q->n_processing++;
+        if (q->n_input-- >= q->qsize)
+            cnd_broadcast(&q->input_not_full_c);
 
-            if (!(q->input_head = j->next))
-                q->input_tail = NULL;
+        if (q->n_input == 0)
+            cnd_signal(&q->input_empty_c);
 
-            q->n_processing++;
-            if (q->n_input-- >= q->qsize)
-                cnd_broadcast(&q->input_not_full_c);
+        p->njobs--;
 
-            if (q->n_input == 0)
-                cnd_signal(&q->input_empty_c);
+        /* Never backwards: a queue served for running dry or for its
+         * priority may be behind the others */
+        if (p->vtime < q->vtime)
+            p->vtime = q->vtime;
+        q->vtime += SA_TPOOL_VTIME_UNIT / (uint64_t)q->weight;
 
-            p->njobs--;
+        mtx_unlock(&p->pool_m);
 
-            mtx_unlock(&p->pool_m);
+        if (sa_tpool_add_result(j, j->func(j->arg)) < 0)
+            goto err;
+        sa_free(j);
 
-            if (sa_tpool_add_result(j, j->func(j->arg)) < 0)
-                goto err;
-            sa_free(j);
+        mtx_lock(&p->pool_m);
 
-            mtx_lock(&p->pool_m);
-        }
         if (--q->ref_count == 0) {
             sa_tpool_process_destroy(q);
         } else {
-            /* Out of jobs on this queue, restart search from next one */
+            /* Restart the search from the next one, so ties rotate */
             if (p->q_head)
                 p->q_head = p->q_head->next;
         }
     }
 
-shutdown:
     mtx_unlock(&p->pool_m);
     return 0;
 
@@ -554,6 +608,7 @@ sa_tpool *sa_tpool_init(int n)
     p->t_stack = NULL;
     p->n_count = 0;
     p->n_running = 0;
+    p->vtime = 0;
 
     p->t = sa_malloc((size_t)n * sizeof(p->t[0]));
     if (!p->t) {
@@ -672,6 +727,10 @@ int sa_tpool_dispatch3(sa_tpool *p, sa_tpool_process *q,
         }
     }
 
+    /* A queue coming back from idle starts level with the others */
+    if (!q->input_head && !q->n_processing && q->vtime < p->vtime)
+        q->vtime = p->vtime;
+
     p->njobs++;
     q->n_input++;
 
@@ -33,6 +33,10 @@ extern "C" {
  * enabling heterogeneous workloads on the same set of threads.
  *
  * Results are returned in dispatch order (serial-number ordered).
+ *
+ * Workers pick the next job by process queue: queues running dry first,
+ * then higher priorities, then a weighted fair share among queues of the
+ * same priority.
  */
 
 /* Opaque types */
@@ -40,6 +44,19 @@ typedef struct sa_tpool sa_tpool;
 typedef struct sa_tpool_process sa_tpool_process;
 typedef struct sa_tpool_result sa_tpool_result;
 
+/**
+ * Scheduling options of a process queue.
+ *
+ * A zeroed struct (or NULL where accepted) gives the defaults: priority 0,
+ * weight 1, no low-water mark.
+ */
+typedef struct sa_tpool_process_opts {
+    int priority;   /* Higher is served first */
+    int weight;     /* Share of the workers among queues of equal priority */
+    int low_water;  /* Served ahead of every priority while fewer results
+                       than this are ready or in progress; 0 = never */
+} sa_tpool_process_opts;
+
 /* =========================================================================
  * Pool lifecycle
  * ========================================================================= */
@@ -159,9 +176,21 @@ SACD_API void * sa_tpool_result_data(sa_tpool_result *r);
  * @param p        Pool to attach to
  * @param qsize    Maximum queue depth (input + output)
  * @param in_only  If true, don't store results (fire-and-forget jobs)
+ * @param opts     Scheduling options, or NULL for the defaults
  * @return Process queue, or NULL on failure
  */
-SACD_API sa_tpool_process * sa_tpool_process_init(sa_tpool *p, int qsize, int in_only);
+SACD_API sa_tpool_process * sa_tpool_process_init(sa_tpool *p, int qsize, int in_only,
+                                                  const sa_tpool_process_opts *opts);
+
+/**
+ * Change the scheduling options of a process queue.
+ * Jobs already running are not affected.
+ *
+ * @param q     Process queue
+ * @param opts  Scheduling options, or NULL for the defaults
+ */
+SACD_API void sa_tpool_process_set_opts(sa_tpool_process *q,
+                                        const sa_tpool_process_opts *opts);
 
 /**
  * Destroy a process queue. Drains remaining jobs first.
@@ -21,9 +21,11 @@
  * It consists of two distinct interfaces: thread pools and thread job queues.
  *
  * The pool of threads is given a function pointer and void* data to pass in.
- * This means the pool can run jobs of multiple types, albeit first come
- * first served with no job scheduling except to pick tasks from
- * queues that have room to store the result.
+ * This means the pool can run jobs of multiple types. Jobs within a queue
+ * run first come first served; between queues that have room to store
+ * the result, workers prefer queues below their low-water mark, then
+ * higher priorities, then the queue with the lowest virtual time (jobs
+ * started, scaled by 1/weight).
  *
  * Upon completion, the return value from the function pointer is
  * added back to the queue if the result is required. We may have
@@ -114,6 +116,12 @@ struct sa_tpool_process {
 
     int ref_count;                  /* used to track safe destruction */
 
+    int priority;                   /* higher is served first */
+    int weight;                     /* fair share among equal priorities */
+    int low_water;                  /* results in flight below which the
+                                       queue is urgent; 0 = never */
+    uint64_t vtime;                 /* virtual time: jobs started / weight */
+
     cnd_t output_avail_c;     /* signaled on each new output */
     cnd_t input_not_full_c;   /* input queue is no longer full */
     cnd_t input_empty_c;      /* input queue has become empty */
@@ -150,6 +158,11 @@ struct sa_tpool {
 
     /* Tracking of average number of running jobs. */
     int n_count, n_running;
+
+    /* Latest virtual time a job was started at. A queue that goes idle and
+     * comes back is moved up to it, so it cannot claim the workers for
+     * the time it was idle. */
+    uint64_t vtime;
 };
 
 #ifdef __cplusplus
@@ -0,0 +1,369 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief SSSE3/AVX2 kernels for dsdinterleave.h
+ * Bytes are bit-reversed with two pshufb nibble lookups, then transposed
+ * with pshufb and unpacks. Kernels carry target attributes, so the file
+ * builds without -mssse3/-mavx2 and is only entered after CPUID agrees.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#if ARCH_X86 && HAVE_SSSE3
+
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "libsautil/cpu.h"
+#include "libsautil/dsdinterleave_internal.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TARGET_AVX2  __attribute__((target("avx2")))
+#else
+#define TARGET_SSSE3
+#define TARGET_AVX2
+#endif
+
+/* reverse(n) for the low nibble moved high, and for the high nibble moved low */
+static const uint8_t bitrev_lo_nibble[16] = {
+    0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0,
+    0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0
+};
+static const uint8_t bitrev_hi_nibble[16] = {
+    0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE,
+    0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF
+};
+
+/* Gathers even bytes into the low half and odd bytes into the high half */
+static const uint8_t split2[16] = {
+    0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15
+};
+
+/* Groups 4 frames of 4 channels into one 32-bit lane per channel */
+static const uint8_t split4[16] = {
+    0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15
+};
+
+/* 6 channels move 8 frames (48 bytes, 3 registers) at a time. Each output
+ * register is ORed together from one pshufb per input register; the masks
+ * are built once in sa_dsdinterleave_init_x86(). */
+static uint8_t deint6_mask[3][3][16];   /* [channel pair][input reg] */
+static uint8_t int6_mask[3][3][16];     /* [output reg][channel pair] */
+
+/* =============================================================================
+ * SSSE3
+ * ===========================================================================*/
+
+static inline TARGET_SSSE3 __m128i bitrev_ssse3(__m128i v)
+{
+    const __m128i lo_lut = _mm_loadu_si128((const __m128i *)bitrev_lo_nibble);
+    const __m128i hi_lut = _mm_loadu_si128((const __m128i *)bitrev_hi_nibble);
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i lo = _mm_and_si128(v, mask);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), mask);
+
+    return _mm_or_si128(_mm_shuffle_epi8(lo_lut, lo), _mm_shuffle_epi8(hi_lut, hi));
+}
+
+static TARGET_SSSE3 size_t deinterleave1_ssse3(uint8_t *const *dst, const uint8_t *src,
+                                               size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dst[0] + i), bitrev_ssse3(v));
+    }
+    return i;
+}
+
+static TARGET_SSSE3 size_t interleave1_ssse3(uint8_t *dst, const uint8_t *const *src,
+                                             size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src[0] + i));
+        _mm_storeu_si128((__m128i *)(dst + i), bitrev_ssse3(v));
+    }
+    return i;
+}
+
+static TARGET_SSSE3 size_t deinterleave2_ssse3(uint8_t *const *dst, const uint8_t *src,
+                                               size_t n)
+{
+    const __m128i split = _mm_loadu_si128((const __m128i *)split2);
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(src + 2 * i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(src + 2 * i + 16));
+
+        a = _mm_shuffle_epi8(bitrev_ssse3(a), split);
+        b = _mm_shuffle_epi8(bitrev_ssse3(b), split);
+        _mm_storeu_si128((__m128i *)(dst[0] + i), _mm_unpacklo_epi64(a, b));
+        _mm_storeu_si128((__m128i *)(dst[1] + i), _mm_unpackhi_epi64(a, b));
+    }
+    return i;
+}
+
+static TARGET_SSSE3 size_t interleave2_ssse3(uint8_t *dst, const uint8_t *const *src,
+                                             size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m128i l = bitrev_ssse3(_mm_loadu_si128((const __m128i *)(src[0] + i)));
+        __m128i r = bitrev_ssse3(_mm_loadu_si128((const __m128i *)(src[1] + i)));
+
+        _mm_storeu_si128((__m128i *)(dst + 2 * i), _mm_unpacklo_epi8(l, r));
+        _mm_storeu_si128((__m128i *)(dst + 2 * i + 16), _mm_unpackhi_epi8(l, r));
+    }
+    return i;
+}
+
+static TARGET_SSSE3 size_t deinterleave4_ssse3(uint8_t *const *dst, const uint8_t *src,
+                                               size_t n)
+{
+    const __m128i split = _mm_loadu_si128((const __m128i *)split4);
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        const uint8_t *s = src + 4 * i;
+        __m128i a = _mm_shuffle_epi8(bitrev_ssse3(_mm_loadu_si128((const __m128i *)s)), split);
+        __m128i b = _mm_shuffle_epi8(bitrev_ssse3(_mm_loadu_si128((const __m128i *)(s + 16))), split);
+        __m128i c = _mm_shuffle_epi8(bitrev_ssse3(_mm_loadu_si128((const __m128i *)(s + 32))), split);
+        __m128i d = _mm_shuffle_epi8(bitrev_ssse3(_mm_loadu_si128((const __m128i *)(s + 48))), split);
+
+        /* 4x4 transpose of 32-bit lanes */
+        __m128i ab_lo = _mm_unpacklo_epi32(a, b);
+        __m128i cd_lo = _mm_unpacklo_epi32(c, d);
+        __m128i ab_hi = _mm_unpackhi_epi32(a, b);
+        __m128i cd_hi = _mm_unpackhi_epi32(c, d);
+
+        _mm_storeu_si128((__m128i *)(dst[0] + i), _mm_unpacklo_epi64(ab_lo, cd_lo));
+        _mm_storeu_si128((__m128i *)(dst[1] + i), _mm_unpackhi_epi64(ab_lo, cd_lo));
+        _mm_storeu_si128((__m128i *)(dst[2] + i), _mm_unpacklo_epi64(ab_hi, cd_hi));
+        _mm_storeu_si128((__m128i *)(dst[3] + i), _mm_unpackhi_epi64(ab_hi, cd_hi));
+    }
+    return i;
+}
+
+static TARGET_SSSE3 size_t interleave4_ssse3(uint8_t *dst, const uint8_t *const *src,
+                                             size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m128i c0 = bitrev_ssse3(_mm_loadu_si128((const __m128i *)(src[0] + i)));
+        __m128i c1 = bitrev_ssse3(_mm_loadu_si128((const __m128i *)(src[1] + i)));
+        __m128i c2 = bitrev_ssse3(_mm_loadu_si128((const __m128i *)(src[2] + i)));
+        __m128i c3 = bitrev_ssse3(_mm_loadu_si128((const __m128i *)(src[3] + i)));
+        __m128i c01_lo = _mm_unpacklo_epi8(c0, c1);
+        __m128i c01_hi = _mm_unpackhi_epi8(c0, c1);
+        __m128i c23_lo = _mm_unpacklo_epi8(c2, c3);
+        __m128i c23_hi = _mm_unpackhi_epi8(c2, c3);
+        uint8_t *d = dst + 4 * i;
+
+        _mm_storeu_si128((__m128i *)d, _mm_unpacklo_epi16(c01_lo, c23_lo));
+        _mm_storeu_si128((__m128i *)(d + 16), _mm_unpackhi_epi16(c01_lo, c23_lo));
+        _mm_storeu_si128((__m128i *)(d + 32), _mm_unpacklo_epi16(c01_hi, c23_hi));
+        _mm_storeu_si128((__m128i *)(d + 48), _mm_unpackhi_epi16(c01_hi, c23_hi));
+    }
+    return i;
+}
+
+static TARGET_SSSE3 size_t deinterleave6_ssse3(uint8_t *const *dst, const uint8_t *src,
+                                               size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        const uint8_t *s = src + 6 * i;
+        __m128i in[3];
+
+        for (int r = 0; r < 3; r++)
+            in[r] = bitrev_ssse3(_mm_loadu_si128((const __m128i *)(s + 16 * r)));
+
+        for (int k = 0; k < 3; k++) {
+            __m128i v = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_shuffle_epi8(in[0], _mm_loadu_si128((const __m128i *)deint6_mask[k][0])),
+                    _mm_shuffle_epi8(in[1], _mm_loadu_si128((const __m128i *)deint6_mask[k][1]))),
+                _mm_shuffle_epi8(in[2], _mm_loadu_si128((const __m128i *)deint6_mask[k][2])));
+
+            _mm_storel_epi64((__m128i *)(dst[2 * k] + i), v);
+            _mm_storel_epi64((__m128i *)(dst[2 * k + 1] + i), _mm_unpackhi_epi64(v, v));
+        }
+    }
+    return i;
+}
+
+static TARGET_SSSE3 size_t interleave6_ssse3(uint8_t *dst, const uint8_t *const *src,
+                                             size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        uint8_t *d = dst + 6 * i;
+        __m128i in[3];
+
+        for (int k = 0; k < 3; k++) {
+            __m128i a = _mm_loadl_epi64((const __m128i *)(src[2 * k] + i));
+            __m128i b = _mm_loadl_epi64((const __m128i *)(src[2 * k + 1] + i));
+            in[k] = bitrev_ssse3(_mm_unpacklo_epi64(a, b));
+        }
+
+        for (int r = 0; r < 3; r++) {
+            __m128i v = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_shuffle_epi8(in[0], _mm_loadu_si128((const __m128i *)int6_mask[r][0])),
+                    _mm_shuffle_epi8(in[1], _mm_loadu_si128((const __m128i *)int6_mask[r][1]))),
+                _mm_shuffle_epi8(in[2], _mm_loadu_si128((const __m128i *)int6_mask[r][2])));
+
+            _mm_storeu_si128((__m128i *)(d + 16 * r), v);
+        }
+    }
+    return i;
+}
+
+/* =============================================================================
+ * AVX2
+ * ===========================================================================*/
+
+#if HAVE_AVX2
+
+static inline TARGET_AVX2 __m256i bitrev_avx2(__m256i v)
+{
+    const __m256i lo_lut = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)bitrev_lo_nibble));
+    const __m256i hi_lut = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)bitrev_hi_nibble));
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    __m256i lo = _mm256_and_si256(v, mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), mask);
+
+    return _mm256_or_si256(_mm256_shuffle_epi8(lo_lut, lo), _mm256_shuffle_epi8(hi_lut, hi));
+}
+
+static TARGET_AVX2 size_t deinterleave1_avx2(uint8_t *const *dst, const uint8_t *src,
+                                             size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+        _mm256_storeu_si256((__m256i *)(dst[0] + i), bitrev_avx2(v));
+    }
+    return i;
+}
+
+static TARGET_AVX2 size_t interleave1_avx2(uint8_t *dst, const uint8_t *const *src,
+                                           size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(src[0] + i));
+        _mm256_storeu_si256((__m256i *)(dst + i), bitrev_avx2(v));
+    }
+    return i;
+}
+
+static TARGET_AVX2 size_t deinterleave2_avx2(uint8_t *const *dst, const uint8_t *src,
+                                             size_t n)
+{
+    const __m256i split = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)split2));
+    size_t i;
+
+    for (i = 0; i + 32 <= n; i += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(src + 2 * i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(src + 2 * i + 32));
+
+        /* Per lane [L x8 | R x8], then gather the L and R quadwords */
+        a = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(bitrev_avx2(a), split), 0xD8);
+        b = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(bitrev_avx2(b), split), 0xD8);
+        _mm256_storeu_si256((__m256i *)(dst[0] + i), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *)(dst[1] + i), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    return i;
+}
+
+static TARGET_AVX2 size_t interleave2_avx2(uint8_t *dst, const uint8_t *const *src,
+                                           size_t n)
+{
+    size_t i;
+
+    for (i = 0; i + 32 <= n; i += 32) {
+        __m256i l = bitrev_avx2(_mm256_loadu_si256((const __m256i *)(src[0] + i)));
+        __m256i r = bitrev_avx2(_mm256_loadu_si256((const __m256i *)(src[1] + i)));
+        __m256i lo = _mm256_unpacklo_epi8(l, r);
+        __m256i hi = _mm256_unpackhi_epi8(l, r);
+
+        _mm256_storeu_si256((__m256i *)(dst + 2 * i), _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i *)(dst + 2 * i + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    return i;
+}
+
+#endif /* HAVE_AVX2 */
+
+static void init_6ch_masks(void)
+{
+    for (int k = 0; k < 3; k++) {
+        for (int r = 0; r < 3; r++) {
+            for (int p = 0; p < 16; p++) {
+                /* Output pair k, byte p: channel 2k + p/8 of frame p%8 */
+                int g = 6 * (p % 8) + 2 * k + p / 8;
+                deint6_mask[k][r][p] = (g / 16 == r) ? (uint8_t)(g % 16) : 0x80;
+
+                /* Output reg r, byte p: frame g/6, channel g%6 */
+                g = 16 * r + p;
+                int ch = g % 6;
+                int6_mask[r][k][p] = (ch / 2 == k) ? (uint8_t)((ch % 2) * 8 + g / 6) : 0x80;
+            }
+        }
+    }
+}
+
+void sa_dsdinterleave_init_x86(SADSDInterleaveDSP *dsp, int cpu_flags)
+{
+    if (cpu_flags & SA_CPU_FLAG_SSSE3) {
+        init_6ch_masks();
+        dsp->deinterleave[1] = deinterleave1_ssse3;
+        dsp->interleave[1]   = interleave1_ssse3;
+        dsp->deinterleave[2] = deinterleave2_ssse3;
+        dsp->interleave[2]   = interleave2_ssse3;
+        dsp->deinterleave[4] = deinterleave4_ssse3;
+        dsp->interleave[4]   = interleave4_ssse3;
+        dsp->deinterleave[6] = deinterleave6_ssse3;
+        dsp->interleave[6]   = interleave6_ssse3;
+    }
+#if HAVE_AVX2
+    if (cpu_flags & SA_CPU_FLAG_AVX2) {
+        dsp->deinterleave[1] = deinterleave1_avx2;
+        dsp->interleave[1]   = interleave1_avx2;
+        dsp->deinterleave[2] = deinterleave2_avx2;
+        dsp->interleave[2]   = interleave2_avx2;
+    }
+#endif
+}
+
+#endif /* ARCH_X86 && HAVE_SSSE3 */
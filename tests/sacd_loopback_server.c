@@ -0,0 +1,320 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Loopback stand-in for the SACD network server, used by tests
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sacd_loopback_server.h"
+#include "sacd_pb_stream.h"
+
+#include <libsautil/mem.h>
+#include <libsautil/c11threads.h>
+
+#include <string.h>
+#include <time.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include <tinycsocket.h>
+#include <pb_encode.h>
+#include <pb_decode.h>
+#include "sacd_ripper.pb.h"
+
+#define LOOPBACK_SECTOR_SIZE 2048
+#define LOOPBACK_MAX_SECTORS 500    /* 1024000 bytes per response */
+
+struct sacd_loopback_server {
+    TcsSocket       listen_sock;
+    struct TcsAddress address;      /* 127.0.0.1:port */
+    uint16_t        port;
+    uint32_t        total_sectors;
+    const uint8_t  *image;          /* Sectors to serve, NULL for the pattern */
+    thrd_t          thread;
+    atomic_int      stop;
+    atomic_int      read_requests;
+    atomic_int      read_sectors;
+    uint8_t        *payload;        /* LOOPBACK_MAX_SECTORS sectors */
+    size_t          payload_size;   /* Bytes of payload to send */
+};
+
+void sacd_loopback_fill_sector(uint32_t lsn, uint8_t *buf)
+{
+    uint32_t i;
+
+    for (i = 0; i < LOOPBACK_SECTOR_SIZE; i++)
+    {
+        buf[i] = (uint8_t)((lsn * 7u + i) & 0xFF);
+    }
+    memcpy(buf, &lsn, sizeof(lsn));
+}
+
+static bool _encode_data(pb_ostream_t *stream, const pb_field_t *field,
+                         void * const *arg)
+{
+    const sacd_loopback_server_t *srv = (const sacd_loopback_server_t *)*arg;
+
+    return pb_encode_tag_for_field(stream, field) &&
+           pb_encode_string(stream, srv->payload, srv->payload_size);
+}
+
+static bool _send_response(sacd_loopback_server_t *srv, TcsSocket sock,
+                           ServerResponse *response)
+{
+    pb_ostream_t output = pb_ostream_from_tcs_socket(sock);
+    uint8_t zero = 0;
+
+    if (srv->payload_size > 0)
+    {
+        response->data.funcs.encode = _encode_data;
+        response->data.arg = srv;
+    }
+
+    return pb_encode(&output, ServerResponse_fields, response) &&
+           pb_write(&output, &zero, 1);
+}
+
+/* Serve one client until it disconnects or sends DISC_CLOSE */
+static void _serve_connection(sacd_loopback_server_t *srv, TcsSocket sock)
+{
+    for (;;)
+    {
+        ServerRequest request = ServerRequest_init_zero;
+        pb_istream_t input = pb_istream_from_tcs_socket(sock);
+        ServerResponse response = ServerResponse_init_zero;
+
+        if (!pb_decode_ex(&input, ServerRequest_fields, &request,
+                          PB_DECODE_NULLTERMINATED))
+        {
+            return;
+        }
+
+        srv->payload_size = 0;
+
+        switch (request.type)
+        {
+        case ServerRequest_Type_DISC_OPEN:
+            response.type = ServerResponse_Type_DISC_OPENED;
+            break;
+
+        case ServerRequest_Type_DISC_SIZE:
+            response.type = ServerResponse_Type_DISC_SIZE;
+            response.result = srv->total_sectors;
+            break;
+
+        case ServerRequest_Type_DISC_READ:
+        {
+            uint32_t count = 0;
+            uint32_t i;
+
+            if (request.sector_offset < srv->total_sectors)
+            {
+                count = srv->total_sectors - request.sector_offset;
+                if (count > request.sector_count)
+                {
+                    count = request.sector_count;
+                }
+            }
+            if (count > LOOPBACK_MAX_SECTORS)
+            {
+                count = LOOPBACK_MAX_SECTORS;
+            }
+
+            if (srv->image)
+            {
+                memcpy(srv->payload,
+                       srv->image + (size_t)request.sector_offset * LOOPBACK_SECTOR_SIZE,
+                       (size_t)count * LOOPBACK_SECTOR_SIZE);
+            }
+            else
+            {
+                for (i = 0; i < count; i++)
+                {
+                    sacd_loopback_fill_sector(request.sector_offset + i,
+                        srv->payload + (size_t)i * LOOPBACK_SECTOR_SIZE);
+                }
+            }
+
+            response.type = ServerResponse_Type_DISC_READ;
+            response.result = count;
+            srv->payload_size = (size_t)count * LOOPBACK_SECTOR_SIZE;
+            atomic_fetch_add(&srv->read_requests, 1);
+            atomic_fetch_add(&srv->read_sectors, (int)count);
+            break;
+        }
+
+        case ServerRequest_Type_DISC_CLOSE:
+        default:
+            return;
+        }
+
+        if (!_send_response(srv, sock, &response))
+        {
+            return;
+        }
+    }
+}
+
+static int _server_thread(void *arg)
+{
+    sacd_loopback_server_t *srv = (sacd_loopback_server_t *)arg;
+
+    while (!atomic_load(&srv->stop))
+    {
+        TcsSocket client = TCS_SOCKET_INVALID;
+
+        if (tcs_accept(srv->listen_sock, &client, NULL) != TCS_SUCCESS)
+        {
+            break;
+        }
+        if (!atomic_load(&srv->stop))
+        {
+            _serve_connection(srv, client);
+        }
+        tcs_close(&client);
+    }
+    return 0;
+}
+
+static int _server_start(uint32_t total_sectors, const uint8_t *image,
+                         sacd_loopback_server_t **out)
+{
+    sacd_loopback_server_t *srv;
+    struct TcsAddress local;
+    uint32_t base;
+    uint32_t attempt;
+
+    *out = NULL;
+
+    if (tcs_lib_init() != TCS_SUCCESS)
+    {
+        return -1;
+    }
+
+    srv = (sacd_loopback_server_t *)sa_calloc(1, sizeof(*srv));
+    if (!srv)
+    {
+        tcs_lib_free();
+        return -1;
+    }
+    srv->payload = (uint8_t *)sa_malloc((size_t)LOOPBACK_MAX_SECTORS *
+                                        LOOPBACK_SECTOR_SIZE);
+    srv->listen_sock = TCS_SOCKET_INVALID;
+    srv->total_sectors = total_sectors;
+    srv->image = image;
+    atomic_init(&srv->stop, 0);
+    atomic_init(&srv->read_requests, 0);
+    atomic_init(&srv->read_sectors, 0);
+
+    /*
+     * Bind 127.0.0.1. tinycsocket cannot report the port the OS picked for
+     * port 0 on every platform, so probe a range starting at a time-based
+     * offset instead.
+     */
+    if (!srv->payload)
+    {
+        goto fail;
+    }
+    base = 20000u + (uint32_t)(time(NULL) % 20000) + (uint32_t)clock() % 1000u;
+    for (attempt = 0; attempt < 256; attempt++)
+    {
+        memset(&local, 0, sizeof(local));
+        local.family = TCS_AF_IP4;
+        local.data.ip4.address = 0x7F000001u;
+        local.data.ip4.port = (uint16_t)(base + attempt * 7u);
+        if (tcs_tcp_server(&srv->listen_sock, &local) == TCS_SUCCESS)
+        {
+            srv->address = local;
+            srv->port = local.data.ip4.port;
+            break;
+        }
+        srv->listen_sock = TCS_SOCKET_INVALID;
+    }
+    if (srv->listen_sock == TCS_SOCKET_INVALID)
+    {
+        goto fail;
+    }
+
+    if (thrd_create(&srv->thread, _server_thread, srv) != thrd_success)
+    {
+        goto fail;
+    }
+
+    *out = srv;
+    return 0;
+
+fail:
+    if (srv->listen_sock != TCS_SOCKET_INVALID)
+    {
+        tcs_close(&srv->listen_sock);
+    }
+    sa_free(srv->payload);
+    sa_free(srv);
+    tcs_lib_free();
+    return -1;
+}
+
+int sacd_loopback_server_start(uint32_t total_sectors,
+                               sacd_loopback_server_t **out)
+{
+    return _server_start(total_sectors, NULL, out);
+}
+
+int sacd_loopback_server_start_image(const uint8_t *sectors,
+                                     uint32_t total_sectors,
+                                     sacd_loopback_server_t **out)
+{
+    return _server_start(total_sectors, sectors, out);
+}
+
+void sacd_loopback_server_stop(sacd_loopback_server_t *server)
+{
+    TcsSocket wake = TCS_SOCKET_INVALID;
+
+    if (!server)
+    {
+        return;
+    }
+
+    /* Unblock tcs_accept() with a throwaway connection */
+    atomic_store(&server->stop, 1);
+    if (tcs_socket_preset(&wake, TCS_PRESET_TCP_IP4) == TCS_SUCCESS)
+    {
+        tcs_connect(wake, &server->address);
+        tcs_close(&wake);
+    }
+    thrd_join(server->thread, NULL);
+
+    tcs_close(&server->listen_sock);
+    sa_free(server->payload);
+    sa_free(server);
+    tcs_lib_free();
+}
+
+uint16_t sacd_loopback_server_port(const sacd_loopback_server_t *server)
+{
+    return server->port;
+}
+
+uint32_t sacd_loopback_server_read_requests(sacd_loopback_server_t *server)
+{
+    return (uint32_t)atomic_load(&server->read_requests);
+}
+
+uint32_t sacd_loopback_server_read_sectors(sacd_loopback_server_t *server)
+{
+    return (uint32_t)atomic_load(&server->read_sectors);
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Loopback stand-in for the SACD network server, used by tests
+ * Serves a synthetic disc over the sacd_ripper.proto protocol on
+ * 127.0.0.1 so the network input can be exercised without a drive.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SACD_LOOPBACK_SERVER_H
+#define SACD_LOOPBACK_SERVER_H
+
+#include <stdint.h>
+
+typedef struct sacd_loopback_server sacd_loopback_server_t;
+
+/**
+ * @brief Start a server for a disc of @p total_sectors sectors.
+ *
+ * The server listens on a free port and handles one connection at a
+ * time on a background thread.
+ *
+ * @return 0 on success, -1 on failure
+ */
+int sacd_loopback_server_start(uint32_t total_sectors,
+                               sacd_loopback_server_t **out);
+
+/**
+ * @brief Start a server for a disc image held in memory.
+ *
+ * Serves @p total_sectors 2048-byte sectors from @p sectors, which must
+ * stay valid until the server is stopped.
+ *
+ * @return 0 on success, -1 on failure
+ */
+int sacd_loopback_server_start_image(const uint8_t *sectors,
+                                     uint32_t total_sectors,
+                                     sacd_loopback_server_t **out);
+
+/** @brief Stop the server thread and free it. */
+void sacd_loopback_server_stop(sacd_loopback_server_t *server);
+
+/** @brief Port the server listens on. */
+uint16_t sacd_loopback_server_port(const sacd_loopback_server_t *server);
+
+/** @brief Number of DISC_READ requests answered so far. */
+uint32_t sacd_loopback_server_read_requests(sacd_loopback_server_t *server);
+
+/** @brief Number of sectors sent in DISC_READ responses so far. */
+uint32_t sacd_loopback_server_read_sectors(sacd_loopback_server_t *server);
+
+/** @brief Fill @p buf with the 2048-byte test pattern of sector @p lsn. */
+void sacd_loopback_fill_sector(uint32_t lsn, uint8_t *buf);
+
+#endif /* SACD_LOOPBACK_SERVER_H */
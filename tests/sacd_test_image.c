@@ -0,0 +1,430 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Synthetic SACD disc images, used by tests
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sacd_test_image.h"
+#include "sacd_specification.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IMAGE_MASTER_TOC    510
+#define IMAGE_MASTER_TEXT   511
+#define IMAGE_MANUF_INFO    519
+#define IMAGE_AREA_TOC_1    544
+#define IMAGE_AREA_TOC_2    600
+#define IMAGE_AREA_TOC_LEN  40
+
+#define IMAGE_DST_FRAMES    400
+#define IMAGE_DSD_FRAMES    21
+
+/** Room for the largest DST Track Area the packer can produce */
+#define IMAGE_MAX_SECTORS   (SACD_TEST_IMAGE_TRACK_START + IMAGE_DST_FRAMES * 4)
+
+/** Audio sector layout: 1-byte header, 2-byte packet info, 4-byte DST frame info */
+#define SECTOR_HEADER_SIZE  1
+#define PACKET_INFO_SIZE    2
+#define FRAME_INFO_SIZE     4
+
+/** Payload bytes per packet: the 11-bit packet length field */
+#define PACKET_MAX_LENGTH   2047
+
+struct sacd_test_image {
+    uint8_t *sectors;
+    uint32_t total_sectors;
+    uint32_t track_end;
+    uint32_t frame_count;
+    uint8_t **frames;                   /**< DST payloads, NULL for DSD */
+    uint32_t *frame_sizes;
+};
+
+/* =============================================================================
+ * Helpers
+ * ===========================================================================*/
+
+static uint8_t *image_sector(sacd_test_image_t *image, uint32_t lsn)
+{
+    return image->sectors + (size_t)lsn * SACD_LSN_SIZE;
+}
+
+static void put_be16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+static void put_be32(void *dst, uint32_t v)
+{
+    uint8_t *p = (uint8_t *)dst;
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static void put_time(time_sacd_t *t, uint32_t frames)
+{
+    t->minutes = (uint8_t)(frames / (60 * SACD_FRAMES_PER_SEC));
+    t->seconds = (uint8_t)((frames / SACD_FRAMES_PER_SEC) % 60);
+    t->frames = (uint8_t)(frames % SACD_FRAMES_PER_SEC);
+}
+
+static uint32_t next_random(uint32_t *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 8;
+}
+
+/* =============================================================================
+ * Track Area
+ * ===========================================================================*/
+
+typedef struct {
+    bool frame_start;
+    uint8_t data_type;
+    uint16_t length;
+    const uint8_t *data;                /**< NULL for supplementary data */
+    uint32_t frame;
+} image_packet_t;
+
+/** Supplementary data following frame @p frame, 0 for none */
+static uint32_t image_supplementary_size(uint32_t frame)
+{
+    return (frame % 5 == 1) ? 100 + frame : 0;
+}
+
+/**
+ * @brief Multiplex the DST frames into audio sectors.
+ *
+ * Packets are cut at sector boundaries, up to 7 per sector. Every frame
+ * start gets a frame_info entry whose sector count is filled in once the
+ * last sector of the frame is known.
+ */
+static int image_pack_dst(sacd_test_image_t *image)
+{
+    uint32_t *first_lsn = (uint32_t *)calloc(image->frame_count, sizeof(uint32_t));
+    uint32_t *last_lsn = (uint32_t *)calloc(image->frame_count, sizeof(uint32_t));
+    uint8_t **frame_info = (uint8_t **)calloc(image->frame_count, sizeof(uint8_t *));
+    uint32_t lsn = SACD_TEST_IMAGE_TRACK_START;
+    uint32_t frame = 0, offset = 0, supplementary = 0;
+
+    if (!first_lsn || !last_lsn || !frame_info) {
+        free(first_lsn);
+        free(last_lsn);
+        free(frame_info);
+        return -1;
+    }
+
+    while (frame < image->frame_count && lsn < IMAGE_MAX_SECTORS) {
+        image_packet_t packets[7];
+        int packet_count = 0, start_count = 0;
+        uint32_t used = SECTOR_HEADER_SIZE;
+        uint8_t *sector = image_sector(image, lsn);
+        uint8_t *p;
+
+        /* Lay out the packets of this sector */
+        while (packet_count < 7 && frame < image->frame_count) {
+            image_packet_t *packet = &packets[packet_count];
+            bool start = (offset == 0);
+            uint32_t header = PACKET_INFO_SIZE + (start ? FRAME_INFO_SIZE : 0);
+            uint32_t space, length;
+
+            if (used + header >= SACD_LSN_SIZE) {
+                break;
+            }
+            space = SACD_LSN_SIZE - used - header;
+            if (space > PACKET_MAX_LENGTH) {
+                space = PACKET_MAX_LENGTH;
+            }
+
+            packet->frame_start = start;
+            packet->frame = frame;
+            if (supplementary > 0) {
+                length = supplementary < space ? supplementary : space;
+                packet->data_type = DATA_TYPE_SUPPLEMENTARY;
+                packet->data = NULL;
+                supplementary -= length;
+            } else {
+                uint32_t left = image->frame_sizes[frame] - offset;
+                length = left < space ? left : space;
+                packet->data_type = DATA_TYPE_AUDIO;
+                packet->data = image->frames[frame] + offset;
+                offset += length;
+                if (offset == image->frame_sizes[frame]) {
+                    supplementary = image_supplementary_size(frame);
+                }
+            }
+            packet->length = (uint16_t)length;
+
+            if (start) {
+                first_lsn[frame] = lsn;
+                start_count++;
+            }
+            last_lsn[frame] = lsn;
+            used += header + length;
+            packet_count++;
+
+            /* Move on once the frame and its supplementary data are out */
+            if (offset == image->frame_sizes[frame] && supplementary == 0) {
+                frame++;
+                offset = 0;
+            }
+        }
+
+        /* Sector header: packet count, frame start count, DST coded */
+        sector[0] = (uint8_t)((packet_count << 5) | (start_count << 2) | 1);
+        p = sector + SECTOR_HEADER_SIZE;
+        for (int i = 0; i < packet_count; i++) {
+            put_be16(p, (uint16_t)((packets[i].frame_start ? 0x8000 : 0) |
+                                   (packets[i].data_type << 11) |
+                                   packets[i].length));
+            p += PACKET_INFO_SIZE;
+        }
+        for (int i = 0; i < packet_count; i++) {
+            if (packets[i].frame_start) {
+                uint32_t k = packets[i].frame;
+                put_time((time_sacd_t *)p, k);
+                frame_info[k] = p + 3;
+                p += FRAME_INFO_SIZE;
+            }
+        }
+        for (int i = 0; i < packet_count; i++) {
+            if (packets[i].data) {
+                memcpy(p, packets[i].data, packets[i].length);
+            } else {
+                memset(p, 0xEE, packets[i].length);
+            }
+            p += packets[i].length;
+        }
+        lsn++;
+    }
+
+    for (uint32_t k = 0; k < frame && k < image->frame_count; k++) {
+        *frame_info[k] = (uint8_t)((last_lsn[k] - first_lsn[k] + 1) << 2);
+    }
+
+    free(first_lsn);
+    free(last_lsn);
+    free(frame_info);
+
+    if (frame < image->frame_count) {
+        return -1;
+    }
+    image->track_end = lsn - 1;
+    return 0;
+}
+
+static int image_fill_dst(sacd_test_image_t *image)
+{
+    uint32_t seed = 12345;
+
+    image->frame_count = IMAGE_DST_FRAMES;
+    image->frames = (uint8_t **)calloc(image->frame_count, sizeof(uint8_t *));
+    image->frame_sizes = (uint32_t *)calloc(image->frame_count, sizeof(uint32_t));
+    if (!image->frames || !image->frame_sizes) {
+        return -1;
+    }
+
+    for (uint32_t k = 0; k < image->frame_count; k++) {
+        /* Every seventh frame is short enough to share a sector */
+        uint32_t size = (k % 7 == 3) ? 40 + next_random(&seed) % 200
+                                     : 300 + next_random(&seed) % 6000;
+        image->frames[k] = (uint8_t *)malloc(size);
+        if (!image->frames[k]) {
+            return -1;
+        }
+        /* A zero first byte marks a frame the DST decoder takes as plain
+         * DSD, so the frames decode as well */
+        image->frames[k][0] = 0;
+        for (uint32_t i = 1; i < size; i++) {
+            image->frames[k][i] = (uint8_t)next_random(&seed);
+        }
+        image->frame_sizes[k] = size;
+    }
+
+    return image_pack_dst(image);
+}
+
+static void image_fill_dsd(sacd_test_image_t *image)
+{
+    image->frame_count = IMAGE_DSD_FRAMES;
+
+    /* 3 frames in 14 sectors */
+    image->track_end = SACD_TEST_IMAGE_TRACK_START + IMAGE_DSD_FRAMES / 3 * 14 - 1;
+    for (uint32_t lsn = SACD_TEST_IMAGE_TRACK_START; lsn <= image->track_end; lsn++) {
+        uint8_t *sector = image_sector(image, lsn);
+        for (int i = 0; i < SACD_LSN_SIZE; i++) {
+            sector[i] = (uint8_t)(lsn * 7 + i);
+        }
+    }
+}
+
+/* =============================================================================
+ * TOCs
+ * ===========================================================================*/
+
+static void image_write_tocs(sacd_test_image_t *image, bool dst)
+{
+    master_toc_0_t *master = (master_toc_0_t *)image_sector(image, IMAGE_MASTER_TOC);
+    master_text_t *text = (master_text_t *)image_sector(image, IMAGE_MASTER_TEXT);
+    manuf_info_t *manuf = (manuf_info_t *)image_sector(image, IMAGE_MANUF_INFO);
+
+    memcpy(&master->signature, "SACDMTOC", 8);
+    master->version.major = 1;
+    master->version.minor = 20;
+    put_be32(&master->disc.stereo_toc_1_lsn, IMAGE_AREA_TOC_1);
+    put_be32(&master->disc.stereo_toc_2_lsn, IMAGE_AREA_TOC_2);
+    put_be16((uint8_t *)&master->disc.stereo_toc_length, IMAGE_AREA_TOC_LEN);
+    memcpy(&text->signature, "SACDText", 8);
+    memcpy(&manuf->signature, "SACD_Man", 8);
+
+    for (int copy = 0; copy < 2; copy++) {
+        uint32_t base = copy ? IMAGE_AREA_TOC_2 : IMAGE_AREA_TOC_1;
+        area_data_t *area = (area_data_t *)image_sector(image, base);
+        track_list_1_t *list1 = (track_list_1_t *)image_sector(image, base + 1);
+        track_list_2_t *list2 = (track_list_2_t *)image_sector(image, base + 2);
+        isrc_genre_list_1_t *isrc = (isrc_genre_list_1_t *)image_sector(image, base + 3);
+
+        memcpy(&area->signature, "TWOCHTOC", 8);
+        area->version.major = 1;
+        area->version.minor = 20;
+        put_be32(&area->max_byte_rate, 705600);
+        area->fs_code = 4;
+        area->frame_format = dst ? FRAME_FORMAT_DST : FRAME_FORMAT_DSD_3_IN_14;
+        area->channel_count = 2;
+        area->track_count = 1;
+        put_time(&area->total_area_play_time, image->frame_count);
+        put_be32(&area->track_area_start_address, SACD_TEST_IMAGE_TRACK_START);
+        put_be32(&area->track_area_end_address, image->track_end);
+
+        memcpy(&list1->signature, "SACDTRL1", 8);
+        put_be32(&list1->track_start_lsn[0], SACD_TEST_IMAGE_TRACK_START);
+        put_be32(&list1->track_length[0], image->track_end - SACD_TEST_IMAGE_TRACK_START + 1);
+        memcpy(&list2->signature, "SACDTRL2", 8);
+        put_time(&list2->info_2[0].track_time_length, image->frame_count);
+        memcpy(&isrc->signature, "SACD_IGL", 8);
+    }
+}
+
+/* =============================================================================
+ * Public API
+ * ===========================================================================*/
+
+int sacd_test_image_create(bool dst, sacd_test_image_t **out)
+{
+    sacd_test_image_t *image = (sacd_test_image_t *)calloc(1, sizeof(*image));
+    int result;
+
+    *out = NULL;
+    if (!image) {
+        return -1;
+    }
+
+    image->total_sectors = IMAGE_MAX_SECTORS;
+    image->sectors = (uint8_t *)calloc(image->total_sectors, SACD_LSN_SIZE);
+    if (!image->sectors) {
+        free(image);
+        return -1;
+    }
+
+    if (dst) {
+        result = image_fill_dst(image);
+    } else {
+        image_fill_dsd(image);
+        result = 0;
+    }
+    if (result != 0) {
+        sacd_test_image_free(image);
+        return -1;
+    }
+
+    image_write_tocs(image, dst);
+    image->total_sectors = image->track_end + 1;
+
+    *out = image;
+    return 0;
+}
+
+void sacd_test_image_free(sacd_test_image_t *image)
+{
+    if (!image) {
+        return;
+    }
+    if (image->frames) {
+        for (uint32_t k = 0; k < image->frame_count; k++) {
+            free(image->frames[k]);
+        }
+        free(image->frames);
+    }
+    free(image->frame_sizes);
+    free(image->sectors);
+    free(image);
+}
+
+int sacd_test_image_write(const sacd_test_image_t *image, const char *path)
+{
+    FILE *fp = fopen(path, "wb");
+    int result = 0;
+
+    if (!fp) {
+        return -1;
+    }
+    if (fwrite(image->sectors, SACD_LSN_SIZE, image->total_sectors, fp) != image->total_sectors) {
+        result = -1;
+    }
+    if (fclose(fp) != 0) {
+        result = -1;
+    }
+    return result;
+}
+
+uint32_t sacd_test_image_frame_count(const sacd_test_image_t *image)
+{
+    return image->frame_count;
+}
+
+uint32_t sacd_test_image_track_end(const sacd_test_image_t *image)
+{
+    return image->track_end;
+}
+
+uint32_t sacd_test_image_total_sectors(const sacd_test_image_t *image)
+{
+    return image->total_sectors;
+}
+
+const uint8_t *sacd_test_image_sector(const sacd_test_image_t *image,
+                                      uint32_t lsn)
+{
+    if (lsn >= image->total_sectors) {
+        return NULL;
+    }
+    return image->sectors + (size_t)lsn * SACD_LSN_SIZE;
+}
+
+const uint8_t *sacd_test_image_frame(const sacd_test_image_t *image,
+                                     uint32_t frame, uint32_t *size)
+{
+    if (!image->frames || frame >= image->frame_count) {
+        return NULL;
+    }
+    *size = image->frame_sizes[frame];
+    return image->frames[frame];
+}
@@ -0,0 +1,80 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Synthetic SACD disc images, used by tests
+ * Builds a small single-track 2-channel disc (Master TOC, both Area TOC
+ * copies and a Track Area) in memory, either DST coded with frames of
+ * known content or as plain DSD 3-in-14, so the readers can be exercised
+ * without a real disc image.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SACD_TEST_IMAGE_H
+#define SACD_TEST_IMAGE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** First sector of the Track Area */
+#define SACD_TEST_IMAGE_TRACK_START 700
+
+typedef struct sacd_test_image sacd_test_image_t;
+
+/**
+ * @brief Build an image in memory.
+ *
+ * DST images hold 400 frames of pseudo-random payload. Frame sizes vary
+ * from a few dozen bytes (several frames starting in one sector) to a few
+ * sectors, and some frames are followed by supplementary data packets.
+ * Each payload is marked as not DST coded, so it also decodes.
+ * DSD images hold 21 frames.
+ *
+ * @return 0 on success, -1 on failure
+ */
+int sacd_test_image_create(bool dst, sacd_test_image_t **out);
+
+/** @brief Free an image. */
+void sacd_test_image_free(sacd_test_image_t *image);
+
+/**
+ * @brief Write the image to @p path as a 2048-byte sector ISO.
+ *
+ * @return 0 on success, -1 on failure
+ */
+int sacd_test_image_write(const sacd_test_image_t *image, const char *path);
+
+/** @brief Number of frames in the Track Area. */
+uint32_t sacd_test_image_frame_count(const sacd_test_image_t *image);
+
+/** @brief Last sector of the Track Area. */
+uint32_t sacd_test_image_track_end(const sacd_test_image_t *image);
+
+/** @brief Number of sectors in the image. */
+uint32_t sacd_test_image_total_sectors(const sacd_test_image_t *image);
+
+/** @brief The 2048 bytes of sector @p lsn. */
+const uint8_t *sacd_test_image_sector(const sacd_test_image_t *image,
+                                      uint32_t lsn);
+
+/**
+ * @brief Payload of DST frame @p frame, as the reader must return it.
+ *
+ * @return The payload, or NULL for DSD images
+ */
+const uint8_t *sacd_test_image_frame(const sacd_test_image_t *image,
+                                     uint32_t frame, uint32_t *size);
+
+#endif /* SACD_TEST_IMAGE_H */
@@ -0,0 +1,134 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Unit tests for the dsdctl command line helpers using CMocka
+ * Covers the --range time range parser.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "cli_common.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+/* =============================================================================
+ * Helpers
+ * ===========================================================================*/
+
+static void check_range(const char *str, uint32_t start_ms, uint32_t end_ms)
+{
+    uint32_t start = 1234;
+    uint32_t end = 5678;
+
+    assert_int_equal(cli_parse_time_range(str, &start, &end), 0);
+    assert_int_equal(start, start_ms);
+    assert_int_equal(end, end_ms);
+}
+
+static void check_invalid(const char *str)
+{
+    uint32_t start = 1234;
+    uint32_t end = 5678;
+
+    assert_int_equal(cli_parse_time_range(str, &start, &end), -1);
+
+    /* Outputs are left alone on error */
+    assert_int_equal(start, 1234);
+    assert_int_equal(end, 5678);
+}
+
+/* =============================================================================
+ * Tests
+ * ===========================================================================*/
+
+/**
+ * @brief Seconds, minutes and hours, with and without fraction
+ */
+static void test_time_range_fields(void **state)
+{
+    (void)state;
+
+    check_range("90-120", 90000, 120000);
+    check_range("1:30-2:00", 90000, 120000);
+    check_range("0:01:30-1:00:00", 90000, 3600000);
+    check_range("1:30.250-1:31.5", 90250, 91500);
+    check_range("0.001-0.002", 1, 2);
+    check_range("0-0.5", 0, 500);
+
+    /* Digits past milliseconds are ignored */
+    check_range("1.2349-2", 1234, 2000);
+}
+
+/**
+ * @brief A range without end runs to the end of the track
+ */
+static void test_time_range_open_end(void **state)
+{
+    (void)state;
+
+    check_range("0-", 0, 0);
+    check_range("1:30-", 90000, 0);
+    check_range("99:59:59.999-", 359999999, 0);
+}
+
+/**
+ * @brief Malformed ranges are rejected
+ */
+static void test_time_range_invalid(void **state)
+{
+    (void)state;
+
+    check_invalid("");
+    check_invalid("-");
+    check_invalid("-10");
+    check_invalid("10");
+    check_invalid("abc-10");
+    check_invalid("10-abc");
+    check_invalid("10-20x");
+    check_invalid("1:60-2:00");
+    check_invalid("1:30-1:00:60");
+    check_invalid("1:2:3:4-");
+    check_invalid("1.-2");
+    check_invalid("1:-2");
+
+    /* End must come after start */
+    check_invalid("20-10");
+    check_invalid("1:30-90");
+
+    /* Field out of range */
+    check_invalid("360000-");
+
+    assert_int_equal(cli_parse_time_range(NULL, NULL, NULL), -1);
+}
+
+/* =============================================================================
+ * Main
+ * ===========================================================================*/
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_time_range_fields),
+        cmocka_unit_test(test_time_range_open_end),
+        cmocka_unit_test(test_time_range_invalid),
+    };
+
+    return cmocka_run_group_tests_name("CLI Helpers", tests, NULL, NULL);
+}
@@ -0,0 +1,388 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Unit tests for the dsdpipe resume journal using CMocka
+ * Records completed track outputs, reloads the journal and checks which
+ * records still count: a changed sink configuration, a changed source or
+ * a partial output file must make a track be converted again. A pipeline
+ * run over a generated DSF file checks that a --range excerpt is not
+ * taken for the whole track, or the other way round.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "journal.h"
+
+#include <libdsdpipe/dsdpipe.h>
+#include <libdsf/dsf.h>
+#include <libsautil/mem.h>
+#include <libsautil/sa_path.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define rmdir _rmdir
+#else
+#include <unistd.h>
+#endif
+
+#define TEST_JOURNAL    "test_dsdpipe_journal." DSDPIPE_JOURNAL_EXT
+#define TEST_SOURCE     "test_dsdpipe_journal_source.iso"
+#define TEST_OUTPUT_1   "test_dsdpipe_journal_01.dsf"
+#define TEST_OUTPUT_2   "test_dsdpipe_journal_02.dsf"
+#define TEST_SIG        "dsf:ch2:fs2822400:id3=1"
+
+#define TEST_DSF_SOURCE "test_dsdpipe_journal_src.dsf"
+#define TEST_OUT_DIR    "test_dsdpipe_journal_out"
+#define TEST_DSF_SECONDS 2
+
+/* =============================================================================
+ * Helpers
+ * ===========================================================================*/
+
+static void write_file(const char *path, size_t size)
+{
+    FILE *f = fopen(path, "wb");
+    assert_non_null(f);
+    for (size_t i = 0; i < size; i++) {
+        fputc((int)(i & 0xFF), f);
+    }
+    fclose(f);
+}
+
+static void append_line(const char *path, const char *line)
+{
+    FILE *f = fopen(path, "a");
+    assert_non_null(f);
+    fputs(line, f);
+    fclose(f);
+}
+
+static int setup_files(void **state)
+{
+    (void)state;
+    remove(TEST_JOURNAL);
+    write_file(TEST_SOURCE, 4096);
+    write_file(TEST_OUTPUT_1, 1000);
+    write_file(TEST_OUTPUT_2, 2000);
+    return 0;
+}
+
+static int teardown_files(void **state)
+{
+    (void)state;
+    remove(TEST_JOURNAL);
+    remove(TEST_SOURCE);
+    remove(TEST_OUTPUT_1);
+    remove(TEST_OUTPUT_2);
+    return 0;
+}
+
+static dsdpipe_journal_t *open_journal(void)
+{
+    dsdpipe_journal_t *journal = NULL;
+    assert_int_equal(dsdpipe_journal_open(&journal, TEST_JOURNAL, TEST_SOURCE),
+                     DSDPIPE_OK);
+    assert_non_null(journal);
+    return journal;
+}
+
+static void write_dsf_source(void)
+{
+    dsf_t *file = NULL;
+    uint8_t block[4096];
+    uint64_t written = 0;
+
+    for (size_t i = 0; i < sizeof(block); i++) {
+        block[i] = (i & 1) ? 0x69 : 0x96;
+    }
+
+    assert_int_equal(dsf_alloc(&file), DSF_SUCCESS);
+    assert_int_equal(dsf_create(file, TEST_DSF_SOURCE, DSF_SAMPLE_FREQ_64FS,
+                                DSF_CHANNEL_TYPE_STEREO, 2,
+                                DSF_BITS_PER_SAMPLE_1),
+                     DSF_SUCCESS);
+
+    /* DSD64 stereo: 705600 bytes per second */
+    size_t remaining = 705600 * TEST_DSF_SECONDS;
+    while (remaining > 0) {
+        size_t n = remaining < sizeof(block) ? remaining : sizeof(block);
+        assert_int_equal(dsf_write_audio_data(file, block, n, &written),
+                         DSF_SUCCESS);
+        remaining -= n;
+    }
+
+    dsf_finalize(file);
+    dsf_close(file);
+    dsf_free(file);
+}
+
+static long file_size(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return -1;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+/**
+ * @brief Convert the DSF source to DSF, optionally a range, with a journal
+ */
+static void run_dsf_pipeline(const char *journal_path, uint32_t start_ms,
+                             uint32_t end_ms)
+{
+    dsdpipe_t *pipe = dsdpipe_create();
+    assert_non_null(pipe);
+
+    assert_int_equal(dsdpipe_set_source_dsf(pipe, TEST_DSF_SOURCE), DSDPIPE_OK);
+    if (end_ms > 0) {
+        assert_int_equal(dsdpipe_select_range(pipe, 1, start_ms, end_ms),
+                         DSDPIPE_OK);
+    } else {
+        assert_int_equal(dsdpipe_select_all_tracks(pipe), DSDPIPE_OK);
+    }
+    assert_int_equal(dsdpipe_set_track_filename_format(pipe,
+                                                       DSDPIPE_TRACK_NUM_ONLY),
+                     DSDPIPE_OK);
+    assert_int_equal(dsdpipe_add_sink_dsf(pipe, TEST_OUT_DIR, false), DSDPIPE_OK);
+    assert_int_equal(dsdpipe_set_journal(pipe, journal_path), DSDPIPE_OK);
+    assert_int_equal(dsdpipe_run(pipe), DSDPIPE_OK);
+
+    dsdpipe_destroy(pipe);
+}
+
+static int setup_pipeline(void **state)
+{
+    (void)state;
+    remove(TEST_JOURNAL);
+    write_dsf_source();
+    return 0;
+}
+
+static int teardown_pipeline(void **state)
+{
+    (void)state;
+    char *output = sa_make_path(TEST_OUT_DIR, NULL, "01", "dsf");
+    if (output) {
+        remove(output);
+        sa_free(output);
+    }
+    rmdir(TEST_OUT_DIR);
+    remove(TEST_JOURNAL);
+    remove(TEST_DSF_SOURCE);
+    return 0;
+}
+
+/* =============================================================================
+ * Tests
+ * ===========================================================================*/
+
+/**
+ * @brief Records survive closing and reopening the journal
+ */
+static void test_journal_record_reload(void **state)
+{
+    (void)state;
+    dsdpipe_journal_t *journal = open_journal();
+
+    assert_false(dsdpipe_journal_is_complete(journal, 1, TEST_SIG, TEST_OUTPUT_1));
+    assert_int_equal(dsdpipe_journal_record(journal, 1, TEST_SIG, TEST_OUTPUT_1),
+                     DSDPIPE_OK);
+    assert_true(dsdpipe_journal_is_complete(journal, 1, TEST_SIG, TEST_OUTPUT_1));
+    dsdpipe_journal_close(journal);
+
+    journal = open_journal();
+    assert_true(dsdpipe_journal_is_complete(journal, 1, TEST_SIG, TEST_OUTPUT_1));
+    assert_false(dsdpipe_journal_is_complete(journal, 2, TEST_SIG, TEST_OUTPUT_2));
+    assert_int_equal(dsdpipe_journal_record(journal, 2, TEST_SIG, TEST_OUTPUT_2),
+                     DSDPIPE_OK);
+    dsdpipe_journal_close(journal);
+
+    journal = open_journal();
+    assert_true(dsdpipe_journal_is_complete(journal, 1, TEST_SIG, TEST_OUTPUT_1));
+    assert_true(dsdpipe_journal_is_complete(journal, 2, TEST_SIG, TEST_OUTPUT_2));
+    dsdpipe_journal_close(journal);
+}
+
+/**
+ * @brief A different sink configuration or output path is not complete
+ */
+static void test_journal_signature_mismatch(void **state)
+{
+    (void)state;
+    dsdpipe_journal_t *journal = open_journal();
+
+    assert_int_equal(dsdpipe_journal_record(journal, 1, TEST_SIG, TEST_OUTPUT_1),
+                     DSDPIPE_OK);
+    dsdpipe_journal_close(journal);
+
+    journal = open_journal();
+    assert_false(dsdpipe_journal_is_complete(journal, 1,
+                                             "dsf:ch2:fs2822400:id3=0",
+                                             TEST_OUTPUT_1));
+    assert_false(dsdpipe_journal_is_complete(journal, 1, TEST_SIG, TEST_OUTPUT_2));
+    assert_false(dsdpipe_journal_is_complete(journal, 2, TEST_SIG, TEST_OUTPUT_1));
+    dsdpipe_journal_close(journal);
+}
+
+/**
+ * @brief Records of an older copy of the source are dropped
+ */
+static void test_journal_source_changed(void **state)
+{
+    (void)state;
+    dsdpipe_journal_t *journal = open_journal();
+
+    assert_int_equal(dsdpipe_journal_record(journal, 1, TEST_SIG, TEST_OUTPUT_1),
+                     DSDPIPE_OK);
+    dsdpipe_journal_close(journal);
+
+    write_file(TEST_SOURCE, 8192);
+
+    journal = open_journal();
+    assert_false(dsdpipe_journal_is_complete(journal, 1, TEST_SIG, TEST_OUTPUT_1));
+    dsdpipe_journal_close(journal);
+}
+
+/**
+ * @brief Partial outputs and interrupted journal writes are redone
+ *
+ * An output cut short by an interruption, or removed, no longer matches
+ * its recorded size; a record cut short mid-line is ignored.
+ */
+static void test_journal_partial_output(void **state)
+{
+    (void)state;
+    dsdpipe_journal_t *journal = open_journal();
+
+    assert_int_equal(dsdpipe_journal_record(journal, 1, TEST_SIG, TEST_OUTPUT_1),
+                     DSDPIPE_OK);
+    assert_int_equal(dsdpipe_journal_record(journal, 2, TEST_SIG, TEST_OUTPUT_2),
+                     DSDPIPE_OK);
+    dsdpipe_journal_close(journal);
+
+    write_file(TEST_OUTPUT_1, 600);
+    remove(TEST_OUTPUT_2);
+    append_line(TEST_JOURNAL, "T\t3\t4096");
+
+    journal = open_journal();
+    assert_false(dsdpipe_journal_is_complete(journal, 1, TEST_SIG, TEST_OUTPUT_1));
+    assert_false(dsdpipe_journal_is_complete(journal, 2, TEST_SIG, TEST_OUTPUT_2));
+
+    /* Redoing the track records the new output */
+    assert_int_equal(dsdpipe_journal_record(journal, 1, TEST_SIG, TEST_OUTPUT_1),
+                     DSDPIPE_OK);
+    assert_true(dsdpipe_journal_is_complete(journal, 1, TEST_SIG, TEST_OUTPUT_1));
+    dsdpipe_journal_close(journal);
+
+    journal = open_journal();
+    assert_true(dsdpipe_journal_is_complete(journal, 1, TEST_SIG, TEST_OUTPUT_1));
+    dsdpipe_journal_close(journal);
+}
+
+/**
+ * @brief A range excerpt and the whole track do not satisfy each other
+ *
+ * Both are written to the same file, so resuming with a different --range
+ * (or without one) must convert the track again instead of keeping the
+ * output of the previous run.
+ */
+static void test_journal_range(void **state)
+{
+    (void)state;
+    char *output = sa_make_path(TEST_OUT_DIR, NULL, "01", "dsf");
+    assert_non_null(output);
+
+    run_dsf_pipeline(TEST_JOURNAL, 0, 0);
+    long full_size = file_size(output);
+    assert_true(full_size > 705600);
+
+    /* Excerpt after the whole track: redone, not skipped */
+    run_dsf_pipeline(TEST_JOURNAL, 500, 1000);
+    long range_size = file_size(output);
+    assert_true(range_size > 0);
+    assert_true(range_size < full_size / 2);
+
+    /* Same excerpt again: skipped, output kept */
+    run_dsf_pipeline(TEST_JOURNAL, 500, 1000);
+    assert_int_equal(file_size(output), range_size);
+
+    /* Another excerpt: redone */
+    run_dsf_pipeline(TEST_JOURNAL, 0, 1500);
+    assert_true(file_size(output) > range_size);
+
+    /* Whole track after the excerpts: redone */
+    run_dsf_pipeline(TEST_JOURNAL, 0, 0);
+    assert_int_equal(file_size(output), full_size);
+
+    sa_free(output);
+}
+
+/**
+ * @brief Invalid arguments
+ */
+static void test_journal_invalid(void **state)
+{
+    (void)state;
+    dsdpipe_journal_t *journal = NULL;
+
+    assert_int_equal(dsdpipe_journal_open(NULL, TEST_JOURNAL, TEST_SOURCE),
+                     DSDPIPE_ERROR_INVALID_ARG);
+    assert_int_equal(dsdpipe_journal_open(&journal, NULL, TEST_SOURCE),
+                     DSDPIPE_ERROR_INVALID_ARG);
+    assert_null(journal);
+
+    journal = open_journal();
+    assert_int_not_equal(dsdpipe_journal_record(journal, 1, TEST_SIG,
+                                                "test_dsdpipe_journal_missing.dsf"),
+                         DSDPIPE_OK);
+    assert_false(dsdpipe_journal_is_complete(NULL, 1, TEST_SIG, TEST_OUTPUT_1));
+    dsdpipe_journal_close(journal);
+    dsdpipe_journal_close(NULL);
+}
+
+/* =============================================================================
+ * Main
+ * ===========================================================================*/
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_journal_record_reload,
+                                        setup_files, teardown_files),
+        cmocka_unit_test_setup_teardown(test_journal_signature_mismatch,
+                                        setup_files, teardown_files),
+        cmocka_unit_test_setup_teardown(test_journal_source_changed,
+                                        setup_files, teardown_files),
+        cmocka_unit_test_setup_teardown(test_journal_partial_output,
+                                        setup_files, teardown_files),
+        cmocka_unit_test_setup_teardown(test_journal_range,
+                                        setup_pipeline, teardown_pipeline),
+        cmocka_unit_test_setup_teardown(test_journal_invalid,
+                                        setup_files, teardown_files),
+    };
+
+    return cmocka_run_group_tests_name("Resume Journal", tests, NULL, NULL);
+}
@@ -0,0 +1,275 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Unit tests for the dsdpipe stream sink using CMocka
+ * Runs a generated DSF file through the sink behind dsdctl's "-" output
+ * and checks the raw DSD and WAV streams written to a file descriptor.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <libdsdpipe/dsdpipe.h>
+#include <libdsf/dsf.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define fileno _fileno
+#define write _write
+#else
+#include <unistd.h>
+#endif
+
+#define TEST_SOURCE     "test_dsdpipe_stream_src.dsf"
+#define TEST_OUTPUT     "test_dsdpipe_stream.out"
+
+/** Bytes per channel: about one second of DSD64, in whole DSF blocks */
+#define TEST_DSD_BYTES  (86 * 4096)
+
+/* =============================================================================
+ * Helpers
+ * ===========================================================================*/
+
+/** Byte @p i of channel @p ch in the generated source */
+static uint8_t source_byte(size_t i, unsigned int ch)
+{
+    return (uint8_t)((i * 3 + ch * 0x55) & 0xFF);
+}
+
+static int setup_source(void **state)
+{
+    (void)state;
+    dsf_t *file = NULL;
+    uint8_t block[4096];
+    uint64_t written = 0;
+    size_t pos = 0;
+
+    assert_int_equal(dsf_alloc(&file), DSF_SUCCESS);
+    assert_int_equal(dsf_create(file, TEST_SOURCE, DSF_SAMPLE_FREQ_64FS,
+                                DSF_CHANNEL_TYPE_STEREO, 2,
+                                DSF_BITS_PER_SAMPLE_1),
+                     DSF_SUCCESS);
+
+    /* Byte-interleaved, as dsf_write_audio_data() takes it */
+    while (pos < TEST_DSD_BYTES) {
+        size_t n = 0;
+        while (n < sizeof(block) && pos < TEST_DSD_BYTES) {
+            block[n++] = source_byte(pos, 0);
+            block[n++] = source_byte(pos, 1);
+            pos++;
+        }
+        assert_int_equal(dsf_write_audio_data(file, block, n, &written),
+                         DSF_SUCCESS);
+    }
+
+    dsf_finalize(file);
+    dsf_close(file);
+    dsf_free(file);
+    return 0;
+}
+
+static int teardown_source(void **state)
+{
+    (void)state;
+    remove(TEST_SOURCE);
+    remove(TEST_OUTPUT);
+    return 0;
+}
+
+/**
+ * @brief Convert the source to a stream on an open descriptor
+ *
+ * The descriptor stays open across the run, as standard output does in
+ * dsdctl; the contents are returned once it is closed.
+ */
+static uint8_t *run_stream(dsdpipe_stream_format_t format, int bit_depth,
+                           int compression, size_t *size)
+{
+    FILE *out = fopen(TEST_OUTPUT, "wb");
+    assert_non_null(out);
+
+    dsdpipe_t *pipe = dsdpipe_create();
+    assert_non_null(pipe);
+    assert_int_equal(dsdpipe_set_source_dsf(pipe, TEST_SOURCE), DSDPIPE_OK);
+    assert_int_equal(dsdpipe_select_all_tracks(pipe), DSDPIPE_OK);
+    assert_int_equal(dsdpipe_add_sink_stream(pipe, fileno(out), format,
+                                             bit_depth, compression),
+                     DSDPIPE_OK);
+    assert_int_equal(dsdpipe_run(pipe), DSDPIPE_OK);
+    dsdpipe_destroy(pipe);
+
+    /* The pipeline must not have closed the caller's descriptor */
+    assert_int_equal(write(fileno(out), "", 0), 0);
+    fclose(out);
+
+    FILE *in = fopen(TEST_OUTPUT, "rb");
+    assert_non_null(in);
+    fseek(in, 0, SEEK_END);
+    long length = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    assert_true(length > 0);
+
+    uint8_t *data = (uint8_t *)malloc((size_t)length);
+    assert_non_null(data);
+    assert_int_equal(fread(data, 1, (size_t)length, in), (size_t)length);
+    fclose(in);
+
+    *size = (size_t)length;
+    return data;
+}
+
+static uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* =============================================================================
+ * Tests
+ * ===========================================================================*/
+
+/**
+ * @brief Raw DSD is the source, byte-interleaved, with nothing added
+ */
+static void test_stream_raw_dsd(void **state)
+{
+    (void)state;
+    size_t size = 0;
+    uint8_t *data = run_stream(DSDPIPE_STREAM_RAW_DSD, 0, 5, &size);
+
+    assert_int_equal(size, 2 * TEST_DSD_BYTES);
+    for (size_t i = 0; i < TEST_DSD_BYTES; i++) {
+        assert_int_equal(data[2 * i], source_byte(i, 0));
+        assert_int_equal(data[2 * i + 1], source_byte(i, 1));
+    }
+
+    free(data);
+}
+
+/**
+ * @brief WAV carries streaming sizes and whole sample frames
+ */
+static void test_stream_wav(void **state)
+{
+    (void)state;
+    size_t size = 0;
+    uint8_t *data = run_stream(DSDPIPE_STREAM_WAV, 24, 5, &size);
+
+    assert_true(size > 44);
+    assert_memory_equal(data, "RIFF", 4);
+    assert_int_equal(get_le32(data + 4), 0xFFFFFFFFu);
+    assert_memory_equal(data + 8, "WAVEfmt ", 8);
+
+    /* Walk to the data chunk */
+    size_t pos = 12;
+    while (pos + 8 <= size && memcmp(data + pos, "data", 4) != 0) {
+        pos += 8 + get_le32(data + pos + 4);
+    }
+    assert_true(pos + 8 <= size);
+    assert_int_equal(get_le32(data + pos + 4), 0xFFFFFFFFu);
+
+    /* 2 channels x 3 bytes per sample frame */
+    size_t payload = size - pos - 8;
+    assert_true(payload > 0);
+    assert_int_equal(payload % 6, 0);
+
+    free(data);
+}
+
+/**
+ * @brief FLAC uses the configured compression level
+ */
+static void test_stream_flac(void **state)
+{
+    (void)state;
+    size_t fast_size = 0;
+    size_t best_size = 0;
+
+    if (!dsdpipe_has_flac_support()) {
+        skip();
+    }
+
+    uint8_t *fast = run_stream(DSDPIPE_STREAM_FLAC, 16, 0, &fast_size);
+    uint8_t *best = run_stream(DSDPIPE_STREAM_FLAC, 16, 8, &best_size);
+
+    assert_memory_equal(fast, "fLaC", 4);
+    assert_memory_equal(best, "fLaC", 4);
+    assert_true(best_size <= fast_size);
+
+    free(fast);
+    free(best);
+}
+
+/**
+ * @brief Invalid stream sink configurations are rejected
+ */
+static void test_stream_invalid(void **state)
+{
+    (void)state;
+    dsdpipe_t *pipe = dsdpipe_create();
+    assert_non_null(pipe);
+
+    assert_int_equal(dsdpipe_add_sink_stream(NULL, 1, DSDPIPE_STREAM_WAV, 16, 5),
+                     DSDPIPE_ERROR_INVALID_ARG);
+    assert_int_equal(dsdpipe_add_sink_stream(pipe, -1, DSDPIPE_STREAM_WAV, 16, 5),
+                     DSDPIPE_ERROR_INVALID_ARG);
+    assert_int_equal(dsdpipe_add_sink_stream(pipe, 1, DSDPIPE_STREAM_WAV, 20, 5),
+                     DSDPIPE_ERROR_INVALID_ARG);
+    if (dsdpipe_has_flac_support()) {
+        assert_int_equal(dsdpipe_add_sink_stream(pipe, 1, DSDPIPE_STREAM_FLAC,
+                                                 32, 5),
+                         DSDPIPE_ERROR_INVALID_ARG);
+        assert_int_equal(dsdpipe_add_sink_stream(pipe, 1, DSDPIPE_STREAM_FLAC,
+                                                 24, 9),
+                         DSDPIPE_ERROR_INVALID_ARG);
+    }
+
+    /* The compression level only matters for FLAC */
+    assert_int_equal(dsdpipe_add_sink_stream(pipe, 1, DSDPIPE_STREAM_WAV, 16, -1),
+                     DSDPIPE_OK);
+
+    /* One sink per descriptor */
+    assert_int_equal(dsdpipe_add_sink_stream(pipe, 1, DSDPIPE_STREAM_RAW_DSD, 0, 5),
+                     DSDPIPE_ERROR_INVALID_ARG);
+    assert_int_equal(dsdpipe_get_sink_count(pipe), 1);
+
+    dsdpipe_destroy(pipe);
+}
+
+/* =============================================================================
+ * Main
+ * ===========================================================================*/
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_stream_raw_dsd,
+                                        setup_source, teardown_source),
+        cmocka_unit_test_setup_teardown(test_stream_wav,
+                                        setup_source, teardown_source),
+        cmocka_unit_test_setup_teardown(test_stream_flac,
+                                        setup_source, teardown_source),
+        cmocka_unit_test(test_stream_invalid),
+    };
+
+    return cmocka_run_group_tests_name("Stream Sink", tests, NULL, NULL);
+}
@@ -952,6 +952,86 @@ static void test_large_audio_write(void **state)
     sa_free(buffer);
 }
 
+/* =============================================================================
+ * Test: Format Conversion
+ * ===========================================================================*/
+
+static uint8_t reverse_bits(uint8_t v)
+{
+    uint8_t r = 0;
+    for (int b = 0; b < 8; b++) {
+        r = (uint8_t)((r << 1) | ((v >> b) & 1));
+    }
+    return r;
+}
+
+static void test_convert_interleaving(void **state)
+{
+    (void)state;
+    /* Mono up to 6 channels, sizes with a partial last block and a tail
+     * shorter than any SIMD kernel's step */
+    const uint32_t channel_counts[] = { 1, 2, 3, 4, 5, 6 };
+    const size_t sizes[] = { 1, 37, DSF_BLOCK_SIZE_PER_CHANNEL, DSF_BLOCK_SIZE_PER_CHANNEL * 2 + 13 };
+    size_t max_groups = 3;
+    size_t max_size = DSF_BLOCK_SIZE_PER_CHANNEL * max_groups * 6;
+    uint8_t *dsdiff = (uint8_t *)sa_malloc(max_size);
+    uint8_t *dsf = (uint8_t *)sa_malloc(max_size);
+    uint8_t *back = (uint8_t *)sa_malloc(max_size);
+    assert_non_null(dsdiff);
+    assert_non_null(dsf);
+    assert_non_null(back);
+
+    for (size_t c = 0; c < sizeof(channel_counts) / sizeof(channel_counts[0]); c++) {
+        uint32_t channels = channel_counts[c];
+
+        for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+            size_t per_channel = sizes[k];
+            size_t groups = (per_channel + DSF_BLOCK_SIZE_PER_CHANNEL - 1) / DSF_BLOCK_SIZE_PER_CHANNEL;
+            size_t dsf_size = 0;
+            size_t dsdiff_size = 0;
+
+            for (size_t i = 0; i < per_channel * channels; i++) {
+                dsdiff[i] = (uint8_t)(i * 131 + channels * 7 + 1);
+            }
+
+            assert_int_equal(dsf_convert_dsd_to_block_interleaved(dsdiff, dsf,
+                                                                  per_channel * channels,
+                                                                  channels, &dsf_size),
+                             DSF_SUCCESS);
+            assert_int_equal(dsf_size, groups * DSF_BLOCK_SIZE_PER_CHANNEL * channels);
+
+            for (size_t i = 0; i < groups * DSF_BLOCK_SIZE_PER_CHANNEL; i++) {
+                size_t group = i / DSF_BLOCK_SIZE_PER_CHANNEL;
+                size_t pos = i % DSF_BLOCK_SIZE_PER_CHANNEL;
+                for (uint32_t ch = 0; ch < channels; ch++) {
+                    uint8_t got = dsf[(group * channels + ch) * DSF_BLOCK_SIZE_PER_CHANNEL + pos];
+                    uint8_t want = (i < per_channel) ? reverse_bits(dsdiff[i * channels + ch]) : 0;
+                    assert_int_equal(got, want);
+                }
+            }
+
+            assert_int_equal(dsf_convert_dsd_to_byte_interleaved(dsf, back, dsf_size,
+                                                                 channels, &dsdiff_size),
+                             DSF_SUCCESS);
+            assert_int_equal(dsdiff_size, dsf_size);
+            assert_memory_equal(back, dsdiff, per_channel * channels);
+        }
+    }
+
+    /* Invalid input */
+    size_t out_size;
+    assert_int_not_equal(dsf_convert_dsd_to_block_interleaved(dsdiff, dsf, 3, 2, &out_size),
+                         DSF_SUCCESS);
+    assert_int_not_equal(dsf_convert_dsd_to_block_interleaved(dsdiff, dsf, 16, 0, &out_size),
+                         DSF_SUCCESS);
+    assert_int_not_equal(dsf_convert_dsd_to_byte_interleaved(dsf, back, 100, 2, &out_size),
+                         DSF_SUCCESS);
+
+    sa_free(dsdiff);
+    sa_free(dsf);
+    sa_free(back);
+}
+
 /* =============================================================================
  * Main Test Runner
  * ===========================================================================*/
@@ -1010,6 +1090,10 @@ int main(void)
         cmocka_unit_test(test_large_audio_write),
     };
 
+    const struct CMUnitTest conversion_tests[] = {
+        cmocka_unit_test(test_convert_interleaving),
+    };
+
     int failed = 0;
 
     failed += cmocka_run_group_tests_name("Allocation/Deallocation Tests",
@@ -1032,6 +1116,8 @@ int main(void)
                                           file_removal_tests, NULL, NULL);
     failed += cmocka_run_group_tests_name("Large File Tests",
                                           large_file_tests, NULL, group_teardown);
+    failed += cmocka_run_group_tests_name("Format Conversion Tests",
+                                          conversion_tests, NULL, NULL);
 
     return failed;
 }
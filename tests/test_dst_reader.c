@@ -8,6 +8,9 @@
  * - Sequential frame reading using sacd_get_sound_data()
  * - Correct state maintenance during sequential reads (no continuous seeking)
  * - DST frame header verification
+ * - Frame index build, sidecar save and reload
+ * - Lazy TOC parsing against the full parse
+ * - Batched zero-copy frame reads against sacd_get_sound_data()
  * Usage: test_dst_reader [iso_path]
  *        Default iso_path is "data/dst.iso" relative to working directory.
  *
@@ -341,6 +344,431 @@ static int test_seek_then_sequential(sacd_t *ctx, uint32_t total_frames)
     return 0;
 }
 
+/**
+ * @brief Test the frame index and its sidecar file.
+ *
+ * Builds the full index, saves it, loads it into a second reader and checks
+ * that both readers locate the same sectors for frames across the area.
+ *
+ * @param[in] ctx          SACD reader context
+ * @param[in] iso_path     ISO path (to open the second reader)
+ * @param[in] channel_type Selected area
+ * @param[in] total_frames Total number of frames in the area
+ * @return 0 on success, non-zero on failure
+ */
+static int test_frame_index(sacd_t *ctx, const char *iso_path,
+                            channel_t channel_type, uint32_t total_frames)
+{
+    const char *sidecar = "test_dst_reader.idx";
+    sacd_t *loaded;
+    uint32_t sector_a = 0, sector_b = 0;
+    int count_a = 0, count_b = 0;
+    int result;
+    int failed = 0;
+
+    printf("\n=== Testing Frame Index ===\n");
+
+    result = sacd_build_frame_index(ctx);
+    if (result != SACD_OK) {
+        printf("ERROR: Building frame index failed (error=%d)\n", result);
+        return -1;
+    }
+
+    result = sacd_save_frame_index(ctx, sidecar);
+    if (result == SACD_NOT_AVAILABLE) {
+        printf("Area is not DST coded, no sidecar to test.\n");
+        return 0;
+    }
+    if (result != SACD_OK) {
+        printf("ERROR: Saving frame index failed (error=%d)\n", result);
+        return -1;
+    }
+
+    loaded = sacd_create();
+    if (!loaded || sacd_init(loaded, iso_path, 1, 1) != SACD_OK ||
+        sacd_select_channel_type(loaded, channel_type) != SACD_OK) {
+        printf("ERROR: Failed to open second reader\n");
+        sacd_destroy(loaded);
+        remove(sidecar);
+        return -1;
+    }
+
+    result = sacd_load_frame_index(loaded, sidecar);
+    if (result != SACD_OK) {
+        printf("ERROR: Loading frame index failed (error=%d)\n", result);
+        failed = 1;
+    }
+
+    for (uint32_t frame = 0; !failed && frame < total_frames;
+         frame += (total_frames / 97) + 1) {
+        if (sacd_get_frame_sector_range(ctx, frame, &sector_a, &count_a) != SACD_OK ||
+            sacd_get_frame_sector_range(loaded, frame, &sector_b, &count_b) != SACD_OK ||
+            sector_a != sector_b || count_a != count_b) {
+            printf("  Frame %u: MISMATCH (sector %u/%u, sectors %d/%d)\n",
+                   frame, sector_a, sector_b, count_a, count_b);
+            failed = 1;
+        }
+    }
+
+    sacd_close(loaded);
+    sacd_destroy(loaded);
+    remove(sidecar);
+
+    if (failed) {
+        return -1;
+    }
+
+    printf("Frame index test PASSED: sidecar round trip matches.\n");
+    return 0;
+}
+
+/**
+ * @brief Test readers created with sacd_clone().
+ *
+ * Clones the reader, closes the original and checks that the clone still
+ * reads the same frames, so the shared TOC data outlives the original.
+ *
+ * @param[in] iso_path     ISO path (to open the original reader)
+ * @param[in] channel_type Selected area
+ * @param[in] total_frames Total number of frames in the area
+ * @return 0 on success, non-zero on failure
+ */
+static int test_clone(const char *iso_path, channel_t channel_type,
+                      uint32_t total_frames)
+{
+    sacd_t *original = NULL;
+    sacd_t *clone = NULL;
+    uint8_t *buffer_a = NULL;
+    uint8_t *buffer_b = NULL;
+    uint32_t frames = (total_frames < SEQUENTIAL_TEST_FRAMES) ?
+                      total_frames : SEQUENTIAL_TEST_FRAMES;
+    uint32_t frame_count;
+    uint16_t sizes[SEQUENTIAL_TEST_FRAMES];
+    uint16_t size_b = 0;
+    int result;
+    int failed = 0;
+
+    printf("\n=== Testing Reader Clones ===\n");
+
+    original = sacd_create();
+    if (!original || sacd_init(original, iso_path, 1, 1) != SACD_OK) {
+        printf("ERROR: Failed to open reader\n");
+        sacd_destroy(original);
+        return -1;
+    }
+
+    result = sacd_clone(original, &clone);
+    if (result == SACD_NOT_AVAILABLE) {
+        printf("Input cannot be shared, nothing to test.\n");
+        sacd_destroy(original);
+        return 0;
+    }
+    if (result != SACD_OK) {
+        printf("ERROR: Cloning reader failed (error=%d)\n", result);
+        sacd_destroy(original);
+        return -1;
+    }
+
+    buffer_a = (uint8_t *)sa_malloc(DST_FRAME_BUFFER_SIZE * frames);
+    buffer_b = (uint8_t *)sa_malloc(DST_FRAME_BUFFER_SIZE);
+    if (!buffer_a || !buffer_b ||
+        sacd_select_channel_type(original, channel_type) != SACD_OK ||
+        sacd_select_channel_type(clone, channel_type) != SACD_OK) {
+        printf("ERROR: Failed to prepare readers\n");
+        failed = 1;
+    }
+
+    /* Read through the original, then drop it before reading the clone */
+    for (uint32_t i = 0; !failed && i < frames; i++) {
+        frame_count = 1;
+        if (sacd_get_sound_data(original, buffer_a + i * DST_FRAME_BUFFER_SIZE,
+                                i, &frame_count, &sizes[i]) != SACD_OK) {
+            printf("  Frame %u: READ FAILED on original\n", i);
+            failed = 1;
+        }
+    }
+    sacd_destroy(original);
+
+    for (uint32_t i = 0; !failed && i < frames; i++) {
+        uint8_t *expected = buffer_a + i * DST_FRAME_BUFFER_SIZE;
+        frame_count = 1;
+        if (sacd_get_sound_data(clone, buffer_b, i, &frame_count,
+                                &size_b) != SACD_OK ||
+            sizes[i] != size_b || memcmp(expected, buffer_b, size_b) != 0) {
+            printf("  Frame %u: MISMATCH on clone (size %u/%u)\n",
+                   i, sizes[i], size_b);
+            failed = 1;
+        }
+    }
+
+    sacd_destroy(clone);
+    sa_free(buffer_a);
+    sa_free(buffer_b);
+
+    if (failed) {
+        return -1;
+    }
+
+    printf("Clone test PASSED: %u frames match after closing the original.\n",
+           frames);
+    return 0;
+}
+
+/**
+ * @brief Compare text, ISRC and seek results of two readers on one area.
+ *
+ * @return 0 if they match, non-zero otherwise
+ */
+static int compare_readers(sacd_t *a, sacd_t *b, uint32_t total_frames)
+{
+    uint8_t track_count_a = 0, track_count_b = 0;
+    const char *text_a = NULL;
+    const char *text_b = NULL;
+    uint32_t frame = total_frames / 2;
+    uint32_t start_a = 0, start_b = 0;
+    int count_a = 0, count_b = 0;
+
+    if (sacd_get_track_count(a, &track_count_a) != SACD_OK ||
+        sacd_get_track_count(b, &track_count_b) != SACD_OK ||
+        track_count_a != track_count_b) {
+        printf("  Track count differs: %u/%u\n", track_count_a, track_count_b);
+        return -1;
+    }
+
+    for (uint8_t track = 1; track <= track_count_a; track++) {
+        area_isrc_t isrc_a, isrc_b;
+        int res_a, res_b;
+
+        memset(&isrc_a, 0, sizeof(isrc_a));
+        memset(&isrc_b, 0, sizeof(isrc_b));
+        sacd_get_track_isrc_num(a, track, &isrc_a);
+        sacd_get_track_isrc_num(b, track, &isrc_b);
+        if (memcmp(&isrc_a, &isrc_b, sizeof(isrc_a)) != 0) {
+            printf("  Track %u: ISRC differs\n", track);
+            return -1;
+        }
+
+        text_a = text_b = NULL;
+        res_a = sacd_get_track_text(a, track, 1, TRACK_TYPE_TITLE, &text_a);
+        res_b = sacd_get_track_text(b, track, 1, TRACK_TYPE_TITLE, &text_b);
+        if (res_a != res_b || (text_a == NULL) != (text_b == NULL) ||
+            (text_a && strcmp(text_a, text_b) != 0)) {
+            printf("  Track %u: title differs\n", track);
+            return -1;
+        }
+    }
+
+    text_a = text_b = NULL;
+    sacd_get_area_text(a, 1, AREA_TEXT_TYPE_NAME, &text_a);
+    sacd_get_area_text(b, 1, AREA_TEXT_TYPE_NAME, &text_b);
+    if ((text_a == NULL) != (text_b == NULL) ||
+        (text_a && strcmp(text_a, text_b) != 0)) {
+        printf("  Area name differs\n");
+        return -1;
+    }
+
+    /* The access list is part of the deferred data too */
+    if (sacd_get_frame_sector_range(a, frame, &start_a, &count_a) !=
+            sacd_get_frame_sector_range(b, frame, &start_b, &count_b) ||
+        start_a != start_b || count_a != count_b) {
+        printf("  Frame %u: sector range differs\n", frame);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Test a reader initialized with SACD_INIT_LAZY_TOC.
+ *
+ * The deferred data is first decoded through a clone, which must see the
+ * same text, ISRCs and frame positions as the fully parsed reader; the
+ * lazy reader itself then picks up what the clone decoded.
+ *
+ * @param[in] ctx          Fully initialized reader
+ * @param[in] iso_path     ISO path (to open the lazy reader)
+ * @param[in] channel_type Selected area
+ * @param[in] total_frames Total number of frames in the area
+ * @return 0 on success, non-zero on failure
+ */
+static int test_lazy_toc(sacd_t *ctx, const char *iso_path,
+                         channel_t channel_type, uint32_t total_frames)
+{
+    sacd_t *lazy = NULL;
+    sacd_t *clone = NULL;
+    int failed = 0;
+
+    printf("\n=== Testing Lazy TOC Parsing ===\n");
+
+    lazy = sacd_create();
+    if (!lazy ||
+        sacd_init_ex(lazy, iso_path, 1, 1, SACD_INIT_LAZY_TOC) != SACD_OK ||
+        sacd_select_channel_type(lazy, channel_type) != SACD_OK) {
+        printf("ERROR: Failed to open lazy reader\n");
+        sacd_destroy(lazy);
+        return -1;
+    }
+
+    if (sacd_clone(lazy, &clone) == SACD_OK) {
+        if (sacd_select_channel_type(clone, channel_type) != SACD_OK ||
+            compare_readers(ctx, clone, total_frames) != 0) {
+            printf("ERROR: Clone of lazy reader differs\n");
+            failed = 1;
+        }
+        sacd_destroy(clone);
+    }
+
+    if (!failed && compare_readers(ctx, lazy, total_frames) != 0) {
+        printf("ERROR: Lazy reader differs\n");
+        failed = 1;
+    }
+
+    sacd_destroy(lazy);
+
+    if (failed) {
+        return -1;
+    }
+
+    printf("Lazy TOC test PASSED: deferred data matches the full parse.\n");
+    return 0;
+}
+
+/**
+ * @brief Test sacd_get_sound_frames() against sacd_get_sound_data().
+ *
+ * Reads the first SEQUENTIAL_TEST_FRAMES frames in runs of several sizes,
+ * then from a few random starting points, and compares every frame with a
+ * copy made by the single-frame API. The last run is released only after
+ * the reader is destroyed, since the frames must outlive it.
+ *
+ * @param[in] iso_path     ISO path (to open a reader of our own)
+ * @param[in] channel_type Selected area
+ * @param[in] total_frames Total number of frames in the area
+ * @return 0 on success, non-zero on failure
+ */
+static int test_sound_frames(const char *iso_path, channel_t channel_type,
+                             uint32_t total_frames)
+{
+    static const uint32_t run_sizes[] = { 1, 7, 32 };
+    sacd_frame_ref_t frames[32];
+    uint8_t *expected = NULL;
+    uint16_t *expected_size = NULL;
+    uint32_t frame_count = SEQUENTIAL_TEST_FRAMES;
+    uint32_t kept = 0;
+    sacd_t *ctx = NULL;
+    int failed = 0;
+
+    printf("\n=== Testing Batched Frame Reads ===\n");
+
+    if (frame_count > total_frames) {
+        frame_count = total_frames;
+    }
+
+    ctx = sacd_create();
+    expected = (uint8_t *)sa_malloc((size_t)frame_count * DST_FRAME_BUFFER_SIZE);
+    expected_size = (uint16_t *)sa_calloc(frame_count, sizeof(uint16_t));
+    if (!ctx || !expected || !expected_size ||
+        sacd_init(ctx, iso_path, 1, 1) != SACD_OK ||
+        sacd_select_channel_type(ctx, channel_type) != SACD_OK) {
+        printf("ERROR: Failed to open reader\n");
+        sa_free(expected);
+        sa_free(expected_size);
+        sacd_destroy(ctx);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < frame_count && !failed; i++) {
+        uint32_t one = 1;
+        if (sacd_get_sound_data(ctx, expected + (size_t)i * DST_FRAME_BUFFER_SIZE, i,
+                                &one, &expected_size[i]) != SACD_OK || one != 1) {
+            printf("ERROR: sacd_get_sound_data failed at frame %u\n", i);
+            failed = 1;
+        }
+    }
+
+    for (size_t r = 0; r < sizeof(run_sizes) / sizeof(run_sizes[0]) && !failed; r++) {
+        uint32_t frame = 0;
+
+        while (frame < frame_count && !failed) {
+            uint32_t count = run_sizes[r];
+            if (count > frame_count - frame) {
+                count = frame_count - frame;
+            }
+
+            if (sacd_get_sound_frames(ctx, frame, &count, frames) != SACD_OK || count == 0) {
+                printf("ERROR: sacd_get_sound_frames failed at frame %u\n", frame);
+                failed = 1;
+                break;
+            }
+
+            for (uint32_t i = 0; i < count && !failed; i++) {
+                if (frames[i].frame_nr != frame + i ||
+                    frames[i].size != expected_size[frame + i] ||
+                    memcmp(frames[i].data, expected + (size_t)(frame + i) * DST_FRAME_BUFFER_SIZE,
+                           frames[i].size) != 0) {
+                    printf("ERROR: Frame %u differs (run of %u)\n", frame + i, run_sizes[r]);
+                    failed = 1;
+                }
+            }
+
+            sacd_release_sound_frames(frames, count);
+            frame += count;
+        }
+    }
+
+    /* Random starting points, most of them a seek away from the last read */
+    for (int i = 0; i < SEEK_TEST_COUNT && !failed; i++) {
+        uint32_t start = (uint32_t)(rand() % (int)frame_count);
+        uint32_t count = 32;
+
+        if (sacd_get_sound_frames(ctx, start, &count, frames) != SACD_OK || count == 0) {
+            printf("ERROR: sacd_get_sound_frames failed at frame %u\n", start);
+            failed = 1;
+            break;
+        }
+        for (uint32_t j = 0; j < count && start + j < frame_count; j++) {
+            if (frames[j].size != expected_size[start + j] ||
+                memcmp(frames[j].data, expected + (size_t)(start + j) * DST_FRAME_BUFFER_SIZE,
+                       frames[j].size) != 0) {
+                printf("ERROR: Frame %u differs after seek\n", start + j);
+                failed = 1;
+                break;
+            }
+        }
+        sacd_release_sound_frames(frames, count);
+    }
+
+    if (!failed) {
+        kept = 32;
+        if (sacd_get_sound_frames(ctx, 0, &kept, frames) != SACD_OK) {
+            kept = 0;
+            failed = 1;
+        }
+    }
+
+    sacd_close(ctx);
+    sacd_destroy(ctx);
+
+    for (uint32_t i = 0; i < kept && i < frame_count && !failed; i++) {
+        if (memcmp(frames[i].data, expected + (size_t)i * DST_FRAME_BUFFER_SIZE,
+                   frames[i].size) != 0) {
+            printf("ERROR: Frame %u changed after the reader was destroyed\n", i);
+            failed = 1;
+        }
+    }
+    sacd_release_sound_frames(frames, kept);
+
+    sa_free(expected);
+    sa_free(expected_size);
+
+    if (failed) {
+        return -1;
+    }
+
+    printf("Batched frame test PASSED: %u frames match sacd_get_sound_data().\n", frame_count);
+    return 0;
+}
+
 /**
  * @brief Print disc and area summary information.
  *
@@ -514,6 +942,30 @@ int main(int argc, char *argv[])
         test_result = 1;
     }
 
+    /* Test 4: Frame index sidecar */
+    if (test_frame_index(ctx, iso_path, channel_types[0], total_frames) != 0) {
+        printf("\n*** FRAME INDEX TEST FAILED ***\n");
+        test_result = 1;
+    }
+
+    /* Test 5: Cloned readers */
+    if (test_clone(iso_path, channel_types[0], total_frames) != 0) {
+        printf("\n*** CLONE TEST FAILED ***\n");
+        test_result = 1;
+    }
+
+    /* Test 6: Lazy TOC parsing */
+    if (test_lazy_toc(ctx, iso_path, channel_types[0], total_frames) != 0) {
+        printf("\n*** LAZY TOC TEST FAILED ***\n");
+        test_result = 1;
+    }
+
+    /* Test 7: Batched zero-copy frame reads */
+    if (test_sound_frames(iso_path, channel_types[0], total_frames) != 0) {
+        printf("\n*** BATCHED FRAME TEST FAILED ***\n");
+        test_result = 1;
+    }
+
     /* Summary */
     printf("\n=================================================\n");
     if (test_result == 0) {
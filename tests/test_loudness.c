@@ -0,0 +1,294 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Unit tests for the EBU R128 loudness meter
+ * Uses the reference signals of EBU Tech 3341/3342: a 1 kHz sine at
+ * -23 dBFS on both stereo channels must read -23 LUFS, and two 20 s
+ * tones 10 dB apart must give a loudness range of 10 LU.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "loudness.h"
+
+#include <libsautil/mem.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/** Tolerance of EBU Tech 3341 for integrated loudness (LU) */
+#define LOUDNESS_TOLERANCE  0.1
+
+/* =============================================================================
+ * Helpers
+ * ===========================================================================*/
+
+/**
+ * @brief Feed a stereo sine in 1 s chunks
+ */
+static void feed_sine(dsdpipe_loudness_meter_t *meter, uint32_t sample_rate,
+                      double freq, double dbfs, double seconds, double phase)
+{
+    double amplitude = pow(10.0, dbfs / 20.0);
+    size_t total = (size_t)(seconds * sample_rate);
+    float *buf = (float *)sa_malloc((size_t)sample_rate * 2 * sizeof(float));
+    size_t pos = 0;
+
+    assert_non_null(buf);
+
+    while (pos < total) {
+        size_t n = total - pos;
+        if (n > sample_rate) {
+            n = sample_rate;
+        }
+        for (size_t i = 0; i < n; i++) {
+            double t = (double)(pos + i) / sample_rate;
+            float v = (float)(amplitude * sin(2.0 * M_PI * freq * t + phase));
+            buf[2 * i] = v;
+            buf[2 * i + 1] = v;
+        }
+        dsdpipe_loudness_meter_add_float(meter, buf, n);
+        pos += n;
+    }
+
+    sa_free(buf);
+}
+
+/* =============================================================================
+ * Test: Integrated Loudness
+ * ===========================================================================*/
+
+static void check_reference_tone(uint32_t sample_rate)
+{
+    dsdpipe_loudness_meter_t *meter = NULL;
+    dsdpipe_loudness_t result;
+
+    assert_int_equal(dsdpipe_loudness_meter_create(&meter, sample_rate, 2),
+                     DSDPIPE_OK);
+    dsdpipe_loudness_meter_start_track(meter);
+    feed_sine(meter, sample_rate, 1000.0, -23.0, 20.0, 0.0);
+    dsdpipe_loudness_meter_get_track(meter, &result);
+
+    assert_true(result.valid);
+    assert_true(fabs(result.integrated_lufs - (-23.0)) < LOUDNESS_TOLERANCE);
+    assert_true(fabs(result.replaygain_db - 5.0) < LOUDNESS_TOLERANCE);
+    assert_true(result.loudness_range_lu < 0.5);
+
+    dsdpipe_loudness_meter_destroy(meter);
+}
+
+static void test_loudness_reference_48k(void **state)
+{
+    (void)state;
+    check_reference_tone(48000);
+}
+
+static void test_loudness_reference_88k(void **state)
+{
+    (void)state;
+    check_reference_tone(88200);
+}
+
+static void test_loudness_silence(void **state)
+{
+    (void)state;
+    dsdpipe_loudness_meter_t *meter = NULL;
+    dsdpipe_loudness_t result;
+    float zeros[2 * 4800];
+
+    memset(zeros, 0, sizeof(zeros));
+
+    assert_int_equal(dsdpipe_loudness_meter_create(&meter, 48000, 2), DSDPIPE_OK);
+    dsdpipe_loudness_meter_start_track(meter);
+    for (int i = 0; i < 50; i++) {
+        dsdpipe_loudness_meter_add_float(meter, zeros, 4800);
+    }
+    dsdpipe_loudness_meter_get_track(meter, &result);
+
+    /* Nothing passes the absolute gate */
+    assert_false(result.valid);
+
+    dsdpipe_loudness_meter_destroy(meter);
+}
+
+/* =============================================================================
+ * Test: Loudness Range and Album
+ * ===========================================================================*/
+
+static void test_loudness_range(void **state)
+{
+    (void)state;
+    dsdpipe_loudness_meter_t *meter = NULL;
+    dsdpipe_loudness_t track, album;
+
+    assert_int_equal(dsdpipe_loudness_meter_create(&meter, 48000, 2), DSDPIPE_OK);
+
+    dsdpipe_loudness_meter_start_track(meter);
+    feed_sine(meter, 48000, 1000.0, -20.0, 20.0, 0.0);
+    feed_sine(meter, 48000, 1000.0, -30.0, 20.0, 0.0);
+    dsdpipe_loudness_meter_get_track(meter, &track);
+
+    assert_true(track.valid);
+    assert_true(fabs(track.loudness_range_lu - 10.0) < LOUDNESS_TOLERANCE);
+
+    /* A second, quieter track lowers the album value but not track 1 */
+    dsdpipe_loudness_meter_start_track(meter);
+    feed_sine(meter, 48000, 1000.0, -33.0, 20.0, 0.0);
+    dsdpipe_loudness_meter_get_track(meter, &track);
+    dsdpipe_loudness_meter_get_album(meter, &album);
+
+    assert_true(fabs(track.integrated_lufs - (-33.0)) < LOUDNESS_TOLERANCE);
+    assert_true(album.valid);
+    assert_true(album.integrated_lufs < -22.0);
+    assert_true(album.integrated_lufs > -33.0);
+
+    dsdpipe_loudness_meter_destroy(meter);
+}
+
+/* =============================================================================
+ * Test: True Peak
+ * ===========================================================================*/
+
+static void test_loudness_true_peak(void **state)
+{
+    (void)state;
+    dsdpipe_loudness_meter_t *meter = NULL;
+    dsdpipe_loudness_t result;
+
+    /* fs/4 sine at 45 degrees: samples hit 0.707 of the real peak */
+    assert_int_equal(dsdpipe_loudness_meter_create(&meter, 48000, 2), DSDPIPE_OK);
+    dsdpipe_loudness_meter_start_track(meter);
+    feed_sine(meter, 48000, 12000.0, -6.0, 5.0, M_PI / 4.0);
+    dsdpipe_loudness_meter_get_track(meter, &result);
+
+    assert_true(20.0 * log10(result.sample_peak) < -8.5);
+    assert_true(fabs(result.true_peak_dbtp - (-6.0)) < 0.5);
+
+    dsdpipe_loudness_meter_destroy(meter);
+}
+
+/* =============================================================================
+ * Test: SSE2 Loops
+ * ===========================================================================*/
+
+static void assert_close(double a, double b)
+{
+    assert_true(fabs(a - b) <= 1e-9 * (fabs(a) + fabs(b)) + 1e-12);
+}
+
+/**
+ * @brief The SSE2 loops measure what the scalar reference measures
+ *
+ * Six channels of noise with a level that changes every half second, at a
+ * rate with 4x and one with 2x true-peak oversampling.
+ */
+static void test_loudness_sse2_matches_scalar(void **state)
+{
+    (void)state;
+    static const uint32_t rates[] = { 48000, 96000 };
+
+    for (size_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+        uint32_t rate = rates[r];
+        dsdpipe_loudness_meter_t *sse2 = NULL;
+        dsdpipe_loudness_meter_t *scalar = NULL;
+        dsdpipe_loudness_t a, b;
+
+        assert_int_equal(dsdpipe_loudness_meter_create(&sse2, rate, 6), DSDPIPE_OK);
+        assert_int_equal(dsdpipe_loudness_meter_create(&scalar, rate, 6), DSDPIPE_OK);
+        if (!dsdpipe_loudness_meter_use_sse2(sse2, true)) {
+            dsdpipe_loudness_meter_destroy(sse2);
+            dsdpipe_loudness_meter_destroy(scalar);
+            skip();
+        }
+        assert_false(dsdpipe_loudness_meter_use_sse2(scalar, false));
+
+        size_t frames = rate / 2;
+        double *buf = (double *)sa_malloc(frames * 6 * sizeof(double));
+        uint32_t seed = 1;
+        assert_non_null(buf);
+
+        dsdpipe_loudness_meter_start_track(sse2);
+        dsdpipe_loudness_meter_start_track(scalar);
+        for (int block = 0; block < 20; block++) {
+            double level = pow(10.0, -(double)((block * 7) % 30) / 20.0);
+            for (size_t i = 0; i < frames * 6; i++) {
+                seed = seed * 1664525u + 1013904223u;
+                buf[i] = level * ((double)(seed >> 8) / 8388608.0 - 1.0);
+            }
+            dsdpipe_loudness_meter_add_double(sse2, buf, frames);
+            dsdpipe_loudness_meter_add_double(scalar, buf, frames);
+        }
+        sa_free(buf);
+
+        dsdpipe_loudness_meter_get_track(sse2, &a);
+        dsdpipe_loudness_meter_get_track(scalar, &b);
+        assert_true(a.valid && b.valid);
+        assert_close(a.integrated_lufs, b.integrated_lufs);
+        assert_close(a.loudness_range_lu, b.loudness_range_lu);
+        assert_close(a.max_momentary_lufs, b.max_momentary_lufs);
+        assert_close(a.max_short_term_lufs, b.max_short_term_lufs);
+        assert_close(a.sample_peak, b.sample_peak);
+        assert_close(a.true_peak, b.true_peak);
+
+        dsdpipe_loudness_meter_destroy(sse2);
+        dsdpipe_loudness_meter_destroy(scalar);
+    }
+}
+
+/* =============================================================================
+ * Test: Argument Validation
+ * ===========================================================================*/
+
+static void test_loudness_create_invalid(void **state)
+{
+    (void)state;
+    dsdpipe_loudness_meter_t *meter = NULL;
+
+    assert_int_not_equal(dsdpipe_loudness_meter_create(NULL, 48000, 2), DSDPIPE_OK);
+    assert_int_not_equal(dsdpipe_loudness_meter_create(&meter, 0, 2), DSDPIPE_OK);
+    assert_int_not_equal(dsdpipe_loudness_meter_create(&meter, 48000, 0), DSDPIPE_OK);
+    assert_int_not_equal(dsdpipe_loudness_meter_create(&meter, 48000, 9), DSDPIPE_OK);
+    assert_null(meter);
+
+    dsdpipe_loudness_meter_destroy(NULL);
+}
+
+/* =============================================================================
+ * Main
+ * ===========================================================================*/
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_loudness_reference_48k),
+        cmocka_unit_test(test_loudness_reference_88k),
+        cmocka_unit_test(test_loudness_silence),
+        cmocka_unit_test(test_loudness_range),
+        cmocka_unit_test(test_loudness_true_peak),
+        cmocka_unit_test(test_loudness_sse2_matches_scalar),
+        cmocka_unit_test(test_loudness_create_invalid),
+    };
+
+    return cmocka_run_group_tests_name("Loudness Meter", tests, NULL, NULL);
+}
@@ -0,0 +1,316 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Unit tests for the sa_tpool scheduler using CMocka
+ * Runs jobs of several process queues on a single worker, held back until
+ * every queue has its backlog, and checks the order they are served in.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <libsautil/sa_tpool.h>
+#include <libsautil/c11threads.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#define TEST_QSIZE      64
+#define TEST_MAX_JOBS   256
+
+/* =============================================================================
+ * Helpers
+ * ===========================================================================*/
+
+/** Queue tags in the order their jobs ran */
+static struct {
+    mtx_t mtx;
+    char tags[TEST_MAX_JOBS];
+    int count;
+} g_log;
+
+/** Holds the worker until opened */
+static struct {
+    mtx_t mtx;
+    cnd_t cnd;
+    int entered;
+    int open;
+} g_gate;
+
+static void *log_job(void *arg)
+{
+    mtx_lock(&g_log.mtx);
+    if (g_log.count < TEST_MAX_JOBS) {
+        g_log.tags[g_log.count++] = *(const char *)arg;
+    }
+    mtx_unlock(&g_log.mtx);
+    return NULL;
+}
+
+static void *gate_job(void *arg)
+{
+    (void)arg;
+    mtx_lock(&g_gate.mtx);
+    g_gate.entered = 1;
+    cnd_broadcast(&g_gate.cnd);
+    while (!g_gate.open) {
+        cnd_wait(&g_gate.cnd, &g_gate.mtx);
+    }
+    mtx_unlock(&g_gate.mtx);
+    return NULL;
+}
+
+/** Occupy the only worker of @p pool until open_gate() */
+static void close_gate(sa_tpool *pool, sa_tpool_process *gate)
+{
+    mtx_lock(&g_gate.mtx);
+    g_gate.entered = 0;
+    g_gate.open = 0;
+    mtx_unlock(&g_gate.mtx);
+
+    assert_int_equal(sa_tpool_dispatch(pool, gate, gate_job, NULL), 0);
+
+    mtx_lock(&g_gate.mtx);
+    while (!g_gate.entered) {
+        cnd_wait(&g_gate.cnd, &g_gate.mtx);
+    }
+    mtx_unlock(&g_gate.mtx);
+}
+
+static void open_gate(sa_tpool_process *gate)
+{
+    mtx_lock(&g_gate.mtx);
+    g_gate.open = 1;
+    cnd_broadcast(&g_gate.cnd);
+    mtx_unlock(&g_gate.mtx);
+    sa_tpool_process_flush(gate);
+}
+
+static void dispatch_jobs(sa_tpool *pool, sa_tpool_process *q,
+                          const char *tag, int count)
+{
+    for (int i = 0; i < count; i++) {
+        assert_int_equal(sa_tpool_dispatch3(pool, q, log_job, (void *)tag,
+                                            NULL, NULL, -1),
+                         0);
+    }
+}
+
+static sa_tpool_process *make_queue(sa_tpool *pool, int in_only, int priority,
+                                    int weight, int low_water)
+{
+    sa_tpool_process_opts opts;
+    memset(&opts, 0, sizeof(opts));
+    opts.priority = priority;
+    opts.weight = weight;
+    opts.low_water = low_water;
+
+    sa_tpool_process *q = sa_tpool_process_init(pool, TEST_QSIZE, in_only, &opts);
+    assert_non_null(q);
+    return q;
+}
+
+/** Occurrences of @p tag among the logged jobs [first, first + count) */
+static int count_tag(int first, int count, char tag)
+{
+    int n = 0;
+    for (int i = first; i < first + count; i++) {
+        if (g_log.tags[i] == tag) {
+            n++;
+        }
+    }
+    return n;
+}
+
+static int setup_pool(void **state)
+{
+    memset(&g_log.tags, 0, sizeof(g_log.tags));
+    g_log.count = 0;
+    if (mtx_init(&g_log.mtx, mtx_plain) != thrd_success ||
+        mtx_init(&g_gate.mtx, mtx_plain) != thrd_success ||
+        cnd_init(&g_gate.cnd) != thrd_success) {
+        return -1;
+    }
+
+    sa_tpool *pool = sa_tpool_init(1);
+    if (!pool) {
+        return -1;
+    }
+    *state = pool;
+    return 0;
+}
+
+static int teardown_pool(void **state)
+{
+    sa_tpool_destroy((sa_tpool *)*state);
+    cnd_destroy(&g_gate.cnd);
+    mtx_destroy(&g_gate.mtx);
+    mtx_destroy(&g_log.mtx);
+    return 0;
+}
+
+/* =============================================================================
+ * Tests
+ * ===========================================================================*/
+
+/**
+ * @brief A higher priority queue is served before an older backlog
+ */
+static void test_priority(void **state)
+{
+    sa_tpool *pool = (sa_tpool *)*state;
+    sa_tpool_process *gate = make_queue(pool, 1, 10, 0, 0);
+    sa_tpool_process *low = make_queue(pool, 1, 0, 0, 0);
+    sa_tpool_process *high = make_queue(pool, 1, 1, 0, 0);
+
+    close_gate(pool, gate);
+    dispatch_jobs(pool, low, "l", 8);
+    dispatch_jobs(pool, high, "h", 8);
+    open_gate(gate);
+    sa_tpool_process_flush(low);
+    sa_tpool_process_flush(high);
+
+    assert_int_equal(g_log.count, 16);
+    assert_int_equal(count_tag(0, 8, 'h'), 8);
+    assert_int_equal(count_tag(8, 8, 'l'), 8);
+
+    sa_tpool_process_destroy(high);
+    sa_tpool_process_destroy(low);
+    sa_tpool_process_destroy(gate);
+}
+
+/**
+ * @brief A queue below its low-water mark beats a higher priority
+ */
+static void test_low_water(void **state)
+{
+    sa_tpool *pool = (sa_tpool *)*state;
+    sa_tpool_process *gate = make_queue(pool, 1, 10, 0, 0);
+    sa_tpool_process *dry = make_queue(pool, 0, 0, 0, 4);
+    sa_tpool_process *high = make_queue(pool, 1, 1, 0, 0);
+
+    close_gate(pool, gate);
+    dispatch_jobs(pool, high, "h", 8);
+    dispatch_jobs(pool, dry, "d", 8);
+    open_gate(gate);
+    sa_tpool_process_flush(high);
+    sa_tpool_process_flush(dry);
+
+    /* Until four results are waiting, then by priority */
+    assert_int_equal(g_log.count, 16);
+    assert_int_equal(count_tag(0, 4, 'd'), 4);
+    assert_int_equal(count_tag(4, 8, 'h'), 8);
+    assert_int_equal(count_tag(12, 4, 'd'), 4);
+
+    sa_tpool_process_destroy(high);
+    sa_tpool_process_destroy(dry);
+    sa_tpool_process_destroy(gate);
+}
+
+/**
+ * @brief Queues of equal priority share the worker by weight
+ */
+static void test_weight(void **state)
+{
+    sa_tpool *pool = (sa_tpool *)*state;
+    sa_tpool_process *gate = make_queue(pool, 1, 10, 0, 0);
+    sa_tpool_process *one = make_queue(pool, 1, 0, 1, 0);
+    sa_tpool_process *two = make_queue(pool, 1, 0, 2, 0);
+
+    close_gate(pool, gate);
+    dispatch_jobs(pool, one, "1", 30);
+    dispatch_jobs(pool, two, "2", 30);
+    open_gate(gate);
+    sa_tpool_process_flush(one);
+    sa_tpool_process_flush(two);
+
+    /* While both have jobs, about one in three goes to weight 1 */
+    assert_int_equal(g_log.count, 60);
+    int n = count_tag(0, 30, '2');
+    assert_true(n >= 19 && n <= 21);
+
+    sa_tpool_process_destroy(two);
+    sa_tpool_process_destroy(one);
+    sa_tpool_process_destroy(gate);
+}
+
+/**
+ * @brief A queue coming back from idle does not take over the worker
+ *
+ * A busy queue runs alone for a while, then a higher priority queue that
+ * is far behind in virtual time runs a few jobs. A queue coming back from
+ * idle after that must still share the worker with the busy one.
+ */
+static void test_idle_return(void **state)
+{
+    sa_tpool *pool = (sa_tpool *)*state;
+    sa_tpool_process *gate = make_queue(pool, 1, 10, 0, 0);
+    sa_tpool_process *busy = make_queue(pool, 1, 0, 0, 0);
+    sa_tpool_process *idle = make_queue(pool, 1, 0, 0, 0);
+    sa_tpool_process_opts opts = { 1, 1, 0 };
+    sa_tpool_process *high = sa_tpool_process_init(pool, 2, 0, &opts);
+    assert_non_null(high);
+
+    /* The high queue runs two jobs, then waits for room for its results */
+    close_gate(pool, gate);
+    dispatch_jobs(pool, high, "h", 4);
+    dispatch_jobs(pool, busy, "b", 20);
+    open_gate(gate);
+    sa_tpool_process_flush(busy);
+    assert_int_equal(g_log.count, 22);
+
+    /* Room again: its last two jobs run at its old virtual time */
+    for (int i = 0; i < 4; i++) {
+        sa_tpool_result *r = sa_tpool_next_result_wait(high);
+        assert_non_null(r);
+        sa_tpool_delete_result(r, 0);
+    }
+    assert_int_equal(g_log.count, 24);
+
+    close_gate(pool, gate);
+    dispatch_jobs(pool, busy, "b", 10);
+    dispatch_jobs(pool, idle, "i", 10);
+    open_gate(gate);
+    sa_tpool_process_flush(busy);
+    sa_tpool_process_flush(idle);
+
+    assert_int_equal(g_log.count, 44);
+    int n = count_tag(24, 10, 'i');
+    assert_true(n >= 4 && n <= 6);
+
+    sa_tpool_process_destroy(high);
+    sa_tpool_process_destroy(idle);
+    sa_tpool_process_destroy(busy);
+    sa_tpool_process_destroy(gate);
+}
+
+/* =============================================================================
+ * Main
+ * ===========================================================================*/
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_priority, setup_pool, teardown_pool),
+        cmocka_unit_test_setup_teardown(test_low_water, setup_pool, teardown_pool),
+        cmocka_unit_test_setup_teardown(test_weight, setup_pool, teardown_pool),
+        cmocka_unit_test_setup_teardown(test_idle_return, setup_pool, teardown_pool),
+    };
+
+    return cmocka_run_group_tests_name("Thread Pool Scheduler", tests, NULL, NULL);
+}
@@ -0,0 +1,357 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Unit tests for the sacd_input sector cache using CMocka
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sacd_input.h"
+
+#include <libsautil/mem.h>
+#include <libsautil/c11threads.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#define FAKE_SECTORS 1000
+
+/* =============================================================================
+ * Fake Input: every byte of sector n is (n & 0xFF), reads are counted
+ * ===========================================================================*/
+
+typedef struct fake_source {
+    atomic_int refcount;
+    atomic_int reads;           /* read_sectors calls */
+    atomic_int sectors;         /* sectors handed out */
+    uint32_t total;
+    bool can_dup;
+} fake_source_t;
+
+typedef struct fake_input {
+    sacd_input_t base;
+    fake_source_t *src;
+} fake_input_t;
+
+static int fake_close(sacd_input_t *self);
+static int fake_read(sacd_input_t *self, uint32_t pos, uint32_t count,
+                     void *buffer, uint32_t *sectors_read);
+static uint32_t fake_total(sacd_input_t *self);
+static int fake_dup(sacd_input_t *self, sacd_input_t **out);
+
+static const sacd_input_ops_t fake_ops = {
+    .close = fake_close,
+    .read_sectors = fake_read,
+    .total_sectors = fake_total,
+    .dup = fake_dup,
+};
+
+static const sacd_input_ops_t fake_ops_nodup = {
+    .close = fake_close,
+    .read_sectors = fake_read,
+    .total_sectors = fake_total,
+};
+
+static sacd_input_t *fake_handle(fake_source_t *src)
+{
+    fake_input_t *f = (fake_input_t *)sa_calloc(1, sizeof(*f));
+    f->base.ops = src->can_dup ? &fake_ops : &fake_ops_nodup;
+    f->base.type = SACD_INPUT_TYPE_MEMORY;
+    f->src = src;
+    return &f->base;
+}
+
+static sacd_input_t *fake_open(fake_source_t *src, bool can_dup)
+{
+    memset(src, 0, sizeof(*src));
+    atomic_init(&src->refcount, 1);
+    src->total = FAKE_SECTORS;
+    src->can_dup = can_dup;
+    return fake_handle(src);
+}
+
+static int fake_close(sacd_input_t *self)
+{
+    fake_input_t *f = (fake_input_t *)self;
+    atomic_fetch_sub(&f->src->refcount, 1);
+    sa_free(f);
+    return SACD_INPUT_OK;
+}
+
+static int fake_read(sacd_input_t *self, uint32_t pos, uint32_t count,
+                     void *buffer, uint32_t *sectors_read)
+{
+    fake_input_t *f = (fake_input_t *)self;
+
+    atomic_fetch_add(&f->src->reads, 1);
+    *sectors_read = 0;
+    if (pos >= f->src->total) {
+        return SACD_INPUT_ERR_EOF;
+    }
+    if (count > f->src->total - pos) {
+        count = f->src->total - pos;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        memset((uint8_t *)buffer + (size_t)i * SACD_LSN_SIZE,
+               (int)((pos + i) & 0xFF), SACD_LSN_SIZE);
+    }
+    atomic_fetch_add(&f->src->sectors, (int)count);
+    *sectors_read = count;
+    return SACD_INPUT_OK;
+}
+
+static uint32_t fake_total(sacd_input_t *self)
+{
+    return ((fake_input_t *)self)->src->total;
+}
+
+static int fake_dup(sacd_input_t *self, sacd_input_t **out)
+{
+    fake_input_t *f = (fake_input_t *)self;
+    atomic_fetch_add(&f->src->refcount, 1);
+    *out = fake_handle(f->src);
+    return SACD_INPUT_OK;
+}
+
+static bool sectors_match(const uint8_t *buffer, uint32_t pos, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t *sector = buffer + (size_t)i * SACD_LSN_SIZE;
+        if (sector[0] != (uint8_t)(pos + i) ||
+            sector[SACD_LSN_SIZE - 1] != (uint8_t)(pos + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* =============================================================================
+ * Tests
+ * ===========================================================================*/
+
+static void test_cache_hits_and_misses(void **state)
+{
+    (void)state;
+    fake_source_t src;
+    sacd_input_cache_config_t cfg = { .block_sectors = 16, .max_blocks = 8,
+                                      .readahead_blocks = 0, .shard_count = 2 };
+    sacd_input_cache_stats_t stats;
+    sacd_input_t *cache = NULL;
+    uint8_t *buffer = (uint8_t *)sa_malloc(40 * SACD_LSN_SIZE);
+    uint32_t got = 0;
+
+    assert_int_equal(sacd_input_open_cache(fake_open(&src, true), &cfg, &cache),
+                     SACD_INPUT_OK);
+
+    /* Sectors 10..49 span blocks 0..3 */
+    assert_int_equal(sacd_input_read_sectors(cache, 10, 40, buffer, &got),
+                     SACD_INPUT_OK);
+    assert_int_equal(got, 40);
+    assert_true(sectors_match(buffer, 10, 40));
+    assert_int_equal(atomic_load(&src.reads), 4);
+
+    /* Same range again: no further input reads */
+    assert_int_equal(sacd_input_read_sectors(cache, 20, 20, buffer, &got),
+                     SACD_INPUT_OK);
+    assert_true(sectors_match(buffer, 20, 20));
+    assert_int_equal(atomic_load(&src.reads), 4);
+
+    assert_int_equal(sacd_input_cache_get_stats(cache, &stats), SACD_INPUT_OK);
+    assert_int_equal(stats.misses, 4);
+    assert_int_equal(stats.hits, 2);
+    assert_int_equal(stats.cached_blocks, 4);
+    assert_int_equal(stats.block_sectors, 16);
+
+    sacd_input_close(cache);
+    assert_int_equal(atomic_load(&src.refcount), 0);
+    sa_free(buffer);
+}
+
+static void test_cache_eviction(void **state)
+{
+    (void)state;
+    fake_source_t src;
+    sacd_input_cache_config_t cfg = { .block_sectors = 8, .max_blocks = 4,
+                                      .readahead_blocks = 0, .shard_count = 1 };
+    sacd_input_cache_stats_t stats;
+    sacd_input_t *cache = NULL;
+    uint8_t buffer[SACD_LSN_SIZE];
+    uint32_t got = 0;
+
+    assert_int_equal(sacd_input_open_cache(fake_open(&src, true), &cfg, &cache),
+                     SACD_INPUT_OK);
+
+    /* Touch blocks 0..4, then block 1 again: block 0 was the oldest */
+    for (uint32_t block = 0; block < 5; block++) {
+        assert_int_equal(sacd_input_read_sectors(cache, block * 8, 1, buffer, &got),
+                         SACD_INPUT_OK);
+    }
+    assert_int_equal(sacd_input_read_sectors(cache, 8, 1, buffer, &got), SACD_INPUT_OK);
+    assert_int_equal(atomic_load(&src.reads), 5);
+    assert_int_equal(sacd_input_read_sectors(cache, 0, 1, buffer, &got), SACD_INPUT_OK);
+    assert_true(sectors_match(buffer, 0, 1));
+    assert_int_equal(atomic_load(&src.reads), 6);
+
+    assert_int_equal(sacd_input_cache_get_stats(cache, &stats), SACD_INPUT_OK);
+    assert_int_equal(stats.cached_blocks, 4);
+    assert_int_equal(stats.evictions, 2);
+
+    sacd_input_close(cache);
+    assert_int_equal(atomic_load(&src.refcount), 0);
+}
+
+static void test_cache_end_of_disc(void **state)
+{
+    (void)state;
+    fake_source_t src;
+    sacd_input_cache_config_t cfg = { .block_sectors = 64, .max_blocks = 4,
+                                      .readahead_blocks = 0, .shard_count = 1 };
+    sacd_input_t *cache = NULL;
+    uint8_t *buffer = (uint8_t *)sa_malloc(16 * SACD_LSN_SIZE);
+    uint32_t got = 0;
+
+    assert_int_equal(sacd_input_open_cache(fake_open(&src, true), &cfg, &cache),
+                     SACD_INPUT_OK);
+
+    /* Last block is short: 1000 = 15 * 64 + 40 */
+    assert_int_equal(sacd_input_read_sectors(cache, FAKE_SECTORS - 4, 16, buffer, &got),
+                     SACD_INPUT_OK);
+    assert_int_equal(got, 4);
+    assert_true(sectors_match(buffer, FAKE_SECTORS - 4, 4));
+
+    /* Past the end the input's own error comes back */
+    assert_int_equal(sacd_input_read_sectors(cache, FAKE_SECTORS, 1, buffer, &got),
+                     SACD_INPUT_ERR_EOF);
+    assert_int_equal(got, 0);
+
+    sacd_input_close(cache);
+    sa_free(buffer);
+}
+
+static void test_cache_dup_shares_blocks(void **state)
+{
+    (void)state;
+    fake_source_t src;
+    sacd_input_cache_config_t cfg = { .block_sectors = 16, .max_blocks = 16,
+                                      .readahead_blocks = 0, .shard_count = 4 };
+    sacd_input_cache_stats_t stats;
+    sacd_input_t *cache = NULL;
+    sacd_input_t *copy = NULL;
+    uint8_t buffer[SACD_LSN_SIZE];
+    uint32_t got = 0;
+
+    assert_int_equal(sacd_input_open_cache(fake_open(&src, true), &cfg, &cache),
+                     SACD_INPUT_OK);
+    assert_int_equal(sacd_input_read_sectors(cache, 100, 1, buffer, &got), SACD_INPUT_OK);
+
+    assert_int_equal(sacd_input_dup(cache, &copy), SACD_INPUT_OK);
+    assert_int_equal(sacd_input_read_sectors(copy, 101, 1, buffer, &got), SACD_INPUT_OK);
+    assert_true(sectors_match(buffer, 101, 1));
+    assert_int_equal(atomic_load(&src.reads), 1);
+
+    /* Counters are shared too, and outlive the original handle */
+    sacd_input_close(cache);
+    assert_int_equal(sacd_input_cache_get_stats(copy, &stats), SACD_INPUT_OK);
+    assert_int_equal(stats.hits, 1);
+    assert_int_equal(stats.misses, 1);
+
+    sacd_input_close(copy);
+    assert_int_equal(atomic_load(&src.refcount), 0);
+}
+
+static void test_cache_readahead(void **state)
+{
+    (void)state;
+    fake_source_t src;
+    sacd_input_cache_config_t cfg = { .block_sectors = 8, .max_blocks = 64,
+                                      .readahead_blocks = 8, .shard_count = 4 };
+    sacd_input_cache_stats_t stats;
+    sacd_input_t *cache = NULL;
+    uint8_t buffer[SACD_LSN_SIZE];
+    uint32_t got = 0;
+
+    /* No dup: the worker shares the input */
+    for (int pass = 0; pass < 2; pass++) {
+        assert_int_equal(sacd_input_open_cache(fake_open(&src, pass == 0), &cfg, &cache),
+                         SACD_INPUT_OK);
+
+        /* Start a stream, then give the worker time to get ahead */
+        for (uint32_t sector = 0; sector < 4; sector++) {
+            assert_int_equal(sacd_input_read_sectors(cache, sector, 1, buffer, &got),
+                             SACD_INPUT_OK);
+        }
+        for (int wait = 0; wait < 200; wait++) {
+            sacd_input_cache_get_stats(cache, &stats);
+            if (stats.readahead >= 4) {
+                break;
+            }
+            thrd_sleep(&(struct timespec){ .tv_nsec = 10 * 1000 * 1000 }, NULL);
+        }
+        assert_true(stats.readahead >= 4);
+
+        for (uint32_t sector = 4; sector < FAKE_SECTORS; sector++) {
+            assert_int_equal(sacd_input_read_sectors(cache, sector, 1, buffer, &got),
+                             SACD_INPUT_OK);
+            assert_true(sectors_match(buffer, sector, 1));
+        }
+
+        assert_int_equal(sacd_input_cache_get_stats(cache, &stats), SACD_INPUT_OK);
+        assert_true(stats.readahead_hits >= 4);
+        assert_int_equal(stats.misses + stats.readahead, (FAKE_SECTORS + 7) / 8);
+
+        sacd_input_close(cache);
+        assert_int_equal(atomic_load(&src.refcount), 0);
+    }
+}
+
+static void test_cache_stats_not_cache(void **state)
+{
+    (void)state;
+    fake_source_t src;
+    sacd_input_cache_stats_t stats;
+    sacd_input_t *input = fake_open(&src, false);
+    sacd_input_t *copy = NULL;
+    sacd_input_t *cache = NULL;
+
+    assert_int_equal(sacd_input_cache_get_stats(input, &stats),
+                     SACD_INPUT_ERR_NOT_SUPPORTED);
+
+    /* A cache over an input without dup cannot be duplicated either */
+    assert_int_equal(sacd_input_open_cache(input, NULL, &cache), SACD_INPUT_OK);
+    assert_int_equal(sacd_input_dup(cache, &copy), SACD_INPUT_ERR_NOT_SUPPORTED);
+    sacd_input_close(cache);
+
+    assert_int_equal(sacd_input_open_cache(NULL, NULL, &cache),
+                     SACD_INPUT_ERR_INVALID_ARG);
+}
+
+int main(void)
+{
+    const struct CMUnitTest cache_tests[] = {
+        cmocka_unit_test(test_cache_hits_and_misses),
+        cmocka_unit_test(test_cache_eviction),
+        cmocka_unit_test(test_cache_end_of_disc),
+        cmocka_unit_test(test_cache_dup_shares_blocks),
+        cmocka_unit_test(test_cache_readahead),
+        cmocka_unit_test(test_cache_stats_not_cache),
+    };
+
+    return cmocka_run_group_tests_name("Sector Cache Tests", cache_tests, NULL, NULL);
+}
@@ -0,0 +1,293 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Unit tests for the pipelined network input using CMocka
+ * The tests talk to the loopback stand-in server from
+ * sacd_loopback_server.c.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sacd_input.h"
+#include "sacd_loopback_server.h"
+#include "sacd_test_image.h"
+
+#include <libsacd/sacd.h>
+#include <libsautil/mem.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#define DISC_SECTORS 1000
+
+typedef struct network_fixture {
+    sacd_loopback_server_t *server;
+    sacd_input_t *input;
+    uint8_t *buffer;
+} network_fixture_t;
+
+/* =============================================================================
+ * Helpers
+ * ===========================================================================*/
+
+static int setup_network(void **state)
+{
+    network_fixture_t *f = (network_fixture_t *)sa_calloc(1, sizeof(*f));
+
+    if (!f || sacd_loopback_server_start(DISC_SECTORS, &f->server) != 0)
+    {
+        sa_free(f);
+        return -1;
+    }
+    if (sacd_input_open_network("127.0.0.1",
+                                sacd_loopback_server_port(f->server),
+                                &f->input) != SACD_INPUT_OK)
+    {
+        sacd_loopback_server_stop(f->server);
+        sa_free(f);
+        return -1;
+    }
+    f->buffer = (uint8_t *)sa_malloc((size_t)DISC_SECTORS * SACD_LSN_SIZE);
+    *state = f;
+    return 0;
+}
+
+static int teardown_network(void **state)
+{
+    network_fixture_t *f = (network_fixture_t *)*state;
+
+    sacd_input_close(f->input);
+    sacd_loopback_server_stop(f->server);
+    sa_free(f->buffer);
+    sa_free(f);
+    return 0;
+}
+
+static void check_sectors(const uint8_t *buf, uint32_t pos, uint32_t count)
+{
+    uint8_t expected[SACD_LSN_SIZE];
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        sacd_loopback_fill_sector(pos + i, expected);
+        assert_memory_equal(buf + (size_t)i * SACD_LSN_SIZE, expected,
+                            SACD_LSN_SIZE);
+    }
+}
+
+/* =============================================================================
+ * Tests
+ * ===========================================================================*/
+
+static void test_network_open(void **state)
+{
+    network_fixture_t *f = (network_fixture_t *)*state;
+
+    assert_int_equal(sacd_input_total_sectors(f->input), DISC_SECTORS);
+    assert_int_equal(sacd_input_network_set_pipeline(f->input, 17, 0),
+                     SACD_INPUT_ERR_INVALID_ARG);
+    assert_int_equal(sacd_input_network_set_pipeline(f->input, 0, 501),
+                     SACD_INPUT_ERR_INVALID_ARG);
+}
+
+static void test_network_large_read_split(void **state)
+{
+    network_fixture_t *f = (network_fixture_t *)*state;
+    uint32_t got = 0;
+
+    assert_int_equal(sacd_input_network_set_pipeline(f->input, 4, 64),
+                     SACD_INPUT_OK);
+
+    /* 700 sectors would not fit a single response */
+    assert_int_equal(sacd_input_read_sectors(f->input, 100, 700, f->buffer, &got),
+                     SACD_INPUT_OK);
+    assert_int_equal(got, 700);
+    check_sectors(f->buffer, 100, 700);
+
+    /* ceil(700 / 64) requests, nothing speculative on a first read */
+    assert_int_equal(sacd_loopback_server_read_requests(f->server), 11);
+    assert_int_equal(sacd_loopback_server_read_sectors(f->server), 700);
+}
+
+static void test_network_sequential_coalesce(void **state)
+{
+    network_fixture_t *f = (network_fixture_t *)*state;
+    uint32_t got = 0;
+    uint32_t pos;
+
+    assert_int_equal(sacd_input_network_set_pipeline(f->input, 4, 32),
+                     SACD_INPUT_OK);
+
+    for (pos = 0; pos < 256; pos++)
+    {
+        assert_int_equal(sacd_input_read_sectors(f->input, pos, 1,
+                                                 f->buffer, &got),
+                         SACD_INPUT_OK);
+        assert_int_equal(got, 1);
+        check_sectors(f->buffer, pos, 1);
+    }
+
+    /* One demand request, then 32-sector chunks kept up to 4 ahead */
+    assert_true(sacd_loopback_server_read_requests(f->server) <= 1 + 8 + 4);
+    assert_true(sacd_loopback_server_read_sectors(f->server) <= 1 + 256 + 4 * 32);
+}
+
+static void test_network_random_reads(void **state)
+{
+    network_fixture_t *f = (network_fixture_t *)*state;
+    static const uint32_t positions[][2] = {
+        { 510, 10 }, { 0, 3 }, { 3, 40 }, { 43, 300 }, { 20, 5 },
+        { 900, 64 }, { 343, 100 }, { 999, 1 },
+    };
+    uint32_t got = 0;
+    size_t i;
+
+    assert_int_equal(sacd_input_network_set_pipeline(f->input, 3, 16),
+                     SACD_INPUT_OK);
+
+    /* Sequential runs start prefetching; the seeks after them must drain it */
+    for (i = 0; i < sizeof(positions) / sizeof(positions[0]); i++)
+    {
+        assert_int_equal(sacd_input_read_sectors(f->input, positions[i][0],
+                                                 positions[i][1], f->buffer,
+                                                 &got),
+                         SACD_INPUT_OK);
+        assert_int_equal(got, positions[i][1]);
+        check_sectors(f->buffer, positions[i][0], positions[i][1]);
+    }
+}
+
+static void test_network_end_of_disc(void **state)
+{
+    network_fixture_t *f = (network_fixture_t *)*state;
+    uint32_t got = 0;
+    uint32_t pos;
+
+    assert_int_equal(sacd_input_network_set_pipeline(f->input, 4, 100),
+                     SACD_INPUT_OK);
+
+    /* Prefetch stops at the last sector */
+    for (pos = 0; pos < DISC_SECTORS; pos += 50)
+    {
+        assert_int_equal(sacd_input_read_sectors(f->input, pos, 50,
+                                                 f->buffer, &got),
+                         SACD_INPUT_OK);
+        check_sectors(f->buffer, pos, 50);
+    }
+    assert_int_equal(sacd_loopback_server_read_sectors(f->server), DISC_SECTORS);
+
+    /* Reading past the end is a short read */
+    assert_int_equal(sacd_input_read_sectors(f->input, DISC_SECTORS - 5, 10,
+                                             f->buffer, &got),
+                     SACD_INPUT_ERR_READ_FAILED);
+    assert_int_equal(got, 5);
+    check_sectors(f->buffer, DISC_SECTORS - 5, 5);
+
+    /* The connection stays usable */
+    assert_int_equal(sacd_input_read_sectors(f->input, 7, 3, f->buffer, &got),
+                     SACD_INPUT_OK);
+    check_sectors(f->buffer, 7, 3);
+}
+
+/**
+ * @brief DST frames read over the network, behind the sector cache
+ *
+ * The network input does not decrypt, so neither may the cache put in
+ * front of it by sacd_input_open(); otherwise the DST reader would try to
+ * decrypt every sector and fail.
+ */
+static void test_network_dst_frames(void **state)
+{
+    (void)state;
+    sacd_test_image_t *image = NULL;
+    sacd_loopback_server_t *server = NULL;
+    sacd_input_cache_stats_t stats;
+    sacd_input_t *input = NULL;
+    char path[64];
+    uint8_t *data;
+
+    assert_int_equal(sacd_test_image_create(true, &image), 0);
+    assert_int_equal(sacd_loopback_server_start_image(
+                         sacd_test_image_sector(image, 0),
+                         sacd_test_image_total_sectors(image), &server),
+                     0);
+    snprintf(path, sizeof(path), "127.0.0.1:%u",
+             (unsigned int)sacd_loopback_server_port(server));
+
+    assert_int_equal(sacd_input_open(path, &input), SACD_INPUT_OK);
+    assert_int_equal(sacd_input_cache_get_stats(input, &stats), SACD_INPUT_OK);
+    assert_null(input->ops->decrypt);
+    sacd_input_close(input);
+
+    sacd_t *ctx = sacd_create();
+    assert_non_null(ctx);
+    assert_int_equal(sacd_init(ctx, path, 1, 1), SACD_OK);
+    assert_int_equal(sacd_select_channel_type(ctx, TWO_CHANNEL), SACD_OK);
+
+    data = (uint8_t *)sa_malloc(SACD_MAX_DSD_SIZE);
+    assert_non_null(data);
+    for (uint32_t k = 0; k < sacd_test_image_frame_count(image); k++)
+    {
+        const uint8_t *expected;
+        uint32_t expected_size = 0;
+        uint32_t count = 1;
+        uint16_t size = 0;
+
+        expected = sacd_test_image_frame(image, k, &expected_size);
+        assert_int_equal(sacd_get_sound_data(ctx, data, k, &count, &size),
+                         SACD_OK);
+        assert_int_equal(size, expected_size);
+        assert_memory_equal(data, expected, expected_size);
+    }
+
+    sa_free(data);
+    sacd_destroy(ctx);
+    sacd_loopback_server_stop(server);
+    sacd_test_image_free(image);
+}
+
+static void test_network_not_network(void **state)
+{
+    (void)state;
+
+    assert_int_equal(sacd_input_network_set_pipeline(NULL, 0, 0),
+                     SACD_INPUT_ERR_NULL_PTR);
+}
+
+int main(void)
+{
+    const struct CMUnitTest network_tests[] = {
+        cmocka_unit_test_setup_teardown(test_network_open,
+                                        setup_network, teardown_network),
+        cmocka_unit_test_setup_teardown(test_network_large_read_split,
+                                        setup_network, teardown_network),
+        cmocka_unit_test_setup_teardown(test_network_sequential_coalesce,
+                                        setup_network, teardown_network),
+        cmocka_unit_test_setup_teardown(test_network_random_reads,
+                                        setup_network, teardown_network),
+        cmocka_unit_test_setup_teardown(test_network_end_of_disc,
+                                        setup_network, teardown_network),
+        cmocka_unit_test(test_network_dst_frames),
+        cmocka_unit_test(test_network_not_network),
+    };
+
+    return cmocka_run_group_tests_name("Network Input Tests", network_tests,
+                                       NULL, NULL);
+}
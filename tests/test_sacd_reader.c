@@ -0,0 +1,530 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Unit tests for the SACD reader on synthetic disc images using CMocka
+ * Covers DST and DSD frame reads, the lazy Area TOC, multi-frame reads,
+ * readers cloned with sacd_clone() and the DST frame index they share.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <libsacd/sacd.h>
+#include <libsautil/buffer.h>
+
+#include "sacd_input.h"
+#include "sacd_test_image.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#define TEST_DST_IMAGE  "test_sacd_reader_dst.iso"
+#define TEST_DSD_IMAGE  "test_sacd_reader_dsd.iso"
+#define TEST_INDEX_1    "test_sacd_reader_1.idx"
+#define TEST_INDEX_2    "test_sacd_reader_2.idx"
+#define TEST_GROWN_IMAGE "test_sacd_reader_grown.iso"
+#define TEST_COPY_IMAGE "test_sacd_reader_copy.iso"
+
+/** Size of the frame index sidecar header */
+#define INDEX_HEADER_SIZE 28
+
+#define DSD_FRAME_SIZE  9408
+
+static sacd_test_image_t *g_dst;
+static sacd_test_image_t *g_dsd;
+
+/* =============================================================================
+ * Helpers
+ * ===========================================================================*/
+
+static int setup_images(void **state)
+{
+    (void)state;
+
+    if (sacd_test_image_create(true, &g_dst) != 0 ||
+        sacd_test_image_create(false, &g_dsd) != 0 ||
+        sacd_test_image_write(g_dst, TEST_DST_IMAGE) != 0 ||
+        sacd_test_image_write(g_dsd, TEST_DSD_IMAGE) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static int teardown_images(void **state)
+{
+    (void)state;
+
+    sacd_test_image_free(g_dst);
+    sacd_test_image_free(g_dsd);
+    g_dst = NULL;
+    g_dsd = NULL;
+    remove(TEST_DST_IMAGE);
+    remove(TEST_DSD_IMAGE);
+    remove(TEST_INDEX_1);
+    remove(TEST_INDEX_2);
+    remove(TEST_GROWN_IMAGE);
+    remove(TEST_COPY_IMAGE);
+    return 0;
+}
+
+static sacd_t *open_reader(const char *path, unsigned int flags)
+{
+    sacd_t *ctx = sacd_create();
+    assert_non_null(ctx);
+    assert_int_equal(sacd_init_ex(ctx, path, 1, 1, flags), SACD_OK);
+    assert_int_equal(sacd_select_channel_type(ctx, TWO_CHANNEL), SACD_OK);
+    return ctx;
+}
+
+/** Read DST frame @p frame and compare it with the image */
+static void check_dst_frame(sacd_t *ctx, uint32_t frame)
+{
+    static uint8_t data[SACD_MAX_DSD_SIZE];
+    const uint8_t *expected;
+    uint32_t expected_size = 0;
+    uint32_t count = 1;
+    uint16_t size = 0;
+
+    expected = sacd_test_image_frame(g_dst, frame, &expected_size);
+    assert_non_null(expected);
+
+    assert_int_equal(sacd_get_sound_data(ctx, data, frame, &count, &size), SACD_OK);
+    assert_int_equal(count, 1);
+    assert_int_equal(size, expected_size);
+    assert_memory_equal(data, expected, expected_size);
+}
+
+/** Read every DST frame, in order and then in a scattered order */
+static void check_dst_frames(sacd_t *ctx)
+{
+    uint32_t frames = sacd_test_image_frame_count(g_dst);
+
+    for (uint32_t k = 0; k < frames; k++) {
+        check_dst_frame(ctx, k);
+    }
+    for (uint32_t k = 0; k < frames; k++) {
+        check_dst_frame(ctx, (k * 151) % frames);
+    }
+}
+
+static size_t file_size(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    long size;
+
+    assert_non_null(fp);
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fclose(fp);
+    return (size_t)size;
+}
+
+static uint8_t *file_contents(const char *path, size_t *size)
+{
+    FILE *fp = fopen(path, "rb");
+    uint8_t *data;
+
+    *size = file_size(path);
+    assert_non_null(fp);
+    data = (uint8_t *)malloc(*size);
+    assert_non_null(data);
+    assert_int_equal(fread(data, 1, *size, fp), *size);
+    fclose(fp);
+    return data;
+}
+
+/** Overwrite the Track Area of an image file with zeros */
+static void wipe_track_area(const char *path, const sacd_test_image_t *image)
+{
+    static const uint8_t zero[2048];
+    FILE *fp = fopen(path, "r+b");
+
+    assert_non_null(fp);
+    assert_int_equal(fseek(fp, (long)SACD_TEST_IMAGE_TRACK_START * 2048, SEEK_SET), 0);
+    for (uint32_t lsn = SACD_TEST_IMAGE_TRACK_START;
+         lsn <= sacd_test_image_track_end(image); lsn++) {
+        assert_int_equal(fwrite(zero, 1, sizeof(zero), fp), sizeof(zero));
+    }
+    fclose(fp);
+}
+
+/* =============================================================================
+ * Tests
+ * ===========================================================================*/
+
+/**
+ * @brief DST frames come back byte-exact, read in order or scattered
+ */
+static void test_dst_frames(void **state)
+{
+    (void)state;
+    sacd_t *ctx = open_reader(TEST_DST_IMAGE, 0);
+    uint32_t frames = 0;
+
+    assert_int_equal(sacd_get_total_area_play_time(ctx, &frames), SACD_OK);
+    assert_int_equal(frames, sacd_test_image_frame_count(g_dst));
+
+    check_dst_frames(ctx);
+
+    /* Past the end of the area */
+    uint8_t data[16];
+    uint32_t count = 1;
+    uint16_t size = 0;
+    assert_int_not_equal(sacd_get_sound_data(ctx, data, frames, &count, &size), SACD_OK);
+
+    sacd_destroy(ctx);
+}
+
+/**
+ * @brief Plain DSD frames have the fixed size
+ */
+static void test_dsd_frames(void **state)
+{
+    (void)state;
+    sacd_t *ctx = open_reader(TEST_DSD_IMAGE, 0);
+    uint32_t frames = sacd_test_image_frame_count(g_dsd);
+    uint8_t *first = (uint8_t *)malloc(DSD_FRAME_SIZE);
+    uint8_t *data = (uint8_t *)malloc(DSD_FRAME_SIZE);
+    assert_non_null(first);
+    assert_non_null(data);
+
+    for (uint32_t k = 0; k < frames; k++) {
+        uint32_t count = 1;
+        uint16_t size = 0;
+        assert_int_equal(sacd_get_sound_data(ctx, k ? data : first, k, &count, &size),
+                         SACD_OK);
+        assert_int_equal(count, 1);
+        assert_int_equal(size, DSD_FRAME_SIZE);
+    }
+
+    /* Seeking back returns the same data */
+    uint32_t count = 1;
+    uint16_t size = 0;
+    assert_int_equal(sacd_get_sound_data(ctx, data, 0, &count, &size), SACD_OK);
+    assert_memory_equal(data, first, DSD_FRAME_SIZE);
+
+    free(first);
+    free(data);
+    sacd_destroy(ctx);
+}
+
+/**
+ * @brief A lazily parsed Area TOC reads the same frames
+ *
+ * Seeks use the access list, which the lazy TOC decodes on first use.
+ */
+static void test_lazy_toc(void **state)
+{
+    (void)state;
+    sacd_t *ctx = open_reader(TEST_DST_IMAGE, SACD_INIT_LAZY_TOC);
+    uint32_t frames = sacd_test_image_frame_count(g_dst);
+
+    for (uint32_t k = 0; k < frames; k++) {
+        check_dst_frame(ctx, frames - 1 - k);
+    }
+
+    sacd_destroy(ctx);
+}
+
+/**
+ * @brief Multi-frame reads match single-frame reads for any batch size
+ */
+static void test_sound_frames(void **state)
+{
+    (void)state;
+    static const uint32_t batches[] = {1, 3, 5, 12, 64};
+    sacd_t *ctx = open_reader(TEST_DST_IMAGE, 0);
+    uint32_t frames = sacd_test_image_frame_count(g_dst);
+    sacd_frame_ref_t refs[64];
+
+    for (size_t b = 0; b < sizeof(batches) / sizeof(batches[0]); b++) {
+        uint32_t k = 0;
+        while (k < frames) {
+            uint32_t count = batches[b];
+            assert_int_equal(sacd_get_sound_frames(ctx, k, &count, refs), SACD_OK);
+            assert_true(count > 0 && count <= batches[b]);
+
+            for (uint32_t i = 0; i < count; i++) {
+                uint32_t expected_size = 0;
+                const uint8_t *expected = sacd_test_image_frame(g_dst, k + i,
+                                                                &expected_size);
+                assert_int_equal(refs[i].frame_nr, k + i);
+                assert_int_equal(refs[i].size, expected_size);
+                assert_memory_equal(refs[i].data, expected, expected_size);
+            }
+            sacd_release_sound_frames(refs, count);
+            k += count;
+        }
+    }
+
+    /* Out of range */
+    uint32_t count = 1;
+    assert_int_equal(sacd_get_sound_frames(ctx, frames, &count, refs),
+                     SACD_INVALID_ARGUMENT);
+    assert_int_equal(count, 0);
+
+    /* References outlive the reader */
+    count = 8;
+    assert_int_equal(sacd_get_sound_frames(ctx, 0, &count, refs), SACD_OK);
+    sacd_destroy(ctx);
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t expected_size = 0;
+        const uint8_t *expected = sacd_test_image_frame(g_dst, i, &expected_size);
+        assert_memory_equal(refs[i].data, expected, expected_size);
+    }
+    sacd_release_sound_frames(refs, count);
+}
+
+/**
+ * @brief Clones read independently and outlive the reader they came from
+ */
+static void test_clone_reads(void **state)
+{
+    (void)state;
+    sacd_t *ctx = open_reader(TEST_DST_IMAGE, SACD_INIT_LAZY_TOC);
+    uint32_t frames = sacd_test_image_frame_count(g_dst);
+    sacd_t *clone = NULL;
+
+    assert_int_equal(sacd_clone(ctx, &clone), SACD_OK);
+    assert_non_null(clone);
+    assert_int_equal(sacd_select_channel_type(clone, TWO_CHANNEL), SACD_OK);
+
+    /* Interleaved reads at different positions */
+    for (uint32_t k = 0; k < frames; k++) {
+        check_dst_frame(ctx, k);
+        check_dst_frame(clone, frames - 1 - k);
+    }
+
+    sacd_destroy(ctx);
+    check_dst_frames(clone);
+    sacd_destroy(clone);
+}
+
+/**
+ * @brief A clone uses the frame index of the reader it was made from
+ *
+ * Once the index is complete, saving it from a clone must not need the
+ * Track Area: the clone finds every frame in the shared index, even after
+ * the audio sectors on disk have been wiped.
+ */
+static void test_clone_shares_index(void **state)
+{
+    (void)state;
+    sacd_t *ctx = open_reader(TEST_DST_IMAGE, 0);
+    sacd_t *clone = NULL;
+    size_t size_1, size_2;
+    uint8_t *index_1, *index_2;
+
+    assert_int_equal(sacd_build_frame_index(ctx), SACD_OK);
+    assert_int_equal(sacd_save_frame_index(ctx, TEST_INDEX_1), SACD_OK);
+
+    wipe_track_area(TEST_DST_IMAGE, g_dst);
+
+    assert_int_equal(sacd_clone(ctx, &clone), SACD_OK);
+    assert_int_equal(sacd_select_channel_type(clone, TWO_CHANNEL), SACD_OK);
+    assert_int_equal(sacd_save_frame_index(clone, TEST_INDEX_2), SACD_OK);
+
+    index_1 = file_contents(TEST_INDEX_1, &size_1);
+    index_2 = file_contents(TEST_INDEX_2, &size_2);
+    assert_int_equal(size_1, size_2);
+    assert_memory_equal(index_1, index_2, size_1);
+    free(index_1);
+    free(index_2);
+
+    sacd_destroy(clone);
+    sacd_destroy(ctx);
+
+    /* Restore the image for the tests that follow */
+    assert_int_equal(sacd_test_image_write(g_dst, TEST_DST_IMAGE), 0);
+}
+
+/**
+ * @brief A saved index loads into a new reader, which then seeks with it
+ */
+static void test_index_sidecar(void **state)
+{
+    (void)state;
+    sacd_t *ctx = open_reader(TEST_DST_IMAGE, 0);
+    FILE *fp;
+
+    assert_int_equal(sacd_save_frame_index(ctx, TEST_INDEX_1), SACD_OK);
+    sacd_destroy(ctx);
+
+    ctx = open_reader(TEST_DST_IMAGE, 0);
+    assert_int_equal(sacd_load_frame_index(ctx, TEST_INDEX_1), SACD_OK);
+    check_dst_frames(ctx);
+
+    /* A file for another Track Area is rejected */
+    fp = fopen(TEST_INDEX_2, "wb");
+    assert_non_null(fp);
+    fwrite("SDIX", 1, 4, fp);
+    fclose(fp);
+    assert_int_not_equal(sacd_load_frame_index(ctx, TEST_INDEX_2), SACD_OK);
+    check_dst_frames(ctx);
+
+    sacd_destroy(ctx);
+}
+
+/**
+ * @brief A sidecar is tied to its disc, and wrong entries are not trusted
+ */
+static void test_index_stale(void **state)
+{
+    (void)state;
+    sacd_t *ctx = open_reader(TEST_DST_IMAGE, 0);
+    uint32_t frames = sacd_test_image_frame_count(g_dst);
+    static const uint8_t zero[2048];
+    uint8_t *data;
+    size_t size;
+    FILE *fp;
+
+    assert_int_equal(sacd_save_frame_index(ctx, TEST_INDEX_1), SACD_OK);
+    sacd_destroy(ctx);
+
+    /* Same layout, one sector longer: another disc */
+    data = file_contents(TEST_DST_IMAGE, &size);
+    fp = fopen(TEST_GROWN_IMAGE, "wb");
+    assert_non_null(fp);
+    assert_int_equal(fwrite(data, 1, size, fp), size);
+    assert_int_equal(fwrite(zero, 1, sizeof(zero), fp), sizeof(zero));
+    fclose(fp);
+    free(data);
+
+    ctx = open_reader(TEST_GROWN_IMAGE, 0);
+    assert_int_equal(sacd_load_frame_index(ctx, TEST_INDEX_1), SACD_INVALID_ARGUMENT);
+    sacd_destroy(ctx);
+
+    /* Move some frames one sector later; the rest of the file still fits */
+    data = file_contents(TEST_INDEX_1, &size);
+    assert_int_equal(size, INDEX_HEADER_SIZE + 2 * (size_t)frames);
+    uint8_t *entries = data + INDEX_HEADER_SIZE;
+    int moved = 0;
+    for (uint32_t k = 1; k + 1 < frames; k += 5) {
+        if (entries[2 * k] < UINT8_MAX && entries[2 * (k + 1)] > 0) {
+            entries[2 * k]++;
+            entries[2 * (k + 1)]--;
+            moved++;
+        }
+    }
+    assert_true(moved > 10);
+    fp = fopen(TEST_INDEX_2, "wb");
+    assert_non_null(fp);
+    assert_int_equal(fwrite(data, 1, size, fp), size);
+    fclose(fp);
+    free(data);
+
+    /* Seek to the moved frames backwards, before reads in order fix them */
+    ctx = open_reader(TEST_DST_IMAGE, 0);
+    assert_int_equal(sacd_load_frame_index(ctx, TEST_INDEX_2), SACD_OK);
+    for (int k = 1 + 5 * (int)((frames - 2) / 5); k >= 1; k -= 5) {
+        check_dst_frame(ctx, k);
+    }
+    check_dst_frames(ctx);
+
+    /* The bad entries were corrected by the searches */
+    assert_int_equal(sacd_save_frame_index(ctx, TEST_INDEX_2), SACD_OK);
+    sacd_destroy(ctx);
+    size_t size_1;
+    size_t size_2;
+    uint8_t *index_1 = file_contents(TEST_INDEX_1, &size_1);
+    uint8_t *index_2 = file_contents(TEST_INDEX_2, &size_2);
+    assert_int_equal(size_1, size_2);
+    assert_memory_equal(index_1, index_2, size_1);
+    free(index_1);
+    free(index_2);
+}
+
+/**
+ * @brief A file input survives its image changing on disk
+ *
+ * Once the file grows, no more pointers into the mapping are handed out.
+ * Reads past a truncation fail instead of faulting.
+ */
+static void test_file_changed(void **state)
+{
+    (void)state;
+    static uint8_t sector[2048];
+    sacd_input_t *input = NULL;
+    const uint8_t *ptr = NULL;
+    uint32_t got = 0;
+    size_t size;
+    uint8_t *data = file_contents(TEST_DST_IMAGE, &size);
+    FILE *fp = fopen(TEST_COPY_IMAGE, "wb");
+
+    assert_non_null(fp);
+    assert_int_equal(fwrite(data, 1, size, fp), size);
+    fclose(fp);
+
+    assert_int_equal(sacd_input_open_file(TEST_COPY_IMAGE, &input), SACD_INPUT_OK);
+    uint32_t total = sacd_input_total_sectors(input);
+    assert_int_equal(total, size / sizeof(sector));
+    if (sacd_input_get_sector_ptr(input, total - 1, 1, &ptr, &got) == SACD_INPUT_OK) {
+        assert_int_equal(got, 1);
+        assert_memory_equal(ptr, data + size - sizeof(sector), sizeof(sector));
+    }
+
+    fp = fopen(TEST_COPY_IMAGE, "ab");
+    assert_non_null(fp);
+    assert_int_equal(fwrite(sector, 1, sizeof(sector), fp), sizeof(sector));
+    fclose(fp);
+
+    assert_int_equal(sacd_input_get_sector_ptr(input, 0, 1, &ptr, &got),
+                     SACD_INPUT_ERR_NOT_SUPPORTED);
+    assert_int_equal(sacd_input_read_sectors(input, total - 1, 1, sector, &got),
+                     SACD_INPUT_OK);
+    assert_int_equal(got, 1);
+    assert_memory_equal(sector, data + size - sizeof(sector), sizeof(sector));
+
+#ifndef _WIN32
+    /* Windows does not let a mapped file be truncated */
+    fp = fopen(TEST_COPY_IMAGE, "wb");
+    assert_non_null(fp);
+    assert_int_equal(fwrite(data, 1, size / 2, fp), size / 2);
+    fclose(fp);
+
+    assert_int_not_equal(sacd_input_read_sectors(input, total - 1, 1, sector, &got),
+                         SACD_INPUT_OK);
+    assert_int_equal(got, 0);
+#endif
+
+    sacd_input_close(input);
+    free(data);
+}
+
+/* =============================================================================
+ * Main
+ * ===========================================================================*/
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_dst_frames),
+        cmocka_unit_test(test_dsd_frames),
+        cmocka_unit_test(test_lazy_toc),
+        cmocka_unit_test(test_sound_frames),
+        cmocka_unit_test(test_clone_reads),
+        cmocka_unit_test(test_clone_shares_index),
+        cmocka_unit_test(test_index_sidecar),
+        cmocka_unit_test(test_index_stale),
+        cmocka_unit_test(test_file_changed),
+    };
+
+    return cmocka_run_group_tests_name("SACD Reader", tests,
+                                       setup_images, teardown_images);
+}
@@ -0,0 +1,349 @@
+/*
+ * This file is part of DSD-Nexus.
+ * Copyright (c) 2026 Alexander Wichers
+ *
+ * @brief Unit tests for the SACD network server using CMocka
+ * A server thread exports a generated image and the tests read it back
+ * through sacd_input_network, one or several clients at a time.
+ *
+ * DSD-Nexus is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * DSD-Nexus is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with DSD-Nexus; if not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <libsacd/sacd.h>
+#include <libsacd/sacd_server.h>
+#include "sacd_input.h"
+
+#include <libsautil/mem.h>
+#include <libsautil/c11threads.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#define DISC_SECTORS   1200
+#define IMAGE_PATH     "test_sacd_server.iso"
+#define CLIENT_THREADS 4
+
+typedef struct server_fixture {
+    sacd_server_t *server;
+    uint16_t port;
+    thrd_t thread;
+    uint8_t *buffer;
+} server_fixture_t;
+
+/* =============================================================================
+ * Helpers
+ * ===========================================================================*/
+
+static void fill_sector(uint32_t lsn, uint8_t *buf)
+{
+    uint32_t i;
+
+    for (i = 0; i < SACD_LSN_SIZE; i++)
+    {
+        buf[i] = (uint8_t)((lsn * 13u + i) & 0xFF);
+    }
+    memcpy(buf, &lsn, sizeof(lsn));
+}
+
+static void check_sectors(const uint8_t *buf, uint32_t pos, uint32_t count)
+{
+    uint8_t expected[SACD_LSN_SIZE];
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        fill_sector(pos + i, expected);
+        assert_memory_equal(buf + (size_t)i * SACD_LSN_SIZE, expected,
+                            SACD_LSN_SIZE);
+    }
+}
+
+static int write_image(void)
+{
+    uint8_t sector[SACD_LSN_SIZE];
+    FILE *f = fopen(IMAGE_PATH, "wb");
+    uint32_t lsn;
+
+    if (!f)
+    {
+        return -1;
+    }
+    for (lsn = 0; lsn < DISC_SECTORS; lsn++)
+    {
+        fill_sector(lsn, sector);
+        if (fwrite(sector, SACD_LSN_SIZE, 1, f) != 1)
+        {
+            fclose(f);
+            return -1;
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+static int server_thread(void *arg)
+{
+    return sacd_server_run((sacd_server_t *)arg);
+}
+
+static int start_server(void **state, bool disable_sendfile)
+{
+    server_fixture_t *f = (server_fixture_t *)sa_calloc(1, sizeof(*f));
+    sacd_server_config_t config;
+    uint32_t base;
+    uint32_t attempt;
+
+    memset(&config, 0, sizeof(config));
+    config.bind_address = "127.0.0.1";
+    config.client_window = 4;
+    config.disable_sendfile = disable_sendfile;
+
+    if (!f || write_image() != 0 ||
+        sacd_server_create(&config, &f->server) != SACD_OK)
+    {
+        sa_free(f);
+        return -1;
+    }
+
+    /* Probe for a free port, as the loopback server does */
+    base = 20000u + (uint32_t)(time(NULL) % 20000) + (uint32_t)clock() % 1000u;
+    for (attempt = 0; attempt < 256 && f->port == 0; attempt++)
+    {
+        uint16_t port = (uint16_t)(base + attempt * 11u);
+
+        if (sacd_server_add_export(f->server, IMAGE_PATH, port) == SACD_OK)
+        {
+            f->port = port;
+        }
+    }
+    if (f->port == 0 ||
+        thrd_create(&f->thread, server_thread, f->server) != thrd_success)
+    {
+        sacd_server_destroy(f->server);
+        sa_free(f);
+        return -1;
+    }
+
+    f->buffer = (uint8_t *)sa_malloc((size_t)DISC_SECTORS * SACD_LSN_SIZE);
+    *state = f;
+    return 0;
+}
+
+static int setup_sendfile(void **state)
+{
+    return start_server(state, false);
+}
+
+static int setup_buffered(void **state)
+{
+    return start_server(state, true);
+}
+
+static int teardown_server(void **state)
+{
+    server_fixture_t *f = (server_fixture_t *)*state;
+
+    sacd_server_stop(f->server);
+    thrd_join(f->thread, NULL);
+    sacd_server_destroy(f->server);
+    remove(IMAGE_PATH);
+    sa_free(f->buffer);
+    sa_free(f);
+    return 0;
+}
+
+/* =============================================================================
+ * Tests
+ * ===========================================================================*/
+
+static void test_server_read_whole_disc(void **state)
+{
+    server_fixture_t *f = (server_fixture_t *)*state;
+    sacd_input_t *input = NULL;
+    uint32_t sectors_read = 0;
+
+    assert_int_equal(sacd_input_open_network("127.0.0.1", f->port, &input),
+                     SACD_INPUT_OK);
+    assert_int_equal(sacd_input_total_sectors(input), DISC_SECTORS);
+
+    /* Larger than one response; the client splits it into several */
+    assert_int_equal(sacd_input_read_sectors(input, 0, DISC_SECTORS,
+                                             f->buffer, &sectors_read),
+                     SACD_INPUT_OK);
+    assert_int_equal(sectors_read, DISC_SECTORS);
+    check_sectors(f->buffer, 0, DISC_SECTORS);
+
+    sacd_input_close(input);
+}
+
+static void test_server_end_of_disc(void **state)
+{
+    server_fixture_t *f = (server_fixture_t *)*state;
+    sacd_input_t *input = NULL;
+    uint32_t sectors_read = 0;
+
+    assert_int_equal(sacd_input_open_network("127.0.0.1", f->port, &input),
+                     SACD_INPUT_OK);
+
+    assert_int_equal(sacd_input_read_sectors(input, DISC_SECTORS - 3, 3,
+                                             f->buffer, &sectors_read),
+                     SACD_INPUT_OK);
+    assert_int_equal(sectors_read, 3);
+    check_sectors(f->buffer, DISC_SECTORS - 3, 3);
+
+    /* Reading past the end is a short read */
+    assert_int_equal(sacd_input_read_sectors(input, DISC_SECTORS - 1, 8,
+                                             f->buffer, &sectors_read),
+                     SACD_INPUT_ERR_READ_FAILED);
+    assert_int_equal(sectors_read, 1);
+    check_sectors(f->buffer, DISC_SECTORS - 1, 1);
+
+    /* The connection stays usable */
+    assert_int_equal(sacd_input_read_sectors(input, 5, 2, f->buffer,
+                                             &sectors_read),
+                     SACD_INPUT_OK);
+    check_sectors(f->buffer, 5, 2);
+
+    sacd_input_close(input);
+}
+
+typedef struct client_job {
+    uint16_t port;
+    uint32_t seed;
+    int failures;
+} client_job_t;
+
+static int client_thread(void *arg)
+{
+    client_job_t *job = (client_job_t *)arg;
+    uint8_t *buf = (uint8_t *)sa_malloc((size_t)64 * SACD_LSN_SIZE);
+    uint8_t expected[SACD_LSN_SIZE];
+    sacd_input_t *input = NULL;
+    uint32_t rng = job->seed;
+    int round;
+
+    if (!buf ||
+        sacd_input_open_network("127.0.0.1", job->port, &input) != SACD_INPUT_OK)
+    {
+        sa_free(buf);
+        job->failures++;
+        return 0;
+    }
+
+    for (round = 0; round < 40; round++)
+    {
+        uint32_t pos;
+        uint32_t count;
+        uint32_t sectors_read = 0;
+        uint32_t i;
+
+        rng = rng * 1103515245u + 12345u;
+        count = 1 + (rng >> 16) % 64;
+        rng = rng * 1103515245u + 12345u;
+        pos = (rng >> 8) % (DISC_SECTORS - count);
+
+        if (sacd_input_read_sectors(input, pos, count, buf,
+                                    &sectors_read) != SACD_INPUT_OK ||
+            sectors_read != count)
+        {
+            job->failures++;
+            continue;
+        }
+        for (i = 0; i < count; i++)
+        {
+            fill_sector(pos + i, expected);
+            if (memcmp(buf + (size_t)i * SACD_LSN_SIZE, expected,
+                       SACD_LSN_SIZE) != 0)
+            {
+                job->failures++;
+                break;
+            }
+        }
+    }
+
+    sacd_input_close(input);
+    sa_free(buf);
+    return 0;
+}
+
+static void test_server_concurrent_clients(void **state)
+{
+    server_fixture_t *f = (server_fixture_t *)*state;
+    client_job_t jobs[CLIENT_THREADS];
+    thrd_t threads[CLIENT_THREADS];
+    int i;
+
+    for (i = 0; i < CLIENT_THREADS; i++)
+    {
+        jobs[i].port = f->port;
+        jobs[i].seed = 0x1234u + (uint32_t)i * 977u;
+        jobs[i].failures = 0;
+        assert_int_equal(thrd_create(&threads[i], client_thread, &jobs[i]),
+                         thrd_success);
+    }
+    for (i = 0; i < CLIENT_THREADS; i++)
+    {
+        thrd_join(threads[i], NULL);
+        assert_int_equal(jobs[i].failures, 0);
+    }
+}
+
+static void test_server_invalid_args(void **state)
+{
+    sacd_server_t *server = NULL;
+    sacd_server_config_t config;
+
+    (void)state;
+
+    assert_int_equal(sacd_server_create(NULL, NULL), SACD_INVALID_ARGUMENT);
+
+    memset(&config, 0, sizeof(config));
+    config.bind_address = "not-an-address";
+    assert_int_equal(sacd_server_create(&config, &server),
+                     SACD_INVALID_ARGUMENT);
+    assert_null(server);
+
+    assert_int_equal(sacd_server_create(NULL, &server), SACD_OK);
+    assert_int_equal(sacd_server_add_export(server, "missing.iso", 2002),
+                     SACD_IO_ERROR);
+    assert_int_equal(sacd_server_add_export(server, IMAGE_PATH, 0),
+                     SACD_INVALID_ARGUMENT);
+    assert_int_equal(sacd_server_add_export(NULL, IMAGE_PATH, 2002),
+                     SACD_INVALID_ARGUMENT);
+    sacd_server_destroy(server);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_server_read_whole_disc,
+                                        setup_sendfile, teardown_server),
+        cmocka_unit_test_setup_teardown(test_server_end_of_disc,
+                                        setup_sendfile, teardown_server),
+        cmocka_unit_test_setup_teardown(test_server_concurrent_clients,
+                                        setup_sendfile, teardown_server),
+        cmocka_unit_test_setup_teardown(test_server_read_whole_disc,
+                                        setup_buffered, teardown_server),
+        cmocka_unit_test_setup_teardown(test_server_concurrent_clients,
+                                        setup_buffered, teardown_server),
+        cmocka_unit_test(test_server_invalid_args),
+    };
+
+    return cmocka_run_group_tests_name("sacd_server", tests, NULL, NULL);
+}
@@ -32,6 +32,14 @@
 #include <libsacdvfs/sacd_vfs.h>
 
 #include <libsacd/sacd.h>
+#include "sacd_vfs_cache.h"
+#include "sacd_vfs_dff.h"
+#include "sacd_vfs_internal.h"
+#include "sacd_vfs_pcm.h"
+#include "sacd_overlay_internal.h"
+#include "sacd_test_image.h"
+
+#include <libsautil/sa_tpool.h>
 
 #include <stdarg.h>
 #include <stddef.h>
@@ -42,6 +50,12 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdint.h>
+#ifdef _WIN32
+#include <direct.h>
+#define rmdir _rmdir
+#else
+#include <unistd.h>
+#endif
 
 /* =============================================================================
  * Test Constants - Verify Frame Size Definitions
@@ -1688,6 +1702,1268 @@ static void test_seek_all_channel_counts(void **state)
     }
 }
 
+/* =============================================================================
+ * Test: Decoded Block Cache
+ * ===========================================================================*/
+
+#define TEST_GROUP_SIZE (DSF_BLOCK_SIZE_PER_CHANNEL * 2)
+
+static void fill_group(uint8_t *buf, uint32_t block)
+{
+    for (size_t i = 0; i < TEST_GROUP_SIZE; i++) {
+        buf[i] = (uint8_t)(block * 31 + i);
+    }
+}
+
+/**
+ * @brief A zero budget disables the cache
+ */
+static void test_block_cache_create(void **state)
+{
+    (void)state;
+
+    assert_null(sacd_vfs_block_cache_create(0));
+    sacd_vfs_block_cache_destroy(NULL);
+
+    sacd_vfs_block_cache_t *cache = sacd_vfs_block_cache_create(1024 * 1024);
+    assert_non_null(cache);
+
+    sacd_vfs_block_cache_stats_t stats;
+    sacd_vfs_block_cache_get_stats(cache, &stats);
+    assert_int_equal(stats.max_bytes, 1024 * 1024);
+    assert_int_equal(stats.entries, 0);
+    assert_int_equal(stats.bytes, 0);
+
+    sacd_vfs_block_cache_destroy(cache);
+}
+
+/**
+ * @brief Blocks come back intact and are keyed by owner, area, track and block
+ */
+static void test_block_cache_insert_lookup(void **state)
+{
+    (void)state;
+
+    static uint8_t in[TEST_GROUP_SIZE];
+    static uint8_t out[TEST_GROUP_SIZE];
+    sacd_vfs_block_cache_t *cache = sacd_vfs_block_cache_create(1024 * 1024);
+    assert_non_null(cache);
+
+    uint32_t owner = _vfs_block_cache_attach(cache);
+    vfs_block_key_t key = { owner, SACD_VFS_AREA_STEREO, 1, 7 };
+
+    assert_false(_vfs_block_cache_lookup(cache, &key, out, sizeof(out)));
+
+    fill_group(in, 7);
+    _vfs_block_cache_insert(cache, &key, in, sizeof(in));
+    assert_true(_vfs_block_cache_lookup(cache, &key, out, sizeof(out)));
+    assert_memory_equal(in, out, sizeof(in));
+
+    /* Same block of another track, area or owner is a different entry */
+    vfs_block_key_t other = key;
+    other.track = 2;
+    assert_false(_vfs_block_cache_lookup(cache, &other, out, sizeof(out)));
+    other = key;
+    other.area = SACD_VFS_AREA_MULTICHANNEL;
+    assert_false(_vfs_block_cache_lookup(cache, &other, out, sizeof(out)));
+    other = key;
+    other.owner = _vfs_block_cache_attach(cache);
+    assert_false(_vfs_block_cache_lookup(cache, &other, out, sizeof(out)));
+
+    /* A size mismatch (different channel count) is a miss */
+    assert_false(_vfs_block_cache_lookup(cache, &key, out, sizeof(out) / 2));
+
+    sacd_vfs_block_cache_stats_t stats;
+    sacd_vfs_block_cache_get_stats(cache, &stats);
+    assert_int_equal(stats.hits, 1);
+    assert_int_equal(stats.misses, 5);
+    assert_int_equal(stats.insertions, 1);
+    assert_int_equal(stats.entries, 1);
+
+    sacd_vfs_block_cache_destroy(cache);
+}
+
+/**
+ * @brief The least recently used blocks are evicted to stay within budget
+ */
+static void test_block_cache_eviction(void **state)
+{
+    (void)state;
+
+    static uint8_t in[TEST_GROUP_SIZE];
+    static uint8_t out[TEST_GROUP_SIZE];
+    const size_t budget = TEST_GROUP_SIZE * 4 + 1024;
+    sacd_vfs_block_cache_t *cache = sacd_vfs_block_cache_create(budget);
+    assert_non_null(cache);
+
+    vfs_block_key_t key = { _vfs_block_cache_attach(cache),
+                            SACD_VFS_AREA_STEREO, 1, 0 };
+
+    for (uint32_t block = 0; block < 16; block++) {
+        key.block = block;
+        fill_group(in, block);
+        _vfs_block_cache_insert(cache, &key, in, sizeof(in));
+
+        /* Keep block 0 hot */
+        key.block = 0;
+        assert_true(_vfs_block_cache_lookup(cache, &key, out, sizeof(out)));
+    }
+
+    sacd_vfs_block_cache_stats_t stats;
+    sacd_vfs_block_cache_get_stats(cache, &stats);
+    assert_true(stats.bytes <= budget);
+    assert_true(stats.evictions > 0);
+    assert_int_equal(stats.insertions, 16);
+    assert_int_equal(stats.entries, stats.insertions - stats.evictions);
+
+    key.block = 0;
+    assert_true(_vfs_block_cache_lookup(cache, &key, out, sizeof(out)));
+    fill_group(in, 0);
+    assert_memory_equal(in, out, sizeof(in));
+    key.block = 1;
+    assert_false(_vfs_block_cache_lookup(cache, &key, out, sizeof(out)));
+    key.block = 15;
+    assert_true(_vfs_block_cache_lookup(cache, &key, out, sizeof(out)));
+
+    sacd_vfs_block_cache_destroy(cache);
+}
+
+/**
+ * @brief Purging an owner drops only its blocks
+ */
+static void test_block_cache_purge(void **state)
+{
+    (void)state;
+
+    static uint8_t buf[TEST_GROUP_SIZE];
+    sacd_vfs_block_cache_t *cache = sacd_vfs_block_cache_create(1024 * 1024);
+    assert_non_null(cache);
+
+    vfs_block_key_t a = { _vfs_block_cache_attach(cache), SACD_VFS_AREA_STEREO, 1, 0 };
+    vfs_block_key_t b = { _vfs_block_cache_attach(cache), SACD_VFS_AREA_STEREO, 1, 0 };
+
+    fill_group(buf, 0);
+    for (uint32_t block = 0; block < 4; block++) {
+        a.block = b.block = block;
+        _vfs_block_cache_insert(cache, &a, buf, sizeof(buf));
+        _vfs_block_cache_insert(cache, &b, buf, sizeof(buf));
+    }
+
+    _vfs_block_cache_purge(cache, a.owner);
+
+    sacd_vfs_block_cache_stats_t stats;
+    sacd_vfs_block_cache_get_stats(cache, &stats);
+    assert_int_equal(stats.entries, 4);
+
+    for (uint32_t block = 0; block < 4; block++) {
+        a.block = b.block = block;
+        assert_false(_vfs_block_cache_lookup(cache, &a, buf, sizeof(buf)));
+        assert_true(_vfs_block_cache_lookup(cache, &b, buf, sizeof(buf)));
+    }
+
+    sacd_vfs_block_cache_destroy(cache);
+}
+
+/**
+ * @brief Attaching and detaching a cache on a context
+ */
+static void test_block_cache_set(void **state)
+{
+    (void)state;
+
+    sacd_vfs_block_cache_t *cache = sacd_vfs_block_cache_create(1024 * 1024);
+    assert_non_null(cache);
+
+    assert_int_equal(sacd_vfs_set_block_cache(NULL, cache),
+                     SACD_VFS_ERROR_INVALID_PARAMETER);
+
+    sacd_vfs_ctx_t *ctx = sacd_vfs_create();
+    assert_non_null(ctx);
+    assert_int_equal(sacd_vfs_set_block_cache(ctx, cache), SACD_VFS_OK);
+    assert_int_equal(sacd_vfs_set_block_cache(ctx, NULL), SACD_VFS_OK);
+    assert_int_equal(sacd_vfs_set_block_cache(ctx, cache), SACD_VFS_OK);
+    sacd_vfs_destroy(ctx);
+
+    sacd_vfs_block_cache_destroy(cache);
+}
+
+/* =============================================================================
+ * Test: On-Disk Transcode Cache
+ * ===========================================================================*/
+
+#define TEST_DISK_CACHE_DIR "test_sacd_vfs_cache"
+#define TEST_DISK_CACHE_ISO "test_sacd_vfs_cache.iso"
+
+static void write_fake_iso(size_t size)
+{
+    FILE *f = fopen(TEST_DISK_CACHE_ISO, "wb");
+    assert_non_null(f);
+    for (size_t i = 0; i < size; i++) {
+        fputc((int)(i & 0xFF), f);
+    }
+    fclose(f);
+}
+
+/** Remove the files the cache wrote for TEST_DISK_CACHE_ISO */
+static void remove_disk_cache(void)
+{
+    /* Directory name: FNV-1a hash of the ISO path, as the cache does */
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (const char *p = TEST_DISK_CACHE_ISO; *p; p++) {
+        h ^= (unsigned char)*p;
+        h *= 0x100000001B3ull;
+    }
+
+    char dir[256];
+    char path[300];
+    snprintf(dir, sizeof(dir), TEST_DISK_CACHE_DIR "/%016llx", (unsigned long long)h);
+    snprintf(path, sizeof(path), "%s/s001.dat", dir);
+    remove(path);
+    snprintf(path, sizeof(path), "%s/s001.map", dir);
+    remove(path);
+    snprintf(path, sizeof(path), "%s/iso.info", dir);
+    remove(path);
+    rmdir(dir);
+    rmdir(TEST_DISK_CACHE_DIR);
+    remove(TEST_DISK_CACHE_ISO);
+}
+
+/**
+ * @brief Invalid arguments
+ */
+static void test_disk_cache_create(void **state)
+{
+    (void)state;
+
+    assert_null(sacd_vfs_disk_cache_create(NULL, 1024 * 1024));
+    assert_null(sacd_vfs_disk_cache_create("", 1024 * 1024));
+    assert_null(sacd_vfs_disk_cache_create(TEST_DISK_CACHE_DIR, 0));
+    sacd_vfs_disk_cache_destroy(NULL);
+
+    assert_int_equal(sacd_vfs_set_disk_cache(NULL, NULL),
+                     SACD_VFS_ERROR_INVALID_PARAMETER);
+}
+
+/**
+ * @brief Blocks survive closing the cache and are dropped when the ISO changes
+ */
+static void test_disk_cache_persistence(void **state)
+{
+    (void)state;
+
+    static uint8_t in[TEST_GROUP_SIZE];
+    static uint8_t out[TEST_GROUP_SIZE];
+    sacd_vfs_disk_cache_stats_t stats;
+
+    remove_disk_cache();
+    write_fake_iso(1000);
+
+    sacd_vfs_disk_cache_t *cache = sacd_vfs_disk_cache_create(TEST_DISK_CACHE_DIR,
+                                                              1024 * 1024);
+    assert_non_null(cache);
+    uint32_t iso = _vfs_disk_cache_attach(cache, TEST_DISK_CACHE_ISO);
+    assert_int_not_equal(iso, 0);
+
+    /* Blocks 2 and 5 only; the rest of the track stays a hole */
+    vfs_block_key_t key = { iso, SACD_VFS_AREA_STEREO, 1, 2 };
+    fill_group(in, 2);
+    _vfs_disk_cache_insert(cache, &key, in, sizeof(in));
+    key.block = 5;
+    fill_group(in, 5);
+    _vfs_disk_cache_insert(cache, &key, in, sizeof(in));
+
+    key.block = 3;
+    assert_false(_vfs_disk_cache_lookup(cache, &key, out, sizeof(out)));
+    key.block = 5;
+    assert_true(_vfs_disk_cache_lookup(cache, &key, out, sizeof(out)));
+    assert_memory_equal(in, out, sizeof(in));
+
+    _vfs_disk_cache_detach(cache, iso);
+    sacd_vfs_disk_cache_destroy(cache);
+
+    /* Reopened: the files are found again */
+    cache = sacd_vfs_disk_cache_create(TEST_DISK_CACHE_DIR, 1024 * 1024);
+    assert_non_null(cache);
+    assert_int_equal(sacd_vfs_disk_cache_get_stats(cache, &stats), SACD_VFS_OK);
+    assert_int_equal(stats.files, 1);
+    assert_int_equal(stats.bytes, 2 * TEST_GROUP_SIZE);
+
+    iso = _vfs_disk_cache_attach(cache, TEST_DISK_CACHE_ISO);
+    key.owner = iso;
+    key.block = 2;
+    assert_true(_vfs_disk_cache_lookup(cache, &key, out, sizeof(out)));
+    fill_group(in, 2);
+    assert_memory_equal(in, out, sizeof(in));
+    /* Another channel count is a miss */
+    assert_false(_vfs_disk_cache_lookup(cache, &key, out, sizeof(out) / 2));
+    _vfs_disk_cache_detach(cache, iso);
+
+    /* The ISO changed size: its blocks are stale */
+    write_fake_iso(2000);
+    iso = _vfs_disk_cache_attach(cache, TEST_DISK_CACHE_ISO);
+    key.owner = iso;
+    assert_false(_vfs_disk_cache_lookup(cache, &key, out, sizeof(out)));
+    assert_int_equal(sacd_vfs_disk_cache_get_stats(cache, &stats), SACD_VFS_OK);
+    assert_int_equal(stats.files, 0);
+    assert_int_equal(stats.bytes, 0);
+    _vfs_disk_cache_detach(cache, iso);
+
+    sacd_vfs_disk_cache_destroy(cache);
+    remove_disk_cache();
+}
+
+/* =============================================================================
+ * Test: Deferred MT Pipeline
+ * ===========================================================================*/
+
+#define TEST_MT_ISO "test_sacd_vfs_mt.iso"
+
+/** Process queue depth, and so the largest window, for a 2-thread pool */
+#define TEST_MT_MAX_WINDOW 16
+
+typedef struct {
+    sa_tpool *pool;
+    sacd_vfs_ctx_t *ctx;
+    sacd_vfs_file_t *file;
+    sacd_vfs_file_info_t info;
+} mt_fixture_t;
+
+static int setup_mt_file(void **state)
+{
+    sacd_test_image_t *image = NULL;
+    char album[256];
+    char name[256];
+    char path[600];
+
+    if (sacd_test_image_create(true, &image) != 0) {
+        return -1;
+    }
+    int ret = sacd_test_image_write(image, TEST_MT_ISO);
+    sacd_test_image_free(image);
+    if (ret != 0) {
+        return -1;
+    }
+
+    mt_fixture_t *fx = (mt_fixture_t *)calloc(1, sizeof(mt_fixture_t));
+    if (!fx) {
+        return -1;
+    }
+    fx->pool = sa_tpool_init(2);
+    fx->ctx = sacd_vfs_create();
+    if (!fx->pool || !fx->ctx ||
+        sacd_vfs_open(fx->ctx, TEST_MT_ISO) != SACD_VFS_OK ||
+        sacd_vfs_get_album_name(fx->ctx, album, sizeof(album)) != SACD_VFS_OK ||
+        sacd_vfs_get_track_filename(fx->ctx, SACD_VFS_AREA_STEREO, 1,
+                                    name, sizeof(name)) != SACD_VFS_OK) {
+        return -1;
+    }
+    snprintf(path, sizeof(path), "/%s/Stereo/%s", album, name);
+    if (sacd_vfs_file_open_mt(fx->ctx, path, fx->pool, &fx->file) != SACD_VFS_OK ||
+        sacd_vfs_file_get_info(fx->file, &fx->info) != SACD_VFS_OK) {
+        return -1;
+    }
+
+    *state = fx;
+    return 0;
+}
+
+static int teardown_mt_file(void **state)
+{
+    mt_fixture_t *fx = (mt_fixture_t *)*state;
+
+    if (fx) {
+        sacd_vfs_file_close(fx->file);
+        sacd_vfs_destroy(fx->ctx);
+        if (fx->pool) {
+            sa_tpool_destroy(fx->pool);
+        }
+        free(fx);
+    }
+    remove(TEST_MT_ISO);
+    return 0;
+}
+
+/**
+ * @brief Reading the header and the ID3 tag decodes nothing
+ */
+static void test_mt_deferred_start(void **state)
+{
+    mt_fixture_t *fx = (mt_fixture_t *)*state;
+    static uint8_t buf[2 * DSF_BLOCK_SIZE_PER_CHANNEL];
+    size_t n = 0;
+
+    assert_int_equal(_vfs_file_mt_window(fx->file), 0);
+
+    /* Header, as a tag scanner reads it */
+    assert_int_equal(sacd_vfs_file_read(fx->file, buf, fx->info.header_size, &n),
+                     SACD_VFS_OK);
+    assert_int_equal(n, fx->info.header_size);
+    assert_int_equal(_vfs_file_mt_window(fx->file), 0);
+
+    /* Trailing ID3 tag */
+    assert_int_equal(sacd_vfs_file_seek(fx->file, (int64_t)fx->info.metadata_offset,
+                                        SEEK_SET),
+                     SACD_VFS_OK);
+    if (fx->info.metadata_size > 0) {
+        assert_int_equal(sacd_vfs_file_read(fx->file, buf, sizeof(buf), &n),
+                         SACD_VFS_OK);
+        assert_true(n > 0);
+    }
+    assert_int_equal(_vfs_file_mt_window(fx->file), 0);
+
+    /* The first audio read starts the pipeline */
+    assert_int_equal(sacd_vfs_file_seek(fx->file, (int64_t)fx->info.header_size,
+                                        SEEK_SET),
+                     SACD_VFS_OK);
+    assert_int_equal(_vfs_file_mt_window(fx->file), 0);
+    assert_int_equal(sacd_vfs_file_read(fx->file, buf, sizeof(buf), &n),
+                     SACD_VFS_OK);
+    assert_int_equal(n, sizeof(buf));
+    assert_int_not_equal(_vfs_file_mt_window(fx->file), 0);
+}
+
+/**
+ * @brief The window doubles on sequential reads and resets on a seek
+ */
+static void test_mt_window(void **state)
+{
+    mt_fixture_t *fx = (mt_fixture_t *)*state;
+    static uint8_t buf[2 * DSF_BLOCK_SIZE_PER_CHANNEL];
+    uint32_t window = 0;
+    uint32_t last = 0;
+    size_t n = 0;
+
+    assert_int_equal(sacd_vfs_file_seek(fx->file, (int64_t)fx->info.header_size,
+                                        SEEK_SET),
+                     SACD_VFS_OK);
+    assert_int_equal(sacd_vfs_file_read(fx->file, buf, sizeof(buf), &n),
+                     SACD_VFS_OK);
+    last = _vfs_file_mt_window(fx->file);
+    /* Grown by the frames in that block group only */
+    assert_true(last >= 2 && last < TEST_MT_MAX_WINDOW);
+
+    /* Sequential reads: each change is a doubling, up to the queue depth */
+    for (int i = 0; i < 40; i++) {
+        assert_int_equal(sacd_vfs_file_read(fx->file, buf, sizeof(buf), &n),
+                         SACD_VFS_OK);
+        assert_int_equal(n, sizeof(buf));
+        window = _vfs_file_mt_window(fx->file);
+        if (window != last) {
+            assert_int_equal(window, 2 * last);
+        }
+        last = window;
+    }
+    assert_int_equal(window, TEST_MT_MAX_WINDOW);
+
+    /* A seek starts over with a small window */
+    uint64_t middle = fx->info.header_size + fx->info.audio_data_size / 2;
+    assert_int_equal(sacd_vfs_file_seek(fx->file, (int64_t)middle, SEEK_SET),
+                     SACD_VFS_OK);
+    assert_int_equal(_vfs_file_mt_window(fx->file), 2);
+    assert_int_equal(sacd_vfs_file_read(fx->file, buf, sizeof(buf), &n),
+                     SACD_VFS_OK);
+    assert_true(_vfs_file_mt_window(fx->file) < TEST_MT_MAX_WINDOW);
+}
+
+/* =============================================================================
+ * Test: Overlay Mount Index
+ * ===========================================================================*/
+
+#define TEST_MOUNT_COUNT 1000
+
+static iso_mount_t *register_test_iso(sacd_overlay_ctx_t *ctx, int i)
+{
+    char iso_path[64];
+    char parent[64];
+    char name[64];
+
+    snprintf(iso_path, sizeof(iso_path), "/src/dir%d/album%d.iso", i % 10, i);
+    snprintf(parent, sizeof(parent), "/dir%d", i % 10);
+    snprintf(name, sizeof(name), "album%d", i);
+    return _overlay_get_or_create_iso(ctx, iso_path, parent, name, 0);
+}
+
+/**
+ * @brief Registered ISOs are found by source path and by virtual path
+ */
+static void test_overlay_mount_index(void **state)
+{
+    (void)state;
+
+    sacd_overlay_config_t config;
+    sacd_overlay_config_init(&config);
+    config.source_dir = ".";
+    config.block_cache_size = 0;
+    sacd_overlay_ctx_t *ctx = sacd_overlay_create(&config);
+    assert_non_null(ctx);
+
+    assert_null(_overlay_find_iso_mount(ctx, "/src/dir0/album0.iso"));
+    assert_null(_overlay_find_iso_by_vpath(ctx, "/dir0/album0"));
+
+    iso_mount_t *mounts[TEST_MOUNT_COUNT];
+    for (int i = 0; i < TEST_MOUNT_COUNT; i++) {
+        mounts[i] = register_test_iso(ctx, i);
+        assert_non_null(mounts[i]);
+    }
+    /* Registering again returns the same entry */
+    assert_true(register_test_iso(ctx, 123) == mounts[123]);
+
+    /* A folder nested in a folder named like an ISO */
+    iso_mount_t *nested = _overlay_get_or_create_iso(
+        ctx, "/src/dir1/album1/inner.iso", "/dir1/album1", "inner", 0);
+    assert_non_null(nested);
+
+    for (int i = 0; i < TEST_MOUNT_COUNT; i++) {
+        char path[128];
+
+        snprintf(path, sizeof(path), "/src/dir%d/album%d.iso", i % 10, i);
+        assert_true(_overlay_find_iso_mount(ctx, path) == mounts[i]);
+
+        snprintf(path, sizeof(path), "/dir%d/album%d", i % 10, i);
+        assert_true(_overlay_find_iso_by_vpath(ctx, path) == mounts[i]);
+
+        snprintf(path, sizeof(path), "/dir%d/album%d/", i % 10, i);
+        assert_true(_overlay_find_iso_by_vpath(ctx, path) == mounts[i]);
+
+        snprintf(path, sizeof(path), "/dir%d/album%d/Stereo/01. Track.dsf", i % 10, i);
+        assert_true(_overlay_find_iso_by_vpath(ctx, path) == mounts[i]);
+    }
+
+    /* The most specific mount wins */
+    assert_true(_overlay_find_iso_by_vpath(ctx, "/dir1/album1/inner/Stereo") == nested);
+    assert_true(_overlay_find_iso_by_vpath(ctx, "/dir1/album1/innerX") == mounts[1]);
+
+    /* Only whole path components match */
+    assert_null(_overlay_find_iso_by_vpath(ctx, "/dir0/album"));
+    assert_null(_overlay_find_iso_by_vpath(ctx, "/dir0/album00"));
+    assert_null(_overlay_find_iso_by_vpath(ctx, "/dir0"));
+    assert_null(_overlay_find_iso_by_vpath(ctx, "/"));
+    assert_null(_overlay_find_iso_mount(ctx, "/src/dir0/album1.iso"));
+
+    /* Removal keeps the others reachable */
+    _overlay_cleanup_iso(ctx, mounts[500]);
+    assert_null(_overlay_find_iso_by_vpath(ctx, "/dir0/album500"));
+    assert_null(_overlay_find_iso_mount(ctx, "/src/dir0/album500.iso"));
+    assert_true(_overlay_find_iso_by_vpath(ctx, "/dir1/album501") == mounts[501]);
+
+    sacd_overlay_destroy(ctx);
+}
+
+typedef struct {
+    sacd_overlay_ctx_t *ctx;
+    int failures;
+} mount_lookup_job_t;
+
+static int mount_lookup_thread(void *arg)
+{
+    mount_lookup_job_t *job = (mount_lookup_job_t *)arg;
+
+    /* Look up mounts while the main thread keeps registering (and so
+     * growing the index); the first half is registered before we start */
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < TEST_MOUNT_COUNT / 2; i++) {
+            char path[128];
+            char name[64];
+            snprintf(path, sizeof(path), "/dir%d/album%d/Stereo", i % 10, i);
+            snprintf(name, sizeof(name), "album%d", i);
+            iso_mount_t *mount = _overlay_find_iso_by_vpath(job->ctx, path);
+            if (!mount || strcmp(mount->display_name, name) != 0) {
+                job->failures++;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Lookups run concurrently with registrations
+ */
+static void test_overlay_mount_index_concurrent(void **state)
+{
+    (void)state;
+
+    sacd_overlay_config_t config;
+    sacd_overlay_config_init(&config);
+    config.source_dir = ".";
+    config.block_cache_size = 0;
+    sacd_overlay_ctx_t *ctx = sacd_overlay_create(&config);
+    assert_non_null(ctx);
+
+    for (int i = 0; i < TEST_MOUNT_COUNT / 2; i++) {
+        assert_non_null(register_test_iso(ctx, i));
+    }
+
+    mount_lookup_job_t jobs[4];
+    thrd_t threads[4];
+    for (int t = 0; t < 4; t++) {
+        jobs[t].ctx = ctx;
+        jobs[t].failures = 0;
+        assert_int_equal(thrd_create(&threads[t], mount_lookup_thread, &jobs[t]),
+                         thrd_success);
+    }
+    for (int i = TEST_MOUNT_COUNT / 2; i < TEST_MOUNT_COUNT * 8; i++) {
+        assert_non_null(register_test_iso(ctx, i));
+    }
+    for (int t = 0; t < 4; t++) {
+        thrd_join(threads[t], NULL);
+        assert_int_equal(jobs[t].failures, 0);
+    }
+
+    sacd_overlay_destroy(ctx);
+}
+
+/* =============================================================================
+ * Test: Overlay SACD Detection Cache
+ * ===========================================================================*/
+
+#define TEST_DETECT_SRC   "test_detect_src"
+#define TEST_DETECT_CACHE "test_detect_cache"
+
+static const char *const test_detect_files[] = {
+    TEST_DETECT_SRC "/a.iso",
+    TEST_DETECT_SRC "/b.iso",
+    TEST_DETECT_SRC "/c.iso",
+    TEST_DETECT_SRC "/notes.txt",
+};
+
+static void write_test_file(const char *path, size_t size)
+{
+    FILE *f = fopen(path, "wb");
+    assert_non_null(f);
+    for (size_t i = 0; i < size; i++) {
+        fputc(0, f);
+    }
+    fclose(f);
+}
+
+static void remove_detect_files(void)
+{
+    for (size_t i = 0; i < sizeof(test_detect_files) / sizeof(test_detect_files[0]); i++) {
+        remove(test_detect_files[i]);
+    }
+    remove(TEST_DETECT_CACHE "/detect.cache");
+    rmdir(TEST_DETECT_CACHE);
+    rmdir(TEST_DETECT_SRC);
+}
+
+static int count_entry_cb(const sacd_overlay_entry_t *entry, void *userdata)
+{
+    (void)entry;
+    (*(int *)userdata)++;
+    return 0;
+}
+
+static sacd_overlay_ctx_t *create_detect_overlay(void)
+{
+    sacd_overlay_config_t config;
+    sacd_overlay_config_init(&config);
+    config.source_dir = TEST_DETECT_SRC;
+    config.thread_pool_size = -1;
+    config.block_cache_size = 0;
+    config.disk_cache_dir = TEST_DETECT_CACHE;
+    config.disk_cache_size = 1024 * 1024;
+    return sacd_overlay_create(&config);
+}
+
+/**
+ * @brief Non-SACD ISOs are probed once, again after a change, and the
+ *        results are reused by the next overlay on the same cache directory
+ */
+static void test_overlay_detect_cache(void **state)
+{
+    (void)state;
+
+    sacd_overlay_entry_t entry;
+    uint64_t hits, probes;
+    int listed;
+
+    remove_detect_files();
+#ifdef _WIN32
+    assert_int_equal(_mkdir(TEST_DETECT_SRC), 0);
+#else
+    assert_int_equal(mkdir(TEST_DETECT_SRC, 0755), 0);
+#endif
+    for (size_t i = 0; i < sizeof(test_detect_files) / sizeof(test_detect_files[0]); i++) {
+        write_test_file(test_detect_files[i], 4096);
+    }
+
+    sacd_overlay_ctx_t *ctx = create_detect_overlay();
+    assert_non_null(ctx);
+
+    /* Only notes.txt is listed; each ISO is opened once */
+    listed = 0;
+    assert_int_equal(sacd_overlay_readdir(ctx, "/", count_entry_cb, &listed), 1);
+    assert_int_equal(listed, 1);
+    _overlay_detect_get_stats(ctx, &hits, &probes);
+    assert_int_equal(probes, 3);
+    assert_int_equal(hits, 0);
+
+    listed = 0;
+    assert_int_equal(sacd_overlay_readdir(ctx, "/", count_entry_cb, &listed), 1);
+    assert_int_equal(sacd_overlay_stat(ctx, "/a", &entry), SACD_OVERLAY_ERROR_NOT_FOUND);
+    _overlay_detect_get_stats(ctx, &hits, &probes);
+    assert_int_equal(probes, 3);
+    assert_int_equal(hits, 4);
+
+    /* A changed file is probed again */
+    write_test_file(TEST_DETECT_SRC "/b.iso", 8192);
+    listed = 0;
+    assert_int_equal(sacd_overlay_readdir(ctx, "/", count_entry_cb, &listed), 1);
+    _overlay_detect_get_stats(ctx, &hits, &probes);
+    assert_int_equal(probes, 4);
+    assert_int_equal(hits, 6);
+
+    sacd_overlay_destroy(ctx);
+
+    /* The next overlay starts with the saved results */
+    ctx = create_detect_overlay();
+    assert_non_null(ctx);
+    listed = 0;
+    assert_int_equal(sacd_overlay_readdir(ctx, "/", count_entry_cb, &listed), 1);
+    _overlay_detect_get_stats(ctx, &hits, &probes);
+    assert_int_equal(probes, 0);
+    assert_int_equal(hits, 3);
+    sacd_overlay_destroy(ctx);
+
+    remove_detect_files();
+}
+
+/* =============================================================================
+ * Test: Overlay ISO Summary
+ * ===========================================================================*/
+
+#define TEST_SUMMARY_SRC "test_summary_src"
+#define TEST_SUMMARY_ISO TEST_SUMMARY_SRC "/album.iso"
+
+typedef struct {
+    char names[8][64];
+    uint64_t sizes[8];
+    int count;
+} collect_entries_t;
+
+static int collect_entry_cb(const sacd_overlay_entry_t *entry, void *userdata)
+{
+    collect_entries_t *c = (collect_entries_t *)userdata;
+    if (c->count < 8) {
+        snprintf(c->names[c->count], sizeof(c->names[0]), "%s", entry->name);
+        c->sizes[c->count] = entry->size;
+    }
+    c->count++;
+    return 0;
+}
+
+/** Append a little-endian field to a summary blob */
+static uint8_t *put_le(uint8_t *p, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        *p++ = (uint8_t)(v >> (8 * i));
+    }
+    return p;
+}
+
+static uint8_t *put_str(uint8_t *p, const char *s)
+{
+    size_t n = strlen(s);
+    p = put_le(p, n, 2);
+    memcpy(p, s, n);
+    return p + n;
+}
+
+/**
+ * @brief A stored summary answers stat and readdir without mounting the ISO
+ */
+static void test_overlay_summary(void **state)
+{
+    (void)state;
+
+    sacd_overlay_entry_t entry;
+    collect_entries_t c;
+
+    remove(TEST_SUMMARY_ISO);
+    rmdir(TEST_SUMMARY_SRC);
+#ifdef _WIN32
+    assert_int_equal(_mkdir(TEST_SUMMARY_SRC), 0);
+#else
+    assert_int_equal(mkdir(TEST_SUMMARY_SRC, 0755), 0);
+#endif
+    /* Not an SACD image: anything that mounts it fails */
+    write_test_file(TEST_SUMMARY_ISO, 4096);
+
+    sacd_overlay_config_t config;
+    sacd_overlay_config_init(&config);
+    config.source_dir = TEST_SUMMARY_SRC;
+    config.thread_pool_size = -1;
+    config.block_cache_size = 0;
+    config.dst_passthrough = true;
+    config.pcm_sample_rate = 88200;
+    sacd_overlay_ctx_t *ctx = sacd_overlay_create(&config);
+    assert_non_null(ctx);
+
+    iso_mount_t *mount = _overlay_get_or_create_iso(ctx, TEST_SUMMARY_ISO, "/",
+                                                    "album", 0);
+    assert_non_null(mount);
+
+    /* No summary yet: the ISO has to be mounted, which fails */
+    assert_int_equal(sacd_overlay_stat(ctx, "/album/Test/Stereo", &entry),
+                     SACD_OVERLAY_ERROR_IO);
+
+    /* Both areas visible, .dff files on, 88.2 kHz/24-bit .wav files, no
+     * sidecar, album "Test", stereo with two tracks, the first one with a
+     * .dff twin, both with a .wav twin */
+    uint8_t blob[128];
+    uint8_t *p = blob;
+    *p++ = 3;
+    *p++ = 7;
+    *p++ = 0;
+    p = put_le(p, 0, 8);
+    p = put_le(p, 0, 8);
+    p = put_le(p, 88200, 4);
+    *p++ = 24;
+    p = put_str(p, "Test");
+    *p++ = 1;
+    *p++ = SACD_VFS_AREA_STEREO;
+    *p++ = 2;
+    p = put_le(p, 1000, 8);
+    p = put_le(p, 600, 8);
+    p = put_le(p, 1500, 8);
+    p = put_str(p, "01. One.dsf");
+    p = put_le(p, 2000, 8);
+    p = put_le(p, 0, 8);
+    p = put_le(p, 3000, 8);
+    p = put_str(p, "02. Two.dsf");
+
+    struct stat st;
+    assert_int_equal(stat(TEST_SUMMARY_ISO, &st), 0);
+    _overlay_detect_set_summary(ctx, TEST_SUMMARY_ISO, &st, blob, (size_t)(p - blob));
+
+    memset(&c, 0, sizeof(c));
+    assert_int_equal(sacd_overlay_readdir(ctx, "/album", collect_entry_cb, &c), 1);
+    assert_string_equal(c.names[0], "Test");
+
+    memset(&c, 0, sizeof(c));
+    assert_int_equal(sacd_overlay_readdir(ctx, "/album/Test", collect_entry_cb, &c), 1);
+    assert_string_equal(c.names[0], "Stereo");
+
+    memset(&c, 0, sizeof(c));
+    assert_int_equal(sacd_overlay_readdir(ctx, "/album/Test/Stereo", collect_entry_cb, &c), 5);
+    assert_string_equal(c.names[0], "01. One.dsf");
+    assert_string_equal(c.names[1], "01. One.dff");
+    assert_string_equal(c.names[2], "01. One.wav");
+    assert_string_equal(c.names[3], "02. Two.dsf");
+    assert_string_equal(c.names[4], "02. Two.wav");
+    assert_int_equal(c.sizes[0], 1000);
+    assert_int_equal(c.sizes[1], 600);
+    assert_int_equal(c.sizes[2], 1500);
+    assert_int_equal(c.sizes[3], 2000);
+    assert_int_equal(c.sizes[4], 3000);
+
+    assert_int_equal(sacd_overlay_stat(ctx, "/album/Test/Stereo/02. Two.dsf", &entry),
+                     SACD_OVERLAY_OK);
+    assert_int_equal(entry.type, SACD_OVERLAY_ENTRY_FILE);
+    assert_int_equal(entry.size, 2000);
+    assert_int_equal(sacd_overlay_stat(ctx, "/album/Test/Stereo/03. Three.dsf", &entry),
+                     SACD_OVERLAY_ERROR_NOT_FOUND);
+    assert_int_equal(sacd_overlay_stat(ctx, "/album/Test/Stereo/01. One.dff", &entry),
+                     SACD_OVERLAY_OK);
+    assert_int_equal(entry.size, 600);
+    assert_int_equal(sacd_overlay_stat(ctx, "/album/Test/Stereo/02. Two.dff", &entry),
+                     SACD_OVERLAY_ERROR_NOT_FOUND);
+    assert_int_equal(sacd_overlay_stat(ctx, "/album/Test/Stereo/02. Two.wav", &entry),
+                     SACD_OVERLAY_OK);
+    assert_int_equal(entry.size, 3000);
+    assert_int_equal(sacd_overlay_stat(ctx, "/album/Test/Multi-channel", &entry),
+                     SACD_OVERLAY_ERROR_NOT_FOUND);
+
+    assert_int_equal(sacd_overlay_get_mounted_iso_count(ctx), 0);
+
+    /* Dropping it brings back the mount attempt */
+    _overlay_summary_invalidate(ctx, mount);
+    assert_int_equal(sacd_overlay_stat(ctx, "/album/Test/Stereo", &entry),
+                     SACD_OVERLAY_ERROR_IO);
+
+    sacd_overlay_destroy(ctx);
+    remove(TEST_SUMMARY_ISO);
+    rmdir(TEST_SUMMARY_SRC);
+}
+
+/* =============================================================================
+ * Test: DSDIFF/DST Passthrough Layout
+ * ===========================================================================*/
+
+static uint64_t get_be(const uint8_t *p, int bytes)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+/**
+ * @brief Synthesized chunks walk as a valid DSDIFF/DST file
+ */
+static void test_dff_layout(void **state)
+{
+    (void)state;
+
+    static const uint32_t sizes[] = { 5, 8, 3 };
+    vfs_dff_layout_t *layout = _vfs_dff_layout_create(sizes, 3, 2, SACD_SAMPLING_FREQUENCY, 7);
+    assert_non_null(layout);
+    assert_int_equal(layout->total_size % 2, 0);
+    assert_int_equal(layout->header_size, 16 + 16 + 16 + 16 + 22 + 28 + 12 + 18);
+
+    /* Assemble the file, frame payloads filled with their frame number */
+    uint8_t *file = malloc((size_t)layout->total_size);
+    assert_non_null(file);
+    uint64_t pos = 0;
+    while (pos < layout->total_size) {
+        uint32_t frame, within;
+        if (_vfs_dff_find_payload(layout, pos, &frame, &within)) {
+            file[pos++] = (uint8_t)(0xA0 + frame);
+        } else if (pos >= layout->id3_offset && pos < layout->id3_offset + layout->id3_size) {
+            file[pos++] = 0x1D;
+        } else {
+            size_t n = _vfs_dff_read_structure(layout, pos, file + pos,
+                                               (size_t)(layout->total_size - pos));
+            assert_true(n > 0);
+            pos += n;
+        }
+    }
+
+    assert_memory_equal(file, "FRM8", 4);
+    assert_int_equal(get_be(file + 4, 8), layout->total_size - 12);
+    assert_memory_equal(file + 12, "DSD ", 4);
+
+    /* Walk the top-level chunks */
+    uint64_t off = 16;
+    int seen_dst = 0, seen_index = 0, seen_id3 = 0;
+    while (off < layout->total_size) {
+        const uint8_t *ck = file + off;
+        uint64_t len = get_be(ck + 4, 8);
+
+        if (memcmp(ck, "PROP", 4) == 0) {
+            assert_memory_equal(ck + 12, "SND ", 4);
+            assert_memory_equal(ck + 16, "FS  ", 4);
+            assert_int_equal(get_be(ck + 28, 4), SACD_SAMPLING_FREQUENCY);
+            assert_memory_equal(ck + 32, "CHNL", 4);
+            assert_int_equal(get_be(ck + 44, 2), 2);
+            assert_memory_equal(ck + 46, "SLFTSRGT", 8);
+            assert_memory_equal(ck + 54, "CMPR", 4);
+            assert_memory_equal(ck + 66, "DST ", 4);
+        } else if (memcmp(ck, "DST ", 4) == 0) {
+            assert_int_equal(off + 12 + len, layout->data_end);
+            assert_memory_equal(ck + 12, "FRTE", 4);
+            assert_int_equal(get_be(ck + 24, 4), 3);
+            assert_int_equal(get_be(ck + 28, 2), SACD_FRAMES_PER_SEC);
+
+            uint64_t f = off + 30;
+            for (uint32_t i = 0; i < 3; i++) {
+                assert_memory_equal(file + f, "DSTF", 4);
+                assert_int_equal(get_be(file + f + 4, 8), sizes[i]);
+                assert_int_equal(layout->frame_pos[i], f + 12);
+                for (uint32_t b = 0; b < sizes[i]; b++) {
+                    assert_int_equal(file[f + 12 + b], 0xA0 + i);
+                }
+                f += 12 + sizes[i] + (sizes[i] & 1);
+            }
+            assert_int_equal(f, layout->data_end);
+            seen_dst = 1;
+        } else if (memcmp(ck, "DSTI", 4) == 0) {
+            assert_int_equal(len, 3 * 12);
+            for (uint32_t i = 0; i < 3; i++) {
+                assert_int_equal(get_be(ck + 12 + i * 12, 8), layout->frame_pos[i]);
+                assert_int_equal(get_be(ck + 20 + i * 12, 4), sizes[i]);
+            }
+            seen_index = 1;
+        } else if (memcmp(ck, "ID3 ", 4) == 0) {
+            assert_int_equal(len, 7);
+            assert_int_equal(off + 12, layout->id3_offset);
+            assert_int_equal(ck[12], 0x1D);
+            seen_id3 = 1;
+        }
+        off += 12 + len + (len & 1);
+    }
+    assert_int_equal(off, layout->total_size);
+    assert_true(seen_dst && seen_index && seen_id3);
+
+    /* Reads stop at payloads; payload offsets map back to their frame */
+    uint8_t buf[64];
+    assert_int_equal(_vfs_dff_read_structure(layout, layout->frame_pos[1], buf, sizeof(buf)), 0);
+    assert_int_equal(_vfs_dff_read_structure(layout, layout->frame_pos[1] - 12, buf, sizeof(buf)), 12);
+    uint32_t frame, within;
+    assert_true(_vfs_dff_find_payload(layout, layout->frame_pos[2] + 2, &frame, &within));
+    assert_int_equal(frame, 2);
+    assert_int_equal(within, 2);
+    assert_false(_vfs_dff_find_payload(layout, layout->frame_pos[0] + 5, &frame, &within));
+
+    free(file);
+    _vfs_dff_layout_free(layout);
+}
+
+/**
+ * @brief Tracks without frames or tag still form a complete file
+ */
+static void test_dff_layout_empty(void **state)
+{
+    (void)state;
+
+    vfs_dff_layout_t *layout = _vfs_dff_layout_create(NULL, 0, 6, SACD_SAMPLING_FREQUENCY, 0);
+    assert_non_null(layout);
+    assert_int_equal(layout->data_end, layout->header_size);
+    assert_int_equal(layout->total_size, layout->data_end + 12);
+    assert_int_equal(layout->id3_offset, layout->total_size);
+
+    assert_null(_vfs_dff_layout_create(NULL, 0, 0, SACD_SAMPLING_FREQUENCY, 0));
+    assert_null(_vfs_dff_layout_create(NULL, 1, 2, SACD_SAMPLING_FREQUENCY, 0));
+
+    assert_int_equal(sacd_vfs_set_dst_passthrough(NULL, true),
+                     SACD_VFS_ERROR_INVALID_PARAMETER);
+    assert_false(sacd_vfs_get_dst_passthrough(NULL));
+
+    _vfs_dff_layout_free(layout);
+    _vfs_dff_layout_free(NULL);
+}
+
+#define TEST_DFF_ISO "test_sacd_vfs_dff.iso"
+#define TEST_DFF_OPENERS 4
+
+typedef struct {
+    sacd_vfs_ctx_t *ctx;
+    const char *path;
+    int result;
+    uint64_t total_size;
+} dff_open_job_t;
+
+static int dff_open_thread(void *arg)
+{
+    dff_open_job_t *job = (dff_open_job_t *)arg;
+    sacd_vfs_file_t *file = NULL;
+    sacd_vfs_file_info_t info;
+
+    job->result = sacd_vfs_file_open(job->ctx, job->path, &file);
+    if (job->result == SACD_VFS_OK) {
+        job->result = sacd_vfs_file_get_info(file, &info);
+        job->total_size = info.total_size;
+        sacd_vfs_file_close(file);
+    }
+    return 0;
+}
+
+/**
+ * @brief A track whose audio ends early gets silent frames at the end
+ *
+ * Several threads open the .dff file at once; all of them see the layout
+ * of the one scan.
+ */
+static void test_dff_early_eof(void **state)
+{
+    (void)state;
+
+    sacd_test_image_t *image = NULL;
+    assert_int_equal(sacd_test_image_create(true, &image), 0);
+    uint32_t frames = sacd_test_image_frame_count(image);
+
+    /* The image ends three quarters into the Track Area */
+    uint32_t cut = SACD_TEST_IMAGE_TRACK_START +
+                   (sacd_test_image_track_end(image) - SACD_TEST_IMAGE_TRACK_START) * 3 / 4;
+    FILE *fp = fopen(TEST_DFF_ISO, "wb");
+    assert_non_null(fp);
+    for (uint32_t lsn = 0; lsn < cut; lsn++) {
+        assert_int_equal(fwrite(sacd_test_image_sector(image, lsn), 1, 2048, fp), 2048);
+    }
+    fclose(fp);
+
+    char album[256];
+    char name[256];
+    char path[600];
+    sacd_vfs_ctx_t *ctx = sacd_vfs_create();
+    assert_non_null(ctx);
+    assert_int_equal(sacd_vfs_set_dst_passthrough(ctx, true), SACD_VFS_OK);
+    assert_int_equal(sacd_vfs_open(ctx, TEST_DFF_ISO), SACD_VFS_OK);
+    assert_int_equal(sacd_vfs_get_album_name(ctx, album, sizeof(album)), SACD_VFS_OK);
+    assert_int_equal(sacd_vfs_get_track_filename(ctx, SACD_VFS_AREA_STEREO, 1,
+                                                 name, sizeof(name)),
+                     SACD_VFS_OK);
+    size_t len = strlen(name);
+    assert_true(len > 4);
+    memcpy(name + len - 4, ".dff", 4);
+    snprintf(path, sizeof(path), "/%s/Stereo/%s", album, name);
+
+    thrd_t threads[TEST_DFF_OPENERS];
+    dff_open_job_t jobs[TEST_DFF_OPENERS];
+    for (int t = 0; t < TEST_DFF_OPENERS; t++) {
+        jobs[t].ctx = ctx;
+        jobs[t].path = path;
+        jobs[t].result = -1;
+        jobs[t].total_size = 0;
+        assert_int_equal(thrd_create(&threads[t], dff_open_thread, &jobs[t]),
+                         thrd_success);
+    }
+    for (int t = 0; t < TEST_DFF_OPENERS; t++) {
+        thrd_join(threads[t], NULL);
+        assert_int_equal(jobs[t].result, SACD_VFS_OK);
+        assert_int_equal(jobs[t].total_size, jobs[0].total_size);
+    }
+
+    /* Read the whole file */
+    sacd_vfs_file_t *file = NULL;
+    sacd_vfs_file_info_t info;
+    assert_int_equal(sacd_vfs_file_open(ctx, path, &file), SACD_VFS_OK);
+    assert_int_equal(sacd_vfs_file_get_info(file, &info), SACD_VFS_OK);
+    assert_int_equal(info.total_size, jobs[0].total_size);
+    uint8_t *data = malloc((size_t)info.total_size);
+    assert_non_null(data);
+    size_t total = 0;
+    while (total < info.total_size) {
+        size_t n = 0;
+        assert_int_equal(sacd_vfs_file_read(file, data + total,
+                                            (size_t)info.total_size - total, &n),
+                         SACD_VFS_OK);
+        assert_true(n > 0);
+        total += n;
+    }
+    sacd_vfs_file_close(file);
+
+    /* Frames from the disc, then plain frames of silence */
+    uint64_t f = info.header_size;
+    uint32_t found = frames;
+    for (uint32_t i = 0; i < frames; i++) {
+        uint32_t expected_size = 0;
+        const uint8_t *expected = sacd_test_image_frame(image, i, &expected_size);
+        uint64_t size = get_be(data + f + 4, 8);
+
+        assert_memory_equal(data + f, "DSTF", 4);
+        if (found == frames && size == expected_size &&
+            memcmp(data + f + 12, expected, expected_size) == 0) {
+            f += 12 + size + (size & 1);
+            continue;
+        }
+        if (found == frames) {
+            found = i;
+        }
+        assert_int_equal(size, VFS_DFF_PLAIN_FRAME_SIZE(2));
+        assert_int_equal(data[f + 12], 0);
+        for (uint64_t b = 1; b < size; b++) {
+            assert_int_equal(data[f + 12 + b], VFS_DFF_SILENCE);
+        }
+        f += 12 + size + (size & 1);
+    }
+    assert_true(found > frames / 2 && found < frames);
+    assert_memory_equal(data + f, "DSTI", 4);
+
+    free(data);
+    sacd_vfs_destroy(ctx);
+    sacd_test_image_free(image);
+    remove(TEST_DFF_ISO);
+}
+
+/* =============================================================================
+ * Test: PCM Rendition Layout
+ * ===========================================================================*/
+
+/**
+ * @brief A stereo 16-bit WAV is sized from the frame count and tagged
+ */
+static void test_pcm_layout(void **state)
+{
+    (void)state;
+
+    vfs_pcm_layout_t layout;
+    uint8_t file[64];
+    uint8_t buf[16];
+
+    assert_int_equal(_vfs_pcm_layout_init(&layout, 3, 2, 44100, 16, 7), SACD_VFS_OK);
+    assert_int_equal(layout.header_size, 44);
+    assert_int_equal(layout.block_samples, 588 * 2);
+    assert_int_equal(layout.block_size, 588 * 2 * 2);
+    assert_int_equal(layout.data_offset, 44);
+    assert_int_equal(layout.data_size, 3 * 588 * 2 * 2);
+    assert_int_equal(layout.id3_offset, 44 + layout.data_size + 8);
+    assert_int_equal(layout.total_size, layout.id3_offset + 7 + 1);
+
+    /* Header */
+    assert_int_equal(_vfs_pcm_read_structure(&layout, 0, file, sizeof(file)), 44);
+    assert_memory_equal(file, "RIFF", 4);
+    assert_int_equal(file[4] | file[5] << 8 | file[6] << 16, layout.total_size - 8);
+    assert_memory_equal(file + 8, "WAVEfmt ", 8);
+    assert_int_equal(file[16], 16);
+    assert_int_equal(file[20], 1);                  /* WAVE_FORMAT_PCM */
+    assert_int_equal(file[22], 2);
+    assert_int_equal(file[32], 4);                  /* Block align */
+    assert_memory_equal(file + 36, "data", 4);
+    assert_int_equal(file[40] | file[41] << 8, layout.data_size);
+
+    /* PCM data and tag are not synthesized */
+    assert_int_equal(_vfs_pcm_read_structure(&layout, 44, buf, sizeof(buf)), 0);
+    assert_int_equal(_vfs_pcm_read_structure(&layout, layout.id3_offset, buf, sizeof(buf)), 0);
+
+    /* ID3 chunk header, then the pad byte after the odd-sized tag */
+    uint64_t data_end = layout.data_offset + layout.data_size;
+    assert_int_equal(_vfs_pcm_read_structure(&layout, data_end, buf, sizeof(buf)), 8);
+    assert_memory_equal(buf, "id3 \x07\0\0\0", 8);
+    assert_int_equal(_vfs_pcm_read_structure(&layout, data_end + 4, buf, 2), 2);
+    assert_int_equal(buf[0], 7);
+    buf[0] = 0xFF;
+    assert_int_equal(_vfs_pcm_read_structure(&layout, layout.total_size - 1, buf, sizeof(buf)), 1);
+    assert_int_equal(buf[0], 0);
+    assert_int_equal(_vfs_pcm_read_structure(&layout, layout.total_size, buf, sizeof(buf)), 0);
+}
+
+/**
+ * @brief Multichannel and 24-bit renditions use WAVE_FORMAT_EXTENSIBLE
+ */
+static void test_pcm_layout_extensible(void **state)
+{
+    (void)state;
+
+    vfs_pcm_layout_t layout;
+    uint8_t file[VFS_PCM_HEADER_MAX];
+
+    assert_int_equal(_vfs_pcm_layout_init(&layout, 2, 6, 88200, 24, 0), SACD_VFS_OK);
+    assert_int_equal(layout.header_size, 68);
+    assert_int_equal(layout.block_size, 1176 * 6 * 3);
+    assert_int_equal(layout.id3_size, 0);
+    assert_int_equal(layout.total_size, 68 + layout.data_size);
+
+    assert_int_equal(_vfs_pcm_read_structure(&layout, 0, file, sizeof(file)), 68);
+    assert_int_equal(file[16], 40);
+    assert_int_equal(file[20] | file[21] << 8, 0xFFFE);
+    assert_int_equal(file[34], 24);
+    assert_int_equal(file[40], 0x3F);               /* Channel mask */
+    assert_memory_equal(file + 60, "data", 4);
+
+    /* More than 4 GiB of PCM does not fit a RIFF file */
+    assert_int_equal(_vfs_pcm_layout_init(&layout, 60 * 75 * 60, 6, 352800, 24, 0),
+                     SACD_VFS_ERROR_FORMAT);
+}
+
+/**
+ * @brief Samples are packed little-endian and clipped
+ */
+static void test_pcm_pack(void **state)
+{
+    (void)state;
+
+    const double src[4] = { 0.0, 1.5, -2.0, -1.0 / 32767.0 };
+    uint8_t out[12];
+
+    _vfs_pcm_pack(src, 4, 16, out);
+    assert_memory_equal(out, "\x00\x00\xFF\x7F\x01\x80\xFF\xFF", 8);
+
+    _vfs_pcm_pack(src, 3, 24, out);
+    assert_memory_equal(out, "\x00\x00\x00\xFF\xFF\x7F\x01\x00\x80", 9);
+
+    assert_true(_vfs_pcm_format_valid(88200, 24));
+    assert_true(_vfs_pcm_format_valid(44100, 16));
+    assert_false(_vfs_pcm_format_valid(48000, 24));
+    assert_false(_vfs_pcm_format_valid(88200, 20));
+    assert_false(_vfs_pcm_format_valid(0, 16));
+
+    assert_int_equal(sacd_vfs_set_pcm_rendition(NULL, 88200, 24),
+                     SACD_VFS_ERROR_INVALID_PARAMETER);
+    assert_int_equal(sacd_vfs_get_pcm_rendition(NULL, NULL), 0);
+}
+
 /* =============================================================================
  * Main Test Runner
  * ===========================================================================*/
@@ -1783,6 +3059,42 @@ int main(void)
         cmocka_unit_test(test_dsf_structure_independent_of_source),
     };
 
+    const struct CMUnitTest block_cache_tests[] = {
+        cmocka_unit_test(test_block_cache_create),
+        cmocka_unit_test(test_block_cache_insert_lookup),
+        cmocka_unit_test(test_block_cache_eviction),
+        cmocka_unit_test(test_block_cache_purge),
+        cmocka_unit_test(test_block_cache_set),
+        cmocka_unit_test(test_disk_cache_create),
+        cmocka_unit_test(test_disk_cache_persistence),
+    };
+
+    const struct CMUnitTest dff_tests[] = {
+        cmocka_unit_test(test_dff_layout),
+        cmocka_unit_test(test_dff_layout_empty),
+        cmocka_unit_test(test_dff_early_eof),
+    };
+
+    const struct CMUnitTest pcm_tests[] = {
+        cmocka_unit_test(test_pcm_layout),
+        cmocka_unit_test(test_pcm_layout_extensible),
+        cmocka_unit_test(test_pcm_pack),
+    };
+
+    const struct CMUnitTest mt_pipeline_tests[] = {
+        cmocka_unit_test_setup_teardown(test_mt_deferred_start,
+                                        setup_mt_file, teardown_mt_file),
+        cmocka_unit_test_setup_teardown(test_mt_window,
+                                        setup_mt_file, teardown_mt_file),
+    };
+
+    const struct CMUnitTest mount_index_tests[] = {
+        cmocka_unit_test(test_overlay_mount_index),
+        cmocka_unit_test(test_overlay_mount_index_concurrent),
+        cmocka_unit_test(test_overlay_detect_cache),
+        cmocka_unit_test(test_overlay_summary),
+    };
+
     const struct CMUnitTest seek_edge_tests[] = {
         cmocka_unit_test(test_seek_set_positions),
         cmocka_unit_test(test_seek_cur_calculations),
@@ -1825,5 +3137,16 @@ int main(void)
     failed += cmocka_run_group_tests_name("Read After Seek Tests",
                                           read_after_seek_tests, NULL, group_teardown);
 
+    failed += cmocka_run_group_tests_name("Block Cache Tests",
+                                          block_cache_tests, NULL, NULL);
+    failed += cmocka_run_group_tests_name("DSDIFF/DST Passthrough Tests",
+                                          dff_tests, NULL, NULL);
+    failed += cmocka_run_group_tests_name("PCM Rendition Tests",
+                                          pcm_tests, NULL, NULL);
+    failed += cmocka_run_group_tests_name("MT Pipeline Tests",
+                                          mt_pipeline_tests, NULL, NULL);
+    failed += cmocka_run_group_tests_name("Overlay Mount Index Tests",
+                                          mount_index_tests, NULL, NULL);
+
     return failed;
 }